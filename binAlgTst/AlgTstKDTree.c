@@ -0,0 +1,367 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgTstKDTree_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binAlgTst/AlgTstKDTree.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Benchmark for the flat kD-tree (AlcKDTFlatNew()) against
+*		the linked kD-tree (AlcKDTInsert()), which checks the
+*		flat tree's nearest neighbour, k nearest neighbour and
+*		radius queries against the linked tree and brute force
+*		searches.
+* \ingroup	binAlgTst
+*/
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <Alc.h>
+#include <Alg.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+extern char     *optarg;
+extern int      optind,
+                opterr,
+                optopt;
+
+static double	AlgTstKDTreeSec(struct timeval *t0);
+static size_t	AlgTstKDTreeBrute(int dim, size_t nKeys, double *keys,
+				  double *q, double r, size_t k,
+				  double *dist);
+
+int             main(int argc, char *argv[])
+{
+  int		dim = 3,
+  		option,
+		ok = 1,
+		usage = 0;
+  size_t	idx,
+  		idK,
+  		k = 8,
+		nBad = 0,
+		nCheck = 100,
+  		nKeys = 100000,
+		nQ = 100000;
+  double	r,
+  		sec;
+  size_t	*fIdx = NULL,
+  		*fCnt = NULL;
+  double	*keys = NULL,
+  		*qKeys = NULL,
+		*lDist = NULL,
+		*fDist = NULL,
+		*bDist = NULL;
+  AlcKDTTree	*lTree = NULL;
+  AlcKDTFlat	*fTree = NULL;
+  AlcKDTNode	*node;
+  struct timeval t0;
+  AlcErrno	alcErr = ALC_ER_NONE;
+  static char   optList[] = "d:k:n:q:h";
+
+  opterr = 0;
+  while(ok && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 'd':
+        if((sscanf(optarg, "%d", &dim) != 1) || (dim < 1) || (dim > 16))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'k':
+        if((sscanf(optarg, "%lu", &k) != 1) || (k < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'n':
+        if((sscanf(optarg, "%lu", &nKeys) != 1) || (nKeys < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'q':
+        if((sscanf(optarg, "%lu", &nQ) != 1) || (nQ < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+        break;
+    }
+  }
+  ok = !usage;
+  if(ok)
+  {
+    nCheck = ALG_MIN(nCheck, nQ);
+    if(((keys = (double *)AlcMalloc(sizeof(double) * nKeys * dim)) == NULL) ||
+       ((qKeys = (double *)AlcMalloc(sizeof(double) * nQ * dim)) == NULL) ||
+       ((lDist = (double *)AlcMalloc(sizeof(double) * nQ)) == NULL) ||
+       ((fIdx = (size_t *)AlcMalloc(sizeof(size_t) * nQ * k)) == NULL) ||
+       ((fDist = (double *)AlcMalloc(sizeof(double) * nQ * k)) == NULL) ||
+       ((fCnt = (size_t *)AlcMalloc(sizeof(size_t) * nQ)) == NULL) ||
+       ((bDist = (double *)AlcMalloc(sizeof(double) * nKeys)) == NULL))
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: failed to allocate memory.\n", *argv);
+    }
+  }
+  if(ok)
+  {
+    srand48(0L);
+    for(idx = 0; idx < nKeys * dim; ++idx)
+    {
+      keys[idx] = drand48();
+    }
+    for(idx = 0; idx < nQ * dim; ++idx)
+    {
+      qKeys[idx] = drand48();
+    }
+    (void )printf("%d dimensions, %lu keys, %lu queries, k = %lu\n",
+                  dim, nKeys, nQ, k);
+  }
+  /* Linked kD-tree, built by insertion and queried one key at a time. */
+  if(ok)
+  {
+    gettimeofday(&t0, NULL);
+    lTree = AlcKDTTreeNew(ALC_POINTTYPE_DBL, dim, -1.0, nKeys, &alcErr);
+    for(idx = 0; (alcErr == ALC_ER_NONE) && (idx < nKeys); ++idx)
+    {
+      if((node = AlcKDTInsert(lTree, keys + (idx * dim), NULL,
+                              &alcErr)) != NULL)
+      {
+        node->idx = idx;
+      }
+    }
+    sec = AlgTstKDTreeSec(&t0);
+    if(alcErr == ALC_ER_NONE)
+    {
+      (void )printf("linked tree build    %10.3f s\n", sec);
+      gettimeofday(&t0, NULL);
+      for(idx = 0; (alcErr == ALC_ER_NONE) && (idx < nQ); ++idx)
+      {
+	(void )AlcKDTGetNN(lTree, qKeys + (idx * dim), DBL_MAX, lDist + idx,
+			   &alcErr);
+      }
+      sec = AlgTstKDTreeSec(&t0);
+      (void )printf("linked tree NN       %10.3f s %12.0f queries/s\n",
+                    sec, (sec > 0.0)? nQ / sec: 0.0);
+    }
+    (void )AlcKDTTreeFree(lTree);
+    ok = (alcErr == ALC_ER_NONE);
+  }
+  /* Flat kD-tree, built in bulk and queried in batches. */
+  if(ok)
+  {
+    gettimeofday(&t0, NULL);
+    fTree = AlcKDTFlatNew(ALC_POINTTYPE_DBL, dim, nKeys, keys, &alcErr);
+    sec = AlgTstKDTreeSec(&t0);
+    if(alcErr == ALC_ER_NONE)
+    {
+      (void )printf("flat tree build      %10.3f s\n", sec);
+      gettimeofday(&t0, NULL);
+      alcErr = AlcKDTFlatGetKNN(fTree, nQ, qKeys, 1, DBL_MAX,
+                                fIdx, fDist, NULL);
+      sec = AlgTstKDTreeSec(&t0);
+      (void )printf("flat tree NN         %10.3f s %12.0f queries/s\n",
+                    sec, (sec > 0.0)? nQ / sec: 0.0);
+    }
+    /* The nearest neighbour distances must match. */
+    for(idx = 0; (alcErr == ALC_ER_NONE) && (idx < nQ); ++idx)
+    {
+      if(fabs(fDist[idx] - lDist[idx]) > DBL_EPSILON)
+      {
+        ++nBad;
+      }
+    }
+  }
+  if(ok && (alcErr == ALC_ER_NONE))
+  {
+    gettimeofday(&t0, NULL);
+    alcErr = AlcKDTFlatGetKNN(fTree, nQ, qKeys, k, DBL_MAX,
+			      fIdx, fDist, fCnt);
+    sec = AlgTstKDTreeSec(&t0);
+    (void )printf("flat tree kNN        %10.3f s %12.0f queries/s\n",
+		  sec, (sec > 0.0)? nQ / sec: 0.0);
+    /* Check the k nearest neighbour distances of some queries by
+     * brute force. */
+    for(idx = 0; (alcErr == ALC_ER_NONE) && (idx < nCheck); ++idx)
+    {
+      size_t	nB;
+
+      nB = AlgTstKDTreeBrute(dim, nKeys, keys, qKeys + (idx * dim), DBL_MAX,
+                             k, bDist);
+      if(nB != fCnt[idx])
+      {
+        ++nBad;
+      }
+      for(idK = 0; idK < nB; ++idK)
+      {
+        if(fabs(sqrt(bDist[idK]) - fDist[(idx * k) + idK]) > DBL_EPSILON)
+	{
+	  ++nBad;
+	}
+      }
+    }
+  }
+  if(ok && (alcErr == ALC_ER_NONE))
+  {
+    /* Choose a radius which on average contains k keys. */
+    r = pow(k / (nKeys * pow(ALG_M_PI, 0.5 * dim) / tgamma(1.0 + 0.5 * dim)),
+            1.0 / dim);
+    gettimeofday(&t0, NULL);
+    alcErr = AlcKDTFlatGetRadius(fTree, nQ, qKeys, r, k, fIdx, NULL, fCnt);
+    sec = AlgTstKDTreeSec(&t0);
+    (void )printf("flat tree radius     %10.3f s %12.0f queries/s\n",
+		  sec, (sec > 0.0)? nQ / sec: 0.0);
+    for(idx = 0; (alcErr == ALC_ER_NONE) && (idx < nCheck); ++idx)
+    {
+      if(AlgTstKDTreeBrute(dim, nKeys, keys, qKeys + (idx * dim), r,
+                           nKeys, bDist) != fCnt[idx])
+      {
+        ++nBad;
+      }
+    }
+  }
+  if(ok)
+  {
+    if(alcErr != ALC_ER_NONE)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: kD-tree error %d.\n", *argv, (int )alcErr);
+    }
+    else if(nBad > 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: %lu queries gave incorrect results.\n",
+                     *argv, nBad);
+    }
+  }
+  (void )AlcKDTFlatFree(fTree);
+  AlcFree(keys);
+  AlcFree(qKeys);
+  AlcFree(lDist);
+  AlcFree(fIdx);
+  AlcFree(fDist);
+  AlcFree(fCnt);
+  AlcFree(bDist);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-d#] [-k#] [-n#] [-q#] [-h]\n"
+    "Benchmarks the flat kD-tree against the linked kD-tree using\n"
+    "uniformly distributed random keys and queries. The flat tree's\n"
+    "results are checked against the linked tree and, for a sample of\n"
+    "the queries, against a brute force search.\n"
+    "Options:\n"
+    "  -d  Dimension of the keys.\n"
+    "  -k  Number of neighbours for the k nearest neighbour query.\n"
+    "  -n  Number of keys in the trees.\n"
+    "  -q  Number of query keys.\n"
+    "  -h  Prints this usage information.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Seconds elapsed.
+* \ingroup	binAlgTst
+* \brief	Returns the number of seconds since the given time.
+* \param	t0			Given time.
+*/
+static double	AlgTstKDTreeSec(struct timeval *t0)
+{
+  struct timeval t1,
+  		t2;
+
+  gettimeofday(&t1, NULL);
+  ALC_TIMERSUB(&t1, t0, &t2);
+  return(t2.tv_sec + (0.000001 * t2.tv_usec));
+}
+
+/*!
+* \return	Number of keys within the radius, at most k.
+* \ingroup	binAlgTst
+* \brief	Finds the squared distances of the k nearest keys within
+*		the given radius of the query key by brute force.
+* \param	dim			Dimension of the keys.
+* \param	nKeys			Number of keys.
+* \param	keys			Keys.
+* \param	q			Query key.
+* \param	r			Radius.
+* \param	k			Number of neighbours.
+* \param	dist			Destination for the squared
+*					distances in increasing order.
+*/
+static size_t	AlgTstKDTreeBrute(int dim, size_t nKeys, double *keys,
+				  double *q, double r, size_t k,
+				  double *dist)
+{
+  int		idD;
+  size_t	idN,
+  		idK,
+		nK = 0;
+  double	r2;
+
+  r2 = (r < sqrt(DBL_MAX))? r * r: DBL_MAX;
+  for(idN = 0; idN < nKeys; ++idN)
+  {
+    double	e = 0.0;
+
+    for(idD = 0; idD < dim; ++idD)
+    {
+      double	t;
+
+      t = keys[(idN * dim) + idD] - q[idD];
+      e += t * t;
+    }
+    if((e < r2) && ((nK < k) || (e < dist[k - 1])))
+    {
+      idK = (nK < k)? nK++: k - 1;
+      while((idK > 0) && (dist[idK - 1] > e))
+      {
+        dist[idK] = dist[idK - 1];
+	--idK;
+      }
+      dist[idK] = e;
+    }
+  }
+  return(nK);
+}
@@ -52,13 +52,22 @@ WlzBasisFnTransformObj - computes and applies Woolz basis function transforms.
 WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
 		       [-m<min mesh dist>] [-M<max mesh dist>]
 		       [-b<basis fn transform>] [-Y<order of polynomial>]
-		       [-D<flags>] [-P<param>]
-		       [-d] [-g] [-h] [-q] [-Q] [-s] [-t] [-y]
+		       [-D<flags>] [-P<param>] [-a<tolerance>]
+		       [-d] [-g] [-h] [-k] [-q] [-Q] [-s] [-t] [-y]
 		       [-B] [-C] [-E] [-G] [-L] [-N] [-R] [-S] [-T]
 		       [-U] [<in object>]
 \endverbatim
 \par Options
 <table width="500" border="0">
+  <tr> 
+    <td><b>-a</b></td>
+    <td>Evaluate the basis function using a tree over the tie points
+        with the given tolerance (eg 0.5) rather than directly. This
+	is much faster when there are many tie points. Only valid for
+	Gaussian, multi-quadric, inverse-multi-quadric, thin plate
+	spline and compactly supported basis functions and not with
+	conforming distance transforms or a target mesh.</td>
+  </tr>
   <tr> 
     <td><b>-B</b></td>
     <td>Block mesh generation method.</td>
@@ -145,6 +154,13 @@ WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
     <td><b>-h</b></td>
     <td>Help, prints usage message.</td>
   </tr>
+  <tr> 
+    <td><b>-k</b></td>
+    <td>Use compactly supported basis function if tie points are given.
+        This is fitted iteratively and is suitable for very many tie
+	points. The basis function parameter is the support radius,
+	which is chosen automatically if not given.</td>
+  </tr>
   <tr> 
     <td><b>-P</b></td>
     <td>Basis function parameter (eg MQ delta value).</td>
@@ -290,6 +306,7 @@ int             main(int argc, char **argv)
 		ok = 1,
 		usage = 0;
   double	basisFnParam = 0.001,
+  		treeTol = 0.0,
   		meshMinDist = 20.0,
   		meshMaxDist = 40.0;
   WlzVertexP	vxA0,
@@ -314,7 +331,7 @@ int             main(int argc, char **argv)
   struct timeval times[6];
   const int	delOut = 1;
   const char    *errMsg;
-  static char	optList[] = "b:m:o:p:t:D:M:P:Y:cdghqsyBCEGLNQRSTU",
+  static char	optList[] = "a:b:m:o:p:t:D:M:P:Y:cdghkqsyBCEGLNQRSTU",
   		inObjFileStrDef[] = "-",
 		outObjFileStrDef[] = "-";
 
@@ -330,6 +347,12 @@ int             main(int argc, char **argv)
   {
     switch(option)
     {
+      case 'a':
+	if(sscanf(optarg, "%lg", &treeTol) != 1)
+	{
+	  usage = 1;
+	}
+	break;
       case 'o':
         outObjFileStr = optarg;
 	break;
@@ -363,6 +386,9 @@ int             main(int argc, char **argv)
       case 'G':
         meshGenMth = WLZ_MESH_GENMETHOD_GRADIENT;
 	break;
+      case 'k':
+        basisFnType = WLZ_FN_BASIS_2DCS;
+	break;
       case 'L':
         interp = WLZ_INTERPOLATION_LINEAR;
 	break;
@@ -672,6 +698,9 @@ int             main(int argc, char **argv)
         case WLZ_FN_BASIS_2DMQ:
           basisFnType = WLZ_FN_BASIS_3DMQ;
 	  break;
+        case WLZ_FN_BASIS_2DCS:
+          basisFnType = WLZ_FN_BASIS_3DCS;
+	  break;
         default:
 	  errNum = WLZ_ERR_DOMAIN_TYPE;
 	  ok = 0;
@@ -749,6 +778,10 @@ int             main(int argc, char **argv)
 				nBasisFnParam, &basisFnParam, &errNum);
 	  }
 	}
+	if((errNum == WLZ_ERR_NONE) && (treeTol > 0.0))
+	{
+	  errNum = WlzBasisFnSetTree(basisTr->basisFn, treeTol);
+	}
 	if(errNum != WLZ_ERR_NONE)
 	{
 	  ok = 0;
@@ -761,11 +794,11 @@ int             main(int argc, char **argv)
     }
     else /* Use affine and basis functions to define mesh. */
     {
-      meshTr.mesh = WlzMeshTransformFromCPts(inObj,
+      meshTr.mesh = WlzMeshTransformFromCPtsTree(inObj,
       				basisFnType, basisFnPolyOrder,
       				nTiePP, vxA0.d2, nTiePP, vxA1.d2,
 				meshGenMth, meshMinDist, meshMaxDist,
-				&errNum);
+				treeTol, &errNum);
     }
     gettimeofday(times + 1, NULL);
   }
@@ -939,14 +972,20 @@ int             main(int argc, char **argv)
     " [-o<out object>] [-p<tie points file>]\n"
     "                  [-m<min mesh dist>] [-M<max mesh dist>]\n"
     "                  [-b<basis fn transform>] [-Y<order of polynomial>]\n"
-    "                  [-D<flags>] [-P<param>]\n"
-    "                  [-d] [-g] [-h] [-q] [-s] [-t] [-y]\n"
+    "                  [-D<flags>] [-P<param>] [-a<tolerance>]\n"
+    "                  [-d] [-g] [-h] [-k] [-q] [-s] [-t] [-y]\n"
     "                  [-B] [-C] [-E] [-G] [-L] [-N] [-Q] [-R] [-S] [-T]\n"
     "                  [-U] [<in object>]\n"
     "Version: ",
     WlzVersion(),
     "\n"
     "Options:\n"
+    "  -a  Evaluate the basis function using a tree over the tie points\n"
+    "      with the given tolerance (eg 0.5) rather than directly. This is\n"
+    "      much faster when there are many tie points. Only valid for\n"
+    "      Gaussian, multi-quadric, inverse-multi-quadric, thin plate\n"
+    "      spline and compactly supported basis functions and not with\n"
+    "      conforming distance transforms or a target mesh.\n"
     "  -b  Basis function transform object.\n"
     "  -B  Block mesh generation method.\n"
     "  -C  Use conforming mesh.\n"
@@ -974,6 +1013,10 @@ int             main(int argc, char **argv)
     "      only (ie no least squares affine).\n"
     "  -g  Use Gaussian basis function if tie points are given.\n"
     "  -h  Help, prints this usage message.\n"
+    "  -k  Use compactly supported basis function if tie points are given.\n"
+    "      This is fitted iteratively and is suitable for very many tie\n"
+    "      points. The basis function parameter is the support radius,\n"
+    "      which is chosen automatically if not given.\n"
     "  -q  Use multi-quadric basis function if tie points are given.\n"
     "  -P  Basis function parameter (eg MQ delta value).\n"
     "  -Q  Use inverse-multi-quadric basis function if tie points are given.\n"
@@ -52,7 +52,7 @@ WlzBasisFnTransformVertices  -  applies a basis function to vertices.
 WlzBasisFnTransformVertices [-o<out object>] [-p<tie points file>]
                             [-m<min mesh dist>] [-M<max mesh dist>]
 			    [-t<basis fn transform>] [-Y<order of polynomial>]
-			    [-g] [-h] [-q] [-Q] [-s] [-y] [-B] [-D] [-G]
+			    [-a<tolerance>] [-g] [-h] [-q] [-Q] [-s] [-y] [-B] [-D] [-G]
 			    [-L] [-T] [<in object>]
 \endverbatim
 \par Options
@@ -69,6 +69,12 @@ WlzBasisFnTransformVertices [-o<out object>] [-p<tie points file>]
     <td><b>-v</b></td>
     <td>Vertex file.</td>
   </tr>
+  <tr> 
+    <td><b>-a</b></td>
+    <td>Evaluate the basis function using a tree over the tie points
+        with the given tolerance (eg 0.5) rather than directly. This
+	is much faster when there are many tie points.</td>
+  </tr>
   <tr> 
     <td><b>-c</b></td>
     <td>Use conformal polynomial basis function if tie points are given.</td>
@@ -157,6 +163,7 @@ int             main(int argc, char **argv)
 		ok = 1,
 		ic = 0,
 		usage = 0;
+  double	treeTol = 0.0;
   WlzDVertex2	*vx0 = NULL,
   		*vx1 = NULL,
 		*vxVec0  = NULL,
@@ -176,7 +183,7 @@ int             main(int argc, char **argv)
 		*vertptFileStr = NULL,
   		*outVerticesFileStr;
   const char    *errMsg;
-  static char	optList[] = "o:p:v:t:Y:cghqsy",
+  static char	optList[] = "a:o:p:v:t:Y:cghqsy",
   		inObjFileStrDef[] = "-",
 		outVerticesFileStrDef[] = "-",
   		inRecord[IN_RECORD_MAX];
@@ -188,6 +195,13 @@ int             main(int argc, char **argv)
   {
     switch(option)
     {
+      case 'a':
+        if(sscanf(optarg, "%lg", &treeTol) != 1)
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
       case 'o':
         outVerticesFileStr = optarg;
 	break;
@@ -332,6 +346,10 @@ int             main(int argc, char **argv)
       basisTr = WlzBasisFnTrFromCPts2D(basisFnType, basisFnPolyOrder,
 					nTiePP, vxVec0,
 					nTiePP, vxVec1, NULL, &errNum);
+      if((errNum == WLZ_ERR_NONE) && (treeTol > 0.0))
+      {
+        errNum = WlzBasisFnSetTree(basisTr->basisFn, treeTol);
+      }
       if(errNum != WLZ_ERR_NONE)
       {
 	ok = 0;
@@ -485,6 +503,7 @@ int             main(int argc, char **argv)
     " [-o<out object>] [-p<tie points file>]\n"
     "                  [-m<min mesh dist>] [-M<max mesh dist>]\n"
     "                  [-t<basis fn transform>] [-Y<order of polynomial>]\n"
+    "                  [-a<tolerance>]\n"
     "                  [-g] [-h] [-q] [-Q] [-s] [-y] [-B] [-D] [-G] [-L]\n"
     "                  [-T] [<in object>]\n"
     "Version: ",
@@ -494,6 +513,9 @@ int             main(int argc, char **argv)
     "  -o  Output vertices file name.\n"
     "  -p  Tie point file.\n"
     "  -v  vertices file.\n"
+    "  -a  Evaluate the basis function using a tree over the tie points\n"
+    "      with the given tolerance (eg 0.5) rather than directly. This is\n"
+    "      much faster when there are many tie points.\n"
     "  -c  Use conformal polynomial basis function if tie points are given.\n"
     "  -g  Use Gaussian basis function if tie points are given.\n"
     "  -h  Help, prints this usage message.\n"
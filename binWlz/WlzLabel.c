@@ -49,7 +49,7 @@ static char _WlzLabel_c[] = "University of Edinburgh $Id$";
 WlzLabel - labels (segments) the input objects.
 \par Synopsis
 \verbatim
-WlzLabel [i#] [-v] [-h] [-M#] [<input file>]
+WlzLabel [i#] [-p] [-v] [-h] [-M#] [<input file>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -69,6 +69,10 @@ WlzLabel [i#] [-v] [-h] [-M#] [<input file>]
     <td><b>-M</b></td>
     <td>Maximum number of segmented objects.</td>
   </tr>
+  <tr> 
+    <td><b>-p</b></td>
+    <td>Use the parallel labeler WlzLabelParallel().</td>
+  </tr>
 </table>
 \par Description
 Label (segment) the input objects and write the result
@@ -116,7 +120,7 @@ extern char     *optarg;
 static void usage(char *proc_str)
 {
   (void )fprintf(stderr,
-	  "Usage:\t%s [i#] [-M#] [-v] [-h] [<input file>]\n"
+	  "Usage:\t%s [i#] [-M#] [-p] [-v] [-h] [<input file>]\n"
 	  "\tLabel (segment) the input objects and write the result\n"
 	  "\tto stdout. Non-domain objects are ignored, the number\n"
 	  "\tof segments found is written to stderr\n"
@@ -124,6 +128,7 @@ static void usage(char *proc_str)
 	  "Options:\n"
 	  "\t  -i#       Ignore objects with number of lines < #\n"
 	  "\t  -M#       Maximum number of segmented objects.\n"
+	  "\t  -p        Use the parallel labeler.\n"
 	  "\t  -v        Verbose flag\n"
 	  "\t  -h        Help - prints this usage message\n",
 	  proc_str,
@@ -140,9 +145,9 @@ int main(int	argc,
   WlzObject	*obj;
   WlzObject	**objlist = NULL;
   FILE		*inFile;
-  char 		optList[] = "i:M:vh";
+  char 		optList[] = "i:M:pvh";
   int		option;
-  int		count, numobj, maxobj = MAXOBJS, i, verbose = 0;
+  int		count, numobj, maxobj = MAXOBJS, i, verbose = 0, par = 0;
   int		ignw = -1;
   const char	*errMsg;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -170,6 +175,10 @@ int main(int	argc,
       }
       break;
  
+    case 'p':
+      par = 1;
+      break;
+
     case 'v':
       verbose = 1;
       break;
@@ -201,7 +210,16 @@ int main(int	argc,
 
     case WLZ_2D_DOMAINOBJ:
     case WLZ_3D_DOMAINOBJ:
-      errNum = WlzLabel(obj, &numobj, &objlist, maxobj, ignw, WLZ_8_CONNECTED);
+      if(par)
+      {
+	errNum = WlzLabelParallel(obj, &numobj, &objlist, maxobj, ignw,
+				  WLZ_8_CONNECTED);
+      }
+      else
+      {
+	errNum = WlzLabel(obj, &numobj, &objlist, maxobj, ignw,
+			  WLZ_8_CONNECTED);
+      }
       if(errNum == WLZ_ERR_DOMAIN_TYPE) {
 	errNum = WlzWriteObj(stdout, obj);
       }
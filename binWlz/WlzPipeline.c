@@ -0,0 +1,388 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzPipeline_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlz/WlzPipeline.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Applies a chain of operations to objects in memory.
+* \ingroup	BinWlz
+*
+* \par Binary
+* \ref wlzpipeline "WlzPipeline"
+*/
+
+/*!
+\ingroup BinWlz
+\defgroup wlzpipeline WlzPipeline
+\par Name
+WlzPipeline - applies a chain of operations to objects in memory.
+\par Synopsis
+\verbatim
+WlzPipeline [-h] [-l] [-T] [-o<output file>] -p<pipeline>
+            [<input file> ...]
+\endverbatim
+\par Options
+<table width="500" border="0">
+  <tr>
+    <td><b>-h</b></td>
+    <td>Help, prints usage message.</td>
+  </tr>
+  <tr>
+    <td><b>-l</b></td>
+    <td>List the available operations and their arguments.</td>
+  </tr>
+  <tr>
+    <td><b>-o</b></td>
+    <td>Output file, default standard output.</td>
+  </tr>
+  <tr>
+    <td><b>-p</b></td>
+    <td>Pipeline description.</td>
+  </tr>
+  <tr>
+    <td><b>-T</b></td>
+    <td>Report the elapsed time of each stage of the pipeline
+        (summed over all objects) and of reading and writing.</td>
+  </tr>
+</table>
+\par Description
+Reads all the objects from the input files (or the standard input
+if there are none), applies the pipeline to each of them and then
+writes the resulting objects in the same order.
+The pipeline is a string of stages separated by '|' characters,
+each stage being an operation name followed by its arguments.
+The objects are held in memory between the stages and
+independent objects are processed in parallel.
+\par Examples
+\verbatim
+WlzPipeline -T -p 'gauss 2 | threshold 100 high | erosion | label' \
+            -o out.wlz in0.wlz in1.wlz
+\endverbatim
+Smooths the objects read from in0.wlz and in1.wlz, thresholds,
+erodes and labels them, writing the compound array objects of
+labeled components to out.wlz and the stage times to the standard
+error output.
+This is equivalent to the shell pipeline
+\verbatim
+WlzGauss -x 2 -y 2 in.wlz | WlzThreshold -v 100 -H | WlzErosion | WlzLabel
+\endverbatim
+but without any intermediate objects being written or read.
+\par File
+\ref WlzPipeline.c "WlzPipeline.c"
+\par See Also
+\ref BinWlz "WlzIntro(1)"
+\ref WlzPipelineParse "WlzPipelineParse(3)"
+\ref WlzPipelineRunN "WlzPipelineRunN(3)"
+*/
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+/* externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int 	optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double	WlzPipelineElapsed(struct timeval *t0);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		nObj = 0,
+		maxObj = 0,
+		ok = 1,
+		listFlg = 0,
+		timeFlg = 0,
+  		option,
+  		usage = 0;
+  double	rdTime = 0.0,
+		runTime = 0.0,
+  		wrTime = 0.0;
+  double	*stageTimes = NULL;
+  FILE		*fP = NULL;
+  char		*outFileStr,
+  		*pipeStr = NULL;
+  const char	*errMsgStr;
+  struct timeval t0;
+  WlzObject	**inObjs = NULL,
+  		**outObjs = NULL;
+  WlzPipeline	*pipe = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hlTo:p:";
+  const char    outFileStrDef[] = "-";
+
+  opterr = 0;
+  outFileStr = (char *)outFileStrDef;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'l':
+        listFlg = 1;
+	break;
+      case 'o':
+        outFileStr = optarg;
+	break;
+      case 'p':
+        pipeStr = optarg;
+	break;
+      case 'T':
+        timeFlg = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && listFlg)
+  {
+    int		nOps;
+
+    nOps = WlzPipelineOpCount();
+    for(idx = 0; idx < nOps; ++idx)
+    {
+      (void )fprintf(stdout, "%s\n", WlzPipelineOpGet(idx)->usage);
+    }
+    return(0);
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    if((pipeStr == NULL) || (*pipeStr == '\0') ||
+       (outFileStr == NULL) || (*outFileStr == '\0'))
+    {
+      ok = 0;
+      usage = 1;
+    }
+  }
+  if(ok)
+  {
+    if((pipe = WlzPipelineParse(pipeStr, &errNum)) == NULL)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: failed to parse pipeline, unknown operation or\n"
+		     "invalid number of arguments (%s).\n",
+		     *argv, errMsgStr);
+    }
+    else if((stageTimes = (double *)
+                          AlcCalloc(pipe->nStage, sizeof(double))) == NULL)
+    {
+      ok = 0;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Read all the objects from all the input files. */
+  if(ok)
+  {
+    int		idF,
+    		nFiles;
+
+    gettimeofday(&t0, NULL);
+    nFiles = (optind < argc)? argc - optind: 1;
+    for(idF = 0; ok && (idF < nFiles); ++idF)
+    {
+      char	*inFileStr;
+      WlzObject	*obj;
+
+      inFileStr = (optind < argc)? *(argv + optind + idF): "-";
+      if((fP = (strcmp(inFileStr, "-")?
+               fopen(inFileStr, "r"): stdin)) == NULL)
+      {
+        ok = 0;
+	(void )fprintf(stderr, "%s: failed to open input file %s.\n",
+		       *argv, inFileStr);
+      }
+      while(ok &&
+            ((obj = WlzAssignObject(WlzReadObj(fP, NULL), NULL)) != NULL))
+      {
+        if(nObj >= maxObj)
+	{
+	  WlzObject **newObjs;
+
+	  maxObj = (maxObj < 16)? 16: 2 * maxObj;
+	  if((newObjs = (WlzObject **)
+	                AlcRealloc(inObjs,
+				   sizeof(WlzObject *) * maxObj)) != NULL)
+	  {
+	    inObjs = newObjs;
+	  }
+	  else
+	  {
+	    ok = 0;
+	    (void )WlzFreeObj(obj);
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	    (void )fprintf(stderr, "%s: failed to allocate memory.\n",
+	                   *argv);
+	  }
+	}
+	if(ok)
+	{
+	  inObjs[nObj++] = obj;
+	}
+      }
+      if(fP && strcmp(inFileStr, "-"))
+      {
+        (void )fclose(fP);
+      }
+      fP = NULL;
+    }
+    rdTime = WlzPipelineElapsed(&t0);
+  }
+  if(ok && (nObj > 0))
+  {
+    gettimeofday(&t0, NULL);
+    if((outObjs = (WlzObject **)
+                  AlcCalloc(nObj, sizeof(WlzObject *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      errNum = WlzPipelineRunN(pipe, nObj, inObjs, outObjs, stageTimes);
+    }
+    runTime = WlzPipelineElapsed(&t0);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: failed to apply pipeline (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    gettimeofday(&t0, NULL);
+    if((fP = (strcmp(outFileStr, "-")?
+             fopen(outFileStr, "w"): stdout)) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: failed to open output file %s.\n",
+		     *argv, outFileStr);
+    }
+    for(idx = 0; ok && (idx < nObj); ++idx)
+    {
+      if((errNum = WlzWriteObj(fP, outObjs[idx])) != WLZ_ERR_NONE)
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsgStr);
+	(void )fprintf(stderr, "%s: failed to write object (%s).\n",
+		       *argv, errMsgStr);
+      }
+    }
+    if(fP && strcmp(outFileStr, "-"))
+    {
+      (void )fclose(fP);
+    }
+    wrTime = WlzPipelineElapsed(&t0);
+  }
+  if(ok && timeFlg)
+  {
+    (void )fprintf(stderr, "%s: %d object(s)\n", *argv, nObj);
+    (void )fprintf(stderr, "%s: read           %gs\n", *argv, rdTime);
+    for(idx = 0; idx < pipe->nStage; ++idx)
+    {
+      (void )fprintf(stderr, "%s: stage %-3d %-10s %gs\n",
+		     *argv, idx, pipe->stages[idx].op->name,
+		     stageTimes[idx]);
+    }
+    (void )fprintf(stderr, "%s: pipeline       %gs\n", *argv, runTime);
+    (void )fprintf(stderr, "%s: write          %gs\n", *argv, wrTime);
+  }
+  for(idx = 0; idx < nObj; ++idx)
+  {
+    (void )WlzFreeObj(inObjs[idx]);
+    if(outObjs)
+    {
+      (void )WlzFreeObj(outObjs[idx]);
+    }
+  }
+  AlcFree(inObjs);
+  AlcFree(outObjs);
+  AlcFree(stageTimes);
+  WlzPipelineFree(pipe);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-l] [-T] [-o<output file>] -p<pipeline>\n"
+    "\t\t[<input file> ...]\n"
+    "Version: %s\n"
+    "Options:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -l  List the available operations and their arguments.\n"
+    "  -o  Output file, default standard output.\n"
+    "  -p  Pipeline description: stages separated by '|' characters,\n"
+    "      each stage being an operation name followed by its arguments.\n"
+    "  -T  Report the elapsed time of each stage (summed over all\n"
+    "      objects) and of reading and writing.\n"
+    "Reads all the objects from the input files (or the standard input\n"
+    "if there are none), applies the pipeline to each of them with\n"
+    "independent objects processed in parallel and then writes the\n"
+    "resulting objects in the same order.\n"
+    "Example:\n"
+    "  %s -T -p 'gauss 2 | threshold 100 high | erosion | label' \\\n"
+    "     -o out.wlz in0.wlz in1.wlz\n"
+    "Smooths the objects read from in0.wlz and in1.wlz, thresholds,\n"
+    "erodes and labels them, writing the compound array objects of\n"
+    "labeled components to out.wlz.\n",
+    argv[0],
+    WlzVersion(),
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Elapsed time in seconds.
+* \brief	Computes the time elapsed since the given time.
+* \param	t0			Given start time.
+*/
+static double	WlzPipelineElapsed(struct timeval *t0)
+{
+  struct timeval t1,
+  		t2;
+
+  gettimeofday(&t1, NULL);
+  ALC_TIMERSUB(&t1, t0, &t2);
+  return(t2.tv_sec + (0.000001 * t2.tv_usec));
+}
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
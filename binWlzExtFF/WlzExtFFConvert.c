@@ -50,7 +50,7 @@ static char _WlzExtFFConvert_c[] = "University of Edinburgh $Id$";
 WlzExtFFConvert - converts image objects between file formats.
 \par Synopsis
 \verbatim
-WlzExtFFConvert [-h] [-s] [-G] [-S] [-b<background>]
+WlzExtFFConvert [-h] [-s] [-B] [-G] [-S] [-b<background>]
                 [-f<input format>] [-F<output format>]
 		[-x<x size>] [-y<y size>] [-z<z size>]
 		[-o<output file>] [<input file>)]
@@ -66,6 +66,11 @@ WlzExtFFConvert [-h] [-s] [-G] [-S] [-b<background>]
     <td><b>-s</b></td>
     <td>Split labeled volumes into domains.</td>
   </tr>
+  <tr>
+    <td><b>-B</b></td>
+    <td>Write binary rather than ASCII data for output formats which
+        support both, currently only VTK.</td>
+  </tr>
   <tr>
     <td><b>-G</b></td>
     <td>Apply grey value transforms.</td>
@@ -199,6 +204,7 @@ int             main(int argc, char **argv)
 {
   int		option,
   		bgdFlag = 0,
+		binData = 0,
 		split = 0,
 		gTrans = 0,
 		sTrans = 0,
@@ -219,7 +225,7 @@ int             main(int argc, char **argv)
   		bgdV;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const char    *errMsg;
-  static char	optList[] = "b:d:D:f:F:Lo:x:y:z:hsGS",
+  static char	optList[] = "b:d:D:f:F:Lo:x:y:z:hsBGS",
 		outObjFileStrDef[] = "-",
 		inObjFileStrDef[] = "-";
  
@@ -315,6 +321,9 @@ int             main(int argc, char **argv)
       case 's':
         split = 1;
 	break;
+      case 'B':
+        binData = 1;
+	break;
       case 'G':
         gTrans = 1;
 	break;
@@ -480,8 +489,27 @@ int             main(int argc, char **argv)
       fP = NULL;
       fStr = outObjFileStr;
     }
-    if((errNum = WlzEffWriteObj(fP, fStr,
-    				inObj, outFmt)) != WLZ_ERR_NONE)
+    if(binData && (outFmt == WLZEFF_FORMAT_VTK))
+    {
+      if(fStr && ((fP = fopen(fStr, "wb")) == NULL))
+      {
+        errNum = WLZ_ERR_WRITE_EOF;
+      }
+      else
+      {
+        errNum = WlzEffWriteObjVtkDataType(fP, inObj,
+					   WLZEFF_VTK_DATATYPE_BINARY);
+	if(fStr)
+	{
+	  (void )fclose(fP);
+	}
+      }
+    }
+    else
+    {
+      errNum = WlzEffWriteObj(fP, fStr, inObj, outFmt);
+    }
+    if(errNum != WLZ_ERR_NONE)
     {
       ok = 0;
       (void )WlzStringFromErrorNum(errNum, &errMsg);
@@ -505,7 +533,7 @@ int             main(int argc, char **argv)
 	stderr,
 	"Usage: %s%s%s%s%s%s%s%s%s%s%s\n",
 	*argv,
-	" [-h] [-s] [-b<background>]\n"
+	" [-h] [-s] [-B] [-b<background>]\n"
 	"                       [-d<min-dimension>] [-D<max-dimension>]\n"
 	"                       [-f<input format>] [-F<output format>]\n"
 	"                       [-x<x size>] [-y<y size>] [-z<z size>]\n"
@@ -519,6 +547,8 @@ int             main(int argc, char **argv)
 	"  -h    Help, prints this usage information.\n"
 	"  -s    Split labeled volumes into domains.This will also split\n"
 	"        a tiled or pyramidal tiff into resolution slices and tiles.\n"
+	"  -B    Write binary rather than ASCII data for output formats\n"
+	"        which support both, currently only VTK.\n"
 	"  -G    Apply grey value transforms.\n"
 	"  -S    Use spatial transforms to create WLZ_TRANS_OBJ objects\n"
         "        (by default just offsets are applied).\n"
@@ -51,11 +51,14 @@ WlzExtFFDefGrdExportVTK - exports tensor deformation features to an
                           extended VTK format file.
 \par Synopsis
 \verbatim
-WlzExtFFDefGrdExportVTK [-h] [-m #] [-o<output file>] [input file]
+WlzExtFFDefGrdExportVTK [-b] [-h] [-m #] [-o<output file>] [input file]
 \endverbatim
 \par Options
 <table width="500" border="0">
   <tr>
+  <td><b>-b</b></td>
+    <td>Binary VTK output.</td>
+  </tr> <tr>
   <td><b>-h</b></td>
     <td>Prints usage information.</td>
   </tr> <tr>
@@ -70,6 +73,8 @@ Reads a tensor deformation gradient features compound object file
 as produced by WlzDefGrdTensorFeatures(1) or WlzDGTensorFeatures(3) and
 exports the features to an extended legacy ASCII VTK format file.
 If given all output values are multiplied by the given factor.
+The points and values are written as ASCII unless binary output is
+requested, in which case they are written as big-endian binary floats.
 The feature to export is identified by a single chaacter and must
 be one of the following:
 <table width="500" border="0">
@@ -147,7 +152,8 @@ static WlzErrorNum		WlzExtFFDefGrdWriteEigen(
 				  FILE *fP,
 				  WlzObject *lObj,
 				  WlzObject *eObj,
-				  double mf);
+				  double mf,
+				  WlzEffVtkDataType dType);
 extern char     *optarg;
 extern int      optind,
                 opterr,
@@ -162,13 +168,14 @@ int             		main(
                 usage = 0,
       		feature = 'j';
   double	mulFac = 1.0;
+  WlzEffVtkDataType dType = WLZEFF_VTK_DATATYPE_ASCII;
   WlzCompoundArray *inCpd = NULL;
   char		*inFileStr,
   		*outFileStr;
   FILE		*fP = NULL;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
   const char    *errMsg;
-  static char   optList[] = "hf:m:o:",
+  static char   optList[] = "bhf:m:o:",
                 fileStrDef[] = "-";
 
   opterr = 0;
@@ -178,6 +185,9 @@ int             		main(
   {
     switch(option)
     {
+      case 'b':
+        dType = WLZEFF_VTK_DATATYPE_BINARY;
+	break;
       case 'f':
         switch(*optarg)
 	{
@@ -287,7 +297,7 @@ int             		main(
     }
     else
     {
-      errNum = WlzEffWritePointsVtk(fP, obj, 1);
+      errNum = WlzEffWritePointsVtkDataType(fP, obj, 1, dType);
     }
   }
   if(ok)
@@ -327,7 +337,7 @@ int             		main(
 	  errNum = WlzExtFFDefGrdWriteEigen(fP,
 	                               inCpd->o[featIndex[2]],
 				       inCpd->o[featIndex[1]],
-				       mulFac);
+				       mulFac, dType);
 	}
         break;
       case 'j':
@@ -342,8 +352,9 @@ int             		main(
 	  }
 	  if(errNum == WLZ_ERR_NONE)
 	  {
-	    errNum = WlzEffWritePointsVtkScalarValues(fP,
-						      inCpd->o[featIndex[0]]);
+	    errNum = WlzEffWritePointsVtkScalarValuesDataType(fP,
+						inCpd->o[featIndex[0]],
+						dType);
 	  }
 	}
         break;
@@ -368,10 +379,11 @@ int             		main(
   {
     (void )fprintf(
         stderr,
-	"Usage: %s [-h] [-f <feat>] [-m #] [-o<output file>]\n"
+	"Usage: %s [-b] [-h] [-f <feat>] [-m #] [-o<output file>]\n"
 	"\t\t[input file]\n"
 	"Version: %s\n"
 	"Options:\n"
+	"  -b  Binary VTK output.\n"
 	"  -f  Feature to export.\n"
 	"  -o  Output file.\n"
 	"  -m  Value multiplication factor.\n"
@@ -382,6 +394,9 @@ int             		main(
 	"and exports the features to an extended legacy ASCII VTK format\n"
 	"file.\n"
 	"If given all output values are multiplied by the given factor.\n"
+	"The points and values are written as ASCII unless binary output\n"
+	"is requested, in which case they are written as big-endian binary\n"
+	"floats.\n"
 	"The feature to export is identified by a single chaacter and must\n"
 	"be one of the following:\n"
 	"  *id char* *feature*\n"
@@ -481,12 +496,14 @@ static WlzErrorNum		WlzExtFFDefGrdJacScale(
 * \param	lObj		Eigen value object.
 * \param	eObj		Eigen vector object.
 * \param	mf		Value multiplication factor.
+* \param	dType		VTK data type, ASCII or binary.
 */
 static WlzErrorNum		WlzExtFFDefGrdWriteEigen(
 				  FILE *fP,
 				  WlzObject *lObj,
 				  WlzObject *eObj,
-				  double mf)
+				  double mf,
+				  WlzEffVtkDataType dType)
 {
   size_t	nPts;
   WlzValues 	nVal;
@@ -594,7 +611,7 @@ static WlzErrorNum		WlzExtFFDefGrdWriteEigen(
       n[3] = e[0] * mf; n[4] = e[1] * mf; n[5] = e[2] * mf; 
       n[6] = e[3] * mf; n[7] = e[4] * mf; n[8] = e[5] * mf; 
     }
-    errNum = WlzEffWritePointsVtkFieldValues(fP, nObj);
+    errNum = WlzEffWritePointsVtkFieldValuesDataType(fP, nObj, dType);
   }
   if(nObj)
   {
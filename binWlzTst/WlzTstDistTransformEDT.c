@@ -0,0 +1,355 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstDistTransformEDT_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstDistTransformEDT.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the exact Euclidean distance transform.
+* 		The foreground object is a sphere (or circle) with a
+* 		spherical hole and the reference object is a set of
+* 		randomly placed pixels/voxels, some of which lie outside
+* 		of the foreground object's bounding box. The distances
+* 		computed by WlzDistanceTransform() are compared with
+* 		those found by a brute force search of the reference
+* 		pixels/voxels.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static WlzObject		*WlzTstDistTransformEDTRef(
+				  WlzObjectType oType,
+				  int nRef,
+				  double radius,
+				  WlzIVertex3 *vtx,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		nErr = 0,
+		nRef = 20,
+		nTst = 0,
+		ok = 1,
+  		usage = 0;
+  long		seed = 0;
+  double	dMax = 0.0,
+  		radius = 12.0,
+		maxErr = 0.0;
+  const char	*errMsgStr;
+  WlzIVertex3	*vtx = NULL;
+  WlzObjectType	oType = WLZ_2D_DOMAINOBJ;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzObject	*dObj = NULL,
+  		*fObj = NULL,
+  		*rObj = NULL;
+  const double	tol = 1.0e-4;
+  static char   optList[] = "23hm:n:r:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        oType = WLZ_2D_DOMAINOBJ;
+	break;
+      case '3':
+        oType = WLZ_3D_DOMAINOBJ;
+	break;
+      case 'm':
+        if(sscanf(optarg, "%lg", &dMax) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nRef) != 1) || (nRef < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 2.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  /* Make the foreground object, a sphere with an off centre spherical
+   * hole, and the reference object. */
+  if(ok)
+  {
+    WlzObject	*o0 = NULL,
+    		*o1 = NULL;
+
+    AlgRandSeed(seed);
+    o0 = WlzAssignObject(
+         WlzMakeSphereObject(oType, radius, 0.0, 0.0, 0.0, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      o1 = WlzAssignObject(
+           WlzMakeSphereObject(oType, radius / 2.0, radius / 3.0, 0.0, 0.0,
+	                       &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      fObj = WlzAssignObject(WlzDiffDomain(o0, o1, &errNum), NULL);
+    }
+    (void )WlzFreeObj(o0);
+    (void )WlzFreeObj(o1);
+    if((errNum == WLZ_ERR_NONE) &&
+       ((vtx = (WlzIVertex3 *)
+	       AlcMalloc(nRef * sizeof(WlzIVertex3))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rObj = WlzTstDistTransformEDTRef(oType, nRef, radius, vtx, &errNum);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to make objects (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    dObj = WlzAssignObject(
+           WlzDistanceTransform(fObj, rObj, WLZ_EUCLIDEAN_DISTANCE, 0.0,
+	                        dMax, &errNum), NULL);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to compute distance transform (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+  }
+  /* Compare the distances with those found by brute force. */
+  if(ok)
+  {
+    WlzIterateWSpace *itWSp;
+
+    itWSp = WlzIterateInit(dObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    while((errNum == WLZ_ERR_NONE) &&
+          ((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE))
+    {
+      int	idV;
+      double	d,
+      		e,
+		d2 = DBL_MAX;
+
+      for(idV = 0; idV < nRef; ++idV)
+      {
+	double	t;
+	WlzDVertex3 del;
+
+	WLZ_VTX_3_SUB(del, vtx[idV], itWSp->pos);
+	t = WLZ_VTX_3_SQRLEN(del);
+	if(t < d2)
+	{
+	  d2 = t;
+	}
+      }
+      d = sqrt(d2);
+      if((dMax > 0.0) && (d > dMax))
+      {
+        d = 0.0;
+      }
+      e = fabs(d - *(itWSp->gP.flp));
+      if(e > maxErr)
+      {
+        maxErr = e;
+      }
+      if(e > tol * WLZ_MAX(d, 1.0))
+      {
+        ++nErr;
+      }
+      ++nTst;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    WlzIterateWSpFree(itWSp);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to iterate through distances (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+    else if(nErr > 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+                     "%s: Failed, %d of %d distances differ, maximum "
+		     "difference %g.\n",
+		     argv[0], nErr, nTst, maxErr);
+    }
+  }
+  AlcFree(vtx);
+  (void )WlzFreeObj(dObj);
+  (void )WlzFreeObj(fObj);
+  (void )WlzFreeObj(rObj);
+  if(ok)
+  {
+    (void )printf("%s: Passed (%d distances, maximum difference %g).\n",
+                  argv[0], nTst, maxErr);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2] [-3] [-h] [-m#] [-n#] [-r#] [-s#]\n"
+    "Test for the exact Euclidean distance transform. The distances from\n"
+    "randomly placed reference pixels (or voxels) to a sphere with a\n"
+    "spherical hole are compared with those found by a brute force\n"
+    "search.\n"
+    "Options are:\n"
+    "  -2  2D objects (default).\n"
+    "  -3  3D objects.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -m  Maximum distance, <= 0 for no maximum (%g).\n"
+    "  -n  Number of reference pixels/voxels (%d).\n"
+    "  -r  Radius of the foreground sphere (%g).\n"
+    "  -s  Seed for the random reference positions (%ld).\n",
+    argv[0], dMax, nRef, radius, seed);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New reference object.
+* \ingroup	BinWlzTst
+* \brief	Makes a reference object with pixels/voxels at random
+*		positions within a cube twice the size of the foreground
+*		sphere's bounding box.
+* \param	oType			Object type, either WLZ_2D_DOMAINOBJ
+*					or WLZ_3D_DOMAINOBJ.
+* \param	nRef			Number of reference pixels/voxels.
+* \param	radius			Radius of the foreground sphere.
+* \param	vtx			Array for the reference positions
+*					with room for nRef vertices.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzTstDistTransformEDTRef(
+				  WlzObjectType oType,
+				  int nRef,
+				  double radius,
+				  WlzIVertex3 *vtx,
+				  WlzErrorNum *dstErr)
+{
+  int		idR;
+  WlzObject	*rObj = NULL;
+  WlzObject	**objs;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((objs = (WlzObject **)AlcCalloc(nRef, sizeof(WlzObject *))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < nRef); ++idR)
+  {
+    int		idC;
+    int		p[3];
+
+    for(idC = 0; idC < 3; ++idC)
+    {
+      p[idC] = WLZ_NINT(4.0 * radius * (AlgRandUniform() - 0.5));
+    }
+    if(oType == WLZ_2D_DOMAINOBJ)
+    {
+      p[2] = 0;
+    }
+    WLZ_VTX_3_SET(vtx[idR], p[0], p[1], p[2]);
+    objs[idR] = WlzAssignObject(
+                WlzMakeSinglePixelObject(oType, p[0], p[1], p[2], &errNum),
+		NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzAssignObject(WlzUnionN(nRef, objs, 0, &errNum), NULL);
+  }
+  if(objs)
+  {
+    for(idR = 0; idR < nRef; ++idR)
+    {
+      (void )WlzFreeObj(objs[idR]);
+    }
+    AlcFree(objs);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
@@ -0,0 +1,555 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRankFilter_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRankFilter.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the rank filter on fragmented domains.
+* 		A rectangle (or cuboid) is given random values and then
+* 		thresholded to give an object with a fragmented domain.
+* 		The values of the thresholded object after filtering by
+* 		WlzRankFilter() are compared with those found by a brute
+* 		force sort of the in-domain values of each filter window.
+* 		The value mode selects which of the rank filter's paths
+* 		is used: small range integer values use a histogram, few
+* 		distinct values use a look up table and many distinct
+* 		values use a sorted window.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstRankFilterVal(
+				  double u,
+				  WlzGreyType gType,
+				  char vMode);
+static double			WlzTstRankFilterGet(
+				  WlzGreyP gP,
+				  WlzGreyType gType);
+static void			WlzTstRankFilterSet(
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  double v);
+static int			WlzTstRankFilterDblCmp(
+				  const void *p0,
+				  const void *p1);
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+  		fSz = 5,
+		nErr = 0,
+		nTst = 0,
+		nVx = 0,
+		ok = 1,
+  		usage = 0;
+  long		seed = 0;
+  double	rank = 0.5,
+		radius = 20.0;
+  char		vMode = 'h';
+  const char	*errMsgStr;
+  int		*msk = NULL;
+  double	*org = NULL,
+  		*win = NULL;
+  WlzIBox3	bBox;
+  WlzIVertex3	sz;
+  WlzGreyType	gType = WLZ_GREY_UBYTE;
+  WlzObjectType	oType = WLZ_2D_DOMAINOBJ;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzObject	*tObj = NULL,
+  		*vObj = NULL;
+  static char   optList[] = "23hf:g:r:R:s:v:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        oType = WLZ_2D_DOMAINOBJ;
+	break;
+      case '3':
+        oType = WLZ_3D_DOMAINOBJ;
+	break;
+      case 'f':
+        if((sscanf(optarg, "%d", &fSz) != 1) || (fSz < 0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'g':
+        switch(*optarg)
+	{
+	  case 'u':
+	    gType = WLZ_GREY_UBYTE;
+	    break;
+	  case 's':
+	    gType = WLZ_GREY_SHORT;
+	    break;
+	  case 'i':
+	    gType = WLZ_GREY_INT;
+	    break;
+	  case 'f':
+	    gType = WLZ_GREY_FLOAT;
+	    break;
+	  case 'd':
+	    gType = WLZ_GREY_DOUBLE;
+	    break;
+	  default:
+	    usage = 1;
+	    break;
+	}
+	break;
+      case 'r':
+        if(sscanf(optarg, "%lg", &rank) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'R':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 1.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        vMode = *optarg;
+	if((vMode != 'h') && (vMode != 'l') && (vMode != 's'))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) &&
+     ((optind != argc) ||
+      ((vMode != 'h') &&
+       ((gType == WLZ_GREY_UBYTE) || (gType == WLZ_GREY_SHORT)))))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  /* Make a rectangle (or cuboid) with random values, keeping a copy of
+   * the values, then threshold it to give a fragmented domain. */
+  if(ok)
+  {
+    WlzObject	*o0 = NULL;
+    WlzObjectType tType;
+    WlzPixelV	bgdV;
+
+    AlgRandSeed(seed);
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    o0 = WlzAssignObject(
+         WlzMakeCuboidObject(oType, radius, radius, radius / 2.0,
+	                     0.0, 0.0, 0.0, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      vObj = WlzAssignObject(
+             WlzNewObjectValues(o0, tType, bgdV, 0, bgdV, &errNum), NULL);
+    }
+    (void )WlzFreeObj(o0);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bBox = WlzBoundingBox3I(vObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      sz.vtX = bBox.xMax - bBox.xMin + 1;
+      sz.vtY = bBox.yMax - bBox.yMin + 1;
+      sz.vtZ = bBox.zMax - bBox.zMin + 1;
+      nVx = sz.vtX * sz.vtY * sz.vtZ;
+      if(((org = (double *)AlcMalloc(nVx * sizeof(double))) == NULL) ||
+         ((msk = (int *)AlcCalloc(nVx, sizeof(int))) == NULL) ||
+	 ((win = (double *)AlcMalloc((fSz * fSz * fSz + 1) *
+	                             sizeof(double))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      itWSp = WlzIterateInit(vObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      while((errNum == WLZ_ERR_NONE) &&
+	    ((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE))
+      {
+	double	v;
+
+	v = WlzTstRankFilterVal(AlgRandUniform(), gType, vMode);
+	WlzTstRankFilterSet(itWSp->gP, gType, v);
+	org[((itWSp->pos.vtZ - bBox.zMin) * sz.vtY +
+	     itWSp->pos.vtY - bBox.yMin) * sz.vtX +
+	    itWSp->pos.vtX - bBox.xMin] = v;
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzPixelV	thrV;
+
+      /* Threshold above the lowest 30% of the values. */
+      thrV.type = WLZ_GREY_DOUBLE;
+      thrV.v.dbv = WlzTstRankFilterVal(0.3, gType, vMode);
+      (void )WlzValueConvertPixel(&thrV, thrV, gType);
+      tObj = WlzAssignObject(
+             WlzThreshold(vObj, thrV, WLZ_THRESH_HIGH, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIterateWSpace *itWSp;
+
+      itWSp = WlzIterateInit(tObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+      while((errNum == WLZ_ERR_NONE) &&
+	    ((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE))
+      {
+	msk[((itWSp->pos.vtZ - bBox.zMin) * sz.vtY +
+	     itWSp->pos.vtY - bBox.yMin) * sz.vtX +
+	    itWSp->pos.vtX - bBox.xMin] = 1;
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+      WlzIterateWSpFree(itWSp);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to make objects (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    errNum = WlzRankFilter(tObj, fSz, rank);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to rank filter object (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+  }
+  /* Compare the filtered values with those found by sorting the
+   * in-domain values of each window. The window and rank follow
+   * WlzRankFilter(): the window of a voxel at p covers p - h to
+   * p - h + fSz - 1 on each axis with h = fSz / 2 and the value is
+   * that with index floor(n * rank) of the n sorted in-domain values,
+   * unless n is less than two. */
+  if(ok)
+  {
+    int		h;
+    double	rnk;
+    WlzIterateWSpace *itWSp;
+
+    h = fSz / 2;
+    rnk = ALG_MIN(ALG_MAX(rank, DBL_EPSILON), 1.0 - DBL_EPSILON);
+    itWSp = WlzIterateInit(tObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+    while((errNum == WLZ_ERR_NONE) &&
+          ((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE))
+    {
+      int	n = 0;
+      double	v;
+      WlzIVertex3 p,
+      		  w0,
+      		  w1;
+
+      p.vtX = itWSp->pos.vtX - bBox.xMin;
+      p.vtY = itWSp->pos.vtY - bBox.yMin;
+      p.vtZ = itWSp->pos.vtZ - bBox.zMin;
+      w0.vtX = ALG_MAX(p.vtX - h, 0);
+      w0.vtY = ALG_MAX(p.vtY - h, 0);
+      w0.vtZ = (sz.vtZ > 1)? ALG_MAX(p.vtZ - h, 0): 0;
+      w1.vtX = ALG_MIN(p.vtX - h + fSz - 1, sz.vtX - 1);
+      w1.vtY = ALG_MIN(p.vtY - h + fSz - 1, sz.vtY - 1);
+      w1.vtZ = (sz.vtZ > 1)? ALG_MIN(p.vtZ - h + fSz - 1, sz.vtZ - 1): 0;
+      for(p.vtZ = w0.vtZ; p.vtZ <= w1.vtZ; ++(p.vtZ))
+      {
+        for(p.vtY = w0.vtY; p.vtY <= w1.vtY; ++(p.vtY))
+	{
+	  for(p.vtX = w0.vtX; p.vtX <= w1.vtX; ++(p.vtX))
+	  {
+	    int	i;
+
+	    i = (p.vtZ * sz.vtY + p.vtY) * sz.vtX + p.vtX;
+	    if(msk[i])
+	    {
+	      win[n++] = org[i];
+	    }
+	  }
+	}
+      }
+      if(n > 1)
+      {
+        qsort(win, n, sizeof(double), WlzTstRankFilterDblCmp);
+	v = win[(int )floor(n * rnk)];
+      }
+      else
+      {
+        v = org[((itWSp->pos.vtZ - bBox.zMin) * sz.vtY +
+	         itWSp->pos.vtY - bBox.yMin) * sz.vtX +
+		itWSp->pos.vtX - bBox.xMin];
+      }
+      if(v != WlzTstRankFilterGet(itWSp->gP, gType))
+      {
+        ++nErr;
+      }
+      ++nTst;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    WlzIterateWSpFree(itWSp);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to iterate through values (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+    else if(nErr > 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+                     "%s: Failed, %d of %d values differ.\n",
+		     argv[0], nErr, nTst);
+    }
+  }
+  AlcFree(org);
+  AlcFree(msk);
+  AlcFree(win);
+  (void )WlzFreeObj(tObj);
+  (void )WlzFreeObj(vObj);
+  if(ok)
+  {
+    (void )printf("%s: Passed (%d values).\n", argv[0], nTst);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2] [-3] [-h] [-f#] [-g<type>] [-r#] [-R#] [-s#]\n"
+    "\t\t[-v<mode>]\n"
+    "Test for the rank filter. A rectangle (or cuboid) with random values\n"
+    "is thresholded to give a fragmented domain, rank filtered and the\n"
+    "filtered values are compared with those found by a brute force sort\n"
+    "of the in-domain values of each filter window.\n"
+    "Options are:\n"
+    "  -2  2D objects (default).\n"
+    "  -3  3D objects.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -f  Filter size (%d).\n"
+    "  -g  Grey type: u, s, i, f or d for unsigned byte, short, int, float\n"
+    "      or double (u).\n"
+    "  -r  Rank, 0.0 for a minimum and 1.0 for a maximum filter (%g).\n"
+    "  -R  Half width of the rectangle (or cuboid) (%g).\n"
+    "  -s  Seed for the random values (%ld).\n"
+    "  -v  Value mode: h for integer values in [0-255] which are ranked\n"
+    "      using a histogram, l for 1000 distinct values with a wide range\n"
+    "      which are ranked using a look up table and s for values which\n"
+    "      are all distinct and ranked using a sorted window. The l and s\n"
+    "      modes are only valid for int, float and double values and the\n"
+    "      s mode needs more than 65535 voxels in the domain to use a\n"
+    "      sorted window, eg -3 -R 32 (%c).\n",
+    argv[0], fSz, rank, radius, seed, vMode);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Value for the given grey type and value mode.
+* \ingroup	BinWlzTst
+* \brief	Computes a value from the given uniform random number
+* 		which is representable by the grey type and increases
+* 		monotonically with the random number.
+* \param	u			Random number in the interval [0, 1).
+* \param	gType			Grey type.
+* \param	vMode			Value mode, see usage.
+*/
+static double			WlzTstRankFilterVal(
+				  double u,
+				  WlzGreyType gType,
+				  char vMode)
+{
+  double	v = 0.0;
+
+  switch(vMode)
+  {
+    case 'h':
+      v = floor(u * 256.0);
+      break;
+    case 'l':
+      v = floor(u * 1000.0);
+      v = (gType == WLZ_GREY_INT)? v * 100000.0: v * 0.5;
+      break;
+    case 's':
+      v = (gType == WLZ_GREY_INT)? floor((u - 0.5) * 2.0e9):
+          (gType == WLZ_GREY_FLOAT)? (float )((u - 0.5) * 1000.0):
+	  (u - 0.5) * 1000.0;
+      break;
+    default:
+      break;
+  }
+  return(v);
+}
+
+/*!
+* \return	Value as a double.
+* \ingroup	BinWlzTst
+* \brief	Gets the value at the given grey pointer.
+* \param	gP			Grey pointer.
+* \param	gType			Grey type.
+*/
+static double			WlzTstRankFilterGet(
+				  WlzGreyP gP,
+				  WlzGreyType gType)
+{
+  double	v = 0.0;
+
+  switch(gType)
+  {
+    case WLZ_GREY_UBYTE:
+      v = *(gP.ubp);
+      break;
+    case WLZ_GREY_SHORT:
+      v = *(gP.shp);
+      break;
+    case WLZ_GREY_INT:
+      v = *(gP.inp);
+      break;
+    case WLZ_GREY_FLOAT:
+      v = *(gP.flp);
+      break;
+    case WLZ_GREY_DOUBLE:
+      v = *(gP.dbp);
+      break;
+    default:
+      break;
+  }
+  return(v);
+}
+
+/*!
+* \ingroup	BinWlzTst
+* \brief	Sets the value at the given grey pointer.
+* \param	gP			Grey pointer.
+* \param	gType			Grey type.
+* \param	v			Value which is representable by the
+* 					grey type.
+*/
+static void			WlzTstRankFilterSet(
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  double v)
+{
+  switch(gType)
+  {
+    case WLZ_GREY_UBYTE:
+      *(gP.ubp) = (WlzUByte )v;
+      break;
+    case WLZ_GREY_SHORT:
+      *(gP.shp) = (short )v;
+      break;
+    case WLZ_GREY_INT:
+      *(gP.inp) = (int )v;
+      break;
+    case WLZ_GREY_FLOAT:
+      *(gP.flp) = (float )v;
+      break;
+    case WLZ_GREY_DOUBLE:
+      *(gP.dbp) = v;
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \return	Negative, zero or positive for less than, equal or
+* 		greater than.
+* \ingroup	BinWlzTst
+* \brief	Compares two doubles for qsort().
+* \param	p0			Pointer to first double.
+* \param	p1			Pointer to second double.
+*/
+static int			WlzTstRankFilterDblCmp(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d0,
+  		d1;
+
+  d0 = *(const double *)p0;
+  d1 = *(const double *)p1;
+  return((d0 < d1)? -1: (d0 > d1));
+}
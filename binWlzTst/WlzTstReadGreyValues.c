@@ -0,0 +1,257 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstReadGreyValues_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstReadGreyValues.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Benchmark for reading grey values with WlzReadObj(),
+* 		reporting the read rate for each grey type and checking
+* 		that the values read are the same as those written.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char	*optarg;
+extern int	optind,
+		opterr,
+		optopt;
+
+int		main(int argc, char *argv[])
+{
+  int		idG,
+  		idR,
+  		option,
+  		ok = 1,
+		usage = 0,
+		nRep = 4;
+  double	radius = 100.0;
+  FILE		*fP = NULL;
+  char		*inFileStr = NULL;
+  WlzObject	*inObj = NULL,
+  		*incObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsg;
+  static char	optList[] = "hn:r:";
+  const WlzGreyType gTypes[] =
+  {
+    WLZ_GREY_UBYTE,
+    WLZ_GREY_SHORT,
+    WLZ_GREY_INT,
+    WLZ_GREY_FLOAT,
+    WLZ_GREY_DOUBLE,
+    WLZ_GREY_RGBA
+  };
+  const int	nGTypes = sizeof(gTypes) / sizeof(WlzGreyType);
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'n':
+        if((sscanf(optarg, "%d", &nRep) != 1) || (nRep < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 1.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind < argc))
+  {
+    if((optind + 1) != argc)
+    {
+      usage = 1;
+    }
+    else
+    {
+      inFileStr = *(argv + optind);
+    }
+  }
+  ok = !usage;
+  /* Either read the given domain object or make a sphere. */
+  if(ok)
+  {
+    if(inFileStr)
+    {
+      errNum = WLZ_ERR_READ_EOF;
+      if(((fP = (strcmp(inFileStr, "-")? fopen(inFileStr, "r"):
+					 stdin)) == NULL) ||
+	 ((inObj= WlzAssignObject(WlzReadObj(fP, &errNum), NULL)) == NULL))
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsg);
+	(void )fprintf(stderr,
+		       "%s: Failed to read object from file %s (%s).\n",
+		       *argv, inFileStr, errMsg);
+      }
+      if(fP && strcmp(inFileStr, "-"))
+      {
+	(void )fclose(fP);
+      }
+      fP = NULL;
+    }
+    else
+    {
+      inObj = WlzAssignObject(
+              WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, radius, 0.0, 0.0, 0.0,
+	                          &errNum), NULL);
+      if(errNum != WLZ_ERR_NONE)
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsg);
+	(void )fprintf(stderr,
+		       "%s: Failed to create sphere object (%s).\n",
+		       *argv, errMsg);
+      }
+    }
+  }
+  /* Give the object incrementing values so that the full range of each
+   * grey type's packing is used. */
+  if(ok)
+  {
+    incObj = WlzAssignObject(
+             WlzGreyNewIncValues(inObj, &errNum), NULL);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+		     "%s: Failed to set object values (%s).\n",
+		     *argv, errMsg);
+    }
+  }
+  if(ok && ((fP = tmpfile()) == NULL))
+  {
+    ok = 0;
+    (void )fprintf(stderr, "%s: Failed to open temporary file.\n", *argv);
+  }
+  for(idG = 0; ok && (idG < nGTypes); ++idG)
+  {
+    long	nBytes = 0;
+    double	sec,
+		sum[2];
+    WlzObject	*gObj = NULL;
+    struct timeval times[3];
+
+    gObj = WlzAssignObject(
+           WlzConvertPix(incObj, gTypes[idG], &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rewind(fP);
+      errNum = WlzWriteObj(fP, gObj);
+      (void )fflush(fP);
+      nBytes = ftell(fP);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzGreyStats(gObj, NULL, NULL, NULL, sum + 0, NULL, NULL, NULL,
+                          &errNum);
+    }
+    sec = 0.0;
+    for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < nRep); ++idR)
+    {
+      WlzObject	*rObj;
+
+      rewind(fP);
+      gettimeofday(times + 0, NULL);
+      rObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL);
+      gettimeofday(times + 1, NULL);
+      ALC_TIMERSUB(times + 1, times + 0, times + 2);
+      sec += times[2].tv_sec + (0.000001 * times[2].tv_usec);
+      if((errNum == WLZ_ERR_NONE) && (idR == 0))
+      {
+        (void )WlzGreyStats(rObj, NULL, NULL, NULL, sum + 1,
+	                    NULL, NULL, NULL, &errNum);
+	if((errNum == WLZ_ERR_NONE) && (sum[0] != sum[1]))
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+      (void )WlzFreeObj(rObj);
+    }
+    (void )WlzFreeObj(gObj);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )printf("%-16s %12ld bytes %10.3f MB/s\n",
+                    WlzStringFromGreyType(gTypes[idG], NULL), nBytes,
+		    (sec > 0.0)? (nRep * nBytes) / (1.0e6 * sec): 0.0);
+    }
+    else
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+		     "%s: Failed to write and read back %s values (%s).\n",
+		     *argv, WlzStringFromGreyType(gTypes[idG], NULL), errMsg);
+    }
+  }
+  if(fP)
+  {
+    (void )fclose(fP);
+  }
+  (void )WlzFreeObj(incObj);
+  (void )WlzFreeObj(inObj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-h] [-n#] [-r#] [<input object>]\n"
+    "Benchmarks reading grey values for each grey type. The given domain\n"
+    "object (or a sphere) is given incrementing values which are converted\n"
+    "to each grey type, written to a temporary file and then read back.\n"
+    "The read rate is reported and the values read back are checked.\n"
+    "Options:\n"
+    "  -h  Prints this usage information.\n"
+    "  -n  Number of times each object is read.\n"
+    "  -r  Radius of the sphere used when no input object is given.\n");
+  }
+  return(!ok);
+}
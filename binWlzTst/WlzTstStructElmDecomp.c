@@ -0,0 +1,220 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstStructElmDecomp_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstStructElmDecomp.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Regression test for structuring element decomposition.
+* 		A single pixel (or voxel) object is dilated by an
+* 		unassigned (zero link count) sphere structuring element,
+* 		which must give the sphere, and the result is then eroded
+* 		by the same element, which must give the single pixel.
+* 		The structuring element is used repeatedly and freed only
+* 		at the end so that any change to its link count by the
+* 		decomposition is detected.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static WlzLong			WlzTstStructElmDecompSize(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idR,
+		option,
+		nRep = 3,
+		ok = 1,
+  		usage = 0;
+  double	radius = 3.0;
+  const char	*errMsgStr;
+  WlzObjectType	oType = WLZ_2D_DOMAINOBJ;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzObject	*pObj = NULL,
+  		*sObj = NULL;
+  static char   optList[] = "23hn:r:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        oType = WLZ_2D_DOMAINOBJ;
+	break;
+      case '3':
+        oType = WLZ_3D_DOMAINOBJ;
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nRep) != 1) || (nRep < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 1.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    /* The single pixel object is assigned but the structuring element
+     * is deliberately left with a zero link count, as callers of
+     * WlzStructDilation() and WlzStructErosion() usually do. */
+    pObj = WlzAssignObject(
+           WlzMakeSinglePixelObject(oType, 0, 0, 0, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      sObj = WlzMakeSphereObject(oType, radius, 0.0, 0.0, 0.0, &errNum);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to make objects (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+  }
+  for(idR = 0; ok && (idR < nRep); ++idR)
+  {
+    WlzLong	sSz = 0,
+    		dSz = 0,
+		eSz = 0;
+    WlzObject	*dObj = NULL,
+    		*eObj = NULL;
+
+    sSz = WlzTstStructElmDecompSize(sObj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dObj = WlzAssignObject(WlzStructDilation(pObj, sObj, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dSz = WlzTstStructElmDecompSize(dObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      eObj = WlzAssignObject(WlzStructErosion(dObj, sObj, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      eSz = WlzTstStructElmDecompSize(eObj, &errNum);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+	             "%s: Failed to dilate or erode (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+    else if((sObj->linkcount != 0) || (dSz != sSz) || (eSz != 1))
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+                     "%s: Failed, repeat %d, link count %d, element size "
+		     "%ld, dilated size %ld, eroded size %ld.\n",
+		     argv[0], idR, sObj->linkcount,
+		     (long )sSz, (long )dSz, (long )eSz);
+    }
+    (void )WlzFreeObj(eObj);
+    (void )WlzFreeObj(dObj);
+  }
+  (void )WlzFreeObj(sObj);
+  (void )WlzFreeObj(pObj);
+  if(ok)
+  {
+    (void )printf("%s: Passed.\n", argv[0]);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2] [-3] [-h] [-n#] [-r#]\n"
+    "Regression test for structuring element decomposition. A single\n"
+    "pixel (or voxel) is dilated by an unassigned sphere structuring\n"
+    "element and the result eroded by the same element, which is reused\n"
+    "for each repeat.\n"
+    "Options are:\n"
+    "  -2  2D objects (default).\n"
+    "  -3  3D objects.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -n  Number of repeats (%d).\n"
+    "  -r  Radius of the structuring element (%g).\n",
+    argv[0], nRep, radius);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Area or volume of the given object.
+* \ingroup	BinWlzTst
+* \brief	Computes the area of a 2D or the volume of a 3D domain
+* 		object.
+* \param	obj			Given object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzLong			WlzTstStructElmDecompSize(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr)
+{
+  return((obj->type == WLZ_3D_DOMAINOBJ)? WlzVolume(obj, dstErr):
+                                          WlzArea(obj, dstErr));
+}
@@ -48,6 +48,13 @@ static char _AlcAlloc_c[] = "University of Edinburgh $Id$";
 #include <string.h>
 #include <Alc.h>
 
+static void			AlcAllocCountAdd(
+				  size_t byteCount);
+
+static int			alcAllocCountOn = 0;
+static size_t			alcAllocCountBytes = 0,
+				alcAllocCountCalls = 0;
+
 /*!
 * \return	Allocated storage or NULL on error.
 * \ingroup	AlcAlloc
@@ -64,6 +71,10 @@ void		*AlcCalloc(size_t elCount, size_t elSz)
   if((elCount > 0) && (elSz > 0))
   {
     data = calloc(elCount, elSz);
+    if(alcAllocCountOn)
+    {
+      AlcAllocCountAdd(elCount * elSz);
+    }
   }
   return(data);
 }
@@ -82,6 +93,10 @@ void		*AlcMalloc(size_t byteCount)
   if(byteCount > 0)
   {
     data = malloc(byteCount);
+    if(alcAllocCountOn)
+    {
+      AlcAllocCountAdd(byteCount);
+    }
   }
   return(data);
 }
@@ -101,6 +116,10 @@ void		*AlcRealloc(void *givenData, size_t byteCount)
   if(byteCount > 0)
   {
     data = realloc(givenData, byteCount);
+    if(alcAllocCountOn)
+    {
+      AlcAllocCountAdd(byteCount);
+    }
   }
   return(data);
 }
@@ -118,3 +137,59 @@ void		AlcFree(void *data)
     free(data);
   }
 }
+
+/*!
+* \return	void
+* \ingroup	AlcAlloc
+* \brief	Enables or disables counting of the allocations made by
+*		AlcCalloc(), AlcMalloc() and AlcRealloc(). Counting is
+*		disabled by default, when its only cost is a test of a
+*		flag. The counts are not reset by this function.
+* \param	on			Counting is enabled if non-zero.
+*/
+void		AlcAllocCountSet(int on)
+{
+  alcAllocCountOn = on;
+}
+
+/*!
+* \return	void
+* \ingroup	AlcAlloc
+* \brief	Gets the number of bytes requested and the number of
+*		allocations made while counting was enabled. For
+*		AlcRealloc() the whole of the new size is counted.
+*		The counts are for all threads.
+* \param	dstBytes		Destination pointer for the number of
+*					bytes, may be NULL.
+* \param	dstCalls		Destination pointer for the number of
+*					allocations, may be NULL.
+*/
+void		AlcAllocCountGet(size_t *dstBytes, size_t *dstCalls)
+{
+  if(dstBytes)
+  {
+    *dstBytes = alcAllocCountBytes;
+  }
+  if(dstCalls)
+  {
+    *dstCalls = alcAllocCountCalls;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlcAlloc
+* \brief	Adds an allocation to the allocation counts.
+* \param	byteCount		Number of bytes allocated.
+*/
+static void	AlcAllocCountAdd(size_t byteCount)
+{
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  alcAllocCountBytes += byteCount;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  ++alcAllocCountCalls;
+}
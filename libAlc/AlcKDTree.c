@@ -85,6 +85,71 @@ static AlcKDTNode 		*AlcKDTNodeGetNN(
 				  AlcPointP key,
 				  double minDist,
 				  double *dstDist);
+static void			AlcKDTFlatBuild(
+				  AlcKDTFlat *tree,
+				  double *keys,
+				  size_t *perm,
+				  size_t lo,
+				  size_t hi);
+static void			AlcKDTFlatSelect(
+				  double *keys,
+				  int dim,
+				  int s,
+				  size_t *perm,
+				  long lo,
+				  long hi,
+				  long m);
+static double			AlcKDTFlatDistSq(
+				  AlcKDTFlat *tree,
+				  size_t idN,
+				  double *q);
+static void			AlcKDTFlatKNNInsert(
+				  size_t k,
+				  size_t *nK,
+				  double *w,
+				  size_t *idx,
+				  double *d2,
+				  size_t id,
+				  double e);
+static void			AlcKDTFlatRadiusInsert(
+				  size_t maxNbr,
+				  size_t *nK,
+				  size_t *idx,
+				  double *d2,
+				  size_t id,
+				  double e);
+static size_t			AlcKDTFlatKNN(
+				  AlcKDTFlat *tree,
+				  double *q,
+				  size_t k,
+				  double maxD2,
+				  size_t *idx,
+				  double *d2);
+static size_t			AlcKDTFlatRadius(
+				  AlcKDTFlat *tree,
+				  double *q,
+				  double r2,
+				  size_t maxNbr,
+				  size_t *idx,
+				  double *d2);
+
+/*!
+* \def		ALC_KDT_FLAT_LEAFSZ
+* \ingroup	AlcKDTree
+* \brief	Maximum number of keys in a leaf of a flat kD-tree. The
+*		keys of a leaf are contiguous and are compared by a
+*		simple scan.
+*/
+#define ALC_KDT_FLAT_LEAFSZ	(8)
+
+/*!
+* \def		ALC_KDT_FLAT_MAXDEPTH
+* \ingroup	AlcKDTree
+* \brief	Size of the range stack used when searching a flat
+*		kD-tree. Because nodes split at their median this is
+*		greater than the depth of any flat kD-tree.
+*/
+#define ALC_KDT_FLAT_MAXDEPTH	(64)
 
 /*!
 * \return     	KD-tree data structure, or NULL on error.
@@ -1054,6 +1119,679 @@ static int	AlcKDTNodeValueCompare(AlcKDTTree *tree, AlcKDTNode *node,
   return(cmp);
 }
 
+/*!
+* \return	New flat kD-tree, or NULL on error.
+* \ingroup	AlcKDTree
+* \brief	Creates a balanced kD-tree from all of the given keys
+*		at once. The keys are recursively split at their median
+*		along the dimension in which the range of keys is widest
+*		and are then copied into a contiguous array in tree
+*		order, so that a search visits memory far more coherently
+*		than in a tree built by AlcKDTInsert(). Integer keys are
+*		converted to double precision values. Duplicate keys
+*		are kept.
+* \param	type			Type of the given keys.
+* \param	dim			Dimension of the keys (must be in the
+*					range [1-255]).
+* \param	nKeys			Number of keys (must be >= 1).
+* \param	keys			Keys, with dim values per key.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+AlcKDTFlat	*AlcKDTFlatNew(AlcPointType type, int dim, size_t nKeys,
+			       void *keys, AlcErrno *dstErr)
+{
+  size_t	idN,
+  		nV;
+  double	*dKeys = NULL;
+  AlcKDTFlat	*tree = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if(keys == NULL)
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if((dim < 1) || (dim > UCHAR_MAX) ||
+          ((type != ALC_POINTTYPE_INT) && (type != ALC_POINTTYPE_DBL)))
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else if(nKeys < 1)
+  {
+    errNum = ALC_ER_NUMELEM;
+  }
+  else
+  {
+    nV = nKeys * dim;
+    if(((tree = (AlcKDTFlat *)AlcCalloc(1, sizeof(AlcKDTFlat))) == NULL) ||
+       ((tree->key = (double *)AlcMalloc(sizeof(double) * nV)) == NULL) ||
+       ((tree->idx = (size_t *)AlcMalloc(sizeof(size_t) * nKeys)) == NULL) ||
+       ((tree->split = (unsigned char *)
+                       AlcCalloc(nKeys, sizeof(unsigned char))) == NULL))
+    {
+      errNum = ALC_ER_ALLOC;
+    }
+  }
+  /* Build the tree using a permutation of the given keys, converting
+   * integer keys to a temporary array of doubles first. */
+  if(errNum == ALC_ER_NONE)
+  {
+    tree->dim = dim;
+    tree->nKeys = nKeys;
+    tree->leafSz = ALC_KDT_FLAT_LEAFSZ;
+    if(type == ALC_POINTTYPE_DBL)
+    {
+      dKeys = (double *)keys;
+    }
+    else if((dKeys = (double *)AlcMalloc(sizeof(double) * nV)) == NULL)
+    {
+      errNum = ALC_ER_ALLOC;
+    }
+    else
+    {
+      for(idN = 0; idN < nV; ++idN)
+      {
+        dKeys[idN] = *((int *)keys + idN);
+      }
+    }
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    for(idN = 0; idN < nKeys; ++idN)
+    {
+      tree->idx[idN] = idN;
+    }
+    AlcKDTFlatBuild(tree, dKeys, tree->idx, 0, nKeys);
+    for(idN = 0; idN < nKeys; ++idN)
+    {
+      int	idD;
+      double	*k0,
+		*k1;
+
+      k0 = tree->key + (idN * dim);
+      k1 = dKeys + (tree->idx[idN] * dim);
+      for(idD = 0; idD < dim; ++idD)
+      {
+        k0[idD] = k1[idD];
+      }
+    }
+  }
+  if(dKeys != (double *)keys)
+  {
+    AlcFree(dKeys);
+  }
+  if(errNum != ALC_ER_NONE)
+  {
+    (void )AlcKDTFlatFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDTree
+* \brief	Frees the given flat kD-tree.
+* \param	tree			The flat kD-tree.
+*/
+AlcErrno	AlcKDTFlatFree(AlcKDTFlat *tree)
+{
+  if(tree)
+  {
+    AlcFree(tree->key);
+    AlcFree(tree->idx);
+    AlcFree(tree->split);
+    AlcFree(tree);
+  }
+  return(ALC_ER_NONE);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDTree
+* \brief	Finds the k nearest neighbours in the given flat kD-tree
+*		of each of the given query keys. The tree is not modified
+*		by a search, so this function may be called concurrently
+*		from several threads. When built with OpenMP the queries
+*		are themselves shared between threads.
+*
+*		The neighbours of each query are returned in order of
+*		increasing distance. If fewer than k neighbours are found
+*		(because the tree has fewer than k keys or because of
+*		the maximum distance) the remaining entries have index
+*		equal to the number of keys in the tree and distance
+*		DBL_MAX.
+* \param	tree			The flat kD-tree.
+* \param	nQ			Number of query keys.
+* \param	qKeys			Query keys, with the tree's
+*					dimension of values per key.
+* \param	k			Number of neighbours to find for
+*					each query key.
+* \param	maxDist			Neighbours must be closer than this
+*					distance to the query key.
+* \param	dstIdx			Destination array for nQ * k
+*					neighbour indices, these are the
+*					indices of the keys in the array
+*					the tree was built from.
+* \param	dstDist			Destination array for nQ * k
+*					neighbour distances.
+* \param	dstCnt			Destination array for the number
+*					of neighbours found for each query
+*					key, may be NULL.
+*/
+AlcErrno	AlcKDTFlatGetKNN(AlcKDTFlat *tree, size_t nQ, double *qKeys,
+				 size_t k, double maxDist,
+				 size_t *dstIdx, double *dstDist,
+				 size_t *dstCnt)
+{
+  long		idQ;
+  double	maxD2;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (qKeys == NULL) ||
+     (dstIdx == NULL) || (dstDist == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(maxDist < 0.0)
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else if(k > 0)
+  {
+    maxD2 = (maxDist < sqrt(DBL_MAX))? maxDist * maxDist: DBL_MAX;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idQ = 0; idQ < (long )nQ; ++idQ)
+    {
+      size_t	idK,
+      		nK;
+      size_t	*idx;
+      double	*dist;
+
+      idx = dstIdx + (idQ * k);
+      dist = dstDist + (idQ * k);
+      nK = AlcKDTFlatKNN(tree, qKeys + (idQ * tree->dim), k, maxD2,
+                         idx, dist);
+      for(idK = 0; idK < nK; ++idK)
+      {
+        dist[idK] = sqrt(dist[idK]);
+      }
+      for(idK = nK; idK < k; ++idK)
+      {
+        idx[idK] = tree->nKeys;
+	dist[idK] = DBL_MAX;
+      }
+      if(dstCnt)
+      {
+        dstCnt[idQ] = nK;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDTree
+* \brief	Finds the keys in the given flat kD-tree which are
+*		closer than the given radius to each of the given query
+*		keys. As with AlcKDTFlatGetKNN() this function may be
+*		called concurrently from several threads and when built
+*		with OpenMP the queries are shared between threads.
+*
+*		At most maxNbr neighbours are returned for each query
+*		key, in no particular order, but the number returned in
+*		dstCnt is the number of keys found within the radius,
+*		which will be greater than maxNbr if some were not
+*		returned.
+* \param	tree			The flat kD-tree.
+* \param	nQ			Number of query keys.
+* \param	qKeys			Query keys, with the tree's
+*					dimension of values per key.
+* \param	radius			Neighbours must be closer than this
+*					distance to the query key.
+* \param	maxNbr			Maximum number of neighbours
+*					returned for each query key.
+* \param	dstIdx			Destination array for nQ * maxNbr
+*					neighbour indices, these are the
+*					indices of the keys in the array
+*					the tree was built from.
+* \param	dstDist			Destination array for nQ * maxNbr
+*					neighbour distances, may be NULL.
+* \param	dstCnt			Destination array for the number
+*					of keys within the radius of each
+*					query key.
+*/
+AlcErrno	AlcKDTFlatGetRadius(AlcKDTFlat *tree, size_t nQ,
+				    double *qKeys, double radius,
+				    size_t maxNbr, size_t *dstIdx,
+				    double *dstDist, size_t *dstCnt)
+{
+  long		idQ;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (qKeys == NULL) ||
+     (dstIdx == NULL) || (dstCnt == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if((radius < 0.0) || (radius >= sqrt(DBL_MAX)))
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idQ = 0; idQ < (long )nQ; ++idQ)
+    {
+      size_t	idK,
+      		nK;
+      double	*dist;
+
+      dist = (dstDist)? dstDist + (idQ * maxNbr): NULL;
+      nK = AlcKDTFlatRadius(tree, qKeys + (idQ * tree->dim),
+                            radius * radius, maxNbr,
+			    dstIdx + (idQ * maxNbr), dist);
+      if(dist)
+      {
+	for(idK = 0; (idK < nK) && (idK < maxNbr); ++idK)
+	{
+	  dist[idK] = sqrt(dist[idK]);
+	}
+      }
+      dstCnt[idQ] = nK;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Recursively builds the flat kD-tree for the given range
+*		of the permutation of keys. The median key along the
+*		dimension in which the keys of the range are most widely
+*		spread becomes the key of the range's node, with the
+*		keys before and after it forming the node's children.
+* \param	tree			The flat kD-tree.
+* \param	keys			Keys the tree is built from.
+* \param	perm			Permutation of the keys which is
+*					reordered into tree order.
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the range.
+*/
+static void	AlcKDTFlatBuild(AlcKDTFlat *tree, double *keys,
+				size_t *perm, size_t lo, size_t hi)
+{
+  int		idD,
+  		sD = 0;
+  size_t	idN,
+  		m;
+  double	w,
+  		wMax = -1.0;
+
+  if((hi - lo) > tree->leafSz)
+  {
+    for(idD = 0; idD < tree->dim; ++idD)
+    {
+      double	v,
+		vMin,
+		vMax;
+
+      vMin = vMax = keys[(perm[lo] * tree->dim) + idD];
+      for(idN = lo + 1; idN < hi; ++idN)
+      {
+	v = keys[(perm[idN] * tree->dim) + idD];
+	if(v < vMin)
+	{
+	  vMin = v;
+	}
+	else if(v > vMax)
+	{
+	  vMax = v;
+	}
+      }
+      if((w = vMax - vMin) > wMax)
+      {
+	wMax = w;
+	sD = idD;
+      }
+    }
+    m = (lo + hi) / 2;
+    AlcKDTFlatSelect(keys, tree->dim, sD, perm, lo, hi, m);
+    tree->split[m] = (unsigned char )sD;
+    AlcKDTFlatBuild(tree, keys, perm, lo, m); 			/* Recursive */
+    AlcKDTFlatBuild(tree, keys, perm, m + 1, hi); 		/* Recursive */
+  }
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Partially sorts the given range of the permutation of
+*		keys so that the key at the given index has the value
+*		it would have were the range sorted by the given
+*		dimension, with no greater values before it and no
+*		smaller values after it.
+* \param	keys			Keys.
+* \param	dim			Dimension of the keys.
+* \param	s			Dimension to sort by.
+* \param	perm			Permutation of the keys.
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the range.
+* \param	m			Index of the required key.
+*/
+static void	AlcKDTFlatSelect(double *keys, int dim, int s,
+				 size_t *perm, long lo, long hi, long m)
+{
+  long		i,
+  		j;
+  size_t	t;
+  double	p;
+
+  --hi;
+  while(lo < hi)
+  {
+    p = keys[(perm[(lo + hi) / 2] * dim) + s];
+    i = lo;
+    j = hi;
+    while(i <= j)
+    {
+      while(keys[(perm[i] * dim) + s] < p)
+      {
+        ++i;
+      }
+      while(keys[(perm[j] * dim) + s] > p)
+      {
+        --j;
+      }
+      if(i <= j)
+      {
+        t = perm[i];
+	perm[i] = perm[j];
+	perm[j] = t;
+	++i;
+	--j;
+      }
+    }
+    if(m <= j)
+    {
+      hi = j;
+    }
+    else if(m >= i)
+    {
+      lo = i;
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+/*!
+* \return	Squared distance.
+* \ingroup	AlcKDTree
+* \brief	Computes the squared distance between a key of the given
+*		flat kD-tree and a query key.
+* \param	tree			The flat kD-tree.
+* \param	idN			Index of the key in tree order.
+* \param	q			Query key.
+*/
+static double	AlcKDTFlatDistSq(AlcKDTFlat *tree, size_t idN, double *q)
+{
+  int		idD;
+  double	e = 0.0;
+  double	*key;
+
+  key = tree->key + (idN * tree->dim);
+  for(idD = 0; idD < tree->dim; ++idD)
+  {
+    double	t;
+
+    t = key[idD] - q[idD];
+    e += t * t;
+  }
+  return(e);
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Inserts a neighbour into the ordered list of the k
+*		nearest neighbours found so far, updating the squared
+*		distance which any further neighbour must be closer than
+*		once there are k neighbours.
+* \param	k			Number of neighbours required.
+* \param	nK			Number of neighbours found so far.
+* \param	w			Squared distance any further
+*					neighbour must be closer than.
+* \param	idx			Neighbour indices.
+* \param	d2			Squared neighbour distances.
+* \param	id			Index of the new neighbour.
+* \param	e			Squared distance of the new
+*					neighbour, which must be less
+*					than w.
+*/
+static void	AlcKDTFlatKNNInsert(size_t k, size_t *nK, double *w,
+				    size_t *idx, double *d2,
+				    size_t id, double e)
+{
+  size_t	idK;
+
+  idK = (*nK < k)? (*nK)++: k - 1;
+  while((idK > 0) && (d2[idK - 1] > e))
+  {
+    d2[idK] = d2[idK - 1];
+    idx[idK] = idx[idK - 1];
+    --idK;
+  }
+  d2[idK] = e;
+  idx[idK] = id;
+  if(*nK == k)
+  {
+    *w = d2[k - 1];
+  }
+}
+
+/*!
+* \return	Number of neighbours found.
+* \ingroup	AlcKDTree
+* \brief	Finds the k nearest neighbours of a single query key in
+*		the given flat kD-tree. The ranges still to be searched
+*		are kept on a stack together with a lower bound on the
+*		squared distance of their keys from the query key, so
+*		that the nearer child is always searched first and far
+*		ranges are discarded once k close enough neighbours
+*		have been found.
+* \param	tree			The flat kD-tree.
+* \param	q			Query key.
+* \param	k			Number of neighbours required.
+* \param	maxD2			Square of the maximum distance.
+* \param	idx			Destination for the neighbour
+*					indices.
+* \param	d2			Destination for the squared
+*					neighbour distances.
+*/
+static size_t	AlcKDTFlatKNN(AlcKDTFlat *tree, double *q, size_t k,
+			      double maxD2, size_t *idx, double *d2)
+{
+  int		sp;
+  size_t	idN,
+		lo,
+		hi,
+  		nK = 0;
+  double	e,
+  		w;
+  size_t	stkLo[ALC_KDT_FLAT_MAXDEPTH],
+  		stkHi[ALC_KDT_FLAT_MAXDEPTH];
+  double	stkBnd[ALC_KDT_FLAT_MAXDEPTH];
+
+  w = maxD2;
+  stkLo[0] = 0;
+  stkHi[0] = tree->nKeys;
+  stkBnd[0] = 0.0;
+  sp = 1;
+  while(sp > 0)
+  {
+    --sp;
+    if(stkBnd[sp] < w)
+    {
+      lo = stkLo[sp];
+      hi = stkHi[sp];
+      /* Descend to the leaf containing the query key, testing the
+       * key of each node passed and pushing the far children. */
+      while((hi - lo) > tree->leafSz)
+      {
+	int	idD;
+	size_t	m;
+	double	d;
+
+	m = (lo + hi) / 2;
+	if((e = AlcKDTFlatDistSq(tree, m, q)) < w)
+	{
+	  AlcKDTFlatKNNInsert(k, &nK, &w, idx, d2, tree->idx[m], e);
+	}
+	idD = tree->split[m];
+	d = q[idD] - tree->key[(m * tree->dim) + idD];
+	if(d < 0.0)
+	{
+	  stkLo[sp] = m + 1;
+	  stkHi[sp] = hi;
+	  hi = m;
+	}
+	else
+	{
+	  stkLo[sp] = lo;
+	  stkHi[sp] = m;
+	  lo = m + 1;
+	}
+	if((stkBnd[sp] = d * d) < w)
+	{
+	  ++sp;
+	}
+      }
+      for(idN = lo; idN < hi; ++idN)
+      {
+	if((e = AlcKDTFlatDistSq(tree, idN, q)) < w)
+	{
+	  AlcKDTFlatKNNInsert(k, &nK, &w, idx, d2, tree->idx[idN], e);
+	}
+      }
+    }
+  }
+  return(nK);
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Adds a neighbour to those found within a radius, only
+*		setting its index and distance if there is room for it.
+* \param	maxNbr			Maximum number of neighbours to set.
+* \param	nK			Number of neighbours found so far.
+* \param	idx			Neighbour indices.
+* \param	d2			Squared neighbour distances, may
+*					be NULL.
+* \param	id			Index of the new neighbour.
+* \param	e			Squared distance of the new
+*					neighbour.
+*/
+static void	AlcKDTFlatRadiusInsert(size_t maxNbr, size_t *nK,
+				       size_t *idx, double *d2,
+				       size_t id, double e)
+{
+  if(*nK < maxNbr)
+  {
+    idx[*nK] = id;
+    if(d2)
+    {
+      d2[*nK] = e;
+    }
+  }
+  ++(*nK);
+}
+
+/*!
+* \return	Number of keys within the radius.
+* \ingroup	AlcKDTree
+* \brief	Finds the keys of the given flat kD-tree which are within
+*		the given radius of a single query key, searching the
+*		tree as in AlcKDTFlatKNN() but with a fixed radius.
+* \param	tree			The flat kD-tree.
+* \param	q			Query key.
+* \param	r2			Square of the radius.
+* \param	maxNbr			Maximum number of neighbours to set.
+* \param	idx			Destination for the neighbour
+*					indices.
+* \param	d2			Destination for the squared
+*					neighbour distances, may be NULL.
+*/
+static size_t	AlcKDTFlatRadius(AlcKDTFlat *tree, double *q, double r2,
+				 size_t maxNbr, size_t *idx, double *d2)
+{
+  int		sp;
+  size_t	idN,
+		lo,
+		hi,
+  		nK = 0;
+  double	e;
+  size_t	stkLo[ALC_KDT_FLAT_MAXDEPTH],
+  		stkHi[ALC_KDT_FLAT_MAXDEPTH];
+
+  stkLo[0] = 0;
+  stkHi[0] = tree->nKeys;
+  sp = 1;
+  while(sp > 0)
+  {
+    --sp;
+    lo = stkLo[sp];
+    hi = stkHi[sp];
+    while((hi - lo) > tree->leafSz)
+    {
+      int	idD;
+      size_t	m;
+      double	d;
+
+      m = (lo + hi) / 2;
+      if((e = AlcKDTFlatDistSq(tree, m, q)) < r2)
+      {
+	AlcKDTFlatRadiusInsert(maxNbr, &nK, idx, d2, tree->idx[m], e);
+      }
+      idD = tree->split[m];
+      d = q[idD] - tree->key[(m * tree->dim) + idD];
+      if(d < 0.0)
+      {
+	stkLo[sp] = m + 1;
+	stkHi[sp] = hi;
+	hi = m;
+      }
+      else
+      {
+	stkLo[sp] = lo;
+	stkHi[sp] = m;
+	lo = m + 1;
+      }
+      if((d * d) < r2)
+      {
+	++sp;
+      }
+    }
+    for(idN = lo; idN < hi; ++idN)
+    {
+      if((e = AlcKDTFlatDistSq(tree, idN, q)) < r2)
+      {
+	AlcKDTFlatRadiusInsert(maxNbr, &nK, idx, d2, tree->idx[idN], e);
+      }
+    }
+  }
+  return(nK);
+}
+
 #ifdef ALC_KDT_TEST
 int		main(int argc, char *argv[])
 {
@@ -60,6 +60,11 @@ extern void			*AlcRealloc(
 				  size_t byteCount);
 extern void			AlcFree(
 				  void *data);
+extern void			AlcAllocCountSet(
+				  int on);
+extern void			AlcAllocCountGet(
+				  size_t *dstBytes,
+				  size_t *dstCalls);
 
 /************************************************************************
 * AlcArray.c
@@ -444,6 +449,11 @@ extern void            		*AlcFreeStackPush(
 				  void *prev,
 				  void *data,
 				  AlcErrno *dstErr);
+extern void            		*AlcFreeStackPushFn(
+				  void *prev,
+				  void *data,
+				  void (*freeFn)(void *),
+				  AlcErrno *dstErr);
 extern void			*AlcFreeStackPop(
 				  void *prev,
 				  void **dstData,
@@ -569,6 +579,32 @@ extern AlcKDTNode	       *AlcKDTGetNN(
 				  double minDist,
 				  double *dstNNDist,
 				  AlcErrno *dstErr);
+extern AlcKDTFlat		*AlcKDTFlatNew(
+				  AlcPointType type,
+				  int dim,
+				  size_t nKeys,
+				  void *keys,
+				  AlcErrno *dstErr);
+extern AlcErrno			AlcKDTFlatFree(
+				  AlcKDTFlat *tree);
+extern AlcErrno			AlcKDTFlatGetKNN(
+				  AlcKDTFlat *tree,
+				  size_t nQ,
+				  double *qKeys,
+				  size_t k,
+				  double maxDist,
+				  size_t *dstIdx,
+				  double *dstDist,
+				  size_t *dstCnt);
+extern AlcErrno			AlcKDTFlatGetRadius(
+				  AlcKDTFlat *tree,
+				  size_t nQ,
+				  double *qKeys,
+				  double radius,
+				  size_t maxNbr,
+				  size_t *dstIdx,
+				  double *dstDist,
+				  size_t *dstCnt);
 
 /************************************************************************
 * AlcLRUCache.c
@@ -438,6 +438,32 @@ typedef struct _AlcKDTTree
   AlcBlockStack *freeStack;	/*!< Stack of allocated node blocks */
 } AlcKDTTree;
 
+/*!
+* \struct	_AlcKDTFlat
+* \ingroup	AlcKDTree
+* \brief	A balanced binary space partition tree (kD-tree) which is
+*		built from all of its keys at once and then not modified.
+*		The keys are held in a single contiguous array in tree
+*		order and the nodes are implicit: the node for the range
+*		of keys [l, h) has the key at \f$m = (l + h) / 2\f$, with
+*		the ranges [l, m) and [m + 1, h) as its children, and
+*		ranges of no more than leafSz keys are leaves.
+*               Typedef: ::AlcKDTFlat
+*/
+typedef struct _AlcKDTFlat
+{
+  int		dim;		/*!< Dimension of the tree. */
+  size_t	nKeys;		/*!< Number of keys in the tree. */
+  size_t	leafSz;		/*!< Maximum number of keys in a leaf. */
+  double	*key;		/*!< Keys in tree order, with dim values
+  				     per key. */
+  size_t	*idx;		/*!< Index of each key in the array the
+  				     tree was built from. */
+  unsigned char	*split;		/*!< Splitting dimension of the node with
+  				     each key, only set for the keys of
+				     non-leaf nodes. */
+} AlcKDTFlat;
+
 /*!
 * \struct       _AlcHeapEntryCore
 * \ingroup      AlcHeap
@@ -162,6 +162,11 @@ int				AlcUFTreeConnected(
 * \ingroup	AlcUFTree
 * \brief	If the two given nodes have different components then
 * 		their components are merged to form one.
+* 		Unions may be made concurrently by several threads
+* 		provided that the components of the nodes given to
+* 		each thread are disjoint from those given to all the
+* 		others, eg when labeling disjoint blocks of a domain
+* 		before merging the seams between them.
 * \param	uft			The union find tree.
 * \param	p			Node in first component.
 * \param	q			Node in second component.
@@ -188,6 +193,9 @@ void				AlcUFTreeUnion(
       uft->pr[rQ] = rP;
       uft->sz[rP] += uft->sz[rQ];
     }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
     --(uft->nCmp);
   }
 }
@@ -107,10 +107,41 @@ typedef enum _AlgFourAxis
   ALG_FOUR_AXIS_Z = 2
 } AlgFourAxis;
 
+/*!
+* \struct	_AlgFourMix
+* \brief	Mixed radix transform plan and per thread work buffers
+*		for the length of an axis. The plan is NULL if the
+*		length is an integer power of two, in which case the
+*		Hartley transform based functions are used.
+*/
+typedef struct _AlgFourMix
+{
+  AlgFourPlan	*plan;		/*!< Plan for the axis length or NULL. */
+  ComplexD	*wrk;		/*!< Work buffers, twice the axis length
+  				     for each thread. */
+} AlgFourMix;
+
+static void			AlgFourMix1D(
+				  const AlgFourMix *mix,
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step,
+				  AlgFourDir dir);
+static void			AlgFourMixFree(
+				  AlgFourMix *mix,
+				  int nAxes);
+static AlgError			AlgFourMixNew(
+				  AlgFourMix *mix,
+				  int nAxes,
+				  int numX,
+				  int numY,
+				  int numZ);
 static AlgError			AlgFourRepXY1D(
 				  double **real,
 				  double **imag,
 			          AlgFourAxis axis,
+				  const AlgFourMix *mix,
 				  int useBuf,
 			          int numX,
 				  int numY,
@@ -118,6 +149,7 @@ static AlgError			AlgFourRepXY1D(
 static AlgError			AlgFourRepXYReal1D(
 				  double **data,
 				  AlgFourAxis axis,
+				  const AlgFourMix *mix,
 				  int useBuf,
 				  int numX,
 				  int numY,
@@ -126,6 +158,7 @@ static AlgError			AlgFourRepXYZ1D(
 				  double ***real,
 				  double ***imag,
 			          AlgFourAxis axis,
+				  const AlgFourMix *mix,
 				  int useBuf,
 			          int numX,
 				  int numY,
@@ -134,6 +167,7 @@ static AlgError			AlgFourRepXYZ1D(
 static AlgError			AlgFourRepXYZReal1D(
 				  double ***data,
 				  AlgFourAxis axis,
+				  const AlgFourMix *mix,
 				  int useBuf,
 				  int numX,
 				  int numY,
@@ -759,19 +793,24 @@ AlgError 	AlgFourHart2D(double **data, int useBuf, int numX, int numY)
 }
 
 /*!
-* \return	void
+* \return	Error code, may be set if the mixed radix plan
+*		can not be allocated, in which case the data are
+*		unchanged.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given one
 *		dimensional complex data, and does it in place.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
+*		If the number of data is not an integer power of two
+*		the transform is computed using a mixed radix transform
+*		plan, see AlgFourPlanNew().
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
 * \param	num			Number of data.
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFour1D(double *real, double *imag, int num, int step)
+AlgError	AlgFour1D(double *real, double *imag, int num, int step)
 {
   double	tD0,
 		tD1,
@@ -783,69 +822,89 @@ void		AlgFour1D(double *real, double *imag, int num, int step)
 		*tIp0,
 		*tIp1;
   int		count;
+  AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour1D FE %p %p %d %d\n",
 	   real, imag, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
+  if((num & (num - 1)) != 0)
   {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 + tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 - tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 - tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 + tD2) * 0.5;
-    tIp1 -= step;
+    AlgFourPlan	*plan;
+
+    if((plan = AlgFourPlanNew(num, &errNum)) != NULL)
+    {
+      errNum = AlgFourPlanCmplxSplit1D(plan, NULL, real, imag, step, 0);
+      AlgFourPlanFree(plan);
+    }
   }
+  else
+  {
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    tIp0 = imag + step;
+    tIp1 = imag + ((num - 1) * step);
+    count = (num / 2) - 1;
+    while(count-- > 0)
+    {
+      tD1 = *tRp0;
+      tD0 = *tRp1;
+      tD2 = tD1 - tD0;
+      tD1 += tD0;
+      tD3 = *tIp0;
+      tD0 = *tIp1;
+      tD4 = tD3 - tD0;
+      tD3 += tD0;
+      *tRp0 = (tD1 + tD4) * 0.5;
+      tRp0 += step;
+      *tRp1 = (tD1 - tD4) * 0.5;
+      tRp1 -= step;
+      *tIp0 = (tD3 - tD2) * 0.5;
+      tIp0 += step;
+      *tIp1 = (tD3 + tD2) * 0.5;
+      tIp1 -= step;
+    }
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-  {
+    {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
+      {
+	AlgFourHart1D(real, num, step);
+      }
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(imag, num, step);
+      {
+	AlgFourHart1D(imag, num, step);
+      }
     }
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour1D FX\n"));
+  return(errNum);
 }
 
 /*!
-* \return	void
+* \return	Error code, may be set if the mixed radix plan
+*		can not be allocated, in which case the data are
+*		unchanged.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given
 *		complex one dimensional data, and does it in place.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
+*		If the number of data is not an integer power of two
+*		the transform is computed using a mixed radix transform
+*		plan, see AlgFourPlanNew().
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
 * \param	num			Number of data.
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourInv1D(double *real, double *imag, int num, int step)
+AlgError	AlgFourInv1D(double *real, double *imag, int num, int step)
 {
   double	tD0,
 		tD1,
@@ -857,54 +916,69 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
 		*tIp0,
 		*tIp1;
   int		count;
+  AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv1D FE %p %p %d %d\n",
 	   real, imag, num, step));
+  if((num & (num - 1)) != 0)
+  {
+    AlgFourPlan	*plan;
+
+    if((plan = AlgFourPlanNew(num, &errNum)) != NULL)
+    {
+      errNum = AlgFourPlanCmplxSplit1D(plan, NULL, real, imag, step, 1);
+      AlgFourPlanFree(plan);
+    }
+  }
+  else
+  {
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-  {
+    {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
+      {
+	AlgFourHart1D(real, num, step);
+      }
 #ifdef _OPENMP
 #pragma omp section
 #endif
+      {
+	AlgFourHart1D(imag, num, step);
+      }
+    }
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    tIp0 = imag + step;
+    tIp1 = imag + ((num - 1) * step);
+    count = (num / 2) - 1;
+    while(count-- > 0)
     {
-      AlgFourHart1D(imag, num, step);
+      tD1 = *tRp0;
+      tD0 = *tRp1;
+      tD2 = tD1 - tD0;
+      tD1 += tD0;
+
+      tD3 = *tIp0;
+      tD0 = *tIp1;
+      tD4 = tD3 - tD0;
+      tD3 += tD0;
+      *tRp0 = (tD1 - tD4) * 0.5;
+      tRp0 += step;
+      *tRp1 = (tD1 + tD4) * 0.5;
+      tRp1 -= step;
+      *tIp0 = (tD3 + tD2) * 0.5;
+      tIp0 += step;
+      *tIp1 = (tD3 - tD2) * 0.5;
+      tIp1 -= step;
     }
   }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
-  {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 - tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 + tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 + tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 - tD2) * 0.5;
-    tIp1 -= step;
-  }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv1D FX\n"));
+  return(errNum);
 }
 
 /*!
@@ -1048,17 +1122,23 @@ AlgError	AlgFour2D(double **real, double **imag,
 			  int useBuf, int numX, int numY)
 {
   AlgError	errNum;
+  AlgFourMix	mix[2];
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                          numX, numY, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMixNew(mix, 2, numX, numY, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
+    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, mix, useBuf,
                             numX, numY, ALG_FOUR_DIR_FWD);
   }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
+                            numX, numY, ALG_FOUR_DIR_FWD);
+  }
+  AlgFourMixFree(mix, 2);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FX\n"));
   return(errNum);
@@ -1082,17 +1162,23 @@ AlgError	AlgFourInv2D(double **real, double **imag,
 			     int useBuf, int numX, int numY)
 {
   AlgError	errNum;
+  AlgFourMix	mix[2];
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                          numX, numY, ALG_FOUR_DIR_INV);
+  errNum = AlgFourMixNew(mix, 2, numX, numY, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
+    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
                             numX, numY, ALG_FOUR_DIR_INV);
   }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, mix, useBuf,
+                            numX, numY, ALG_FOUR_DIR_INV);
+  }
+  AlgFourMixFree(mix, 2);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FX\n"));
   return(errNum);
@@ -1146,17 +1232,23 @@ AlgError	AlgFourReal2D(double **real,
 			      int useBuf, int numX, int numY)
 {
   AlgError	errNum;
+  AlgFourMix	mix[2];
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-                              ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMixNew(mix, 2, numX, numY, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-    				ALG_FOUR_DIR_FWD);
+    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, mix, useBuf,
+                                numX, numY, ALG_FOUR_DIR_FWD);
   }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
+                                numX, numY, ALG_FOUR_DIR_FWD);
+  }
+  AlgFourMixFree(mix, 2);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FX\n"));
   return(errNum);
@@ -1180,16 +1272,22 @@ AlgError	AlgFourRealInv2D(double **real,
 				 int useBuf, int numX, int numY)
 {
   AlgError	errNum;
+  AlgFourMix	mix[2];
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-                              ALG_FOUR_DIR_INV);
+  errNum = AlgFourMixNew(mix, 2, numX, numY, 0);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
+                                numX, numY, ALG_FOUR_DIR_INV);
+  }
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-  				ALG_FOUR_DIR_INV);
+    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, mix, useBuf,
+                                numX, numY, ALG_FOUR_DIR_INV);
   }
+  AlgFourMixFree(mix, 2);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FX\n"));
   return(errNum);
@@ -1218,22 +1316,28 @@ AlgError	AlgFour3D(double ***real, double ***imag,
 			  int useBuf, int numX, int numY, int numZ)
 {
   AlgError	errNum;
+  AlgFourMix	mix[3];
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                           numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMixNew(mix, 3, numX, numY, numZ);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, mix, useBuf,
+                             numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  }
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
                              numX, numY, numZ, ALG_FOUR_DIR_FWD);
   }
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, mix + 2, useBuf,
                              numX, numY, numZ, ALG_FOUR_DIR_FWD);
   }
+  AlgFourMixFree(mix, 3);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FX\n"));
   return(errNum);
@@ -1258,22 +1362,28 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
 			     int useBuf, int numX, int numY, int numZ)
 {
   AlgError	errNum;
+  AlgFourMix	mix[3];
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
-                          numX, numY, numZ, ALG_FOUR_DIR_INV);
+  errNum = AlgFourMixNew(mix, 3, numX, numY, numZ);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                            numX, numY, numZ, ALG_FOUR_DIR_INV);
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, mix + 2, useBuf,
+                             numX, numY, numZ, ALG_FOUR_DIR_INV);
   }
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                            numX, numY, numZ, ALG_FOUR_DIR_INV);
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
+                             numX, numY, numZ, ALG_FOUR_DIR_INV);
   }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, mix, useBuf,
+                             numX, numY, numZ, ALG_FOUR_DIR_INV);
+  }
+  AlgFourMixFree(mix, 3);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FX\n"));
   return(errNum);
@@ -1300,22 +1410,28 @@ AlgError	AlgFourReal3D(double ***real,
 			      int useBuf, int numX, int numY, int numZ)
 {
   AlgError	errNum;
+  AlgFourMix	mix[3];
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMixNew(mix, 3, numX, numY, numZ);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, mix, useBuf,
                                  numX, numY, numZ, ALG_FOUR_DIR_FWD);
   }
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-    				 numX, numY, numZ, ALG_FOUR_DIR_FWD);
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
+                                 numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, mix + 2, useBuf,
+                                 numX, numY, numZ, ALG_FOUR_DIR_FWD);
   }
+  AlgFourMixFree(mix, 3);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FX\n"));
   return(errNum);
@@ -1340,21 +1456,27 @@ AlgError	AlgFourRealInv3D(double ***real,
 				 int useBuf, int numX, int numY, int numZ)
 {
   AlgError	errNum;
+  AlgFourMix	mix[3];
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_INV);
+  errNum = AlgFourMixNew(mix, 3, numX, numY, numZ);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, mix + 2, useBuf,
                                  numX, numY, numZ, ALG_FOUR_DIR_INV);
   }
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, mix + 1, useBuf,
                                  numX, numY, numZ, ALG_FOUR_DIR_INV);
   }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, mix, useBuf,
+                                 numX, numY, numZ, ALG_FOUR_DIR_INV);
+  }
+  AlgFourMixFree(mix, 3);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FX\n"));
   return(errNum);
@@ -1367,6 +1489,8 @@ AlgError	AlgFourRealInv3D(double ***real,
 * \param	real			Given real 2D data array.
 * \param	imag			Given imaginary 2D data array.
 * \param	axis			Axis for partial evaluation.
+* \param	mix			Mixed radix plan and work buffers
+*					for the length of the axis.
 * \param	useBuf			Allocate private buffers to make
 * 					columns contiguous.
 * \param	numX			Number of data columns in given
@@ -1376,8 +1500,8 @@ AlgError	AlgFourRealInv3D(double ***real,
 * \param	dir			Forward or inverse transform.
 */
 static AlgError	AlgFourRepXY1D(double **real, double **imag,
-			       AlgFourAxis axis, int useBuf,
-			       int numX, int numY, AlgFourDir dir)
+			       AlgFourAxis axis, const AlgFourMix *mix,
+			       int useBuf, int numX, int numY, AlgFourDir dir)
 {
   AlgError	errNum = ALG_ERR_NONE;
 
@@ -1392,7 +1516,8 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 #endif
       for(idY = 0; idY < numY; ++idY)
       {
-	AlgFour1D(*(real + idY), *(imag + idY), numX, 1);
+	AlgFourMix1D(mix, *(real + idY), *(imag + idY), numX, 1,
+	    ALG_FOUR_DIR_FWD);
       }
     }
     else
@@ -1404,7 +1529,8 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 #endif
       for(idY = 0; idY < numY; ++idY)
       {
-	AlgFourInv1D(*(real + idY), *(imag + idY), numX, 1);
+	AlgFourMix1D(mix, *(real + idY), *(imag + idY), numX, 1,
+	    ALG_FOUR_DIR_INV);
       }
     }
   }
@@ -1456,11 +1582,11 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 	  /* Transform buffer. */
 	  if(dir == ALG_FOUR_DIR_FWD)
 	  {
-	    AlgFour1D(reBuf, imBuf, numY, 1);
+	    AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_FWD);
 	  }
 	  else
 	  {
-	    AlgFourInv1D(reBuf, imBuf, numY, 1);
+	    AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_INV);
 	  }
 	  /* Copy back from buffer. */
 	  for(idY = 0; idY < numY; ++idY)
@@ -1483,7 +1609,8 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 #endif
 	for(idX = 0; idX < numX; ++idX)
 	{
-	  AlgFour1D(*real + idX, *imag + idX, numY, numX);
+	  AlgFourMix1D(mix, *real + idX, *imag + idX, numY, numX,
+	      ALG_FOUR_DIR_FWD);
         }
       }
       else
@@ -1493,7 +1620,8 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 #endif
 	for(idX = 0; idX < numX; ++idX)
 	{
-	  AlgFourInv1D(*real + idX, *imag + idX, numY, numX);
+	  AlgFourMix1D(mix, *real + idX, *imag + idX, numY, numX,
+	      ALG_FOUR_DIR_INV);
         }
       }
     }
@@ -1510,6 +1638,8 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 *	 	array.
 * \param	data			Given 2D data array.
 * \param	axis			Axis for partial evaluation.
+* \param	mix			Mixed radix plan and work buffers
+*					for the length of the axis.
 * \param	useBuf			Allocate private buffers to make
 * 					columns contiguous.
 * \param	numX			Number of data columns in given
@@ -1518,7 +1648,8 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 *					data array.
 * \param	dir			Forward or inverse transform.
 */
-static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
+static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis,
+				   const AlgFourMix *mix, int useBuf,
 				   int numX, int numY, AlgFourDir dir)
 {
   AlgError	errNum = ALG_ERR_NONE;
@@ -1663,11 +1794,11 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 	    }
 	    if(dir == ALG_FOUR_DIR_FWD)
 	    {
-	      AlgFour1D(reBuf, imBuf, numY, 1);
+	      AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_FWD);
 	    }
 	    else
 	    {
-	      AlgFourInv1D(reBuf, imBuf, numY, 1);
+	      AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_INV);
 	    }
 	    for(idY = 0; idY < numY; ++idY)
 	    {
@@ -1712,7 +1843,8 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 #endif
 	  for(idX = 1; idX < halfData; ++idX)
 	  {
-	    AlgFour1D(*data + idX, *data + halfData + idX, numY, numX);
+	    AlgFourMix1D(mix, *data + idX, *data + halfData + idX, numY, numX,
+	        ALG_FOUR_DIR_FWD);
 	  }
 	}
       }
@@ -1746,8 +1878,8 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 #endif
 	  for(idX = 1; idX < halfData; ++idX)
 	  {
-	    AlgFourInv1D(*data + idX, *data + halfData + idX, numY,
-		numX);
+	    AlgFourMix1D(mix, *data + idX, *data + halfData + idX, numY,
+		numX, ALG_FOUR_DIR_INV);
 	  }
 	}
       }
@@ -1763,6 +1895,8 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 * \param	real			Given 3D real data array.
 * \param	imag			Given 3D imaginary data array.
 * \param	axis			Axis for partial evaluation.
+* \param	mix			Mixed radix plan and work buffers
+*					for the length of the axis.
 * \param	useBuf			Allocate private buffers to make
 * 					columns contiguous.
 * \param	numX			Number of data columns in given
@@ -1774,8 +1908,9 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 * \param	dir			Forward or inverse transform.
 */
 static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
-			        AlgFourAxis axis, int useBuf,
-			        int numX, int numY, int numZ, AlgFourDir dir)
+			        AlgFourAxis axis, const AlgFourMix *mix,
+				int useBuf, int numX, int numY, int numZ,
+				AlgFourDir dir)
 {
   int		idX,
   		idY,
@@ -1795,13 +1930,13 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 	{
 	  if(dir == ALG_FOUR_DIR_FWD)
 	  {
-	    AlgFour1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
+	    AlgFourMix1D(mix, *(*(real + idZ) + idY), *(*(imag + idZ) + idY),
+		numX, 1, ALG_FOUR_DIR_FWD);
 	  }
 	  else
 	  {
-	    AlgFourInv1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
+	    AlgFourMix1D(mix, *(*(real + idZ) + idY), *(*(imag + idZ) + idY),
+		numX, 1, ALG_FOUR_DIR_INV);
 	  }
 	}
       }
@@ -1853,11 +1988,11 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 	      /* Transform buffer. */
 	      if(dir == ALG_FOUR_DIR_FWD)
 	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_FWD);
 	      }
 	      else
 	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_INV);
 	      }
 	      /* Copy back from buffer. */
 	      for(idY = 0; idY < numY; ++idY)
@@ -1881,13 +2016,13 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 	  {
 	    if(dir == ALG_FOUR_DIR_FWD)
 	    {
-	      AlgFour1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
+	      AlgFourMix1D(mix, **(real + idZ) + idX, **(imag + idZ) + idX,
+		  numY, numX, ALG_FOUR_DIR_FWD);
 	    }
 	    else
 	    {
-	      AlgFourInv1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
+	      AlgFourMix1D(mix, **(real + idZ) + idX, **(imag + idZ) + idX,
+		  numY, numX, ALG_FOUR_DIR_INV);
 	    }
 	  }
 	}
@@ -1940,11 +2075,11 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 	      /* Transform buffer. */
 	      if(dir == ALG_FOUR_DIR_FWD)
 	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numZ, 1, ALG_FOUR_DIR_FWD);
 	      }
 	      else
 	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numZ, 1, ALG_FOUR_DIR_INV);
 	      }
 	      /* Copy back from buffer. */
 	      for(idZ = 0; idZ < numZ; ++idZ)
@@ -1968,13 +2103,13 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 	  {
 	    if(dir == ALG_FOUR_DIR_FWD)
 	    {
-	      AlgFour1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
+	      AlgFourMix1D(mix, *(*real + idY) + idX, *(*imag + idY) + idX,
+		  numZ, numX * numY, ALG_FOUR_DIR_FWD);
 	    }
 	    else
 	    {
-	      AlgFourInv1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
+	      AlgFourMix1D(mix, *(*real + idY) + idX, *(*imag + idY) + idX,
+		  numZ, numX * numY, ALG_FOUR_DIR_INV);
 	    }
 	  }
 	}
@@ -1995,6 +2130,8 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 *	 	array.
 * \param	data			Given 2D data array.
 * \param	axis			Axis for partial evaluation.
+* \param	mix			Mixed radix plan and work buffers
+*					for the length of the axis.
 * \param	useBuf			Allocate private buffers to make
 * 					columns contiguous.
 * \param	numX			Number of data columns in given
@@ -2006,7 +2143,7 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 * \param	dir			Forward or inverse transform.
 */
 static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
-				    int useBuf,
+				    const AlgFourMix *mix, int useBuf,
 				    int numX, int numY, int numZ,
 				    AlgFourDir dir)
 {
@@ -2106,11 +2243,11 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 	      }
 	      if(dir == ALG_FOUR_DIR_FWD)
 	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_FWD);
 	      }
 	      else
 	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numY, 1, ALG_FOUR_DIR_INV);
 	      }
 	      /* Copy back. */
 	      for(idY = 0; idY < numY; ++idY)
@@ -2136,8 +2273,9 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 	    AlgFourReal1D(**(data + idZ) + halfData, numY, numX);
 	    for(idX = 1; idX < halfData; ++idX)
 	    {
-	      AlgFour1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
+	      AlgFourMix1D(mix, **(data + idZ) + idX,
+		  **(data + idZ) + halfData + idX, numY, numX,
+		  ALG_FOUR_DIR_FWD);
 	    }
 	  }
 	  else
@@ -2146,8 +2284,9 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 	    AlgFourRealInv1D(**(data + idZ) + halfData, numY, numX);
 	    for(idX = 1; idX < halfData; ++idX)
 	    {
-	      AlgFourInv1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
+	      AlgFourMix1D(mix, **(data + idZ) + idX,
+		  **(data + idZ) + halfData + idX, numY, numX,
+		  ALG_FOUR_DIR_INV);
 	    }
 	  }
 	}
@@ -2221,11 +2360,11 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 	      }
 	      if(dir == ALG_FOUR_DIR_FWD)
 	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numZ, 1, ALG_FOUR_DIR_FWD);
 	      }
 	      else
 	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
+		AlgFourMix1D(mix, reBuf, imBuf, numZ, 1, ALG_FOUR_DIR_INV);
 	      }
 	      /* Copy back from buffer. */
 	      for(idZ = 0; idZ < numZ; ++idZ)
@@ -2252,8 +2391,9 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 	    AlgFourReal1D(*(*data + idY) + halfData, numZ, numX * numY);
 	    for(idX = 1; idX < halfData; ++idX)
 	    {
-	      AlgFour1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
+	      AlgFourMix1D(mix, *(*data + idY) + idX,
+		  *(*data + idY) + halfData + idX, numZ, numX * numY,
+		  ALG_FOUR_DIR_FWD);
 	    }
 	  }
 	  else
@@ -2262,8 +2402,9 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 	    AlgFourRealInv1D(*(*data + idY) + halfData, numZ, numX * numY);
 	    for(idX = 1; idX < halfData; ++idX)
 	    {
-	      AlgFourInv1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
+	      AlgFourMix1D(mix, *(*data + idY) + idX,
+		  *(*data + idY) + halfData + idX, numZ, numX * numY,
+		  ALG_FOUR_DIR_INV);
 	    }
 	  }
 	}
@@ -2274,3 +2415,126 @@ static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
   }
   return(errNum);
 }
+
+/*!
+* \return	Error code, may be set if buffers can not be allocated.
+* \brief	Creates mixed radix transform plans and per thread work
+*		buffers for each of the given axis lengths which is not
+*		an integer power of two. These are created once by the
+*		2D and 3D transform functions so that the rows, columns
+*		and plane columns are transformed without any further
+*		allocation. On error all the plans and buffers are freed.
+* \param	mix			Array of nAxes mixed radix plans
+*					to be set.
+* \param	nAxes			Number of axes, 2 or 3.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane column,
+*					ignored unless nAxes is 3.
+*/
+static AlgError	AlgFourMixNew(AlgFourMix *mix, int nAxes,
+			      int numX, int numY, int numZ)
+{
+  int		idA,
+  		nThr = 1;
+  int		num[3];
+  AlgError	errNum = ALG_ERR_NONE;
+
+  num[0] = numX;
+  num[1] = numY;
+  num[2] = numZ;
+#ifdef _OPENMP
+  /* This bounds the number of threads in any team started by the
+   * transform functions. */
+  nThr = omp_get_max_threads();
+#endif
+  for(idA = 0; idA < nAxes; ++idA)
+  {
+    mix[idA].plan = NULL;
+    mix[idA].wrk = NULL;
+  }
+  for(idA = 0; (errNum == ALG_ERR_NONE) && (idA < nAxes); ++idA)
+  {
+    if((num[idA] & (num[idA] - 1)) != 0)
+    {
+      mix[idA].plan = AlgFourPlanNew(num[idA], &errNum);
+      if((errNum == ALG_ERR_NONE) &&
+         ((mix[idA].wrk = (ComplexD *)
+	                  AlcMalloc(sizeof(ComplexD) * 2 * num[idA] *
+			            nThr)) == NULL))
+      {
+        errNum = ALG_ERR_MALLOC;
+      }
+    }
+  }
+  if(errNum != ALG_ERR_NONE)
+  {
+    AlgFourMixFree(mix, nAxes);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \brief	Frees the plans and work buffers created by
+*		AlgFourMixNew().
+* \param	mix			Array of mixed radix plans.
+* \param	nAxes			Number of axes.
+*/
+static void	AlgFourMixFree(AlgFourMix *mix, int nAxes)
+{
+  int		idA;
+
+  for(idA = 0; idA < nAxes; ++idA)
+  {
+    AlgFourPlanFree(mix[idA].plan);
+    AlcFree(mix[idA].wrk);
+    mix[idA].plan = NULL;
+    mix[idA].wrk = NULL;
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the Fourier transform of one dimensional
+*		complex data with separate real and imaginary arrays
+*		using the given mixed radix plan and the calling
+*		thread's work buffer, or if the length is an integer
+*		power of two using AlgFour1D() or AlgFourInv1D().
+*		Because the plan and buffers are allocated by
+*		AlgFourMixNew() this can not fail.
+* \param	mix			Mixed radix plan and work buffers
+*					for the length of the data.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	dir			Forward or inverse transform.
+*/
+static void	AlgFourMix1D(const AlgFourMix *mix,
+			     double *real, double *imag, int num, int step,
+			     AlgFourDir dir)
+{
+  if(mix->plan == NULL)
+  {
+    if(dir == ALG_FOUR_DIR_FWD)
+    {
+      (void )AlgFour1D(real, imag, num, step);
+    }
+    else
+    {
+      (void )AlgFourInv1D(real, imag, num, step);
+    }
+  }
+  else
+  {
+    int		thrId = 0;
+
+#ifdef _OPENMP
+    thrId = omp_get_thread_num();
+#endif
+    (void )AlgFourPlanCmplxSplit1D(mix->plan, mix->wrk + (2 * num * thrId),
+                                   real, imag, step, dir == ALG_FOUR_DIR_INV);
+  }
+}
@@ -0,0 +1,1416 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgFourierPlan_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libAlg/AlgFourierPlan.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Plan based mixed radix fast Fourier transforms.
+*
+* \par
+*		Unlike the Hartley transform based functions of
+*		AlgFourier.c, which require the data size to be an
+*		integer power of two, these functions use a plan
+*		(see AlgFourPlanNew()) which holds the factorisation
+*		of the transform length and a table of twiddle factors
+*		that is computed once and then shared by all the
+*		transforms of that length. Lengths with factors of
+*		2, 3, 4 and 5 are computed efficiently using a Stockham
+*		autosort algorithm, any other prime factors are
+*		computed directly. AlgFourPlanGoodSize() may be used
+*		to find the smallest efficient length that is not
+*		less than the data size, this is usually much smaller
+*		than the next integer power of two.
+*
+*		The multi-dimensional real transforms operate on
+*		contiguous buffers with the x index varying fastest.
+*		A real array of numX x numY (x numZ) values transforms
+*		into a complex array of (numX / 2 + 1) x numY (x numZ)
+*		values, with the complex conjugate symmetric half of
+*		the spectrum omitted. Pairs of rows are transformed
+*		together as a single complex transform. Both float and
+*		double precision data are supported, with the 1D
+*		transforms always being computed in double precision
+*		within per-thread buffers, so that float data only
+*		halve the memory required and do not lose accuracy
+*		beyond that of their storage.
+*
+*		As for the transforms of AlgFourier.c the transforms are
+*		not normalised, so a forward transform followed by an
+*		inverse transform scales the data by the product of the
+*		transformed lengths.
+* \ingroup      AlgFourier
+* \todo         -
+* \bug          None known.
+*/
+
+#include <Alg.h>
+#include <float.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static void			AlgFourPlanPass2(
+				  const ComplexD *tw,
+				  int m,
+				  int s,
+				  const ComplexD *x,
+				  ComplexD *y);
+static void			AlgFourPlanPass3(
+				  const ComplexD *tw,
+				  int m,
+				  int s,
+				  const ComplexD *x,
+				  ComplexD *y);
+static void			AlgFourPlanPass4(
+				  const ComplexD *tw,
+				  int m,
+				  int s,
+				  const ComplexD *x,
+				  ComplexD *y);
+static void			AlgFourPlanPass5(
+				  const ComplexD *tw,
+				  int m,
+				  int s,
+				  const ComplexD *x,
+				  ComplexD *y);
+static void			AlgFourPlanPassN(
+				  const ComplexD *tw,
+				  int num,
+				  int r,
+				  int m,
+				  int s,
+				  const ComplexD *x,
+				  ComplexD *y);
+static void			AlgFourPlanRowsR2C(
+				  const AlgFourPlan *plan,
+				  ComplexD *buf,
+				  void *rData,
+				  void *cData,
+				  int isF,
+				  int row,
+				  int nRow);
+static void			AlgFourPlanRowsC2R(
+				  const AlgFourPlan *plan,
+				  ComplexD *buf,
+				  void *cData,
+				  void *rData,
+				  int isF,
+				  int row,
+				  int nRow);
+static void			AlgFourPlanCmplxStrided(
+				  const AlgFourPlan *plan,
+				  ComplexD *buf,
+				  void *data,
+				  int isF,
+				  size_t off,
+				  size_t step,
+				  int inv);
+static AlgError			AlgFourPlanRealND(
+				  void *rData,
+				  void *cData,
+				  int isF,
+				  int inv,
+				  int numX,
+				  int numY,
+				  int numZ);
+static ComplexD			*AlgFourPlanRun(
+				  const AlgFourPlan *plan,
+				  ComplexD *x,
+				  ComplexD *y);
+
+/*!
+* \return	Smallest efficient transform length.
+* \ingroup	AlgFourier
+* \brief	Computes the smallest integer which is not less than
+*		the given data size and has no prime factors other
+*		than 2, 3 and 5. Padding data to this size rather
+*		than to an integer power of two gives a much smaller
+*		increase in the data size.
+* \param	num			Given data size.
+*/
+int		AlgFourPlanGoodSize(int num)
+{
+  int		n,
+  		r;
+
+  if(num < 1)
+  {
+    num = 1;
+  }
+  for(n = num; ; ++n)
+  {
+    r = n;
+    while((r % 2) == 0)
+    {
+      r /= 2;
+    }
+    while((r % 3) == 0)
+    {
+      r /= 3;
+    }
+    while((r % 5) == 0)
+    {
+      r /= 5;
+    }
+    if(r == 1)
+    {
+      break;
+    }
+  }
+  return(n);
+}
+
+/*!
+* \return	New transform plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Makes a new plan for Fourier transforms of the given
+*		length. The plan holds the factorisation of the length
+*		and a table of the twiddle factors. A plan is not
+*		modified by the transforms which use it and may
+*		be shared by any number of concurrent transforms.
+*		The plan should be freed using AlgFourPlanFree().
+* \param	num			Transform length, must be greater
+*					than zero.
+* \param	dstErr			Destination error pointer, may
+*					be NULL.
+*/
+AlgFourPlan	*AlgFourPlanNew(int num, AlgError *dstErr)
+{
+  int		idx,
+  		r,
+		p;
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanNew FE %d\n", num));
+  if(num < 1)
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if(((plan = (AlgFourPlan *)
+                   AlcCalloc(1, sizeof(AlgFourPlan))) == NULL) ||
+          ((plan->twiddle = (ComplexD *)
+	                    AlcMalloc(sizeof(ComplexD) * num)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    plan->num = num;
+    /* Factorise using radix 4 passes where possible, then 2, 3 and 5,
+     * with any remaining prime factors computed directly. */
+    r = num;
+    while((r % 4) == 0)
+    {
+      plan->fac[plan->nFac++] = 4;
+      r /= 4;
+    }
+    p = 2;
+    while(r > 1)
+    {
+      while((r % p) == 0)
+      {
+	plan->fac[plan->nFac++] = p;
+	r /= p;
+      }
+      p = (p == 2)? 3: p + 2;
+      if(p * p > r)
+      {
+        p = r;
+      }
+    }
+    /* Compute the twiddle factors directly, without any recurrence, to
+     * avoid the accumulation of rounding errors. */
+    for(idx = 0; idx < num; ++idx)
+    {
+      double	theta;
+
+      theta = (2.0 * ALG_M_PI * idx) / num;
+      plan->twiddle[idx].re = cos(theta);
+      plan->twiddle[idx].im = -sin(theta);
+    }
+  }
+  if(errNum != ALG_ERR_NONE)
+  {
+    AlgFourPlanFree(plan);
+    plan = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanNew FX %p\n", plan));
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Frees a transform plan made by AlgFourPlanNew().
+* \param	plan			Given plan, may be NULL.
+*/
+void		AlgFourPlanFree(AlgFourPlan *plan)
+{
+  if(plan)
+  {
+    AlcFree(plan->twiddle);
+    AlcFree(plan);
+  }
+}
+
+/*!
+* \return	Error code, may be set if buffers can not be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex double data, and does it in place.
+*		As for AlgFour1D() the transform is not normalised.
+* \param	plan			Plan for the transform length.
+* \param	data			Given data.
+* \param	step			Offset in complex data elements
+*					between the data to be transformed.
+* \param	inv			Non-zero for an inverse transform.
+*/
+AlgError	AlgFourPlanCmplx1D(const AlgFourPlan *plan, ComplexD *data,
+				   int step, int inv)
+{
+  ComplexD	*buf;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || (data == NULL) || (step < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((buf = (ComplexD *)
+                 AlcMalloc(sizeof(ComplexD) * 2 * plan->num)) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    AlgFourPlanCmplxStrided(plan, buf, data, 0, 0, step, inv);
+    AlcFree(buf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if buffers can not be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex float data, and does it in place.
+*		As for AlgFour1D() the transform is not normalised.
+* \param	plan			Plan for the transform length.
+* \param	data			Given data.
+* \param	step			Offset in complex data elements
+*					between the data to be transformed.
+* \param	inv			Non-zero for an inverse transform.
+*/
+AlgError	AlgFourPlanCmplx1F(const AlgFourPlan *plan, ComplexF *data,
+				   int step, int inv)
+{
+  ComplexD	*buf;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || (data == NULL) || (step < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((buf = (ComplexD *)
+                 AlcMalloc(sizeof(ComplexD) * 2 * plan->num)) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    AlgFourPlanCmplxStrided(plan, buf, data, 1, 0, step, inv);
+    AlcFree(buf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code, may be set if buffers can not be allocated.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex double data held in separate
+*		real and imaginary arrays, and does it in place.
+*		A work buffer may be given so that repeated transforms
+*		of the same length need no allocation.
+*		As for AlgFour1D() the transform is not normalised.
+* \param	plan			Plan for the transform length.
+* \param	buf			Work buffer for twice the transform
+*					length, if NULL a buffer will be
+*					allocated and freed.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	inv			Non-zero for an inverse transform.
+*/
+AlgError	AlgFourPlanCmplxSplit1D(const AlgFourPlan *plan,
+					ComplexD *buf, double *real,
+					double *imag, int step, int inv)
+{
+  int		idx,
+  		n;
+  double	sgn;
+  ComplexD	*z,
+  		*tBuf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || (real == NULL) || (imag == NULL) || (step < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((buf == NULL) &&
+          ((buf = tBuf = (ComplexD *)
+	                 AlcMalloc(sizeof(ComplexD) * 2 * plan->num)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    n = plan->num;
+    sgn = (inv)? -1.0: 1.0;
+    for(idx = 0; idx < n; ++idx)
+    {
+      buf[idx].re = *(real + (idx * step));
+      buf[idx].im = sgn * *(imag + (idx * step));
+    }
+    z = AlgFourPlanRun(plan, buf, buf + n);
+    for(idx = 0; idx < n; ++idx)
+    {
+      *(real + (idx * step)) = z[idx].re;
+      *(imag + (idx * step)) = sgn * z[idx].im;
+    }
+  }
+  AlcFree(tBuf);
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given two
+*		dimensional real double data. The data are in a
+*		contiguous buffer of numX x numY values and the
+*		transform is written to a contiguous buffer of
+*		(numX / 2 + 1) x numY complex values. The rows
+*		and then the columns are transformed in parallel.
+*		The transform is not normalised.
+* \param	rData			Given real data which are not
+*					modified.
+* \param	cData			Destination for the complex
+*					transformed data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourPlanReal2D(const double *rData, ComplexD *cData,
+				  int numX, int numY)
+{
+  return(AlgFourPlanRealND((void *)rData, cData, 0, 0, numX, numY, 1));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given two
+*		dimensional complex double data which are laid out as
+*		computed by AlgFourPlanReal2D(). The complex data are
+*		used as workspace and are overwritten.
+*		The transform is not normalised.
+* \param	cData			Given complex data.
+* \param	rData			Destination for the real data.
+* \param	numX			Number of real data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourPlanRealInv2D(ComplexD *cData, double *rData,
+				     int numX, int numY)
+{
+  return(AlgFourPlanRealND(rData, cData, 0, 1, numX, numY, 1));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Single precision version of AlgFourPlanReal2D().
+* \param	rData			Given real data which are not
+*					modified.
+* \param	cData			Destination for the complex
+*					transformed data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourPlanReal2F(const float *rData, ComplexF *cData,
+				  int numX, int numY)
+{
+  return(AlgFourPlanRealND((void *)rData, cData, 1, 0, numX, numY, 1));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Single precision version of AlgFourPlanRealInv2D().
+* \param	cData			Given complex data.
+* \param	rData			Destination for the real data.
+* \param	numX			Number of real data in each row.
+* \param	numY			Number of data in each column.
+*/
+AlgError	AlgFourPlanRealInv2F(ComplexF *cData, float *rData,
+				     int numX, int numY)
+{
+  return(AlgFourPlanRealND(rData, cData, 1, 1, numX, numY, 1));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given three
+*		dimensional real double data. The data are in a
+*		contiguous buffer of numX x numY x numZ values and
+*		the transform is written to a contiguous buffer of
+*		(numX / 2 + 1) x numY x numZ complex values. The rows,
+*		columns and then the plane columns are transformed
+*		in parallel.
+*		The transform is not normalised.
+* \param	rData			Given real data which are not
+*					modified.
+* \param	cData			Destination for the complex
+*					transformed data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of planes.
+*/
+AlgError	AlgFourPlanReal3D(const double *rData, ComplexD *cData,
+				  int numX, int numY, int numZ)
+{
+  return(AlgFourPlanRealND((void *)rData, cData, 0, 0, numX, numY, numZ));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given three
+*		dimensional complex double data which are laid out as
+*		computed by AlgFourPlanReal3D(). The complex data are
+*		used as workspace and are overwritten.
+*		The transform is not normalised.
+* \param	cData			Given complex data.
+* \param	rData			Destination for the real data.
+* \param	numX			Number of real data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of planes.
+*/
+AlgError	AlgFourPlanRealInv3D(ComplexD *cData, double *rData,
+				     int numX, int numY, int numZ)
+{
+  return(AlgFourPlanRealND(rData, cData, 0, 1, numX, numY, numZ));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Single precision version of AlgFourPlanReal3D().
+* \param	rData			Given real data which are not
+*					modified.
+* \param	cData			Destination for the complex
+*					transformed data.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of planes.
+*/
+AlgError	AlgFourPlanReal3F(const float *rData, ComplexF *cData,
+				  int numX, int numY, int numZ)
+{
+  return(AlgFourPlanRealND((void *)rData, cData, 1, 0, numX, numY, numZ));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Single precision version of AlgFourPlanRealInv3D().
+* \param	cData			Given complex data.
+* \param	rData			Destination for the real data.
+* \param	numX			Number of real data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of planes.
+*/
+AlgError	AlgFourPlanRealInv3F(ComplexF *cData, float *rData,
+				     int numX, int numY, int numZ)
+{
+  return(AlgFourPlanRealND(rData, cData, 1, 1, numX, numY, numZ));
+}
+
+/*!
+* \return	Error code.
+* \brief	Computes the forward or inverse real transform of two
+*		or three dimensional data. For the forward transform
+*		the rows are transformed (in pairs) from the real to
+*		the complex buffer, then the columns and then the
+*		plane columns are transformed in place in the complex
+*		buffer. The inverse transform reverses this sequence.
+*		Each of these steps is parallelised over the rows or
+*		columns using per-thread buffers.
+* \param	rData			Real data buffer.
+* \param	cData			Complex data buffer.
+* \param	isF			Non-zero for float data, otherwise
+*					double.
+* \param	inv			Non-zero for an inverse transform.
+* \param	numX			Number of real data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of planes, 1 for 2D data.
+*/
+static AlgError	AlgFourPlanRealND(void *rData, void *cData, int isF, int inv,
+				  int numX, int numY, int numZ)
+{
+  int		idP,
+  		nXC,
+		nThr = 1,
+		maxN;
+  size_t	nPC;
+  ComplexD	*bufBase = NULL;
+  AlgFourPlan	*plan[3] = {NULL, NULL, NULL};
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanRealND FE %p %p %d %d %d %d %d\n",
+	   rData, cData, isF, inv, numX, numY, numZ));
+  if((rData == NULL) || (cData == NULL) ||
+     (numX < 1) || (numY < 1) || (numZ < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    /* Make plans, sharing them between equal lengths. */
+    plan[0] = AlgFourPlanNew(numX, &errNum);
+    if(errNum == ALG_ERR_NONE)
+    {
+      plan[1] = (numY == numX)? plan[0]: AlgFourPlanNew(numY, &errNum);
+    }
+    if((errNum == ALG_ERR_NONE) && (numZ > 1))
+    {
+      plan[2] = (numZ == numX)? plan[0]:
+                (numZ == numY)? plan[1]: AlgFourPlanNew(numZ, &errNum);
+    }
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    maxN = ALG_MAX3(numX, numY, numZ);
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+        nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if((bufBase = (ComplexD *)
+                  AlcMalloc(sizeof(ComplexD) * 2 * maxN * nThr)) == NULL)
+    {
+      errNum = ALG_ERR_MALLOC;
+    }
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    int		idR,
+    		idS,
+		nRow;
+
+    nXC = (numX / 2) + 1;
+    nPC = (size_t )nXC * numY;
+    nRow = numY * numZ;
+    for(idS = 0; idS < 3; ++idS)
+    {
+      /* Forward passes are x, y, z and inverse passes are z, y, x. */
+      idP = (inv)? 2 - idS: idS;
+      switch(idP)
+      {
+        case 0:
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(static)
+#endif
+	  for(idR = 0; idR < nRow; idR += 2)
+	  {
+	    int	thrId = 0;
+
+#ifdef _OPENMP
+	    thrId = omp_get_thread_num();
+#endif
+	    if(inv)
+	    {
+	      AlgFourPlanRowsC2R(plan[0], bufBase + (2 * maxN * thrId),
+				 cData, rData, isF, idR, nRow);
+	    }
+	    else
+	    {
+	      AlgFourPlanRowsR2C(plan[0], bufBase + (2 * maxN * thrId),
+				 rData, cData, isF, idR, nRow);
+	    }
+	  }
+	  break;
+	case 1:
+	  if(numY > 1)
+	  {
+	    int	nCol;
+
+	    nCol = nXC * numZ;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(static)
+#endif
+	    for(idR = 0; idR < nCol; ++idR)
+	    {
+	      int	thrId = 0;
+	      size_t	off;
+
+#ifdef _OPENMP
+	      thrId = omp_get_thread_num();
+#endif
+	      off = ((idR / nXC) * nPC) + (idR % nXC);
+	      AlgFourPlanCmplxStrided(plan[1], bufBase + (2 * maxN * thrId),
+	                              cData, isF, off, nXC, inv);
+	    }
+	  }
+	  break;
+	case 2:
+	  if(numZ > 1)
+	  {
+	    int	nCol;
+
+	    nCol = (int )nPC;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(static)
+#endif
+	    for(idR = 0; idR < nCol; ++idR)
+	    {
+	      int	thrId = 0;
+
+#ifdef _OPENMP
+	      thrId = omp_get_thread_num();
+#endif
+	      AlgFourPlanCmplxStrided(plan[2], bufBase + (2 * maxN * thrId),
+	                              cData, isF, idR, nPC, inv);
+	    }
+	  }
+	  break;
+      }
+    }
+  }
+  AlcFree(bufBase);
+  if(plan[2] && (plan[2] != plan[1]) && (plan[2] != plan[0]))
+  {
+    AlgFourPlanFree(plan[2]);
+  }
+  if(plan[1] && (plan[1] != plan[0]))
+  {
+    AlgFourPlanFree(plan[1]);
+  }
+  AlgFourPlanFree(plan[0]);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanRealND FX %d\n", errNum));
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \brief	Transforms a pair of real rows, starting with the given
+*		row, into half complex rows. The two real rows a and b
+*		are transformed together as the complex row z = a + ib,
+*		from which \f$A_k = (Z_k + Z^*_{n-k})/2\f$ and
+*		\f$B_k = (Z_k - Z^*_{n-k})/2i\f$. If the given row is
+*		the last row then it is transformed alone.
+* \param	plan			Plan for the row length.
+* \param	buf			Buffer for twice the row length.
+* \param	rData			Real data buffer.
+* \param	cData			Complex data buffer.
+* \param	isF			Non-zero for float data.
+* \param	row			First row of the pair.
+* \param	nRow			Total number of rows.
+*/
+static void	AlgFourPlanRowsR2C(const AlgFourPlan *plan, ComplexD *buf,
+				   void *rData, void *cData, int isF,
+				   int row, int nRow)
+{
+  int		idx,
+  		n,
+		nXC,
+		two;
+  ComplexD	*z;
+  size_t	rOff,
+  		cOff;
+
+  n = plan->num;
+  nXC = (n / 2) + 1;
+  two = (row + 1) < nRow;
+  rOff = (size_t )row * n;
+  cOff = (size_t )row * nXC;
+  if(isF)
+  {
+    float	*a,
+    		*b;
+
+    a = (float *)rData + rOff;
+    b = a + n;
+    for(idx = 0; idx < n; ++idx)
+    {
+      buf[idx].re = a[idx];
+      buf[idx].im = (two)? b[idx]: 0.0;
+    }
+  }
+  else
+  {
+    double	*a,
+    		*b;
+
+    a = (double *)rData + rOff;
+    b = a + n;
+    for(idx = 0; idx < n; ++idx)
+    {
+      buf[idx].re = a[idx];
+      buf[idx].im = (two)? b[idx]: 0.0;
+    }
+  }
+  z = AlgFourPlanRun(plan, buf, buf + n);
+  for(idx = 0; idx < nXC; ++idx)
+  {
+    ComplexD	zk,
+    		zn,
+		a,
+		b;
+
+    zk = z[idx];
+    zn = z[(n - idx) % n];
+    a.re = 0.5 * (zk.re + zn.re);
+    a.im = 0.5 * (zk.im - zn.im);
+    b.re = 0.5 * (zk.im + zn.im);
+    b.im = 0.5 * (zn.re - zk.re);
+    if(isF)
+    {
+      ComplexF	*c;
+
+      c = (ComplexF *)cData + cOff + idx;
+      c->re = (float )(a.re);
+      c->im = (float )(a.im);
+      if(two)
+      {
+        c += nXC;
+	c->re = (float )(b.re);
+	c->im = (float )(b.im);
+      }
+    }
+    else
+    {
+      ComplexD	*c;
+
+      c = (ComplexD *)cData + cOff + idx;
+      *c = a;
+      if(two)
+      {
+        *(c + nXC) = b;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Inverse of AlgFourPlanRowsR2C(), transforms a pair of
+*		half complex rows, starting with the given row, to real
+*		rows using the complex conjugate symmetry of their
+*		spectra to form the complex row \f$Z_k = A_k + i B_k\f$.
+* \param	plan			Plan for the row length.
+* \param	buf			Buffer for twice the row length.
+* \param	cData			Complex data buffer.
+* \param	rData			Real data buffer.
+* \param	isF			Non-zero for float data.
+* \param	row			First row of the pair.
+* \param	nRow			Total number of rows.
+*/
+static void	AlgFourPlanRowsC2R(const AlgFourPlan *plan, ComplexD *buf,
+				   void *cData, void *rData, int isF,
+				   int row, int nRow)
+{
+  int		idx,
+  		n,
+		nXC,
+		two;
+  ComplexD	*z;
+  size_t	rOff,
+  		cOff;
+
+  n = plan->num;
+  nXC = (n / 2) + 1;
+  two = (row + 1) < nRow;
+  rOff = (size_t )row * n;
+  cOff = (size_t )row * nXC;
+  for(idx = 0; idx < nXC; ++idx)
+  {
+    ComplexD	a,
+    		b;
+
+    b.re = b.im = 0.0;
+    if(isF)
+    {
+      ComplexF	*c;
+
+      c = (ComplexF *)cData + cOff + idx;
+      a.re = c->re;
+      a.im = c->im;
+      if(two)
+      {
+        c += nXC;
+	b.re = c->re;
+	b.im = c->im;
+      }
+    }
+    else
+    {
+      ComplexD	*c;
+
+      c = (ComplexD *)cData + cOff + idx;
+      a = *c;
+      if(two)
+      {
+        b = *(c + nXC);
+      }
+    }
+    /* The inverse is computed as the conjugate of the forward transform
+     * of the conjugate, so buf holds conj(A + iB) and its reflection
+     * holds conj(A* + iB*). */
+    buf[idx].re = a.re - b.im;
+    buf[idx].im = -(a.im + b.re);
+    if((idx > 0) && ((n - idx) > idx))
+    {
+      buf[n - idx].re = a.re + b.im;
+      buf[n - idx].im = a.im - b.re;
+    }
+  }
+  z = AlgFourPlanRun(plan, buf, buf + n);
+  if(isF)
+  {
+    float	*a,
+    		*b;
+
+    a = (float *)rData + rOff;
+    b = a + n;
+    for(idx = 0; idx < n; ++idx)
+    {
+      a[idx] = (float )(z[idx].re);
+      if(two)
+      {
+        b[idx] = (float )(-z[idx].im);
+      }
+    }
+  }
+  else
+  {
+    double	*a,
+    		*b;
+
+    a = (double *)rData + rOff;
+    b = a + n;
+    for(idx = 0; idx < n; ++idx)
+    {
+      a[idx] = z[idx].re;
+      if(two)
+      {
+        b[idx] = -z[idx].im;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Transforms a strided complex vector in place, by
+*		copying it to a contiguous double buffer, transforming
+*		it and then copying it back. Inverse transforms are
+*		computed as the conjugate of the forward transform of
+*		the conjugate.
+* \param	plan			Plan for the vector length.
+* \param	buf			Buffer for twice the vector length.
+* \param	data			Complex data buffer.
+* \param	isF			Non-zero for float data.
+* \param	off			Offset of the first element.
+* \param	step			Offset between elements.
+* \param	inv			Non-zero for an inverse transform.
+*/
+static void	AlgFourPlanCmplxStrided(const AlgFourPlan *plan,
+					ComplexD *buf, void *data, int isF,
+					size_t off, size_t step, int inv)
+{
+  int		idx,
+  		n;
+  double	sgn;
+  ComplexD	*z;
+
+  n = plan->num;
+  sgn = (inv)? -1.0: 1.0;
+  if(isF)
+  {
+    ComplexF	*d;
+
+    d = (ComplexF *)data + off;
+    for(idx = 0; idx < n; ++idx)
+    {
+      buf[idx].re = d->re;
+      buf[idx].im = sgn * d->im;
+      d += step;
+    }
+  }
+  else
+  {
+    ComplexD	*d;
+
+    d = (ComplexD *)data + off;
+    for(idx = 0; idx < n; ++idx)
+    {
+      buf[idx].re = d->re;
+      buf[idx].im = sgn * d->im;
+      d += step;
+    }
+  }
+  z = AlgFourPlanRun(plan, buf, buf + n);
+  if(isF)
+  {
+    ComplexF	*d;
+
+    d = (ComplexF *)data + off;
+    for(idx = 0; idx < n; ++idx)
+    {
+      d->re = (float )(z[idx].re);
+      d->im = (float )(sgn * z[idx].im);
+      d += step;
+    }
+  }
+  else
+  {
+    ComplexD	*d;
+
+    d = (ComplexD *)data + off;
+    for(idx = 0; idx < n; ++idx)
+    {
+      d->re = z[idx].re;
+      d->im = sgn * z[idx].im;
+      d += step;
+    }
+  }
+}
+
+/*!
+* \return	Pointer to the buffer holding the unscaled forward
+*		transform, this will be one of the two given buffers.
+* \brief	Computes the unscaled forward transform of the contiguous
+*		data in the first of the given buffers, using a Stockham
+*		autosort decimation in frequency algorithm in which
+*		each pass reads one buffer and writes the other.
+* \param	plan			Plan for the transform length.
+* \param	x			Buffer with the data.
+* \param	y			Work buffer of the same length.
+*/
+static ComplexD	*AlgFourPlanRun(const AlgFourPlan *plan,
+			        ComplexD *x, ComplexD *y)
+{
+  int		idF,
+  		m,
+		n,
+		r,
+		s;
+  ComplexD	*t;
+
+  n = plan->num;
+  s = 1;
+  for(idF = 0; idF < plan->nFac; ++idF)
+  {
+    r = plan->fac[idF];
+    m = n / r;
+    switch(r)
+    {
+      case 2:
+        AlgFourPlanPass2(plan->twiddle, m, s, x, y);
+	break;
+      case 3:
+        AlgFourPlanPass3(plan->twiddle, m, s, x, y);
+	break;
+      case 4:
+        AlgFourPlanPass4(plan->twiddle, m, s, x, y);
+	break;
+      case 5:
+        AlgFourPlanPass5(plan->twiddle, m, s, x, y);
+	break;
+      default:
+        AlgFourPlanPassN(plan->twiddle, plan->num, r, m, s, x, y);
+	break;
+    }
+    t = x; x = y; y = t;
+    n = m;
+    s *= r;
+  }
+  return(x);
+}
+
+/*!
+* \return	void
+* \brief	Radix 2 Stockham pass. With the current sub-transform
+*		length being r * m and the stride s, each pass computes
+*		\f$y_{q + s(rp + k)} = W_{rms}^{pks}
+*		\sum_j x_{q + s(p + jm)} W_r^{jk}\f$.
+* \param	tw			Twiddle factors of the plan.
+* \param	m			Sub-transform length over the radix.
+* \param	s			Stride.
+* \param	x			Source buffer.
+* \param	y			Destination buffer.
+*/
+static void	AlgFourPlanPass2(const ComplexD *tw, int m, int s,
+				 const ComplexD *x, ComplexD *y)
+{
+  int		p,
+  		q;
+
+  for(p = 0; p < m; ++p)
+  {
+    ComplexD	w1;
+    const ComplexD *x0,
+    		*x1;
+    ComplexD	*y0,
+    		*y1;
+
+    w1 = tw[p * s];
+    x0 = x + (s * p);
+    x1 = x0 + (s * m);
+    y0 = y + (s * 2 * p);
+    y1 = y0 + s;
+    for(q = 0; q < s; ++q)
+    {
+      ComplexD	a,
+      		b;
+
+      a = x0[q];
+      b = x1[q];
+      y0[q].re = a.re + b.re;
+      y0[q].im = a.im + b.im;
+      a.re -= b.re;
+      a.im -= b.im;
+      y1[q].re = (a.re * w1.re) - (a.im * w1.im);
+      y1[q].im = (a.re * w1.im) + (a.im * w1.re);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Radix 3 Stockham pass, see AlgFourPlanPass2().
+* \param	tw			Twiddle factors of the plan.
+* \param	m			Sub-transform length over the radix.
+* \param	s			Stride.
+* \param	x			Source buffer.
+* \param	y			Destination buffer.
+*/
+static void	AlgFourPlanPass3(const ComplexD *tw, int m, int s,
+				 const ComplexD *x, ComplexD *y)
+{
+  int		p,
+  		q;
+  const double	s3 = 0.5 * ALG_M_SQRT3;
+
+  for(p = 0; p < m; ++p)
+  {
+    ComplexD	w1,
+    		w2;
+    const ComplexD *x0,
+    		*x1,
+		*x2;
+    ComplexD	*y0,
+    		*y1,
+		*y2;
+
+    w1 = tw[p * s];
+    w2 = tw[2 * p * s];
+    x0 = x + (s * p);
+    x1 = x0 + (s * m);
+    x2 = x1 + (s * m);
+    y0 = y + (s * 3 * p);
+    y1 = y0 + s;
+    y2 = y1 + s;
+    for(q = 0; q < s; ++q)
+    {
+      ComplexD	a,
+      		t1,
+		t2,
+		u,
+		v;
+
+      a = x0[q];
+      t1.re = x1[q].re + x2[q].re;
+      t1.im = x1[q].im + x2[q].im;
+      t2.re = a.re - (0.5 * t1.re);
+      t2.im = a.im - (0.5 * t1.im);
+      u.re = s3 * (x1[q].im - x2[q].im);
+      u.im = -s3 * (x1[q].re - x2[q].re);
+      y0[q].re = a.re + t1.re;
+      y0[q].im = a.im + t1.im;
+      v.re = t2.re + u.re;
+      v.im = t2.im + u.im;
+      y1[q].re = (v.re * w1.re) - (v.im * w1.im);
+      y1[q].im = (v.re * w1.im) + (v.im * w1.re);
+      v.re = t2.re - u.re;
+      v.im = t2.im - u.im;
+      y2[q].re = (v.re * w2.re) - (v.im * w2.im);
+      y2[q].im = (v.re * w2.im) + (v.im * w2.re);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Radix 4 Stockham pass, see AlgFourPlanPass2().
+* \param	tw			Twiddle factors of the plan.
+* \param	m			Sub-transform length over the radix.
+* \param	s			Stride.
+* \param	x			Source buffer.
+* \param	y			Destination buffer.
+*/
+static void	AlgFourPlanPass4(const ComplexD *tw, int m, int s,
+				 const ComplexD *x, ComplexD *y)
+{
+  int		p,
+  		q;
+
+  for(p = 0; p < m; ++p)
+  {
+    ComplexD	w1,
+    		w2,
+		w3;
+    const ComplexD *x0,
+    		*x1,
+		*x2,
+		*x3;
+    ComplexD	*y0,
+    		*y1,
+		*y2,
+		*y3;
+
+    w1 = tw[p * s];
+    w2 = tw[2 * p * s];
+    w3 = tw[3 * p * s];
+    x0 = x + (s * p);
+    x1 = x0 + (s * m);
+    x2 = x1 + (s * m);
+    x3 = x2 + (s * m);
+    y0 = y + (s * 4 * p);
+    y1 = y0 + s;
+    y2 = y1 + s;
+    y3 = y2 + s;
+    for(q = 0; q < s; ++q)
+    {
+      ComplexD	t0,
+      		t1,
+		t2,
+		t3,
+		v;
+
+      t0.re = x0[q].re + x2[q].re;
+      t0.im = x0[q].im + x2[q].im;
+      t1.re = x0[q].re - x2[q].re;
+      t1.im = x0[q].im - x2[q].im;
+      t2.re = x1[q].re + x3[q].re;
+      t2.im = x1[q].im + x3[q].im;
+      /* t3 = -i(x1 - x3) */
+      t3.re = x1[q].im - x3[q].im;
+      t3.im = x3[q].re - x1[q].re;
+      y0[q].re = t0.re + t2.re;
+      y0[q].im = t0.im + t2.im;
+      v.re = t1.re + t3.re;
+      v.im = t1.im + t3.im;
+      y1[q].re = (v.re * w1.re) - (v.im * w1.im);
+      y1[q].im = (v.re * w1.im) + (v.im * w1.re);
+      v.re = t0.re - t2.re;
+      v.im = t0.im - t2.im;
+      y2[q].re = (v.re * w2.re) - (v.im * w2.im);
+      y2[q].im = (v.re * w2.im) + (v.im * w2.re);
+      v.re = t1.re - t3.re;
+      v.im = t1.im - t3.im;
+      y3[q].re = (v.re * w3.re) - (v.im * w3.im);
+      y3[q].im = (v.re * w3.im) + (v.im * w3.re);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Radix 5 Stockham pass, see AlgFourPlanPass2().
+* \param	tw			Twiddle factors of the plan.
+* \param	m			Sub-transform length over the radix.
+* \param	s			Stride.
+* \param	x			Source buffer.
+* \param	y			Destination buffer.
+*/
+static void	AlgFourPlanPass5(const ComplexD *tw, int m, int s,
+				 const ComplexD *x, ComplexD *y)
+{
+  int		p,
+  		q,
+		k;
+  const double	c1 = 0.30901699437494742410,	/* cos(2pi/5) */
+  		c2 = -0.80901699437494742410,	/* cos(4pi/5) */
+		s1 = 0.95105651629515357212,	/* sin(2pi/5) */
+		s2 = 0.58778525229247312917;	/* sin(4pi/5) */
+
+  for(p = 0; p < m; ++p)
+  {
+    ComplexD	w[5];
+    const ComplexD *x0,
+    		*x1,
+		*x2,
+		*x3,
+		*x4;
+    ComplexD	*y0;
+
+    for(k = 1; k < 5; ++k)
+    {
+      w[k] = tw[k * p * s];
+    }
+    x0 = x + (s * p);
+    x1 = x0 + (s * m);
+    x2 = x1 + (s * m);
+    x3 = x2 + (s * m);
+    x4 = x3 + (s * m);
+    y0 = y + (s * 5 * p);
+    for(q = 0; q < s; ++q)
+    {
+      ComplexD	a,
+      		t1,
+		t2,
+		t3,
+		t4,
+		b1,
+		b2,
+		u1,
+		u2,
+		v[5];
+
+      a = x0[q];
+      t1.re = x1[q].re + x4[q].re;
+      t1.im = x1[q].im + x4[q].im;
+      t2.re = x2[q].re + x3[q].re;
+      t2.im = x2[q].im + x3[q].im;
+      t3.re = x1[q].re - x4[q].re;
+      t3.im = x1[q].im - x4[q].im;
+      t4.re = x2[q].re - x3[q].re;
+      t4.im = x2[q].im - x3[q].im;
+      b1.re = a.re + (c1 * t1.re) + (c2 * t2.re);
+      b1.im = a.im + (c1 * t1.im) + (c2 * t2.im);
+      b2.re = a.re + (c2 * t1.re) + (c1 * t2.re);
+      b2.im = a.im + (c2 * t1.im) + (c1 * t2.im);
+      /* u1 = -i(s1 t3 + s2 t4), u2 = -i(s2 t3 - s1 t4) */
+      u1.re = (s1 * t3.im) + (s2 * t4.im);
+      u1.im = -((s1 * t3.re) + (s2 * t4.re));
+      u2.re = (s2 * t3.im) - (s1 * t4.im);
+      u2.im = -((s2 * t3.re) - (s1 * t4.re));
+      v[1].re = b1.re + u1.re;
+      v[1].im = b1.im + u1.im;
+      v[4].re = b1.re - u1.re;
+      v[4].im = b1.im - u1.im;
+      v[2].re = b2.re + u2.re;
+      v[2].im = b2.im + u2.im;
+      v[3].re = b2.re - u2.re;
+      v[3].im = b2.im - u2.im;
+      y0[q].re = a.re + t1.re + t2.re;
+      y0[q].im = a.im + t1.im + t2.im;
+      for(k = 1; k < 5; ++k)
+      {
+	ComplexD *yk;
+
+	yk = y0 + (k * s) + q;
+        yk->re = (v[k].re * w[k].re) - (v[k].im * w[k].im);
+        yk->im = (v[k].re * w[k].im) + (v[k].im * w[k].re);
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Stockham pass for any radix, see AlgFourPlanPass2(),
+*		which directly evaluates the radix r DFT. This is
+*		only used for prime factors greater than 5.
+* \param	tw			Twiddle factors of the plan.
+* \param	num			Length of the plan.
+* \param	r			Radix.
+* \param	m			Sub-transform length over the radix.
+* \param	s			Stride.
+* \param	x			Source buffer.
+* \param	y			Destination buffer.
+*/
+static void	AlgFourPlanPassN(const ComplexD *tw, int num, int r,
+				 int m, int s,
+				 const ComplexD *x, ComplexD *y)
+{
+  int		j,
+  		k,
+		p,
+		q,
+		rS;
+
+  rS = num / r;				/* W_r^j = tw[j * rS] */
+  for(p = 0; p < m; ++p)
+  {
+    for(k = 0; k < r; ++k)
+    {
+      ComplexD	w;
+
+      w = tw[k * p * s];
+      for(q = 0; q < s; ++q)
+      {
+	ComplexD	v;
+
+	v.re = v.im = 0.0;
+	for(j = 0; j < r; ++j)
+	{
+	  ComplexD	a,
+	  		wr;
+
+	  a = x[q + (s * (p + (j * m)))];
+	  wr = tw[((j * k) % r) * rS];
+	  v.re += (a.re * wr.re) - (a.im * wr.im);
+	  v.im += (a.re * wr.im) + (a.im * wr.re);
+	}
+	y[q + (s * ((r * p) + k))].re = (v.re * w.re) - (v.im * w.im);
+	y[q + (s * ((r * p) + k))].im = (v.re * w.im) + (v.im * w.re);
+      }
+    }
+  }
+}
@@ -163,12 +163,12 @@ extern void     		AlgFourHart1D(
 				  double *data,
 				  int num, 
 				  int step);
-extern void			AlgFour1D(
+extern AlgError			AlgFour1D(
 				  double *real,
 				  double *imag,
 				  int num,
 				  int step);
-extern void			AlgFourInv1D(
+extern AlgError			AlgFourInv1D(
 				  double *real,
 				  double *imag,
 				  int num,
@@ -235,6 +235,76 @@ extern AlgError        		AlgFourRealInv3D(
 				  int numY,
 				  int numZ);
 
+/* From AlgFourierPlan.c */
+extern int			AlgFourPlanGoodSize(
+				  int num);
+extern AlgFourPlan		*AlgFourPlanNew(
+				  int num,
+				  AlgError *dstErr);
+extern void			AlgFourPlanFree(
+				  AlgFourPlan *plan);
+extern AlgError			AlgFourPlanCmplx1D(
+				  const AlgFourPlan *plan,
+				  ComplexD *data,
+				  int step,
+				  int inv);
+extern AlgError			AlgFourPlanCmplx1F(
+				  const AlgFourPlan *plan,
+				  ComplexF *data,
+				  int step,
+				  int inv);
+extern AlgError			AlgFourPlanCmplxSplit1D(
+				  const AlgFourPlan *plan,
+				  ComplexD *buf,
+				  double *real,
+				  double *imag,
+				  int step,
+				  int inv);
+extern AlgError			AlgFourPlanReal2D(
+				  const double *rData,
+				  ComplexD *cData,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourPlanRealInv2D(
+				  ComplexD *cData,
+				  double *rData,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourPlanReal2F(
+				  const float *rData,
+				  ComplexF *cData,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourPlanRealInv2F(
+				  ComplexF *cData,
+				  float *rData,
+				  int numX,
+				  int numY);
+extern AlgError			AlgFourPlanReal3D(
+				  const double *rData,
+				  ComplexD *cData,
+				  int numX,
+				  int numY,
+				  int numZ);
+extern AlgError			AlgFourPlanRealInv3D(
+				  ComplexD *cData,
+				  double *rData,
+				  int numX,
+				  int numY,
+				  int numZ);
+extern AlgError			AlgFourPlanReal3F(
+				  const float *rData,
+				  ComplexF *cData,
+				  int numX,
+				  int numY,
+				  int numZ);
+extern AlgError			AlgFourPlanRealInv3F(
+				  ComplexF *cData,
+				  float *rData,
+				  int numX,
+				  int numY,
+				  int numZ);
+
 /* From AlgGamma.c */
 extern double			AlgGammaLog(
 				  double x,
@@ -249,6 +249,42 @@ typedef struct _ComplexD
   double	im;
 } ComplexD;
 
+/*!
+* \struct	_ComplexF
+* \brief	Single precision complex number data type.
+* 		Typedef: ::ComplexF.
+*/
+typedef struct _ComplexF
+{
+  float		re;
+  float		im;
+} ComplexF;
+
+/*!
+* \def		ALG_FOUR_PLAN_MAX_FAC
+* \brief	Maximum number of factors of a Fourier transform plan's
+*		length, sufficient for any length that fits an int.
+*/
+#define ALG_FOUR_PLAN_MAX_FAC	(32)
+
+/*!
+* \struct	_AlgFourPlan
+* \brief	Plan for mixed radix Fourier transforms of a given length.
+*		The twiddle factors are computed once when the plan is
+*		made and are then shared by all transforms of the length.
+* 		Typedef: ::AlgFourPlan.
+*/
+typedef struct _AlgFourPlan
+{
+  int		num;		/*!< Transform length. */
+  int		nFac;		/*!< Number of factors of the length. */
+  int		fac[ALG_FOUR_PLAN_MAX_FAC]; /*!< Factors (radices) of the
+  				     length in the order they are applied. */
+  ComplexD	*twiddle;	/*!< Forward twiddle factors
+  				     \f$e^{-2 \pi i k/n}\f$ for
+				     \f$k = 0, \ldots, n - 1\f$. */
+} AlgFourPlan;
+
 
 /*
 * \enum		_AlgError
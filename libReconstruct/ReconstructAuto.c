@@ -42,6 +42,46 @@ static char _ReconstructAuto_c[] = "University of Edinburgh $Id$";
 
 #include <Reconstruct.h>
 #include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_RecAutoWork
+* \ingroup	Reconstruct
+* \brief	Application work function and data which are wrapped
+*		so that concurrent pair registrations call the work
+*		function one at a time.
+*/
+typedef struct _RecAutoWork
+{
+  RecWorkFunction fn;			/*!< Application work function. */
+  void		*data;			/*!< Application work function data. */
+} RecAutoWork;
+
+static void			RecAutoWorkFn(
+				  RecState *state,
+				  void *data);
+static RecError			RecAutoStart(
+				  RecControl *rCtrl,
+				  HGUDlpList *secList,
+				  HGUDlpListItem **dstItem,
+				  RecSection **dstSec0,
+				  RecSection **dstSec1);
+static RecError			RecAutoFill(
+				  RecControl *rCtrl,
+				  HGUDlpList *secList,
+				  HGUDlpListItem **item,
+				  RecSection **sec,
+				  int *nSec,
+				  int maxSec,
+				  int *more);
+static RecError			RecAutoEnd(
+				  RecError errFlag,
+				  int *cancelFlag,
+				  RecWorkFunction workFn,
+				  void *workData,
+				  char **eMsg);
 
 /*!
 * \return	Non zero if registration fails.
@@ -70,15 +110,11 @@ RecError	RecAuto(RecControl *rCtrl, RecPPControl *ppCtrl,
 			RecWorkFunction workFn, void *workData,
 			char **eMsg)
 {
-  RecState	rState;
   RecSection	*oSec0 = NULL,
 		*oSec1 = NULL,
 		*nSec0 = NULL,
 		*nSec1 = NULL;
   HGUDlpListItem *item = NULL;
-  static char	errMsgInvalidListStr[] =
-	     		"Section list or the registration limits are invalid.",
-	     	errMsgMallocStr[] = "Not enough memory available.";
   RecError	errFlag = REC_ERR_NONE;
 
   REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
@@ -94,38 +130,7 @@ RecError	RecAuto(RecControl *rCtrl, RecPPControl *ppCtrl,
   }
   if(errFlag == REC_ERR_NONE)
   {
-    if(((item = RecSecFindItemIndex(secList, NULL, rCtrl->firstIdx,
-     				    HGU_DLPLIST_DIR_TOTAIL)) == NULL) ||
-       ((oSec0 = (RecSection *)HGUDlpListEntryGet(secList, item)) == NULL))
-    {
-      errFlag = REC_ERR_LIST;
-    }
-  }
-  if(errFlag == REC_ERR_NONE)
-  {
-    if(RecSecIsEmpty(oSec0))
-    {
-      if((oSec0 = RecSecNext(secList, item, &item, 1)) == NULL)
-      {
-        errFlag = REC_ERR_LIST;
-      }
-    }
-  }
-  if(errFlag == REC_ERR_NONE)
-  {
-    if((oSec1 = RecSecNext(secList, item, &item, 1)) == NULL)
-    {
-      errFlag = REC_ERR_LIST;
-    }
-  }
-  if(errFlag == REC_ERR_NONE)
-  {
-    if((oSec0->index != rCtrl->firstIdx) ||
-       (oSec1->index < rCtrl->firstIdx) ||
-       (oSec1->index > rCtrl->lastIdx))
-    {
-      errFlag = REC_ERR_LIST;
-    }
+    errFlag = RecAutoStart(rCtrl, secList, &item, &oSec0, &oSec1);
   }
   if(errFlag == REC_ERR_NONE)
   {
@@ -187,6 +192,438 @@ RecError	RecAuto(RecControl *rCtrl, RecPPControl *ppCtrl,
   {
     RecSecFree(nSec1);
   }
+  errFlag = RecAutoEnd(errFlag, cancelFlag, workFn, workData, eMsg);
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAuto FX %d\n",
+	   errFlag));
+  return(errFlag);
+}
+
+/*!
+* \return	Non zero if registration fails.
+* \ingroup	Reconstruct
+* \brief	Performs the automatic registration of serial sections
+*		as RecAuto(), but with many adjacent pairs of sections
+*		registered concurrently.
+*
+*		The sections are taken from the list in batches of
+*		up to nPair + 1 sections. The section images of a batch
+*		are read concurrently and then the nPair pairs of the
+*		batch are registered concurrently. Each registration
+*		only sets the transform relative to the previous
+*		section, so the pairs are independent. Once a batch
+*		has been registered the section update function is
+*		called for its sections in order, so that the list
+*		is updated exactly as by RecAuto(). The last section
+*		of each batch is kept as the first of the next.
+*
+*		The cancel flag is checked before each pair is
+*		registered and the application's work function is
+*		never called by more than one thread at a time.
+*		If a pair fails or is cancelled then only the sections
+*		before it are updated.
+* \param	rCtrl			The registration control data
+* 					structure.
+* \param	ppCtrl			Pre-processing control data
+*					structure.
+* \param	secList			Section list.
+* \param	cancelFlag		Cancel if flag pointed to is non-zero.
+* \param	secFn			application supplied section update
+*					function. This function is responsible
+*					for replacing the section in the list,
+*					it may also display it, etc, ....
+* \param	secData			Application supplied data for section
+* 					update function.
+* \param	workFn			Application supplied work function.
+* \param	workData		Application supplied data for the
+*					work function.
+* \param	nPair			Maximum number of pairs of sections
+*					registered concurrently, this also
+*					bounds the number of section images
+*					held in memory to nPair + 1. If less
+*					than one then twice the number of
+*					threads is used.
+* \param	eMsg			Pointer for error message strings.
+*/
+RecError	RecAutoPar(RecControl *rCtrl, RecPPControl *ppCtrl,
+			   HGUDlpList *secList, int *cancelFlag,
+			   RecSecUpdateFunction secFn, void *secData,
+			   RecWorkFunction workFn, void *workData,
+			   int nPair, char **eMsg)
+{
+  int		idS,
+  		idF,
+  		idK,
+		full,
+		nSec = 0,
+		more = 1;
+  int		*done = NULL;
+  char		**msg = NULL;
+  RecError	*rdErr = NULL,
+  		*regErr = NULL;
+  RecSection	*oSec0 = NULL,
+		*oSec1 = NULL,
+		*keep;
+  RecSection	**sec = NULL;
+  HGUDlpListItem *item = NULL;
+  RecAutoWork	work;
+  RecError	errFlag = REC_ERR_NONE,
+  		fillErr = REC_ERR_NONE;
+
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAutoPar FE 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx "
+	   "%d 0x%lx\n",
+	   (unsigned long )rCtrl, (unsigned long )ppCtrl,
+	   (unsigned long )secList, (unsigned long )cancelFlag,
+	   (unsigned long )secFn, (unsigned long )secData,
+	   (unsigned long )workFn, (unsigned long )workData,
+	   nPair, (unsigned long )eMsg));
+  if((rCtrl == NULL) || (ppCtrl == NULL) || (secList == NULL))
+  {
+    errFlag = REC_ERR_FUNC;
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    errFlag = RecAutoStart(rCtrl, secList, &item, &oSec0, &oSec1);
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(nPair < 1)
+    {
+#ifdef _OPENMP
+      nPair = 2 * omp_get_max_threads();
+#else
+      nPair = 1;
+#endif
+    }
+    if(((sec = (RecSection **)
+               AlcCalloc(nPair + 1, sizeof(RecSection *))) == NULL) ||
+       ((msg = (char **)AlcCalloc(nPair + 1, sizeof(char *))) == NULL) ||
+       ((done = (int *)AlcCalloc(nPair + 1, sizeof(int))) == NULL) ||
+       ((rdErr = (RecError *)
+                 AlcCalloc(nPair + 1, sizeof(RecError))) == NULL) ||
+       ((regErr = (RecError *)
+                  AlcCalloc(nPair + 1, sizeof(RecError))) == NULL))
+    {
+      errFlag = REC_ERR_MALLOC;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if((sec[0] = RecSecDup(oSec0)) != NULL)
+    {
+      nSec = 1;
+      sec[1] = RecSecDup(oSec1);
+    }
+    if(sec[1] == NULL)
+    {
+      errFlag = REC_ERR_MALLOC;
+    }
+    else
+    {
+      nSec = 2;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    errFlag = RecFileSecObjRead(sec[0], eMsg);
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    /* A list error found while filling a batch is only reported once
+     * the sections before it have been registered, as in RecAuto(). */
+    fillErr = RecAutoFill(rCtrl, secList, &item, sec, &nSec, nPair + 1,
+    			  &more);
+  }
+  work.fn = workFn;
+  work.data = workData;
+  while((errFlag == REC_ERR_NONE) && (*cancelFlag == 0) && (nSec > 1))
+  {
+    for(idS = 0; idS < nSec; ++idS)
+    {
+      msg[idS] = NULL;
+      done[idS] = 0;
+      rdErr[idS] = REC_ERR_NONE;
+      regErr[idS] = REC_ERR_NONE;
+    }
+    /* Read the section images of the batch and then register each
+     * section with the previous one. */
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(idS = 1; idS < nSec; ++idS)
+      {
+	rdErr[idS] = RecFileSecObjRead(sec[idS], &(msg[idS]));
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(idS = 1; idS < nSec; ++idS)
+      {
+        if((*cancelFlag == 0) &&
+	   (rdErr[idS - 1] == REC_ERR_NONE) && (rdErr[idS] == REC_ERR_NONE))
+	{
+	  regErr[idS] = RecRegisterPair(&(sec[idS]->transform),
+					&(sec[idS]->correl),
+					&(sec[idS]->iterations),
+					rCtrl, ppCtrl,
+					sec[idS - 1]->obj, sec[idS]->obj,
+					(workFn)? RecAutoWorkFn: NULL, &work,
+					&(msg[idS]));
+	  done[idS] = 1;
+	}
+      }
+    }
+    /* Update the list in order, exactly as RecAuto() would, stopping at
+     * the first pair which was cancelled or failed. */
+    idK = 0;
+    idF = 0;
+    for(idS = 1; (errFlag == REC_ERR_NONE) && (idS < nSec); ++idS)
+    {
+      if(*cancelFlag || ((done[idS] == 0) && (rdErr[idS] == REC_ERR_NONE)))
+      {
+        break;
+      }
+      if(secFn)
+      {
+	(*secFn)(sec[idS - 1], secData);
+      }
+      if(rdErr[idS] != REC_ERR_NONE)
+      {
+        errFlag = rdErr[idS];
+	idF = idS;
+      }
+      else if(regErr[idS] != REC_ERR_NONE)
+      {
+        errFlag = regErr[idS];
+	idF = idS;
+      }
+      else
+      {
+	idK = idS;
+      }
+    }
+    if((errFlag != REC_ERR_NONE) && (*eMsg == NULL))
+    {
+      *eMsg = msg[idF];
+      msg[idF] = NULL;
+    }
+    /* Keep only the last updated section, as the first of the next
+     * batch. */
+    keep = sec[idK];
+    full = idK == nSec - 1;
+    for(idS = 0; idS < nSec; ++idS)
+    {
+      AlcFree(msg[idS]);
+      if(idS != idK)
+      {
+	RecSecFree(sec[idS]);
+      }
+      sec[idS] = NULL;
+    }
+    sec[0] = keep;
+    nSec = 1;
+    if((errFlag == REC_ERR_NONE) && full)
+    {
+      if(fillErr != REC_ERR_NONE)
+      {
+	errFlag = fillErr;
+      }
+      else
+      {
+	fillErr = RecAutoFill(rCtrl, secList, &item, sec, &nSec, nPair + 1,
+			      &more);
+      }
+    }
+  }
+  if((errFlag == REC_ERR_NONE) && secFn && (nSec > 0))
+  {
+    (*secFn)(sec[0], secData);
+  }
+  for(idS = 0; idS < nSec; ++idS)
+  {
+    RecSecFree(sec[idS]);
+  }
+  AlcFree(sec);
+  AlcFree(msg);
+  AlcFree(done);
+  AlcFree(rdErr);
+  AlcFree(regErr);
+  errFlag = RecAutoEnd(errFlag, cancelFlag, workFn, workData, eMsg);
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAutoPar FX %d\n",
+	   errFlag));
+  return(errFlag);
+}
+
+/*!
+* \return	void
+* \ingroup	Reconstruct
+* \brief	Work function passed to RecRegisterPair() by RecAutoPar()
+*		which calls the application's work function within a
+*		critical section.
+* \param	state			Registration state.
+* \param	data			Used to pass the RecAutoWork.
+*/
+static void	RecAutoWorkFn(RecState *state, void *data)
+{
+  RecAutoWork	*work;
+
+  work = (RecAutoWork *)data;
+#ifdef _OPENMP
+#pragma omp critical (RecAutoWorkFn)
+#endif
+  {
+    (*(work->fn))(state, work->data);
+  }
+}
+
+/*!
+* \return	Non zero if the section list is invalid.
+* \ingroup	Reconstruct
+* \brief	Finds the first pair of sections to be registered.
+* \param	rCtrl			The registration control data
+* 					structure.
+* \param	secList			Section list.
+* \param	dstItem			Destination pointer for the list
+*					item of the second section.
+* \param	dstSec0			Destination pointer for the first
+*					section.
+* \param	dstSec1			Destination pointer for the second
+*					section.
+*/
+static RecError	RecAutoStart(RecControl *rCtrl, HGUDlpList *secList,
+			     HGUDlpListItem **dstItem,
+			     RecSection **dstSec0, RecSection **dstSec1)
+{
+  RecSection	*oSec0 = NULL,
+		*oSec1 = NULL;
+  HGUDlpListItem *item = NULL;
+  RecError	errFlag = REC_ERR_NONE;
+
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(((item = RecSecFindItemIndex(secList, NULL, rCtrl->firstIdx,
+     				    HGU_DLPLIST_DIR_TOTAIL)) == NULL) ||
+       ((oSec0 = (RecSection *)HGUDlpListEntryGet(secList, item)) == NULL))
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(RecSecIsEmpty(oSec0))
+    {
+      if((oSec0 = RecSecNext(secList, item, &item, 1)) == NULL)
+      {
+        errFlag = REC_ERR_LIST;
+      }
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if((oSec1 = RecSecNext(secList, item, &item, 1)) == NULL)
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if((oSec0->index != rCtrl->firstIdx) ||
+       (oSec1->index < rCtrl->firstIdx) ||
+       (oSec1->index > rCtrl->lastIdx))
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  *dstItem = item;
+  *dstSec0 = oSec0;
+  *dstSec1 = oSec1;
+  return(errFlag);
+}
+
+/*!
+* \return	Non zero if the section list is invalid.
+* \ingroup	Reconstruct
+* \brief	Appends copies of the following sections in the list to
+*		the given array of sections, until either the array is
+*		full or the last section to be registered has been
+*		appended.
+* \param	rCtrl			The registration control data
+* 					structure.
+* \param	secList			Section list.
+* \param	item			List item of the last section in the
+*					array, updated as sections are
+*					appended.
+* \param	sec			Array of sections.
+* \param	nSec			Number of sections in the array,
+*					updated as sections are appended.
+* \param	maxSec			Maximum number of sections in the
+*					array.
+* \param	more			Set to zero once there are no more
+*					sections to be appended.
+*/
+static RecError	RecAutoFill(RecControl *rCtrl, HGUDlpList *secList,
+			    HGUDlpListItem **item, RecSection **sec,
+			    int *nSec, int maxSec, int *more)
+{
+  RecSection	*oSec;
+  RecError	errFlag = REC_ERR_NONE;
+
+  while(*more && (*nSec < maxSec))
+  {
+    if(sec[*nSec - 1]->index >= rCtrl->lastIdx)
+    {
+      *more = 0;
+    }
+    else if((oSec = RecSecNext(secList, *item, item, 1)) == NULL)
+    {
+      errFlag = REC_ERR_LIST;
+      *more = 0;
+    }
+    else if(oSec->index > rCtrl->lastIdx)
+    {
+      *more = 0;
+    }
+    else if((sec[*nSec] = RecSecDup(oSec)) == NULL)
+    {
+      errFlag = REC_ERR_MALLOC;
+      *more = 0;
+    }
+    else
+    {
+      ++*nSec;
+    }
+  }
+  return(errFlag);
+}
+
+/*!
+* \return	Non zero if registration failed or was cancelled.
+* \ingroup	Reconstruct
+* \brief	Sets the cancel error code and error message and then
+*		calls the application's work function to report the
+*		final state of an automatic registration.
+* \param	errFlag			Error code of the registration.
+* \param	cancelFlag		Cancel flag.
+* \param	workFn			Application supplied work function.
+* \param	workData		Application supplied data for the
+*					work function.
+* \param	eMsg			Pointer for error message strings.
+*/
+static RecError	RecAutoEnd(RecError errFlag, int *cancelFlag,
+			   RecWorkFunction workFn, void *workData,
+			   char **eMsg)
+{
+  RecState	rState;
+  static char	errMsgInvalidListStr[] =
+	     		"Section list or the registration limits are invalid.",
+	     	errMsgMallocStr[] = "Not enough memory available.";
+
   if(*cancelFlag && (errFlag == REC_ERR_NONE))
   {
     errFlag = REC_ERR_CANCEL;
@@ -215,8 +652,5 @@ RecError	RecAuto(RecControl *rCtrl, RecPPControl *ppCtrl,
     rState.errFlag = errFlag;
     (*workFn)(&rState, workData);
   }
-  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
-	  ("RecAuto FX %d\n",
-	   errFlag));
   return(errFlag);
 }
@@ -95,9 +95,11 @@ WlzObject 	*WlzGetSectionFromObject(
   WlzObject	*newObj = NULL;
   WlzDomain	dom;
   WlzValues	val;
+  WlzPerfScope	perfScope;
   WlzErrorNum 	errNum = WLZ_ERR_NONE;
 
 
+  WLZ_PERF_BEGIN(perfScope, "WlzGetSectionFromObject");
   if(obj == NULL)
   {
     errNum = WLZ_ERR_OBJECT_NULL;
@@ -135,6 +137,7 @@ WlzObject 	*WlzGetSectionFromObject(
   {
     *dstErr = errNum;
   }
+  WLZ_PERF_END(perfScope);
   return(newObj);
 }
 
@@ -60,6 +60,37 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzInterpolationType	interp,
   WlzObject		**maskRtn,
   WlzErrorNum 		*dstErr);
+static WlzErrorNum	WlzGetSectionTileBand(
+  WlzGreyValueWSpace	*gVWSp,
+  WlzInterpolationType	interp,
+  WlzGreyType		gType,
+  WlzGreyP		dst,
+  int			width,
+  int			ln0,
+  int			ln1,
+  double		scale,
+  double		**colPos,
+  WlzDVertex3		rowStep);
+static void		WlzGetSectionTileSet(
+  WlzGreyP		dst,
+  size_t		off,
+  WlzGreyType		gType,
+  double		*val,
+  int			n);
+
+/*!
+* \def		WLZ_SECTION_TILE_BLKSZ
+* \brief	Number of columns of a section tile row which are sampled
+* 		together.
+*/
+#define WLZ_SECTION_TILE_BLKSZ	(64)
+
+/*!
+* \def		WLZ_SECTION_TILE_BAND
+* \brief	Number of section tile rows which are sampled by a thread
+* 		using the same grey value cursors.
+*/
+#define WLZ_SECTION_TILE_BAND	(16)
 
 
 /*!
@@ -293,6 +324,7 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
                   lnRel;
       WlzDVertex3 vty;
       WlzGreyP	  lnGP;
+      WlzTiledValuesTile *tile = NULL;
 
       lnRel = ln - subBox.yMin;
       switch(gType)
@@ -392,6 +424,7 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 #endif
 	      {
 		size_t   off;
+		WlzGreyP tGP;
 
 #ifdef WLZ_FAST_CODE
 		off = (idx  << 12) +
@@ -407,25 +440,37 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 		       tv->tileWidth) + tOff.vtX;
 #endif
 		off *= tv->vpe;
-		switch(gType)
+		tGP = tv->tiles;
+		if(tv->cmp)
+		{
+		  /* Compressed tiles, hold the current tile for this line. */
+		  if((tile == NULL) || (tile->idx != idx))
+		  {
+		    WlzTiledValuesTileRelease(tile);
+		    tile = WlzTiledValuesTileGet(tv, idx, NULL);
+		  }
+		  tGP.v = (tile)? tile->values.v: NULL;
+		  off -= idx * tv->tileSz * tv->vpe;
+		}
+		switch((tGP.v)? gType: WLZ_GREY_ERROR)
 		{
 	          case WLZ_GREY_INT:
-		    lnGP.inp[klRel] = tv->tiles.inp[off];
+		    lnGP.inp[klRel] = tGP.inp[off];
 		    break;
 	          case WLZ_GREY_SHORT:
-		    lnGP.shp[klRel] = tv->tiles.shp[off];
+		    lnGP.shp[klRel] = tGP.shp[off];
 		    break;
 	          case WLZ_GREY_UBYTE:
-		    lnGP.ubp[klRel] = tv->tiles.ubp[off];
+		    lnGP.ubp[klRel] = tGP.ubp[off];
 		    break;
 	          case WLZ_GREY_FLOAT:
-		    lnGP.flp[klRel] = tv->tiles.flp[off];
+		    lnGP.flp[klRel] = tGP.flp[off];
 		    break;
 	          case WLZ_GREY_DOUBLE:
-		    lnGP.dbp[klRel] = tv->tiles.dbp[off];
+		    lnGP.dbp[klRel] = tGP.dbp[off];
 		    break;
 	          case WLZ_GREY_RGBA:
-		    lnGP.rgbp[klRel] = tv->tiles.rgbp[off];
+		    lnGP.rgbp[klRel] = tGP.rgbp[off];
 		    break;
 		  default:
 		    break;
@@ -435,6 +480,7 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
 	  }
 	}
       }
+      WlzTiledValuesTileRelease(tile);
     }
   }
   if(dstErr)
@@ -886,3 +932,472 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   }
   return(newObj);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Cuts a rectangular tile from a section through the given
+* 		3D domain object with values, writing the values directly
+* 		into the given buffer rather than creating a new object.
+* 		This is intended for serving arbitrary sections of large
+* 		volumes to viewers, where the same object and view are
+* 		used for many tiles and the view structure need only be
+* 		initialised once (by WlzInit3DViewStruct()).
+*
+* 		The tile is given in the coordinates of the section at the
+* 		given scale, so that the tile column kl and line ln are
+* 		at (kl / scale, ln / scale) in the coordinates of the
+* 		section computed by WlzGetSubSectionFromObject(). With a
+* 		scale of 1.0 the tile values are the same as those of that
+* 		section (with the tile's columns and lines clipped to its
+* 		domain) for nearest neighbour interpolation.
+*
+* 		The values are of the object's grey type and are written
+* 		line by line with (tile.xMax - tile.xMin + 1) values per
+* 		line. Values outside of the object have the object's
+* 		background value. The lines of the tile are sampled in
+* 		parallel (when OpenMP is used) through grey value cursors
+* 		which share the grey value work space. Neither the view
+* 		structure nor the work space are modified, so they may be
+* 		reused for any number of tiles.
+* \param	obj			Given 3D domain object with values.
+* \param	gVWSp			Grey value work space for the given
+* 					object, may be NULL in which case
+* 					a work space is created and free'd
+* 					within this function.
+* \param	view			Given initialised view structure.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR (linear
+* 					interpolation is not available for
+* 					RGBA values).
+* \param	scale			Scale of the tile with respect to
+* 					the section, must be greater than
+* 					zero.
+* \param	tile			Tile within the scaled section.
+* \param	dst			Destination buffer for the tile
+* 					values which must have room for
+* 					all of the tile's values.
+*/
+WlzErrorNum	WlzGetSectionTileFromObject(
+  WlzObject		*obj,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*view,
+  WlzInterpolationType	interp,
+  double		scale,
+  WlzIBox2		tile,
+  WlzGreyP		dst)
+{
+  int			width = 0,
+  			height = 0;
+  double		*colPos[3] = {NULL};
+  WlzGreyType		gType = WLZ_GREY_ERROR;
+  WlzDVertex3		rowStep;
+  WlzAffineTransform	*invTr = NULL;
+  WlzGreyValueWSpace	*newGVWSp = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->type != WLZ_3D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((view == NULL) || (dst.v == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(view->type != WLZ_3D_VIEW_STRUCT)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(!(view->initialised) || (view->trans == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_DATA;
+  }
+  else if((scale < DBL_EPSILON) ||
+          (tile.xMin > tile.xMax) || (tile.yMin > tile.yMax))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    width = tile.xMax - tile.xMin + 1;
+    height = tile.yMax - tile.yMin + 1;
+    gType = WlzGreyTypeFromObj(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+	break;
+      case WLZ_GREY_RGBA:
+	if(interp != WLZ_INTERPOLATION_NEAREST)
+	{
+	  errNum = WLZ_ERR_GREY_TYPE;
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(interp)
+    {
+      case WLZ_INTERPOLATION_NEAREST: /* FALLTHROUGH */
+      case WLZ_INTERPOLATION_LINEAR:
+	break;
+      default:
+	errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (gVWSp == NULL))
+  {
+    gVWSp = newGVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  /* Compute the object coordinates of the tile columns on line zero and
+   * the increment for each tile line, in the same way as the view
+   * structure's look up tables are computed by
+   * Wlz3DViewStructSetupTransformLuts(). */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    invTr = WlzAffineTransformInverse(view->trans, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((colPos[0] = (double *)AlcMalloc(sizeof(double) * 3 *
+                                        width)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	idx;
+
+      colPos[1] = colPos[0] + width;
+      colPos[2] = colPos[1] + width;
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < width); ++idx)
+      {
+	WlzDVertex3 p;
+
+	p.vtX = (tile.xMin + idx) / scale;
+	p.vtY = 0.0;
+	p.vtZ = view->dist;
+	p = WlzAffineTransformVertexD3(invTr, p, &errNum);
+	colPos[0][idx] = p.vtX;
+	colPos[1][idx] = p.vtY;
+	colPos[2][idx] = p.vtZ;
+      }
+      rowStep.vtX = invTr->mat[0][1];
+      rowStep.vtY = invTr->mat[1][1];
+      rowStep.vtZ = invTr->mat[2][1];
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idB,
+    		nBand;
+
+    nBand = (height + WLZ_SECTION_TILE_BAND - 1) / WLZ_SECTION_TILE_BAND;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idB = 0; idB < nBand; ++idB)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	ln0,
+		ln1;
+	size_t	off;
+	WlzGreyP bandP;
+	WlzErrorNum errNum2;
+
+	ln0 = idB * WLZ_SECTION_TILE_BAND;
+	ln1 = WLZ_MIN(ln0 + WLZ_SECTION_TILE_BAND, height) - 1;
+	off = (size_t )ln0 * width;
+	switch(gType)
+	{
+	  case WLZ_GREY_INT:
+	    bandP.inp = dst.inp + off;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    bandP.shp = dst.shp + off;
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    bandP.ubp = dst.ubp + off;
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    bandP.flp = dst.flp + off;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    bandP.dbp = dst.dbp + off;
+	    break;
+	  case WLZ_GREY_RGBA:
+	    bandP.rgbp = dst.rgbp + off;
+	    break;
+	  default:
+	    bandP.v = NULL;
+	    break;
+	}
+	errNum2 = WlzGetSectionTileBand(gVWSp, interp, gType, bandP, width,
+				        tile.yMin + ln0, tile.yMin + ln1,
+					scale, colPos, rowStep);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzGetSectionTileFromObject)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+  }
+  AlcFree(colPos[0]);
+  if(invTr)
+  {
+    (void )WlzFreeAffineTransform(invTr);
+  }
+  if(newGVWSp)
+  {
+    WlzGreyValueFreeWSp(newGVWSp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Samples a band of consecutive lines of a section tile for
+* 		WlzGetSectionTileFromObject(), using grey value cursors
+* 		which are private to the band. Each line is sampled in
+* 		blocks of columns: for nearest neighbour interpolation
+* 		a single cursor is used while for linear interpolation
+* 		each of four cursors gathers the pairs of column
+* 		neighbours on one of the four neighbouring object lines.
+* \param	gVWSp			Shared grey value work space.
+* \param	interp			Interpolation type.
+* \param	gType			Grey type of the object values,
+* 					RGBA only with nearest neighbour
+* 					interpolation.
+* \param	dst			Destination for the values of the
+* 					first line of the band.
+* \param	width			Number of values per tile line.
+* \param	ln0			First (scaled section) line of the
+* 					band.
+* \param	ln1			Last (scaled section) line of the
+* 					band.
+* \param	scale			Scale of the tile.
+* \param	colPos			Object coordinates (x, y and z
+* 					arrays) of the tile columns on the
+* 					section's line zero.
+* \param	rowStep			Object coordinate increment for
+* 					each (unscaled) section line.
+*/
+static WlzErrorNum WlzGetSectionTileBand(
+  WlzGreyValueWSpace	*gVWSp,
+  WlzInterpolationType	interp,
+  WlzGreyType		gType,
+  WlzGreyP		dst,
+  int			width,
+  int			ln0,
+  int			ln1,
+  double		scale,
+  double		**colPos,
+  WlzDVertex3		rowStep)
+{
+  int			idC,
+  			ln,
+			nCur;
+  size_t		off = 0;
+  WlzGreyValueCursor	*gVCur[4] = {NULL};
+  WlzIVertex3		pos[4][WLZ_SECTION_TILE_BLKSZ];
+  double		frc[3][WLZ_SECTION_TILE_BLKSZ],
+  			val[8][WLZ_SECTION_TILE_BLKSZ];
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  nCur = (interp == WLZ_INTERPOLATION_NEAREST)? 1: 4;
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < nCur); ++idC)
+  {
+    gVCur[idC] = WlzGreyValueMakeCursor(gVWSp, &errNum);
+  }
+  for(ln = ln0; (errNum == WLZ_ERR_NONE) && (ln <= ln1); ++ln)
+  {
+    int		kl0,
+    		nB;
+    double	y;
+    WlzDVertex3	rowPos;
+
+    y = ln / scale;
+    rowPos.vtX = rowStep.vtX * y;
+    rowPos.vtY = rowStep.vtY * y;
+    rowPos.vtZ = rowStep.vtZ * y;
+    for(kl0 = 0; kl0 < width; kl0 += nB)
+    {
+      int	idB;
+
+      nB = WLZ_MIN(width - kl0, WLZ_SECTION_TILE_BLKSZ);
+      if(interp == WLZ_INTERPOLATION_NEAREST)
+      {
+	for(idB = 0; idB < nB; ++idB)
+	{
+	  int	kl;
+
+	  kl = kl0 + idB;
+	  pos[0][idB].vtX = WLZ_NINT(colPos[0][kl] + rowPos.vtX);
+	  pos[0][idB].vtY = WLZ_NINT(colPos[1][kl] + rowPos.vtY);
+	  pos[0][idB].vtZ = WLZ_NINT(colPos[2][kl] + rowPos.vtZ);
+	}
+	WlzGreyValueCursorGetRunsI(gVCur[0], nB, 1, 0, pos[0], val[0]);
+	WlzGetSectionTileSet(dst, off, gType, val[0], nB);
+      }
+      else
+      {
+	for(idB = 0; idB < nB; ++idB)
+	{
+	  int	kl;
+	  WlzDVertex3 p;
+	  WlzIVertex3 p0;
+
+	  kl = kl0 + idB;
+	  p.vtX = colPos[0][kl] + rowPos.vtX;
+	  p.vtY = colPos[1][kl] + rowPos.vtY;
+	  p.vtZ = colPos[2][kl] + rowPos.vtZ;
+	  p0.vtX = (int )floor(p.vtX);
+	  p0.vtY = (int )floor(p.vtY);
+	  p0.vtZ = (int )floor(p.vtZ);
+	  frc[0][idB] = p.vtX - p0.vtX;
+	  frc[1][idB] = p.vtY - p0.vtY;
+	  frc[2][idB] = p.vtZ - p0.vtZ;
+	  for(idC = 0; idC < 4; ++idC)
+	  {
+	    pos[idC][idB].vtX = p0.vtX;
+	    pos[idC][idB].vtY = p0.vtY + (idC & 1);
+	    pos[idC][idB].vtZ = p0.vtZ + (idC >> 1);
+	  }
+	}
+	for(idC = 0; idC < 4; ++idC)
+	{
+	  WlzGreyValueCursorGetRunsI(gVCur[idC], nB, 2,
+	  			     WLZ_SECTION_TILE_BLKSZ, pos[idC],
+				     val[2 * idC]);
+	}
+	for(idB = 0; idB < nB; ++idB)
+	{
+	  double c00,
+	  	 c10,
+		 c01,
+		 c11;
+
+	  c00 = val[0][idB] + frc[0][idB] * (val[1][idB] - val[0][idB]);
+	  c10 = val[2][idB] + frc[0][idB] * (val[3][idB] - val[2][idB]);
+	  c01 = val[4][idB] + frc[0][idB] * (val[5][idB] - val[4][idB]);
+	  c11 = val[6][idB] + frc[0][idB] * (val[7][idB] - val[6][idB]);
+	  c00 += frc[1][idB] * (c10 - c00);
+	  c01 += frc[1][idB] * (c11 - c01);
+	  val[0][idB] = c00 + frc[2][idB] * (c01 - c00);
+	}
+	WlzGetSectionTileSet(dst, off, gType, val[0], nB);
+      }
+      off += nB;
+    }
+  }
+  for(idC = 0; idC < nCur; ++idC)
+  {
+    WlzGreyValueFreeCursor(gVCur[idC]);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Sets section tile values of the given grey type from the
+*		given doubles, clamping and rounding them to the range of
+*		the grey type. RGBA values are only copied, since they
+*		are not interpolated.
+* \param	dst			Destination for the tile values.
+* \param	off			Offset of the first value set.
+* \param	gType			Grey type.
+* \param	val			Given values.
+* \param	n			Number of values.
+*/
+static void	WlzGetSectionTileSet(WlzGreyP dst, size_t off,
+				     WlzGreyType gType, double *val, int n)
+{
+  int		idx;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	v;
+
+	v = WLZ_CLAMP(val[idx], (double )(INT_MIN), (double )(INT_MAX));
+	dst.inp[off + idx] = WLZ_NINT(v);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	v;
+
+	v = WLZ_CLAMP(val[idx], (double )(SHRT_MIN), (double )(SHRT_MAX));
+	dst.shp[off + idx] = (short )WLZ_NINT(v);
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	v;
+
+	v = WLZ_CLAMP(val[idx], 0.0, 255.0);
+	dst.ubp[off + idx] = (WlzUByte )WLZ_NINT(v);
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	dst.flp[off + idx] = (float )WLZ_CLAMP(val[idx], -FLT_MAX, FLT_MAX);
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(idx = 0; idx < n; ++idx)
+      {
+	dst.dbp[off + idx] = val[idx];
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      for(idx = 0; idx < n; ++idx)
+      {
+	dst.rgbp[off + idx] = (WlzUInt )(val[idx]);
+      }
+      break;
+    default:
+      break;
+  }
+}
@@ -49,12 +49,48 @@ static char _WlzAffineTransform_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <string.h>
 
+#include <math.h>
+
 #include <Wlz.h>
 
+#ifndef WLZ_FAST_CODE
+#define WLZ_FAST_CODE
+#endif
+
+#if defined WLZ_FAST_CODE && (defined __AVX2__ || defined __SSE2__)
+#include <immintrin.h>
+#endif
+
 #ifdef _OPENMP
 #define WLZ_VALUE_OMP_CHUNKSZ 1024    /* To avoid parallelising small loops. */
 #endif
 
+/* Number of values sampled together when transforming 3D values. */
+#define WLZ_AFFINE_SAMPLE_BLKSZ	(64)
+
+/* Largest integer not greater than X (a double), avoiding floor(). */
+#define WLZ_AFFINE_FLOOR(X)	(((X) < (int )(X))? (int )(X) - 1: (int )(X))
+
+/*!
+* \struct	_WlzAffineSampleWSp
+* \ingroup	WlzTransform
+* \brief	Per thread work space used to sample the values of
+*		a 3D object in blocks along an interval of the
+*		transformed object.
+*/
+typedef struct _WlzAffineSampleWSp
+{
+  WlzGreyValueCursor *gVCur[4];		/*!< Cursors, one for each line
+  					     of neighbours. */
+  WlzIVertex3	pos[4][WLZ_AFFINE_SAMPLE_BLKSZ]; /*!< Positions of the
+  					     first neighbour on each
+					     line. */
+  double	val[8][WLZ_AFFINE_SAMPLE_BLKSZ]; /*!< Neighbour values. */
+  double	rgb[8][WLZ_AFFINE_SAMPLE_BLKSZ]; /*!< Neighbour RGBA values. */
+  double	frc[3][WLZ_AFFINE_SAMPLE_BLKSZ]; /*!< Fractional positions. */
+  double	res[WLZ_AFFINE_SAMPLE_BLKSZ];	/*!< Interpolated values. */
+} WlzAffineSampleWSp;
+
 static int			WlzAffineTransformIsTranslate2(
 				  WlzAffineTransform *trans,
 				  WlzObject *obj,
@@ -102,6 +138,34 @@ static WlzErrorNum 		WlzAffineTransformValues3(WlzObject *newObj,
 				  WlzInterpolationType interp,
 				  void *cbData,
 				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum		WlzAffineTransformValues3Pln(
+				  WlzObject *newObj,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzAffineTransform *invTrans,
+				  int idZ,
+				  int pln,
+				  WlzGreyType gType,
+				  WlzPixelV bkdV,
+				  WlzInterpolationType interp,
+				  void *cbData,
+				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum		WlzAffineTransformSampleItv3(
+				  WlzAffineSampleWSp *sWSp,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  WlzInterpolationType interp,
+				  int kol0,
+				  int count,
+				  WlzDVertex3 org,
+				  WlzDVertex3 step);
+static void			WlzAffineTransformLinear3(
+				  WlzAffineSampleWSp *sWSp,
+				  int n);
+static void			WlzAffineTransformSampleSet(
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  double *val,
+				  int n);
 static WlzErrorNum 		WlzAffineTransformPrimSet2(
 				  WlzAffineTransform *tr,
 				  WlzAffineTransformPrim prim);
@@ -1572,31 +1636,17 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
 					     void *cbData,
 					     WlzAffineTransformCbFn cbFn)
 {
-  int		tI0,
-  		count;
-  double	tD0, x, y, z;
-  WlzIVertex3	idx,
-  		sPos,
-		dPos;
-  WlzDVertex3	tDV0,
-  		tDV1;
+  int		idZ,
+  		nPln = 0;
   WlzIBox3	bBox;
   WlzPixelV	bkdV;
-  WlzValues	tVal,
-  		dstValues,
-  		emptyValues;
-  WlzObject 	*tObj0;
-  WlzGreyWSpace	gWSp;
-  WlzIntervalWSpace iWSp;
+  WlzValues	dstValues;
   WlzGreyValueWSpace *gVWSp = NULL;
   WlzAffineTransform *invTrans = NULL;
-  WlzGreyType	gType;
-  WlzDomain	dom2D;
-  double	tMat[3][3];
-  WlzErrorNum	errNum = WLZ_ERR_UNIMPLEMENTED;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstValues.core = NULL;
-  emptyValues.core = NULL;
   /* Make a new voxel value table. */
   bkdV = WlzGetBackground(srcObj, &errNum);
   if(errNum == WLZ_ERR_NONE)
@@ -1623,341 +1673,547 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
     invTrans = WlzAffineTransformInverse(trans, &errNum);
   }
   /* For each plane in the new object make a new value table and
-   * then fill it in. */
+   * then fill it in. The grey value work space is shared by the
+   * threads, each of which samples it through its own cursors, but
+   * a callback is given the work space itself so the planes are then
+   * done sequentially. */
   if(errNum == WLZ_ERR_NONE)
   {
     gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    idx.vtZ = 0;
-    dPos.vtZ = bBox.zMin;
-    tMat[0][0] = invTrans->mat[0][0];
-    tMat[1][0] = invTrans->mat[1][0];
-    tMat[2][0] = invTrans->mat[2][0];
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ <= bBox.zMax))
+    nPln = bBox.zMax - bBox.zMin + 1;
+  }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) \
+		     if(interp != WLZ_INTERPOLATION_CALLBACK)
+#endif
+  for(idZ = 0; idZ < nPln; ++idZ)
+  {
+    if(errNum == WLZ_ERR_NONE)
     {
-      if(((dom2D = *(newObj->domain.p->domains + idx.vtZ)).core != NULL) &&
-         (dom2D.core->type != WLZ_EMPTY_DOMAIN))
+      WlzErrorNum errNum2;
+
+      errNum2 = WlzAffineTransformValues3Pln(newObj, gVWSp, invTrans,
+      					     idZ, bBox.zMin + idZ, gType,
+					     bkdV, interp, cbData, cbFn);
+      if(errNum2 != WLZ_ERR_NONE)
       {
-	tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
-	tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
-	tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
-	/* Make a 2D domain object for the plane. */
-	tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	    *(newObj->domain.p->domains + idx.vtZ),
-	    emptyValues, NULL, NULL, &errNum);
-	if(errNum == WLZ_ERR_NONE)
+#ifdef _OPENMP
+#pragma omp critical (WlzAffineTransformValues3)
 	{
-	  tVal.v = WlzNewValueTb(tObj0,
-	  		         WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
-				 		       gType, NULL),
-				 bkdV, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
 	}
-	if(errNum == WLZ_ERR_NONE)
+#else
+	errNum = errNum2;
+#endif
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(invTrans)
+  {
+    (void )WlzFreeAffineTransform(invTrans);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Creates a new 2D value table for a single plane of the
+*		given partially transformed 3D object and fills in its
+*		values by sampling the source object through the given
+*		grey value work space.
+*		Each interval of the plane is sampled using
+*		WlzAffineTransformSampleItv3() unless a callback
+*		function is being used.
+* \param	newObj			Partialy transformed object
+*					with a valid domain and voxel
+*					value table.
+* \param	gVWSp			Grey value work space for the
+* 					source object, which is only
+* 					read (through cursors) unless
+* 					a callback function is used.
+* \param	invTrans		Inverse of the transform.
+* \param	idZ			Index of the plane in the new
+* 					object.
+* \param	pln			Plane coordinate.
+* \param	gType			Grey type of the values.
+* \param	bkdV			Background value.
+* \param	interp			Level of interpolation to
+*					use.
+* \param	cbData			Data passed to the directly to
+* 					the callback function.
+* \param	cbFn			Callback function.
+*/
+static WlzErrorNum WlzAffineTransformValues3Pln(WlzObject *newObj,
+					WlzGreyValueWSpace *gVWSp,
+					WlzAffineTransform *invTrans,
+					int idZ, int pln,
+					WlzGreyType gType, WlzPixelV bkdV,
+					WlzInterpolationType interp,
+					void *cbData,
+					WlzAffineTransformCbFn cbFn)
+{
+  int		idC;
+  WlzDVertex3	org,
+  		pOrg,
+  		step;
+  WlzValues	tVal,
+  		emptyValues;
+  WlzDomain	dom2D;
+  WlzObject 	*tObj0 = NULL;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzAffineSampleWSp *sWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  emptyValues.core = NULL;
+  dom2D = *(newObj->domain.p->domains + idZ);
+  if((dom2D.core == NULL) || (dom2D.core->type == WLZ_EMPTY_DOMAIN))
+  {
+    return(WLZ_ERR_NONE);
+  }
+  /* Make a 2D domain object for the plane. */
+  tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2D, emptyValues,
+  		      NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal.v = WlzNewValueTb(tObj0,
+			   WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
+						 gType, NULL),
+			   bkdV, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tObj0->values = WlzAssignValues(tVal, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (interp != WLZ_INTERPOLATION_CALLBACK))
+  {
+    if((sWSp = (WlzAffineSampleWSp *)
+               AlcCalloc(1, sizeof(WlzAffineSampleWSp))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < 4); ++idC)
+    {
+      sWSp->gVCur[idC] = WlzGreyValueMakeCursor(gVWSp, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Source position of the plane origin and the increment in
+     * source position for each column. */
+    pOrg.vtX = invTrans->mat[0][3] + (invTrans->mat[0][2] * pln);
+    pOrg.vtY = invTrans->mat[1][3] + (invTrans->mat[1][2] * pln);
+    pOrg.vtZ = invTrans->mat[2][3] + (invTrans->mat[2][2] * pln);
+    step.vtX = invTrans->mat[0][0];
+    step.vtY = invTrans->mat[1][0];
+    step.vtZ = invTrans->mat[2][0];
+    /* Fill in the values of the new 2D object. */
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      switch(interp)
+      {
+	case WLZ_INTERPOLATION_NEAREST: /* FALLTHROUGH */
+	case WLZ_INTERPOLATION_LINEAR:
+	  org.vtX = pOrg.vtX + (invTrans->mat[0][1] * iWSp.linpos);
+	  org.vtY = pOrg.vtY + (invTrans->mat[1][1] * iWSp.linpos);
+	  org.vtZ = pOrg.vtZ + (invTrans->mat[2][1] * iWSp.linpos);
+	  errNum = WlzAffineTransformSampleItv3(sWSp, gWSp.u_grintptr,
+	  				gWSp.pixeltype, interp,
+					iWSp.lftpos,
+					iWSp.rgtpos - iWSp.lftpos + 1,
+					org, step);
+	  break;
+	case WLZ_INTERPOLATION_CALLBACK:
+	  errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
+			   pln, iWSp.linpos);
+	  break;
+	default:
+	  errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	  break;
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *(newObj->values.vox->values + idZ) =
+      WlzAssignValues(tObj0->values, NULL);
+  }
+  if(sWSp)
+  {
+    for(idC = 0; idC < 4; ++idC)
+    {
+      WlzGreyValueFreeCursor(sWSp->gVCur[idC]);
+    }
+    AlcFree(sWSp);
+  }
+  (void )WlzFreeObj(tObj0);
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Samples the source values for an interval of a
+*		transformed 3D object. The source position of each
+*		column is the line's origin plus the column times the
+*		column step (rather than being accumulated, so that
+*		positions which should be integral do not drift), and
+*		the positions are processed in blocks of WLZ_AFFINE_SAMPLE_BLKSZ: the voxel values are
+*		first gathered into contiguous arrays (one per
+*		neighbour) by grey value cursors and then interpolated
+*		by WlzAffineTransformLinear3() before being stored with
+*		the destination grey type.
+*		Nearest neighbour positions are truncated (as the
+*		source positions are always rounded down).
+* \param	sWSp			Sampling work space with cursors.
+* \param	gP			Destination for the interval's
+* 					values.
+* \param	gType			Grey type of the values.
+* \param	interp			Either WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	kol0			First column of the interval.
+* \param	count			Number of values in the interval.
+* \param	org			Source position of column zero
+* 					on the interval's line.
+* \param	step			Source position increment for each
+* 					column.
+*/
+static WlzErrorNum WlzAffineTransformSampleItv3(WlzAffineSampleWSp *sWSp,
+					WlzGreyP gP, WlzGreyType gType,
+					WlzInterpolationType interp,
+					int kol0, int count,
+					WlzDVertex3 org, WlzDVertex3 step)
+{
+  int		idB,
+  		idC,
+		nB;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:    /* FALLTHROUGH */
+    case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+    case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+    case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+    case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+    case WLZ_GREY_RGBA:
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  while((errNum == WLZ_ERR_NONE) && (count > 0))
+  {
+    nB = WLZ_MIN(count, WLZ_AFFINE_SAMPLE_BLKSZ);
+    if(interp == WLZ_INTERPOLATION_NEAREST)
+    {
+      for(idB = 0; idB < nB; ++idB)
+      {
+	double	k;
+
+	k = kol0 + idB;
+	sWSp->pos[0][idB].vtX = (int )(org.vtX + (step.vtX * k));
+	sWSp->pos[0][idB].vtY = (int )(org.vtY + (step.vtY * k));
+	sWSp->pos[0][idB].vtZ = (int )(org.vtZ + (step.vtZ * k));
+      }
+      WlzGreyValueCursorGetRunsI(sWSp->gVCur[0], nB, 1, 0, sWSp->pos[0],
+      			         sWSp->res);
+      if(gType == WLZ_GREY_RGBA)
+      {
+        for(idB = 0; idB < nB; ++idB)
 	{
-	  tObj0->values = WlzAssignValues(tVal, &errNum);
+	  gP.rgbp[idB] = (WlzUInt )(sWSp->res[idB]);
 	}
-	if(errNum == WLZ_ERR_NONE)
+      }
+      else
+      {
+        WlzAffineTransformSampleSet(gP, gType, sWSp->res, nB);
+      }
+    }
+    else
+    {
+      /* Neighbours are ordered by column, then line then plane
+       * as for WlzGreyValueGetCon(). Each of the four cursors gathers
+       * the pairs of column neighbours on one of the four lines. */
+      for(idB = 0; idB < nB; ++idB)
+      {
+	double	k;
+	WlzDVertex3 pos;
+	WlzIVertex3 p0;
+
+	k = kol0 + idB;
+	pos.vtX = org.vtX + (step.vtX * k);
+	pos.vtY = org.vtY + (step.vtY * k);
+	pos.vtZ = org.vtZ + (step.vtZ * k);
+	p0.vtX = WLZ_AFFINE_FLOOR(pos.vtX);
+	p0.vtY = WLZ_AFFINE_FLOOR(pos.vtY);
+	p0.vtZ = WLZ_AFFINE_FLOOR(pos.vtZ);
+	sWSp->frc[0][idB] = pos.vtX - p0.vtX;
+	sWSp->frc[1][idB] = pos.vtY - p0.vtY;
+	sWSp->frc[2][idB] = pos.vtZ - p0.vtZ;
+	for(idC = 0; idC < 4; ++idC)
 	{
-	  errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+	  sWSp->pos[idC][idB].vtX = p0.vtX;
+	  sWSp->pos[idC][idB].vtY = p0.vtY + (idC & 1);
+	  sWSp->pos[idC][idB].vtZ = p0.vtZ + (idC >> 1);
 	}
-	if(errNum == WLZ_ERR_NONE)
+      }
+      if(gType == WLZ_GREY_RGBA)
+      {
+	int	idS;
+
+	for(idC = 0; idC < 4; ++idC)
 	{
-	  /* Fill in the values of the new 2D object. */
-	  while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
-	  {
-	    dPos.vtX = iWSp.lftpos;
-	    dPos.vtY = iWSp.linpos;
-	    tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
-	    tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
-	    tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
-	    count = iWSp.rgtpos - iWSp.lftpos + 1;
-	    switch(interp)
-	    {
-	      case WLZ_INTERPOLATION_NEAREST:
-		while(count-- > 0)
-		{
-		  sPos.vtX = (int )(tMat[0][1] +
-				    (tMat[0][0] * (double )(dPos.vtX)));
-		  sPos.vtY = (int )(tMat[1][1] +
-				    (tMat[1][0] * (double )(dPos.vtX)));
-		  sPos.vtZ = (int )(tMat[2][1] +
-				    (tMat[2][0] * (double )(dPos.vtX)));
-		  WlzGreyValueGet(gVWSp, (double )(sPos.vtZ),
-				  (double )(sPos.vtY), (double )(sPos.vtX));
-		  switch(gWSp.pixeltype)
-		  {
-		    case WLZ_GREY_INT:
-		      *(gWSp.u_grintptr.inp)++ = (*(gVWSp->gVal)).inv;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      *(gWSp.u_grintptr.shp)++ = (*(gVWSp->gVal)).shv;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      *(gWSp.u_grintptr.ubp)++ = (*(gVWSp->gVal)).ubv;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      *(gWSp.u_grintptr.flp)++ = (*(gVWSp->gVal)).flv;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      *(gWSp.u_grintptr.dbp)++ = (*(gVWSp->gVal)).dbv;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      *(gWSp.u_grintptr.rgbp)++ = (*(gVWSp->gVal)).rgbv;
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_LINEAR:
-		while(count-- > 0)
-		{
-		  x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
-		  y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
-		  z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
-		  WlzGreyValueGetCon(gVWSp, z, y, x);
-		  tDV0.vtX = x - WLZ_NINT(x - 0.5);
-		  tDV0.vtY = y - WLZ_NINT(y - 0.5);
-		  tDV0.vtZ = z - WLZ_NINT(z - 0.5);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  switch(gWSp.pixeltype)
-		  {
-		    case WLZ_GREY_INT:
-		      tD0 = ((gVWSp->gVal[0]).inv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).inv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(INT_MIN), (double )(INT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.inp)++ = tI0;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      tD0 = ((gVWSp->gVal[0]).shv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).shv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(SHRT_MIN),
-				      (double )(SHRT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.shp)++ = (short )tI0;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      tD0 = ((gVWSp->gVal[0]).ubv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).ubv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.ubp)++ = (WlzUByte )tI0;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      tD0 = ((gVWSp->gVal[0]).flv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).flv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		      *(gWSp.u_grintptr.flp)++ = (float )tD0;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      tD0 = ((gVWSp->gVal[0]).dbv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).dbv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      *(gWSp.u_grintptr.dbp)++ = tD0;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      tD0 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_RED_SET(*(gWSp.u_grintptr.rgbp),
-		                       (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_GREEN_SET(*(gWSp.u_grintptr.rgbp),
-		                         (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_BLUE_SET(*(gWSp.u_grintptr.rgbp),
-		                        (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_ALPHA_SET(*(gWSp.u_grintptr.rgbp), (WlzUByte )tI0);
-		      ++(gWSp.u_grintptr.rgbp);
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_CALLBACK:
-		errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
-				 dPos.vtZ, dPos.vtY);
-		break;
-	      default:
-		errNum = WLZ_ERR_INTERPOLATION_TYPE;
-		break;
-	    }
-	  }
-          (void )WlzEndGreyScan(&iWSp, &gWSp);
+	  WlzGreyValueCursorGetRunsI(sWSp->gVCur[idC], nB, 2,
+	  			     WLZ_AFFINE_SAMPLE_BLKSZ, sWSp->pos[idC],
+				     sWSp->rgb[2 * idC]);
 	}
-	if(errNum == WLZ_ERR_EOO)
+	for(idB = 0; idB < nB; ++idB)
 	{
-	  errNum = WLZ_ERR_NONE;
+	  gP.rgbp[idB] = 0;
 	}
-	if(errNum == WLZ_ERR_NONE)
+	/* Interpolate each of the red, green, blue and alpha
+	 * components in turn. */
+	for(idS = 0; idS < 32; idS += 8)
 	{
-	  *(newObj->values.vox->values + idx.vtZ) =
-	    WlzAssignValues(tObj0->values, NULL);
+	  for(idC = 0; idC < 8; ++idC)
+	  {
+	    for(idB = 0; idB < nB; ++idB)
+	    {
+	      sWSp->val[idC][idB] = ((WlzUInt )(sWSp->rgb[idC][idB]) >> idS) &
+	      			    0xff;
+	    }
+	  }
+	  WlzAffineTransformLinear3(sWSp, nB);
+	  for(idB = 0; idB < nB; ++idB)
+	  {
+	    double	v;
+
+	    v = WLZ_CLAMP(sWSp->res[idB], 0.0, 255.0);
+	    gP.rgbp[idB] |= (WlzUInt )WLZ_NINT(v) << idS;
+	  }
 	}
-	if(tObj0)
+      }
+      else
+      {
+	for(idC = 0; idC < 4; ++idC)
 	{
-	  (void )WlzFreeObj(tObj0);
+	  WlzGreyValueCursorGetRunsI(sWSp->gVCur[idC], nB, 2,
+	  			     WLZ_AFFINE_SAMPLE_BLKSZ, sWSp->pos[idC],
+				     sWSp->val[2 * idC]);
 	}
+	WlzAffineTransformLinear3(sWSp, nB);
+	WlzAffineTransformSampleSet(gP, gType, sWSp->res, nB);
       }
-      ++(idx.vtZ);
-      ++(dPos.vtZ);
     }
+    switch(gType)
+    {
+      case WLZ_GREY_INT:
+        gP.inp += nB;
+	break;
+      case WLZ_GREY_SHORT:
+        gP.shp += nB;
+	break;
+      case WLZ_GREY_UBYTE:
+        gP.ubp += nB;
+	break;
+      case WLZ_GREY_FLOAT:
+        gP.flp += nB;
+	break;
+      case WLZ_GREY_DOUBLE:
+        gP.dbp += nB;
+	break;
+      case WLZ_GREY_RGBA:
+        gP.rgbp += nB;
+	break;
+      default:
+	break;
+    }
+    kol0 += nB;
+    count -= nB;
   }
-  WlzGreyValueFreeWSp(gVWSp);
-  if(invTrans)
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Trilinear interpolation of the gathered neighbour
+*		values in the given sampling work space, using AVX2 or
+*		SSE2 when available.
+* \param	sWSp			Sampling work space with the
+* 					neighbour values and fractional
+* 					positions set.
+* \param	n			Number of values to interpolate.
+*/
+static void	WlzAffineTransformLinear3(WlzAffineSampleWSp *sWSp, int n)
+{
+  int		idx = 0;
+  double	*v0, *v1, *v2, *v3, *v4, *v5, *v6, *v7,
+  		*fx, *fy, *fz,
+		*r;
+
+  v0 = sWSp->val[0]; v1 = sWSp->val[1]; v2 = sWSp->val[2];
+  v3 = sWSp->val[3]; v4 = sWSp->val[4]; v5 = sWSp->val[5];
+  v6 = sWSp->val[6]; v7 = sWSp->val[7];
+  fx = sWSp->frc[0]; fy = sWSp->frc[1]; fz = sWSp->frc[2];
+  r = sWSp->res;
+#if defined WLZ_FAST_CODE && defined __AVX2__
+  for(; idx + 4 <= n; idx += 4)
+  {
+    __m256d	x,
+		y,
+		z,
+		c00,
+		c10,
+		c01,
+		c11;
+
+    x = _mm256_loadu_pd(fx + idx);
+    y = _mm256_loadu_pd(fy + idx);
+    z = _mm256_loadu_pd(fz + idx);
+    c00 = _mm256_loadu_pd(v0 + idx);
+    c10 = _mm256_loadu_pd(v2 + idx);
+    c01 = _mm256_loadu_pd(v4 + idx);
+    c11 = _mm256_loadu_pd(v6 + idx);
+    c00 = _mm256_add_pd(c00, _mm256_mul_pd(x,
+    	  _mm256_sub_pd(_mm256_loadu_pd(v1 + idx), c00)));
+    c10 = _mm256_add_pd(c10, _mm256_mul_pd(x,
+    	  _mm256_sub_pd(_mm256_loadu_pd(v3 + idx), c10)));
+    c01 = _mm256_add_pd(c01, _mm256_mul_pd(x,
+    	  _mm256_sub_pd(_mm256_loadu_pd(v5 + idx), c01)));
+    c11 = _mm256_add_pd(c11, _mm256_mul_pd(x,
+    	  _mm256_sub_pd(_mm256_loadu_pd(v7 + idx), c11)));
+    c00 = _mm256_add_pd(c00, _mm256_mul_pd(y, _mm256_sub_pd(c10, c00)));
+    c01 = _mm256_add_pd(c01, _mm256_mul_pd(y, _mm256_sub_pd(c11, c01)));
+    c00 = _mm256_add_pd(c00, _mm256_mul_pd(z, _mm256_sub_pd(c01, c00)));
+    _mm256_storeu_pd(r + idx, c00);
+  }
+#elif defined WLZ_FAST_CODE && defined __SSE2__
+  for(; idx + 2 <= n; idx += 2)
+  {
+    __m128d	x,
+		y,
+		z,
+		c00,
+		c10,
+		c01,
+		c11;
+
+    x = _mm_loadu_pd(fx + idx);
+    y = _mm_loadu_pd(fy + idx);
+    z = _mm_loadu_pd(fz + idx);
+    c00 = _mm_loadu_pd(v0 + idx);
+    c10 = _mm_loadu_pd(v2 + idx);
+    c01 = _mm_loadu_pd(v4 + idx);
+    c11 = _mm_loadu_pd(v6 + idx);
+    c00 = _mm_add_pd(c00, _mm_mul_pd(x, _mm_sub_pd(_mm_loadu_pd(v1 + idx),
+    						   c00)));
+    c10 = _mm_add_pd(c10, _mm_mul_pd(x, _mm_sub_pd(_mm_loadu_pd(v3 + idx),
+    						   c10)));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(x, _mm_sub_pd(_mm_loadu_pd(v5 + idx),
+    						   c01)));
+    c11 = _mm_add_pd(c11, _mm_mul_pd(x, _mm_sub_pd(_mm_loadu_pd(v7 + idx),
+    						   c11)));
+    c00 = _mm_add_pd(c00, _mm_mul_pd(y, _mm_sub_pd(c10, c00)));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(y, _mm_sub_pd(c11, c01)));
+    c00 = _mm_add_pd(c00, _mm_mul_pd(z, _mm_sub_pd(c01, c00)));
+    _mm_storeu_pd(r + idx, c00);
+  }
+#endif
+  for(; idx < n; ++idx)
   {
-    (void )WlzFreeAffineTransform(invTrans);
+    double	c00,
+    		c10,
+		c01,
+		c11;
+
+    c00 = v0[idx] + fx[idx] * (v1[idx] - v0[idx]);
+    c10 = v2[idx] + fx[idx] * (v3[idx] - v2[idx]);
+    c01 = v4[idx] + fx[idx] * (v5[idx] - v4[idx]);
+    c11 = v6[idx] + fx[idx] * (v7[idx] - v6[idx]);
+    c00 += fy[idx] * (c10 - c00);
+    c01 += fy[idx] * (c11 - c01);
+    r[idx] = c00 + fz[idx] * (c01 - c00);
+  }
+}
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Sets values of the given (non RGBA) grey type from the
+*		given doubles, clamping and rounding them to the range
+*		of the grey type.
+* \param	gP			Destination for the values.
+* \param	gType			Grey type.
+* \param	val			Given values.
+* \param	n			Number of values.
+*/
+static void	WlzAffineTransformSampleSet(WlzGreyP gP, WlzGreyType gType,
+					    double *val, int n)
+{
+  int		idx;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	v;
+
+	v = WLZ_CLAMP(val[idx], (double )(INT_MIN), (double )(INT_MAX));
+	gP.inp[idx] = WLZ_NINT(v);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	v;
+
+	v = WLZ_CLAMP(val[idx], (double )(SHRT_MIN), (double )(SHRT_MAX));
+	gP.shp[idx] = (short )WLZ_NINT(v);
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	v;
+
+	v = WLZ_CLAMP(val[idx], 0.0, 255.0);
+	gP.ubp[idx] = (WlzUByte )WLZ_NINT(v);
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	gP.flp[idx] = (float )WLZ_CLAMP(val[idx], -FLT_MAX, FLT_MAX);
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(idx = 0; idx < n; ++idx)
+      {
+	gP.dbp[idx] = val[idx];
+      }
+      break;
+    default:
+      break;
   }
-  return(errNum);
 }
 
 /*!
@@ -3282,7 +3538,13 @@ WlzObject	*WlzAffineTransformObj(WlzObject *srcObj,
 				       WlzInterpolationType interp,
 				       WlzErrorNum *dstErr)
 {
-  return(WlzAffineTransformObjCb(srcObj, trans, interp, NULL, NULL, dstErr));
+  WlzObject	*dstObj;
+  WlzPerfScope	perfScope;
+
+  WLZ_PERF_BEGIN(perfScope, "WlzAffineTransformObj");
+  dstObj = WlzAffineTransformObjCb(srcObj, trans, interp, NULL, NULL, dstErr);
+  WLZ_PERF_END(perfScope);
+  return(dstObj);
 }
 
 /*!
@@ -140,6 +140,175 @@ static WlzHistogramDomain 	*WlzBasisFnScalarMOS3DEvalTb(
 				  double delta,
 				  double tau,
 				  WlzErrorNum *dstErr);
+static void			WlzBasisFnTreeFree(
+				  WlzBasisFnTree *tree);
+static int			WlzBasisFnTreeNodeCount(
+				  int nVtx);
+static int			WlzBasisFnTreeNTerm(
+				  int dim,
+				  int order);
+static WlzErrorNum		WlzBasisFnTreeTerms(
+				  WlzBasisFnTree *tree);
+static int			WlzBasisFnTreeBuild(
+				  WlzBasisFnTree *tree,
+				  int *nxtNod,
+				  WlzDVertex3 *vtx,
+				  WlzDVertex3 *co,
+				  int *vIdx,
+				  double *key,
+				  double *pw,
+				  int first,
+				  int count);
+static double			WlzBasisFnTreePhi(
+				  WlzFnType type,
+				  double delta,
+				  double s);
+static void			WlzBasisFnTreeCoef(
+				  WlzBasisFnTree *tree,
+				  WlzFnType type,
+				  double delta,
+				  int nTerm,
+				  WlzDVertex3 uVx,
+				  double s,
+				  double *a,
+				  double *b);
+static WlzDVertex2		WlzBasisFnTreeSum2D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex2 srcVx);
+static WlzDVertex3		WlzBasisFnTreeSum3D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex3 srcVx);
+static double			WlzBasisFnCSPhi(
+				  double s,
+				  double rho);
+static double			WlzBasisFnCSRadius(
+				  int dim,
+				  int nPts,
+				  WlzDVertex3 *vtx);
+static WlzBasisFn		*WlzBasisFnCSFromCPts(
+				  int dim,
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  double rho,
+				  double alpha,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzBasisFnCSMatrix(
+				  AlgMatrix *dstM,
+				  int *rank,
+				  int nPts,
+				  WlzDVertex3 *vtx,
+				  WlzDBox3 *extentDB,
+				  double rho,
+				  double alpha);
+static void			WlzBasisFnCSPrecond(
+				  void *data,
+				  AlgMatrix aM,
+				  double *r,
+				  double *z);
+
+/*!
+* \def		WLZ_BASISFN_TREE_LEAFSZ
+* \ingroup	WlzFunction
+* \brief	Maximum number of control points in a leaf node of a
+*		basis function evaluation tree.
+*/
+#define WLZ_BASISFN_TREE_LEAFSZ		(32)
+
+/*!
+* \def		WLZ_BASISFN_TREE_THETA
+* \ingroup	WlzFunction
+* \brief	Maximum ratio of node radius to distance for which a node
+*		of a basis function evaluation tree may be approximated
+*		by a Taylor expansion.
+*/
+#define WLZ_BASISFN_TREE_THETA		(0.5)
+
+/*!
+* \def		WLZ_BASISFN_TREE_ORDER2D
+* \ingroup	WlzFunction
+* \brief	Maximum order of the Taylor expansions used by a 2D basis
+*		function evaluation tree.
+*/
+#define WLZ_BASISFN_TREE_ORDER2D	(16)
+
+/*!
+* \def		WLZ_BASISFN_TREE_ORDER3D
+* \ingroup	WlzFunction
+* \brief	Maximum order of the Taylor expansions used by a 3D basis
+*		function evaluation tree.
+*/
+#define WLZ_BASISFN_TREE_ORDER3D	(12)
+
+/*!
+* \def		WLZ_BASISFN_TREE_MAXTERM
+* \ingroup	WlzFunction
+* \brief	Number of terms in a Taylor expansion of the maximum
+*		order, this being larger for 3D than 2D.
+*/
+#define WLZ_BASISFN_TREE_MAXTERM	(((WLZ_BASISFN_TREE_ORDER3D + 1) * \
+					  (WLZ_BASISFN_TREE_ORDER3D + 2) * \
+					  (WLZ_BASISFN_TREE_ORDER3D + 3)) / 6)
+
+/*!
+* \def		WLZ_BASISFN_TREE_MAXDEPTH
+* \ingroup	WlzFunction
+* \brief	Size of the node stack used when traversing a basis
+*		function evaluation tree. Because nodes are split at
+*		their median this is far greater than the depth of any
+*		tree which can be built.
+*/
+#define WLZ_BASISFN_TREE_MAXDEPTH	(64)
+
+/*!
+* \def		WLZ_BASISFN_CS_NNBR2D
+* \ingroup	WlzFunction
+* \brief	Number of neighbouring control points which are, on
+*		average, within the support radius of a 2D compactly
+*		supported basis function when the radius is chosen
+*		automatically. This gives about the same ratio of support
+*		radius to control point spacing as WLZ_BASISFN_CS_NNBR3D,
+*		larger ratios give smoother functions but the number of
+*		conjugate gradient iterations grows rapidly with it.
+*/
+#define WLZ_BASISFN_CS_NNBR2D		(12)
+
+/*!
+* \def		WLZ_BASISFN_CS_NNBR3D
+* \ingroup	WlzFunction
+* \brief	Number of neighbouring control points which are, on
+*		average, within the support radius of a 3D compactly
+*		supported basis function when the radius is chosen
+*		automatically.
+*/
+#define WLZ_BASISFN_CS_NNBR3D		(32)
+
+/*!
+* \def		WLZ_BASISFN_CS_NSAMPLE
+* \ingroup	WlzFunction
+* \brief	Maximum number of control points sampled when choosing
+*		the support radius of a compactly supported basis function.
+*/
+#define WLZ_BASISFN_CS_NSAMPLE		(64)
+
+/*!
+* \def		WLZ_BASISFN_CS_CGTOL
+* \ingroup	WlzFunction
+* \brief	Relative residual at which the conjugate gradient solution
+*		of the compactly supported basis function design equation
+*		is accepted.
+*/
+#define WLZ_BASISFN_CS_CGTOL		(1.0e-08)
+
+/*!
+* \def		WLZ_BASISFN_CS_CGMAXITR
+* \ingroup	WlzFunction
+* \brief	Maximum number of conjugate gradient iterations used to
+*		solve the compactly supported basis function design
+*		equation.
+*/
+#define WLZ_BASISFN_CS_CGMAXITR		(10000)
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzFunction
@@ -170,11 +339,227 @@ WlzErrorNum	WlzBasisFnFree(WlzBasisFn *basisFn)
       }
       AlcFree(basisFn->distMap);
     }
+    WlzBasisFnTreeFree(basisFn->tree);
     AlcFree(basisFn);
   }
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Builds (or removes) a tree over the control points of the
+*		given radial basis function so that the basis function
+*		may be evaluated in close to O(log n) rather than O(n)
+*		time for n control points.
+*		The tree is a binary tree built by splitting the control
+*		points at their median along the longest axis, with each
+*		node holding the moments of the basis function coefficients
+*		about its centre. When a node is far from the evaluation
+*		position the sum over its control points is approximated
+*		by a Cartesian Taylor expansion of the radial function about
+*		the node centre, otherwise the node's children are visited
+*		or, for a leaf node, its control points are summed
+*		directly. The Taylor coefficients are computed using
+*		recurrence relations for the radial functions and the
+*		order of each expansion is the lowest for which the
+*		estimated error is within the node's share of the tolerance.
+*		Each node's share of the tolerance is proportional to the
+*		sum of the magnitudes of its coefficients so that the
+*		tolerance bounds (approximately) the error in the sum over
+*		all control points, e.g. a tolerance of 0.01 gives
+*		displacements accurate to about 1/100th of a pixel.
+*		Radial basis functions which closely fit many control
+*		points may have large coefficients which almost cancel,
+*		these will need high order expansions and so benefit less
+*		from the tree.
+*		Any existing tree is freed. The tree is only valid for
+*		the control points and coefficients of the basis function
+*		when it was built, so it must be rebuilt if these are
+*		changed.
+*		Trees are supported for Euclidean distance 2D Gaussian,
+*		2D and 3D multiquadric, 2D and 3D inverse multiquadric
+*		and 2D thin plate spline basis functions (there are no
+*		3D Gaussian basis functions, so WLZ_FN_BASIS_3DGAUSS is
+*		not supported). Trees are also
+*		supported for the 2D and 3D compactly supported basis
+*		functions, for which nodes beyond the support radius are
+*		skipped rather than approximated, so that evaluation is
+*		exact for any positive tolerance.
+* \param	basisFn			Given basis function.
+* \param	tol			Tolerance, the maximum absolute
+*					error in the sum over the control
+*					points. If less than or equal to
+*					zero any existing tree is removed
+*					and the basis function will be
+*					evaluated directly.
+*/
+WlzErrorNum	WlzBasisFnSetTree(WlzBasisFn *basisFn, double tol)
+{
+  int		idx,
+  		dim = 2,
+  		nxtNod = 0;
+  int		*vIdx = NULL;
+  double	*key = NULL,
+  		*pw = NULL;
+  WlzDVertex3	*vtx = NULL,
+  		*co = NULL;
+  WlzBasisFnTree *tree = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(tol > 0.0)
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:
+	if((basisFn->distFn != NULL) &&
+	   (basisFn->distFn != WlzBasisFnEucDistFn2D))
+	{
+	  errNum = WLZ_ERR_TRANSFORM_TYPE;
+	}
+        break;
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+        dim = 3;
+	if((basisFn->distFn != NULL) &&
+	   (basisFn->distFn != WlzBasisFnEucDistFn3D))
+	{
+	  errNum = WLZ_ERR_TRANSFORM_TYPE;
+	}
+        break;
+      case WLZ_FN_BASIS_2DTPS:
+	/* The thin plate spline squares any distance function's value. */
+        if(basisFn->distFn != NULL)
+	{
+	  errNum = WLZ_ERR_TRANSFORM_TYPE;
+	}
+	break;
+      case WLZ_FN_BASIS_2DCS:
+        break;
+      case WLZ_FN_BASIS_3DCS:
+        dim = 3;
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzBasisFnTreeFree(basisFn->tree);
+    basisFn->tree = NULL;
+    if((tol > 0.0) && (basisFn->nVtx > 0))
+    {
+      int	nVtx;
+
+      nVtx = basisFn->nVtx;
+      if((tree = (WlzBasisFnTree *)
+                 AlcCalloc(1, sizeof(WlzBasisFnTree))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	tree->dim = dim;
+	if((basisFn->type == WLZ_FN_BASIS_2DCS) ||
+	   (basisFn->type == WLZ_FN_BASIS_3DCS))
+	{
+	  /* Compactly supported basis functions never use expansions. */
+	  tree->order = 0;
+	}
+	else
+	{
+	  tree->order = (dim == 2)? WLZ_BASISFN_TREE_ORDER2D:
+				    WLZ_BASISFN_TREE_ORDER3D;
+	}
+	tree->nTerm = WlzBasisFnTreeNTerm(dim, tree->order);
+	tree->nVtx = nVtx;
+	tree->nNodes = WlzBasisFnTreeNodeCount(nVtx);
+	tree->tol = tol;
+	errNum = WlzBasisFnTreeTerms(tree);
+      }
+      if((errNum == WLZ_ERR_NONE) &&
+         (((tree->vertices = (WlzDVertex3 *)
+	                     AlcMalloc(sizeof(WlzDVertex3) * nVtx)) == NULL) ||
+	  ((tree->basis = (WlzDVertex3 *)
+	                  AlcMalloc(sizeof(WlzDVertex3) * nVtx)) == NULL) ||
+	  ((tree->nodes = (WlzBasisFnTreeNode *)
+	                  AlcMalloc(sizeof(WlzBasisFnTreeNode) *
+			            tree->nNodes)) == NULL) ||
+	  ((tree->moments = (WlzDVertex3 *)
+	                    AlcCalloc(tree->nNodes * tree->nTerm,
+			              sizeof(WlzDVertex3))) == NULL) ||
+	  ((vtx = (WlzDVertex3 *)
+	          AlcMalloc(sizeof(WlzDVertex3) * nVtx)) == NULL) ||
+	  ((co = (WlzDVertex3 *)
+	         AlcMalloc(sizeof(WlzDVertex3) * nVtx)) == NULL) ||
+	  ((vIdx = (int *)AlcMalloc(sizeof(int) * nVtx)) == NULL) ||
+	  ((key = (double *)AlcMalloc(sizeof(double) * nVtx)) == NULL) ||
+	  ((pw = (double *)AlcMalloc(sizeof(double) * tree->nTerm)) == NULL)))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* Work in 3D with zero z components for 2D basis functions. */
+	if(dim == 3)
+	{
+	  for(idx = 0; idx < nVtx; ++idx)
+	  {
+	    vtx[idx] = basisFn->vertices.d3[idx];
+	    co[idx] = basisFn->basis.d3[idx];
+	  }
+	}
+	else
+	{
+	  for(idx = 0; idx < nVtx; ++idx)
+	  {
+	    vtx[idx].vtX = basisFn->vertices.d2[idx].vtX;
+	    vtx[idx].vtY = basisFn->vertices.d2[idx].vtY;
+	    vtx[idx].vtZ = 0.0;
+	    co[idx].vtX = basisFn->basis.d2[idx].vtX;
+	    co[idx].vtY = basisFn->basis.d2[idx].vtY;
+	    co[idx].vtZ = 0.0;
+	  }
+	}
+	tree->wSum = 0.0;
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  vIdx[idx] = idx;
+	  tree->wSum += fabs(co[idx].vtX) + fabs(co[idx].vtY) +
+	                fabs(co[idx].vtZ);
+	}
+	(void )WlzBasisFnTreeBuild(tree, &nxtNod, vtx, co, vIdx, key, pw,
+				   0, nVtx);
+	/* Store the control points and coefficients in tree order so that
+	 * those of each node are contiguous. */
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  tree->vertices[idx] = vtx[vIdx[idx]];
+	  tree->basis[idx] = co[vIdx[idx]];
+	}
+	basisFn->tree = tree;
+      }
+      else
+      {
+        WlzBasisFnTreeFree(tree);
+      }
+    }
+  }
+  AlcFree(vtx);
+  AlcFree(co);
+  AlcFree(vIdx);
+  AlcFree(key);
+  AlcFree(pw);
+  return(errNum);
+}
+
 /*!
 * \return       New vertex value.
 * \ingroup      WlzFunction
@@ -241,23 +626,30 @@ WlzDVertex2 	WlzBasisFnValueGauss2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if(basisFn->tree != NULL)
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
+    newVx = WlzBasisFnTreeSum2D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      }
+      tD1 = (tD0 > DBL_EPSILON)? exp(tD0 * delta): 1.0;
+      newVx.vtX += basisCo->vtX * tD1;
+      newVx.vtY += basisCo->vtY * tD1;
+      ++cPts;
+      ++basisCo;
     }
-    tD1 = (tD0 > DBL_EPSILON)? exp(tD0 * delta): 1.0;
-    newVx.vtX += basisCo->vtX * tD1;
-    newVx.vtY += basisCo->vtY * tD1;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -291,23 +683,30 @@ WlzDVertex2 	WlzBasisFnValueMQ2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if(basisFn->tree != NULL)
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
+    newVx = WlzBasisFnTreeSum2D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      }
+      tD0 = sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -345,25 +744,32 @@ WlzDVertex3 	WlzBasisFnValueMQ3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
   cPts    = basisFn->vertices.d3;
   basisCo = basisFn->basis.d3;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if(basisFn->tree != NULL)
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD2 = srcVx.vtZ - cPts->vtZ;
-      tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
-    }
-    else
+    newVx = WlzBasisFnTreeSum3D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD2 = srcVx.vtZ - cPts->vtZ;
+        tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      }
+      tD0 = sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      newVx.vtZ += basisCo->vtZ * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    newVx.vtZ += basisCo->vtZ * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -398,23 +804,30 @@ WlzDVertex2 	WlzBasisFnValueIMQ2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if(basisFn->tree != NULL)
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
+    newVx = WlzBasisFnTreeSum2D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      }
+      tD0 = 1.0 / sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = 1.0 / sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -452,25 +865,32 @@ WlzDVertex3 	WlzBasisFnValueIMQ3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
   cPts    = basisFn->vertices.d3;
   basisCo = basisFn->basis.d3;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if(basisFn->tree != NULL)
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD2 = srcVx.vtZ - cPts->vtZ;
-      tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
-    }
-    else
+    newVx = WlzBasisFnTreeSum3D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD2 = srcVx.vtZ - cPts->vtZ;
+        tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      }
+      tD0 = 1.0 / sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      newVx.vtZ += basisCo->vtZ * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = 1.0 / sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    newVx.vtZ += basisCo->vtZ * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -503,27 +923,34 @@ WlzDVertex2 	WlzBasisFnValueTPS2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   newVx.vtY = 0.0;
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if(basisFn->tree != NULL)
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
-    {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
-      tD0 *= tD0;
-    }
-    if(tD0 > DBL_EPSILON)
+    newVx = WlzBasisFnTreeSum2D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 *= log(tD0);
-      newVx.vtX += basisCo->vtX * tD0;
-      newVx.vtY += basisCo->vtY * tD0;
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+        tD0 *= tD0;
+      }
+      if(tD0 > DBL_EPSILON)
+      {
+        tD0 *= log(tD0);
+        newVx.vtX += basisCo->vtX * tD0;
+        newVx.vtY += basisCo->vtY * tD0;
+      }
+      ++cPts;
+      ++basisCo;
     }
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = (newVx.vtX * 0.5) + polyVx.vtX;
@@ -570,38 +997,139 @@ WlzDVertex2 	WlzBasisFnValueConf2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
 /*!
 * \return	New vertex value.
 * \ingroup	WlzFunction
-* \brief	Calculates the value for the given vertex using
-*		a 3D multiorder basis function:
-*		\f[
-		\phi(r) = \frac{1}{4 \pi \delta^2 r}
-			  (1 -
-			   \frac{w}{w - v} e^{- \sqrt{v} r} +
-			   \frac{v}{w - v} e^{- \sqrt{w} r})
-		\f]
-		\f[
-		v = \frac{1 + \sqrt{1 - 4 \pi \tau^2 \delta^2}}{2 \tau^2}
-		\f]
-		\f[
-		w = \frac{1 - \sqrt{1 - 4 \pi \tau^2 \delta^2}}{2 \tau^2}
-		\f]
+* \brief	Calculates the displacement value for the given vertex using
+*		a 2D compactly supported basis function, see
+*		WlzBasisFnCS2DFromCPts().
 * \param	basisFn			Basis function.
 * \param	srcVx			Source vertex.
 */
-WlzDVertex3 	WlzBasisFnValueMOS3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+WlzDVertex2 	WlzBasisFnValueCS2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
 {
   int           idx;
   double        tD0,
 		tD1,
-		v,
-		w,
-		rad,
-		phi,
-		delta,
-		tau,
-		rv,
-		rw,
-		norm;
-  WlzDVertex3   *basisCo,
+		rho;
+  WlzDVertex2    *basisCo,
+		*cPts;
+  WlzDVertex2    polyVx,
+  		 newVx;
+
+  newVx.vtX = 0.0;
+  newVx.vtY = 0.0;
+  cPts    = basisFn->vertices.d2;
+  basisCo = basisFn->basis.d2;
+  rho = *((double *)(basisFn->param));
+  if(basisFn->tree != NULL)
+  {
+    newVx = WlzBasisFnTreeSum2D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
+    {
+      tD0 = srcVx.vtX - cPts->vtX;
+      tD1 = srcVx.vtY - cPts->vtY;
+      tD0 = WlzBasisFnCSPhi((tD0 * tD0) + (tD1 * tD1), rho);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      ++cPts;
+      ++basisCo;
+    }
+  }
+  polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
+  newVx.vtX = newVx.vtX + polyVx.vtX;
+  newVx.vtY = newVx.vtY + polyVx.vtY;
+  return(newVx);
+}
+
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement value for the given vertex using
+*		a 3D compactly supported basis function, see
+*		WlzBasisFnCS3DFromCPts().
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex3 	WlzBasisFnValueCS3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+{
+  int           idx;
+  double        tD0,
+		tD1,
+		tD2,
+		rho;
+  WlzDVertex3   *basisCo,
+		*cPts;
+  WlzDVertex3    polyVx,
+  		 newVx;
+
+  newVx.vtX = 0.0;
+  newVx.vtY = 0.0;
+  newVx.vtZ = 0.0;
+  cPts    = basisFn->vertices.d3;
+  basisCo = basisFn->basis.d3;
+  rho = *((double *)(basisFn->param));
+  if(basisFn->tree != NULL)
+  {
+    newVx = WlzBasisFnTreeSum3D(basisFn, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
+    {
+      tD0 = srcVx.vtX - cPts->vtX;
+      tD1 = srcVx.vtY - cPts->vtY;
+      tD2 = srcVx.vtZ - cPts->vtZ;
+      tD0 = WlzBasisFnCSPhi((tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2), rho);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      newVx.vtZ += basisCo->vtZ * tD0;
+      ++cPts;
+      ++basisCo;
+    }
+  }
+  polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
+  newVx.vtX = newVx.vtX + polyVx.vtX;
+  newVx.vtY = newVx.vtY + polyVx.vtY;
+  newVx.vtZ = newVx.vtZ + polyVx.vtZ;
+  return(newVx);
+}
+
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the value for the given vertex using
+*		a 3D multiorder basis function:
+*		\f[
+		\phi(r) = \frac{1}{4 \pi \delta^2 r}
+			  (1 -
+			   \frac{w}{w - v} e^{- \sqrt{v} r} +
+			   \frac{v}{w - v} e^{- \sqrt{w} r})
+		\f]
+		\f[
+		v = \frac{1 + \sqrt{1 - 4 \pi \tau^2 \delta^2}}{2 \tau^2}
+		\f]
+		\f[
+		w = \frac{1 - \sqrt{1 - 4 \pi \tau^2 \delta^2}}{2 \tau^2}
+		\f]
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex3 	WlzBasisFnValueMOS3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+{
+  int           idx;
+  double        tD0,
+		tD1,
+		v,
+		w,
+		rad,
+		phi,
+		delta,
+		tau,
+		rv,
+		rw,
+		norm;
+  WlzDVertex3   *basisCo,
 		*cPts;
   WlzDVertex3   dispVx,
   		polyVx,
@@ -1161,6 +1689,7 @@ WlzBasisFn *WlzBasisFnGauss2DFromCPts(int nPts, WlzDVertex2 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->tree = NULL;
 	  if(newBasisFn->distMap != NULL)
 	  {
 	    tI0 = ALG_MIN(newBasisFn->nVtx, prvBasisFn->nVtx);
@@ -1761,6 +2290,7 @@ WlzBasisFn *WlzBasisFnMQ2DFromCPts(int nPts, WlzDVertex2 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->tree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -2116,6 +2646,7 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->tree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -2522,6 +3053,7 @@ WlzBasisFn *WlzBasisFnIMQ2DFromCPts(int nPts, WlzDVertex2 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->tree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -2877,6 +3409,7 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->tree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -3266,6 +3799,7 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
           prvBasisFn->param = NULL;
           prvBasisFn->mesh.v = NULL;
           prvBasisFn->distMap = NULL;
+          newBasisFn->tree = NULL;
           if(newBasisFn->distMap != NULL)
           {
             tI0 = ALG_MIN(newBasisFn->nVtx, prvBasisFn->nVtx);
@@ -3490,6 +4024,139 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
   return(newBasisFn);
 }
 
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new 2D compactly supported basis function
+*		using Wendland's \f$C^2\f$ function
+*		\f[
+		\phi(r) = (1 - \frac{r}{\rho})_+^4 (4 \frac{r}{\rho} + 1)
+		\f]
+*		with support radius \f$\rho\f$, together with an affine
+*		polynomial. Unlike the other radial basis functions the
+*		design equation is sparse, with each control point only
+*		coupled to those within the support radius, so that
+*		basis functions may be fitted to many thousands of control
+*		points. The affine polynomial is first fitted to the
+*		displacements by least squares, after which the radial
+*		basis function coefficients are found by solving the
+*		(positive definite) sparse design equation for the
+*		residual displacements using a preconditioned conjugate
+*		gradient method.
+*		An evaluation tree is built (see WlzBasisFnSetTree())
+*		so that evaluation only visits control points within the
+*		support radius.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	rho			Support radius \f$\rho\f$, if not
+*					greater than zero a support radius
+*					is chosen so that on average each
+*					control point has about
+*					WLZ_BASISFN_CS_NNBR2D others within
+*					its support.
+* \param	alpha			Regularization parameter which is
+*					added to the diagonal of the design
+*					equation, zero for an interpolating
+*					function and greater than zero for
+*					a smoother approximating function.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFn *WlzBasisFnCS2DFromCPts(int nPts,
+				  WlzDVertex2 *dPts, WlzDVertex2 *sPts,
+				  double rho, double alpha,
+				  WlzErrorNum *dstErr)
+{
+  int		idN;
+  WlzDVertex3	*dPts3 = NULL,
+  		*sPts3 = NULL;
+  WlzBasisFn	*basisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nPts <= 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((dPts3 = (WlzDVertex3 *)
+                    AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL) ||
+          ((sPts3 = (WlzDVertex3 *)
+	            AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      dPts3[idN].vtX = dPts[idN].vtX;
+      dPts3[idN].vtY = dPts[idN].vtY;
+      dPts3[idN].vtZ = 0.0;
+      sPts3[idN].vtX = sPts[idN].vtX;
+      sPts3[idN].vtY = sPts[idN].vtY;
+      sPts3[idN].vtZ = 0.0;
+    }
+    basisFn = WlzBasisFnCSFromCPts(2, nPts, dPts3, sPts3, rho, alpha,
+                                   &errNum);
+  }
+  AlcFree(dPts3);
+  AlcFree(sPts3);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(basisFn);
+}
+
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new 3D compactly supported basis function,
+*		see WlzBasisFnCS2DFromCPts() for details.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	rho			Support radius, if not greater than
+*					zero a support radius is chosen
+*					so that on average each control
+*					point has about
+*					WLZ_BASISFN_CS_NNBR3D others within
+*					its support.
+* \param	alpha			Regularization parameter, zero for
+*					an interpolating function.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFn *WlzBasisFnCS3DFromCPts(int nPts,
+				  WlzDVertex3 *dPts, WlzDVertex3 *sPts,
+				  double rho, double alpha,
+				  WlzErrorNum *dstErr)
+{
+  WlzBasisFn	*basisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nPts <= 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    basisFn = WlzBasisFnCSFromCPts(3, nPts, dPts, sPts, rho, alpha,
+                                   &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(basisFn);
+}
+
 /*!
 * \return	New basis function.
 * \ingroup	WlzFunction
@@ -4489,3 +5156,1224 @@ static void	WlzBasisFnEditSV(int n, double *vV)
     }
   }
 }
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Free's the given basis function evaluation tree.
+* \param	tree			Given tree, may be NULL.
+*/
+static void	WlzBasisFnTreeFree(WlzBasisFnTree *tree)
+{
+  if(tree)
+  {
+    AlcFree(tree->terms);
+    AlcFree(tree->moments);
+    AlcFree(tree->vertices);
+    AlcFree(tree->basis);
+    AlcFree(tree->nodes);
+    AlcFree(tree);
+  }
+}
+
+/*!
+* \return	Number of tree nodes.
+* \ingroup	WlzFunction
+* \brief	Computes the number of nodes in a basis function evaluation
+*		tree built over the given number of control points.
+* \param	nVtx			Number of control points.
+*/
+static int	WlzBasisFnTreeNodeCount(int nVtx)
+{
+  int		nNodes = 1;
+
+  if(nVtx > WLZ_BASISFN_TREE_LEAFSZ)
+  {
+    nNodes += WlzBasisFnTreeNodeCount(nVtx / 2) +
+              WlzBasisFnTreeNodeCount(nVtx - (nVtx / 2));
+  }
+  return(nNodes);
+}
+
+/*!
+* \return	Number of terms.
+* \ingroup	WlzFunction
+* \brief	Computes the number of terms in a Taylor expansion of the
+*		given order and dimension.
+* \param	dim			Dimension, 2 or 3.
+* \param	order			Order of the expansion.
+*/
+static int	WlzBasisFnTreeNTerm(int dim, int order)
+{
+  int		nTerm;
+
+  nTerm = ((order + 1) * (order + 2)) / 2;
+  if(dim == 3)
+  {
+    nTerm = (nTerm * (order + 3)) / 3;
+  }
+  return(nTerm);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Allocates and fills in the table of Taylor expansion terms
+*		for the given tree, which must have its dimension, order
+*		and number of terms set. The terms are ordered by total
+*		degree so that the terms of an expansion of any lower order
+*		are a prefix of those for the maximum order.
+* \param	tree			Given tree.
+*/
+static WlzErrorNum WlzBasisFnTreeTerms(WlzBasisFnTree *tree)
+{
+  int		idD,
+		idJ,
+  		idT = 0,
+		nZ,
+		kX,
+		kY,
+		kZ,
+		nO;
+  int		k[3];
+  int		*map = NULL,
+  		*tP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nO = tree->order + 1;
+  nZ = (tree->dim == 3)? nO: 1;
+  if(((tree->terms = (int *)
+                     AlcMalloc(sizeof(int) * 7 * tree->nTerm)) == NULL) ||
+     ((map = (int *)AlcMalloc(sizeof(int) * nO * nO * nZ)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idD = 0; idD < nO; ++idD)
+    {
+      for(kX = idD; kX >= 0; --kX)
+      {
+	for(kY = idD - kX; kY >= 0; --kY)
+	{
+	  kZ = idD - kX - kY;
+	  if((tree->dim == 3) || (kZ == 0))
+	  {
+	    map[(((kZ * nO) + kY) * nO) + kX] = idT;
+	    tP = tree->terms + (7 * idT);
+	    tP[0] = idD;
+	    k[0] = kX;
+	    k[1] = kY;
+	    k[2] = kZ;
+	    for(idJ = 0; idJ < 3; ++idJ)
+	    {
+	      tP[1 + idJ] = tP[4 + idJ] = -1;
+	      if(k[idJ] > 0)
+	      {
+		--(k[idJ]);
+		tP[1 + idJ] = map[(((k[2] * nO) + k[1]) * nO) + k[0]];
+		if(k[idJ] > 0)
+		{
+		  --(k[idJ]);
+		  tP[4 + idJ] = map[(((k[2] * nO) + k[1]) * nO) + k[0]];
+		  ++(k[idJ]);
+		}
+		++(k[idJ]);
+	      }
+	    }
+	    ++idT;
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(map);
+  return(errNum);
+}
+
+/*!
+* \return	Index of the new node.
+* \ingroup	WlzFunction
+* \brief	Recursively builds a node of a basis function evaluation
+*		tree, computing its centre, radius and coefficient moments
+*		and then, if it has more than WLZ_BASISFN_TREE_LEAFSZ
+*		control points, splitting it at the median along its
+*		longest axis. The moments are of the coefficients weighted
+*		by powers of the offsets from the control points to the
+*		centre (rather than from the centre to the control points)
+*		as these are used in the Taylor expansions.
+* \param	tree			Tree with the nodes and moments
+*					allocated.
+* \param	nxtNod			Index of the next free node,
+*					incremented for each node built.
+* \param	vtx			Control points.
+* \param	co			Basis function coefficients.
+* \param	vIdx			Control point indices which are
+*					sorted into tree order.
+* \param	key			Workspace for sort keys with room for
+*					all control points.
+* \param	pw			Workspace for the powers of the
+*					offsets with room for all terms.
+* \param	first			First index of the node in vIdx.
+* \param	count			Number of control points in the node.
+*/
+static int	WlzBasisFnTreeBuild(WlzBasisFnTree *tree, int *nxtNod,
+				    WlzDVertex3 *vtx, WlzDVertex3 *co,
+				    int *vIdx, double *key, double *pw,
+				    int first, int count)
+{
+  int		idx,
+  		idT,
+		axis,
+  		nodIdx;
+  int		*tP;
+  double	tD0;
+  double	h[3];
+  WlzDVertex3	cVx,
+  		dVx,
+		vMin,
+  		vMax;
+  WlzDVertex3	*mom;
+  WlzBasisFnTreeNode *nod;
+
+  nodIdx = (*nxtNod)++;
+  nod = tree->nodes + nodIdx;
+  mom = tree->moments + (nodIdx * tree->nTerm);
+  nod->first = first;
+  nod->count = count;
+  nod->child[0] = nod->child[1] = -1;
+  vMin = vMax = vtx[vIdx[first]];
+  for(idx = 1; idx < count; ++idx)
+  {
+    cVx = vtx[vIdx[first + idx]];
+    vMin.vtX = ALG_MIN(vMin.vtX, cVx.vtX);
+    vMin.vtY = ALG_MIN(vMin.vtY, cVx.vtY);
+    vMin.vtZ = ALG_MIN(vMin.vtZ, cVx.vtZ);
+    vMax.vtX = ALG_MAX(vMax.vtX, cVx.vtX);
+    vMax.vtY = ALG_MAX(vMax.vtY, cVx.vtY);
+    vMax.vtZ = ALG_MAX(vMax.vtZ, cVx.vtZ);
+  }
+  WLZ_VTX_3_ADD(nod->centre, vMin, vMax);
+  WLZ_VTX_3_SCALE(nod->centre, nod->centre, 0.5);
+  nod->rad = 0.0;
+  pw[0] = 1.0;
+  for(idx = 0; idx < count; ++idx)
+  {
+    cVx = vtx[vIdx[first + idx]];
+    WLZ_VTX_3_SUB(dVx, nod->centre, cVx);
+    tD0 = WLZ_VTX_3_SQRLEN(dVx);
+    if(tD0 > nod->rad)
+    {
+      nod->rad = tD0;
+    }
+    h[0] = dVx.vtX;
+    h[1] = dVx.vtY;
+    h[2] = dVx.vtZ;
+    cVx = co[vIdx[first + idx]];
+    mom[0].vtX += cVx.vtX;
+    mom[0].vtY += cVx.vtY;
+    mom[0].vtZ += cVx.vtZ;
+    for(idT = 1; idT < tree->nTerm; ++idT)
+    {
+      tP = tree->terms + (7 * idT);
+      if(tP[1] >= 0)
+      {
+        pw[idT] = pw[tP[1]] * h[0];
+      }
+      else if(tP[2] >= 0)
+      {
+        pw[idT] = pw[tP[2]] * h[1];
+      }
+      else
+      {
+        pw[idT] = pw[tP[3]] * h[2];
+      }
+      mom[idT].vtX += pw[idT] * cVx.vtX;
+      mom[idT].vtY += pw[idT] * cVx.vtY;
+      mom[idT].vtZ += pw[idT] * cVx.vtZ;
+    }
+  }
+  nod->rad = sqrt(nod->rad);
+  if(count > WLZ_BASISFN_TREE_LEAFSZ)
+  {
+    int		cnt0,
+    		chd0,
+		chd1;
+
+    WLZ_VTX_3_SUB(dVx, vMax, vMin);
+    axis = ((dVx.vtX >= dVx.vtY) && (dVx.vtX >= dVx.vtZ))? 0:
+           (dVx.vtY >= dVx.vtZ)? 1: 2;
+    for(idx = 0; idx < count; ++idx)
+    {
+      int	idV;
+
+      idV = vIdx[first + idx];
+      key[idV] = (axis == 0)? vtx[idV].vtX:
+                 (axis == 1)? vtx[idV].vtY: vtx[idV].vtZ;
+    }
+    (void )AlgHeapSortIdx(key, vIdx + first, count, AlgHeapSortCmpIdxDFn);
+    cnt0 = count / 2;
+    chd0 = WlzBasisFnTreeBuild(tree, nxtNod, vtx, co, vIdx, key, pw,
+                               first, cnt0);
+    chd1 = WlzBasisFnTreeBuild(tree, nxtNod, vtx, co, vIdx, key, pw,
+                               first + cnt0, count - cnt0);
+    nod = tree->nodes + nodIdx;
+    nod->child[0] = chd0;
+    nod->child[1] = chd1;
+  }
+  return(nodIdx);
+}
+
+/*!
+* \return	Value of the radial function.
+* \ingroup	WlzFunction
+* \brief	Evaluates the radial function of a basis function, as used
+*		in the direct evaluation, for the given squared distance.
+* \param	type			Basis function type.
+* \param	delta			Basis function parameter.
+* \param	s			Squared distance.
+*/
+static double	WlzBasisFnTreePhi(WlzFnType type, double delta, double s)
+{
+  double	g = 0.0;
+
+  switch(type)
+  {
+    case WLZ_FN_BASIS_2DGAUSS:
+      g = (s > DBL_EPSILON)? exp(s * delta): 1.0;
+      break;
+    case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DMQ:
+      g = sqrt(s + delta);
+      break;
+    case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DIMQ:
+      g = 1.0 / sqrt(s + delta);
+      break;
+    case WLZ_FN_BASIS_2DTPS:
+      if(s > DBL_EPSILON)
+      {
+	g = s * log(s);
+      }
+      break;
+    case WLZ_FN_BASIS_2DCS: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DCS:
+      g = WlzBasisFnCSPhi(s, delta);
+      break;
+    default:
+      break;
+  }
+  return(g);
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Computes the Taylor coefficients \f$a_k\f$ of the radial
+*		function \f$f(y) = \phi(|y|^2)\f$ about \f$y = u\f$, so that
+*		\f$f(u + h) = \sum_k a_k h^k\f$ for multi-indices \f$k\f$.
+*		These are computed using recurrences for increasing
+*		degree \f$n = |k|\f$. With
+*		\f$S_1 = \sum_j u_j a_{k - e_j}\f$ and
+*		\f$S_2 = \sum_j a_{k - 2e_j}\f$, then for the generalised
+*		multiquadric \f$(|y|^2 + \delta)^\nu\f$, which satisfies
+*		\f$(|y|^2 + \delta) \nabla f = 2 \nu y f\f$,
+*		\f[
+		n (|u|^2 + \delta) a_k = 2 (\nu - n + 1) S_1 +
+		                         (2 \nu - n + 2) S_2
+		\f]
+*		for the Gaussian \f$e^{\delta |y|^2}\f$
+*		\f[
+		n a_k = 2 \delta (S_1 + S_2)
+		\f]
+*		and for the thin plate spline \f$|y|^2 \log |y|^2\f$ the
+*		coefficients \f$b_k\f$ of \f$\log |y|^2\f$ are found using
+*		the multiquadric recurrence with \f$\nu = 0\f$, but with
+*		additional terms of \f$2 u_j\f$ for \f$k = e_j\f$ and
+*		\f$2\f$ for \f$k = 2 e_j\f$, after which
+*		\f$a_k = |u|^2 b_k + 2 S_1(b) + S_2(b)\f$.
+* \param	tree			Tree with the term table.
+* \param	type			Basis function type.
+* \param	delta			Basis function parameter.
+* \param	nTerm			Number of terms required.
+* \param	uVx			Expansion position \f$u\f$.
+* \param	s			Squared length of \f$u\f$, which
+*					must be greater than zero for the
+*					thin plate spline.
+* \param	a			Destination for the coefficients.
+* \param	b			Workspace for the thin plate spline
+*					logarithm coefficients.
+*/
+static void	WlzBasisFnTreeCoef(WlzBasisFnTree *tree, WlzFnType type,
+				   double delta, int nTerm, WlzDVertex3 uVx,
+				   double s, double *a, double *b)
+{
+  int		idT,
+  		idJ,
+		n;
+  int		*tP;
+  double	nu,
+  		r0,
+		s1,
+		s2,
+		src;
+  double	u[3];
+
+  u[0] = uVx.vtX;
+  u[1] = uVx.vtY;
+  u[2] = uVx.vtZ;
+  switch(type)
+  {
+    case WLZ_FN_BASIS_2DGAUSS:
+      a[0] = WlzBasisFnTreePhi(type, delta, s);
+      for(idT = 1; idT < nTerm; ++idT)
+      {
+	tP = tree->terms + (7 * idT);
+	s1 = s2 = 0.0;
+	for(idJ = 0; idJ < 3; ++idJ)
+	{
+	  if(tP[1 + idJ] >= 0)
+	  {
+	    s1 += u[idJ] * a[tP[1 + idJ]];
+	    if(tP[4 + idJ] >= 0)
+	    {
+	      s2 += a[tP[4 + idJ]];
+	    }
+	  }
+	}
+	a[idT] = 2.0 * delta * (s1 + s2) / tP[0];
+      }
+      break;
+    case WLZ_FN_BASIS_2DMQ:  /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DMQ:  /* FALLTHROUGH */
+    case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DIMQ:
+      nu = ((type == WLZ_FN_BASIS_2DMQ) ||
+            (type == WLZ_FN_BASIS_3DMQ))? 0.5: -0.5;
+      r0 = s + delta;
+      a[0] = WlzBasisFnTreePhi(type, delta, s);
+      for(idT = 1; idT < nTerm; ++idT)
+      {
+	tP = tree->terms + (7 * idT);
+	n = tP[0];
+	s1 = s2 = 0.0;
+	for(idJ = 0; idJ < 3; ++idJ)
+	{
+	  if(tP[1 + idJ] >= 0)
+	  {
+	    s1 += u[idJ] * a[tP[1 + idJ]];
+	    if(tP[4 + idJ] >= 0)
+	    {
+	      s2 += a[tP[4 + idJ]];
+	    }
+	  }
+	}
+	a[idT] = ((2.0 * (nu - n + 1) * s1) + (((2.0 * nu) - n + 2) * s2)) /
+	         (n * r0);
+      }
+      break;
+    case WLZ_FN_BASIS_2DTPS:
+      b[0] = log(s);
+      a[0] = s * b[0];
+      for(idT = 1; idT < nTerm; ++idT)
+      {
+	tP = tree->terms + (7 * idT);
+	n = tP[0];
+	s1 = s2 = src = 0.0;
+	for(idJ = 0; idJ < 3; ++idJ)
+	{
+	  if(tP[1 + idJ] >= 0)
+	  {
+	    s1 += u[idJ] * b[tP[1 + idJ]];
+	    if(n == 1)
+	    {
+	      src = 2.0 * u[idJ];
+	    }
+	    if(tP[4 + idJ] >= 0)
+	    {
+	      s2 += b[tP[4 + idJ]];
+	      if(n == 2)
+	      {
+	        src = 2.0;
+	      }
+	    }
+	  }
+	}
+	b[idT] = (src - (2.0 * (n - 1) * s1) - ((n - 2) * s2)) / (n * s);
+	a[idT] = (s * b[idT]) + (2.0 * s1) + s2;
+      }
+      break;
+    default:
+      for(idT = 0; idT < nTerm; ++idT)
+      {
+        a[idT] = 0.0;
+      }
+      break;
+  }
+}
+
+/*!
+* \return	Sum of the basis function coefficients weighted by the
+*		radial function.
+* \ingroup	WlzFunction
+* \brief	Uses the basis function's evaluation tree to approximate the
+*		sum over the control points of the basis function
+*		coefficients weighted by the radial function of the
+*		squared distance from the given vertex. This excludes
+*		the polynomial term and any final scaling.
+*		A node at offset \f$u\f$ from the vertex with radius \f$r\f$
+*		is a candidate for approximation if
+*		\f$\theta = r / |u|\f$ is less than WLZ_BASISFN_TREE_THETA.
+*		The error of an expansion of order \f$p\f$ is then
+*		estimated, per unit coefficient magnitude, by
+*		\f$\kappa_p F \theta^{p+1} / (1 - \theta)\f$ where \f$F\f$
+*		is the largest magnitude of the radial function at
+*		distances \f$|u| - r\f$, \f$|u|\f$ and \f$|u| + r\f$.
+*		The terms of each degree are bounded by those of the
+*		Gegenbauer expansion of the radial function, which decay
+*		as \f$\kappa_p = (p + 1)^{-3/2}\f$ for the multiquadric and
+*		\f$\kappa_p = 1 / (p (p + 1))\f$ for the thin plate spline,
+*		otherwise \f$\kappa_p = 1\f$.
+*		For compactly supported basis functions nodes are never
+*		approximated, instead those with \f$|u| \geq r + \rho\f$
+*		for support radius \f$\rho\f$ are skipped.
+* \param	basisFn			Basis function with a tree.
+* \param	srcVx			Source vertex.
+*/
+static WlzDVertex3 WlzBasisFnTreeSum3D(WlzBasisFn *basisFn,
+				       WlzDVertex3 srcVx)
+{
+  int		idx,
+  		cs,
+		nStk = 0;
+  double	s,
+		tD0,
+		tD1,
+  		delta = 0.0,
+		errMax;
+  int		stk[WLZ_BASISFN_TREE_MAXDEPTH];
+  double	a[WLZ_BASISFN_TREE_MAXTERM],
+  		b[WLZ_BASISFN_TREE_MAXTERM];
+  WlzDVertex3	uVx,
+  		sumVx;
+  WlzBasisFnTreeNode *nod;
+  WlzBasisFnTree *tree;
+
+  tree = basisFn->tree;
+  errMax = (tree->wSum > DBL_EPSILON)? tree->tol / tree->wSum: DBL_MAX;
+  if(basisFn->param)
+  {
+    delta = *((double *)(basisFn->param));
+  }
+  cs = (basisFn->type == WLZ_FN_BASIS_2DCS) ||
+       (basisFn->type == WLZ_FN_BASIS_3DCS);
+  sumVx.vtX = sumVx.vtY = sumVx.vtZ = 0.0;
+  stk[nStk++] = 0;
+  while(nStk > 0)
+  {
+    int		skip = 0,
+    		order = -1;
+
+    nod = tree->nodes + stk[--nStk];
+    WLZ_VTX_3_SUB(uVx, srcVx, nod->centre);
+    s = WLZ_VTX_3_SQRLEN(uVx);
+    if(cs)
+    {
+      /* Only nodes within the support radius contribute. */
+      tD0 = nod->rad + delta;
+      skip = s >= tD0 * tD0;
+    }
+    else if((s > DBL_EPSILON) &&
+            (nod->rad < WLZ_BASISFN_TREE_THETA * sqrt(s)))
+    {
+      double	f,
+      		theta;
+
+      /* Find the lowest order expansion with an acceptable error. */
+      tD0 = sqrt(s);
+      theta = nod->rad / tD0;
+      f = fabs(WlzBasisFnTreePhi(basisFn->type, delta, s));
+      tD1 = tD0 - nod->rad;
+      tD1 = fabs(WlzBasisFnTreePhi(basisFn->type, delta, tD1 * tD1));
+      f = ALG_MAX(f, tD1);
+      tD1 = tD0 + nod->rad;
+      tD1 = fabs(WlzBasisFnTreePhi(basisFn->type, delta, tD1 * tD1));
+      f = ALG_MAX(f, tD1);
+      tD1 = errMax * (1.0 - theta) / f;
+      tD0 = theta;
+      for(idx = 0; idx <= tree->order; ++idx)
+      {
+	double	est;
+
+        switch(basisFn->type)
+	{
+	  case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+	  case WLZ_FN_BASIS_3DMQ:
+	    est = tD0 / ((idx + 1) * sqrt(idx + 1.0));
+	    break;
+	  case WLZ_FN_BASIS_2DTPS:
+	    est = (idx > 0)? tD0 / (idx * (idx + 1)): tD0;
+	    break;
+	  default:
+	    est = tD0;
+	    break;
+	}
+	if(est <= tD1)
+	{
+	  order = idx;
+	  break;
+	}
+	tD0 *= theta;
+      }
+    }
+    if(order >= 0)
+    {
+      int	nTerm;
+      WlzDVertex3 *mom;
+
+      /* Far from the node so approximate it using a Taylor expansion. */
+      nTerm = WlzBasisFnTreeNTerm(tree->dim, order);
+      WlzBasisFnTreeCoef(tree, basisFn->type, delta, nTerm, uVx, s, a, b);
+      mom = tree->moments + ((nod - tree->nodes) * tree->nTerm);
+      for(idx = 0; idx < nTerm; ++idx)
+      {
+        sumVx.vtX += a[idx] * mom[idx].vtX;
+        sumVx.vtY += a[idx] * mom[idx].vtY;
+        sumVx.vtZ += a[idx] * mom[idx].vtZ;
+      }
+    }
+    else if(!skip && (nod->child[0] < 0))
+    {
+      /* Near to a leaf node so sum its control points directly. */
+      for(idx = nod->first; idx < nod->first + nod->count; ++idx)
+      {
+        WLZ_VTX_3_SUB(uVx, srcVx, tree->vertices[idx]);
+	tD0 = WlzBasisFnTreePhi(basisFn->type, delta,
+			        WLZ_VTX_3_SQRLEN(uVx));
+	sumVx.vtX += tD0 * tree->basis[idx].vtX;
+	sumVx.vtY += tD0 * tree->basis[idx].vtY;
+	sumVx.vtZ += tD0 * tree->basis[idx].vtZ;
+      }
+    }
+    else if(!skip)
+    {
+      stk[nStk++] = nod->child[1];
+      stk[nStk++] = nod->child[0];
+    }
+  }
+  return(sumVx);
+}
+
+/*!
+* \return	Sum of the basis function coefficients weighted by the
+*		radial function.
+* \ingroup	WlzFunction
+* \brief	Two dimensional wrapper for WlzBasisFnTreeSum3D().
+* \param	basisFn			Basis function with a tree.
+* \param	srcVx			Source vertex.
+*/
+static WlzDVertex2 WlzBasisFnTreeSum2D(WlzBasisFn *basisFn,
+				       WlzDVertex2 srcVx)
+{
+  WlzDVertex2	sumVx;
+  WlzDVertex3	pos,
+  		sum3Vx;
+
+  pos.vtX = srcVx.vtX;
+  pos.vtY = srcVx.vtY;
+  pos.vtZ = 0.0;
+  sum3Vx = WlzBasisFnTreeSum3D(basisFn, pos);
+  sumVx.vtX = sum3Vx.vtX;
+  sumVx.vtY = sum3Vx.vtY;
+  return(sumVx);
+}
+
+/*!
+* \return	Value of the radial function.
+* \ingroup	WlzFunction
+* \brief	Computes Wendland's \f$C^2\f$ compactly supported radial
+*		function \f$(1 - r)_+^4 (4 r + 1)\f$, where \f$r\f$ is the
+*		distance divided by the support radius.
+* \param	s			Squared distance.
+* \param	rho			Support radius.
+*/
+static double	WlzBasisFnCSPhi(double s, double rho)
+{
+  double	r,
+  		t,
+		g = 0.0;
+
+  if(s < rho * rho)
+  {
+    r = sqrt(s) / rho;
+    t = 1.0 - r;
+    t *= t;
+    g = t * t * ((4.0 * r) + 1.0);
+  }
+  return(g);
+}
+
+/*!
+* \return	Support radius.
+* \ingroup	WlzFunction
+* \brief	Chooses a support radius for a compactly supported basis
+*		function. This is the median, over a sample of the control
+*		points, of the distance to the WLZ_BASISFN_CS_NNBR2D'th
+*		or WLZ_BASISFN_CS_NNBR3D'th nearest control point.
+* \param	dim			Dimension, 2 or 3.
+* \param	nPts			Number of control points.
+* \param	vtx			Control points.
+*/
+static double	WlzBasisFnCSRadius(int dim, int nPts, WlzDVertex3 *vtx)
+{
+  int		idK,
+  		idN,
+		idS,
+		nK,
+		nSmp;
+  double	rho = 1.0;
+  double	nnD[WLZ_BASISFN_CS_NNBR3D],
+  		smpD[WLZ_BASISFN_CS_NSAMPLE];
+
+  nK = (dim == 2)? WLZ_BASISFN_CS_NNBR2D: WLZ_BASISFN_CS_NNBR3D;
+  nK = ALG_MIN(nK, nPts - 1);
+  if(nK > 0)
+  {
+    nSmp = ALG_MIN(WLZ_BASISFN_CS_NSAMPLE, nPts);
+    for(idS = 0; idS < nSmp; ++idS)
+    {
+      int	idP,
+      		nNN = 0;
+      double	d;
+      WlzDVertex3 tV;
+
+      idP = (int )(((long )idS * nPts) / nSmp);
+      for(idN = 0; idN < nPts; ++idN)
+      {
+	if(idN != idP)
+	{
+	  WLZ_VTX_3_SUB(tV, vtx[idN], vtx[idP]);
+	  d = WLZ_VTX_3_SQRLEN(tV);
+	  /* Keep the nK smallest squared distances in ascending order. */
+	  if((nNN < nK) || (d < nnD[nK - 1]))
+	  {
+	    idK = (nNN < nK)? nNN++: nK - 1;
+	    while((idK > 0) && (nnD[idK - 1] > d))
+	    {
+	      nnD[idK] = nnD[idK - 1];
+	      --idK;
+	    }
+	    nnD[idK] = d;
+	  }
+	}
+      }
+      smpD[idS] = nnD[nK - 1];
+    }
+    (void )AlgHeapSort(smpD, nSmp, sizeof(double), AlgHeapSortCmpDFn);
+    rho = sqrt(smpD[nSmp / 2]);
+    if(rho < DBL_EPSILON)
+    {
+      rho = 1.0;
+    }
+  }
+  return(rho);
+}
+
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new 2D or 3D compactly supported basis function,
+*		see WlzBasisFnCS2DFromCPts(). Control points and
+*		displacements are always given in 3D, with zero z
+*		components for 2D.
+* \param	dim			Dimension, 2 or 3.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	rho			Support radius, chosen automatically
+*					if not greater than zero.
+* \param	alpha			Regularization parameter.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzBasisFn *WlzBasisFnCSFromCPts(int dim, int nPts,
+				WlzDVertex3 *dPts, WlzDVertex3 *sPts,
+				double rho, double alpha,
+				WlzErrorNum *dstErr)
+{
+  int		idC,
+  		idK,
+		idL,
+		idN,
+		nP;
+  size_t	vSz;
+  double	tD0,
+  		range;
+  double	q[4];
+  double	pC[3][4];
+  int		*rank = NULL;
+  double	*bV = NULL,
+		*pV = NULL,
+		*rV = NULL,
+		*wV = NULL,
+		*xV = NULL;
+  double	**nA;
+  AlgMatrix	aM,
+  		nM,
+		vM,
+		wM;
+  WlzDBox3	extentDB;
+  WlzBasisFn	*basisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  aM.core = NULL;
+  nM.core = NULL;
+  vM.core = NULL;
+  wM.core = NULL;
+  nP = dim + 1;
+  vSz = (dim == 2)? sizeof(WlzDVertex2): sizeof(WlzDVertex3);
+  if(alpha < 0.0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(((basisFn = (WlzBasisFn *)
+		      AlcCalloc(sizeof(WlzBasisFn), 1)) == NULL) ||
+	  ((basisFn->poly.v = AlcMalloc(vSz * nP)) == NULL) ||
+	  ((basisFn->basis.v = AlcMalloc(vSz * nPts)) == NULL) ||
+	  ((basisFn->vertices.v = AlcMalloc(vSz * nPts)) == NULL) ||
+	  ((basisFn->param = AlcMalloc(sizeof(double) * 2)) == NULL) ||
+	  ((rV = (double *)AlcMalloc(sizeof(double) * 3 * nPts)) == NULL) ||
+	  ((xV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+	  ((pV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+	  ((rank = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+	  ((bV = (double *)AlcMalloc(sizeof(double) * nP)) == NULL) ||
+	  ((wV = (double *)AlcCalloc(nP, sizeof(double))) == NULL) ||
+	  ((nM.rect = AlgMatrixRectNew(nP, nP, NULL)) == NULL) ||
+	  ((vM.rect = AlgMatrixRectNew(nP, nP, NULL)) == NULL) ||
+	  ((wM.rect = AlgMatrixRectNew(4, nPts, NULL)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    basisFn->type = (dim == 2)? WLZ_FN_BASIS_2DCS: WLZ_FN_BASIS_3DCS;
+    basisFn->nPoly = 2;
+    basisFn->nBasis = nPts;
+    basisFn->nVtx = nPts;
+    basisFn->maxVx = nPts;
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      if(dim == 2)
+      {
+	basisFn->vertices.d2[idN].vtX = dPts[idN].vtX;
+	basisFn->vertices.d2[idN].vtY = dPts[idN].vtY;
+      }
+      else
+      {
+	basisFn->vertices.d3[idN] = dPts[idN];
+      }
+      /* Displacements with all x components, then y and then z. */
+      rV[idN] = sPts[idN].vtX - dPts[idN].vtX;
+      rV[nPts + idN] = sPts[idN].vtY - dPts[idN].vtY;
+      rV[(2 * nPts) + idN] = sPts[idN].vtZ - dPts[idN].vtZ;
+    }
+    /* Fit the affine polynomial by least squares using coordinates
+     * scaled to the unit cube. */
+    WlzBasisFnVxExtent3D(&extentDB, dPts, dPts, nPts);
+    range = ALG_MAX(extentDB.xMax - extentDB.xMin,
+                    extentDB.yMax - extentDB.yMin);
+    range = ALG_MAX(range, extentDB.zMax - extentDB.zMin);
+    if(range < DBL_EPSILON)
+    {
+      range = 1.0;
+    }
+    AlgMatrixZero(nM);
+    nA = nM.rect->array;
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      q[0] = 1.0;
+      q[1] = (dPts[idN].vtX - extentDB.xMin) / range;
+      q[2] = (dPts[idN].vtY - extentDB.yMin) / range;
+      q[3] = (dPts[idN].vtZ - extentDB.zMin) / range;
+      for(idK = 0; idK < nP; ++idK)
+      {
+        for(idL = 0; idL < nP; ++idL)
+	{
+	  nA[idK][idL] += q[idK] * q[idL];
+	}
+      }
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(nM, wV, vM));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzBasisFnEditSV(nP, wV);
+    for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < dim); ++idC)
+    {
+      double	*cV;
+
+      cV = rV + (idC * nPts);
+      for(idK = 0; idK < nP; ++idK)
+      {
+        bV[idK] = 0.0;
+      }
+      for(idN = 0; idN < nPts; ++idN)
+      {
+	q[0] = 1.0;
+	q[1] = (dPts[idN].vtX - extentDB.xMin) / range;
+	q[2] = (dPts[idN].vtY - extentDB.yMin) / range;
+	q[3] = (dPts[idN].vtZ - extentDB.zMin) / range;
+	for(idK = 0; idK < nP; ++idK)
+	{
+	  bV[idK] += q[idK] * cV[idN];
+	}
+      }
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(nM, wV, vM, bV));
+      if(errNum == WLZ_ERR_NONE)
+      {
+        /* Remove the polynomial from the displacements and change the
+	 * polynomial coefficients back to unscaled coordinates. */
+	for(idN = 0; idN < nPts; ++idN)
+	{
+	  q[1] = (dPts[idN].vtX - extentDB.xMin) / range;
+	  q[2] = (dPts[idN].vtY - extentDB.yMin) / range;
+	  q[3] = (dPts[idN].vtZ - extentDB.zMin) / range;
+	  tD0 = bV[0];
+	  for(idK = 1; idK < nP; ++idK)
+	  {
+	    tD0 += bV[idK] * q[idK];
+	  }
+	  cV[idN] -= tD0;
+	}
+	q[1] = extentDB.xMin;
+	q[2] = extentDB.yMin;
+	q[3] = extentDB.zMin;
+	pC[idC][0] = bV[0];
+	for(idK = 1; idK < nP; ++idK)
+	{
+	  pC[idC][idK] = bV[idK] / range;
+	  pC[idC][0] -= pC[idC][idK] * q[idK];
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(rho <= 0.0)
+    {
+      rho = WlzBasisFnCSRadius(dim, nPts, dPts);
+    }
+    *((double *)(basisFn->param) + 0) = rho;
+    *((double *)(basisFn->param) + 1) = alpha;
+    errNum = WlzBasisFnCSMatrix(&aM, rank, nPts, dPts, &extentDB,
+                                rho, alpha);
+  }
+  /* Solve the sparse design equation for each component of the
+   * residual displacements, overwriting them with the coefficients.
+   * The equation's rows are in the spatially coherent order given
+   * by rank. */
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < dim); ++idC)
+  {
+    double	*cV;
+
+    cV = rV + (idC * nPts);
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      xV[idN] = 0.0;
+      pV[rank[idN]] = cV[idN];
+    }
+    errNum = WlzErrorFromAlg(
+             AlgMatrixCGSolve(aM, xV, pV, wM,
+	                      WlzBasisFnCSPrecond, NULL,
+			      WLZ_BASISFN_CS_CGTOL, WLZ_BASISFN_CS_CGMAXITR,
+			      NULL, NULL));
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < nPts; ++idN)
+      {
+        cV[idN] = xV[rank[idN]];
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dim == 2)
+    {
+      for(idK = 0; idK < nP; ++idK)
+      {
+	basisFn->poly.d2[idK].vtX = pC[0][idK];
+	basisFn->poly.d2[idK].vtY = pC[1][idK];
+      }
+      for(idN = 0; idN < nPts; ++idN)
+      {
+	basisFn->basis.d2[idN].vtX = rV[idN];
+	basisFn->basis.d2[idN].vtY = rV[nPts + idN];
+      }
+    }
+    else
+    {
+      for(idK = 0; idK < nP; ++idK)
+      {
+	basisFn->poly.d3[idK].vtX = pC[0][idK];
+	basisFn->poly.d3[idK].vtY = pC[1][idK];
+	basisFn->poly.d3[idK].vtZ = pC[2][idK];
+      }
+      for(idN = 0; idN < nPts; ++idN)
+      {
+	basisFn->basis.d3[idN].vtX = rV[idN];
+	basisFn->basis.d3[idN].vtY = rV[nPts + idN];
+	basisFn->basis.d3[idN].vtZ = rV[(2 * nPts) + idN];
+      }
+    }
+    /* The tree only skips control points beyond the support radius,
+     * so any positive tolerance gives exact evaluation. */
+    errNum = WlzBasisFnSetTree(basisFn, 1.0);
+  }
+  AlcFree(bV);
+  AlcFree(pV);
+  AlcFree(rV);
+  AlcFree(wV);
+  AlcFree(xV);
+  AlcFree(rank);
+  AlgMatrixFree(aM);
+  AlgMatrixFree(nM);
+  AlgMatrixFree(vM);
+  AlgMatrixFree(wM);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnFree(basisFn);
+    basisFn = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(basisFn);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Builds the sparse design equation matrix of a compactly
+*		supported basis function. Control points are binned into
+*		a uniform grid with cells no smaller than the support
+*		radius so that only those in neighbouring cells need be
+*		compared. The rows and columns of the matrix are ordered
+*		by grid cell, which keeps neighbouring control points
+*		close together and makes the Gauss-Seidel preconditioner
+*		far more effective than an arbitrary order would.
+* \param	dstM			Destination for the new linked list
+*					row matrix.
+* \param	rank			Destination array for the matrix
+*					row of each control point, must
+*					have room for nPts values.
+* \param	nPts			Number of control points.
+* \param	vtx			Control points.
+* \param	extentDB		Extent of the control points.
+* \param	rho			Support radius.
+* \param	alpha			Regularization parameter added to
+*					the diagonal.
+*/
+static WlzErrorNum WlzBasisFnCSMatrix(AlgMatrix *dstM, int *rank, int nPts,
+				WlzDVertex3 *vtx, WlzDBox3 *extentDB,
+				double rho, double alpha)
+{
+  int		idN,
+		fit = 0,
+		nCell = 0;
+  int		nG[3];
+  int		*cellOf = NULL,
+  		*cellFirst = NULL,
+		*cellVtx = NULL;
+  double	cSz,
+		rho2;
+  AlgMatrix	aM;
+  AlgError	algErr = ALG_ERR_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  aM.core = NULL;
+  /* Choose the cell size so there are not many more cells than control
+   * points. */
+  cSz = rho;
+  while(!fit)
+  {
+    double	gX,
+    		gY,
+		gZ;
+
+    gX = floor((extentDB->xMax - extentDB->xMin) / cSz) + 1.0;
+    gY = floor((extentDB->yMax - extentDB->yMin) / cSz) + 1.0;
+    gZ = floor((extentDB->zMax - extentDB->zMin) / cSz) + 1.0;
+    if(gX * gY * gZ <= (4.0 * nPts) + 64.0)
+    {
+      nG[0] = (int )gX;
+      nG[1] = (int )gY;
+      nG[2] = (int )gZ;
+      nCell = nG[0] * nG[1] * nG[2];
+      fit = 1;
+    }
+    else
+    {
+      cSz *= 2.0;
+    }
+  }
+  if(((cellOf = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+     ((cellVtx = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+     ((cellFirst = (int *)AlcCalloc(nCell + 1, sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    aM.llr = AlgMatrixLLRNew(nPts, nPts,
+                             (size_t )nPts * WLZ_BASISFN_CS_NNBR3D, 0.0,
+			     &algErr);
+    errNum = WlzErrorFromAlg(algErr);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Bin the control points by cell. */
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      int	iX,
+		iY,
+		iZ;
+
+      iX = ALG_MIN((int )((vtx[idN].vtX - extentDB->xMin) / cSz), nG[0] - 1);
+      iY = ALG_MIN((int )((vtx[idN].vtY - extentDB->yMin) / cSz), nG[1] - 1);
+      iZ = ALG_MIN((int )((vtx[idN].vtZ - extentDB->zMin) / cSz), nG[2] - 1);
+      cellOf[idN] = iX + (nG[0] * (iY + (nG[1] * iZ)));
+      ++(cellFirst[cellOf[idN]]);
+    }
+    for(idN = 1; idN < nCell; ++idN)
+    {
+      cellFirst[idN] += cellFirst[idN - 1];
+    }
+    cellFirst[nCell] = nPts;
+    for(idN = nPts - 1; idN >= 0; --idN)
+    {
+      cellVtx[--(cellFirst[cellOf[idN]])] = idN;
+    }
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      rank[cellVtx[idN]] = idN;
+    }
+    /* Set the matrix entries for all pairs of control points within the
+     * support radius. */
+    rho2 = rho * rho;
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nPts); ++idN)
+    {
+      int	iX,
+		iY,
+		iZ,
+		jX,
+		jY,
+		jZ;
+
+      iZ = cellOf[idN] / (nG[0] * nG[1]);
+      iY = (cellOf[idN] / nG[0]) % nG[1];
+      iX = cellOf[idN] % nG[0];
+      for(jZ = ALG_MAX(iZ - 1, 0); jZ <= ALG_MIN(iZ + 1, nG[2] - 1); ++jZ)
+      {
+	for(jY = ALG_MAX(iY - 1, 0); jY <= ALG_MIN(iY + 1, nG[1] - 1); ++jY)
+	{
+	  for(jX = ALG_MAX(iX - 1, 0); jX <= ALG_MIN(iX + 1, nG[0] - 1);
+	      ++jX)
+	  {
+	    int	idC,
+	    	idM;
+
+	    idC = jX + (nG[0] * (jY + (nG[1] * jZ)));
+	    for(idM = cellFirst[idC];
+	        (algErr == ALG_ERR_NONE) && (idM < cellFirst[idC + 1]); ++idM)
+	    {
+	      int	idP;
+	      double	d;
+	      WlzDVertex3 tV;
+
+	      idP = cellVtx[idM];
+	      WLZ_VTX_3_SUB(tV, vtx[idP], vtx[idN]);
+	      if((d = WLZ_VTX_3_SQRLEN(tV)) < rho2)
+	      {
+		d = WlzBasisFnCSPhi(d, rho);
+		if(idP == idN)
+		{
+		  d += alpha;
+		}
+		algErr = AlgMatrixLLRSet(aM.llr, rank[idN], rank[idP], d);
+	      }
+	    }
+	  }
+	}
+      }
+      errNum = WlzErrorFromAlg(algErr);
+    }
+  }
+  AlcFree(cellOf);
+  AlcFree(cellVtx);
+  AlcFree(cellFirst);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstM = aM;
+  }
+  else
+  {
+    AlgMatrixFree(aM);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Symmetric Gauss-Seidel preconditioner for the conjugate
+*		gradient solution of a sparse design equation, which
+*		solves \f$(D + L) D^{-1} (D + U) z = r\f$ for \f$z\f$
+*		using a forward then a backward sweep. The rows of the
+*		linked list row matrix are ordered by column so each
+*		sweep only visits the entries it needs.
+* \param	data			Unused.
+* \param	aM			Linked list row matrix.
+* \param	r			Given residual vector.
+* \param	z			Destination vector.
+*/
+static void	WlzBasisFnCSPrecond(void *data, AlgMatrix aM,
+				    double *r, double *z)
+{
+  size_t	idN;
+  double	d,
+  		t;
+  AlgMatrixLLRE *p;
+
+  for(idN = 0; idN < aM.llr->nR; ++idN)
+  {
+    d = 1.0;
+    t = r[idN];
+    for(p = aM.llr->tbl[idN]; (p != NULL) && (p->col <= idN); p = p->nxt)
+    {
+      if(p->col < idN)
+      {
+        t -= p->val * z[p->col];
+      }
+      else
+      {
+        d = p->val;
+      }
+    }
+    z[idN] = t / d;
+  }
+  idN = aM.llr->nR;
+  while(idN-- > 0)
+  {
+    d = 1.0;
+    t = 0.0;
+    for(p = aM.llr->tbl[idN]; p != NULL; p = p->nxt)
+    {
+      if(p->col > idN)
+      {
+        t += p->val * z[p->col];
+      }
+      else if(p->col == idN)
+      {
+        d = p->val;
+      }
+    }
+    z[idN] -= t / d;
+  }
+}
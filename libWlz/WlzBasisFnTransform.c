@@ -153,6 +153,13 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2D(WlzFnType type,
 *		supply the multi-quadric delta or gauss parameter scaling.
 *		The default values of multi-quadric delta = 0.001 and
 *		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		For compactly supported basis functions the parameters
+*		are the support radius and then the regularization
+*		parameter, both of which default to zero (see
+*		WlzBasisFnCS2DFromCPts()). Compactly supported basis
+*		functions are fitted iteratively and can be used with
+*		many thousands of control points, but they do not
+*		support constrained distances.
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_2DPOLY.
@@ -254,6 +261,21 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 					order, dPts, sPts,
 				        &errNum);
 	break;
+      case WLZ_FN_BASIS_2DCS:
+        if(mesh != NULL)
+	{
+	  errNum = WLZ_ERR_TRANSFORM_TYPE;
+	}
+	else
+	{
+	  basisTr->basisFn = WlzBasisFnCS2DFromCPts(nDPts, dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					param[0]: 0.0,
+					((nParam > 1) && (param != NULL))?
+					param[1]: 0.0,
+					&errNum);
+	}
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -286,6 +308,13 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 *		supply the multi-quadric delta or gauss parameter scaling.
 *		The default values of multi-quadric delta = 0.001 and
 *		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		For compactly supported basis functions the parameters
+*		are the support radius and then the regularization
+*		parameter, both of which default to zero (see
+*		WlzBasisFnCS2DFromCPts()). Compactly supported basis
+*		functions are fitted iteratively and can be used with
+*		many thousands of control points, but they do not
+*		support constrained distances.
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_3DPOLY.
@@ -364,6 +393,21 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3DParam(WlzFnType type,
 					*param: deltaMQ,
 					NULL, mesh, &errNum);
 	break;
+      case WLZ_FN_BASIS_3DCS:
+        if(mesh != NULL)
+	{
+	  errNum = WLZ_ERR_TRANSFORM_TYPE;
+	}
+	else
+	{
+	  basisTr->basisFn = WlzBasisFnCS3DFromCPts(nDPts, dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					param[0]: 0.0,
+					((nParam > 1) && (param != NULL))?
+					param[1]: 0.0,
+					&errNum);
+	}
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -433,6 +477,9 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPts(WlzBasisFnTransform *basisTr,
 *		supply the multi-quadric delta or gauss parameter scaling.
 *		The default values of multi-quadric delta = 0.001 and
 *		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		If the basis function has an evaluation tree (see
+*		WlzBasisFnSetTree()) then it is rebuilt with the same
+*		tolerance.
 * \param	basisTr			Existing basis function transform.
 * \param	nDPts			Number of destination control points.
 * \param	dPts			Destination control points.
@@ -518,6 +565,14 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPtsParam(WlzBasisFnTransform *basisTr,
 					dPts, sPts,
 				        &errNum);
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	newBasisFn = WlzBasisFnCS2DFromCPts(nDPts, dPts, sPts,
+			  ((nParam > 0) && (param != NULL))?
+			  param[0]: *((double *)(basisTr->basisFn->param) + 0),
+			  ((nParam > 1) && (param != NULL))?
+			  param[1]: *((double *)(basisTr->basisFn->param) + 1),
+			  &errNum);
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -525,6 +580,11 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPtsParam(WlzBasisFnTransform *basisTr,
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    /* Rebuild any evaluation tree for the new control points. */
+    if((basisTr->basisFn->tree != NULL) && (newBasisFn->tree == NULL))
+    {
+      errNum = WlzBasisFnSetTree(newBasisFn, basisTr->basisFn->tree->tol);
+    }
     (void )WlzBasisFnFree(basisTr->basisFn);
     basisTr->basisFn = newBasisFn;
   }
@@ -655,6 +715,14 @@ WlzErrorNum    	WlzBasisFnSetMesh(WlzMeshTransform *mesh,
 	  ++nod;
 	}
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	while(nodCnt-- > 0)
+	{
+	  nod->displacement = WlzBasisFnValueCS2D(basisTr->basisFn,
+	  				nod->position);
+	  ++nod;
+	}
+	break;
       default:
 	errNum = WLZ_ERR_TRANSFORM_TYPE;
 	break;
@@ -832,6 +900,22 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
 	  }
 	}
         break;
+      case WLZ_FN_BASIS_2DCS:
+#ifdef _OPENMP
+#pragma omp parallel for private(dsp, dspV, nod)
+#endif
+	for(idN = 0; idN < maxNodIdx; ++idN)
+	{
+	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	  if(nod->idx >= 0)
+	  {
+	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
+	    dspV = WlzBasisFnValueCS2D(basisTr->basisFn, nod->pos);
+	    dsp[0] = dspV.vtX;
+	    dsp[1] = dspV.vtY;
+	  }
+	}
+        break;
       default:
 	errNum = WLZ_ERR_DOMAIN_TYPE;
         break;
@@ -885,6 +969,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
           case WLZ_FN_BASIS_2DTPS:
 	    cDspB = WlzBasisFnValueTPS2D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_2DCS:
+	    cDspB = WlzBasisFnValueCS2D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_2_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -999,6 +1086,23 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
 	  }
 	}
 	break;
+      case WLZ_FN_BASIS_3DCS:
+#ifdef _OPENMP
+#pragma omp parallel for private(dsp, dspV, nod)
+#endif
+        for(idN = 0; idN < maxNodIdx; ++idN)
+	{
+	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	  if(nod->idx >= 0)
+	  {
+	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
+	    dspV = WlzBasisFnValueCS3D(basisTr->basisFn, nod->pos);
+	    dsp[0] = dspV.vtX;
+	    dsp[1] = dspV.vtY;
+	    dsp[2] = dspV.vtZ;
+	  }
+	}
+	break;
       default:
         errNum = WLZ_ERR_VALUES_TYPE;
 	break;
@@ -1046,6 +1150,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
           case WLZ_FN_BASIS_3DMQ:
 	    cDspB = WlzBasisFnValueMQ3D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_3DCS:
+	    cDspB = WlzBasisFnValueCS3D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_3_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -2012,6 +2119,11 @@ WlzDVertex2	WlzBasisFnTransformVertexD(WlzBasisFnTransform *basisTr,
 	dstVx.vtX += srcVx.vtX;
 	dstVx.vtY += srcVx.vtY;
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	dstVx = WlzBasisFnValueCS2D(basisTr->basisFn, srcVx);
+	dstVx.vtX += srcVx.vtX;
+	dstVx.vtY += srcVx.vtY;
+	break;
       default:
 	errNum = WLZ_ERR_TRANSFORM_TYPE;
 	break;
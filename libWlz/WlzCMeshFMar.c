@@ -45,6 +45,31 @@ static char _WlzCMeshFMar_c[] = "University of Edinburgh $Id$";
 
 /* #define WLZ_CMESH_FMAR_DEBUG */
 
+/*!
+* \def		WLZ_CMESH_FIM_TOL
+* \ingroup	WlzMesh
+* \brief	Relative change in a node's distance below which the fast
+* 		iterative method considers the node to have converged.
+*/
+#define WLZ_CMESH_FIM_TOL	(1.0e-09)
+
+/*!
+* \def		WLZ_CMESH_FIM_NOD_FLAG_CAND
+* \ingroup	WlzMesh
+* \brief	Private node flag used by the fast iterative method to mark
+* 		nodes already in the candidate list. It is outside the range
+* 		of the public node flags.
+*/
+#define WLZ_CMESH_FIM_NOD_FLAG_CAND (WLZ_CMESH_NOD_FLAG_ALL + 1)
+
+/*!
+* \def		WLZ_CMESH_FIM_LESS
+* \ingroup	WlzMesh
+* \brief	Non zero if distance A is less than distance B by more than
+* 		the fast iterative method's tolerance.
+*/
+#define WLZ_CMESH_FIM_LESS(A,B) ((A) < ((B) - (WLZ_CMESH_FIM_TOL * (A))))
+
 /*!
 * \struct	_WlzCMeshFMarQEnt
 * \ingroup	WlzMesh
@@ -131,6 +156,15 @@ static int			WlzCMeshFMarCompute3D3(
 				  WlzCMeshNod3D *nod2,
 				  WlzCMeshNod3D *nod3,
 				  double *distances);
+static double			WlzCMeshFMarSolve3D3(
+				  WlzDVertex3 p0,
+				  WlzDVertex3 p1,
+				  WlzDVertex3 p2,
+				  WlzDVertex3 p3,
+				  double d0,
+				  double d1,
+				  double d2,
+				  double d3);
 static WlzErrorNum 		WlzCMeshFMarAddSeeds2D(
 				  AlcHeap *queue,
 				  WlzCMesh2D *mesh, 
@@ -189,6 +223,40 @@ static WlzErrorNum 		WlzCMeshFMarElmQInit3D(
 				  AlcHeap *queue,
 				  WlzCMeshNod3D *nod,
 				  int *fmNFlags);
+static WlzErrorNum		WlzCMeshFIMAddSeeds2D5(
+				  WlzCMesh2D5 *mesh,
+				  double *distances,
+				  int *fimFlags,
+				  int nSeeds,
+				  WlzDVertex3 *seeds);
+static WlzErrorNum		WlzCMeshFIMRun(
+				  WlzCMeshP mesh,
+				  double *distances,
+				  int *fimFlags);
+static int			WlzCMeshFIMCandidates(
+				  WlzCMeshP mesh,
+				  int idx,
+				  int *fimFlags,
+				  int *cnd,
+				  int nCnd);
+static int			WlzCMeshFIMAddCandidate(
+				  int idx,
+				  int *fimFlags,
+				  int *cnd,
+				  int nCnd);
+static double			WlzCMeshFIMSolveNod(
+				  WlzCMeshP mesh,
+				  int idx,
+				  double *distances);
+static double			WlzCMeshFIMSolveNod2D(
+				  WlzCMeshNod2D *nod,
+				  double *distances);
+static double			WlzCMeshFIMSolveNod2D5(
+				  WlzCMeshNod2D5 *nod,
+				  double *distances);
+static double			WlzCMeshFIMSolveNod3D(
+				  WlzCMeshNod3D *nod,
+				  double *distances);
 
 /*!
 * \return	A 2D domain object, an empty object if the mesh has
@@ -837,6 +905,299 @@ WlzErrorNum	WlzCMeshFMarNodes3D(WlzCMesh3D *mesh, double *distances,
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes constrained distances within a 2D conforming mesh
+* 		using the fast iterative method. This is an alternative
+* 		to WlzCMeshFMarNodes2D() with the same seeds and distances,
+* 		but rather than a single front ordered by a priority queue
+* 		a list of active nodes is kept and all of the active nodes
+* 		are updated concurrently. Nodes are removed from the active
+* 		list when their distance converges, at which point any
+* 		neighbours whose distance would decrease are added to it.
+* 		Each pass of the active list reads the distances of the
+* 		previous pass, so the computed distances do not depend on
+* 		the number of threads.
+* 		The given mesh will not be modified.
+* \param	mesh			Given mesh.
+* \param	distances		Array for computed distances.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+* 					any seeds are not within the
+* 					mesh.
+*/
+WlzErrorNum	WlzCMeshFIMNodes2D(WlzCMesh2D *mesh, double *distances,
+				   int nSeeds, WlzDVertex2 *seeds)
+{
+  int		idN,
+  		idS,
+		cnt;
+  int		*fimFlags = NULL;
+  WlzCMeshNod2D	*nod;
+  WlzCMeshP	meshP;
+  AlcHeap 	*nodQ = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_2D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fimFlags = (int *)AlcCalloc(mesh->res.nod.maxEnt,
+                                    sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
+    if((cnt = WlzCMeshCountBoundNodes2D(mesh)) <= 0)
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+  }
+  /* Set the seed distances using the same seeding as fast marching, the
+   * node queue is only needed by this. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((nodQ = AlcHeapNew(sizeof(WlzCMeshFMarQEnt), cnt, NULL)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nodQ->topPriLo = 1;
+    if(nSeeds > 0)
+    {
+      errNum = WlzCMeshFMarAddSeeds2D(nodQ, mesh, cnt + 1,
+                                      distances, fimFlags, nSeeds, seeds);
+    }
+    else
+    {
+      nSeeds = cnt;
+      if((seeds = (WlzDVertex2 *)
+                  AlcMalloc(nSeeds * sizeof(WlzDVertex2))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	idS = 0;
+        for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+	{
+	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	  if((nod->idx >= 0) && (WlzCMeshNodIsBoundary2D(nod) != 0))
+	  {
+	    seeds[idS] = nod->pos;
+	    ++idS;
+	  }
+	}
+	errNum = WlzCMeshFMarAddSeeds2D(nodQ, mesh, cnt + 1,
+				        distances, fimFlags, nSeeds, seeds);
+	AlcFree(seeds);
+      }
+    }
+  }
+  AlcHeapFree(nodQ);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    meshP.m2 = mesh;
+    errNum = WlzCMeshFIMRun(meshP, distances, fimFlags);
+  }
+  AlcFree(fimFlags);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes constrained distances within a 2D5 conforming mesh
+* 		(a triangulated surface in 3D) using the fast iterative
+* 		method, see WlzCMeshFIMNodes2D().
+* 		Each seed sets the distances of the nodes of the element
+* 		which encloses it, or if there is no enclosing element
+* 		the distance of the closest node, to the Euclidean distance
+* 		from the seed.
+* 		The given mesh will not be modified.
+* \param	mesh			Given mesh.
+* \param	distances		Array for computed distances.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1.
+*/
+WlzErrorNum	WlzCMeshFIMNodes2D5(WlzCMesh2D5 *mesh, double *distances,
+				    int nSeeds, WlzDVertex3 *seeds)
+{
+  int		*fimFlags = NULL;
+  WlzCMeshP	meshP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_2D5)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fimFlags = (int *)AlcCalloc(mesh->res.nod.maxEnt,
+                                    sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
+    errNum = WlzCMeshFIMAddSeeds2D5(mesh, distances, fimFlags,
+                                    nSeeds, seeds);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    meshP.m2d5 = mesh;
+    errNum = WlzCMeshFIMRun(meshP, distances, fimFlags);
+  }
+  AlcFree(fimFlags);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes constrained distances within a 3D conforming mesh
+* 		using the fast iterative method, see WlzCMeshFIMNodes2D().
+* 		This is an alternative to WlzCMeshFMarNodes3D() with the
+* 		same seeds and distances.
+* 		The given mesh will not be modified.
+* \param	mesh			Given mesh.
+* \param	distances		Array for computed distances.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+* 					any seeds are not within the
+* 					mesh.
+*/
+WlzErrorNum	WlzCMeshFIMNodes3D(WlzCMesh3D *mesh, double *distances,
+				   int nSeeds, WlzDVertex3 *seeds)
+{
+  int		idN,
+  		idS,
+		cnt;
+  int		*fimFlags = NULL;
+  WlzCMeshNod3D	*nod;
+  WlzCMeshP	meshP;
+  AlcHeap 	*nodQ = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fimFlags = (int *)AlcCalloc(mesh->res.nod.maxEnt,
+                                    sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
+    if((cnt = WlzCMeshCountBoundNodes3D(mesh)) <= 0)
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+  }
+  /* Set the seed distances using the same seeding as fast marching, the
+   * node queue is only needed by this. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((nodQ = AlcHeapNew(sizeof(WlzCMeshFMarQEnt), cnt, NULL)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nodQ->topPriLo = 1;
+    if(nSeeds > 0)
+    {
+      errNum = WlzCMeshFMarAddSeeds3D(nodQ, mesh, cnt + 1,
+                                      distances, fimFlags, nSeeds, seeds);
+    }
+    else
+    {
+      nSeeds = cnt;
+      if((seeds = (WlzDVertex3 *)
+                  AlcMalloc(nSeeds * sizeof(WlzDVertex3))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	idS = 0;
+        for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+	{
+	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	  if((nod->idx >= 0) && (WlzCMeshNodIsBoundary3D(nod) != 0))
+	  {
+	    seeds[idS] = nod->pos;
+	    ++idS;
+	  }
+	}
+	errNum = WlzCMeshFMarAddSeeds3D(nodQ, mesh, cnt + 1,
+				        distances, fimFlags, nSeeds, seeds);
+	AlcFree(seeds);
+      }
+    }
+  }
+  AlcHeapFree(nodQ);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    meshP.m3 = mesh;
+    errNum = WlzCMeshFIMRun(meshP, distances, fimFlags);
+  }
+  AlcFree(fimFlags);
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzMesh
@@ -1390,19 +1751,53 @@ static int	WlzCMeshFMarCompute3D2(WlzCMeshNod3D *nod0,
 /*!
 * \return	Non zero if distance computed and less than current distance.
 * \ingroup	WlzMesh
-* \brief	Computes wavefront propagation time for the unknown nodes of
-* 		the given element.
-* 		This function is given three known nodes and computes the
-* 		times for the remaining node using the following method.
-* 		The solution is similar to that in "Fast Sweeping Methods
-* 		For Eikonal equations On triangular meshes", Jianliang Qian,
-* 		etal, SIAM journal on Mumerical Analysis, Vol 45, pp 83-107,
-* 		2007. But is given in greater detail here than in the paper.
-* 		Given a tetrahedron with four nodes \f$(n_0, n_1, n_2, n_3)\f$
-* 		and known front arival times at the first three of these
-* 		nodes \f$(t_0, t_1, t_2)\f$ such that \f$t0 \leq t_1, t_2\f$.
-* 		This method is only used provided causality constraints are
-* 		satisfied: ie \f$n_1 - n_0 > (t_1 - t_0)s_3\f$,
+* \brief	Computes wavefront propagation time for the unknown node of
+* 		the given element, given three known nodes, using
+* 		WlzCMeshFMarSolve3D3().
+* \param	nod0			First (current) known node.
+* \param	nod1			Second known node.
+* \param	nod2			Third known node.
+* \param	nod3			Unknown node.
+* \param	distances		Array of distances indexed by the
+* 					mesh node indices, which will be
+* 					set for the unknown node on return.
+*/
+static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
+                                       WlzCMeshNod3D *nod1,
+                                       WlzCMeshNod3D *nod2,
+                                       WlzCMeshNod3D *nod3,
+				       double *distances)
+{
+  int		rtn = 0;
+  double	d;
+
+  d = WlzCMeshFMarSolve3D3(nod0->pos, nod1->pos, nod2->pos, nod3->pos,
+                           distances[nod0->idx], distances[nod1->idx],
+			   distances[nod2->idx], distances[nod3->idx]);
+  if(d < distances[nod3->idx])
+  {
+    distances[nod3->idx] = d;
+    rtn = 1;
+  }
+  return(rtn);
+}
+
+/*!
+* \return	Computed distance of the fourth vertex, which is never
+* 		greater than the given distance of the fourth vertex.
+* \ingroup	WlzMesh
+* \brief	Computes wavefront propagation time for the fourth vertex
+* 		of a tetrahedron given known times at the other three.
+* 		The following method is used.
+* 		The solution is similar to that in "Fast Sweeping Methods
+* 		For Eikonal equations On triangular meshes", Jianliang Qian,
+* 		etal, SIAM journal on Mumerical Analysis, Vol 45, pp 83-107,
+* 		2007. But is given in greater detail here than in the paper.
+* 		Given a tetrahedron with four nodes \f$(n_0, n_1, n_2, n_3)\f$
+* 		and known front arival times at the first three of these
+* 		nodes \f$(t_0, t_1, t_2)\f$ such that \f$t0 \leq t_1, t_2\f$.
+* 		This method is only used provided causality constraints are
+* 		satisfied: ie \f$n_1 - n_0 > (t_1 - t_0)s_3\f$,
 * 		\f$n_2 - n_0 > (t_2 - t_0)s_3\f$ and the normal (see below)
 * 		passes through the triangle fromed by \f$n_0, n_1, n_2\f$.
 *
@@ -1445,25 +1840,24 @@ static int	WlzCMeshFMarCompute3D2(WlzCMeshNod3D *nod0,
 *		\f$\mathbf{Q}\f$ must be within the triangle.  If this is
 *		not satisfied the time value is the minimum for the path
 *		along the other three faces.
-* \param	nod0			First (current) known node.
-* \param	nod1			Second known node.
-* \param	nod2			Third known node.
-* \param	nod3			Unknown node.
-* \param	distances		Array of distances indexed by the
-* 					mesh node indices, which will be
-* 					set for the unknown node on return.
+* \param	p0			Position of first known vertex.
+* \param	p1			Position of second known vertex.
+* \param	p2			Position of third known vertex.
+* \param	p3			Position of unknown vertex.
+* \param	d0			Distance of first vertex.
+* \param	d1			Distance of second vertex.
+* \param	d2			Distance of third vertex.
+* \param	d3			Current distance of the unknown vertex.
 */
-static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
-                                       WlzCMeshNod3D *nod1,
-                                       WlzCMeshNod3D *nod2,
-                                       WlzCMeshNod3D *nod3,
-				       double *distances)
+static double	WlzCMeshFMarSolve3D3(WlzDVertex3 p0, WlzDVertex3 p1,
+				     WlzDVertex3 p2, WlzDVertex3 p3,
+				     double d0, double d1,
+				     double d2, double d3)
 {
   int		id0,
   		id1,
 		hit = 0,
-		par = 0,
-		rtn = 0;
+		par = 0;
   double	a,
 		a2,
   		b,
@@ -1471,8 +1865,8 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
 		c,
 		c2,
 		d,
-		d1,
-  		d2,
+		dd1,
+  		dd2,
 		e,
 		e2,
 		f,
@@ -1484,57 +1878,55 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
 		q2;
   WlzDVertex3	n0,
 		n1,
-		t0,
-		t1;
-  WlzDVertex3	l[4];
-  WlzCMeshNod3D	*tNod;
-  WlzCMeshNod3D	*nod[8];
-
-  /* Sort nodes 0 - 2, by time st distances[nod[0]->idx] <=
-   * distances[nod[1]->idx] <= distances[nod[2]->idx]. */
-  nod[0] = nod0;
-  nod[1] = nod1;
-  nod[2] = nod2;
-  nod[3] = nod3;
+		w0,
+		w1;
+  double	t[4];
+  WlzDVertex3	l[4],
+  		p[4];
+
+  /* Sort vertices 0 - 2, by time st t[0] <= t[1] <= t[2]. */
+  p[0] = p0; p[1] = p1; p[2] = p2; p[3] = p3;
+  t[0] = d0; t[1] = d1; t[2] = d2; t[3] = d3;
   for(id0 = 0; id0 < 3; ++id0)
   {
     for(id1 = id0 + 1; id1 < 3; ++id1)
     {
-      if(*(distances + nod[id1]->idx) < *(distances + nod[id0]->idx))
+      if(t[id1] < t[id0])
       {
-        tNod = nod[id0]; nod[id0] = nod[id1]; nod[id1] = tNod;
+        w0 = p[id0]; p[id0] = p[id1]; p[id1] = w0;
+	d = t[id0]; t[id0] = t[id1]; t[id1] = d;
       }
     }
   }
-  /* Compute vectors and distances relative to nod[0]. */
-  WLZ_VTX_3_SUB(l[1], nod[1]->pos, nod[0]->pos);
-  WLZ_VTX_3_SUB(l[2], nod[2]->pos, nod[0]->pos);
-  d1 = *(distances + nod[1]->idx) - *(distances + nod[0]->idx);
-  d2 = *(distances + nod[2]->idx) - *(distances + nod[0]->idx);
+  /* Compute vectors and distances relative to p[0]. */
+  WLZ_VTX_3_SUB(l[1], p[1], p[0]);
+  WLZ_VTX_3_SUB(l[2], p[2], p[0]);
+  dd1 = t[1] - t[0];
+  dd2 = t[2] - t[0];
   a = WLZ_VTX_3_LENGTH(l[1]);
   b = WLZ_VTX_3_LENGTH(l[2]);
-  if((a < d1) && (b < d2))
+  if((a < dd1) && (b < dd2))
   {
     /* Compute the unit vector which is normal to the propagation front
      * by solving:
-     *   l[1] . n = d1
-     *   l[2] . n = d2
+     *   l[1] . n = dd1
+     *   l[2] . n = dd2
      *   n . n  = 1
      */
     a  = l[1].vtY * l[2].vtX - l[1].vtX * l[2].vtY;
     b  = l[1].vtZ * l[2].vtY - l[1].vtY * l[2].vtZ;
     c  = l[1].vtZ * l[2].vtX - l[1].vtX * l[2].vtZ;
-    d  = d2 * l[1].vtY - d1 * l[2].vtY;
-    e  = d2 * l[1].vtX - d1 * l[2].vtX;
+    d  = dd2 * l[1].vtY - dd1 * l[2].vtY;
+    e  = dd2 * l[1].vtX - dd1 * l[2].vtX;
     f  = -(d * b + e * c);
     a2 = a * a;
     b2 = b * b;
     c2 = c * c;
-    d2 = d * d;
+    dd2 = d * d;
     e2 = e * e;
     f2 = f * f;
-    g  = sqrt(f2 - (d2 + e2 - a2) * (a2 + b2 + c2));
-    h  = d2 + e2 - a2;
+    g  = sqrt(f2 - (dd2 + e2 - a2) * (a2 + b2 + c2));
+    h  = dd2 + e2 - a2;
     n0.vtZ = (f + g) / h;
     n1.vtZ = (f - g) / h;
     n0.vtY = -(e + c * n0.vtZ) / a;
@@ -1542,17 +1934,17 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     n0.vtX =  (d + b * n0.vtZ) / a;
     n1.vtX =  (d + b * n1.vtZ) / a;
     /* Have two solutions for the normal: n0 and n1, choose the one that runs
-     * from the centre of the triangle formed by nodes 0, 1 and 2 to node 3. */
-    WLZ_VTX_3_ADD3(t0, nod[0]->pos, nod[1]->pos, nod[2]->pos);
-    WLZ_VTX_3_SCALE(t0, t0, 1.0 / 3.0);
-    WLZ_VTX_3_SUB(t1, nod[3]->pos, t0);
-    a = WLZ_VTX_3_DOT(n0, t1);
+     * from the centre of the triangle formed by vertices 0, 1 and 2 to
+     * vertex 3. */
+    WLZ_VTX_3_ADD3(w0, p[0], p[1], p[2]);
+    WLZ_VTX_3_SCALE(w0, w0, 1.0 / 3.0);
+    WLZ_VTX_3_SUB(w1, p[3], w0);
+    a = WLZ_VTX_3_DOT(n0, w1);
     if(a < 0)
     {
       n0 = n1;
     }
-    hit = WlzGeomLineTriangleIntersect3D(nod[3]->pos, n0,
-					nod[0]->pos, nod[1]->pos, nod[2]->pos,
+    hit = WlzGeomLineTriangleIntersect3D(p[3], n0, p[0], p[1], p[2],
 					&par, NULL, NULL, NULL);
     if(par != 0)
     {
@@ -1560,17 +1952,16 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     }
     else if(hit != 0)
     {
-      /* Normal is through the triangle (nodes 0, 1 and 2), so compute the
-       * distance at node 3: t_3 = t_0 + n . (n_3 - n_0). */
-      WLZ_VTX_3_SUB(l[3], nod[3]->pos, nod[0]->pos);
+      /* Normal is through the triangle (vertices 0, 1 and 2), so compute
+       * the distance at vertex 3: t_3 = t_0 + n . (p_3 - p_0). */
+      WLZ_VTX_3_SUB(l[3], p[3], p[0]);
       d = WLZ_VTX_3_DOT(n0, l[3]);
       if(d > 0.0)
       {
-	d = *(distances + nod[0]->idx) + d;
-	if(*(distances + nod[3]->idx) > d)
+	d = t[0] + d;
+	if(t[3] > d)
 	{
-	  *(distances + nod[3]->idx) = d;
-	  rtn = 1;
+	  t[3] = d;
 	}
       }
     }
@@ -1582,34 +1973,29 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     for(id0 = 0; id0 < 3; ++id0)
     {
       id1 = (id0 + 1) % 3;
-      WlzGeomMap3DTriangleTo2D(nod[id0]->pos, nod[id1]->pos,
-                               nod[3]->pos, &q1, &q2);
-      d = WlzCMeshFMarSolve2D2(q0, q1, q2,
-                          distances[nod[id0]->idx],
-			  distances[nod[id1]->idx]);
-      if(d < distances[nod[3]->idx])
+      WlzGeomMap3DTriangleTo2D(p[id0], p[id1], p[3], &q1, &q2);
+      d = WlzCMeshFMarSolve2D2(q0, q1, q2, t[id0], t[id1]);
+      if(d < t[3])
       {
-	distances[nod[3]->idx] = d;
+	t[3] = d;
 	hit = 1;
-	rtn = 1;
       }
     }
   }
   if(hit == 0)
   {
-    /* TIf all else fails use the minimum distance along the edges. */
+    /* If all else fails use the minimum distance along the edges. */
     for(id0 = 0; id0 < 3; ++id0)
     {
-      WLZ_VTX_3_SUB(t0, nod[3]->pos, nod[id0]->pos);
-      d = WLZ_VTX_3_LENGTH(t0) + *(distances + nod[id0]->idx);
-      if(*(distances + nod[3]->idx) > d)
+      WLZ_VTX_3_SUB(w0, p[3], p[id0]);
+      d = WLZ_VTX_3_LENGTH(w0) + t[id0];
+      if(t[3] > d)
       {
-	rtn = 1;
-	*(distances + nod[3]->idx) = d;
+	t[3] = d;
       }
     }
   }
-  return(rtn);
+  return(t[3]);
 }
 
 /*!
@@ -2413,3 +2799,576 @@ static int	WlzCMeshFMarElmQCalcPriority3D(WlzCMeshElm3D *elm,
 	       ((fmNFlags[nod->idx] & WLZ_CMESH_NOD_FLAG_UPWIND) != 0));
   return(priority);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Sets the seed distances for the fast iterative method
+* 		within a 2D5 mesh, flagging the seeded nodes as known.
+* \param	mesh			The mesh.
+* \param	distances		Array of distances.
+* \param	fimFlags		Node flags for the fast iterative
+* 					method.
+* \param	nSeeds			Number of seeds, if \f$<\f$ 1 then
+* 					all boundary nodes are used.
+* \param	seeds			Array of seeds.
+*/
+static WlzErrorNum WlzCMeshFIMAddSeeds2D5(WlzCMesh2D5 *mesh,
+				double *distances, int *fimFlags,
+				int nSeeds, WlzDVertex3 *seeds)
+{
+  int		idN,
+  		idS,
+		idE,
+		cnt = 0;
+  double	d;
+  WlzDVertex3	del;
+  WlzCMeshNod2D5 *nod;
+  WlzCMeshElm2D5 *elm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nSeeds < 1)
+  {
+    for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+    {
+      nod = (WlzCMeshNod2D5 *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+      if((nod->idx >= 0) && (WlzCMeshNodIsBoundary2D5(nod) != 0))
+      {
+	distances[idN] = 0.0;
+	fimFlags[idN] |= WLZ_CMESH_NOD_FLAG_KNOWN;
+	++cnt;
+      }
+    }
+  }
+  else
+  {
+    for(idS = 0; idS < nSeeds; ++idS)
+    {
+      idE = WlzCMeshElmEnclosingPos2D5(mesh, -1, seeds[idS].vtX,
+                                       seeds[idS].vtY, seeds[idS].vtZ,
+				       0, NULL);
+      if(idE >= 0)
+      {
+        elm = (WlzCMeshElm2D5 *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	for(idN = 0; idN < 3; ++idN)
+	{
+	  nod = elm->edu[idN].nod;
+	  WLZ_VTX_3_SUB(del, nod->pos, seeds[idS]);
+	  d = WLZ_VTX_3_LENGTH(del);
+	  if(d < distances[nod->idx])
+	  {
+	    distances[nod->idx] = d;
+	  }
+	  fimFlags[nod->idx] |= WLZ_CMESH_NOD_FLAG_KNOWN;
+	}
+	++cnt;
+      }
+      else if((idN = WlzCMeshClosestNod2D5(mesh, seeds[idS])) >= 0)
+      {
+	nod = (WlzCMeshNod2D5 *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	WLZ_VTX_3_SUB(del, nod->pos, seeds[idS]);
+	d = WLZ_VTX_3_LENGTH(del);
+	if(d < distances[idN])
+	{
+	  distances[idN] = d;
+	}
+	fimFlags[idN] |= WLZ_CMESH_NOD_FLAG_KNOWN;
+	++cnt;
+      }
+    }
+  }
+  if(cnt == 0)
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Propagates distances from the known (seed) nodes through
+* 		the mesh using the fast iterative method. Only the known
+* 		node flag is used from the given flags on entry.
+* 		Each iteration:
+* 		  -# Updates the distances of all active nodes in parallel.
+* 		  -# Removes the nodes which have converged from the
+* 		     active list.
+* 		  -# Finds the neighbours of the converged nodes which
+* 		     are neither known nor active and in parallel
+* 		     computes their distances, adding those with reduced
+* 		     distances to the active list.
+* 		The known nodes act as the initial converged nodes.
+* \param	mesh			Given 2D, 2D5 or 3D mesh.
+* \param	distances		Array of distances, set for the known
+* 					nodes and DBL_MAX for all others.
+* \param	fimFlags		Node flags for the fast iterative
+* 					method.
+*/
+static WlzErrorNum WlzCMeshFIMRun(WlzCMeshP mesh, double *distances,
+				  int *fimFlags)
+{
+  int		idA,
+  		idN,
+		idx,
+		nAct = 0,
+		nCnd = 0,
+		nSrc = 0,
+		maxNod = 0;
+  double	d;
+  int		*act = NULL,
+  		*cnd = NULL,
+		*src = NULL;
+  double	*val = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(mesh.core->type)
+  {
+    case WLZ_CMESH_2D:
+      maxNod = mesh.m2->res.nod.maxEnt;
+      break;
+    case WLZ_CMESH_2D5:
+      maxNod = mesh.m2d5->res.nod.maxEnt;
+      break;
+    case WLZ_CMESH_3D:
+      maxNod = mesh.m3->res.nod.maxEnt;
+      break;
+    default:
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+      break;
+  }
+  if((errNum == WLZ_ERR_NONE) && (maxNod > 0))
+  {
+    if(((act = (int *)AlcMalloc(sizeof(int) * maxNod)) == NULL) ||
+       ((cnd = (int *)AlcMalloc(sizeof(int) * maxNod)) == NULL) ||
+       ((src = (int *)AlcMalloc(sizeof(int) * maxNod)) == NULL) ||
+       ((val = (double *)AlcMalloc(sizeof(double) * maxNod)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (maxNod > 0))
+  {
+    /* The known nodes are the initial sources from which to expand. */
+    for(idN = 0; idN < maxNod; ++idN)
+    {
+      fimFlags[idN] &= WLZ_CMESH_NOD_FLAG_KNOWN;
+      if(fimFlags[idN] != 0)
+      {
+        src[nSrc++] = idN;
+      }
+    }
+    for(;;)
+    {
+      /* Find the candidate neighbours of the converged source nodes,
+       * compute their distances and activate those that are reduced. */
+      nCnd = 0;
+      for(idA = 0; idA < nSrc; ++idA)
+      {
+        nCnd = WlzCMeshFIMCandidates(mesh, src[idA], fimFlags, cnd, nCnd);
+      }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for(idA = 0; idA < nCnd; ++idA)
+      {
+        val[idA] = WlzCMeshFIMSolveNod(mesh, cnd[idA], distances);
+      }
+      for(idA = 0; idA < nCnd; ++idA)
+      {
+	idx = cnd[idA];
+        fimFlags[idx] &= ~(WLZ_CMESH_FIM_NOD_FLAG_CAND);
+	if(WLZ_CMESH_FIM_LESS(val[idA], distances[idx]))
+	{
+	  distances[idx] = val[idA];
+	  fimFlags[idx] |= WLZ_CMESH_NOD_FLAG_ACTIVE;
+	  act[nAct++] = idx;
+	}
+      }
+      if(nAct == 0)
+      {
+        break;
+      }
+      /* Update all the active nodes from the current distances. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for(idA = 0; idA < nAct; ++idA)
+      {
+        val[idA] = WlzCMeshFIMSolveNod(mesh, act[idA], distances);
+      }
+      /* Keep the active nodes which have not converged and make the
+       * converged nodes the sources for the next expansion. */
+      idN = 0;
+      nSrc = 0;
+      for(idA = 0; idA < nAct; ++idA)
+      {
+	idx = act[idA];
+	d = distances[idx];
+	distances[idx] = val[idA];
+        if(WLZ_CMESH_FIM_LESS(val[idA], d))
+	{
+	  act[idN++] = idx;
+	}
+	else
+	{
+	  fimFlags[idx] &= ~(WLZ_CMESH_NOD_FLAG_ACTIVE);
+	  src[nSrc++] = idx;
+	}
+      }
+      nAct = idN;
+    }
+  }
+  AlcFree(act);
+  AlcFree(cnd);
+  AlcFree(src);
+  AlcFree(val);
+  return(errNum);
+}
+
+/*!
+* \return	New number of candidates.
+* \ingroup	WlzMesh
+* \brief	Appends the neighbours of the given node to the candidate
+* 		list, skipping any which are known, active or already
+* 		candidates.
+* \param	mesh			Given 2D, 2D5 or 3D mesh.
+* \param	idx			Index of the given node.
+* \param	fimFlags		Node flags for the fast iterative
+* 					method.
+* \param	cnd			Candidate node index list.
+* \param	nCnd			Number of candidates in the list.
+*/
+static int	WlzCMeshFIMCandidates(WlzCMeshP mesh, int idx,
+				      int *fimFlags, int *cnd, int nCnd)
+{
+  switch(mesh.core->type)
+  {
+    case WLZ_CMESH_2D:
+      {
+	WlzCMeshNod2D	*nod;
+	WlzCMeshEdgU2D	*edu0,
+			*edu1;
+
+	nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh.m2->res.nod.vec, idx);
+	edu0 = edu1 = nod->edu;
+	do
+	{
+	  nCnd = WlzCMeshFIMAddCandidate(edu1->next->nod->idx,
+	                                 fimFlags, cnd, nCnd);
+	  nCnd = WlzCMeshFIMAddCandidate(edu1->next->next->nod->idx,
+	                                 fimFlags, cnd, nCnd);
+	  edu1 = edu1->nnxt;
+	} while(edu1 != edu0);
+      }
+      break;
+    case WLZ_CMESH_2D5:
+      {
+	WlzCMeshNod2D5	*nod;
+	WlzCMeshEdgU2D5	*edu0,
+			*edu1;
+
+	nod = (WlzCMeshNod2D5 *)AlcVectorItemGet(mesh.m2d5->res.nod.vec,
+						 idx);
+	edu0 = edu1 = nod->edu;
+	do
+	{
+	  nCnd = WlzCMeshFIMAddCandidate(edu1->next->nod->idx,
+	                                 fimFlags, cnd, nCnd);
+	  nCnd = WlzCMeshFIMAddCandidate(edu1->next->next->nod->idx,
+	                                 fimFlags, cnd, nCnd);
+	  edu1 = edu1->nnxt;
+	} while(edu1 != edu0);
+      }
+      break;
+    case WLZ_CMESH_3D:
+      {
+	WlzCMeshNod3D	*nod;
+	WlzCMeshEdgU3D	*edu0,
+			*edu1;
+
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh.m3->res.nod.vec, idx);
+	edu0 = edu1 = nod->edu;
+	do
+	{
+	  nCnd = WlzCMeshFIMAddCandidate(edu1->next->nod->idx,
+	                                 fimFlags, cnd, nCnd);
+	  nCnd = WlzCMeshFIMAddCandidate(edu1->next->next->nod->idx,
+	                                 fimFlags, cnd, nCnd);
+	  edu1 = edu1->nnxt;
+	} while(edu1 != edu0);
+      }
+      break;
+    default:
+      break;
+  }
+  return(nCnd);
+}
+
+/*!
+* \return	New number of candidates.
+* \ingroup	WlzMesh
+* \brief	Appends the given node to the candidate list unless it is
+* 		known, active or already a candidate.
+* \param	idx			Index of the given node.
+* \param	fimFlags		Node flags for the fast iterative
+* 					method.
+* \param	cnd			Candidate node index list.
+* \param	nCnd			Number of candidates in the list.
+*/
+static int	WlzCMeshFIMAddCandidate(int idx, int *fimFlags,
+					int *cnd, int nCnd)
+{
+  if((fimFlags[idx] & (WLZ_CMESH_NOD_FLAG_KNOWN |
+                       WLZ_CMESH_NOD_FLAG_ACTIVE |
+		       WLZ_CMESH_FIM_NOD_FLAG_CAND)) == 0)
+  {
+    fimFlags[idx] |= WLZ_CMESH_FIM_NOD_FLAG_CAND;
+    cnd[nCnd++] = idx;
+  }
+  return(nCnd);
+}
+
+/*!
+* \return	Updated distance of the node, which is never greater than
+* 		it's current distance.
+* \ingroup	WlzMesh
+* \brief	Computes the distance of the given node from the current
+* 		distances of it's neighbours. The distances are only read,
+* 		so this may be called concurrently for different nodes.
+* \param	mesh			Given 2D, 2D5 or 3D mesh.
+* \param	idx			Index of the given node.
+* \param	distances		Array of distances.
+*/
+static double	WlzCMeshFIMSolveNod(WlzCMeshP mesh, int idx,
+				    double *distances)
+{
+  double	d = DBL_MAX;
+
+  switch(mesh.core->type)
+  {
+    case WLZ_CMESH_2D:
+      d = WlzCMeshFIMSolveNod2D((WlzCMeshNod2D *)
+                                AlcVectorItemGet(mesh.m2->res.nod.vec, idx),
+				distances);
+      break;
+    case WLZ_CMESH_2D5:
+      d = WlzCMeshFIMSolveNod2D5((WlzCMeshNod2D5 *)
+                                 AlcVectorItemGet(mesh.m2d5->res.nod.vec, idx),
+				 distances);
+      break;
+    case WLZ_CMESH_3D:
+      d = WlzCMeshFIMSolveNod3D((WlzCMeshNod3D *)
+                                AlcVectorItemGet(mesh.m3->res.nod.vec, idx),
+				distances);
+      break;
+    default:
+      break;
+  }
+  return(d);
+}
+
+/*!
+* \return	Updated distance of the node.
+* \ingroup	WlzMesh
+* \brief	Computes the distance of the given 2D node as the minimum
+* 		over the elements which use it. Within each element the
+* 		distance is computed from the other two nodes, or along
+* 		an edge if only one of them has a known distance.
+* \param	nod			Given node.
+* \param	distances		Array of distances.
+*/
+static double	WlzCMeshFIMSolveNod2D(WlzCMeshNod2D *nod, double *distances)
+{
+  double	d,
+  		d0,
+		d1,
+		dMin;
+  WlzDVertex2	del;
+  WlzCMeshNod2D	*nod0,
+  		*nod1;
+  WlzCMeshEdgU2D *edu0,
+  		*edu1;
+
+  dMin = distances[nod->idx];
+  edu0 = edu1 = nod->edu;
+  do
+  {
+    nod0 = edu1->next->nod;
+    nod1 = edu1->next->next->nod;
+    d0 = distances[nod0->idx];
+    d1 = distances[nod1->idx];
+    if(d1 < d0)
+    {
+      d = d0; d0 = d1; d1 = d;
+      nod0 = edu1->next->next->nod;
+      nod1 = edu1->next->nod;
+    }
+    if(d1 < DBL_MAX / 2.0)
+    {
+      d = WlzCMeshFMarSolve2D2(nod0->pos, nod1->pos, nod->pos, d0, d1);
+    }
+    else if(d0 < DBL_MAX / 2.0)
+    {
+      WLZ_VTX_2_SUB(del, nod->pos, nod0->pos);
+      d = d0 + WLZ_VTX_2_LENGTH(del);
+    }
+    else
+    {
+      d = DBL_MAX;
+    }
+    if(d < dMin)
+    {
+      dMin = d;
+    }
+    edu1 = edu1->nnxt;
+  } while(edu1 != edu0);
+  return(dMin);
+}
+
+/*!
+* \return	Updated distance of the node.
+* \ingroup	WlzMesh
+* \brief	Computes the distance of the given 2D5 node as the minimum
+* 		over the elements which use it, with each element mapped
+* 		into it's plane, see WlzCMeshFIMSolveNod2D().
+* \param	nod			Given node.
+* \param	distances		Array of distances.
+*/
+static double	WlzCMeshFIMSolveNod2D5(WlzCMeshNod2D5 *nod,
+				       double *distances)
+{
+  double	d,
+  		d0,
+		d1,
+		dMin;
+  WlzDVertex2	q0,
+  		q1,
+		q2;
+  WlzDVertex3	del;
+  WlzCMeshNod2D5 *nod0,
+  		*nod1;
+  WlzCMeshEdgU2D5 *edu0,
+  		*edu1;
+
+  WLZ_VTX_2_SET(q0, 0.0, 0.0);
+  dMin = distances[nod->idx];
+  edu0 = edu1 = nod->edu;
+  do
+  {
+    nod0 = edu1->next->nod;
+    nod1 = edu1->next->next->nod;
+    d0 = distances[nod0->idx];
+    d1 = distances[nod1->idx];
+    if(d1 < d0)
+    {
+      d = d0; d0 = d1; d1 = d;
+      nod0 = edu1->next->next->nod;
+      nod1 = edu1->next->nod;
+    }
+    if(d1 < DBL_MAX / 2.0)
+    {
+      WlzGeomMap3DTriangleTo2D(nod0->pos, nod1->pos, nod->pos, &q1, &q2);
+      d = WlzCMeshFMarSolve2D2(q0, q1, q2, d0, d1);
+    }
+    else if(d0 < DBL_MAX / 2.0)
+    {
+      WLZ_VTX_3_SUB(del, nod->pos, nod0->pos);
+      d = d0 + WLZ_VTX_3_LENGTH(del);
+    }
+    else
+    {
+      d = DBL_MAX;
+    }
+    if(d < dMin)
+    {
+      dMin = d;
+    }
+    edu1 = edu1->nnxt;
+  } while(edu1 != edu0);
+  return(dMin);
+}
+
+/*!
+* \return	Updated distance of the node.
+* \ingroup	WlzMesh
+* \brief	Computes the distance of the given 3D node as the minimum
+* 		over the elements which use it. Within each element the
+* 		distance is computed from the other nodes with known
+* 		distances: using WlzCMeshFMarSolve3D3() for three, the
+* 		common face for two and the common edge for one.
+* 		Each element is visited once, through the first of it's
+* 		faces which uses the node.
+* \param	nod			Given node.
+* \param	distances		Array of distances.
+*/
+static double	WlzCMeshFIMSolveNod3D(WlzCMeshNod3D *nod, double *distances)
+{
+  int		idN,
+  		nKwn;
+  double	d,
+		dMin;
+  double	dKwn[3];
+  WlzDVertex2	q0,
+  		q1,
+		q2;
+  WlzDVertex3	del;
+  WlzCMeshFace	*fce;
+  WlzCMeshElm3D	*elm;
+  WlzCMeshNod3D	*nodes[4],
+  		*kwn[3];
+  WlzCMeshEdgU3D *edu0,
+  		*edu1;
+
+  WLZ_VTX_2_SET(q0, 0.0, 0.0);
+  dMin = distances[nod->idx];
+  edu0 = edu1 = nod->edu;
+  do
+  {
+    elm = edu1->face->elm;
+    nodes[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+    nodes[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+    nodes[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+    nodes[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+    /* Face 0 uses nodes 0, 1 and 2, face 1 uses node 3. */
+    fce = (nodes[3] == nod)? elm->face + 1: elm->face + 0;
+    if(edu1->face == fce)
+    {
+      nKwn = 0;
+      for(idN = 0; idN < 4; ++idN)
+      {
+	if((nodes[idN] != nod) &&
+	   ((d = distances[nodes[idN]->idx]) < DBL_MAX / 2.0))
+	{
+	  dKwn[nKwn] = d;
+	  kwn[nKwn++] = nodes[idN];
+	}
+      }
+      switch(nKwn)
+      {
+        case 1:
+	  WLZ_VTX_3_SUB(del, nod->pos, kwn[0]->pos);
+	  d = dKwn[0] + WLZ_VTX_3_LENGTH(del);
+	  break;
+	case 2:
+	  WlzGeomMap3DTriangleTo2D(kwn[0]->pos, kwn[1]->pos, nod->pos,
+	                           &q1, &q2);
+	  d = WlzCMeshFMarSolve2D2(q0, q1, q2, dKwn[0], dKwn[1]);
+	  break;
+	case 3:
+	  d = WlzCMeshFMarSolve3D3(kwn[0]->pos, kwn[1]->pos, kwn[2]->pos,
+	                           nod->pos, dKwn[0], dKwn[1], dKwn[2], dMin);
+	  break;
+	default:
+	  d = DBL_MAX;
+	  break;
+      }
+      if(d < dMin)
+      {
+        dMin = d;
+      }
+    }
+    edu1 = edu1->nnxt;
+  } while(edu1 != edu0);
+  return(dMin);
+}
@@ -166,6 +166,10 @@ typedef struct _WlzCMeshScanWSp3D
   WlzCMeshScanElm3D *dElm;		/*! Destination mesh element data. */
   WlzIBox3	dBox;			/*! Bounding box of the displaced
   					    mesh. */
+  int		*plnItv;		/*! Index of the first interval in
+  					    each plane of the bounding box,
+					    with an additional entry set to
+					    the number of intervals. */
 } WlzCMeshScanWSp3D;
 
 static void 			WlzCMeshUpdateScanElm2D(
@@ -180,6 +184,8 @@ static void 			WlzCMeshUpdateScanElm3D(
 				  WlzObject *mObj,
 				  WlzCMeshScanElm3D *sElm,
 				  int fwd);
+static void 			WlzCMeshUpdateScanElms3D(
+				  WlzCMeshScanWSp3D *mSWSp);
 static void			WlzCMeshScanWSpFree2D(
 				  WlzCMeshScanWSp2D *mSWSp);
 static void			WlzCMeshScanWSpFree3D(
@@ -329,6 +335,17 @@ static WlzErrorNum 		WlzCMeshScanObjValues3D(
 				  WlzObject *srcObj,
 				  WlzCMeshScanWSp3D *mSWSp,
 				  WlzInterpolationType interp);
+static WlzErrorNum 		WlzCMeshScanObjValuesPln3D(
+				  WlzObject *dstObj,
+				  WlzCMeshScanWSp3D *mSWSp,
+				  WlzInterpolationType interp,
+				  int idP,
+				  WlzGreyType gType,
+				  WlzPixelV bgdV,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzGreyP olpBuf,
+				  int *olpCnt,
+				  int bufWidth);
 static WlzErrorNum 		WlzCMeshScanFlushOlpBuf(
 				  WlzGreyP dGP,
 				  WlzGreyP olpBuf,
@@ -3941,6 +3958,7 @@ static void 	WlzCMeshUpdateScanElm3D(WlzObject *mObj,
   ixv = mObj->values.x;
   if(ixv == NULL)
   {
+    sE->flags = (fwd)? WLZ_CMESH_SCANELM_FWD: WLZ_CMESH_SCANELM_REV;
     sE->tr[0] = 1.0;
     sE->tr[1] = 0.0;
     sE->tr[2] = 0.0;
@@ -3998,6 +4016,36 @@ static void 	WlzCMeshUpdateScanElm3D(WlzObject *mObj,
   }
 }
 
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Computes the inverse transform coefficients for all valid
+*		elements of the given 3D mesh scan workspace. This allows
+*		the workspace intervals to be scanned concurrently, with
+*		the elements then only being read.
+* \param	mSWSp			Mesh scan workspace.
+*/
+static void 	WlzCMeshUpdateScanElms3D(WlzCMeshScanWSp3D *mSWSp)
+{
+  int		idE,
+  		nElm;
+
+  nElm = mSWSp->mTr->domain.cm3->res.elm.maxEnt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for(idE = 0; idE < nElm; ++idE)
+  {
+    WlzCMeshScanElm3D *sE;
+
+    sE = mSWSp->dElm + idE;
+    if((sE->idx >= 0) && ((sE->flags & WLZ_CMESH_SCANELM_REV) == 0))
+    {
+      WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
+    }
+  }
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzTransform
@@ -4749,20 +4797,23 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
 {
   int		idE,
 		idI,
-		idN,
+		idP,
+		idT,
   		elmCnt,
-		fstNod;
-  double	*dsp;
-  WlzDVertex3	dspP;
-  WlzDVertex3	dspPos[4];
+		nPln,
+		nItv = 0,
+		nThr = 1,
+		fstBox = 1;
+  int		*thrItvCnt = NULL,
+  		*plnPos = NULL;
+  AlcVector	**thrItvVec = NULL;
   WlzDBox3	dBox;
-  AlcVector	*itvVec = NULL;
   AlcVector	*elmVec;
-  WlzCMeshNod3D	*nodBuf[4];
   WlzCMeshElm3D	*elm;
   WlzIndexedValues *ixv = NULL;
   WlzCMesh3D	*mesh;
   WlzCMeshScanWSp3D *mSWSp = NULL;
+  WlzCMeshScanItv3D *itv;
   WlzCMeshScanElm3D *dElm;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -4805,90 +4856,157 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
   {
     elmVec = mesh->res.elm.vec;
     elmCnt = mesh->res.elm.maxEnt;
-    /* Collect the intervals in the displaced mesh. */
-    /* Create temporary vector in which to accumulate the intervals. */
-    if((itvVec = AlcVectorNew(1, sizeof(WlzCMeshScanItv3D),
-				   mesh->res.elm.vec->blkSz, NULL)) == NULL)
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    /* Create temporary vectors in which each thread accumulates the
+     * intervals of the elements that it scans. */
+    if(((thrItvVec = (AlcVector **)
+                     AlcCalloc(nThr, sizeof(AlcVector *))) == NULL) ||
+       ((thrItvCnt = (int *)AlcCalloc(nThr, sizeof(int))) == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    idE = 0;
-    idI = 0;
-    fstNod = 1;
-    while((errNum == WLZ_ERR_NONE) && (idE < elmCnt))
+    /* Collect the intervals in the displaced mesh. */
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThr)
+#endif
     {
-      /* Compute the displaced nodes and collect the intervals. */
-      elm = (WlzCMeshElm3D *)AlcVectorItemGet(elmVec, (size_t )idE);
-      if(elm->idx >= 0)
+      int	idN,
+		thrId = 0,
+		thrIdI = 0,
+		fstNod = 1;
+      double	*dsp;
+      WlzDVertex3 dspP;
+      WlzDVertex3 dspPos[4];
+      WlzDBox3	tBox;
+      AlcVector	*itvVec;
+      WlzCMeshNod3D *nodBuf[4];
+      WlzCMeshElm3D *pElm;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      tBox = dBox;
+      if((itvVec = AlcVectorNew(1, sizeof(WlzCMeshScanItv3D),
+				elmVec->blkSz, NULL)) == NULL)
+      {
+        errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 256)
+#endif
+      for(idE = 0; idE < elmCnt; ++idE)
       {
-	nodBuf[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
-	nodBuf[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
-	nodBuf[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
-	nodBuf[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
-        for(idN = 0; idN < 4; ++idN)
+	/* Compute the displaced nodes and collect the intervals. */
+	pElm = (WlzCMeshElm3D *)AlcVectorItemGet(elmVec, (size_t )idE);
+	if((errNum2 == WLZ_ERR_NONE) && (pElm->idx >= 0))
 	{
-	  if(ixv == NULL)
+	  nodBuf[0] = WLZ_CMESH_ELM3D_GET_NODE_0(pElm);
+	  nodBuf[1] = WLZ_CMESH_ELM3D_GET_NODE_1(pElm);
+	  nodBuf[2] = WLZ_CMESH_ELM3D_GET_NODE_2(pElm);
+	  nodBuf[3] = WLZ_CMESH_ELM3D_GET_NODE_3(pElm);
+	  for(idN = 0; idN < 4; ++idN)
 	  {
-	    dspP = nodBuf[idN]->pos;
-	  }
-	  else
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, nodBuf[idN]->idx);
-	    dspP.vtX = nodBuf[idN]->pos.vtX + dsp[0];
-	    dspP.vtY = nodBuf[idN]->pos.vtY + dsp[1];
-	    dspP.vtZ = nodBuf[idN]->pos.vtZ + dsp[2];
-	  }
-	  dspPos[idN] = dspP;
-	  if(fstNod)
-	  {
-	    dBox.xMin = dBox.xMax = dspP.vtX;
-	    dBox.yMin = dBox.yMax = dspP.vtY;
-	    dBox.zMin = dBox.zMax = dspP.vtZ;
-	    fstNod = 0;
-	  }
-	  else
-	  {
-	    if(dspP.vtX < dBox.xMin)
+	    if(ixv == NULL)
 	    {
-	      dBox.xMin = dspP.vtX;
+	      dspP = nodBuf[idN]->pos;
 	    }
-	    else if(dspP.vtX > dBox.xMax)
-	    {
-	      dBox.xMax = dspP.vtX;
-	    }
-	    if(dspP.vtY < dBox.yMin)
-	    {
-	      dBox.yMin = dspP.vtY;
-	    }
-	    else if(dspP.vtY > dBox.yMax)
+	    else
 	    {
-	      dBox.yMax = dspP.vtY;
+	      dsp = (double *)WlzIndexedValueGet(ixv, nodBuf[idN]->idx);
+	      dspP.vtX = nodBuf[idN]->pos.vtX + dsp[0];
+	      dspP.vtY = nodBuf[idN]->pos.vtY + dsp[1];
+	      dspP.vtZ = nodBuf[idN]->pos.vtZ + dsp[2];
 	    }
-	    if(dspP.vtZ < dBox.zMin)
+	    dspPos[idN] = dspP;
+	    if(fstNod)
 	    {
-	      dBox.zMin = dspP.vtZ;
+	      tBox.xMin = tBox.xMax = dspP.vtX;
+	      tBox.yMin = tBox.yMax = dspP.vtY;
+	      tBox.zMin = tBox.zMax = dspP.vtZ;
+	      fstNod = 0;
 	    }
-	    else if(dspP.vtZ > dBox.zMax)
+	    else
 	    {
-	      dBox.zMax = dspP.vtZ;
+	      if(dspP.vtX < tBox.xMin)
+	      {
+		tBox.xMin = dspP.vtX;
+	      }
+	      else if(dspP.vtX > tBox.xMax)
+	      {
+		tBox.xMax = dspP.vtX;
+	      }
+	      if(dspP.vtY < tBox.yMin)
+	      {
+		tBox.yMin = dspP.vtY;
+	      }
+	      else if(dspP.vtY > tBox.yMax)
+	      {
+		tBox.yMax = dspP.vtY;
+	      }
+	      if(dspP.vtZ < tBox.zMin)
+	      {
+		tBox.zMin = dspP.vtZ;
+	      }
+	      else if(dspP.vtZ > tBox.zMax)
+	      {
+		tBox.zMax = dspP.vtZ;
+	      }
 	    }
 	  }
+	  errNum2 = WlzCMeshTetElmItv3D(itvVec, &thrIdI, pElm->idx, dspPos);
+	}
+      }
+      thrItvVec[thrId] = itvVec;
+      thrItvCnt[thrId] = thrIdI;
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshScanWSpInit3D)
+#endif
+      {
+        if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+	if(fstNod == 0)
+	{
+	  if(fstBox)
+	  {
+	    dBox = tBox;
+	    fstBox = 0;
+	  }
+	  else
+	  {
+	    dBox.xMin = WLZ_MIN(dBox.xMin, tBox.xMin);
+	    dBox.yMin = WLZ_MIN(dBox.yMin, tBox.yMin);
+	    dBox.zMin = WLZ_MIN(dBox.zMin, tBox.zMin);
+	    dBox.xMax = WLZ_MAX(dBox.xMax, tBox.xMax);
+	    dBox.yMax = WLZ_MAX(dBox.yMax, tBox.yMax);
+	    dBox.zMax = WLZ_MAX(dBox.zMax, tBox.zMax);
+	  }
 	}
-	errNum = WlzCMeshTetElmItv3D(itvVec, &idI, elm->idx, dspPos);
       }
-      ++idE;
     }
   }
   /* Create a mesh scan workspace using the collected intervals. */
   if(errNum == WLZ_ERR_NONE)
   {
-    mSWSp = WlzCMeshMakeScanWSp3D(mObj, idI, &errNum);
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      nItv += thrItvCnt[idT];
+    }
+    mSWSp = WlzCMeshMakeScanWSp3D(mObj, nItv, &errNum);
   }
-  /* Copy the mesh scan intervals and sort them by plane, then line and
-   * then column and then squeeze out the redundant intervals. */
   if(errNum == WLZ_ERR_NONE)
   {
     mSWSp->dBox.xMin = WLZ_CMESH_POS_DTOI(dBox.xMin) - 1;
@@ -4897,13 +5015,58 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
     mSWSp->dBox.xMax = WLZ_CMESH_POS_DTOI(dBox.xMax) + 1;
     mSWSp->dBox.yMax = WLZ_CMESH_POS_DTOI(dBox.yMax) + 1;
     mSWSp->dBox.zMax = WLZ_CMESH_POS_DTOI(dBox.zMax) + 1;
-    for(idI = 0; idI < mSWSp->nItvs; ++idI)
+    nPln = mSWSp->dBox.zMax - mSWSp->dBox.zMin + 1;
+    if(((mSWSp->plnItv = (int *)AlcCalloc(nPln + 1, sizeof(int))) == NULL) ||
+       ((plnPos = (int *)AlcMalloc(nPln * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Copy the mesh scan intervals binning them by plane, sort the intervals
+   * of each plane by line and then column and then squeeze out the
+   * redundant intervals. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+    {
+      for(idI = 0; idI < thrItvCnt[idT]; ++idI)
+      {
+	itv = (WlzCMeshScanItv3D *)AlcVectorItemGet(thrItvVec[idT], idI);
+	idP = itv->plane - mSWSp->dBox.zMin;
+	if((idP < 0) || (idP >= nPln))
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	  break;
+	}
+	++*(mSWSp->plnItv + idP + 1);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idP = 0; idP < nPln; ++idP)
     {
-      *(mSWSp->itvs + idI) = *(WlzCMeshScanItv3D *)
-                             AlcVectorItemGet(itvVec, idI);
+      *(mSWSp->plnItv + idP + 1) += *(mSWSp->plnItv + idP);
+      *(plnPos + idP) = *(mSWSp->plnItv + idP);
+    }
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      for(idI = 0; idI < thrItvCnt[idT]; ++idI)
+      {
+	itv = (WlzCMeshScanItv3D *)AlcVectorItemGet(thrItvVec[idT], idI);
+	idP = itv->plane - mSWSp->dBox.zMin;
+	*(mSWSp->itvs + (*(plnPos + idP))++) = *itv;
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPln; ++idP)
+    {
+      qsort(mSWSp->itvs + *(mSWSp->plnItv + idP),
+	    *(mSWSp->plnItv + idP + 1) - *(mSWSp->plnItv + idP),
+	    sizeof(WlzCMeshScanItv3D), WlzCMeshItv3Cmp);
     }
-    qsort(mSWSp->itvs, mSWSp->nItvs, sizeof(WlzCMeshScanItv3D),
-          WlzCMeshItv3Cmp);
     for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
     {
       elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, (size_t )idE);
@@ -4922,6 +5085,18 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
     }
 #endif
     WlzCMeshSqzRedundantItv3D(mSWSp);
+    /* Index the first of the remaining intervals in each plane. */
+    idI = 0;
+    for(idP = 0; idP < nPln; ++idP)
+    {
+      *(mSWSp->plnItv + idP) = idI;
+      while((idI < mSWSp->nItvs) &&
+            ((mSWSp->itvs + idI)->plane - mSWSp->dBox.zMin == idP))
+      {
+        ++idI;
+      }
+    }
+    *(mSWSp->plnItv + nPln) = mSWSp->nItvs;
 #ifdef WLZ_CMESHTRANSFORM_DEBUG
     for(idI = 0; idI < mSWSp->nItvs; ++idI)
     {
@@ -4933,7 +5108,16 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
     }
 #endif
   }
-  AlcVectorFree(itvVec);
+  if(thrItvVec)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      (void )AlcVectorFree(thrItvVec[idT]);
+    }
+    AlcFree(thrItvVec);
+  }
+  AlcFree(thrItvCnt);
+  AlcFree(plnPos);
   if(errNum != WLZ_ERR_NONE)
   {
     WlzCMeshScanWSpFree3D(mSWSp);
@@ -4986,7 +5170,7 @@ static void	WlzCMeshSqzRedundantItv3D(WlzCMeshScanWSp3D *mSWSp)
     ++itv1;
     ++idx1;
   }
-  mSWSp->nItvs = idx0 + 1;
+  mSWSp->nItvs = (mSWSp->nItvs > 0)? idx0 + 1: 0;
 #ifdef WLZ_CMESHTRANSFORM_DEBUG
   (void )fprintf(stderr, "WlzCMeshSqzRedundantItv3D(X) nItvs = %d\n",
   		 mSWSp->nItvs);
@@ -5070,6 +5254,7 @@ static void	WlzCMeshScanWSpFree3D(WlzCMeshScanWSp3D *mSWSp)
 {
   if(mSWSp)
   {
+    AlcFree(mSWSp->plnItv);
     if(mSWSp->itvs)
     {
       AlcFree(mSWSp->itvs);
@@ -5735,7 +5920,10 @@ static int	WlzCMeshItv2Cmp(const void *cmp0, const void *cmp1)
 * \return	Sorting value for qsort.
 * \ingroup	WlzTransform
 * \brief	Callback function for qsort(3) to sort 3D conforming mesh
-*		element intervals by plane, line and then left column.
+*		element intervals by plane, line, left column, right
+*		column and then element index. Sorting by element index
+*		makes the order independent of the order in which the
+*		intervals were collected.
 * \param	cmp0			Used to pass first mesh interval.
 * \param	cmp1			Used to pass second mesh interval.
 */
@@ -5753,7 +5941,10 @@ static int	WlzCMeshItv3Cmp(const void *cmp0, const void *cmp1)
     {
       if((rtn = itv0->lftI - itv1->lftI) == 0)
       {
-	rtn = itv0->rgtI - itv1->rgtI;
+	if((rtn = itv0->rgtI - itv1->rgtI) == 0)
+	{
+	  rtn = itv0->elmIdx - itv1->elmIdx;
+	}
       }
     }
   }
@@ -5782,8 +5973,10 @@ WlzObject 	*WlzCMeshTransformObj(WlzObject *srcObj,
   		dstValues;
   WlzIndexedValues *mIxv;
   WlzObject	*dstObj = NULL;
+  WlzPerfScope	perfScope;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
  
+  WLZ_PERF_BEGIN(perfScope, "WlzCMeshTransformObj");
   dstDom.core = NULL;
   dstValues.core = NULL;
   srcValues.core = NULL;
@@ -6087,6 +6280,7 @@ WlzObject 	*WlzCMeshTransformObj(WlzObject *srcObj,
   {
     *dstErr = errNum;
   }
+  WLZ_PERF_END(perfScope);
   return(dstObj);
 }
 
@@ -7117,23 +7311,12 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
 					   WlzCMeshScanWSp3D *mSWSp,
 					   WlzErrorNum *dstErr) 
 {
-  int		idI,
-		kol,
-		itvLnCnt = 0,
-		itvPlCnt = 0,
+  int		idP,
+		nPln,
 		itvLnWidth,
 		itvLnByteWidth;
-  WlzIVertex3	dPos,
-		sPos;
-  WlzDVertex3	tV;
-  WlzDynItvPool	itvPool;
-  WlzCMeshScanItv3D *curItv = NULL,
-  		*prvItv = NULL;
   WlzObjectType	dstObjType;
-  WlzCMeshScanElm3D *sE;
-  WlzUByte	*lnMsk = NULL;
-  WlzDomain	dom2,
-  		dom3;
+  WlzDomain	dom3;
   WlzValues	nullVal;
   WlzObject	*dstObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -7141,11 +7324,8 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
   				     allocated in a single block. It is a
 				     tuning parameter, see use below. */
 
-  dom2.core = NULL;
   dom3.core = NULL;
   nullVal.core = NULL;
-  itvPool.offset = 0;
-  itvPool.itvBlock = NULL;
   if(mSWSp->nItvs < 1)
   {
     dstObj = WlzMakeEmpty(&errNum);
@@ -7155,10 +7335,7 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
     dstObjType = (srcObj == NULL)? WLZ_3D_DOMAINOBJ: srcObj->type;
     itvLnWidth = mSWSp->dBox.xMax - mSWSp->dBox.xMin + 1;
     itvLnByteWidth = (itvLnWidth + 7) / 8;
-    /* Initialize a dynamic interval pool. Any size greater than the maximum
-     * number of intervals per line will do, but for efficiency it shouldn't
-     * be too small as this will cause loads of memory allocations. */
-    itvPool.itvsInBlock = (itvLnWidth < minDynItv)? minDynItv: itvLnWidth;
+    nPln = mSWSp->dBox.zMax - mSWSp->dBox.zMin + 1;
     /* Create a new plane domain using the bounding box of the displaced
      * mesh. This is corrected latter. */
     dom3.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
@@ -7168,83 +7345,114 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
 				&errNum);
     if(errNum == WLZ_ERR_NONE)
     {
-      if(AlcBit1Calloc(&lnMsk, itvLnWidth) != ALC_ER_NONE)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-    }
-    if(errNum == WLZ_ERR_NONE)
-    {
-      idI = 0;
-      itvLnCnt = 0;
-      itvPlCnt = 0;
-      itvPool.offset = 0;
-      itvPool.itvBlock = NULL;
-      prvItv = NULL;
-      curItv = mSWSp->itvs;
-    }
-    while((errNum == WLZ_ERR_NONE) && (idI < mSWSp->nItvs))
-    {
-      sE = mSWSp->dElm + curItv->elmIdx;
-      if(dom2.core == NULL)
-      {
-	dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
-				       mSWSp->dBox.yMin, mSWSp->dBox.yMax,
-				       mSWSp->dBox.xMin, mSWSp->dBox.xMax,
-				       &errNum);
-      }
-      dPos.vtY = curItv->line;
-      dPos.vtZ = curItv->plane;
-      for(kol = curItv->lftI; kol <= curItv->rgtI; ++kol)
-      {
-        dPos.vtX = kol;
-	if((sE->flags & WLZ_CMESH_SCANELM_REV) == 0)
-	{
-	  WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
-	}
-	tV.vtX = (sE->tr[ 0] * dPos.vtX) + (sE->tr[ 1] * dPos.vtY) +
-		 (sE->tr[ 2] * dPos.vtZ) +  sE->tr[ 3];
-	tV.vtY = (sE->tr[ 4] * dPos.vtX) + (sE->tr[ 5] * dPos.vtY) +
-		 (sE->tr[ 6] * dPos.vtZ) +  sE->tr[ 7];
-	tV.vtZ = (sE->tr[ 8] * dPos.vtX) + (sE->tr[ 9] * dPos.vtY) +
-		 (sE->tr[10] * dPos.vtZ) +  sE->tr[11];
-	sPos.vtX = WLZ_CMESH_POS_DTOI(tV.vtX);
-	sPos.vtY = WLZ_CMESH_POS_DTOI(tV.vtY);
-	sPos.vtZ = WLZ_CMESH_POS_DTOI(tV.vtZ);
-	if((srcObj == NULL) ||
-	   (WlzInsideDomain(srcObj, sPos.vtZ, sPos.vtY, sPos.vtX, NULL) != 0))
-	{
-	  ++itvLnCnt;
-	  WlzBitLnSetItv(lnMsk,
-	                 kol - mSWSp->dBox.xMin, kol - mSWSp->dBox.xMin,
-			 itvLnWidth);
-	}
-      }
-      prvItv = curItv;
-      ++idI;
-      ++curItv;
-      if((errNum == WLZ_ERR_NONE) &&
-         (itvLnCnt > 0) &&
-	 ((curItv->plane != prvItv->plane) || (curItv->line != prvItv->line)))
-      {
-	/* Add previous line to interval domain. */
-	errNum = WlzDynItvLnFromBitLn(dom2.i, lnMsk, prvItv->line, itvLnWidth,
-	                              &itvPool);
-	memset(lnMsk, 0, itvLnByteWidth);
-	itvPlCnt += itvLnCnt;
-	itvLnCnt = 0;
-      }
-      if((errNum == WLZ_ERR_NONE) &&
-         (itvPlCnt > 0) &&
-	 (curItv->plane != prvItv->plane))
+      /* Compute all element transforms so that the planes can be scanned
+       * concurrently, each plane having its own interval domain, interval
+       * pool and line mask. */
+      WlzCMeshUpdateScanElms3D(mSWSp);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idP = 0; idP < nPln; ++idP)
       {
-        /* Add previous plane to plane domain. */
-	*(dom3.p->domains + prvItv->plane - dom3.p->plane1) =
-				 WlzAssignDomain(dom2, NULL);
-        itvPlCnt = 0;
+	int	kol,
+		itvLnCnt = 0,
+		itvPlCnt = 0;
+	WlzIVertex3 dPos,
+		sPos;
+	WlzDVertex3 tV;
+	WlzDynItvPool itvPool;
+	WlzCMeshScanItv3D *curItv,
+		*lstItv;
+	WlzCMeshScanElm3D *sE;
+	WlzUByte *lnMsk = NULL;
+	WlzDomain dom2;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	if((errNum != WLZ_ERR_NONE) ||
+	   (*(mSWSp->plnItv + idP) >= *(mSWSp->plnItv + idP + 1)))
+	{
+	  continue;
+	}
+	dom2.core = NULL;
+	/* Initialize a dynamic interval pool. Any size greater than the
+	 * maximum number of intervals per line will do, but for efficiency
+	 * it shouldn't be too small as this will cause loads of memory
+	 * allocations. */
 	itvPool.offset = 0;
 	itvPool.itvBlock = NULL;
-        dom2.core = NULL;
+	itvPool.itvsInBlock = (itvLnWidth < minDynItv)? minDynItv: itvLnWidth;
+	if(AlcBit1Calloc(&lnMsk, itvLnWidth) != ALC_ER_NONE)
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+					 mSWSp->dBox.yMin, mSWSp->dBox.yMax,
+					 mSWSp->dBox.xMin, mSWSp->dBox.xMax,
+					 &errNum2);
+	}
+	curItv = mSWSp->itvs + *(mSWSp->plnItv + idP);
+	lstItv = mSWSp->itvs + *(mSWSp->plnItv + idP + 1) - 1;
+	while((errNum2 == WLZ_ERR_NONE) && (curItv <= lstItv))
+	{
+	  sE = mSWSp->dElm + curItv->elmIdx;
+	  dPos.vtY = curItv->line;
+	  dPos.vtZ = curItv->plane;
+	  for(kol = curItv->lftI; kol <= curItv->rgtI; ++kol)
+	  {
+	    dPos.vtX = kol;
+	    tV.vtX = (sE->tr[ 0] * dPos.vtX) + (sE->tr[ 1] * dPos.vtY) +
+		     (sE->tr[ 2] * dPos.vtZ) +  sE->tr[ 3];
+	    tV.vtY = (sE->tr[ 4] * dPos.vtX) + (sE->tr[ 5] * dPos.vtY) +
+		     (sE->tr[ 6] * dPos.vtZ) +  sE->tr[ 7];
+	    tV.vtZ = (sE->tr[ 8] * dPos.vtX) + (sE->tr[ 9] * dPos.vtY) +
+		     (sE->tr[10] * dPos.vtZ) +  sE->tr[11];
+	    sPos.vtX = WLZ_CMESH_POS_DTOI(tV.vtX);
+	    sPos.vtY = WLZ_CMESH_POS_DTOI(tV.vtY);
+	    sPos.vtZ = WLZ_CMESH_POS_DTOI(tV.vtZ);
+	    if((srcObj == NULL) ||
+	       (WlzInsideDomain(srcObj, sPos.vtZ, sPos.vtY, sPos.vtX,
+	                        NULL) != 0))
+	    {
+	      ++itvLnCnt;
+	      WlzBitLnSetItv(lnMsk,
+			     kol - mSWSp->dBox.xMin, kol - mSWSp->dBox.xMin,
+			     itvLnWidth);
+	    }
+	  }
+	  if((itvLnCnt > 0) &&
+	     ((curItv == lstItv) || ((curItv + 1)->line != curItv->line)))
+	  {
+	    /* Add line to interval domain. */
+	    errNum2 = WlzDynItvLnFromBitLn(dom2.i, lnMsk, curItv->line,
+	                                   itvLnWidth, &itvPool);
+	    memset(lnMsk, 0, itvLnByteWidth);
+	    itvPlCnt += itvLnCnt;
+	    itvLnCnt = 0;
+	  }
+	  ++curItv;
+	}
+	if((errNum2 == WLZ_ERR_NONE) && (itvPlCnt > 0))
+	{
+	  /* Add plane to plane domain. */
+	  *(dom3.p->domains + idP) = WlzAssignDomain(dom2, NULL);
+	  dom2.core = NULL;
+	}
+	AlcFree(lnMsk);
+	(void )WlzFreeDomain(dom2);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshScanObjPDomain3D)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
       }
     }
     if(errNum == WLZ_ERR_NONE)
@@ -7265,9 +7473,6 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
       dstObj = WlzMakeMain(dstObjType, dom3, nullVal, NULL, NULL, &errNum);
     }
   }
-  /* Clear up. */
-  AlcFree(lnMsk);
-  (void )WlzFreeDomain(dom2);
   /* Clear up on error. */
   if(errNum != WLZ_ERR_NONE)
   {
@@ -7299,23 +7504,126 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 					WlzInterpolationType interp)
 {
   int		idP,
-  		idI,
+		nPln,
+		bufWidth;
+  WlzGreyType	gType;
+  WlzPixelV	bgdV;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
+
+  bgdV = WlzGetBackground(srcObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTypeFromObj(srcObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bufWidth = dstObj->domain.p->lastkl - dstObj->domain.p->kol1 + 1;
+    nPln = dstObj->domain.p->lastpl - dstObj->domain.p->plane1 + 1;
+    /* Compute all element transforms so that the planes can be filled
+     * concurrently, with each thread having its own grey value workspace
+     * and overlap buffers. */
+    WlzCMeshUpdateScanElms3D(mSWSp);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	*olpCnt = NULL;
+      WlzGreyP	olpBuf;
+      WlzGreyValueWSpace *gVWSp = NULL;
+      WlzErrorNum errNum2;
+
+      olpBuf.inp = NULL;
+      errNum2 = WlzCMeshScanMakeOlpBufs(dstObj, gType,
+                                        &olpBuf, &olpCnt, bufWidth);
+      if(errNum2 == WLZ_ERR_NONE)
+      {
+	gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum2);
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(idP = 0; idP < nPln; ++idP)
+      {
+        if((errNum2 == WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum2 = WlzCMeshScanObjValuesPln3D(dstObj, mSWSp, interp, idP,
+					       gType, bgdV, gVWSp,
+					       olpBuf, olpCnt, bufWidth);
+	}
+      }
+      AlcFree(olpBuf.inp);
+      AlcFree(olpCnt);
+      WlzGreyValueFreeWSp(gVWSp);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshScanObjValues3D)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Fills in the values of a single plane of the destination
+*		object for WlzCMeshScanObjValues3D(). Planes may be
+*		filled concurrently provided that the element transforms
+*		have already been computed and that each thread has its
+*		own grey value workspace and overlap buffers.
+* \param	dstObj			Destination object with values to be
+*					set.
+* \param	mSWSp			Mesh scan workspace which was used to
+*					compute the destination object's
+*					domain.
+* \param	interp			Interpolation type.
+* \param	idP			Index of the plane in the destination
+*					object's plane domain.
+* \param	gType			Grey type of the source object.
+* \param	bgdV			Background value of the source object.
+* \param	gVWSp			Grey value workspace for the source
+*					object.
+* \param	olpBuf			Overlap buffer.
+* \param	olpCnt			Overlap count buffer.
+* \param	bufWidth		Width of the overlap buffers.
+*/
+static WlzErrorNum WlzCMeshScanObjValuesPln3D(WlzObject *dstObj,
+					WlzCMeshScanWSp3D *mSWSp,
+					WlzInterpolationType interp,
+					int idP,
+					WlzGreyType gType,
+					WlzPixelV bgdV,
+					WlzGreyValueWSpace *gVWSp,
+					WlzGreyP olpBuf,
+					int *olpCnt,
+					int bufWidth)
+{
+  int		idI,
   		iLft,
 		iRgt,
+		mPlnIdx,
 		mItvIdx0,
   		mItvIdx1,
-		bufWidth,
+		mItvEnd,
   		itvWidth;
   double	tD0,
   		tD1,
 		tD2,
 		tD3,
 		tD4;
-  int		*olpCnt = NULL;
-  WlzGreyP	dGP,
-  		olpBuf;
-  WlzGreyType	gType;
-  WlzPixelV	bgdV;
+  WlzGreyP	dGP;
   WlzIVertex3	dPos,
   		sPos;
   WlzDVertex3	tV,
@@ -7324,160 +7632,301 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
   WlzCMeshScanItv3D *mItv0,
   		*mItv1,
 		*mItv2;
-  WlzDomain	dom2,
-  		dom3;
-  WlzValues	val3;
+  WlzDomain	dom2;
   WlzObject	*obj2 = NULL;
   WlzGreyWSpace gWSp;
   WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
-  olpBuf.inp = NULL;
-  bgdV = WlzGetBackground(srcObj, &errNum);
-  if(errNum == WLZ_ERR_NONE)
-  {
-    gType = WlzGreyTypeFromObj(srcObj, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bufWidth = dstObj->domain.p->lastkl - dstObj->domain.p->kol1 + 1;
-    errNum = WlzCMeshScanMakeOlpBufs(dstObj, gType,
-                                     &olpBuf, &olpCnt, bufWidth);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    mItvIdx0 = 0;
-    mItv0 = mSWSp->itvs;
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    idP = 0;
-    dom3.p = dstObj->domain.p;
-    val3.vox = dstObj->values.vox;
-    dPos.vtZ = dom3.p->plane1;
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ < dom3.p->lastpl))
+  dPos.vtZ = dstObj->domain.p->plane1 + idP;
+  mPlnIdx = dPos.vtZ - mSWSp->dBox.zMin;
+  dom2 = *(dstObj->domain.p->domains + idP);
+  if((dom2.core != NULL) && (dom2.core->type != WLZ_EMPTY_DOMAIN) &&
+     (mPlnIdx >= 0) && (mPlnIdx <= mSWSp->dBox.zMax - mSWSp->dBox.zMin))
+  {
+    /* Only the mesh intervals of this plane are searched. */
+    mItvIdx0 = *(mSWSp->plnItv + mPlnIdx);
+    mItvEnd = *(mSWSp->plnItv + mPlnIdx + 1);
+    mItv0 = mSWSp->itvs + mItvIdx0;
+    obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2,
+		       *(dstObj->values.vox->values + idP),
+		       NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
     {
-      if(((dom2 = *(dom3.p->domains + idP)).core != NULL) &&
-         (dom2.core->type != WLZ_EMPTY_DOMAIN))
+      errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum == WLZ_ERR_NONE) &&
+	    ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
       {
-	(void )WlzFreeObj(obj2);
-        obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	                      *(dom3.p->domains + idP),
-			      *(val3.vox->values + idP),
-			      NULL, NULL, &errNum);
-        if(errNum == WLZ_ERR_NONE)
+	itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
+	WlzCMeshScanClearOlpBuf(olpBuf, olpCnt, gType, bufWidth, itvWidth);
+	dGP = gWSp.u_grintptr;
+	/* Update the mesh interval pointer so that it points to the
+	 * first mesh interval on the which intersects the current grey
+	 * interval. */
+	while((mItvIdx0 < mItvEnd) && (mItv0->line < iWSp.linpos))
 	{
-	  errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	  ++mItvIdx0;
+	  ++mItv0;
 	}
-	while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
-        {
-          itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
-	  WlzCMeshScanClearOlpBuf(olpBuf, olpCnt, gType, bufWidth, itvWidth);
-	  dGP = gWSp.u_grintptr;
-	  /* Update the mesh interval pointer so that it points to the
-	   * first mesh interval on the which intersects the current grey
-	   * interval. */
-	  while((mItv0->plane < dPos.vtZ) && (mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  while((mItv0->line <= iWSp.linpos) &&
-		(mItv0->rgtI < iWSp.lftpos) &&
-		(mItvIdx0 < mSWSp->nItvs))
+	while((mItvIdx0 < mItvEnd) &&
+	      (mItv0->line <= iWSp.linpos) &&
+	      (mItv0->rgtI < iWSp.lftpos))
+	{
+	  ++mItvIdx0;
+	  ++mItv0;
+	}
+	if((mItvIdx0 < mItvEnd) &&
+	   (mItv0->line == iWSp.linpos) &&
+	   (iWSp.lftpos <= mItv0->rgtI) &&
+	   (iWSp.rgtpos >= mItv0->lftI))
+	{
+	  /* Mesh interval mItv0 intersects the current grey interval find
+	   * the last mesh interval mItv1 which also intersects the current
+	   * grey interval. */
+	  mItv1 = mItv0;
+	  mItvIdx1 = mItvIdx0;
+	  while((mItvIdx1 < mItvEnd) &&
+		(mItv1->line == iWSp.linpos) &&
+		(mItv1->lftI <= iWSp.rgtpos))
 	  {
-	    ++mItvIdx0;
-	    ++mItv0;
+	    ++mItvIdx1;
+	    ++mItv1;
 	  }
-	  if((mItv0->line == iWSp.linpos) &&
-	     (iWSp.lftpos <= mItv0->rgtI) &&
-	     (iWSp.rgtpos >= mItv0->lftI))
+	  mItv2 = mItv1 - 1;
+	  mItv1 = mItv0;
+	  dPos.vtY = mItv0->line;
+	  /* For each mesh interval which intersects the current grey
+	     interval. */
+	  while(mItv1 <= mItv2)
 	  {
-	    /* Mesh interval mItv0 intersects the current grey interval find
-	     * the last mesh interval mItv1 which also intersects the current
-	     * grey interval. */
-	    mItv1 = mItv0;
-	    mItvIdx1 = mItvIdx0;
-	    while((mItv1->line == iWSp.linpos) &&
-		  (mItv1->lftI <= iWSp.rgtpos) &&
-		  (mItvIdx1 < mSWSp->nItvs))
-	    {
-	      ++mItvIdx1;
-	      ++mItv1;
-	    }
-	    mItv2 = mItv1 - 1;
-	    mItv1 = mItv0;
-	    dPos.vtY = mItv0->line;
-	    /* For each mesh interval which intersects the current grey
-	       interval. */
-	    while(mItv1 <= mItv2)
-	    {
 #ifdef WLZ_CMESHTRANSFORM_DEBUG
-      (void )fprintf(stderr,
-      		     "WlzCMeshScanObjValues3D %d %d %d %d %d\n",
-		     mItv1->elmIdx,
-		     mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
+    (void )fprintf(stderr,
+		   "WlzCMeshScanObjValues3D %d %d %d %d %d\n",
+		   mItv1->elmIdx,
+		   mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
 #endif
-	      /* Update mesh scanning. */
-	      sE = mSWSp->dElm + mItv1->elmIdx;
-	      if((sE->flags & WLZ_CMESH_SCANELM_REV) == 0)
-	      {
-	         WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
-	      }
-	      tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
-		       sE->tr[ 3];
-	      tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
-		       sE->tr[ 7];
-	      tV.vtZ = (sE->tr[ 9] * dPos.vtY) + (sE->tr[10] * dPos.vtZ) +
-		       sE->tr[11];
-	      /* Find length of intersection and set the grey pointer. */
-	      iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
-	      iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
-	      dPos.vtX = iLft;
-	      switch(interp)
-	      {
-		case WLZ_INTERPOLATION_NEAREST:
-		  switch(gType)
-		  {
-		    case WLZ_GREY_INT:
-		      while(dPos.vtX <= iRgt)
+	    /* Update mesh scanning. */
+	    sE = mSWSp->dElm + mItv1->elmIdx;
+	    tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
+		     sE->tr[ 3];
+	    tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
+		     sE->tr[ 7];
+	    tV.vtZ = (sE->tr[ 9] * dPos.vtY) + (sE->tr[10] * dPos.vtZ) +
+		     sE->tr[11];
+	    /* Find length of intersection and set the grey pointer. */
+	    iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
+	    iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
+	    dPos.vtX = iLft;
+	    switch(interp)
+	    {
+	      case WLZ_INTERPOLATION_NEAREST:
+		switch(gType)
+		{
+		  case WLZ_GREY_INT:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			idI = dPos.vtX - iWSp.lftpos;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
+		      }
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_SHORT:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
+		      }
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_UBYTE:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			idI = dPos.vtX - iWSp.lftpos;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
+		      }
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_FLOAT:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			idI = dPos.vtX - iWSp.lftpos;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
+		      }
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_DOUBLE:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			idI = dPos.vtX - iWSp.lftpos;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
+		      }
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_RGBA:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			idI = dPos.vtX - iWSp.lftpos;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += WLZ_RGBA_RED_GET(
+					       gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + bufWidth + idI) +=
+			    WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + (2 * bufWidth) + idI) +=
+			    WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + (3 * bufWidth) + idI) +=
+			    WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
+		      }
+		      ++dPos.vtX;
+		    }
+		    break;
+		  default:
+		    errNum = WLZ_ERR_GREY_TYPE;
+		    break;
+		}
+		break;
+	      case WLZ_INTERPOLATION_LINEAR:
+		switch(gType)
+		{
+		  case WLZ_GREY_INT:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+					 sPosD.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			tD0 = sPosD.vtX - floor(sPosD.vtX);
+			tD1 = sPosD.vtY - floor(sPosD.vtY);
+			tD2 = 1.0 - tD0;
+			tD3 = 1.0 - tD1;
+			tD0 = ((gVWSp->gVal[0]).inv * tD2 * tD3) +
+			      ((gVWSp->gVal[1]).inv * tD0 * tD3) +
+			      ((gVWSp->gVal[2]).inv * tD2 * tD1) +
+			      ((gVWSp->gVal[3]).inv * tD0 * tD1);
+			tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+			idI = dPos.vtX - iWSp.lftpos;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		      }
+		      else
+		      {
 			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
 			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
 			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+					sPos.vtX);
 			if(gVWSp->bkdFlag == 0)
 			{
 			  idI = dPos.vtX - iWSp.lftpos;
 			  ++*(olpCnt + idI);
 			  *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
 			}
-			++dPos.vtX;
 		      }
-		      break;
-		    case WLZ_GREY_SHORT:
-		      while(dPos.vtX <= iRgt)
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_SHORT:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+					 sPosD.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
+			tD0 = sPosD.vtX - floor(sPosD.vtX);
+			tD1 = sPosD.vtY - floor(sPosD.vtY);
+			tD2 = 1.0 - tD0;
+			tD3 = 1.0 - tD1;
+			tD0 = ((gVWSp->gVal[0]).shv * tD2 * tD3) +
+			      ((gVWSp->gVal[1]).shv * tD0 * tD3) +
+			      ((gVWSp->gVal[2]).shv * tD2 * tD1) +
+			      ((gVWSp->gVal[3]).shv * tD0 * tD1);
+			tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		      }
+		      else
+		      {
 			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
 			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
 			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
@@ -7488,426 +7937,246 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 			  ++*(olpCnt + idI);
 			  *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
 			}
-			++dPos.vtX;
 		      }
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      while(dPos.vtX <= iRgt)
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_UBYTE:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+					 sPosD.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
+			tD0 = sPosD.vtX - floor(sPosD.vtX);
+			tD1 = sPosD.vtY - floor(sPosD.vtY);
+			tD2 = 1.0 - tD0;
+			tD3 = 1.0 - tD1;
+			tD0 = ((gVWSp->gVal[0]).ubv * tD2 * tD3) +
+			      ((gVWSp->gVal[1]).ubv * tD0 * tD3) +
+			      ((gVWSp->gVal[2]).ubv * tD2 * tD1) +
+			      ((gVWSp->gVal[3]).ubv * tD0 * tD1);
+			tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		      }
+		      else
+		      {
 			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
 			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
 			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+					sPos.vtX);
 			if(gVWSp->bkdFlag == 0)
 			{
 			  idI = dPos.vtX - iWSp.lftpos;
 			  ++*(olpCnt + idI);
 			  *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
 			}
-			++dPos.vtX;
 		      }
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      while(dPos.vtX <= iRgt)
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_FLOAT:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+					 sPosD.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
+			tD0 = sPosD.vtX - floor(sPosD.vtX);
+			tD1 = sPosD.vtY - floor(sPosD.vtY);
+			tD2 = 1.0 - tD0;
+			tD3 = 1.0 - tD1;
+			tD0 = ((gVWSp->gVal[0]).flv * tD2 * tD3) +
+			      ((gVWSp->gVal[1]).flv * tD0 * tD3) +
+			      ((gVWSp->gVal[2]).flv * tD2 * tD1) +
+			      ((gVWSp->gVal[3]).flv * tD0 * tD1);
+			tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += tD0;
+		      }
+		      else
+		      {
 			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
 			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
 			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+					sPos.vtX);
 			if(gVWSp->bkdFlag == 0)
 			{
 			  idI = dPos.vtX - iWSp.lftpos;
 			  ++*(olpCnt + idI);
 			  *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
 			}
-			++dPos.vtX;
 		      }
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      while(dPos.vtX <= iRgt)
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_DOUBLE:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+					 sPosD.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
+			tD0 = sPosD.vtX - floor(sPosD.vtX);
+			tD1 = sPosD.vtY - floor(sPosD.vtY);
+			tD2 = 1.0 - tD0;
+			tD3 = 1.0 - tD1;
+			tD0 = ((gVWSp->gVal[0]).dbv * tD2 * tD3) +
+			      ((gVWSp->gVal[1]).dbv * tD0 * tD3) +
+			      ((gVWSp->gVal[2]).dbv * tD2 * tD1) +
+			      ((gVWSp->gVal[3]).dbv * tD0 * tD1);
+			tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += tD0;
+		      }
+		      else
+		      {
 			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
 			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
 			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+					sPos.vtX);
 			if(gVWSp->bkdFlag == 0)
 			{
 			  idI = dPos.vtX - iWSp.lftpos;
 			  ++*(olpCnt + idI);
 			  *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
 			}
-			++dPos.vtX;
 		      }
-		      break;
-		    case WLZ_GREY_RGBA:
-		      while(dPos.vtX <= iRgt)
+		      ++dPos.vtX;
+		    }
+		    break;
+		  case WLZ_GREY_RGBA:
+		    while(dPos.vtX <= iRgt)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		      sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		      sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		      WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+					 sPosD.vtX);
+		      if(gVWSp->bkdFlag == 0)
+		      {
+			tD0 = sPosD.vtX - floor(sPosD.vtX);
+			tD1 = sPosD.vtY - floor(sPosD.vtY);
+			tD2 = 1.0 - tD0;
+			tD3 = 1.0 - tD1;
+			tD4 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
+			       tD2 * tD3) +
+			      (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
+			       tD0 * tD3) +
+			      (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
+			       tD2 * tD1) +
+			      (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
+			       tD0 * tD1);
+			tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += WLZ_NINT(tD4);
+			tD4 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
+			       tD2 * tD3) +
+			      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
+			       tD0 * tD3) +
+			      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
+			       tD2 * tD1) +
+			      (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
+			       tD0 * tD1);
+			tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+			*(olpBuf.inp + bufWidth + idI) += WLZ_NINT(tD4);
+			tD4 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
+			       tD2 * tD3) +
+			      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
+			       tD0 * tD3) +
+			      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
+			       tD2 * tD1) +
+			      (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
+			       tD0 * tD1);
+			tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+			*(olpBuf.inp + (2 * bufWidth) + idI) +=
+			    WLZ_NINT(tD4);
+			tD4 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
+			       tD2 * tD3) +
+			      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
+			       tD0 * tD3) +
+			      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
+			       tD2 * tD1) +
+			      (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
+			       tD0 * tD1);
+			tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+			*(olpBuf.inp + (3 * bufWidth) + idI) +=
+			    WLZ_NINT(tD4);
+		      }
+		      else
 		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
 			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
 			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
 			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+					sPos.vtX);
 			if(gVWSp->bkdFlag == 0)
 			{
 			  idI = dPos.vtX - iWSp.lftpos;
 			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_RGBA_RED_GET(
-						 gVWSp->gVal[0].rgbv);
+			  *(olpBuf.inp + idI) +=
+				    WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
 			  *(olpBuf.inp + bufWidth + idI) +=
-			      WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + (2 * bufWidth) + idI) +=
-			      WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + (3 * bufWidth) + idI) +=
-			      WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  break;
-		case WLZ_INTERPOLATION_LINEAR:
-		  switch(gType)
-		  {
-		    case WLZ_GREY_INT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).inv * tD2 * tD3) +
-				((gVWSp->gVal[1]).inv * tD0 * tD3) +
-				((gVWSp->gVal[2]).inv * tD2 * tD1) +
-				((gVWSp->gVal[3]).inv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_SHORT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).shv * tD2 * tD3) +
-				((gVWSp->gVal[1]).shv * tD0 * tD3) +
-				((gVWSp->gVal[2]).shv * tD2 * tD1) +
-				((gVWSp->gVal[3]).shv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).ubv * tD2 * tD3) +
-				((gVWSp->gVal[1]).ubv * tD0 * tD3) +
-				((gVWSp->gVal[2]).ubv * tD2 * tD1) +
-				((gVWSp->gVal[3]).ubv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).flv * tD2 * tD3) +
-				((gVWSp->gVal[1]).flv * tD0 * tD3) +
-				((gVWSp->gVal[2]).flv * tD2 * tD1) +
-				((gVWSp->gVal[3]).flv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += tD0;
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).dbv * tD2 * tD3) +
-				((gVWSp->gVal[1]).dbv * tD0 * tD3) +
-				((gVWSp->gVal[2]).dbv * tD2 * tD1) +
-				((gVWSp->gVal[3]).dbv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += tD0;
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_RGBA:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD4 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + bufWidth + idI) += WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+				    WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
 			  *(olpBuf.inp + (2 * bufWidth) + idI) +=
-			      WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+				    WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
 			  *(olpBuf.inp + (3 * bufWidth) + idI) +=
-			      WLZ_NINT(tD4);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) +=
-				      WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + bufWidth + idI) +=
-				      WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + (2 * bufWidth) + idI) +=
-				      WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + (3 * bufWidth) + idI) +=
-				      WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
-			  }
+				    WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
 			}
-			++dPos.vtX;
 		      }
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  break;
-		case WLZ_INTERPOLATION_CLASSIFY_1:     /* FALLTHROUGH */
-		  errNum = WLZ_ERR_UNIMPLEMENTED;
-		  break;
-		default:
-		  errNum = WLZ_ERR_INTERPOLATION_TYPE;
-		  break;
-	      }
-	      ++mItv1;
+		      ++dPos.vtX;
+		    }
+		    break;
+		  default:
+		    errNum = WLZ_ERR_GREY_TYPE;
+		    break;
+		}
+		break;
+	      case WLZ_INTERPOLATION_CLASSIFY_1:     /* FALLTHROUGH */
+		errNum = WLZ_ERR_UNIMPLEMENTED;
+		break;
+	      default:
+		errNum = WLZ_ERR_INTERPOLATION_TYPE;
+		break;
 	    }
+	    ++mItv1;
 	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth,
-					     bgdV, iWSp.lftpos, iWSp.rgtpos,
-					     interp, gType);
-	  }
-        }
-	if(errNum == WLZ_ERR_EOO)
+	}
+	if(errNum == WLZ_ERR_NONE)
 	{
-	  errNum = WLZ_ERR_NONE;
+	  errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth,
+					   bgdV, iWSp.lftpos, iWSp.rgtpos,
+					   interp, gType);
 	}
       }
-      ++idP;
-      ++dPos.vtZ;
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
     }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    (void )WlzFreeObj(obj2);
   }
-  (void )WlzFreeObj(obj2);
-  AlcFree(olpBuf.inp);
-  AlcFree(olpCnt);
-  WlzGreyValueFreeWSp(gVWSp);
   return(errNum);
 }
 
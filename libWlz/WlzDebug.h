@@ -61,6 +61,58 @@ typedef enum _WlzDbgMask
    WLZ_DBG_ALLOC	= (1<<4) 	/*!< Allocation and freeing */
 } WlzDbgMask;
 
+/*!
+* \enum		_WlzPerfMask
+* \ingroup      WlzDebug
+* \brief	Woolz performance counting bit masks.
+*		Typedef: ::WlzPerfMask
+*/
+typedef enum _WlzPerfMask
+{
+  WLZ_PERF_NONE		= (0),		/*!< No performance counting */
+  WLZ_PERF_COUNT	= (1),		/*!< Call counts and elapsed times */
+  WLZ_PERF_ALLOC	= (1<<1),	/*!< Bytes allocated using AlcMalloc(),
+  					     AlcCalloc() and AlcRealloc() */
+  WLZ_PERF_TRACE	= (1<<2)	/*!< Record a trace event for each
+  					     call */
+} WlzPerfMask;
+
+/*!
+* \struct	_WlzPerfCounter
+* \ingroup      WlzDebug
+* \brief	Performance counter for a named scope, usually a Woolz
+*		function. Times are inclusive of any nested scopes and
+*		allocation counts are for all threads while the scope
+*		was active.
+*		Typedef: ::WlzPerfCounter
+*/
+typedef struct _WlzPerfCounter
+{
+  const char	*name;			/*!< Scope name */
+  long		calls;			/*!< Number of calls */
+  double	time;			/*!< Total elapsed time (seconds) */
+  double	maxTime;		/*!< Maximum elapsed time of any
+  					     single call (seconds) */
+  size_t	allocBytes;		/*!< Number of bytes allocated */
+  size_t	allocCalls;		/*!< Number of allocations */
+} WlzPerfCounter;
+
+/*!
+* \struct	_WlzPerfScope
+* \ingroup      WlzDebug
+* \brief	Automatic state of an active performance counting scope,
+*		see WLZ_PERF_BEGIN() and WLZ_PERF_END().
+*		Typedef: ::WlzPerfScope
+*/
+typedef struct _WlzPerfScope
+{
+  int		idx;			/*!< Counter index, negative if the
+  					     scope is not being counted */
+  double	t0;			/*!< Time at scope entry */
+  size_t	allocBytes;		/*!< Bytes allocated at scope entry */
+  size_t	allocCalls;		/*!< Allocations at scope entry */
+} WlzPerfScope;
+
 typedef WlzErrorNum	(*WlzDbgFn)(char *, ...);
 typedef WlzErrorNum	(*WlzDbgObjFn)(WlzObject *, int);
 
@@ -77,6 +129,20 @@ extern WlzDbgObjFn	wlzDbgOutObjFn;
 extern WlzErrorNum	WlzDbgWrite(char *, ...);
 extern WlzErrorNum	WlzDbgObjWrite(WlzObject *, int);
 
+/************************************************************************
+* Woolz performance counting prototypes.				*
+************************************************************************/
+extern WlzPerfMask	wlzPerfMask;
+
+extern WlzErrorNum	WlzPerfEnable(WlzPerfMask mask);
+extern void		WlzPerfReset(void);
+extern void		WlzPerfBegin(WlzPerfScope *scope, const char *name);
+extern void		WlzPerfEnd(WlzPerfScope *scope);
+extern int		WlzPerfCounterCount(void);
+extern WlzErrorNum	WlzPerfCounterGet(int idx, WlzPerfCounter *dstCnt);
+extern WlzErrorNum	WlzPerfWriteJSON(FILE *fP);
+extern WlzErrorNum	WlzPerfWriteTrace(FILE *fP);
+
 /************************************************************************
 * Woolz debugging macros.						*
 ************************************************************************/
@@ -86,6 +152,25 @@ extern WlzErrorNum	WlzDbgObjWrite(WlzObject *, int);
 	 ((((F)&(wlzDbgObjMask))==(F))?(*wlzDbgOutObjFn)((O),(X)):WLZ_ERR_NONE)
 
 
+/************************************************************************
+* Woolz performance counting macros. A scope is only counted if
+* counting was enabled on entry to it, so when counting is disabled
+* the cost is a test of wlzPerfMask. Defining WLZ_PERF_DISABLE
+* removes the counting scopes altogether.
+************************************************************************/
+#ifdef WLZ_PERF_DISABLE
+#define WLZ_PERF_BEGIN(S,N) \
+		      ((void )&(S))
+#define WLZ_PERF_END(S) \
+		      ((void )&(S))
+#else
+#define WLZ_PERF_BEGIN(S,N) \
+		      ((S).idx = -1, \
+		       (wlzPerfMask)? WlzPerfBegin(&(S),(N)): (void )0)
+#define WLZ_PERF_END(S) \
+		      (((S).idx >= 0)? WlzPerfEnd(&(S)): (void )0)
+#endif
+
 #ifndef WLZ_EXT_BIND
 #ifdef  __cplusplus
 }
@@ -46,6 +46,70 @@ static char _WlzDistTransform_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzDistEDTWSp
+* \ingroup	WlzMorphologyOps
+* \brief	Workspace for the exact Euclidean distance transform.
+*		Only single plane buffers are used, with each plane being
+*		visited by a forward and a backward sweep through the
+*		planes.
+*		Typedef: ::WlzDistEDTWSp.
+*/
+typedef struct _WlzDistEDTWSp
+{
+  int		nThr;		/*!< Number of threads with line
+  				     workspaces. */
+  int		maxN;		/*!< Maximum line length in a plane. */
+  double	dMax;		/*!< Maximum distance, DBL_MAX if none. */
+  WlzIVertex3	org;		/*!< Origin of the bounding box covering
+  				     the foreground and reference objects. */
+  WlzIVertex3	sz;		/*!< Size of the bounding box. */
+  int		*refP;		/*!< Plane buffer with the (bounding box
+  				     relative) plane index of the nearest
+				     reference voxel in each column
+				     found so far in the sweep, -1 if
+				     none has been found. */
+  double	*pln;		/*!< Plane buffer for the squared
+  				     distances. */
+  int		*v;		/*!< Per thread parabola locations. */
+  double	*f;		/*!< Per thread line workspace. */
+} WlzDistEDTWSp;
+
+static void			WlzDistEDT1D(
+				  int n,
+				  double *f,
+				  double *d,
+				  int *v,
+				  double *z);
+static WlzDomain		WlzDistEDTPlaneDom(
+				  WlzObject *obj,
+				  int pln,
+				  WlzValues *dstVal);
+static WlzErrorNum		WlzDistEDTSweep(
+				  WlzDistEDTWSp *wSp,
+				  WlzObject *dstObj,
+				  WlzObject *refObj,
+				  int fwd,
+				  int first,
+				  int last);
+static WlzErrorNum		WlzDistEDTMarkRef(
+				  WlzDistEDTWSp *wSp,
+				  WlzDomain dom,
+				  int pln);
+static void			WlzDistEDTPlane(
+				  WlzDistEDTWSp *wSp,
+				  int pln,
+				  int refFound);
+static WlzErrorNum		WlzDistEDTSetValues(
+				  WlzDistEDTWSp *wSp,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int first,
+				  int last);
 static WlzObject 		*WlzDistSample(
 				  WlzObject *obj,
 				  int dim,
@@ -90,6 +154,12 @@ static WlzObject 		*WlzDistSample(
 * 		reference domain using a sphere with a radius having the same
 * 		value as the scale parameter and then finaly sampling the
 * 		scaled distances.
+*
+*		The exact Euclidean distance transform is computed by
+*		WlzDistanceTransformEDT() with single precision floating
+*		point values. Unlike the other distance functions the
+*		Euclidean distances are not constrained to paths within
+*		the foreground domain.
 * \param	forObj			Foreground object.
 * \param	refObj			Reference object.
 * \param	dFn			Distance function which must be
@@ -131,6 +201,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
   WlzAffineTransform *tr = NULL;
   WlzConnectType con = WLZ_0_CONNECTED;
   WlzObjectType dstGType;
+  WlzPerfScope	perfScope;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzValues 	difVal,
   		dstVal,
@@ -182,6 +253,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
     nrmDist26 = val;
   }
 #endif /* WLZ_DIST_TRANSFORM_ENV */
+  WLZ_PERF_BEGIN(perfScope, "WlzDistanceTransform");
   scale = dParam;
   nullVal.core = NULL;
   /* Check parameters. */
@@ -214,6 +286,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_4_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_8_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 2;
 	    break;
@@ -229,6 +302,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_18_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_26_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 3;
 	    break;
@@ -272,18 +346,24 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	}
 	break;
       case WLZ_EUCLIDEAN_DISTANCE:
-	errNum = WLZ_ERR_UNIMPLEMENTED;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
 	break;
     }
   }
-  /* Create scaled domains and a sphere domain for structual erosion if the
+  /* The exact Euclidean distance transform is not iterative, otherwise
+   * create scaled domains and a sphere domain for structual erosion if the
    * distance function is approximate Euclidean. */
   if(errNum == WLZ_ERR_NONE)
   {
-    if(dFn == WLZ_APX_EUCLIDEAN_DISTANCE)
+    if(dFn == WLZ_EUCLIDEAN_DISTANCE)
+    {
+      notDone = 0;
+      dstObj = WlzDistanceTransformEDT(forObj, refObj, WLZ_GREY_FLOAT, dMax,
+                                       &errNum);
+    }
+    else if(dFn == WLZ_APX_EUCLIDEAN_DISTANCE)
     {
       tr = (dim == 2)?
 	   WlzAffineTransformFromScale(WLZ_TRANSFORM_2D_AFFINE,
@@ -352,7 +432,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
     }
   }
   /* Create new values for the computed distances. */
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     dstGType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_INT, NULL);
     if(dim == 2)
@@ -366,12 +446,12 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
   }
   /* Create a distance object using the foreground object's domain and
    * the new distance values. */
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     dstObj = WlzMakeMain(sForObj->type, sForObj->domain, dstVal,
 			 NULL, NULL, &errNum);
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     bothObj[0] = sForObj;
     errNum = WlzGreySetValue(dstObj, dstV);
@@ -530,6 +610,208 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
   {
     *dstErr = errNum;
   }
+  WLZ_PERF_END(perfScope);
+  return(dstObj);
+}
+
+/*!
+* \return	Distance object which shares the given foreground object's
+*		domain and has floating point distance values, null on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the exact Euclidean distance of every pixel/voxel
+*		in the foreground object from the reference object.
+*
+*		The squared distances are computed using separable
+*		one dimensional lower envelope passes, with each pass being
+*		linear in the number of pixels/voxels. See: P. Felzenszwalb
+*		and D. Huttenlocher. "Distance Transforms of Sampled
+*		Functions" Theory of Computing 8:415-428, 2012 and
+*		A. Meijster, J. Roerdink and W. Hesselink. "A General
+*		Algorithm for Computing Distance Transforms in Linear Time"
+*		Mathematical Morphology and its Applications to Image and
+*		Signal Processing 331-340, 2000.
+*
+*		Rather than using a buffer for the whole of the volume, the
+*		planes are visited in a forward and then a backward sweep.
+*		Each sweep records the plane of the nearest reference voxel
+*		found so far in each column, from which the passes within
+*		the plane give the distance to the nearest reference voxel
+*		on that side of the plane. The distances are only computed
+*		for planes in which the foreground object has a non-empty
+*		domain and are set directly in the foreground object's
+*		values, with the backward sweep keeping the minimum of
+*		the two. The working storage is then just two buffers for a
+*		single plane (of the bounding box of the foreground and
+*		reference objects) plus a line workspace for each thread,
+*		with the lines and columns of the passes being processed
+*		in parallel.
+*
+*		Distances are not constrained to paths within the foreground
+*		domain. Pixels/voxels with a distance greater than the
+*		given maximum distance, or with no reference object
+*		pixels/voxels, are set to zero as they are for the iterative
+*		distance functions.
+* \param	forObj			Foreground object.
+* \param	refObj			Reference object, which may be
+*					a spatial domain object of the same
+*					dimension as the foreground object
+*					or a points object.
+* \param	gType			Required grey type, which must be
+*					either WLZ_GREY_FLOAT or
+*					WLZ_GREY_DOUBLE.
+* \param	dMax			Maximum distance, <= 0 implies an
+*					infinite maximum distance.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzDistanceTransformEDT(WlzObject *forObj, WlzObject *refObj,
+				      WlzGreyType gType, double dMax,
+				      WlzErrorNum *dstErr)
+{
+  int		dim = 0;
+  WlzIBox3	fBox,
+  		rBox;
+  WlzObject	*sRefObj = NULL,
+  		*dstObj = NULL;
+  WlzObjectType	dstGType;
+  WlzPixelV	bgdV;
+  WlzValues	dstVal,
+  		nullVal;
+  WlzDistEDTWSp	wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	dEps = 1.0e-6;
+
+  dstVal.core = NULL;
+  nullVal.core = NULL;
+  wSp.refP = NULL;
+  wSp.pln = NULL;
+  wSp.v = NULL;
+  wSp.f = NULL;
+  if((forObj == NULL) || (refObj == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(((forObj->type != WLZ_2D_DOMAINOBJ) &&
+           (forObj->type != WLZ_3D_DOMAINOBJ)) ||
+          ((refObj->type != WLZ_POINTS) &&
+	   (refObj->type != forObj->type)))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((forObj->domain.core == NULL) || (refObj->domain.core == NULL))
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((gType != WLZ_GREY_FLOAT) && (gType != WLZ_GREY_DOUBLE))
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dim = (forObj->type == WLZ_2D_DOMAINOBJ)? 2: 3;
+    if(refObj->type == WLZ_POINTS)
+    {
+      sRefObj = WlzAssignObject(
+                WlzPointsToDomObj(refObj->domain.pts, 1.0, &errNum), NULL);
+      if((errNum == WLZ_ERR_NONE) && (sRefObj->type != forObj->type))
+      {
+        errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+    }
+    else
+    {
+      sRefObj = WlzAssignObject(
+		WlzMakeMain(refObj->type, refObj->domain, nullVal,
+			    NULL, NULL, &errNum), NULL);
+    }
+  }
+  /* Find the bounding box which covers both the foreground and reference
+   * objects. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    fBox = WlzBoundingBox3I(forObj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rBox = WlzBoundingBox3I(sRefObj, &errNum);
+    }
+  }
+  /* Allocate the plane buffers and the per thread line workspaces. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	nPix;
+
+    fBox = WlzBoundingBoxUnion3I(fBox, rBox);
+    wSp.dMax = (dMax > dEps)? dMax: DBL_MAX;
+    wSp.org.vtX = fBox.xMin;
+    wSp.org.vtY = fBox.yMin;
+    wSp.org.vtZ = (dim == 2)? 0: fBox.zMin;
+    wSp.sz.vtX = fBox.xMax - fBox.xMin + 1;
+    wSp.sz.vtY = fBox.yMax - fBox.yMin + 1;
+    wSp.sz.vtZ = (dim == 2)? 1: fBox.zMax - fBox.zMin + 1;
+    wSp.maxN = WLZ_MAX(wSp.sz.vtX, wSp.sz.vtY);
+    wSp.nThr = 1;
+#ifdef _OPENMP
+    wSp.nThr = omp_get_max_threads();
+#endif
+    nPix = (size_t )(wSp.sz.vtX) * wSp.sz.vtY;
+    if(((wSp.refP = (int *)AlcMalloc(nPix * sizeof(int))) == NULL) ||
+       ((wSp.pln = (double *)AlcMalloc(nPix * sizeof(double))) == NULL) ||
+       ((wSp.v = (int *)AlcMalloc((size_t )(wSp.nThr) * wSp.maxN *
+                                  sizeof(int))) == NULL) ||
+       ((wSp.f = (double *)AlcMalloc((size_t )(wSp.nThr) *
+                                     (3 * wSp.maxN + 1) *
+				     sizeof(double))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Create the distance object with the foreground object's domain. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    dstGType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    if(dim == 2)
+    {
+      dstVal.v = WlzNewValueTb(forObj, dstGType, bgdV, &errNum);
+    }
+    else
+    {
+      dstVal.vox = WlzNewValuesVox(forObj, dstGType, bgdV, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dstObj = WlzMakeMain(forObj->type, forObj->domain, dstVal,
+			 NULL, NULL, &errNum);
+  }
+  else if(dstVal.core)
+  {
+    (void )WlzFreeValues(dstVal);
+  }
+  /* Compute the distances, in 3D the distances from the reference
+   * voxels in the preceding planes are set by the forward sweep and
+   * then reduced by those from the following planes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzDistEDTSweep(&wSp, dstObj, sRefObj, 1, 1, dim == 2);
+  }
+  if((errNum == WLZ_ERR_NONE) && (dim == 3))
+  {
+    errNum = WlzDistEDTSweep(&wSp, dstObj, sRefObj, 0, 0, 1);
+  }
+  AlcFree(wSp.refP);
+  AlcFree(wSp.pln);
+  AlcFree(wSp.v);
+  AlcFree(wSp.f);
+  (void )WlzFreeObj(sRefObj);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(dstObj); dstObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
   return(dstObj);
 }
 
@@ -575,3 +857,409 @@ static WlzObject *WlzDistSample(WlzObject *obj, int dim, double scale,
   }
   return(sObj);
 }
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared Euclidean distance
+*		transform of a sampled function, ie for each \f$q\f$
+*		\f$d(q) = \min_p (q - p)^2 + f(p)\f$, using the lower
+*		envelope of the parabolas rooted at the finite samples.
+*		Samples with value DBL_MAX are treated as infinite.
+* \param	n			Number of samples.
+* \param	f			Given sampled function.
+* \param	d			Destination for the squared distances,
+*					must not be the same as f.
+* \param	v			Workspace for the parabola locations
+*					with room for n ints.
+* \param	z			Workspace for the parabola boundaries
+*					with room for n + 1 doubles.
+*/
+static void	WlzDistEDT1D(int n, double *f, double *d, int *v, double *z)
+{
+  int		j,
+  		k = -1,
+		q;
+  double	s = 0.0;
+
+  for(q = 0; q < n; ++q)
+  {
+    if(f[q] < DBL_MAX)
+    {
+      double	fq;
+
+      fq = f[q] + (double )q * q;
+      while(k >= 0)
+      {
+	s = (fq - (f[v[k]] + (double )(v[k]) * v[k])) /
+	    (2.0 * (q - v[k]));
+        if(s > z[k])
+	{
+	  break;
+	}
+	--k;
+      }
+      z[k + 1] = (k < 0)? -DBL_MAX: s;
+      v[++k] = q;
+    }
+  }
+  if(k < 0)
+  {
+    for(q = 0; q < n; ++q)
+    {
+      d[q] = DBL_MAX;
+    }
+  }
+  else
+  {
+    z[k + 1] = DBL_MAX;
+    j = 0;
+    for(q = 0; q < n; ++q)
+    {
+      double	t;
+
+      while(z[j + 1] < q)
+      {
+        ++j;
+      }
+      t = q - v[j];
+      d[q] = (t * t) + f[v[j]];
+    }
+  }
+}
+
+/*!
+* \return	Domain of the plane, with a null core pointer if the
+*		object has no domain in the plane.
+* \ingroup	WlzMorphologyOps
+* \brief	Gets the domain (and optionally the values) of a 2D domain
+*		object or of a plane of a 3D domain object.
+* \param	obj			Given 2 or 3D domain object.
+* \param	pln			Plane coordinate, ignored for a
+*					2D object.
+* \param	dstVal			Destination pointer for the values
+*					of the plane, may be NULL.
+*/
+static WlzDomain WlzDistEDTPlaneDom(WlzObject *obj, int pln,
+				    WlzValues *dstVal)
+{
+  WlzDomain	dom;
+  WlzValues	val;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    dom = obj->domain;
+    val = obj->values;
+  }
+  else if((pln >= obj->domain.p->plane1) && (pln <= obj->domain.p->lastpl))
+  {
+    dom = obj->domain.p->domains[pln - obj->domain.p->plane1];
+    if(obj->values.core)
+    {
+      val = obj->values.vox->values[pln - obj->values.vox->plane1];
+    }
+  }
+  if(dom.core && (dom.core->type == WLZ_EMPTY_DOMAIN))
+  {
+    dom.core = NULL;
+  }
+  if(dstVal)
+  {
+    *dstVal = val;
+  }
+  return(dom);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a single sweep through the planes of the bounding box,
+*		setting the distances of the foreground object's pixels/voxels
+*		from the reference object's pixels/voxels which are in the
+*		same or preceding planes of the sweep.
+* \param	wSp			Distance transform workspace.
+* \param	dstObj			Distance object with floating point
+*					values.
+* \param	refObj			Reference domain object.
+* \param	fwd			Sweep through planes of increasing
+*					coordinate if non-zero, otherwise
+*					decreasing coordinate.
+* \param	first			Non-zero if this is the first sweep,
+*					in which case the distance values are
+*					set rather than reduced.
+* \param	last			Non-zero if this is the last sweep,
+*					in which case distances greater
+*					than the maximum are set to zero.
+*/
+static WlzErrorNum WlzDistEDTSweep(WlzDistEDTWSp *wSp,
+				   WlzObject *dstObj, WlzObject *refObj,
+				   int fwd, int first, int last)
+{
+  int		idI,
+  		refFound = 0;
+  size_t	idx,
+  		nPix;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nPix = (size_t )(wSp->sz.vtX) * wSp->sz.vtY;
+  for(idx = 0; idx < nPix; ++idx)
+  {
+    wSp->refP[idx] = -1;
+  }
+  for(idI = 0; (errNum == WLZ_ERR_NONE) && (idI < wSp->sz.vtZ); ++idI)
+  {
+    int		pln;
+    WlzDomain	dom;
+    WlzValues	val;
+
+    pln = (fwd)? idI: wSp->sz.vtZ - 1 - idI;
+    dom = WlzDistEDTPlaneDom(refObj, pln + wSp->org.vtZ, NULL);
+    if(dom.core)
+    {
+      refFound = 1;
+      errNum = WlzDistEDTMarkRef(wSp, dom, pln);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom = WlzDistEDTPlaneDom(dstObj, pln + wSp->org.vtZ, &val);
+      if(dom.core && val.core)
+      {
+	WlzDistEDTPlane(wSp, pln, refFound);
+	errNum = WlzDistEDTSetValues(wSp, dom, val, first, last);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Records the given plane as that of the nearest reference
+*		voxel for each column within the given reference domain.
+* \param	wSp			Distance transform workspace.
+* \param	dom			Reference domain of the plane.
+* \param	pln			Bounding box relative plane index.
+*/
+static WlzErrorNum WlzDistEDTMarkRef(WlzDistEDTWSp *wSp, WlzDomain dom,
+				     int pln)
+{
+  WlzObject	*obj;
+  WlzValues	nullVal;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	idK;
+      int	*rP;
+
+      rP = wSp->refP + (size_t )(iWSp.linpos - wSp->org.vtY) * wSp->sz.vtX +
+	   iWSp.lftpos - wSp->org.vtX;
+      for(idK = iWSp.lftpos; idK <= iWSp.rgtpos; ++idK)
+      {
+	*rP++ = pln;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the squared distances within the plane buffer
+*		from the reference voxels recorded so far in the sweep,
+*		using a pass along the lines and then one along the
+*		columns of the plane. The lines and columns are each
+*		processed in parallel.
+* \param	wSp			Distance transform workspace.
+* \param	pln			Bounding box relative plane index.
+* \param	refFound		Non-zero if any reference voxels have
+*					been found in the sweep, otherwise
+*					all distances are infinite.
+*/
+static void	WlzDistEDTPlane(WlzDistEDTWSp *wSp, int pln, int refFound)
+{
+  int		idL,
+  		nX,
+		nY;
+
+  nX = wSp->sz.vtX;
+  nY = wSp->sz.vtY;
+  if(refFound == 0)
+  {
+    size_t	idx,
+    		nPix;
+
+    nPix = (size_t )nX * nY;
+    for(idx = 0; idx < nPix; ++idx)
+    {
+      wSp->pln[idx] = DBL_MAX;
+    }
+  }
+  else
+  {
+    /* Pass along the lines, with the distances from the plane of the
+     * nearest reference voxel in each column. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idL = 0; idL < nY; ++idL)
+    {
+      int	idN,
+		thrId = 0;
+      int	*rP;
+      double	*f,
+		*gP;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      f = wSp->f + (size_t )thrId * (3 * wSp->maxN + 1);
+      rP = wSp->refP + (size_t )idL * nX;
+      gP = wSp->pln + (size_t )idL * nX;
+      for(idN = 0; idN < nX; ++idN)
+      {
+	if(rP[idN] < 0)
+	{
+	  f[idN] = DBL_MAX;
+	}
+	else
+	{
+	  double t;
+
+	  t = pln - rP[idN];
+	  f[idN] = t * t;
+	}
+      }
+      WlzDistEDT1D(nX, f, gP, wSp->v + (size_t )thrId * wSp->maxN,
+		   f + wSp->maxN);
+    }
+    /* Pass along the columns. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idL = 0; idL < nX; ++idL)
+    {
+      int	idN,
+		thrId = 0;
+      double	*d,
+		*f,
+		*gP;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      f = wSp->f + (size_t )thrId * (3 * wSp->maxN + 1);
+      d = f + wSp->maxN;
+      gP = wSp->pln + idL;
+      for(idN = 0; idN < nY; ++idN)
+      {
+	f[idN] = *gP;
+	gP += nX;
+      }
+      WlzDistEDT1D(nY, f, d, wSp->v + (size_t )thrId * wSp->maxN,
+		   d + wSp->maxN);
+      gP = wSp->pln + idL;
+      for(idN = 0; idN < nY; ++idN)
+      {
+	*gP = d[idN];
+	gP += nX;
+      }
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets (or reduces) the distance values within a single plane
+*		of the distance object from the squared distances in the
+*		plane buffer.
+* \param	wSp			Distance transform workspace.
+* \param	dom			Domain of the plane.
+* \param	val			Floating point values of the plane.
+* \param	first			Non-zero if the values are to be
+*					set rather than reduced.
+* \param	last			Non-zero if distances greater than
+*					the maximum are to be set to zero.
+*/
+static WlzErrorNum WlzDistEDTSetValues(WlzDistEDTWSp *wSp,
+				       WlzDomain dom, WlzValues val,
+				       int first, int last)
+{
+  WlzObject	*obj;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	idK,
+      		len;
+      double	dInf;
+      double	*gP;
+
+      len = iWSp.rgtpos - iWSp.lftpos + 1;
+      gP = wSp->pln + (size_t )(iWSp.linpos - wSp->org.vtY) * wSp->sz.vtX +
+	   iWSp.lftpos - wSp->org.vtX;
+      dInf = (gWSp.pixeltype == WLZ_GREY_FLOAT)? FLT_MAX: DBL_MAX;
+      for(idK = 0; idK < len; ++idK)
+      {
+	double	d;
+
+	d = (gP[idK] < dInf)? sqrt(gP[idK]): dInf;
+	if(gWSp.pixeltype == WLZ_GREY_FLOAT)
+	{
+	  float	*fP;
+
+	  fP = gWSp.u_grintptr.flp + idK;
+	  if((first == 0) && (*fP < d))
+	  {
+	    d = *fP;
+	  }
+	  *fP = (last && ((d >= dInf) || (d > wSp->dMax)))? 0.0f: (float )d;
+	}
+	else /* gWSp.pixeltype == WLZ_GREY_DOUBLE */
+	{
+	  double *dP;
+
+	  dP = gWSp.u_grintptr.dbp + idK;
+	  if((first == 0) && (*dP < d))
+	  {
+	    d = *dP;
+	  }
+	  *dP = (last && ((d >= dInf) || (d > wSp->dMax)))? 0.0: d;
+	}
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
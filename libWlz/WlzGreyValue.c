@@ -74,15 +74,27 @@ static void			WlzGreyValueComputeGreyPTiled2D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
 				  WlzTiledValues *tVal,
+				  WlzTiledValuesTile **tileP,
 				  int line,
 				  int kol);
 static void			WlzGreyValueComputeGreyPTiled3D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
 				  WlzTiledValues *tVal,
+				  WlzTiledValuesTile **tileP,
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueComputeGreyPTile(
+				  WlzGreyP *baseGVP,
+				  size_t *offset,
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesTile **tileP,
+				  size_t idx,
+				  size_t off);
+static void			WlzGreyValueSetPtrToVal(
+				  WlzGreyValueWSpace *gVWSp,
+				  int count);
 static void			WlzGreyValueGet2D1(
 				  WlzGreyValueWSpace *gVWSp,
 				  int line,
@@ -116,6 +128,34 @@ static void			WlzGreyValueGetTransCon(
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueCursorTransform(
+				  WlzGreyValueCursor *gVCur,
+				  double *plane,
+				  double *line,
+				  double *kol);
+static void			WlzGreyValueCursorGet1(
+				  WlzGreyValueCursor *gVCur,
+				  int plane,
+				  int line,
+				  int kol);
+static void			WlzGreyValueCursorSetLine(
+				  WlzGreyValueCursor *gVCur,
+				  int plane,
+				  int line);
+static void			WlzGreyValueCursorSetSpan(
+				  WlzGreyValueCursor *gVCur,
+				  int kol);
+static double			WlzGreyValueCursorBkdD(
+				  WlzGreyValueCursor *gVCur);
+static double			WlzGreyValueCursorGetD(
+				  WlzGreyValueCursor *gVCur,
+				  int plane,
+				  int line,
+				  int kol,
+				  double bkd);
+static void			WlzGreyValueCursorSetSpanValues(
+				  WlzGreyValueCursor *gVCur,
+				  int kol);
 /*!
 * \return	Grey value work space or NULL on error.
 * \ingroup	WlzAccess
@@ -452,6 +492,7 @@ void		WlzGreyValueFreeWSp(WlzGreyValueWSpace *gVWSp)
 	    gVWSp));
   if(gVWSp)
   {
+    WlzTiledValuesTileRelease(gVWSp->tile);
     (void )WlzFreeAffineTransform(gVWSp->invTrans);
     AlcFree((void *)(gVWSp->gTabTypes3D));
     AlcFree(gVWSp);
@@ -582,6 +623,14 @@ void		WlzGreyValueGetCon(WlzGreyValueWSpace *gVWSp,
 	  break;
       }
     }
+    if((gVWSp->gTabType2D == (WlzObjectType )WLZ_GREY_TAB_TILED) &&
+       (gVWSp->values.t->cmp != NULL))
+    {
+      /* The values may be from several decompressed tiles of which only
+       * one is held, so the pointers are set to the values instead. */
+      WlzGreyValueSetPtrToVal(gVWSp,
+                              (gVWSp->objType == WLZ_2D_DOMAINOBJ)? 4: 8);
+    }
   }
 }
 
@@ -773,6 +822,675 @@ void		WlzGreyValueGetDir(WlzGreyValueWSpace *gVWSp,
   }
 }
 
+/*!
+* \return	New grey value cursor or NULL on error.
+* \ingroup	WlzAccess
+* \brief	Creates a grey value cursor for random access to the
+*		values of the object with which the given grey value
+*		work space was initialised. The work space is only read
+*		through the cursor, so a single work space may be shared
+*		by many cursors, eg one per thread, and it must not be
+*		freed while they are in use. The cursor should be freed
+*		using WlzGreyValueFreeCursor().
+* \param	gVWSp			Given grey value work space.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzGreyValueCursor *WlzGreyValueMakeCursor(WlzGreyValueWSpace *gVWSp,
+					WlzErrorNum *dstErr)
+{
+  WlzGreyValueCursor *gVCur = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gVWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((gVWSp->objType != WLZ_2D_DOMAINOBJ) &&
+          (gVWSp->objType != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((gVWSp->gTabType2D == (WlzObjectType )WLZ_GREY_TAB_TILED) &&
+          (gVWSp->values.t->dim != ((gVWSp->objType == WLZ_2D_DOMAINOBJ)?
+	                            2: 3)))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else if((gVCur = (WlzGreyValueCursor *)AlcCalloc(1,
+  				sizeof(WlzGreyValueCursor))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    gVCur->gVWSp = gVWSp;
+    gVCur->rectItvLn.nintvs = 1;
+    gVCur->rectItvLn.intvs = &(gVCur->rectItv);
+    gVCur->vpe = 1;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(gVCur);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Free's the given grey value cursor created by
+* 		WlzGreyValueMakeCursor(). The cursor's grey value work
+* 		space is not free'd.
+* \param	gVCur			Given grey value cursor.
+*/
+void		WlzGreyValueFreeCursor(WlzGreyValueCursor *gVCur)
+{
+  if(gVCur)
+  {
+    WlzTiledValuesTileRelease(gVCur->tile);
+    AlcFree(gVCur);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets a single grey value/pointer for the given point
+*		using the given cursor. The value, pointer and background
+*		flag are set in the cursor in the same way as they are
+*		for the first value of a grey value work space by
+*		WlzGreyValueGet(). Queries which are on the same line and
+*		within the same interval (or gap between intervals) as
+*		the previous query only require a bounds check.
+* \param	gVCur			Given grey value cursor.
+* \param	plane			Plane (z) coordinate of point.
+* \param	line			Line (y) coordinate of point.
+* \param	kol			Column (x) coordinate of point.
+*/
+void		WlzGreyValueCursorGet(WlzGreyValueCursor *gVCur,
+				      double plane, double line, double kol)
+{
+  if(gVCur)
+  {
+    if(gVCur->gVWSp->invTrans)
+    {
+      WlzGreyValueCursorTransform(gVCur, &plane, &line, &kol);
+    }
+    WlzGreyValueCursorGet1(gVCur,
+    			   WLZ_NINT(plane), WLZ_NINT(line), WLZ_NINT(kol));
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets the grey values at each of the given points using
+*		the given cursor. The points are treated as by
+*		WlzGreyValueCursorGet() but the values are returned as
+*		doubles in a contiguous array, eg for the vectorised
+*		interpolation of values. Points should be ordered for
+*		coherence (eg by line and then by column) for efficiency.
+*		Only the cursor's background flag is set (for the last
+*		point), not its grey value or pointer.
+* \param	gVCur			Given grey value cursor.
+* \param	n			Number of points.
+* \param	pos			Array of point positions.
+* \param	dstVal			Destination array for the n values.
+* \param	dstBkd			Destination array for n flags which
+* 					are set non-zero for background
+* 					values, may be NULL.
+*/
+void		WlzGreyValueCursorGetN(WlzGreyValueCursor *gVCur,
+				       int n, WlzDVertex3 *pos,
+				       double *dstVal, WlzUByte *dstBkd)
+{
+  int		idx;
+  double	bkd;
+
+  if(gVCur && pos && dstVal)
+  {
+    bkd = WlzGreyValueCursorBkdD(gVCur);
+    for(idx = 0; idx < n; ++idx)
+    {
+      int	pl,
+		ln,
+		kl;
+
+      if(gVCur->gVWSp->invTrans)
+      {
+	WlzDVertex3 p;
+
+	p = pos[idx];
+	WlzGreyValueCursorTransform(gVCur, &(p.vtZ), &(p.vtY), &(p.vtX));
+	kl = WLZ_NINT(p.vtX);
+	ln = WLZ_NINT(p.vtY);
+	pl = WLZ_NINT(p.vtZ);
+      }
+      else
+      {
+	kl = WLZ_NINT(pos[idx].vtX);
+	ln = WLZ_NINT(pos[idx].vtY);
+	pl = WLZ_NINT(pos[idx].vtZ);
+      }
+      dstVal[idx] = WlzGreyValueCursorGetD(gVCur, pl, ln, kl, bkd);
+      if(dstBkd)
+      {
+        dstBkd[idx] = (WlzUByte )(gVCur->bkdFlag);
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets runs of grey values along lines using the given
+*		cursor, where each run starts at one of the given integer
+*		positions and has the given number of consecutive columns.
+*		Value k of run i is returned in dstVal[k * stride + i],
+*		so that, for example, runs of length two give the pairs of
+*		values needed for interpolation along columns as two
+*		contiguous arrays. Positions are in the coordinates of the
+*		work space's object: any inverse transform of the work
+*		space is not applied. Only the cursor's background flag is
+*		set (for the last value), not its grey value or pointer.
+* \param	gVCur			Given grey value cursor.
+* \param	n			Number of runs.
+* \param	len			Length of each run.
+* \param	stride			Offset in the destination array
+* 					between the values of a run.
+* \param	pos			Array of run start positions.
+* \param	dstVal			Destination array for the values.
+*/
+void		WlzGreyValueCursorGetRunsI(WlzGreyValueCursor *gVCur,
+					   int n, int len, int stride,
+					   WlzIVertex3 *pos, double *dstVal)
+{
+  int		idx,
+  		idK;
+  double	bkd;
+
+  if(gVCur && pos && dstVal)
+  {
+    bkd = WlzGreyValueCursorBkdD(gVCur);
+    for(idx = 0; idx < n; ++idx)
+    {
+      for(idK = 0; idK < len; ++idK)
+      {
+	dstVal[(idK * stride) + idx] = WlzGreyValueCursorGetD(gVCur,
+					  pos[idx].vtZ, pos[idx].vtY,
+					  pos[idx].vtX + idK, bkd);
+      }
+    }
+  }
+}
+
+/*!
+* \return	Background value as a double.
+* \ingroup	WlzAccess
+* \brief	Gets the background value of the cursor's work space as
+*		a double.
+* \param	gVCur			Given grey value cursor.
+*/
+static double	WlzGreyValueCursorBkdD(WlzGreyValueCursor *gVCur)
+{
+  double	bkd = 0.0;
+
+  switch(gVCur->gVWSp->gType)
+  {
+    case WLZ_GREY_LONG:
+      bkd = gVCur->gVWSp->gBkd.lnv;
+      break;
+    case WLZ_GREY_INT:
+      bkd = gVCur->gVWSp->gBkd.inv;
+      break;
+    case WLZ_GREY_SHORT:
+      bkd = gVCur->gVWSp->gBkd.shv;
+      break;
+    case WLZ_GREY_UBYTE:
+      bkd = gVCur->gVWSp->gBkd.ubv;
+      break;
+    case WLZ_GREY_FLOAT:
+      bkd = gVCur->gVWSp->gBkd.flv;
+      break;
+    case WLZ_GREY_DOUBLE:
+      bkd = gVCur->gVWSp->gBkd.dbv;
+      break;
+    case WLZ_GREY_RGBA:
+      bkd = gVCur->gVWSp->gBkd.rgbv;
+      break;
+    default:
+      break;
+  }
+  return(bkd);
+}
+
+/*!
+* \return	Grey value as a double.
+* \ingroup	WlzAccess
+* \brief	Gets a single grey value for the given integer point as
+*		a double using the given cursor. This is as
+*		WlzGreyValueCursorGet1() but only the value and background
+*		flag are set.
+* \param	gVCur			Given grey value cursor.
+* \param	plane			Plane coordinate of point.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point.
+* \param	bkd			Background value.
+*/
+static double	WlzGreyValueCursorGetD(WlzGreyValueCursor *gVCur,
+				       int plane, int line, int kol,
+				       double bkd)
+{
+  double	v = bkd;
+
+  if((gVCur->lnValid == 0) || (line != gVCur->line) ||
+     ((plane != gVCur->plane) &&
+      (gVCur->gVWSp->objType == WLZ_3D_DOMAINOBJ)))
+  {
+    WlzGreyValueCursorSetLine(gVCur, plane, line);
+  }
+  if((kol < gVCur->spanK0) || (kol > gVCur->spanK1))
+  {
+    WlzGreyValueCursorSetSpan(gVCur, kol);
+  }
+  if(gVCur->spanP.v)
+  {
+    size_t	off;
+
+    off = (size_t )(kol - gVCur->spanK0) * gVCur->vpe;
+    switch(gVCur->gVWSp->gType)
+    {
+      case WLZ_GREY_LONG:
+	v = gVCur->spanP.lnp[off];
+	break;
+      case WLZ_GREY_INT:
+	v = gVCur->spanP.inp[off];
+	break;
+      case WLZ_GREY_SHORT:
+	v = gVCur->spanP.shp[off];
+	break;
+      case WLZ_GREY_UBYTE:
+	v = gVCur->spanP.ubp[off];
+	break;
+      case WLZ_GREY_FLOAT:
+	v = gVCur->spanP.flp[off];
+	break;
+      case WLZ_GREY_DOUBLE:
+	v = gVCur->spanP.dbp[off];
+	break;
+      case WLZ_GREY_RGBA:
+	v = gVCur->spanP.rgbp[off];
+	break;
+      default:
+	break;
+    }
+    gVCur->bkdFlag = 0;
+  }
+  else
+  {
+    gVCur->bkdFlag = 1;
+  }
+  return(v);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Transforms the given point using the inverse transform
+*		of the cursor's grey value work space.
+* \param	gVCur			Given grey value cursor.
+* \param	plane			Plane (z) coordinate of point.
+* \param	line			Line (y) coordinate of point.
+* \param	kol			Column (x) coordinate of point.
+*/
+static void	WlzGreyValueCursorTransform(WlzGreyValueCursor *gVCur,
+					    double *plane, double *line,
+					    double *kol)
+{
+  if(gVCur->gVWSp->objType == WLZ_2D_DOMAINOBJ)
+  {
+    WlzDVertex2	vtx2;
+
+    vtx2.vtX = *kol;
+    vtx2.vtY = *line;
+    vtx2 = WlzAffineTransformVertexD2(gVCur->gVWSp->invTrans, vtx2, NULL);
+    *kol = vtx2.vtX;
+    *line = vtx2.vtY;
+  }
+  else
+  {
+    WlzDVertex3	vtx3;
+
+    vtx3.vtX = *kol;
+    vtx3.vtY = *line;
+    vtx3.vtZ = *plane;
+    vtx3 = WlzAffineTransformVertexD3(gVCur->gVWSp->invTrans, vtx3, NULL);
+    *kol = vtx3.vtX;
+    *line = vtx3.vtY;
+    *plane = vtx3.vtZ;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets a single grey value/pointer for the given integer
+*		point using the given cursor, first updating the cached
+*		line and span if the point is not within the current
+*		span.
+* \param	gVCur			Given grey value cursor.
+* \param	plane			Plane coordinate of point.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point.
+*/
+static void	WlzGreyValueCursorGet1(WlzGreyValueCursor *gVCur,
+				       int plane, int line, int kol)
+{
+  if((gVCur->lnValid == 0) || (line != gVCur->line) ||
+     ((plane != gVCur->plane) &&
+      (gVCur->gVWSp->objType == WLZ_3D_DOMAINOBJ)))
+  {
+    WlzGreyValueCursorSetLine(gVCur, plane, line);
+  }
+  if((kol < gVCur->spanK0) || (kol > gVCur->spanK1))
+  {
+    WlzGreyValueCursorSetSpan(gVCur, kol);
+  }
+  if(gVCur->spanP.v)
+  {
+    WlzGreyValueSetGreyP(&(gVCur->gVal), &(gVCur->gPtr), gVCur->gVWSp->gType,
+    		         gVCur->spanP,
+			 (size_t )(kol - gVCur->spanK0) * gVCur->vpe);
+    gVCur->bkdFlag = 0;
+  }
+  else
+  {
+    WlzGreyValueSetBkdP(&(gVCur->gVal), &(gVCur->gPtr), gVCur->gVWSp->gType,
+    			gVCur->gVWSp->gBkd);
+    gVCur->bkdFlag = 1;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Sets the cursor's cached plane domain, values and
+*		interval line for the given plane and line. If the line
+*		is not within the domain then the cursor's span is set
+*		to cover all columns with background values.
+* \param	gVCur			Given grey value cursor.
+* \param	plane			Plane coordinate.
+* \param	line			Line coordinate.
+*/
+static void	WlzGreyValueCursorSetLine(WlzGreyValueCursor *gVCur,
+					  int plane, int line)
+{
+  int		plRel;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObjectType	gTabType = WLZ_DUMMY_ENTRY;
+  WlzGreyValueWSpace *gVWSp;
+
+  gVWSp = gVCur->gVWSp;
+  gVCur->lnValid = 1;
+  gVCur->plane = plane;
+  gVCur->line = line;
+  gVCur->itvLn = NULL;
+  gVCur->itvIdx = 0;
+  gVCur->spanK0 = INT_MIN;
+  gVCur->spanK1 = INT_MAX;
+  gVCur->spanP.v = NULL;
+  dom.core = NULL;
+  val.core = NULL;
+  if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+  {
+    dom = gVWSp->domain;
+    val = gVWSp->values;
+    gTabType = gVWSp->gTabType;
+  }
+  else
+  {
+    plRel = plane - gVWSp->domain.p->plane1;
+#ifdef WLZ_FAST_CODE
+    if((unsigned int )plRel <= (unsigned int )(gVWSp->domain.p->lastpl -
+                                               gVWSp->domain.p->plane1))
+#else
+    if((plRel >= 0) && (plane <= gVWSp->domain.p->lastpl))
+#endif
+    {
+      dom = gVWSp->domain.p->domains[plRel];
+      if(gVWSp->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)
+      {
+        val = gVWSp->values;
+	gTabType = WLZ_GREY_TAB_TILED;
+      }
+      else
+      {
+        val = gVWSp->values.vox->values[plRel];
+	gTabType = gVWSp->gTabTypes3D[plRel];
+      }
+    }
+  }
+  if(dom.core && val.core &&
+     (line >= dom.i->line1) && (line <= dom.i->lastln))
+  {
+    gVCur->iDom2D = dom.i;
+    gVCur->values2D = val;
+    gVCur->gTabType2D = gTabType;
+    gVCur->vpe = (gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)?
+                 val.t->vpe: 1;
+    switch(dom.i->type)
+    {
+      case WLZ_INTERVALDOMAIN_INTVL:
+	gVCur->itvLn = dom.i->intvlines + line - dom.i->line1;
+	break;
+      case WLZ_INTERVALDOMAIN_RECT:
+	gVCur->rectItv.ileft = 0;
+	gVCur->rectItv.iright = dom.i->lastkl - dom.i->kol1;
+	gVCur->itvLn = &(gVCur->rectItvLn);
+	break;
+      default:
+	break;
+    }
+    if(gVCur->itvLn && (gVCur->itvLn->nintvs > 0))
+    {
+      /* Force the span to be found on the next query. */
+      gVCur->spanK0 = 1;
+      gVCur->spanK1 = 0;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Sets the cursor's span to that containing the given
+*		column on the cursor's current line. The interval search
+*		starts from the previous interval so that coherent
+*		queries only visit neighbouring intervals. The span is
+*		either a gap between intervals (background) or the part
+*		of an interval for which the values are contiguous.
+* \param	gVCur			Given grey value cursor which
+* 					must have a valid interval line
+* 					with at least one interval.
+* \param	kol			Column coordinate.
+*/
+static void	WlzGreyValueCursorSetSpan(WlzGreyValueCursor *gVCur,
+					  int kol)
+{
+  int		idx,
+		nItv,
+		kol1,
+		kolRel;
+  WlzInterval	*itv;
+
+  kol1 = gVCur->iDom2D->kol1;
+  kolRel = kol - kol1;
+  nItv = gVCur->itvLn->nintvs;
+  itv = gVCur->itvLn->intvs;
+  idx = ALG_MIN(gVCur->itvIdx, nItv - 1);
+  while((idx > 0) && (kolRel < itv[idx].ileft))
+  {
+    --idx;
+  }
+  while((idx < nItv - 1) && (kolRel > itv[idx].iright))
+  {
+    ++idx;
+  }
+  gVCur->itvIdx = idx;
+  gVCur->spanP.v = NULL;
+  if(kolRel < itv[idx].ileft)
+  {
+    gVCur->spanK0 = (idx > 0)? kol1 + itv[idx - 1].iright + 1: INT_MIN;
+    gVCur->spanK1 = kol1 + itv[idx].ileft - 1;
+  }
+  else if(kolRel > itv[idx].iright)
+  {
+    gVCur->spanK0 = kol1 + itv[idx].iright + 1;
+    gVCur->spanK1 = (idx < nItv - 1)? kol1 + itv[idx + 1].ileft - 1: INT_MAX;
+  }
+  else
+  {
+    gVCur->spanK0 = kol1 + itv[idx].ileft;
+    gVCur->spanK1 = kol1 + itv[idx].iright;
+    WlzGreyValueCursorSetSpanValues(gVCur, kol);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Given that the cursor's span has been set to the domain
+*		interval containing the given column, this function
+*		restricts the span to the columns for which the values
+*		are contiguous and sets the span's value pointer. If no
+*		values are found then the span is set to just the given
+*		column with a background value.
+* \param	gVCur			Given grey value cursor.
+* \param	kol			Column coordinate.
+*/
+static void	WlzGreyValueCursorSetSpanValues(WlzGreyValueCursor *gVCur,
+					        int kol)
+{
+  int		line;
+  size_t	offset = 0;
+  WlzGreyP	baseGVP;
+
+  baseGVP.v = NULL;
+  line = gVCur->line;
+  switch(gVCur->gTabType2D)
+  {
+    case WLZ_GREY_TAB_RAGR:
+      {
+	WlzRagRValues *vR;
+        WlzValueLine *vLn;
+
+	vR = gVCur->values2D.v;
+	vLn = vR->vtblines + line - vR->line1;
+	baseGVP = vLn->values;
+	offset = gVCur->spanK0 - vR->kol1 - vLn->vkol1;
+      }
+      break;
+    case WLZ_GREY_TAB_RECT:
+      {
+        WlzRectValues *vR;
+
+	vR = gVCur->values2D.r;
+	baseGVP = vR->values;
+	offset = (vR->width * (line - vR->line1)) +
+	         gVCur->spanK0 - vR->kol1;
+      }
+      break;
+    case WLZ_GREY_TAB_INTL:
+      {
+	int	cnt,
+		kol0;
+	WlzIntervalValues *vI;
+	WlzValueLine *vLn;
+	WlzValueIntervalLine *vILn;
+
+	vI = gVCur->values2D.i;
+	kol0 = kol - vI->kol1;
+	vILn = vI->vil + line - vI->line1;
+	vLn = vILn->vtbint;
+	for(cnt = vILn->nintvs; cnt > 0; --cnt)
+	{
+	  if((kol0 >= vLn->vkol1) && (kol0 <= vLn->vlastkl))
+	  {
+	    gVCur->spanK0 = ALG_MAX(gVCur->spanK0, vI->kol1 + vLn->vkol1);
+	    gVCur->spanK1 = ALG_MIN(gVCur->spanK1, vI->kol1 + vLn->vlastkl);
+	    baseGVP = vLn->values;
+	    offset = gVCur->spanK0 - vI->kol1 - vLn->vkol1;
+	    break;
+	  }
+	  ++vLn;
+	}
+      }
+      break;
+    case WLZ_GREY_TAB_TILED:
+      {
+	int	tW,
+		tK0;
+	WlzTiledValues *vT;
+
+	vT = gVCur->values2D.t;
+	tW = (int )(vT->tileWidth);
+	tK0 = vT->kol1 + (((kol - vT->kol1) / tW) * tW);
+	gVCur->spanK0 = ALG_MAX(gVCur->spanK0, tK0);
+	gVCur->spanK1 = ALG_MIN(gVCur->spanK1, tK0 + tW - 1);
+	if(vT->dim == 2)
+	{
+	  WlzGreyValueComputeGreyPTiled2D(&baseGVP, &offset, vT,
+	  				  &(gVCur->tile), line, gVCur->spanK0);
+	}
+	else
+	{
+	  WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset, vT,
+	  				  &(gVCur->tile), gVCur->plane, line,
+					  gVCur->spanK0);
+	}
+      }
+      break;
+    default:
+      break;
+  }
+  if(baseGVP.v == NULL)
+  {
+    gVCur->spanK0 = gVCur->spanK1 = kol;
+  }
+  else
+  {
+    switch(gVCur->gVWSp->gType)
+    {
+      case WLZ_GREY_LONG:
+	gVCur->spanP.lnp = baseGVP.lnp + offset;
+	break;
+      case WLZ_GREY_INT:
+	gVCur->spanP.inp = baseGVP.inp + offset;
+	break;
+      case WLZ_GREY_SHORT:
+	gVCur->spanP.shp = baseGVP.shp + offset;
+	break;
+      case WLZ_GREY_UBYTE:
+	gVCur->spanP.ubp = baseGVP.ubp + offset;
+	break;
+      case WLZ_GREY_FLOAT:
+	gVCur->spanP.flp = baseGVP.flp + offset;
+	break;
+      case WLZ_GREY_DOUBLE:
+	gVCur->spanP.dbp = baseGVP.dbp + offset;
+	break;
+      case WLZ_GREY_RGBA:
+	gVCur->spanP.rgbp = baseGVP.rgbp + offset;
+	break;
+      default:
+        gVCur->spanK0 = gVCur->spanK1 = kol;
+	break;
+    }
+  }
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -1022,7 +1740,7 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
       break;
     case WLZ_GREY_TAB_TILED:
       WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp->values.t,
-                                      line, kol);
+                                      &(gVWSp->tile), line, kol);
       break;
     default:
       break;
@@ -1045,6 +1763,7 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
 */
 static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 				size_t *offset, WlzTiledValues *tVal,
+				WlzTiledValuesTile **tileP,
 				int line, int kol)
 {
   WlzIVertex2 	rPos,
@@ -1084,8 +1803,7 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 	tOff.vtX = rPos.vtX % tVal->tileWidth;
 	tOff.vtY = rPos.vtY % tVal->tileWidth;
 	off = (tOff.vtY * tVal->tileWidth) + tOff.vtX;
-	(*baseGVP).v = tVal->tiles.v;
-	*offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	WlzGreyValueComputeGreyPTile(baseGVP, offset, tVal, tileP, idx, off);
       }
     }
   }
@@ -1108,6 +1826,7 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 */
 static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 				size_t *offset, WlzTiledValues *tVal,
+				WlzTiledValuesTile **tileP,
 				int plane, int line, int kol)
 {
   WlzIVertex3 	rPos,
@@ -1158,14 +1877,101 @@ static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 	  tOff.vtZ = rPos.vtZ % tVal->tileWidth;
 	  off = ((tOff.vtZ * tVal->tileWidth + tOff.vtY) * tVal->tileWidth) +
 	        tOff.vtX;
-	  (*baseGVP).v = tVal->tiles.v;
-	  *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	  WlzGreyValueComputeGreyPTile(baseGVP, offset, tVal, tileP, idx, off);
 	}
       }
     }
   }
 }
 
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Computes the base pointer and offset for a value within
+*		a tile of a tiled value table. If the tiles are compressed
+*		then the tile is got (replacing any other tile held) and
+*		the base pointer is that of the tile's values.
+* \param	baseGVP			Destination pointer for the
+*                                       base pointer, set to NULL if
+*                                       the tile can not be got.
+* \param	offset			Destination pointer for the
+*                                       offset from base pointer.
+* \param	tVal			Tiled value table.
+* \param	tileP			Held tile for compressed tiles.
+* \param	idx			Tile index.
+* \param	off			Offset of the element within the tile.
+*/
+static void	WlzGreyValueComputeGreyPTile(WlzGreyP *baseGVP,
+				size_t *offset, WlzTiledValues *tVal,
+				WlzTiledValuesTile **tileP,
+				size_t idx, size_t off)
+{
+  if(tVal->cmp == NULL)
+  {
+    (*baseGVP).v = tVal->tiles.v;
+    *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+  }
+  else
+  {
+    if((*tileP == NULL) || ((*tileP)->idx != idx))
+    {
+      WlzTiledValuesTileRelease(*tileP);
+      *tileP = WlzTiledValuesTileGet(tVal, idx, NULL);
+    }
+    (*baseGVP).v = (*tileP)? (*tileP)->values.v: NULL;
+    *offset = off * tVal->vpe;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Sets the grey pointers of the work space to point to
+*		the work space's grey values.
+* \param	gVWSp			Grey value work space.
+* \param	count			Number of values/pointers.
+*/
+static void	WlzGreyValueSetPtrToVal(WlzGreyValueWSpace *gVWSp,
+					int count)
+{
+  int		idx;
+
+  for(idx = 0; idx < count; ++idx)
+  {
+    WlzGreyV	*gVP;
+    WlzGreyP	*gPP;
+
+    gVP = gVWSp->gVal + idx;
+    gPP = gVWSp->gPtr + idx;
+    switch(gVWSp->gType)
+    {
+      case WLZ_GREY_LONG:
+	(*gPP).lnp = &((*gVP).lnv);
+	break;
+      case WLZ_GREY_INT:
+	(*gPP).inp = &((*gVP).inv);
+	break;
+      case WLZ_GREY_SHORT:
+	(*gPP).shp = &((*gVP).shv);
+	break;
+      case WLZ_GREY_UBYTE:
+	(*gPP).ubp = &((*gVP).ubv);
+	break;
+      case WLZ_GREY_FLOAT:
+	(*gPP).flp = &((*gVP).flv);
+	break;
+      case WLZ_GREY_DOUBLE:
+	(*gPP).dbp = &((*gVP).dbv);
+	break;
+      case WLZ_GREY_RGBA:
+	(*gPP).rgbp = &((*gVP).rgbv);
+	break;
+      default:
+	break;
+    }
+  }
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -1332,7 +2138,7 @@ static void	WlzGreyValueGet3DTiled(WlzGreyValueWSpace *gVWSp,
 	    WlzGreyP 	baseGVP;
 
 	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset,
-					    gVWSp->values.t,
+					    gVWSp->values.t, &(gVWSp->tile),
 					    plane, line, kol);
 	    WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
 				 baseGVP, offset);
@@ -1465,8 +2271,18 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 	    if(kol <= (gVWSp->iDom2D->lastkl - 1))
 	    {
 	      hitMsk |= 1 << ((pass * 2) + 1);
+	      if(gVWSp->gTabType2D == (WlzObjectType )WLZ_GREY_TAB_TILED)
+	      {
+		/* The next column may be in another tile. */
+		WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line,
+					   kol + 1);
+	      }
+	      else
+	      {
+		++offset;
+	      }
 	      WlzGreyValueSetGreyP(gVP + 1, gPP + 1, gVWSp->gType,
-				   baseGVP, offset + 1);
+				   baseGVP, offset);
 	    }
 	  }
 	  else		  /* gVWSp->iDom2D->type == WLZ_INTERVALDOMAIN_INTVL */
@@ -1494,8 +2310,18 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 		if(kol <= (itv->iright + kol1 - 1))
 		{
 		  hitMsk |= 1 << ((pass * 2) + 1);
+		  if(gVWSp->gTabType2D == (WlzObjectType )WLZ_GREY_TAB_TILED)
+		  {
+		    /* The next column may be in another tile. */
+		    WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp,
+		    			       line, kol + 1);
+		  }
+		  else
+		  {
+		    ++offset;
+		  }
 		  WlzGreyValueSetGreyP(gVP + 1, gPP + 1, gVWSp->gType,
-				       baseGVP, offset + 1);
+				       baseGVP, offset);
 		}
 	      }
 	      ++itv;
@@ -1754,13 +2580,25 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 	  }
 	  else
 	  {
+	    WlzGreyP	baseGVP;
+
             rPos.vtX = kol - tVal->kol1 + idK;
 	    tIdx.vtX = tIdx.vtY + (rPos.vtX / tVal->tileWidth);
             tOff.vtX = tOff.vtY + (rPos.vtX % tVal->tileWidth);
-            offset = (*(tVal->indices + tIdx.vtX) * tVal->tileSz +
-	              tOff.vtX) * tVal->vpe;
-	    WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
-	                         gVWSp->gType, tVal->tiles, offset);
+	    WlzGreyValueComputeGreyPTile(&baseGVP, &offset, tVal,
+	    				 &(gVWSp->tile),
+					 *(tVal->indices + tIdx.vtX),
+					 tOff.vtX);
+	    if(baseGVP.v == NULL)
+	    {
+	      WlzGreyValueSetBkdPN(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+				   gVWSp->gType, gVWSp->gBkd, 1);
+	    }
+	    else
+	    {
+	      WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+				   gVWSp->gType, baseGVP, offset);
+	    }
 	  }
 	  ++idV;
 	}
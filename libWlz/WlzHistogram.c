@@ -2968,6 +2968,7 @@ WlzErrorNum	WlzHistogramEqualiseObj(WlzObject *srcObj, int smoothing,
 	  }
           errNum = WlzHistogramMapValues(srcObj, histObj, dither);
 	}
+	(void )WlzFreeObj(histObj);
         break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
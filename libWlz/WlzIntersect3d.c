@@ -43,6 +43,10 @@ static char _WlzIntersect3d_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* function:     WlzIntersect3d    */
 /*! 
 * \ingroup      WlzBinaryOps
@@ -69,11 +73,11 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
   /* local variables */
   WlzObject 		**objlist, *newObj;
   WlzPlaneDomain 	*pdom, *newpdom;
-  WlzVoxelValues	*voxtab, *newvoxtab;
+  WlzVoxelValues	*newvoxtab;
   WlzDomain 		*domains, domain;
   WlzValues 		*values = NULL, vals;
   WlzPixelV		bgd;
-  int 			i, p, np, min_plane, max_plane, emptyFlag;
+  int 			i, p, min_plane, max_plane, nThr = 1;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* all objects have been checked by WlzIntersectN therefore do not need
@@ -154,8 +158,18 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
     return WlzMakeEmpty(wlzErr);
   }
 
-  /* allocate space for a working object array */
-  if( (objlist = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n)) == NULL){
+  /* allocate space for a working object array for each thread */
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  if( (objlist = (WlzObject **) AlcCalloc(nThr * n,
+  					   sizeof(WlzObject *))) == NULL){
     if(wlzErr) {
       *wlzErr = WLZ_ERR_MEM_ALLOC;
     }
@@ -163,89 +177,84 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
   }
   domain.core = NULL;
   vals.core = NULL;
-  for(i=0; (i < n) && (errNum == WLZ_ERR_NONE); i++){
+  for(i=0; (i < nThr * n) && (errNum == WLZ_ERR_NONE); i++){
     objlist[i] = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, vals, NULL, NULL,
     			     &errNum);
   }
-  if(errNum != WLZ_ERR_NONE) {
-    if(wlzErr) {
-      *wlzErr = errNum;
-    }
-    return NULL;
-  }
 
   /* make a new planedomain and valuetable if required */
-  newpdom = WlzMakePlaneDomain(pdom->type, min_plane, max_plane, 0, 0, 0, 0,
-  			       &errNum);
+  newpdom = NULL;
+  newvoxtab = NULL;
+  if(errNum == WLZ_ERR_NONE) {
+    newpdom = WlzMakePlaneDomain(pdom->type, min_plane, max_plane,
+    				 0, 0, 0, 0, &errNum);
+  }
   if(errNum == WLZ_ERR_NONE) {
     domains = newpdom->domains;
-    newvoxtab = NULL;
     if( uvt ){
       bgd.type = WLZ_GREY_INT;
       bgd.v.inv = 0;
       newvoxtab = WlzMakeVoxelValueTb((*objs)->values.vox->type, min_plane,
 				      max_plane, bgd, NULL, &errNum);
-      values = newvoxtab->values;
-    }
-  }
-  if(errNum != WLZ_ERR_NONE)
-  {
-    if(wlzErr) {
-      *wlzErr = errNum;
+      if(newvoxtab) {
+        values = newvoxtab->values;
+      }
     }
-    return NULL;
   }
 
-  /* find intersection at each plane */
-  for(p=min_plane; (p <= max_plane) && (errNum == WLZ_ERR_NONE); p++){
-    np = 0;
-    for(i=0; i < n; i++){
-      pdom = objs[i]->domain.p;
+  /* find intersection at each plane, in parallel */
+  if(errNum == WLZ_ERR_NONE) {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic, 1)
+#endif
+    for(p=min_plane; p <= max_plane; p++){
+      int		i2, np, thrId = 0;
+      WlzObject		**plObjs, *plObj = NULL;
+      WlzErrorNum	errNum2 = WLZ_ERR_NONE;
 
-      objlist[np]->domain.i = (pdom->domains)[p - pdom->plane1].i;
-      if( uvt ){
-	voxtab = objs[i]->values.vox;
-	objlist[np]->values.v = (voxtab->values)[p - voxtab->plane1].v;
-      }
-      if( objlist[np]->domain.i ){
-	np++;
-      }
-    }
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      plObjs = objlist + thrId * n;
+      np = 0;
+      for(i2=0; i2 < n; i2++){
+	WlzPlaneDomain	*pdom2;
+	WlzVoxelValues	*voxtab2;
 
-    newObj = NULL;
-    if( np == n ){
-      newObj = WlzIntersectN(np, objlist, uvt, &errNum);
-    }
-    else {
-      newObj = WlzMakeEmpty(NULL);
-    }
-    if(newObj) {
-      emptyFlag = (newObj->type == WLZ_EMPTY_OBJ);
-    }
-    else {
-      if(wlzErr) {
-	*wlzErr = errNum;
+	pdom2 = objs[i2]->domain.p;
+	plObjs[np]->domain.i = (pdom2->domains)[p - pdom2->plane1].i;
+	if( uvt ){
+	  voxtab2 = objs[i2]->values.vox;
+	  plObjs[np]->values.v = (voxtab2->values)[p - voxtab2->plane1].v;
+	}
+	if( plObjs[np]->domain.i ){
+	  np++;
+	}
       }
-      return NULL;
-    }
 
-    if(emptyFlag){
-      domains[p - min_plane].core = NULL;
-      if( uvt ){
-	values[p - min_plane].core = NULL;
+      if( np == n ){
+	plObj = WlzIntersectN(np, plObjs, uvt, &errNum2);
       }
-    }
-    else {
-      domains[p - min_plane] = WlzAssignDomain(newObj->domain, &errNum);
-
-
-
-
-      if(uvt && (errNum == WLZ_ERR_NONE)){
-	values[p - min_plane] = WlzAssignValues(newObj->values, &errNum);
+      if( plObj && (plObj->type != WLZ_EMPTY_OBJ) ){
+	domains[p - min_plane] = WlzAssignDomain(plObj->domain, &errNum2);
+	if(uvt && (errNum2 == WLZ_ERR_NONE)){
+	  values[p - min_plane] = WlzAssignValues(plObj->values, &errNum2);
+	}
+      }
+      (void )WlzFreeObj(plObj);
+      if(errNum2 != WLZ_ERR_NONE) {
+#ifdef _OPENMP
+#pragma omp critical (WlzIntersect3d)
+	{
+	  if(errNum == WLZ_ERR_NONE) {
+	    errNum = errNum2;
+	  }
+	}
+#else
+	errNum = errNum2;
+#endif
       }
     }
-    WlzFreeObj(newObj);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -263,10 +272,16 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
   }
   else {
     newObj = NULL;
+    if(newpdom) {
+      (void )WlzFreePlaneDomain(newpdom);
+    }
+    if(newvoxtab) {
+      (void )WlzFreeVoxelValueTb(newvoxtab);
+    }
   }
 
   /* free allocated memory and return */
-  for(i=0; i < n; i++){
+  for(i=0; i < nThr * n; i++){
     AlcFree(objlist[i]);
   }
   AlcFree( objlist );
@@ -0,0 +1,1156 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzLabelParallel_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzLabelParallel.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Parallel labeling (segmentation) of 2D and 3D domain
+* 		objects using a union-find tree over their intervals.
+* \ingroup	WlzBinaryOps
+*/
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <string.h>
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzLabelPItvTb
+* \ingroup	WlzBinaryOps
+* \brief	Flat table of all the intervals of a 2D or 3D domain in
+* 		raster order (plane, line then column). Each plane has
+* 		the same number of lines so that a global line index
+* 		\f$g = p n_l + l\f$ identifies a line of a plane.
+*/
+typedef struct _WlzLabelPItvTb
+{
+  int		nPln;		/*!< Number of planes, 1 for 2D. */
+  int		plane1;		/*!< First plane. */
+  int		nLn;		/*!< Number of lines in each plane. */
+  int		line1;		/*!< First line of all planes. */
+  int		nItv;		/*!< Total number of intervals. */
+  int		*lnOff;		/*!< Offsets of the first interval of each
+  				     global line, with nPln * nLn + 1
+				     entries. */
+  int		*itvG;		/*!< Global line index of each interval. */
+  WlzInterval	*itv;		/*!< Intervals with absolute columns. */
+} WlzLabelPItvTb;
+
+/*!
+* \struct	_WlzLabelPCmp
+* \ingroup	WlzBinaryOps
+* \brief	Extent and output order of a connected component, these
+* 		are only valid at the component's root interval.
+*/
+typedef struct _WlzLabelPCmp
+{
+  int		nItv;		/*!< Number of intervals in the component. */
+  int		line1;		/*!< First line, relative to the table. */
+  int		lastln;		/*!< Last line, relative to the table. */
+  int		kol1;		/*!< First column. */
+  int		lastkl;		/*!< Last column. */
+  int		lastG;		/*!< Last global line of the component. */
+  int		key;		/*!< Index of the first interval on the last
+  				     global line, which orders the output. */
+  int		obj;		/*!< Output object index or -1 if none. */
+} WlzLabelPCmp;
+
+static void			WlzLabelPItvTbFree(
+				  WlzLabelPItvTb *tb);
+static void			WlzLabelPUnionLn(
+				  AlcUFTree *uft,
+				  WlzLabelPItvTb *tb,
+				  int gA,
+				  int gB,
+				  int slack,
+				  char *drop);
+static void			WlzLabelPUnionPln(
+				  AlcUFTree *uft,
+				  WlzLabelPItvTb *tb,
+				  int p,
+				  int slack,
+				  char *drop);
+static WlzIntervalDomain	*WlzLabelPIDom(
+				  WlzLabelPItvTb *tb,
+				  int n,
+				  int *idx,
+				  WlzErrorNum *dstErr);
+static WlzPlaneDomain		*WlzLabelPPDom(
+				  WlzLabelPItvTb *tb,
+				  int n,
+				  int *idx,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzLabelPItvTbMake(
+				  WlzLabelPItvTb *tb,
+				  WlzObject *obj);
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Segments a domain into connected parts in the same way
+* 		as WlzLabel() but labels blocks of lines (and in 3D blocks
+* 		of planes) in parallel. Every interval of the domain is a
+* 		node of a union-find tree, the intervals within each
+* 		block are joined concurrently since the blocks have
+* 		disjoint components and then the seams between the
+* 		blocks are merged.
+*
+* 		The objects are returned in the same order as WlzLabel()
+* 		for 2D objects, ie ordered by the line on which they end
+* 		and then by the column of their first interval on that
+* 		line. This ordering is extended to 3D objects using the
+* 		plane on which they end. The maxNumObjs and ignlns
+* 		parameters have the same meanings as for WlzLabel():
+* 		For 2D objects, if there are more than maxNumObjs objects
+* 		then WLZ_ERR_PARAM_DATA is returned along with the first
+* 		maxNumObjs objects, while for 3D objects
+* 		WLZ_ERR_DOMAIN_DATA is returned with no objects. For 3D
+* 		objects the ignlns parameter is applied to the 2D
+* 		fragments of each plane before they are joined.
+* 		As with WlzLabel3D() 18-connectivity is treated as
+* 		26-connectivity.
+* \param	obj			Input object to be segmented.
+* \param	dstNObj			Destination pointer for the number
+* 					of objects.
+* \param	dstObjs			Destination pointer for the object
+* 					array, allocated in this function.
+* \param	maxNumObjs		Maximum number of objects to return
+* 					(determines the size of the array).
+* \param	ignlns			Ignore objects with num lines or
+* 					columns <= ignlns.
+* \param	connect			Connectivity to determine connected
+* 					regions.
+*/
+WlzErrorNum			WlzLabelParallel(
+				  WlzObject *obj,
+				  int *dstNObj,
+				  WlzObject ***dstObjs,
+				  int maxNumObjs,
+				  int ignlns,
+				  WlzConnectType connect)
+{
+  int		nG = 0,
+		nObj = 0,
+  		nOut = 0,
+		nThr = 1,
+		done = 0,
+		slack2 = 0,
+		slack3 = 0;
+  int		*rt = NULL,
+  		*objOff = NULL,
+		*objItv = NULL;
+  char		*drop = NULL;
+  AlcUFTree	*uft = NULL;
+  WlzLabelPCmp	*cmp = NULL;
+  WlzDomain	*oDom = NULL;
+  WlzObject	**objs = NULL;
+  WlzLabelPItvTb tb;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&tb, 0, sizeof(WlzLabelPItvTb));
+  if((objs = (WlzObject **)AlcCalloc((maxNumObjs > 0)? maxNumObjs: 1,
+  				     sizeof(WlzObject *))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    *dstObjs = objs;
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    /* Do nothing, no object array. */
+  }
+  else if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else
+	{
+	  switch(obj->domain.core->type)
+	  {
+	    case WLZ_INTERVALDOMAIN_INTVL:
+	      break;
+	    case WLZ_INTERVALDOMAIN_RECT:
+	      done = 1;
+	      if((obj->domain.i->lastln - obj->domain.i->line1) >= ignlns)
+	      {
+		if(maxNumObjs < 1)
+		{
+		  errNum = WLZ_ERR_INT_DATA;
+		}
+		else
+		{
+		  objs[0] = WlzAssignObject(
+			    WlzMakeMain(obj->type, obj->domain, obj->values,
+					NULL, NULL, &errNum), NULL);
+		  nOut = (errNum == WLZ_ERR_NONE)? 1: 0;
+		}
+	      }
+	      break;
+	    default:
+	      errNum = WLZ_ERR_DOMAIN_TYPE;
+	      break;
+	  }
+	}
+	if((errNum == WLZ_ERR_NONE) && !done)
+	{
+	  switch(connect)
+	  {
+	    case WLZ_4_CONNECTED:
+	      slack2 = 0;
+	      break;
+	    case WLZ_8_CONNECTED:
+	      slack2 = 1;
+	      break;
+	    default:
+	      errNum = WLZ_ERR_PARAM_DATA;
+	      break;
+	  }
+	}
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else if((obj->values.core != NULL) &&
+		(obj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+	else
+	{
+	  switch(connect)
+	  {
+	    case WLZ_4_CONNECTED:  /* FALLTHROUGH */
+	    case WLZ_6_CONNECTED:
+	      slack2 = 0;
+	      slack3 = 0;
+	      break;
+	    case WLZ_8_CONNECTED:  /* FALLTHROUGH */
+	    case WLZ_18_CONNECTED: /* FALLTHROUGH */
+	    case WLZ_26_CONNECTED:
+	      slack2 = 1;
+	      slack3 = 1;
+	      break;
+	    default:
+	      errNum = WLZ_ERR_PARAM_DATA;
+	      break;
+	  }
+	}
+        break;
+      case WLZ_EMPTY_OBJ:
+        done = 1;
+	break;
+      case WLZ_TRANS_OBJ:
+        errNum = WLZ_ERR_UNIMPLEMENTED;
+	break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  /* Build the interval table and the union-find tree. */
+  if((errNum == WLZ_ERR_NONE) && !done)
+  {
+    errNum = WlzLabelPItvTbMake(&tb, obj);
+    if((errNum == WLZ_ERR_NONE) && (tb.nItv < 1))
+    {
+      done = 1;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !done)
+  {
+    nG = tb.nPln * tb.nLn;
+    if(((uft = AlcUFTreeNew(tb.nItv, tb.nItv)) == NULL) ||
+       ((rt = (int *)AlcMalloc(sizeof(int) * tb.nItv)) == NULL) ||
+       ((cmp = (WlzLabelPCmp *)
+               AlcCalloc(tb.nItv, sizeof(WlzLabelPCmp))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+  }
+  /* Join the intervals of adjacent lines within each plane. Each block
+   * of global lines starts with only singleton components so the blocks
+   * are disjoint and can be joined in parallel, the seams between them
+   * are then merged. */
+  if((errNum == WLZ_ERR_NONE) && !done)
+  {
+    int		b,
+    		nBlk,
+		bSz;
+
+    nBlk = (nG < 4 * nThr)? nG: 4 * nThr;
+    bSz = (nG + nBlk - 1) / nBlk;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(b = 0; b < nBlk; ++b)
+    {
+      int	g,
+      		g0,
+		g1;
+
+      g0 = b * bSz;
+      g1 = (g0 + bSz < nG)? g0 + bSz: nG;
+      for(g = g0 + 1; g < g1; ++g)
+      {
+        if((g % tb.nLn) != 0)
+	{
+	  WlzLabelPUnionLn(uft, &tb, g - 1, g, slack2, NULL);
+	}
+      }
+    }
+    for(b = 1; b < nBlk; ++b)
+    {
+      int	g;
+
+      g = b * bSz;
+      if((g < nG) && ((g % tb.nLn) != 0))
+      {
+	WlzLabelPUnionLn(uft, &tb, g - 1, g, slack2, NULL);
+      }
+    }
+  }
+  /* In 3D small fragments are ignored within each plane before the
+   * planes are joined, as for WlzLabel3D(). Components can not yet
+   * span planes so each plane can be processed in parallel. */
+  if((errNum == WLZ_ERR_NONE) && !done &&
+     (obj->type == WLZ_3D_DOMAINOBJ) && (ignlns > 0))
+  {
+    if((drop = (char *)AlcCalloc(tb.nItv, sizeof(char))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for(p = 0; p < tb.nPln; ++p)
+      {
+        int	i,
+		i0,
+		i1;
+
+	i0 = tb.lnOff[p * tb.nLn];
+	i1 = tb.lnOff[(p + 1) * tb.nLn];
+	for(i = i0; i < i1; ++i)
+	{
+	  int	l;
+	  WlzLabelPCmp *c;
+
+	  l = tb.itvG[i];
+	  rt[i] = AlcUFTreeFind(uft, i);
+	  c = cmp + rt[i];
+	  if(c->nItv++ == 0)
+	  {
+	    c->line1 = l;
+	    c->kol1 = tb.itv[i].ileft;
+	    c->lastkl = tb.itv[i].iright;
+	  }
+	  else
+	  {
+	    c->kol1 = ALG_MIN(c->kol1, tb.itv[i].ileft);
+	    c->lastkl = ALG_MAX(c->lastkl, tb.itv[i].iright);
+	  }
+	  c->lastln = l;
+	}
+	for(i = i0; i < i1; ++i)
+	{
+	  WlzLabelPCmp *c;
+
+	  c = cmp + rt[i];
+	  drop[i] = (char )(((c->lastln - c->line1) < ignlns) ||
+	                    ((c->lastkl - c->kol1) < ignlns));
+	}
+      }
+      (void )memset(cmp, 0, tb.nItv * sizeof(WlzLabelPCmp));
+    }
+  }
+  /* Join the intervals of adjacent planes, again in disjoint blocks
+   * followed by the seams between them. */
+  if((errNum == WLZ_ERR_NONE) && !done && (tb.nPln > 1))
+  {
+    int		b,
+    		nBlk,
+		bSz;
+
+    nBlk = (tb.nPln < 4 * nThr)? tb.nPln: 4 * nThr;
+    bSz = (tb.nPln + nBlk - 1) / nBlk;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(b = 0; b < nBlk; ++b)
+    {
+      int	p,
+      		p0,
+		p1;
+
+      p0 = b * bSz;
+      p1 = (p0 + bSz < tb.nPln)? p0 + bSz: tb.nPln;
+      for(p = p0 + 1; p < p1; ++p)
+      {
+	WlzLabelPUnionPln(uft, &tb, p, slack3, drop);
+      }
+    }
+    for(b = 1; b < nBlk; ++b)
+    {
+      int	p;
+
+      p = b * bSz;
+      if(p < tb.nPln)
+      {
+	WlzLabelPUnionPln(uft, &tb, p, slack3, drop);
+      }
+    }
+  }
+  /* Find the component of every interval, then the extent and output
+   * order of each component. */
+  if((errNum == WLZ_ERR_NONE) && !done)
+  {
+    int		i;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(i = 0; i < tb.nItv; ++i)
+    {
+      rt[i] = AlcUFTreeFind(uft, i);
+    }
+    AlcUFTreeFree(uft);
+    uft = NULL;
+    for(i = 0; i < tb.nItv; ++i)
+    {
+      if((drop == NULL) || (drop[i] == 0))
+      {
+	int	g,
+		l;
+	WlzLabelPCmp *c;
+
+	g = tb.itvG[i];
+	l = g % tb.nLn;
+	c = cmp + rt[i];
+	if(c->nItv++ == 0)
+	{
+	  c->line1 = c->lastln = l;
+	  c->kol1 = tb.itv[i].ileft;
+	  c->lastkl = tb.itv[i].iright;
+	  c->lastG = g;
+	  c->key = i;
+	}
+	else
+	{
+	  c->line1 = ALG_MIN(c->line1, l);
+	  c->lastln = ALG_MAX(c->lastln, l);
+	  c->kol1 = ALG_MIN(c->kol1, tb.itv[i].ileft);
+	  c->lastkl = ALG_MAX(c->lastkl, tb.itv[i].iright);
+	  if(g != c->lastG)
+	  {
+	    c->lastG = g;
+	    c->key = i;
+	  }
+	}
+      }
+    }
+    /* Visiting the intervals in raster order gives the output order,
+     * a component being output at the first interval of its last
+     * line. */
+    for(i = 0; i < tb.nItv; ++i)
+    {
+      WlzLabelPCmp *c;
+
+      c = cmp + rt[i];
+      if(((drop == NULL) || (drop[i] == 0)) && (c->key == i))
+      {
+	c->obj = -1;
+	if((obj->type == WLZ_3D_DOMAINOBJ) ||
+	   (((c->lastln - c->line1) >= ignlns) &&
+	    ((c->lastkl - c->kol1) >= ignlns)))
+	{
+	  c->obj = nObj++;
+	}
+      }
+    }
+    nOut = nObj;
+    if(nObj > maxNumObjs)
+    {
+      if(obj->type == WLZ_2D_DOMAINOBJ)
+      {
+        nOut = (maxNumObjs > 0)? maxNumObjs: 0;
+	errNum = WLZ_ERR_PARAM_DATA;
+      }
+      else
+      {
+        nOut = 0;
+	errNum = WLZ_ERR_DOMAIN_DATA;
+      }
+    }
+  }
+  /* Sort the intervals by output object, keeping them in raster order. */
+  if(((errNum == WLZ_ERR_NONE) || (errNum == WLZ_ERR_PARAM_DATA)) &&
+     !done && (nOut > 0))
+  {
+    if(((objOff = (int *)AlcCalloc(nOut + 1, sizeof(int))) == NULL) ||
+       ((objItv = (int *)AlcMalloc(tb.nItv * sizeof(int))) == NULL) ||
+       ((oDom = (WlzDomain *)AlcCalloc(nOut, sizeof(WlzDomain))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	i,
+      		o;
+
+      for(i = 0; i < tb.nItv; ++i)
+      {
+	if((drop == NULL) || (drop[i] == 0))
+	{
+	  o = cmp[rt[i]].obj;
+	  if((o >= 0) && (o < nOut))
+	  {
+	    ++(objOff[o + 1]);
+	  }
+	}
+      }
+      for(o = 0; o < nOut; ++o)
+      {
+        objOff[o + 1] += objOff[o];
+      }
+      for(i = 0; i < tb.nItv; ++i)
+      {
+	if((drop == NULL) || (drop[i] == 0))
+	{
+	  o = cmp[rt[i]].obj;
+	  if((o >= 0) && (o < nOut))
+	  {
+	    objItv[objOff[o]++] = i;
+	  }
+	}
+      }
+      for(o = nOut; o > 0; --o)
+      {
+        objOff[o] = objOff[o - 1];
+      }
+      objOff[0] = 0;
+    }
+  }
+  /* Build the domains of the labeled objects in parallel. */
+  if(((errNum == WLZ_ERR_NONE) || (errNum == WLZ_ERR_PARAM_DATA)) &&
+     !done && (nOut > 0))
+  {
+    int		o;
+    WlzErrorNum	errNum1 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for(o = 0; o < nOut; ++o)
+    {
+      if(errNum1 == WLZ_ERR_NONE)
+      {
+	int	  n;
+	int	  *idx;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	n = objOff[o + 1] - objOff[o];
+	idx = objItv + objOff[o];
+	if(obj->type == WLZ_2D_DOMAINOBJ)
+	{
+	  oDom[o].i = WlzLabelPIDom(&tb, n, idx, &errNum2);
+	}
+	else
+	{
+	  oDom[o].p = WlzLabelPPDom(&tb, n, idx, &errNum2);
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzLabelParallel)
+	  {
+	    if(errNum1 == WLZ_ERR_NONE)
+	    {
+	      errNum1 = errNum2;
+	    }
+	  }
+#else
+	  errNum1 = errNum2;
+#endif
+	}
+      }
+    }
+    if(errNum1 != WLZ_ERR_NONE)
+    {
+      errNum = errNum1;
+    }
+  }
+  /* Make the objects, this is not done in parallel because the given
+   * object and its values are shared by the new objects. */
+  if(((errNum == WLZ_ERR_NONE) || (errNum == WLZ_ERR_PARAM_DATA)) &&
+     !done && (nOut > 0))
+  {
+    int		o;
+    WlzPixelV	bgdV;
+    WlzErrorNum	errNum1 = WLZ_ERR_NONE;
+
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    if((obj->type == WLZ_3D_DOMAINOBJ) && (obj->values.core != NULL))
+    {
+      bgdV = WlzGetBackground(obj, &errNum1);
+    }
+    for(o = 0; (errNum1 == WLZ_ERR_NONE) && (o < nOut); ++o)
+    {
+      WlzValues	val;
+
+      val.core = NULL;
+      if(obj->type == WLZ_2D_DOMAINOBJ)
+      {
+        objs[o] = WlzAssignObject(
+		  WlzMakeMain(WLZ_2D_DOMAINOBJ, oDom[o], obj->values,
+		              NULL, obj, &errNum1), NULL);
+      }
+      else
+      {
+	WlzPlaneDomain *gPDom,
+		       *nPDom;
+
+	gPDom = obj->domain.p;
+	nPDom = oDom[o].p;
+	nPDom->voxel_size[0] = gPDom->voxel_size[0];
+	nPDom->voxel_size[1] = gPDom->voxel_size[1];
+	nPDom->voxel_size[2] = gPDom->voxel_size[2];
+	if(obj->values.core != NULL)
+	{
+	  val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+				        nPDom->plane1, nPDom->lastpl,
+				        bgdV, NULL, &errNum1);
+	  if(errNum1 == WLZ_ERR_NONE)
+	  {
+	    int	p;
+
+	    for(p = nPDom->plane1; p <= nPDom->lastpl; ++p)
+	    {
+	      val.vox->values[p - nPDom->plane1] = WlzAssignValues(
+	          obj->values.vox->values[p - gPDom->plane1], NULL);
+	    }
+	  }
+	}
+	if(errNum1 == WLZ_ERR_NONE)
+	{
+	  objs[o] = WlzAssignObject(
+		    WlzMakeMain(WLZ_3D_DOMAINOBJ, oDom[o], val,
+				NULL, NULL, &errNum1), NULL);
+	}
+	if((objs[o] == NULL) && (val.core != NULL))
+	{
+	  (void )WlzFreeVoxelValueTb(val.vox);
+	}
+      }
+      if(objs[o] != NULL)
+      {
+        oDom[o].core = NULL;
+      }
+    }
+    if(errNum1 != WLZ_ERR_NONE)
+    {
+      errNum = errNum1;
+    }
+  }
+  if(oDom)
+  {
+    int		o;
+
+    for(o = 0; o < nOut; ++o)
+    {
+      if(oDom[o].core)
+      {
+        (void )WlzFreeDomain(oDom[o]);
+      }
+    }
+    AlcFree(oDom);
+  }
+  if((errNum != WLZ_ERR_NONE) && (errNum != WLZ_ERR_PARAM_DATA))
+  {
+    int		o;
+
+    for(o = 0; o < nOut; ++o)
+    {
+      (void )WlzFreeObj(objs[o]);
+      objs[o] = NULL;
+    }
+    nOut = 0;
+  }
+  AlcUFTreeFree(uft);
+  WlzLabelPItvTbFree(&tb);
+  AlcFree(rt);
+  AlcFree(cmp);
+  AlcFree(drop);
+  AlcFree(objOff);
+  AlcFree(objItv);
+  *dstNObj = nOut;
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Frees the arrays of an interval table.
+* \param	tb			Given interval table.
+*/
+static void			WlzLabelPItvTbFree(
+				  WlzLabelPItvTb *tb)
+{
+  AlcFree(tb->lnOff);
+  AlcFree(tb->itvG);
+  AlcFree(tb->itv);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the intervals of the two given global lines which
+* 		are connected, using a single sweep along both lines.
+* \param	uft			Union-find tree of the intervals.
+* \param	tb			Interval table.
+* \param	gA			First global line.
+* \param	gB			Second global line.
+* \param	slack			Zero for intervals which must
+* 					overlap and one for intervals
+* 					which may touch diagonally.
+* \param	drop			Intervals which must not be
+* 					joined, may be NULL.
+*/
+static void			WlzLabelPUnionLn(
+				  AlcUFTree *uft,
+				  WlzLabelPItvTb *tb,
+				  int gA,
+				  int gB,
+				  int slack,
+				  char *drop)
+{
+  int		iA,
+  		iB,
+		lA,
+		lB;
+  WlzInterval	*itv;
+
+  itv = tb->itv;
+  iA = tb->lnOff[gA];
+  lA = tb->lnOff[gA + 1];
+  iB = tb->lnOff[gB];
+  lB = tb->lnOff[gB + 1];
+  while((iA < lA) && (iB < lB))
+  {
+    if(itv[iA].iright + slack < itv[iB].ileft)
+    {
+      ++iA;
+    }
+    else if(itv[iB].iright + slack < itv[iA].ileft)
+    {
+      ++iB;
+    }
+    else
+    {
+      if((drop == NULL) || ((drop[iA] == 0) && (drop[iB] == 0)))
+      {
+        AlcUFTreeUnion(uft, iA, iB);
+      }
+      if(itv[iA].iright < itv[iB].iright)
+      {
+        ++iA;
+      }
+      else
+      {
+        ++iB;
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the intervals of the given plane to those of the
+* 		previous plane which are connected.
+* \param	uft			Union-find tree of the intervals.
+* \param	tb			Interval table.
+* \param	p			Given plane index, must be > 0.
+* \param	slack			Zero for 6-connectivity and one
+* 					for 26-connectivity.
+* \param	drop			Intervals which must not be
+* 					joined, may be NULL.
+*/
+static void			WlzLabelPUnionPln(
+				  AlcUFTree *uft,
+				  WlzLabelPItvTb *tb,
+				  int p,
+				  int slack,
+				  char *drop)
+{
+  int		l,
+  		g;
+
+  for(l = 0; l < tb->nLn; ++l)
+  {
+    g = p * tb->nLn + l;
+    if(tb->lnOff[g] < tb->lnOff[g + 1])
+    {
+      int	d,
+		d0,
+		d1;
+
+      d0 = (l - slack < 0)? -l: -slack;
+      d1 = (l + slack < tb->nLn)? slack: tb->nLn - 1 - l;
+      for(d = d0; d <= d1; ++d)
+      {
+	WlzLabelPUnionLn(uft, tb, g - tb->nLn + d, g, slack, drop);
+      }
+    }
+  }
+}
+
+/*!
+* \return	New interval domain or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes an interval domain from the given intervals, which
+* 		must all be in the same plane and be in raster order.
+* \param	tb			Interval table.
+* \param	n			Number of intervals, must be > 0.
+* \param	idx			Indices of the intervals in the
+* 					table.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzIntervalDomain	*WlzLabelPIDom(
+				  WlzLabelPItvTb *tb,
+				  int n,
+				  int *idx,
+				  WlzErrorNum *dstErr)
+{
+  int		j,
+  		j0,
+		kol1,
+		lastkl;
+  WlzInterval	*itv = NULL;
+  WlzIntervalDomain *idom = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  kol1 = tb->itv[idx[0]].ileft;
+  lastkl = tb->itv[idx[0]].iright;
+  for(j = 1; j < n; ++j)
+  {
+    kol1 = ALG_MIN(kol1, tb->itv[idx[j]].ileft);
+    lastkl = ALG_MAX(lastkl, tb->itv[idx[j]].iright);
+  }
+  idom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+			       tb->line1 + (tb->itvG[idx[0]] % tb->nLn),
+			       tb->line1 + (tb->itvG[idx[n - 1]] % tb->nLn),
+			       kol1, lastkl, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((itv = (WlzInterval *)AlcMalloc(n * sizeof(WlzInterval))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      idom->freeptr = AlcFreeStackPush(idom->freeptr, (void *)itv, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    j0 = 0;
+    for(j = 0; j < n; ++j)
+    {
+      itv[j].ileft = tb->itv[idx[j]].ileft - kol1;
+      itv[j].iright = tb->itv[idx[j]].iright - kol1;
+      if((j + 1 == n) || (tb->itvG[idx[j + 1]] != tb->itvG[idx[j0]]))
+      {
+        (void )WlzMakeInterval(tb->line1 + (tb->itvG[idx[j0]] % tb->nLn),
+			       idom, j + 1 - j0, itv + j0);
+	j0 = j + 1;
+      }
+    }
+  }
+  else if(idom)
+  {
+    (void )WlzFreeIntervalDomain(idom);
+    idom = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(idom);
+}
+
+/*!
+* \return	New plane domain or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes a plane domain from the given intervals, which must
+* 		be in raster order.
+* \param	tb			Interval table.
+* \param	n			Number of intervals, must be > 0.
+* \param	idx			Indices of the intervals in the
+* 					table.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzPlaneDomain		*WlzLabelPPDom(
+				  WlzLabelPItvTb *tb,
+				  int n,
+				  int *idx,
+				  WlzErrorNum *dstErr)
+{
+  int		j,
+  		j0,
+		line1,
+		lastln,
+		kol1,
+		lastkl;
+  WlzPlaneDomain *pdom = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  line1 = lastln = tb->itvG[idx[0]] % tb->nLn;
+  kol1 = tb->itv[idx[0]].ileft;
+  lastkl = tb->itv[idx[0]].iright;
+  for(j = 1; j < n; ++j)
+  {
+    int		l;
+
+    l = tb->itvG[idx[j]] % tb->nLn;
+    line1 = ALG_MIN(line1, l);
+    lastln = ALG_MAX(lastln, l);
+    kol1 = ALG_MIN(kol1, tb->itv[idx[j]].ileft);
+    lastkl = ALG_MAX(lastkl, tb->itv[idx[j]].iright);
+  }
+  pdom = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			    tb->plane1 + (tb->itvG[idx[0]] / tb->nLn),
+			    tb->plane1 + (tb->itvG[idx[n - 1]] / tb->nLn),
+			    tb->line1 + line1, tb->line1 + lastln,
+			    kol1, lastkl, &errNum);
+  j0 = 0;
+  while((errNum == WLZ_ERR_NONE) && (j0 < n))
+  {
+    int		p;
+    WlzDomain	dom;
+
+    p = tb->itvG[idx[j0]] / tb->nLn;
+    for(j = j0 + 1; (j < n) && (tb->itvG[idx[j]] / tb->nLn == p); ++j)
+    {
+      /* Find the end of this plane's intervals. */
+    }
+    dom.i = WlzLabelPIDom(tb, j - j0, idx + j0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      pdom->domains[tb->plane1 + p - pdom->plane1] =
+          WlzAssignDomain(dom, NULL);
+    }
+    j0 = j;
+  }
+  if((errNum != WLZ_ERR_NONE) && (pdom != NULL))
+  {
+    (void )WlzFreePlaneDomain(pdom);
+    pdom = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pdom);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Builds a table of all the intervals of the given 2D or 3D
+* 		domain object, counting and then copying the intervals
+* 		of the global lines in parallel.
+* \param	tb			Interval table to be filled, with all
+* 					pointers initially NULL.
+* \param	obj			Given 2D or 3D domain object with an
+* 					interval or plane domain.
+*/
+static WlzErrorNum		WlzLabelPItvTbMake(
+				  WlzLabelPItvTb *tb,
+				  WlzObject *obj)
+{
+  int		g,
+  		nG,
+		lastln;
+  WlzDomain	*doms;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    doms = &(obj->domain);
+    tb->nPln = 1;
+    tb->plane1 = 0;
+    tb->line1 = obj->domain.i->line1;
+    lastln = obj->domain.i->lastln;
+  }
+  else
+  {
+    int		p;
+    WlzPlaneDomain *pdom;
+
+    pdom = obj->domain.p;
+    doms = pdom->domains;
+    tb->nPln = pdom->lastpl - pdom->plane1 + 1;
+    tb->plane1 = pdom->plane1;
+    tb->line1 = pdom->line1;
+    lastln = pdom->lastln;
+    for(p = 0; (errNum == WLZ_ERR_NONE) && (p < tb->nPln); ++p)
+    {
+      WlzDomain	dom;
+
+      dom = doms[p];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	if((dom.core->type != WLZ_INTERVALDOMAIN_INTVL) &&
+	   (dom.core->type != WLZ_INTERVALDOMAIN_RECT))
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else
+	{
+	  tb->line1 = ALG_MIN(tb->line1, dom.i->line1);
+	  lastln = ALG_MAX(lastln, dom.i->lastln);
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tb->nLn = lastln - tb->line1 + 1;
+    nG = tb->nPln * tb->nLn;
+    if((tb->nLn < 1) ||
+       ((tb->lnOff = (int *)AlcMalloc((nG + 1) * sizeof(int))) == NULL))
+    {
+      errNum = (tb->nLn < 1)? WLZ_ERR_DOMAIN_DATA: WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tb->lnOff[0] = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(g = 0; g < nG; ++g)
+    {
+      int	l,
+		n = 0;
+      WlzDomain	dom;
+
+      dom = doms[g / tb->nLn];
+      l = tb->line1 + (g % tb->nLn);
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+         (l >= dom.i->line1) && (l <= dom.i->lastln))
+      {
+	n = (dom.core->type == WLZ_INTERVALDOMAIN_RECT)? 1:
+	    dom.i->intvlines[l - dom.i->line1].nintvs;
+      }
+      tb->lnOff[g + 1] = n;
+    }
+    for(g = 0; g < nG; ++g)
+    {
+      tb->lnOff[g + 1] += tb->lnOff[g];
+    }
+    tb->nItv = tb->lnOff[nG];
+    if(tb->nItv > 0)
+    {
+      if(((tb->itvG = (int *)AlcMalloc(tb->nItv * sizeof(int))) == NULL) ||
+	 ((tb->itv = (WlzInterval *)
+		     AlcMalloc(tb->nItv * sizeof(WlzInterval))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (tb->nItv > 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(g = 0; g < nG; ++g)
+    {
+      int	i,
+		k,
+		l;
+      WlzDomain	dom;
+
+      i = tb->lnOff[g];
+      if(i < tb->lnOff[g + 1])
+      {
+	dom = doms[g / tb->nLn];
+	l = tb->line1 + (g % tb->nLn);
+	if(dom.core->type == WLZ_INTERVALDOMAIN_RECT)
+	{
+	  tb->itvG[i] = g;
+	  tb->itv[i].ileft = dom.i->kol1;
+	  tb->itv[i].iright = dom.i->lastkl;
+	}
+	else
+	{
+	  WlzIntervalLine *itvLn;
+
+	  itvLn = dom.i->intvlines + l - dom.i->line1;
+	  for(k = 0; k < itvLn->nintvs; ++k)
+	  {
+	    tb->itvG[i + k] = g;
+	    tb->itv[i + k].ileft = itvLn->intvs[k].ileft + dom.i->kol1;
+	    tb->itv[i + k].iright = itvLn->intvs[k].iright + dom.i->kol1;
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
@@ -0,0 +1,1222 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzMergeN_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzMergeN.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	K-way merging of the intervals of many objects for
+* 		their union or intersection, together with a divide
+* 		and conquer pairwise reduction.
+* \ingroup	WlzBinaryOps
+*/
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <string.h>
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzMergeNSrc
+* \ingroup	WlzBinaryOps
+* \brief	Line access to the intervals of a 2D domain, which may be
+* 		either an interval or a rectangular domain.
+*/
+typedef struct _WlzMergeNSrc
+{
+  int		line1;		/*!< First line. */
+  int		lastln;		/*!< Last line. */
+  int		kol1;		/*!< First column, to which the intervals
+  				     are relative. */
+  WlzIntervalLine *itvLn;	/*!< Interval lines, NULL for a
+  				     rectangular domain. */
+  WlzInterval	rItv;		/*!< The interval of every line of a
+  				     rectangular domain. */
+} WlzMergeNSrc;
+
+/*!
+* \struct	_WlzMergeNWSp
+* \ingroup	WlzBinaryOps
+* \brief	Per thread workspace for merging the intervals of a line,
+* 		with a cursor for each object and a binary heap (tournament)
+* 		of the objects ordered by a key, or for dense lines a
+* 		buffer of counts which is swept along the line.
+*/
+typedef struct _WlzMergeNWSp
+{
+  WlzInterval	**cur;		/*!< Current interval of each object. */
+  int		*rem;		/*!< Intervals remaining on the line for
+  				     each object, including the current
+				     one. */
+  int		*key;		/*!< Heap key of each object. */
+  int		*hp;		/*!< Heap of object indices. */
+  int		*dif;		/*!< Change in the number of objects
+  				     covering each column, zero between
+				     uses. */
+} WlzMergeNWSp;
+
+extern WlzObject		*WlzMergeN2D(
+				  int n,
+				  WlzObject **objs,
+				  int uvt,
+				  int isect,
+				  WlzErrorNum *dstErr);
+static int			WlzMergeNLine(
+				  WlzMergeNSrc *src,
+				  int l,
+				  WlzInterval **dstItv);
+static int			WlzMergeNUnionLn(
+				  int n,
+				  WlzMergeNSrc *src,
+				  WlzMergeNWSp *wSp,
+				  int l,
+				  int kol1,
+				  WlzInterval *itv);
+static int			WlzMergeNIsectLn(
+				  int n,
+				  WlzMergeNSrc *src,
+				  WlzMergeNWSp *wSp,
+				  int l,
+				  int kol1,
+				  WlzInterval *itv);
+static int			WlzMergeNSweepLn(
+				  int n,
+				  WlzMergeNSrc *src,
+				  WlzMergeNWSp *wSp,
+				  int l,
+				  int kol1,
+				  int lastkl,
+				  int isect,
+				  WlzInterval *itv);
+static void			WlzMergeNHeapDown(
+				  int *hp,
+				  int nH,
+				  int *key,
+				  int i);
+static WlzErrorNum		WlzMergeNGrey(
+				  WlzObject *obj,
+				  int n,
+				  WlzObject **objs,
+				  int isect);
+
+/*!
+* \return	Union or intersection of the given objects, or NULL on
+* 		error.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the union or intersection of an array of 2D or
+* 		3D domain objects by divide and conquer: pairs of
+* 		objects are combined in parallel, then pairs of the
+* 		results and so on until a single object remains. This
+* 		needs only \f$\log_2 n\f$ sequential steps, each of which
+* 		is a union (or intersection) of just two objects, and
+* 		gives the same domain as WlzUnionN() (or WlzIntersectN())
+* 		but without values. Empty objects are ignored by the
+* 		union and give an empty intersection.
+* \param	n			Number of objects.
+* \param	objs			Array of objects, which must all be
+* 					either 2D or 3D domain objects or
+* 					empty objects.
+* \param	op			Either WLZ_BO_OR for the union or
+* 					WLZ_BO_AND for the intersection.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzMergeNReduce(
+		  int n,
+		  WlzObject **objs,
+		  WlzBinaryOperatorType op,
+		  WlzErrorNum *dstErr)
+{
+  int		i,
+  		nR = 0,
+		nPMax = 0,
+		isEmpty = 0;
+  WlzObject	*rObj = NULL;
+  WlzObject	**rObjs = NULL,
+  		**pObjs = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(n < 1)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(objs == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if((op != WLZ_BO_OR) && (op != WLZ_BO_AND))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((rObjs = (WlzObject **)
+                   AlcCalloc(n, sizeof(WlzObject *))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Empty objects are removed here so that no union or intersection
+   * of just one object (which shares the given object's domain) is
+   * made within the parallel loop. */
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < n); ++i)
+  {
+    if(objs[i] == NULL)
+    {
+      errNum = WLZ_ERR_OBJECT_NULL;
+    }
+    else if((objs[i]->type != WLZ_EMPTY_OBJ) &&
+            (objs[i]->type != WLZ_2D_DOMAINOBJ) &&
+            (objs[i]->type != WLZ_3D_DOMAINOBJ))
+    {
+      errNum = WLZ_ERR_OBJECT_TYPE;
+    }
+    else if((nR > 0) && (objs[i]->type != WLZ_EMPTY_OBJ) &&
+            (objs[i]->type != rObjs[0]->type))
+    {
+      errNum = WLZ_ERR_OBJECT_TYPE;
+    }
+    else if((objs[i]->type == WLZ_EMPTY_OBJ) ||
+            WlzIsEmpty(objs[i], &errNum))
+    {
+      isEmpty = 1;
+    }
+    else
+    {
+      rObjs[nR++] = WlzAssignObject(objs[i], NULL);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (isEmpty && (op == WLZ_BO_AND)))
+  {
+    for(i = 0; i < nR; ++i)
+    {
+      (void )WlzFreeObj(rObjs[i]);
+      rObjs[i] = NULL;
+    }
+    nR = 0;
+  }
+  /* Combine pairs until only one object remains. */
+  if((errNum == WLZ_ERR_NONE) && (nR > 1))
+  {
+    nPMax = nR / 2;
+    if((pObjs = (WlzObject **)
+                AlcCalloc(nPMax, sizeof(WlzObject *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) && (nR > 1))
+  {
+    int		j,
+    		nP;
+
+    nP = nR / 2;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(i = 0; i < nP; ++i)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzObject *pair[2];
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	pair[0] = rObjs[2 * i];
+	pair[1] = rObjs[2 * i + 1];
+	pObjs[i] = WlzAssignObject(
+		   (op == WLZ_BO_OR)? WlzUnionN(2, pair, 0, &errNum2):
+				      WlzIntersectN(2, pair, 0, &errNum2),
+		   NULL);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzMergeNReduce)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+    /* The combined objects are freed outside of the parallel loop as
+     * the same object may be given more than once. Empty unions are
+     * dropped and an empty intersection ends the reduction. */
+    for(i = 0; i < 2 * nP; ++i)
+    {
+      (void )WlzFreeObj(rObjs[i]);
+      rObjs[i] = NULL;
+    }
+    j = 0;
+    for(i = 0; i < nP; ++i)
+    {
+      if(pObjs[i] != NULL)
+      {
+	if(pObjs[i]->type == WLZ_EMPTY_OBJ)
+	{
+	  isEmpty = 1;
+	  (void )WlzFreeObj(pObjs[i]);
+	}
+	else
+	{
+	  rObjs[j++] = pObjs[i];
+	}
+	pObjs[i] = NULL;
+      }
+    }
+    if(nR > 2 * nP)
+    {
+      rObjs[j++] = rObjs[nR - 1];
+      rObjs[nR - 1] = NULL;
+    }
+    nR = j;
+    if(isEmpty && (op == WLZ_BO_AND))
+    {
+      for(i = 0; i < nR; ++i)
+      {
+	(void )WlzFreeObj(rObjs[i]);
+	rObjs[i] = NULL;
+      }
+      nR = 0;
+    }
+  }
+  /* A new object without values is always returned, even for a single
+   * given object. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(nR == 0)
+    {
+      rObj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      WlzValues	nullVal;
+
+      nullVal.core = NULL;
+      rObj = WlzMakeMain(rObjs[0]->type, rObjs[0]->domain, nullVal,
+			 NULL, NULL, &errNum);
+    }
+  }
+  if(pObjs)
+  {
+    for(i = 0; i < nPMax; ++i)
+    {
+      (void )WlzFreeObj(pObjs[i]);
+    }
+    AlcFree(pObjs);
+  }
+  if(rObjs)
+  {
+    for(i = 0; i < n; ++i)
+    {
+      (void )WlzFreeObj(rObjs[i]);
+    }
+    AlcFree(rObjs);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	Union or intersection object, or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the union or intersection of two or more
+* 		non-empty 2D domain objects. This function should only
+* 		be called by WlzUnionN() and WlzIntersectN(), which
+* 		check the objects, and is not in WlzProto.h.
+*
+* 		The intervals of each line are merged independently
+* 		(and in parallel) using a binary heap of the objects: for
+* 		the union the heap is ordered by the left end of each
+* 		object's current interval so that intervals are visited
+* 		in order, for the intersection it is ordered by the right
+* 		end so that the object whose interval ends first is
+* 		advanced. Each line costs \f$O(m \log n)\f$ for
+* 		\f$m\f$ intervals of \f$n\f$ objects.
+*
+* 		The domain and values are the same as those previously
+* 		computed by WlzUnionN() and WlzIntersectN(): the union's
+* 		domain has the bounding box of the objects and the
+* 		intersection's domain is standardised. Values are the
+* 		mean of the objects' values, accumulated in object order
+* 		using the same arithmetic.
+* \param	n			Number of objects, at least two.
+* \param	objs			Array of non-empty 2D domain objects.
+* \param	uvt			Make values if non-zero, in which case
+* 					all objects must have values.
+* \param	isect			Intersection if non-zero, else
+* 					union.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzMergeN2D(
+		  int n,
+		  WlzObject **objs,
+		  int uvt,
+		  int isect,
+		  WlzErrorNum *dstErr)
+{
+  int		i,
+		l,
+  		nLn = 0,
+		nThr = 1;
+  int		*nOut = NULL;
+  size_t	*off = NULL;
+  WlzInterval	*itvl = NULL;
+  WlzIBox2	bBox;
+  WlzDomain	dom;
+  WlzValues	nullVal;
+  WlzMergeNSrc	*src = NULL;
+  WlzMergeNWSp	*wSp = NULL;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  nullVal.core = NULL;
+  if((src = (WlzMergeNSrc *)AlcMalloc(n * sizeof(WlzMergeNSrc))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < n); ++i)
+  {
+    WlzIntervalDomain *iDom;
+
+    iDom = objs[i]->domain.i;
+    src[i].line1 = iDom->line1;
+    src[i].lastln = iDom->lastln;
+    src[i].kol1 = iDom->kol1;
+    switch(iDom->type)
+    {
+      case WLZ_INTERVALDOMAIN_INTVL:
+	src[i].itvLn = iDom->intvlines;
+	break;
+      case WLZ_INTERVALDOMAIN_RECT:
+	src[i].itvLn = NULL;
+	src[i].rItv.ileft = 0;
+	src[i].rItv.iright = iDom->lastkl - iDom->kol1;
+	break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+    if(i == 0)
+    {
+      bBox.yMin = iDom->line1;
+      bBox.yMax = iDom->lastln;
+      bBox.xMin = iDom->kol1;
+      bBox.xMax = iDom->lastkl;
+    }
+    else if(isect)
+    {
+      bBox.yMin = ALG_MAX(bBox.yMin, iDom->line1);
+      bBox.yMax = ALG_MIN(bBox.yMax, iDom->lastln);
+      bBox.xMin = ALG_MAX(bBox.xMin, iDom->kol1);
+      bBox.xMax = ALG_MIN(bBox.xMax, iDom->lastkl);
+    }
+    else
+    {
+      bBox.yMin = ALG_MIN(bBox.yMin, iDom->line1);
+      bBox.yMax = ALG_MAX(bBox.yMax, iDom->lastln);
+      bBox.xMin = ALG_MIN(bBox.xMin, iDom->kol1);
+      bBox.xMax = ALG_MAX(bBox.xMax, iDom->lastkl);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((bBox.xMax < bBox.xMin) || (bBox.yMax < bBox.yMin)))
+  {
+    /* Only possible for an intersection. */
+    obj = WlzMakeEmpty(&errNum);
+  }
+  /* Count the intervals of the objects on each line, which bounds the
+   * number of intervals of the union or intersection on the line. */
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    nLn = bBox.yMax - bBox.yMin + 1;
+    if(((off = (size_t *)AlcCalloc(nLn + 1, sizeof(size_t))) == NULL) ||
+       ((nOut = (int *)AlcMalloc(nLn * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    for(i = 0; i < n; ++i)
+    {
+      int	l0,
+      		l1;
+
+      l0 = ALG_MAX(src[i].line1, bBox.yMin);
+      l1 = ALG_MIN(src[i].lastln, bBox.yMax);
+      for(l = l0; l <= l1; ++l)
+      {
+	off[l - bBox.yMin + 1] += (src[i].itvLn)?
+	                          src[i].itvLn[l - src[i].line1].nintvs: 1;
+      }
+    }
+    for(l = 0; l < nLn; ++l)
+    {
+      off[l + 1] += off[l];
+    }
+    if(off[nLn] > 0)
+    {
+      if((itvl = (WlzInterval *)
+                 AlcMalloc(off[nLn] * sizeof(WlzInterval))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+				  bBox.yMin, bBox.yMax, bBox.xMin, bBox.xMax,
+				  &errNum);
+    if((errNum == WLZ_ERR_NONE) && itvl)
+    {
+      dom.i->freeptr = AlcFreeStackPush(dom.i->freeptr, (void *)itvl, NULL);
+    }
+    else
+    {
+      AlcFree(itvl);
+    }
+  }
+  /* Allocate workspaces for each thread. */
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if((wSp = (WlzMergeNWSp *)AlcCalloc(nThr, sizeof(WlzMergeNWSp))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nThr); ++i)
+    {
+      if(((wSp[i].cur = (WlzInterval **)
+                        AlcMalloc(n * sizeof(WlzInterval *))) == NULL) ||
+	 ((wSp[i].rem = (int *)AlcMalloc(3 * n * sizeof(int))) == NULL) ||
+	 ((wSp[i].dif = (int *)AlcCalloc(bBox.xMax - bBox.xMin + 2,
+	                                 sizeof(int))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	wSp[i].key = wSp[i].rem + n;
+	wSp[i].hp = wSp[i].key + n;
+      }
+    }
+  }
+  /* Merge the intervals of each line. A line on which there are many
+   * intervals compared to its width is swept, otherwise the intervals
+   * are merged using the heap. */
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    int		lgN = 1,
+    		span;
+
+    span = bBox.xMax - bBox.xMin + 1;
+    while((1 << lgN) < n)
+    {
+      ++lgN;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic, 64)
+#endif
+    for(l = 0; l < nLn; ++l)
+    {
+      int	thrId = 0;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      if((off[l + 1] - off[l]) * lgN >= (size_t )span)
+      {
+	nOut[l] = WlzMergeNSweepLn(n, src, wSp + thrId, l + bBox.yMin,
+				   bBox.xMin, bBox.xMax, isect,
+				   itvl + off[l]);
+      }
+      else
+      {
+	nOut[l] = (isect)?
+		  WlzMergeNIsectLn(n, src, wSp + thrId, l + bBox.yMin,
+				   bBox.xMin, itvl + off[l]):
+		  WlzMergeNUnionLn(n, src, wSp + thrId, l + bBox.yMin,
+				   bBox.xMin, itvl + off[l]);
+      }
+    }
+    for(l = 0; (errNum == WLZ_ERR_NONE) && (l < nLn); ++l)
+    {
+      errNum = WlzMakeInterval(l + bBox.yMin, dom.i, nOut[l],
+                               (nOut[l] > 0)? itvl + off[l]: NULL);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    if(isect)
+    {
+      (void )WlzStandardIntervalDomain(dom.i);
+      if(WlzIntervalCount(dom.i, &errNum) == 0)
+      {
+	(void )WlzFreeIntervalDomain(dom.i);
+	dom.i = NULL;
+	obj = WlzMakeEmpty(&errNum);
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL, &errNum);
+    if((errNum == WLZ_ERR_NONE) && uvt)
+    {
+      errNum = WlzMergeNGrey(obj, n, objs, isect);
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(obj)
+    {
+      (void )WlzFreeObj(obj);
+      obj = NULL;
+    }
+    else if(dom.core)
+    {
+      (void )WlzFreeIntervalDomain(dom.i);
+    }
+  }
+  if(wSp)
+  {
+    for(i = 0; i < nThr; ++i)
+    {
+      AlcFree(wSp[i].cur);
+      AlcFree(wSp[i].rem);
+      AlcFree(wSp[i].dif);
+    }
+    AlcFree(wSp);
+  }
+  AlcFree(nOut);
+  AlcFree(off);
+  AlcFree(src);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	Number of intervals of the line.
+* \ingroup	WlzBinaryOps
+* \brief	Gets the intervals of the given line of a domain.
+* \param	src			Line access to the domain.
+* \param	l			Line.
+* \param	dstItv			Destination pointer for the intervals,
+* 					which are relative to the domain's
+* 					first column.
+*/
+static int			WlzMergeNLine(
+				  WlzMergeNSrc *src,
+				  int l,
+				  WlzInterval **dstItv)
+{
+  int		nItv = 0;
+
+  if((l >= src->line1) && (l <= src->lastln))
+  {
+    if(src->itvLn)
+    {
+      WlzIntervalLine *itvLn;
+
+      itvLn = src->itvLn + l - src->line1;
+      nItv = itvLn->nintvs;
+      *dstItv = itvLn->intvs;
+    }
+    else
+    {
+      nItv = 1;
+      *dstItv = &(src->rItv);
+    }
+  }
+  return(nItv);
+}
+
+/*!
+* \return	Number of intervals of the union on the line.
+* \ingroup	WlzBinaryOps
+* \brief	Merges the intervals of all objects on a line into the
+* 		intervals of their union. The object with the left-most
+* 		current interval is always at the top of the heap, so
+* 		intervals are visited in order of their left ends and
+* 		those which overlap or are adjacent are joined.
+* \param	n			Number of objects.
+* \param	src			Line access to the objects' domains.
+* \param	wSp			Workspace.
+* \param	l			Line.
+* \param	kol1			Column to which the union's intervals
+* 					are relative.
+* \param	itv			Destination for the union's intervals.
+*/
+static int			WlzMergeNUnionLn(
+				  int n,
+				  WlzMergeNSrc *src,
+				  WlzMergeNWSp *wSp,
+				  int l,
+				  int kol1,
+				  WlzInterval *itv)
+{
+  int		i,
+  		nH = 0,
+		nOut = 0,
+		rL = 0,
+		rR = 0;
+
+  for(i = 0; i < n; ++i)
+  {
+    if((wSp->rem[i] = WlzMergeNLine(src + i, l, wSp->cur + i)) > 0)
+    {
+      wSp->key[i] = wSp->cur[i]->ileft + src[i].kol1;
+      wSp->hp[nH++] = i;
+    }
+  }
+  for(i = nH / 2 - 1; i >= 0; --i)
+  {
+    WlzMergeNHeapDown(wSp->hp, nH, wSp->key, i);
+  }
+  while(nH > 0)
+  {
+    int		lft,
+    		rgt;
+
+    i = wSp->hp[0];
+    lft = wSp->key[i];
+    rgt = wSp->cur[i]->iright + src[i].kol1;
+    if((nOut > 0) && (lft <= rR + 1))
+    {
+      rR = ALG_MAX(rR, rgt);
+    }
+    else
+    {
+      if(nOut > 0)
+      {
+	itv->ileft = rL - kol1;
+	itv->iright = rR - kol1;
+	++itv;
+      }
+      rL = lft;
+      rR = rgt;
+      ++nOut;
+    }
+    if(--(wSp->rem[i]) > 0)
+    {
+      ++(wSp->cur[i]);
+      wSp->key[i] = wSp->cur[i]->ileft + src[i].kol1;
+    }
+    else
+    {
+      wSp->hp[0] = wSp->hp[--nH];
+    }
+    WlzMergeNHeapDown(wSp->hp, nH, wSp->key, 0);
+  }
+  if(nOut > 0)
+  {
+    itv->ileft = rL - kol1;
+    itv->iright = rR - kol1;
+  }
+  return(nOut);
+}
+
+/*!
+* \return	Number of intervals of the intersection on the line.
+* \ingroup	WlzBinaryOps
+* \brief	Merges the intervals of all objects on a line into the
+* 		intervals of their intersection. The object whose current
+* 		interval ends first is always at the top of the heap.
+* 		While that interval ends before the greatest left end of
+* 		the current intervals it is advanced, otherwise the
+* 		intersection has an interval from that left end to the
+* 		end of the top interval.
+* \param	n			Number of objects.
+* \param	src			Line access to the objects' domains.
+* \param	wSp			Workspace.
+* \param	l			Line.
+* \param	kol1			Column to which the intersection's
+* 					intervals are relative.
+* \param	itv			Destination for the intersection's
+* 					intervals.
+*/
+static int			WlzMergeNIsectLn(
+				  int n,
+				  WlzMergeNSrc *src,
+				  WlzMergeNWSp *wSp,
+				  int l,
+				  int kol1,
+				  WlzInterval *itv)
+{
+  int		i,
+		nOut = 0,
+		maxL = 0;
+
+  for(i = 0; i < n; ++i)
+  {
+    int		lft;
+
+    if((wSp->rem[i] = WlzMergeNLine(src + i, l, wSp->cur + i)) == 0)
+    {
+      break;
+    }
+    lft = wSp->cur[i]->ileft + src[i].kol1;
+    maxL = (i == 0)? lft: ALG_MAX(maxL, lft);
+    wSp->key[i] = wSp->cur[i]->iright + src[i].kol1;
+    wSp->hp[i] = i;
+  }
+  if(i == n)
+  {
+    for(i = n / 2 - 1; i >= 0; --i)
+    {
+      WlzMergeNHeapDown(wSp->hp, n, wSp->key, i);
+    }
+    for(;;)
+    {
+      i = wSp->hp[0];
+      if(wSp->key[i] < maxL)
+      {
+	if(--(wSp->rem[i]) == 0)
+	{
+	  break;
+	}
+	++(wSp->cur[i]);
+	maxL = ALG_MAX(maxL, wSp->cur[i]->ileft + src[i].kol1);
+	wSp->key[i] = wSp->cur[i]->iright + src[i].kol1;
+	WlzMergeNHeapDown(wSp->hp, n, wSp->key, 0);
+      }
+      else
+      {
+	itv->ileft = maxL - kol1;
+	itv->iright = wSp->key[i] - kol1;
+	++itv;
+	++nOut;
+	maxL = wSp->key[i] + 1;
+      }
+    }
+  }
+  return(nOut);
+}
+
+/*!
+* \return	Number of intervals of the union or intersection on the
+* 		line.
+* \ingroup	WlzBinaryOps
+* \brief	Merges the intervals of all objects on a line by counting
+* 		the objects which cover each column: the count is
+* 		incremented at the left end of each interval and
+* 		decremented after its right end, then a single sweep
+* 		along the line finds the columns covered by at least one
+* 		object (union) or all of the objects (intersection). The
+* 		cost is linear in the number of intervals and columns,
+* 		which is less than that of the heap merge for dense lines.
+* 		The counts are left zero.
+* \param	n			Number of objects.
+* \param	src			Line access to the objects' domains.
+* \param	wSp			Workspace.
+* \param	l			Line.
+* \param	kol1			First column of the union or
+* 					intersection, to which its intervals
+* 					are relative.
+* \param	lastkl			Last column of the union or
+* 					intersection.
+* \param	isect			Intersection if non-zero, else
+* 					union.
+* \param	itv			Destination for the intervals.
+*/
+static int			WlzMergeNSweepLn(
+				  int n,
+				  WlzMergeNSrc *src,
+				  WlzMergeNWSp *wSp,
+				  int l,
+				  int kol1,
+				  int lastkl,
+				  int isect,
+				  WlzInterval *itv)
+{
+  int		i,
+  		j,
+		x,
+		x0 = 0,
+		nItv,
+		sum = 0,
+		nOut = 0,
+		xMin,
+		xMax;
+  int		*dif;
+  WlzInterval	*iv;
+
+  dif = wSp->dif;
+  if(isect)
+  {
+    for(i = 0; i < n; ++i)
+    {
+      if(WlzMergeNLine(src + i, l, &iv) == 0)
+      {
+        return(0);
+      }
+    }
+  }
+  xMin = lastkl - kol1 + 1;
+  xMax = -1;
+  for(i = 0; i < n; ++i)
+  {
+    nItv = WlzMergeNLine(src + i, l, &iv);
+    for(j = 0; j < nItv; ++j)
+    {
+      int	lft,
+      		rgt;
+
+      lft = ALG_MAX(iv[j].ileft + src[i].kol1, kol1) - kol1;
+      rgt = ALG_MIN(iv[j].iright + src[i].kol1, lastkl) - kol1;
+      if(lft <= rgt)
+      {
+	++(dif[lft]);
+	--(dif[rgt + 1]);
+	xMin = ALG_MIN(xMin, lft);
+	xMax = ALG_MAX(xMax, rgt);
+      }
+    }
+  }
+  j = (isect)? n: 1;
+  for(x = xMin; x <= xMax + 1; ++x)
+  {
+    int		in;
+
+    in = sum >= j;
+    sum += dif[x];
+    dif[x] = 0;
+    if(sum >= j)
+    {
+      if(!in)
+      {
+        x0 = x;
+      }
+    }
+    else if(in)
+    {
+      itv->ileft = x0;
+      itv->iright = x - 1;
+      ++itv;
+      ++nOut;
+    }
+  }
+  return(nOut);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Restores the heap order below the given heap position,
+* 		smallest key at the top.
+* \param	hp			Heap of object indices.
+* \param	nH			Number of entries in the heap.
+* \param	key			Keys indexed by object index.
+* \param	i			Position in the heap.
+*/
+static void			WlzMergeNHeapDown(
+				  int *hp,
+				  int nH,
+				  int *key,
+				  int i)
+{
+  int		c,
+  		t;
+
+  if(nH > 0)
+  {
+    t = hp[i];
+    while((c = 2 * i + 1) < nH)
+    {
+      if((c + 1 < nH) && (key[hp[c + 1]] < key[hp[c]]))
+      {
+	++c;
+      }
+      if(key[hp[c]] >= key[t])
+      {
+	break;
+      }
+      hp[i] = hp[c];
+      i = c;
+    }
+    hp[i] = t;
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Makes the values of a union or intersection, which are
+* 		the mean of the values of the objects at each pixel.
+* 		For each line the values of the objects are summed in
+* 		object order into a buffer before the line's values are
+* 		set, with sums of the same type as the previous per pixel
+* 		sums, so that the values are unchanged.
+* \param	obj			Union or intersection without values.
+* \param	n			Number of objects.
+* \param	objs			Array of objects with values.
+* \param	isect			Intersection if non-zero, else
+* 					union.
+*/
+static WlzErrorNum		WlzMergeNGrey(
+				  WlzObject *obj,
+				  int n,
+				  WlzObject **objs,
+				  int isect)
+{
+  int		i,
+  		kMin,
+		kMax,
+		lCur,
+		nInit = 0;
+  int		*act = NULL,
+  		*cnt = NULL;
+  void		*acc = NULL;
+  WlzGreyType	gType;
+  WlzPixelV	bgd;
+  WlzValues	val;
+  WlzObjectType	vType;
+  WlzIntervalWSpace niwsp;
+  WlzGreyWSpace	ngwsp;
+  WlzIntervalWSpace *iwsp = NULL;
+  WlzGreyWSpace	*gwsp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  kMin = objs[0]->domain.i->kol1;
+  kMax = objs[0]->domain.i->lastkl;
+  for(i = 1; i < n; ++i)
+  {
+    kMin = ALG_MIN(kMin, objs[i]->domain.i->kol1);
+    kMax = ALG_MAX(kMax, objs[i]->domain.i->lastkl);
+  }
+  bgd = WlzGetBackground(objs[0], &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTableTypeToGreyType(objs[0]->values.core->type, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    vType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    val.v = WlzNewValueTb(obj, vType, bgd, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj->values = WlzAssignValues(val, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((iwsp = (WlzIntervalWSpace *)
+                AlcMalloc(n * sizeof(WlzIntervalWSpace))) == NULL) ||
+       ((gwsp = (WlzGreyWSpace *)
+                AlcMalloc(n * sizeof(WlzGreyWSpace))) == NULL) ||
+       ((act = (int *)AlcMalloc(n * sizeof(int))) == NULL) ||
+       ((cnt = (int *)AlcMalloc((kMax - kMin + 1) * sizeof(int))) == NULL) ||
+       ((acc = AlcMalloc((kMax - kMin + 1) * sizeof(double))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj, &niwsp, &ngwsp);
+  }
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < n); ++i)
+  {
+    errNum = WlzInitGreyScan(objs[i], iwsp + i, gwsp + i);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nInit = i + 1;
+      act[i] = (WlzNextGreyInterval(iwsp + i) == WLZ_ERR_NONE);
+      if(gwsp[i].pixeltype != gType)
+      {
+	errNum = WLZ_ERR_GREY_TYPE;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    lCur = obj->domain.i->line1 - 1;
+    while((errNum == WLZ_ERR_NONE) &&
+          (WlzNextGreyInterval(&niwsp) == WLZ_ERR_NONE))
+    {
+      int	k,
+      		w;
+      WlzGreyP	aP,
+      		gP;
+
+      aP.v = acc;
+      if(niwsp.linpos != lCur)
+      {
+	/* Sum the values of all objects on the line in object order. */
+	lCur = niwsp.linpos;
+	(void )memset(cnt, 0, (kMax - kMin + 1) * sizeof(int));
+	(void )memset(acc, 0, (kMax - kMin + 1) * sizeof(double));
+	for(i = 0; i < n; ++i)
+	{
+	  while(act[i] && (iwsp[i].linpos < lCur))
+	  {
+	    act[i] = (WlzNextGreyInterval(iwsp + i) == WLZ_ERR_NONE);
+	  }
+	  while(act[i] && (iwsp[i].linpos == lCur))
+	  {
+	    int	  k0;
+
+	    k0 = iwsp[i].lftpos - kMin;
+	    w = iwsp[i].rgtpos - iwsp[i].lftpos + 1;
+	    gP = gwsp[i].u_grintptr;
+	    for(k = 0; k < w; ++k)
+	    {
+	      ++(cnt[k0 + k]);
+	    }
+	    switch(gType)
+	    {
+	      case WLZ_GREY_INT:
+		for(k = 0; k < w; ++k)
+		{
+		  aP.inp[k0 + k] += gP.inp[k];
+		}
+		break;
+	      case WLZ_GREY_SHORT:
+		for(k = 0; k < w; ++k)
+		{
+		  aP.shp[k0 + k] += gP.shp[k];
+		}
+		break;
+	      case WLZ_GREY_UBYTE:
+		if(isect)
+		{
+		  for(k = 0; k < w; ++k)
+		  {
+		    aP.ubp[k0 + k] += gP.ubp[k];
+		  }
+		}
+		else
+		{
+		  for(k = 0; k < w; ++k)
+		  {
+		    aP.inp[k0 + k] += gP.ubp[k];
+		  }
+		}
+		break;
+	      case WLZ_GREY_FLOAT:
+		for(k = 0; k < w; ++k)
+		{
+		  aP.flp[k0 + k] += gP.flp[k];
+		}
+		break;
+	      case WLZ_GREY_DOUBLE:
+		for(k = 0; k < w; ++k)
+		{
+		  aP.dbp[k0 + k] += gP.dbp[k];
+		}
+		break;
+	      case WLZ_GREY_RGBA:
+		for(k = 0; k < w; ++k)
+		{
+		  aP.rgbp[k0 + k] += gP.rgbp[k];
+		}
+		break;
+	      default:
+		errNum = WLZ_ERR_GREY_TYPE;
+		break;
+	    }
+	    act[i] = (WlzNextGreyInterval(iwsp + i) == WLZ_ERR_NONE);
+	  }
+	}
+      }
+      /* Set the mean values of the interval, dividing by the number of
+       * objects for the intersection, as all overlap. */
+      gP = ngwsp.u_grintptr;
+      w = niwsp.rgtpos - niwsp.lftpos + 1;
+      aP.v = acc;
+      for(k = 0; k < w; ++k)
+      {
+	int	c,
+		k0;
+
+	k0 = niwsp.lftpos - kMin + k;
+	c = (isect)? n: cnt[k0];
+	switch(gType)
+	{
+	  case WLZ_GREY_INT:
+	    gP.inp[k] = aP.inp[k0] / c;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    gP.shp[k] = (short )(aP.shp[k0] / c);
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    gP.ubp[k] = (isect)? (WlzUByte )(aP.ubp[k0] / c):
+	                         (WlzUByte )(aP.inp[k0] / c);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    gP.flp[k] = aP.flp[k0] / c;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    gP.dbp[k] = aP.dbp[k0] / c;
+	    break;
+	  case WLZ_GREY_RGBA:
+	    gP.rgbp[k] = aP.rgbp[k0] / c;
+	    break;
+	  default:
+	    break;
+	}
+      }
+    }
+    (void )WlzEndGreyScan(&niwsp, &ngwsp);
+  }
+  for(i = 0; i < nInit; ++i)
+  {
+    (void )WlzEndGreyScan(iwsp + i, gwsp + i);
+  }
+  AlcFree(iwsp);
+  AlcFree(gwsp);
+  AlcFree(act);
+  AlcFree(cnt);
+  AlcFree(acc);
+  return(errNum);
+}
@@ -563,6 +563,51 @@ WlzMeshTransform *WlzMeshTransformFromCPts(WlzObject *obj,
 				WlzMeshGenMethod meshGenMtd,
 				double meshMinDist, double meshMaxDist,
 				WlzErrorNum *dstErr)
+{
+  WlzMeshTransform *mTr;
+
+  mTr = WlzMeshTransformFromCPtsTree(obj, basisFnType, polyOrder,
+  				     nSPts, sPts, nDPts, dPts,
+				     meshGenMtd, meshMinDist, meshMaxDist,
+				     0.0, dstErr);
+  return(mTr);
+}
+
+/*!
+* \return	New mesh transform.
+* \ingroup	WlzTransform
+* \brief	Computes a mesh transform for the given object and a
+*		set of control points using both an affine and a basis
+*		function transform to set the mesh displacements.
+*		This is the same as WlzMeshTransformFromCPts() except
+*		that the basis function may be evaluated using a tree
+*		(see WlzBasisFnSetTree()), which is much faster when
+*		there are many control points.
+* \param	obj			Given object.
+* \param	basisFnType		Required basis function type.
+* \param	polyOrder		Order of polynomial, only used for
+*					WLZ_FN_BASIS_2DPOLY.
+* \param	nSPts			Number of source control points.
+* \param	sPts			Source control points.
+* \param	nDPts			Number of destination control points.
+* \param	dPts			Destination control points.
+* \param	meshGenMtd		Mesh generation method.
+* \param	meshMinDist		Minimum mesh vertex distance.
+* \param	meshMaxDist		Maximum mesh vertex distance.
+* \param	treeTol			Tolerance for the basis function
+*					evaluation tree, if less than or
+*					equal to zero the basis function
+*					is evaluated directly.
+* \param	dstErr			Destination error pointer, may be
+*					NULL.
+*/
+WlzMeshTransform *WlzMeshTransformFromCPtsTree(WlzObject *obj,
+				WlzFnType basisFnType, int polyOrder,
+				int nSPts, WlzDVertex2 *sPts,
+				int nDPts, WlzDVertex2 *dPts,
+				WlzMeshGenMethod meshGenMtd,
+				double meshMinDist, double meshMaxDist,
+				double treeTol, WlzErrorNum *dstErr)
 {
   int		idx;
   WlzDVertex2	*dPtsT = NULL;
@@ -620,6 +665,10 @@ WlzMeshTransform *WlzMeshTransformFromCPts(WlzObject *obj,
 			  	   nSPts, sPts, nSPts, dPtsT,
 				   NULL, &errNum);
       }
+      if((errNum == WLZ_ERR_NONE) && (treeTol > 0.0))
+      {
+        errNum = WlzBasisFnSetTree(bTr->basisFn, treeTol);
+      }
       if(errNum == WLZ_ERR_NONE)
       {
         /* Set the mesh transform displacements and then apply the affine
@@ -640,6 +689,7 @@ WlzMeshTransform *WlzMeshTransformFromCPts(WlzObject *obj,
   if(errNum != WLZ_ERR_NONE)
   {
     (void )WlzMeshFreeTransform(mTr);
+    mTr = NULL;
   }
   if(dstErr)
   {
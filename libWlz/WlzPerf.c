@@ -0,0 +1,517 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzPerf_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzPerf.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Opt-in performance counters and tracing for the Woolz
+*		library.
+* \ingroup	WlzDebug
+*
+* \par
+*		Functions which are instrumented bracket their body
+*		with the WLZ_PERF_BEGIN() and WLZ_PERF_END() macros,
+*		which record nothing unless counting has been enabled
+*		by a call to WlzPerfEnable(). When enabled each named
+*		scope accumulates a call count, elapsed times and
+*		(with ::WLZ_PERF_ALLOC) the storage allocated through
+*		AlcMalloc(), AlcCalloc() and AlcRealloc(). With
+*		::WLZ_PERF_TRACE an event is also recorded for each
+*		call. The counters may be written as JSON using
+*		WlzPerfWriteJSON() and the events as a Chrome trace
+*		file (viewable with chrome://tracing or Perfetto)
+*		using WlzPerfWriteTrace().
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/time.h>
+#include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_PERF_MAX_EVENT
+* \ingroup	WlzDebug
+* \brief	Maximum number of trace events recorded, further events
+*		are counted but discarded.
+*/
+#define WLZ_PERF_MAX_EVENT	(1<<20)
+
+/*!
+* \struct	_WlzPerfEvent
+* \ingroup	WlzDebug
+* \brief	A single trace event.
+*/
+typedef struct _WlzPerfEvent
+{
+  int		idx;			/*!< Counter index */
+  int		thrId;			/*!< Thread which made the call */
+  double	t0;			/*!< Start time relative to the epoch
+  					     (seconds) */
+  double	dt;			/*!< Duration (seconds) */
+} WlzPerfEvent;
+
+static int			WlzPerfCounterFind(
+				  const char *name);
+static double			WlzPerfTime(void);
+static int			WlzPerfWriteName(
+				  FILE *fP,
+				  const char *name);
+
+WlzPerfMask			wlzPerfMask = WLZ_PERF_NONE;
+
+static int			wlzPerfNCounter = 0,
+				wlzPerfMaxCounter = 0,
+				wlzPerfNEvent = 0,
+				wlzPerfMaxEvent = 0;
+static long			wlzPerfNDropped = 0;
+static double			wlzPerfEpoch = 0.0;
+static WlzPerfCounter		*wlzPerfCounters = NULL;
+static WlzPerfEvent		*wlzPerfEvents = NULL;
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzDebug
+* \brief	Sets the performance counting mask. Counting is enabled
+*		for any non-zero mask and disabled (the default) by
+*		::WLZ_PERF_NONE. Counters and events are kept when
+*		counting is disabled, see WlzPerfReset().
+* \param	mask			Performance counting mask.
+*/
+WlzErrorNum	WlzPerfEnable(WlzPerfMask mask)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((mask & ~(WLZ_PERF_COUNT | WLZ_PERF_ALLOC | WLZ_PERF_TRACE)) != 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzPerf)
+#endif
+    {
+      if(wlzPerfEpoch <= 0.0)
+      {
+	wlzPerfEpoch = WlzPerfTime();
+      }
+      AlcAllocCountSet((mask & WLZ_PERF_ALLOC) != 0);
+      wlzPerfMask = mask;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzDebug
+* \brief	Frees all counters and trace events and restarts the
+*		trace epoch. This should not be called while any
+*		counted scope is active.
+*/
+void		WlzPerfReset(void)
+{
+#ifdef _OPENMP
+#pragma omp critical (WlzPerf)
+#endif
+  {
+    AlcFree(wlzPerfCounters);
+    AlcFree(wlzPerfEvents);
+    wlzPerfCounters = NULL;
+    wlzPerfEvents = NULL;
+    wlzPerfNCounter = wlzPerfMaxCounter = 0;
+    wlzPerfNEvent = wlzPerfMaxEvent = 0;
+    wlzPerfNDropped = 0;
+    wlzPerfEpoch = (wlzPerfMask)? WlzPerfTime(): 0.0;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzDebug
+* \brief	Enters a counted scope. This is usually called through
+*		WLZ_PERF_BEGIN() rather than directly.
+* \param	scope			Scope state, which must be passed
+*					to WlzPerfEnd() on leaving the scope.
+* \param	name			Scope name, which must remain valid
+*					until the counters are reset; usually
+*					a string literal.
+*/
+void		WlzPerfBegin(WlzPerfScope *scope, const char *name)
+{
+  int		idx = -1;
+
+  if(wlzPerfMask && name)
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzPerf)
+#endif
+    {
+      idx = WlzPerfCounterFind(name);
+    }
+    if(idx >= 0)
+    {
+      AlcAllocCountGet(&(scope->allocBytes), &(scope->allocCalls));
+      scope->t0 = WlzPerfTime();
+    }
+  }
+  scope->idx = idx;
+}
+
+/*!
+* \return	void
+* \ingroup	WlzDebug
+* \brief	Leaves a counted scope, adding the elapsed time and
+*		allocations to the scope's counter and recording a
+*		trace event if tracing is enabled. This is usually
+*		called through WLZ_PERF_END() rather than directly.
+* \param	scope			Scope state given to WlzPerfBegin().
+*/
+void		WlzPerfEnd(WlzPerfScope *scope)
+{
+  int		thrId = 0;
+  double	dt;
+  size_t	allocBytes,
+  		allocCalls;
+
+  dt = WlzPerfTime() - scope->t0;
+  AlcAllocCountGet(&allocBytes, &allocCalls);
+#ifdef _OPENMP
+  thrId = omp_get_thread_num();
+#pragma omp critical (WlzPerf)
+#endif
+  {
+    WlzPerfCounter *cnt;
+
+    if(scope->idx < wlzPerfNCounter)
+    {
+      cnt = wlzPerfCounters + scope->idx;
+      ++(cnt->calls);
+      cnt->time += dt;
+      if(dt > cnt->maxTime)
+      {
+	cnt->maxTime = dt;
+      }
+      if(allocCalls > scope->allocCalls)
+      {
+	cnt->allocBytes += allocBytes - scope->allocBytes;
+	cnt->allocCalls += allocCalls - scope->allocCalls;
+      }
+      if((wlzPerfMask & WLZ_PERF_TRACE) != 0)
+      {
+	if(wlzPerfNEvent >= wlzPerfMaxEvent)
+	{
+	  int		newMax;
+	  WlzPerfEvent	*newEvents = NULL;
+
+	  newMax = (wlzPerfMaxEvent > 0)? 2 * wlzPerfMaxEvent: 1024;
+	  if((newMax <= WLZ_PERF_MAX_EVENT) &&
+	     ((newEvents = (WlzPerfEvent *)
+			   AlcRealloc(wlzPerfEvents,
+				      newMax * sizeof(WlzPerfEvent))) != NULL))
+	  {
+	    wlzPerfEvents = newEvents;
+	    wlzPerfMaxEvent = newMax;
+	  }
+	}
+	if(wlzPerfNEvent < wlzPerfMaxEvent)
+	{
+	  WlzPerfEvent	*evt;
+
+	  evt = wlzPerfEvents + wlzPerfNEvent++;
+	  evt->idx = scope->idx;
+	  evt->thrId = thrId;
+	  evt->t0 = scope->t0 - wlzPerfEpoch;
+	  evt->dt = dt;
+	}
+	else
+	{
+	  ++wlzPerfNDropped;
+	}
+      }
+    }
+  }
+  scope->idx = -1;
+}
+
+/*!
+* \return	Number of performance counters.
+* \ingroup	WlzDebug
+* \brief	Gives the number of performance counters, there being
+*		one for each scope name entered while counting was
+*		enabled.
+*/
+int		WlzPerfCounterCount(void)
+{
+  return(wlzPerfNCounter);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzDebug
+* \brief	Copies the performance counter with the given index.
+* \param	idx			Index of the counter.
+* \param	dstCnt			Destination for the counter.
+*/
+WlzErrorNum	WlzPerfCounterGet(int idx, WlzPerfCounter *dstCnt)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dstCnt == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzPerf)
+#endif
+    {
+      if((idx < 0) || (idx >= wlzPerfNCounter))
+      {
+	errNum = WLZ_ERR_PARAM_DATA;
+      }
+      else
+      {
+	*dstCnt = wlzPerfCounters[idx];
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzDebug
+* \brief	Writes the performance counters to the given file as a
+*		JSON object with a "counters" array of per-scope objects.
+*		Times are in seconds.
+* \param	fP			Given file.
+*/
+WlzErrorNum	WlzPerfWriteJSON(FILE *fP)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzPerf)
+#endif
+    {
+      int	idx,
+		ok;
+
+      ok = fprintf(fP, "{\n  \"counters\": [\n") > 0;
+      for(idx = 0; ok && (idx < wlzPerfNCounter); ++idx)
+      {
+	WlzPerfCounter *cnt;
+
+	cnt = wlzPerfCounters + idx;
+	ok = (fprintf(fP, "    {\"name\": ") > 0) &&
+	     WlzPerfWriteName(fP, cnt->name) &&
+	     (fprintf(fP, ", \"calls\": %ld, \"time\": %g, \"maxTime\": %g, "
+			  "\"allocBytes\": %lu, \"allocCalls\": %lu}%s\n",
+		      cnt->calls, cnt->time, cnt->maxTime,
+		      (unsigned long )(cnt->allocBytes),
+		      (unsigned long )(cnt->allocCalls),
+		      (idx < wlzPerfNCounter - 1)? ",": "") > 0);
+      }
+      if(ok)
+      {
+	ok = fprintf(fP, "  ]\n}\n") > 0;
+      }
+      if(!ok)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzDebug
+* \brief	Writes the recorded trace events to the given file
+*		using the Chrome trace event format, with one complete
+*		("X") event for each call.
+* \param	fP			Given file.
+*/
+WlzErrorNum	WlzPerfWriteTrace(FILE *fP)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzPerf)
+#endif
+    {
+      int	idx,
+		ok;
+
+      ok = fprintf(fP, "{\"traceEvents\": [\n") > 0;
+      for(idx = 0; ok && (idx < wlzPerfNEvent); ++idx)
+      {
+	WlzPerfEvent *evt;
+
+	evt = wlzPerfEvents + idx;
+	ok = (fprintf(fP, "{\"name\": ") > 0) &&
+	     WlzPerfWriteName(fP, wlzPerfCounters[evt->idx].name) &&
+	     (fprintf(fP, ", \"cat\": \"Wlz\", \"ph\": \"X\", "
+			  "\"ts\": %.3f, \"dur\": %.3f, "
+			  "\"pid\": 0, \"tid\": %d}%s\n",
+		      evt->t0 * 1.0e6, evt->dt * 1.0e6, evt->thrId,
+		      (idx < wlzPerfNEvent - 1)? ",": "") > 0);
+      }
+      if(ok)
+      {
+	ok = fprintf(fP, "],\n\"displayTimeUnit\": \"ms\",\n"
+			 "\"otherData\": {\"droppedEvents\": %ld}}\n",
+		     wlzPerfNDropped) > 0;
+      }
+      if(!ok)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Index of the counter or -1 if it could not be allocated.
+* \ingroup	WlzDebug
+* \brief	Finds the counter with the given name, adding a new
+*		counter if there is none. Names are compared by address
+*		before their contents. Must be called from within the
+*		WlzPerf critical section.
+* \param	name			Given scope name.
+*/
+static int	WlzPerfCounterFind(const char *name)
+{
+  int		idx;
+
+  for(idx = 0; idx < wlzPerfNCounter; ++idx)
+  {
+    if((wlzPerfCounters[idx].name == name) ||
+       (strcmp(wlzPerfCounters[idx].name, name) == 0))
+    {
+      break;
+    }
+  }
+  if(idx >= wlzPerfNCounter)
+  {
+    if(wlzPerfNCounter >= wlzPerfMaxCounter)
+    {
+      int	newMax;
+      WlzPerfCounter *newCounters;
+
+      newMax = (wlzPerfMaxCounter > 0)? 2 * wlzPerfMaxCounter: 64;
+      if((newCounters = (WlzPerfCounter *)
+			AlcRealloc(wlzPerfCounters,
+				   newMax * sizeof(WlzPerfCounter))) == NULL)
+      {
+        idx = -1;
+      }
+      else
+      {
+	wlzPerfCounters = newCounters;
+	wlzPerfMaxCounter = newMax;
+      }
+    }
+    if(idx >= 0)
+    {
+      idx = wlzPerfNCounter++;
+      (void )memset(wlzPerfCounters + idx, 0, sizeof(WlzPerfCounter));
+      wlzPerfCounters[idx].name = name;
+    }
+  }
+  return(idx);
+}
+
+/*!
+* \return	Time of day in seconds.
+* \ingroup	WlzDebug
+* \brief	Gives the time used for performance counting.
+*/
+static double	WlzPerfTime(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (0.000001 * tv.tv_usec));
+}
+
+/*!
+* \return	Non-zero on success, zero if the write failed.
+* \ingroup	WlzDebug
+* \brief	Writes a scope name as a quoted JSON string.
+* \param	fP			Given file.
+* \param	name			Given name.
+*/
+static int	WlzPerfWriteName(FILE *fP, const char *name)
+{
+  int		ok;
+
+  ok = putc('"', fP) != EOF;
+  while(ok && *name)
+  {
+    if((*name == '"') || (*name == '\\'))
+    {
+      ok = putc('\\', fP) != EOF;
+    }
+    if(ok)
+    {
+      ok = putc((isprint((unsigned char )*name))? *name: '?', fP) != EOF;
+    }
+    ++name;
+  }
+  if(ok)
+  {
+    ok = putc('"', fP) != EOF;
+  }
+  return(ok);
+}
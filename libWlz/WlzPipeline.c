@@ -0,0 +1,1111 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzPipeline_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzPipeline.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Registry of named object operations and a pipeline
+*		which applies a chain of them to objects in memory.
+* \ingroup	WlzPipeline
+*
+* \par
+*		A pipeline is described by a string of stages separated
+*		by '|' characters, with each stage being an operation
+*		name followed by white space separated arguments, eg:
+*		\verbatim
+		  gauss 2.0 | threshold 100 high | erosion 8 | label
+		\endverbatim
+*		This allows chains of operations, which would otherwise
+*		be run as a pipeline of binWlz commands, to be run
+*		without writing and reading the intermediate objects.
+*		Operations which modify grey values in place (see
+*		::WLZ_PIPELINE_OP_INPLACE) reuse the values of the
+*		previous stage when that stage made new values
+*		(see ::WLZ_PIPELINE_OP_NEWVAL), otherwise they are
+*		given a copy so that values shared with the input
+*		object are never modified. Further operations may
+*		be added using WlzPipelineOpRegister().
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+static WlzObject		*WlzPipelineOpThreshold(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpDilation(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpErosion(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpGauss(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpConvert(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpAffine(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpShift(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpInvert(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpEqualise(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpLabel(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpDomain(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPipelineOpCopy(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzPipelineParseConnect(
+				  WlzObject *obj,
+				  int nArg,
+				  char **arg,
+				  WlzConnectType *dstCon);
+static WlzErrorNum		WlzPipelineParseDouble(
+				  const char *str,
+				  double *dstVal);
+static double			WlzPipelineTime(void);
+
+/*!
+* \brief	Built in operations, see WlzPipelineOpFind().
+*/
+static const WlzPipelineOp wlzPipelineBuiltinOps[] =
+{
+  {
+    "threshold", 1, 2, 0,
+    "threshold <value> [high|low|equal]",
+    WlzPipelineOpThreshold
+  },
+  {
+    "dilation", 0, 1, 0,
+    "dilation [4|8|6|18|26]",
+    WlzPipelineOpDilation
+  },
+  {
+    "erosion", 0, 1, 0,
+    "erosion [4|8|6|18|26]",
+    WlzPipelineOpErosion
+  },
+  {
+    "gauss", 1, 3, WLZ_PIPELINE_OP_NEWVAL,
+    "gauss <sigma x> [<sigma y> [<sigma z>]]",
+    WlzPipelineOpGauss
+  },
+  {
+    "convert", 1, 1, WLZ_PIPELINE_OP_NEWVAL,
+    "convert int|short|ubyte|float|double|rgba",
+    WlzPipelineOpConvert
+  },
+  {
+    "affine", 2, 7, WLZ_PIPELINE_OP_NEWVAL,
+    "affine <tx> <ty> [<tz> [<scale> [<theta> [<phi> [nearest|linear]]]]]",
+    WlzPipelineOpAffine
+  },
+  {
+    "shift", 2, 3, 0,
+    "shift <x> <y> [<z>]",
+    WlzPipelineOpShift
+  },
+  {
+    "invert", 0, 0, WLZ_PIPELINE_OP_INPLACE,
+    "invert",
+    WlzPipelineOpInvert
+  },
+  {
+    "equalise", 0, 1, WLZ_PIPELINE_OP_INPLACE,
+    "equalise [<smoothing>]",
+    WlzPipelineOpEqualise
+  },
+  {
+    "label", 0, 2, 0,
+    "label [<max objects> [4|8|6|18|26]]",
+    WlzPipelineOpLabel
+  },
+  {
+    "domain", 0, 0, 0,
+    "domain",
+    WlzPipelineOpDomain
+  },
+  {
+    "copy", 0, 0, WLZ_PIPELINE_OP_NEWVAL,
+    "copy",
+    WlzPipelineOpCopy
+  }
+};
+
+/*!
+* \brief	Operations added by WlzPipelineOpRegister().
+*/
+static WlzPipelineOp	*wlzPipelineUserOps = NULL;
+static int		wlzPipelineUserOpsCnt = 0;
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzPipeline
+* \brief	Adds an operation to the registry. An operation with
+*		the same name as an existing operation replaces it for
+*		all subsequently parsed pipelines. The operation's
+*		name and usage strings are not copied and must remain
+*		valid. This function is not thread safe and should be
+*		called before any pipelines are parsed.
+* \param	op			Given operation.
+*/
+WlzErrorNum	WlzPipelineOpRegister(const WlzPipelineOp *op)
+{
+  WlzPipelineOp	*ops;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((op == NULL) || (op->name == NULL) || (op->fn == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((op->minArg < 0) || (op->maxArg < op->minArg))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((ops = (WlzPipelineOp *)
+                 AlcRealloc(wlzPipelineUserOps, sizeof(WlzPipelineOp) *
+			    (wlzPipelineUserOpsCnt + 1))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    wlzPipelineUserOps = ops;
+    wlzPipelineUserOps[wlzPipelineUserOpsCnt++] = *op;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of registered operations.
+* \ingroup	WlzPipeline
+* \brief	Gives the number of operations in the registry, which
+*		may be used with WlzPipelineOpGet() to list them.
+*/
+int		WlzPipelineOpCount(void)
+{
+  int		cnt;
+
+  cnt = wlzPipelineUserOpsCnt +
+        (sizeof(wlzPipelineBuiltinOps) / sizeof(WlzPipelineOp));
+  return(cnt);
+}
+
+/*!
+* \return	Operation or NULL if the index is out of range.
+* \ingroup	WlzPipeline
+* \brief	Gets an operation from the registry by index, with the
+*		registered operations before the built in operations.
+* \param	idx			Index of the operation, range
+*					[0 - WlzPipelineOpCount()).
+*/
+const WlzPipelineOp *WlzPipelineOpGet(int idx)
+{
+  const WlzPipelineOp *op = NULL;
+
+  if(idx >= 0)
+  {
+    if(idx < wlzPipelineUserOpsCnt)
+    {
+      op = wlzPipelineUserOps + idx;
+    }
+    else if((idx - wlzPipelineUserOpsCnt) <
+            (int )(sizeof(wlzPipelineBuiltinOps) / sizeof(WlzPipelineOp)))
+    {
+      op = wlzPipelineBuiltinOps + idx - wlzPipelineUserOpsCnt;
+    }
+  }
+  return(op);
+}
+
+/*!
+* \return	Operation or NULL if no operation has the name.
+* \ingroup	WlzPipeline
+* \brief	Finds the operation with the given name, searching the
+*		registered operations (most recent first) before the
+*		built in operations.
+* \param	name			Given operation name.
+*/
+const WlzPipelineOp *WlzPipelineOpFind(const char *name)
+{
+  int		idx;
+  const WlzPipelineOp *op = NULL;
+
+  if(name)
+  {
+    for(idx = wlzPipelineUserOpsCnt - 1; idx >= 0; --idx)
+    {
+      if(strcmp(name, wlzPipelineUserOps[idx].name) == 0)
+      {
+        op = wlzPipelineUserOps + idx;
+	break;
+      }
+    }
+    if(op == NULL)
+    {
+      int	nOps;
+
+      nOps = sizeof(wlzPipelineBuiltinOps) / sizeof(WlzPipelineOp);
+      for(idx = 0; idx < nOps; ++idx)
+      {
+	if(strcmp(name, wlzPipelineBuiltinOps[idx].name) == 0)
+	{
+	  op = wlzPipelineBuiltinOps + idx;
+	  break;
+	}
+      }
+    }
+  }
+  return(op);
+}
+
+/*!
+* \return	New pipeline or NULL on error.
+* \ingroup	WlzPipeline
+* \brief	Parses a pipeline description, with stages separated
+*		by '|' characters and each stage being an operation
+*		name followed by white space separated arguments.
+*		Each operation is looked up using WlzPipelineOpFind()
+*		and its number of arguments checked.
+*		The pipeline should be freed using WlzPipelineFree().
+* \param	desc			Pipeline description.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzPipeline	*WlzPipelineParse(const char *desc, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nStage = 0,
+		nTok = 0;
+  char		*cP;
+  WlzPipeline	*pipe = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(desc == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((pipe = (WlzPipeline *)AlcCalloc(1, sizeof(WlzPipeline))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((pipe->str = AlcStrDup(desc)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Count the stages and tokens, with '|' separators as tokens too so
+   * that nTok bounds the number of arguments. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		inTok = 0;
+
+    nStage = 1;
+    for(cP = pipe->str; *cP; ++cP)
+    {
+      if(*cP == '|')
+      {
+        ++nStage;
+	++nTok;
+	inTok = 0;
+      }
+      else if(isspace((int )*cP))
+      {
+        inTok = 0;
+      }
+      else if(!inTok)
+      {
+        ++nTok;
+	inTok = 1;
+      }
+    }
+    if(((pipe->stages = (WlzPipelineStage *)
+                        AlcCalloc(nStage, sizeof(WlzPipelineStage))) == NULL) ||
+       ((pipe->args = (char **)AlcMalloc(sizeof(char *) * (nTok + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Split the string in place into the stages' names and arguments. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		nArg = 0;
+    WlzPipelineStage *stage;
+
+    cP = pipe->str;
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nStage); ++idx)
+    {
+      stage = pipe->stages + idx;
+      stage->arg = pipe->args + nArg;
+      while(*cP && (*cP != '|'))
+      {
+        if(isspace((int )*cP))
+	{
+	  *cP++ = '\0';
+	}
+	else
+	{
+	  pipe->args[nArg++] = cP;
+	  ++(stage->nArg);
+	  while(*cP && (*cP != '|') && !isspace((int )*cP))
+	  {
+	    ++cP;
+	  }
+	}
+      }
+      if(*cP == '|')
+      {
+        *cP++ = '\0';
+      }
+      if(stage->nArg < 1)
+      {
+        errNum = WLZ_ERR_PARAM_DATA;	    /* Empty stage, eg "a || b". */
+      }
+      else if((stage->op = WlzPipelineOpFind(stage->arg[0])) == NULL)
+      {
+        errNum = WLZ_ERR_PARAM_DATA;
+      }
+      else
+      {
+	/* Skip the operation name leaving just the arguments. */
+        ++(stage->arg);
+	--(stage->nArg);
+	if((stage->nArg < stage->op->minArg) ||
+	   (stage->nArg > stage->op->maxArg))
+	{
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+      }
+      pipe->nStage = idx + 1;
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzPipelineFree(pipe);
+    pipe = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pipe);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzPipeline
+* \brief	Frees a pipeline made by WlzPipelineParse().
+* \param	pipe			Given pipeline, may be NULL.
+*/
+void		WlzPipelineFree(WlzPipeline *pipe)
+{
+  if(pipe)
+  {
+    AlcFree(pipe->stages);
+    AlcFree(pipe->args);
+    AlcFree(pipe->str);
+    AlcFree(pipe);
+  }
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	WlzPipeline
+* \brief	Applies each stage of the pipeline in turn to the given
+*		object. Intermediate objects are freed as soon as the
+*		following stage has used them, so at most two stages'
+*		objects are held at any time. The given object is not
+*		modified, although the returned object may share its
+*		domain or values.
+* \param	pipe			Given pipeline.
+* \param	inObj			Given object.
+* \param	stageTimes		If non NULL an array of
+*					pipe->nStage times to which the
+*					elapsed time (in seconds) of each
+*					stage is added.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzPipelineRun(WlzPipeline *pipe, WlzObject *inObj,
+				double *stageTimes, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		owned = 0,
+		ownVal = 0;
+  WlzObject	*cur,
+  		*nxt,
+		*rtnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  cur = inObj;
+  if((pipe == NULL) || (inObj == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < pipe->nStage); ++idx)
+  {
+    double	t0;
+    WlzPipelineStage *stage;
+
+    stage = pipe->stages + idx;
+    t0 = WlzPipelineTime();
+    /* In place operations are only given values that no other object
+     * can share, otherwise they are given a copy. */
+    if(((stage->op->flags & WLZ_PIPELINE_OP_INPLACE) != 0) && !ownVal)
+    {
+      if((nxt = WlzAssignObject(WlzCopyObject(cur, &errNum), NULL)) != NULL)
+      {
+	if(owned)
+	{
+	  (void )WlzFreeObj(cur);
+	}
+        cur = nxt;
+	owned = 1;
+	ownVal = 1;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nxt = stage->op->fn(cur, stage->nArg, stage->arg, &errNum);
+      if((errNum == WLZ_ERR_NONE) && (nxt == NULL))
+      {
+        errNum = WLZ_ERR_OBJECT_NULL;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (nxt != cur))
+    {
+      nxt = WlzAssignObject(nxt, NULL);
+      if(owned)
+      {
+        (void )WlzFreeObj(cur);
+      }
+      cur = nxt;
+      owned = 1;
+      ownVal = (stage->op->flags & WLZ_PIPELINE_OP_NEWVAL) != 0;
+    }
+    if(stageTimes)
+    {
+      stageTimes[idx] += WlzPipelineTime() - t0;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(owned)
+    {
+      /* Give up this function's link to the object, so that it is
+       * returned just as a newly made object would be. */
+#ifdef _OPENMP
+#pragma omp critical (WlzLinkcount)
+#endif
+      {
+        --(cur->linkcount);
+      }
+      rtnObj = cur;
+    }
+    else
+    {
+      rtnObj = WlzMakeMain(cur->type, cur->domain, cur->values,
+                           cur->plist, cur->assoc, &errNum);
+    }
+  }
+  else if(owned)
+  {
+    (void )WlzFreeObj(cur);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rtnObj);
+}
+
+/*!
+* \return	Woolz error code, the first error encountered.
+* \ingroup	WlzPipeline
+* \brief	Applies the pipeline to each of the given objects,
+*		which are processed in parallel. On return each of
+*		the output objects is either a new object or NULL
+*		if the pipeline failed for that object.
+* \param	pipe			Given pipeline.
+* \param	nObj			Number of objects.
+* \param	inObjs			Array of given objects.
+* \param	outObjs			Array for the output objects.
+* \param	stageTimes		If non NULL an array of
+*					pipe->nStage times to which the
+*					elapsed time (in seconds) of each
+*					stage, summed over all the objects,
+*					is added.
+*/
+WlzErrorNum	WlzPipelineRunN(WlzPipeline *pipe, int nObj,
+				WlzObject **inObjs, WlzObject **outObjs,
+				double *stageTimes)
+{
+  int		idx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((pipe == NULL) || (inObjs == NULL) || (outObjs == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(idx = 0; idx < nObj; ++idx)
+    {
+      int	idS;
+      double	*tms = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(stageTimes &&
+         ((tms = (double *)AlcCalloc(pipe->nStage, sizeof(double))) == NULL))
+      {
+        errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+      outObjs[idx] = NULL;
+      if(errNum2 == WLZ_ERR_NONE)
+      {
+        outObjs[idx] = WlzPipelineRun(pipe, inObjs[idx], tms, &errNum2);
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzPipelineRunN)
+#endif
+      {
+	if(tms)
+	{
+	  for(idS = 0; idS < pipe->nStage; ++idS)
+	  {
+	    stageTimes[idS] += tms[idS];
+	  }
+	}
+        if((errNum == WLZ_ERR_NONE) && (errNum2 != WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(tms);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Elapsed time in seconds.
+* \brief	Gives the time of day for the stage timings.
+*/
+static double	WlzPipelineTime(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (0.000001 * tv.tv_usec));
+}
+
+/*!
+* \return	Woolz error code.
+* \brief	Parses a double value from an argument string.
+* \param	str			Given string.
+* \param	dstVal			Destination for the value.
+*/
+static WlzErrorNum WlzPipelineParseDouble(const char *str, double *dstVal)
+{
+  char		*endP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  *dstVal = strtod(str, &endP);
+  if((endP == str) || (*endP != '\0'))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \brief	Parses an optional connectivity argument, which defaults
+*		to 8 connected for 2D objects and 26 connected for 3D
+*		objects.
+* \param	obj			Object the operation is applied to.
+* \param	nArg			Number of arguments, the argument
+*					is only used if this is non-zero.
+* \param	arg			Connectivity argument.
+* \param	dstCon			Destination for the connectivity.
+*/
+static WlzErrorNum WlzPipelineParseConnect(WlzObject *obj,
+				int nArg, char **arg, WlzConnectType *dstCon)
+{
+  int		con;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nArg < 1)
+  {
+    *dstCon = (obj->type == WLZ_3D_DOMAINOBJ)?
+              WLZ_26_CONNECTED: WLZ_8_CONNECTED;
+  }
+  else if(WlzStringMatchValue(&con, arg[0],
+			      "4", WLZ_4_CONNECTED,
+			      "8", WLZ_8_CONNECTED,
+			      "6", WLZ_6_CONNECTED,
+			      "18", WLZ_18_CONNECTED,
+			      "26", WLZ_26_CONNECTED,
+			      NULL))
+  {
+    *dstCon = (WlzConnectType )con;
+  }
+  else
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Thresholded object or NULL on error.
+* \brief	Pipeline operation: threshold <value> [high|low|equal],
+*		see WlzThreshold().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpThreshold(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  int		hL = WLZ_THRESH_HIGH;
+  WlzPixelV	thr;
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum;
+
+  thr.type = WLZ_GREY_DOUBLE;
+  errNum = WlzPipelineParseDouble(arg[0], &(thr.v.dbv));
+  if((errNum == WLZ_ERR_NONE) && (nArg > 1) &&
+     (WlzStringMatchValue(&hL, arg[1],
+			  "high", WLZ_THRESH_HIGH,
+			  "low", WLZ_THRESH_LOW,
+			  "equal", WLZ_THRESH_EQUAL,
+			  NULL) == 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzThreshold(obj, thr, (WlzThresholdType )hL, &errNum);
+  }
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	Dilated object or NULL on error.
+* \brief	Pipeline operation: dilation [4|8|6|18|26], see
+*		WlzDilation().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpDilation(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  WlzConnectType con;
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum;
+
+  if((errNum = WlzPipelineParseConnect(obj, nArg, arg,
+                                       &con)) == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzDilation(obj, con, &errNum);
+  }
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	Eroded object or NULL on error.
+* \brief	Pipeline operation: erosion [4|8|6|18|26], see
+*		WlzErosion().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpErosion(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  WlzConnectType con;
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum;
+
+  if((errNum = WlzPipelineParseConnect(obj, nArg, arg,
+                                       &con)) == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzErosion(obj, con, &errNum);
+  }
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	Filtered object or NULL on error.
+* \brief	Pipeline operation: gauss <sigma x> [<sigma y> [<sigma z>]],
+*		see WlzGaussFilter(). Missing sigma values are the same
+*		as the previous sigma value.
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpGauss(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  WlzDVertex3	sigma;
+  WlzIVertex3	order,
+  		direc;
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum;
+
+  errNum = WlzPipelineParseDouble(arg[0], &(sigma.vtX));
+  sigma.vtY = sigma.vtZ = sigma.vtX;
+  if((errNum == WLZ_ERR_NONE) && (nArg > 1))
+  {
+    errNum = WlzPipelineParseDouble(arg[1], &(sigma.vtY));
+    sigma.vtZ = sigma.vtY;
+  }
+  if((errNum == WLZ_ERR_NONE) && (nArg > 2))
+  {
+    errNum = WlzPipelineParseDouble(arg[2], &(sigma.vtZ));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WLZ_VTX_3_SET(order, 0, 0, 0);
+    WLZ_VTX_3_SET(direc, 1, 1, (obj->type == WLZ_3D_DOMAINOBJ)? 1: 0);
+    rtnObj = WlzGaussFilter(obj, sigma, order, direc, WLZ_GREY_ERROR,
+                            ALG_PAD_END, 0.0, 0, &errNum);
+  }
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	Converted object, the given object if it already has the
+*		required grey type, or NULL on error.
+* \brief	Pipeline operation:
+*		convert int|short|ubyte|float|double|rgba,
+*		see WlzConvertPix().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpConvert(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  int		gType;
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(WlzStringMatchValue(&gType, arg[0],
+			 "int", WLZ_GREY_INT,
+			 "short", WLZ_GREY_SHORT,
+			 "ubyte", WLZ_GREY_UBYTE,
+			 "float", WLZ_GREY_FLOAT,
+			 "double", WLZ_GREY_DOUBLE,
+			 "rgba", WLZ_GREY_RGBA,
+			 NULL) == 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(WlzGreyTypeFromObj(obj, &errNum) == (WlzGreyType )gType)
+  {
+    rtnObj = obj;
+  }
+  else if(errNum == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzConvertPix(obj, (WlzGreyType )gType, &errNum);
+  }
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	Transformed object or NULL on error.
+* \brief	Pipeline operation: affine <tx> <ty> [<tz> [<scale>
+*		[<theta> [<phi> [nearest|linear]]]]], with the angles
+*		in degrees, see WlzAffineTransformFromPrimVal() and
+*		WlzAffineTransformObj().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpAffine(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		interp = WLZ_INTERPOLATION_NEAREST;
+  double	prm[6] = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0};
+  WlzAffineTransform *tr = NULL;
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nArg) && (idx < 6); ++idx)
+  {
+    errNum = WlzPipelineParseDouble(arg[idx], prm + idx);
+  }
+  if((errNum == WLZ_ERR_NONE) && (nArg > 6) &&
+     (WlzStringMatchValue(&interp, arg[6],
+			  "nearest", WLZ_INTERPOLATION_NEAREST,
+			  "linear", WLZ_INTERPOLATION_LINEAR,
+			  NULL) == 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr = WlzAffineTransformFromPrimVal(
+    		(obj->type == WLZ_3D_DOMAINOBJ)?
+		WLZ_TRANSFORM_3D_AFFINE: WLZ_TRANSFORM_2D_AFFINE,
+		prm[0], prm[1], prm[2], prm[3],
+		prm[4] * WLZ_M_PI / 180.0, prm[5] * WLZ_M_PI / 180.0,
+		0.0, 0.0, 0.0, 0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzAffineTransformObj(obj, tr,
+                                   (WlzInterpolationType )interp, &errNum);
+  }
+  (void )WlzFreeAffineTransform(tr);
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	Shifted object or NULL on error.
+* \brief	Pipeline operation: shift <x> <y> [<z>], see
+*		WlzShiftObject().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpShift(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  int		idx;
+  double	s[3] = {0.0, 0.0, 0.0};
+  WlzObject	*rtnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nArg); ++idx)
+  {
+    errNum = WlzPipelineParseDouble(arg[idx], s + idx);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzShiftObject(obj, WLZ_NINT(s[0]), WLZ_NINT(s[1]),
+    			    WLZ_NINT(s[2]), &errNum);
+  }
+  *dstErr = errNum;
+  return(rtnObj);
+}
+
+/*!
+* \return	The given object with its values inverted in place.
+* \brief	Pipeline operation: invert, which inverts the grey
+*		values within their range, see WlzGreyInvertMinMax().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpInvert(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  WlzPixelV	min,
+  		max;
+  WlzErrorNum	errNum;
+
+  if((errNum = WlzGreyRange(obj, &min, &max)) == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyInvertMinMax(obj, min, max);
+  }
+  *dstErr = errNum;
+  return((errNum == WLZ_ERR_NONE)? obj: NULL);
+}
+
+/*!
+* \return	The given object with its values equalised in place.
+* \brief	Pipeline operation: equalise [<smoothing>], see
+*		WlzHistogramEqualiseObj().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpEqualise(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  double	smooth = 0.0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nArg > 0)
+  {
+    errNum = WlzPipelineParseDouble(arg[0], &smooth);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzHistogramEqualiseObj(obj, WLZ_NINT(smooth), 0);
+  }
+  *dstErr = errNum;
+  return((errNum == WLZ_ERR_NONE)? obj: NULL);
+}
+
+/*!
+* \return	Compound array of the labeled objects or NULL on error.
+* \brief	Pipeline operation: label [<max objects> [4|8|6|18|26]],
+*		see WlzLabel(). The default maximum number of objects
+*		is 1024.
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpLabel(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nLbl = 0;
+  double	maxLbl = 1024.0;
+  WlzConnectType con;
+  WlzObject	**lbl = NULL;
+  WlzCompoundArray *cObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nArg > 0)
+  {
+    errNum = WlzPipelineParseDouble(arg[0], &maxLbl);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzPipelineParseConnect(obj, nArg - 1, arg + 1, &con);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzLabel(obj, &nLbl, &lbl, WLZ_NINT(maxLbl), 0, con);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cObj = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 3, nLbl, lbl,
+                                obj->type, &errNum);
+  }
+  if(lbl)
+  {
+    /* The labeled objects are assigned both by WlzLabel() and by the
+     * compound object, so this function's links are always freed. */
+    for(idx = 0; idx < nLbl; ++idx)
+    {
+      (void )WlzFreeObj(lbl[idx]);
+    }
+    AlcFree(lbl);
+  }
+  *dstErr = errNum;
+  return((WlzObject *)cObj);
+}
+
+/*!
+* \return	New object with the given object's domain but no values,
+*		or NULL on error.
+* \brief	Pipeline operation: domain, which discards the values.
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpDomain(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  WlzValues	nullVal;
+
+  nullVal.core = NULL;
+  return(WlzMakeMain(obj->type, obj->domain, nullVal, NULL, NULL, dstErr));
+}
+
+/*!
+* \return	Copy of the given object or NULL on error.
+* \brief	Pipeline operation: copy, see WlzCopyObject().
+* \param	obj			Given object.
+* \param	nArg			Number of arguments.
+* \param	arg			Arguments.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzPipelineOpCopy(WlzObject *obj, int nArg,
+				char **arg, WlzErrorNum *dstErr)
+{
+  return(WlzCopyObject(obj, dstErr));
+}
@@ -166,6 +166,14 @@ extern WlzObject 		*WlzGetSubSectionFromObject(
 				  WlzInterpolationType	interp,
 				  WlzObject	**maskRtn,
 				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzGetSectionTileFromObject(
+				  WlzObject *obj,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzThreeDViewStruct *view,
+				  WlzInterpolationType interp,
+				  double scale,
+				  WlzIBox2 tile,
+				  WlzGreyP dst);
 #endif
 
 /************************************************************************
@@ -997,6 +1005,9 @@ extern WlzObject		*WlzSetBackGroundNewObj(
 ************************************************************************/
 extern WlzErrorNum		WlzBasisFnFree(
 				  WlzBasisFn *basisFn);
+extern WlzErrorNum		WlzBasisFnSetTree(
+				  WlzBasisFn *basisFn,
+				  double tol);
 extern WlzDVertex2		WlzBasisFnValueGauss2D(
 				  WlzBasisFn *basisFn,
 				  WlzDVertex2 srcVx);
@@ -1021,6 +1032,12 @@ extern WlzDVertex2		WlzBasisFnValueTPS2D(
 extern WlzDVertex2		WlzBasisFnValueConf2D(
 				  WlzBasisFn *basisFn,
 				  WlzDVertex2 srcVx);
+extern WlzDVertex2		WlzBasisFnValueCS2D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex2 srcVx);
+extern WlzDVertex3		WlzBasisFnValueCS3D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex3 srcVx);
 WlzDVertex3     		WlzBasisFnValueMOS3D(
 				  WlzBasisFn *basisFn,
 				  WlzDVertex3 srcVx);
@@ -1091,6 +1108,20 @@ extern WlzBasisFn		*WlzBasisFnTPS2DFromCPts(
 				  WlzBasisFn *prvBasisFn,
 				  WlzCMesh2D *mesh,
 				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnCS2DFromCPts(
+				  int nPts,
+				  WlzDVertex2 *dPts,
+				  WlzDVertex2 *sPts,
+				  double rho,
+				  double alpha,
+				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnCS3DFromCPts(
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  double rho,
+				  double alpha,
+				  WlzErrorNum *dstErr);
 extern WlzBasisFn 		*WlzBasisFnMOS3DFromCPts(
 				  int nPts,
 				  WlzDVertex2 *dPts,
@@ -1607,6 +1638,21 @@ extern WlzErrorNum     		WlzCMeshFMarNodes3D(
 				  double *distances,
 				  int sizeArraySeedPos,
 				  WlzDVertex3 *arraySeedPos);
+extern WlzErrorNum     		WlzCMeshFIMNodes2D(
+				  WlzCMesh2D *mesh,
+				  double *distances,
+				  int sizeArraySeedPos,
+				  WlzDVertex2 *arraySeedPos);
+extern WlzErrorNum     		WlzCMeshFIMNodes2D5(
+				  WlzCMesh2D5 *mesh,
+				  double *distances,
+				  int sizeArraySeedPos,
+				  WlzDVertex3 *arraySeedPos);
+extern WlzErrorNum     		WlzCMeshFIMNodes3D(
+				  WlzCMesh3D *mesh,
+				  double *distances,
+				  int sizeArraySeedPos,
+				  WlzDVertex3 *arraySeedPos);
 #endif /* WLZ_EXT_BIND */
 extern WlzObject		*WlzCMeshDistance2D(
 				  WlzObject *mObj,
@@ -2548,6 +2594,12 @@ extern WlzObject 		*WlzDistanceTransform(
 				  double dParam,
 				  double dMax,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzDistanceTransformEDT(
+				  WlzObject *forObj,
+				  WlzObject *refObj,
+				  WlzGreyType gType,
+				  double dMax,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzDomainFill.c							*
@@ -3842,6 +3894,29 @@ extern void	                WlzGreyValueGetDir(
 				  int plane,
 				  int line,
 				  int kol);
+extern WlzGreyValueCursor	*WlzGreyValueMakeCursor(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzErrorNum *dstErr);
+extern void			WlzGreyValueFreeCursor(
+				  WlzGreyValueCursor *gVCur);
+extern void			WlzGreyValueCursorGet(
+				  WlzGreyValueCursor *gVCur,
+				  double plane,
+				  double line,
+				  double kol);
+extern void			WlzGreyValueCursorGetN(
+				  WlzGreyValueCursor *gVCur,
+				  int n,
+				  WlzDVertex3 *pos,
+				  double *dstVal,
+				  WlzUByte *dstBkd);
+extern void			WlzGreyValueCursorGetRunsI(
+				  WlzGreyValueCursor *gVCur,
+				  int n,
+				  int len,
+				  int stride,
+				  WlzIVertex3 *pos,
+				  double *dstVal);
 
 
 /************************************************************************
@@ -4349,6 +4424,16 @@ extern WlzObject		*WlzLabel3D(
 				  int ignLn,
 				  WlzConnectType con,
 				  WlzErrorNum *dstErr);
+/************************************************************************
+* WlzLabelParallel.c
+************************************************************************/
+extern WlzErrorNum		WlzLabelParallel(
+				  WlzObject *obj,
+				  int *dstNObj,
+				  WlzObject ***dstObjs,
+				  int maxNumObjs,
+				  int ignlns,
+				  WlzConnectType connect);
 
 /************************************************************************
 * WlzLaplacian.c							*
@@ -4772,6 +4857,15 @@ extern double          		WlzMatchICPWeightMatches(
 				  void *data);
 #endif /* WLZ_EXT_BIND */
 
+/************************************************************************
+* WlzMergeN.c								*
+************************************************************************/
+extern WlzObject		*WlzMergeNReduce(
+				  int n,
+				  WlzObject **objs,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+
 /************************************************************************
 * WlzMeshGen.c								*
 ************************************************************************/
@@ -5269,6 +5363,19 @@ extern WlzMeshTransform 	*WlzMeshTransformFromCPts(
 				  double meshMinDist,
 				  double meshMaxDist,
 				  WlzErrorNum *dstErr);
+extern WlzMeshTransform 	*WlzMeshTransformFromCPtsTree(
+				  WlzObject *obj,
+				  WlzFnType basisFnType,
+				  int polyOrder,
+				  int nDPts,
+				  WlzDVertex2 *dPts,
+				  int nSPts,
+				  WlzDVertex2 *sPts,
+				  WlzMeshGenMethod meshGenMtd,
+				  double meshMinDist,
+				  double meshMaxDist,
+				  double treeTol,
+				  WlzErrorNum *dstErr);
 extern WlzErrorNum		WlzMeshAffineProduct(
 				  WlzMeshTransform *mTr,
 				  WlzAffineTransform *aTr,
@@ -5419,6 +5526,35 @@ extern WlzObject		*WlzOffsetDist(
 				  int maxDist,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzPipeline.c								*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzPipelineOpRegister(
+				  const WlzPipelineOp *op);
+extern int			WlzPipelineOpCount(void);
+extern const WlzPipelineOp	*WlzPipelineOpGet(
+				  int idx);
+extern const WlzPipelineOp	*WlzPipelineOpFind(
+				  const char *name);
+extern WlzPipeline		*WlzPipelineParse(
+				  const char *desc,
+				  WlzErrorNum *dstErr);
+extern void			WlzPipelineFree(
+				  WlzPipeline *pipe);
+extern WlzObject		*WlzPipelineRun(
+				  WlzPipeline *pipe,
+				  WlzObject *inObj,
+				  double *stageTimes,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzPipelineRunN(
+				  WlzPipeline *pipe,
+				  int nObj,
+				  WlzObject **inObjs,
+				  WlzObject **outObjs,
+				  double *stageTimes);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzPoints.c								*
 ************************************************************************/
@@ -5598,6 +5734,9 @@ extern WlzObjectType		WlzReadObjType(
 extern WlzObject		*WlzReadObj(
 				  FILE *fP,
 			          WlzErrorNum *dstErr);
+extern WlzObject		*WlzReadObjMapped(
+				  int fd,
+			          WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
 extern WlzMeshTransform3D 	*WlzReadMeshTransform3D(
 				  FILE *fP,
@@ -6235,6 +6374,28 @@ extern WlzObject 		*WlzStructDilation(
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzStructElmDecomp.c							*
+************************************************************************/
+extern WlzStructElmDecomp	*WlzStructElmDecompose(
+				  WlzObject *sObj,
+				  WlzErrorNum *dstErr);
+extern WlzStructElmDecomp	*WlzMakeStdStructElmDecomp(
+				  WlzObjectType oType,
+				  WlzDistanceType dType,
+				  double radius,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeStructElmDecomp(
+				  WlzStructElmDecomp *dec);
+extern WlzObject		*WlzStructDecompDilation(
+				  WlzObject *obj,
+				  WlzStructElmDecomp *dec,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzStructDecompErosion(
+				  WlzObject *obj,
+				  WlzStructElmDecomp *dec,
+				  WlzErrorNum *dstErr);
+
 /************************************************************************
 * WlzStructErosion.c							*
 ************************************************************************/
@@ -6519,6 +6680,31 @@ extern void			WlzTiledValuesCopyLine(
 extern void			WlzTiledValueBufferFill(
 				  WlzTiledValueBuffer *tvb,
 				  WlzTiledValues *tv);
+extern WlzTiledValuesCmp	*WlzMakeTiledValuesCmp(
+				  WlzTiledValuesCmpType type,
+				  size_t numTiles,
+				  WlzErrorNum *dstErr);
+extern void			WlzFreeTiledValuesCmp(
+				  WlzTiledValuesCmp *cmp);
+extern WlzTiledValues		*WlzTiledValuesCompress(
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesCmpType type,
+				  int level,
+				  WlzErrorNum *dstErr);
+extern WlzTiledValuesTile	*WlzTiledValuesTileGet(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzErrorNum *dstErr);
+extern void			WlzTiledValuesTileRelease(
+				  WlzTiledValuesTile *tile);
+extern WlzErrorNum		WlzTiledValuesCacheSetMax(
+				  WlzTiledValues *tVal,
+				  size_t maxSz);
+extern WlzErrorNum		WlzTiledValuesCacheStats(
+				  WlzTiledValues *tVal,
+				  size_t *dstHit,
+				  size_t *dstMiss,
+				  size_t *dstSz);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -7167,6 +7353,10 @@ extern const char 		*WlzWindowFnName(
 extern WlzErrorNum 		WlzWriteObj(
 				  FILE *fp,
 			          WlzObject *obj);
+extern WlzErrorNum 		WlzWriteObjFd(
+				  int fd,
+				  WlzLong *off,
+			          WlzObject *obj);
 
 #ifndef WLZ_EXT_BIND
 extern WlzErrorNum  		WlzWriteMeshTransform3D(
@@ -47,6 +47,49 @@ static char _WlzRank_c[] = "University of Edinburgh $Id$";
 #include <string.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzRankBuf
+* \ingroup	WlzValuesFilters
+* \brief	Dense copy of the grey values of an object's bounding box
+* 		used by the incremental rank filter. Either the histogram
+* 		bin of each voxel or its value and a domain mask are held.
+*/
+typedef struct _WlzRankBuf
+{
+  int		fSz;		/*!< Rank filter size. */
+  int		nPl;		/*!< Number of planes, 1 for 2D. */
+  int		nLn;		/*!< Number of lines. */
+  int		nKl;		/*!< Number of columns. */
+  int		plane1;		/*!< First plane. */
+  int		line1;		/*!< First line. */
+  int		kol1;		/*!< First column. */
+  int		min;		/*!< Value of histogram bin zero if there
+  				     is no look up table. */
+  int		nBin;		/*!< Number of histogram bins, zero if the
+  				     sorted window is used. */
+  int		sft;		/*!< Shift from a bin to a coarse bin. */
+  unsigned short *iBuf;		/*!< Histogram bin of each voxel or
+  				     WLZ_RANK_OUT if not in the domain. */
+  double	*lut;		/*!< Values of the histogram bins, may be
+  				     NULL. */
+  double	*dBuf;		/*!< Value of each voxel for the sorted
+  				     window. */
+  WlzUByte	*mBuf;		/*!< Non-zero for voxels in the domain
+  				     for the sorted window. */
+} WlzRankBuf;
+
+/*!
+* \def		WLZ_RANK_OUT
+* \ingroup	WlzValuesFilters
+* \brief	Histogram bin used to mark voxels which are not in the
+* 		domain, which also limits the number of bins.
+*/
+#define WLZ_RANK_OUT	(0xffff)
+
 static WlzErrorNum 		WlzRankFilterDomObj2D(
 				  WlzObject *gObj,
 				  int fSz,
@@ -83,6 +126,75 @@ static void			WlzRankFilterValues(
 				  void *values,
 				  int nValues,
 				  double rank);
+static void			WlzRankHistCol(
+				  WlzRankBuf *rb,
+				  int *hst,
+				  int *cHst,
+				  WlzIVertex3 w0,
+				  WlzIVertex3 w1,
+				  int x,
+				  int sgn,
+				  int m,
+				  int *lt,
+				  int *n);
+static void			WlzRankHistSeek(
+				  int *hst,
+				  int *cHst,
+				  int sft,
+				  int r,
+				  int *dstM,
+				  int *dstLt);
+static int			WlzRankSortCol(
+				  WlzRankBuf *rb,
+				  WlzIVertex3 w0,
+				  WlzIVertex3 w1,
+				  int x,
+				  double *buf);
+static WlzErrorNum		WlzRankBufToLut(
+				  WlzRankBuf *rb);
+static int			WlzRankDblCmp(
+				  const void *p0,
+				  const void *p1);
+static int			WlzRankSortMerge(
+				  double *sw,
+				  int n,
+				  double *lv,
+				  int nL,
+				  double *ev,
+				  int nE,
+				  double *dst);
+static WlzObject		*WlzRankPlaneObj(
+				  WlzObject *gObj,
+				  int p,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzRankFilterIncr(
+				  WlzObject *gObj,
+				  int fSz,
+				  double rank,
+				  WlzGreyType vType);
+static WlzErrorNum		WlzRankFilterIncrFillPl(
+				  WlzObject *obj2,
+				  WlzRankBuf *rb,
+				  int p);
+static WlzErrorNum		WlzRankFilterIncrPl(
+				  WlzObject *obj2,
+				  WlzRankBuf *rb,
+				  int p,
+				  double rank);
+static WlzErrorNum		WlzRankFilterMinMax(
+				  WlzRankBuf *rb,
+				  int mx);
+static void			WlzRankMinMaxLn(
+				  double *buf,
+				  double *g,
+				  double *s,
+				  int nP,
+				  int w,
+				  int mx);
+static WlzErrorNum		WlzRankFilterMinMaxPl(
+				  WlzObject *obj2,
+				  WlzRankBuf *rb,
+				  int p);
 
 /*!
 * \return	Woolz error code.
@@ -92,6 +204,21 @@ static void			WlzRankFilterValues(
 *		ranked value of the values in it's immediate neighborhood,
 *		where the neighborhood is a simple axis aligned cuboid
 *		with the size.
+*
+*		All but RGBA values are filtered incrementally: the
+*		filter window slides along each interval of the domain,
+*		only the values of the columns entering and leaving the
+*		window are added and removed. Integer values within a
+*		range of less than 65535 are ranked using a two level
+*		sliding histogram (Huang's algorithm). Other values are
+*		ranked using a histogram of a look up table of their
+*		distinct values if there are less than 65535 of them,
+*		otherwise using a sorted window into which the entering
+*		column is merged. 3D objects are filtered in parallel
+*		over planes. Minimum and maximum filters are separable
+*		and are computed along each axis in turn using the
+*		van Herk/Gil-Werman algorithm, which needs about three
+*		comparisons per value whatever the filter size.
 * \param	gObj			Given object.
 * \param	fSz			Rank filter size.
 * \param	rank			Required rank with values:
@@ -100,6 +227,7 @@ static void			WlzRankFilterValues(
 */
 WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
 {
+  WlzGreyType	vType = WLZ_GREY_ERROR;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(gObj == NULL)
@@ -134,17 +262,30 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
     }
     switch(gObj->type)
     {
-      case WLZ_2D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
-	break;
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
+	vType = WlzGreyTypeFromObj(gObj, &errNum);
 	break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
     }
   }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(vType != WLZ_GREY_RGBA)
+    {
+      errNum = WlzRankFilterIncr(gObj, fSz, rank, vType);
+    }
+    else if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
+    }
+    else
+    {
+      errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
+    }
+  }
   return(errNum);
 }
 
@@ -985,6 +1126,1278 @@ static void	WlzRankFilterValues(WlzGreyValueWSpace *gVWSp,
   }
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Applies a rank filter in place to the given 2D or 3D
+* 		object incrementally, see WlzRankFilter(). The values of
+* 		the object's bounding box are first copied to a dense
+* 		buffer (as histogram bins or values with a mask) so that
+* 		the planes may then be filtered in place and in parallel.
+* \param	gObj			Given object with non-tiled values.
+* \param	fSz			Rank filter size.
+* \param	rank			Required rank in the open interval
+* 					(0.0, 1.0).
+* \param	vType			Grey type of the object's values,
+* 					which must not be RGBA.
+*/
+static WlzErrorNum		WlzRankFilterIncr(
+				  WlzObject *gObj,
+				  int fSz,
+				  double rank,
+				  WlzGreyType vType)
+{
+  int		mx = 0;
+  size_t	nVx = 0;
+  WlzRankBuf	rb;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&rb, 0, sizeof(WlzRankBuf));
+  rb.fSz = fSz;
+  /* The extremal ranks are minimum (-1) and maximum (1) filters. */
+  if(rank <= DBL_EPSILON)
+  {
+    mx = -1;
+  }
+  else if(rank >= 1.0 - DBL_EPSILON)
+  {
+    mx = 1;
+  }
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    rb.nPl = 1;
+    rb.plane1 = 0;
+    rb.line1 = gObj->domain.i->line1;
+    rb.kol1 = gObj->domain.i->kol1;
+    rb.nLn = gObj->domain.i->lastln - rb.line1 + 1;
+    rb.nKl = gObj->domain.i->lastkl - rb.kol1 + 1;
+  }
+  else if(gObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(gObj->values.core->type != WLZ_VOXELVALUETABLE_GREY)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    rb.plane1 = gObj->domain.p->plane1;
+    rb.line1 = gObj->domain.p->line1;
+    rb.kol1 = gObj->domain.p->kol1;
+    rb.nPl = gObj->domain.p->lastpl - rb.plane1 + 1;
+    rb.nLn = gObj->domain.p->lastln - rb.line1 + 1;
+    rb.nKl = gObj->domain.p->lastkl - rb.kol1 + 1;
+  }
+  /* Nothing to filter unless the filter and buffer are larger than a
+   * single voxel. */
+  if((errNum == WLZ_ERR_NONE) &&
+     ((fSz > 1) && (rb.nPl > 0) && (rb.nLn > 0) && (rb.nKl > 0)))
+  {
+    nVx = (size_t )(rb.nPl) * rb.nLn * rb.nKl;
+  }
+  /* Use a histogram for integer values with a small enough range. */
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0) &&
+     ((vType == WLZ_GREY_UBYTE) || (vType == WLZ_GREY_SHORT) ||
+      (vType == WLZ_GREY_INT)))
+  {
+    WlzPixelV	minV,
+    		maxV;
+
+    errNum = WlzGreyRange(gObj, &minV, &maxV);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzValueConvertPixel(&minV, minV, WLZ_GREY_INT);
+      (void )WlzValueConvertPixel(&maxV, maxV, WLZ_GREY_INT);
+      if(((double )(maxV.v.inv) - minV.v.inv) < WLZ_RANK_OUT)
+      {
+	rb.min = minV.v.inv;
+	rb.nBin = maxV.v.inv - minV.v.inv + 1;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    if(rb.nBin > 0)
+    {
+      if((rb.iBuf = (unsigned short *)
+                    AlcMalloc(nVx * sizeof(unsigned short))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	size_t	i;
+
+	for(i = 0; i < nVx; ++i)
+	{
+	  rb.iBuf[i] = WLZ_RANK_OUT;
+	}
+      }
+    }
+    else if(((rb.dBuf = (double *)AlcMalloc(nVx * sizeof(double))) == NULL) ||
+            ((rb.mBuf = (WlzUByte *)AlcCalloc(nVx, sizeof(WlzUByte))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Copy the values of all planes into the buffer before any plane is
+   * filtered. */
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(p = 0; p < rb.nPl; ++p)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzObject *obj2;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	obj2 = WlzRankPlaneObj(gObj, p, &errNum2);
+	if(obj2 != NULL)
+	{
+	  errNum2 = WlzRankFilterIncrFillPl(obj2, &rb, p);
+	  (void )WlzFreeObj(obj2);
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRankFilterIncr)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    if(mx)
+    {
+      errNum = WlzRankFilterMinMax(&rb, mx);
+    }
+    else if(rb.nBin == 0)
+    {
+      errNum = WlzRankBufToLut(&rb);
+    }
+    while((1 << (2 * rb.sft)) < rb.nBin)
+    {
+      ++(rb.sft);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(p = 0; p < rb.nPl; ++p)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzObject *obj2;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	obj2 = WlzRankPlaneObj(gObj, p, &errNum2);
+	if(obj2 != NULL)
+	{
+	  errNum2 = (mx)? WlzRankFilterMinMaxPl(obj2, &rb, p):
+	                  WlzRankFilterIncrPl(obj2, &rb, p, rank);
+	  (void )WlzFreeObj(obj2);
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRankFilterIncr)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+  }
+  AlcFree(rb.iBuf);
+  AlcFree(rb.lut);
+  AlcFree(rb.dBuf);
+  AlcFree(rb.mBuf);
+  return(errNum);
+}
+
+/*!
+* \return	New 2D object or NULL if the plane is empty or on error.
+* \ingroup      WlzValuesFilters
+* \brief	Makes a 2D object for the given plane index of the given
+* 		object which shares its domain and values. For a 2D
+* 		object the object itself is returned (with its link
+* 		count incremented).
+* \param	gObj			Given 2D or 3D object.
+* \param	p			Plane index, relative to the first
+* 					plane.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzRankPlaneObj(
+				  WlzObject *gObj,
+				  int p,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*obj2 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    obj2 = WlzAssignObject(gObj, NULL);
+  }
+  else
+  {
+    WlzDomain	dom2;
+    WlzValues	val2;
+
+    dom2 = gObj->domain.p->domains[p];
+    val2 = gObj->values.vox->values[p];
+    if((dom2.core != NULL) && (dom2.core->type != WLZ_EMPTY_DOMAIN))
+    {
+      if(val2.core == NULL)
+      {
+        errNum = WLZ_ERR_VALUES_NULL;
+      }
+      else
+      {
+	obj2 = WlzAssignObject(
+	       WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, val2, NULL, NULL,
+	                   &errNum), NULL);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj2);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Copies the values of a single plane into the dense buffer.
+* \param	obj2			2D object for the plane.
+* \param	rb			Dense buffer.
+* \param	p			Plane index, relative to the first
+* 					plane.
+*/
+static WlzErrorNum		WlzRankFilterIncrFillPl(
+				  WlzObject *obj2,
+				  WlzRankBuf *rb,
+				  int p)
+{
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	k,
+      		w;
+      size_t	off;
+      WlzGreyP	gP;
+
+      gP = gWSp.u_grintptr;
+      w = iWSp.rgtpos - iWSp.lftpos + 1;
+      off = ((size_t )p * rb->nLn + iWSp.linpos - rb->line1) * rb->nKl +
+            iWSp.lftpos - rb->kol1;
+      if(rb->nBin > 0)
+      {
+	unsigned short *iP;
+
+	iP = rb->iBuf + off;
+	switch(gWSp.pixeltype)
+	{
+	  case WLZ_GREY_UBYTE:
+	    for(k = 0; k < w; ++k)
+	    {
+	      iP[k] = (unsigned short )(gP.ubp[k] - rb->min);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(k = 0; k < w; ++k)
+	    {
+	      iP[k] = (unsigned short )(gP.shp[k] - rb->min);
+	    }
+	    break;
+	  case WLZ_GREY_INT:
+	    for(k = 0; k < w; ++k)
+	    {
+	      iP[k] = (unsigned short )(gP.inp[k] - rb->min);
+	    }
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+      }
+      else
+      {
+	double	*dP;
+
+	dP = rb->dBuf + off;
+	(void )memset(rb->mBuf + off, 1, w);
+	switch(gWSp.pixeltype)
+	{
+	  case WLZ_GREY_UBYTE:
+	    for(k = 0; k < w; ++k)
+	    {
+	      dP[k] = gP.ubp[k];
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(k = 0; k < w; ++k)
+	    {
+	      dP[k] = gP.shp[k];
+	    }
+	    break;
+	  case WLZ_GREY_INT:
+	    for(k = 0; k < w; ++k)
+	    {
+	      dP[k] = gP.inp[k];
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(k = 0; k < w; ++k)
+	    {
+	      dP[k] = gP.flp[k];
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    for(k = 0; k < w; ++k)
+	    {
+	      dP[k] = gP.dbp[k];
+	    }
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
+        break;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Rank filters the values of a single plane in place using
+* 		the dense buffer. For each interval the window is filled
+* 		for the first column, then as it slides along the
+* 		interval the leaving column is removed and the entering
+* 		column added.
+* \param	obj2			2D object for the plane.
+* \param	rb			Dense buffer.
+* \param	p			Plane index, relative to the first
+* 					plane.
+* \param	rank			Required rank in the open interval
+* 					(0.0, 1.0).
+*/
+static WlzErrorNum		WlzRankFilterIncrPl(
+				  WlzObject *obj2,
+				  WlzRankBuf *rb,
+				  int p,
+				  double rank)
+{
+  int		h,
+  		nCol;
+  int		*hst = NULL,
+  		*rCnt = NULL;
+  double	*sw = NULL,
+  		*tw = NULL,
+		*ring = NULL;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  h = rb->fSz / 2;
+  nCol = (rb->nPl > 1)? rb->fSz * rb->fSz: rb->fSz;
+  if(rb->nBin > 0)
+  {
+    if((hst = (int *)AlcCalloc(rb->nBin + (rb->nBin >> rb->sft) + 1,
+                               sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  else if(((sw = (double *)
+                 AlcMalloc((3 * rb->fSz + 1) * nCol * sizeof(double))) == NULL) ||
+          ((rCnt = (int *)AlcMalloc((rb->fSz + 1) * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    /* The ring holds the sorted columns of the window and the entering
+     * column, so each column is only sorted once. */
+    tw = sw + rb->fSz * nCol;
+    ring = tw + rb->fSz * nCol;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		*cHst;
+
+    cHst = (hst)? hst + rb->nBin: NULL;
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	k,
+		x,
+		x0,
+		x1,
+		m = 0,
+		lt = 0,
+		n = 0;
+      WlzIVertex3 w0,
+      		  w1;
+      WlzGreyP	gP;
+
+      gP = gWSp.u_grintptr;
+      /* Window bounds, clipped to the buffer. */
+      w0.vtZ = (rb->nPl > 1)? ALG_MAX(p - h, 0): 0;
+      w1.vtZ = (rb->nPl > 1)? ALG_MIN(p - h + rb->fSz - 1, rb->nPl - 1): 0;
+      w0.vtY = ALG_MAX(iWSp.linpos - rb->line1 - h, 0);
+      w1.vtY = ALG_MIN(iWSp.linpos - rb->line1 - h + rb->fSz - 1,
+                       rb->nLn - 1);
+      x0 = iWSp.lftpos - rb->kol1;
+      x1 = iWSp.rgtpos - rb->kol1;
+      for(x = ALG_MAX(x0 - h, 0);
+          x <= ALG_MIN(x0 - h + rb->fSz - 1, rb->nKl - 1); ++x)
+      {
+        if(hst)
+	{
+	  WlzRankHistCol(rb, hst, cHst, w0, w1, x, 1, m, &lt, &n);
+	}
+	else
+	{
+	  int	c;
+	  double *col,
+	  	 *t;
+
+	  col = ring + (x % (rb->fSz + 1)) * nCol;
+	  c = rCnt[x % (rb->fSz + 1)] = WlzRankSortCol(rb, w0, w1, x, col);
+	  n = WlzRankSortMerge(sw, n, NULL, 0, col, c, tw);
+	  t = sw; sw = tw; tw = t;
+	}
+      }
+      for(x = x0; x <= x1; ++x)
+      {
+	int	xL,
+		xE;
+
+	k = x - x0;
+	xL = x - h - 1;
+	xE = x - h + rb->fSz - 1;
+        if(x > x0)
+	{
+	  if(hst)
+	  {
+	    if(xL >= 0)
+	    {
+	      WlzRankHistCol(rb, hst, cHst, w0, w1, xL, -1, m, &lt, &n);
+	    }
+	    if(xE < rb->nKl)
+	    {
+	      WlzRankHistCol(rb, hst, cHst, w0, w1, xE, 1, m, &lt, &n);
+	    }
+	  }
+	  else
+	  {
+	    int	nL = 0,
+		nE = 0;
+	    double *t,
+	    	   *lv,
+		   *ev;
+
+	    lv = ring + (xL % (rb->fSz + 1)) * nCol;
+	    ev = ring + (xE % (rb->fSz + 1)) * nCol;
+	    if(xL >= 0)
+	    {
+	      nL = rCnt[xL % (rb->fSz + 1)];
+	    }
+	    if(xE < rb->nKl)
+	    {
+	      nE = rCnt[xE % (rb->fSz + 1)] = WlzRankSortCol(rb, w0, w1, xE, ev);
+	    }
+	    n = WlzRankSortMerge(sw, n, lv, nL, ev, nE, tw);
+	    t = sw; sw = tw; tw = t;
+	  }
+	}
+	if(n > 1)
+	{
+	  int	r;
+	  double v;
+
+	  r = (int )floor(n * rank);
+	  if(hst)
+	  {
+	    WlzRankHistSeek(hst, cHst, rb->sft, r, &m, &lt);
+	    v = (rb->lut)? rb->lut[m]: m + rb->min;
+	  }
+	  else
+	  {
+	    v = sw[r];
+	  }
+	  switch(gWSp.pixeltype)
+	  {
+	    case WLZ_GREY_UBYTE:
+	      gP.ubp[k] = (WlzUByte )v;
+	      break;
+	    case WLZ_GREY_SHORT:
+	      gP.shp[k] = (short )v;
+	      break;
+	    case WLZ_GREY_INT:
+	      gP.inp[k] = (int )v;
+	      break;
+	    case WLZ_GREY_FLOAT:
+	      gP.flp[k] = (float )v;
+	      break;
+	    case WLZ_GREY_DOUBLE:
+	      gP.dbp[k] = v;
+	      break;
+	    default:
+	      break;
+	  }
+	}
+      }
+      /* Empty the histogram ready for the next interval. */
+      if(hst)
+      {
+	for(x = ALG_MAX(x1 - h, 0);
+	    x <= ALG_MIN(x1 - h + rb->fSz - 1, rb->nKl - 1); ++x)
+	{
+	  WlzRankHistCol(rb, hst, cHst, w0, w1, x, -1, m, &lt, &n);
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+  }
+  AlcFree(hst);
+  AlcFree(rCnt);
+  AlcFree((sw < tw)? sw: tw);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Minimum or maximum filters the dense buffer in place, as
+* 		separable filters along the columns, lines and (for 3D)
+* 		planes of the buffer in turn. Voxels which are not in the
+* 		domain are first given a value which can not be the
+* 		result for any voxel in the domain. For histogram bins
+* 		this is WLZ_RANK_OUT for a minimum and zero for a maximum,
+* 		the look up table is not used.
+* \param	rb			Dense buffer.
+* \param	mx			Maximum if positive, else minimum.
+*/
+static WlzErrorNum		WlzRankFilterMinMax(
+				  WlzRankBuf *rb,
+				  int mx)
+{
+  int		ax,
+  		nP,
+		nThr = 1;
+  size_t	i,
+  		nVx;
+  double	pad;
+  double	*wBuf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nVx = (size_t )(rb->nPl) * rb->nLn * rb->nKl;
+  if(rb->iBuf)
+  {
+    pad = (mx > 0)? 0.0: WLZ_RANK_OUT;
+    if(mx > 0)
+    {
+      for(i = 0; i < nVx; ++i)
+      {
+	if(rb->iBuf[i] == WLZ_RANK_OUT)
+	{
+	  rb->iBuf[i] = 0;
+	}
+      }
+    }
+  }
+  else
+  {
+    pad = (mx > 0)? -DBL_MAX: DBL_MAX;
+    for(i = 0; i < nVx; ++i)
+    {
+      if(rb->mBuf[i] == 0)
+      {
+        rb->dBuf[i] = pad;
+      }
+    }
+  }
+  /* Padded line length, a multiple of the filter size. */
+  nP = ALG_MAX(rb->nKl, rb->nLn);
+  nP = ALG_MAX(nP, rb->nPl) + rb->fSz - 1;
+  nP = ((nP + rb->fSz - 1) / rb->fSz) * rb->fSz;
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  if((wBuf = (double *)
+             AlcMalloc((size_t )nThr * 3 * nP * sizeof(double))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(ax = 0; (errNum == WLZ_ERR_NONE) && (ax < 3); ++ax)
+  {
+    int		idx,
+    		nLine,
+		len;
+    size_t	stride;
+
+    switch(ax)
+    {
+      case 0:
+	nLine = rb->nPl * rb->nLn;
+	len = rb->nKl;
+	stride = 1;
+	break;
+      case 1:
+	nLine = rb->nPl * rb->nKl;
+	len = rb->nLn;
+	stride = rb->nKl;
+	break;
+      default:
+	nLine = rb->nLn * rb->nKl;
+	len = rb->nPl;
+	stride = (size_t )(rb->nLn) * rb->nKl;
+	break;
+    }
+    if(len > 1)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+      for(idx = 0; idx < nLine; ++idx)
+      {
+	int	k,
+		h,
+		thrId = 0;
+	size_t	off;
+	double	*buf;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	buf = wBuf + (size_t )thrId * 3 * nP;
+	switch(ax)
+	{
+	  case 0:
+	    off = (size_t )idx * rb->nKl;
+	    break;
+	  case 1:
+	    off = ((size_t )(idx / rb->nKl) * rb->nLn * rb->nKl) +
+		  (idx % rb->nKl);
+	    break;
+	  default:
+	    off = idx;
+	    break;
+	}
+	/* Gather the line into the padded buffer so that the window of
+	 * the k'th value starts at the k'th value of the buffer. */
+	h = rb->fSz / 2;
+	for(k = 0; k < h; ++k)
+	{
+	  buf[k] = pad;
+	}
+	for(k = len + h; k < nP; ++k)
+	{
+	  buf[k] = pad;
+	}
+	if(rb->iBuf)
+	{
+	  unsigned short *iP;
+
+	  iP = rb->iBuf + off;
+	  for(k = 0; k < len; ++k)
+	  {
+	    buf[h + k] = *iP;
+	    iP += stride;
+	  }
+	}
+	else
+	{
+	  double *dP;
+
+	  dP = rb->dBuf + off;
+	  for(k = 0; k < len; ++k)
+	  {
+	    buf[h + k] = *dP;
+	    dP += stride;
+	  }
+	}
+	WlzRankMinMaxLn(buf, buf + nP, buf + 2 * nP, nP, rb->fSz, mx);
+	buf += 2 * nP;
+	if(rb->iBuf)
+	{
+	  unsigned short *iP;
+
+	  iP = rb->iBuf + off;
+	  for(k = 0; k < len; ++k)
+	  {
+	    *iP = (unsigned short )(buf[k]);
+	    iP += stride;
+	  }
+	}
+	else
+	{
+	  double *dP;
+
+	  dP = rb->dBuf + off;
+	  for(k = 0; k < len; ++k)
+	  {
+	    *dP = buf[k];
+	    dP += stride;
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(wBuf);
+  return(errNum);
+}
+
+/*!
+* \ingroup      WlzValuesFilters
+* \brief	Computes the minimum or maximum of each window of the
+* 		given size along a padded line using the van Herk/Gil-Werman
+* 		algorithm. The line is divided into blocks of the window
+* 		size, for which running extrema are computed forwards and
+* 		backwards from the block boundaries. Each window then
+* 		spans at most two blocks and its extremum is that of the
+* 		backward extremum at its start and the forward extremum at
+* 		its end.
+* \param	buf			Padded line of values.
+* \param	g			Buffer for the forward extrema.
+* \param	s			Buffer for the backward extrema, the
+* 					extremum of the window starting at
+* 					the k'th value is returned in s[k].
+* \param	nP			Length of the padded line, which must
+* 					be a multiple of the window size.
+* \param	w			Window size.
+* \param	mx			Maximum if positive, else minimum.
+*/
+static void			WlzRankMinMaxLn(
+				  double *buf,
+				  double *g,
+				  double *s,
+				  int nP,
+				  int w,
+				  int mx)
+{
+  int		k;
+
+  if(mx > 0)
+  {
+    for(k = 0; k < nP; ++k)
+    {
+      g[k] = ((k % w) == 0)? buf[k]: ALG_MAX(g[k - 1], buf[k]);
+    }
+    for(k = nP - 1; k >= 0; --k)
+    {
+      s[k] = ((k % w) == w - 1)? buf[k]: ALG_MAX(s[k + 1], buf[k]);
+    }
+    for(k = 0; k <= nP - w; ++k)
+    {
+      s[k] = ALG_MAX(s[k], g[k + w - 1]);
+    }
+  }
+  else
+  {
+    for(k = 0; k < nP; ++k)
+    {
+      g[k] = ((k % w) == 0)? buf[k]: ALG_MIN(g[k - 1], buf[k]);
+    }
+    for(k = nP - 1; k >= 0; --k)
+    {
+      s[k] = ((k % w) == w - 1)? buf[k]: ALG_MIN(s[k + 1], buf[k]);
+    }
+    for(k = 0; k <= nP - w; ++k)
+    {
+      s[k] = ALG_MIN(s[k], g[k + w - 1]);
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Sets the values of a single plane from the minimum or
+* 		maximum filtered dense buffer.
+* \param	obj2			2D object for the plane.
+* \param	rb			Dense buffer.
+* \param	p			Plane index, relative to the first
+* 					plane.
+*/
+static WlzErrorNum		WlzRankFilterMinMaxPl(
+				  WlzObject *obj2,
+				  WlzRankBuf *rb,
+				  int p)
+{
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	k,
+      		w;
+      size_t	off;
+      WlzGreyP	gP;
+
+      gP = gWSp.u_grintptr;
+      w = iWSp.rgtpos - iWSp.lftpos + 1;
+      off = ((size_t )p * rb->nLn + iWSp.linpos - rb->line1) * rb->nKl +
+            iWSp.lftpos - rb->kol1;
+      for(k = 0; k < w; ++k)
+      {
+	double	v;
+
+	v = (rb->iBuf)? rb->iBuf[off + k] + rb->min: rb->dBuf[off + k];
+	switch(gWSp.pixeltype)
+	{
+	  case WLZ_GREY_UBYTE:
+	    gP.ubp[k] = (WlzUByte )v;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    gP.shp[k] = (short )v;
+	    break;
+	  case WLZ_GREY_INT:
+	    gP.inp[k] = (int )v;
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    gP.flp[k] = (float )v;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    gP.dbp[k] = v;
+	    break;
+	  default:
+	    break;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup      WlzValuesFilters
+* \brief	Adds (or removes) the histogram bins of a column of the
+* 		window to (or from) the histogram, updating the count of
+* 		values less than the current value and the total count.
+* \param	rb			Dense buffer with histogram bins.
+* \param	hst			Histogram.
+* \param	cHst			Coarse histogram.
+* \param	w0			Minimum plane and line of the window.
+* \param	w1			Maximum plane and line of the window.
+* \param	x			Column of the window.
+* \param	sgn			1 to add or -1 to remove.
+* \param	m			Current histogram bin.
+* \param	lt			Count of values with bins less than m.
+* \param	n			Total count of values.
+*/
+static void			WlzRankHistCol(
+				  WlzRankBuf *rb,
+				  int *hst,
+				  int *cHst,
+				  WlzIVertex3 w0,
+				  WlzIVertex3 w1,
+				  int x,
+				  int sgn,
+				  int m,
+				  int *lt,
+				  int *n)
+{
+  int		y,
+  		z,
+		dLt = 0,
+		dN = 0;
+
+  for(z = w0.vtZ; z <= w1.vtZ; ++z)
+  {
+    unsigned short *iP;
+
+    iP = rb->iBuf + ((size_t )z * rb->nLn + w0.vtY) * rb->nKl + x;
+    for(y = w0.vtY; y <= w1.vtY; ++y)
+    {
+      int	v;
+
+      v = *iP;
+      if(v != WLZ_RANK_OUT)
+      {
+        hst[v] += sgn;
+	cHst[v >> rb->sft] += sgn;
+	dN += sgn;
+	if(v < m)
+	{
+	  dLt += sgn;
+	}
+      }
+      iP += rb->nKl;
+    }
+  }
+  *lt += dLt;
+  *n += dN;
+}
+
+/*!
+* \ingroup      WlzValuesFilters
+* \brief	Moves the current histogram bin to the bin of the given
+* 		rank, stepping over whole coarse bins where possible.
+* 		The histogram must have more than r values.
+* \param	hst			Histogram.
+* \param	cHst			Coarse histogram.
+* \param	sft			Shift from a bin to a coarse bin.
+* \param	r			Required rank.
+* \param	dstM			Current bin, updated on return.
+* \param	dstLt			Count of values with bins less than
+* 					the current bin, updated on return.
+*/
+static void			WlzRankHistSeek(
+				  int *hst,
+				  int *cHst,
+				  int sft,
+				  int r,
+				  int *dstM,
+				  int *dstLt)
+{
+  int		m,
+  		lt,
+		msk;
+
+  m = *dstM;
+  lt = *dstLt;
+  msk = (1 << sft) - 1;
+  while(lt > r)
+  {
+    if(((m & msk) == 0) && (m > 0) && (lt - cHst[(m >> sft) - 1] > r))
+    {
+      m -= msk + 1;
+      lt -= cHst[m >> sft];
+    }
+    else
+    {
+      --m;
+      lt -= hst[m];
+    }
+  }
+  while(lt + hst[m] <= r)
+  {
+    if(((m & msk) == 0) && (lt + cHst[m >> sft] <= r))
+    {
+      lt += cHst[m >> sft];
+      m += msk + 1;
+    }
+    else
+    {
+      lt += hst[m];
+      ++m;
+    }
+  }
+  *dstM = m;
+  *dstLt = lt;
+}
+
+/*!
+* \return	Number of values in the column.
+* \ingroup      WlzValuesFilters
+* \brief	Gathers the values of a column of the window which are
+* 		within the domain into the given buffer in ascending
+* 		order.
+* \param	rb			Dense buffer with values and mask.
+* \param	w0			Minimum plane and line of the window.
+* \param	w1			Maximum plane and line of the window.
+* \param	x			Column of the window.
+* \param	buf			Buffer for the values.
+*/
+static int			WlzRankSortCol(
+				  WlzRankBuf *rb,
+				  WlzIVertex3 w0,
+				  WlzIVertex3 w1,
+				  int x,
+				  double *buf)
+{
+  int		y,
+  		z,
+		n = 0;
+
+  for(z = w0.vtZ; z <= w1.vtZ; ++z)
+  {
+    size_t	off;
+
+    off = ((size_t )z * rb->nLn + w0.vtY) * rb->nKl + x;
+    for(y = w0.vtY; y <= w1.vtY; ++y)
+    {
+      if(rb->mBuf[off])
+      {
+	int	i;
+	double	v;
+
+	/* Insertion sort, columns are short. */
+	v = rb->dBuf[off];
+	for(i = n; (i > 0) && (buf[i - 1] > v); --i)
+	{
+	  buf[i] = buf[i - 1];
+	}
+	buf[i] = v;
+	++n;
+      }
+      off += rb->nKl;
+    }
+  }
+  return(n);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Replaces the values and mask of the dense buffer with
+* 		histogram bins and a look up table of the distinct values,
+* 		but only if there are less than WLZ_RANK_OUT of them.
+* 		Otherwise the buffer is left unchanged.
+* \param	rb			Dense buffer with values and mask.
+*/
+static WlzErrorNum		WlzRankBufToLut(
+				  WlzRankBuf *rb)
+{
+  size_t	i,
+  		nIn = 0,
+		nU = 0,
+		nVx;
+  double	*val = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nVx = (size_t )(rb->nPl) * rb->nLn * rb->nKl;
+  for(i = 0; i < nVx; ++i)
+  {
+    nIn += rb->mBuf[i] != 0;
+  }
+  if(nIn > 0)
+  {
+    if((val = (double *)AlcMalloc(nIn * sizeof(double))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      size_t	j = 0;
+
+      for(i = 0; i < nVx; ++i)
+      {
+        if(rb->mBuf[i])
+	{
+	  val[j++] = rb->dBuf[i];
+	}
+      }
+      qsort(val, nIn, sizeof(double), WlzRankDblCmp);
+      nU = 1;
+      for(i = 1; i < nIn; ++i)
+      {
+        if(val[i] != val[nU - 1])
+	{
+	  val[nU++] = val[i];
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nU > 0) && (nU < WLZ_RANK_OUT))
+  {
+    if((rb->iBuf = (unsigned short *)
+                   AlcMalloc(nVx * sizeof(unsigned short))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(p = 0; p < rb->nPl; ++p)
+      {
+        size_t	k,
+		k0,
+		k1;
+
+	k0 = (size_t )p * rb->nLn * rb->nKl;
+	k1 = k0 + (size_t )(rb->nLn) * rb->nKl;
+	for(k = k0; k < k1; ++k)
+	{
+	  if(rb->mBuf[k])
+	  {
+	    int	lo,
+	    	hi;
+
+	    /* Binary search for the value's index in the table. */
+	    lo = 0;
+	    hi = (int )nU - 1;
+	    while(lo < hi)
+	    {
+	      int	mid;
+
+	      mid = (lo + hi) / 2;
+	      if(val[mid] < rb->dBuf[k])
+	      {
+		lo = mid + 1;
+	      }
+	      else
+	      {
+		hi = mid;
+	      }
+	    }
+	    rb->iBuf[k] = (unsigned short )lo;
+	  }
+	  else
+	  {
+	    rb->iBuf[k] = WLZ_RANK_OUT;
+	  }
+	}
+      }
+      rb->nBin = (int )nU;
+      rb->lut = val;
+      val = NULL;
+      AlcFree(rb->dBuf);
+      AlcFree(rb->mBuf);
+      rb->dBuf = NULL;
+      rb->mBuf = NULL;
+    }
+  }
+  AlcFree(val);
+  return(errNum);
+}
+
+/*!
+* \return	Negative, zero or positive for less than, equal or
+* 		greater than.
+* \ingroup      WlzValuesFilters
+* \brief	Compares two doubles for qsort().
+* \param	p0			Pointer to first double.
+* \param	p1			Pointer to second double.
+*/
+static int			WlzRankDblCmp(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d0,
+  		d1;
+
+  d0 = *(const double *)p0;
+  d1 = *(const double *)p1;
+  return((d0 > d1) - (d0 < d1));
+}
+
+/*!
+* \return	Number of values in the new sorted window.
+* \ingroup      WlzValuesFilters
+* \brief	Merges a sorted window with the sorted values of the
+* 		entering column while removing the sorted values of the
+* 		leaving column.
+* \param	sw			Sorted window values.
+* \param	n			Number of sorted window values.
+* \param	lv			Sorted values to remove, all of
+* 					which are in the sorted window.
+* \param	nL			Number of values to remove.
+* \param	ev			Sorted values to insert.
+* \param	nE			Number of values to insert.
+* \param	dst			Destination for the new sorted
+* 					window values.
+*/
+static int			WlzRankSortMerge(
+				  double *sw,
+				  int n,
+				  double *lv,
+				  int nL,
+				  double *ev,
+				  int nE,
+				  double *dst)
+{
+  int		i = 0,
+  		j = 0,
+		k = 0,
+		c = 0;
+
+  while(i < n)
+  {
+    if((j < nL) && (sw[i] == lv[j]))
+    {
+      ++i;
+      ++j;
+    }
+    else if((k < nE) && (ev[k] < sw[i]))
+    {
+      dst[c++] = ev[k++];
+    }
+    else
+    {
+      dst[c++] = sw[i++];
+    }
+  }
+  while(k < nE)
+  {
+    dst[c++] = ev[k++];
+  }
+  return(c);
+}
+
 /* #define WLZ_RANK_TEST */
 #ifdef WLZ_RANK_TEST
 
@@ -47,6 +47,7 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #define WLZ_USE_MMAP
 #include <errno.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <sys/mman.h>
 #endif
 
@@ -57,6 +58,47 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #define __x86
 #endif
 
+/* Size (in values) of the staging buffer used when widening packed grey
+ * values. */
+#define WLZ_READ_GREYRUN_BUFSZ	(4096)
+
+#ifdef WLZ_USE_MMAP
+/*!
+* \struct	_WlzReadObjMap
+* \ingroup	WlzIO
+* \brief	A reference counted memory mapped file from which objects
+*		are being read by WlzReadObjMapped(). Object interval and
+*		value arrays may point directly into the mapping, each of
+*		these holds a reference which is released through the
+*		array owner's free stack.
+*/
+typedef struct _WlzReadObjMap
+{
+  int		linkcount;		/*!< Number of references. */
+  FILE		*fP;			/*!< File stream being parsed. */
+  char		*base;			/*!< Base address of the mapping. */
+  size_t	len;			/*!< Length of the mapping. */
+  struct _WlzReadObjMap *next;		/*!< Next mapping being parsed. */
+} WlzReadObjMap;
+
+/* Mappings which are currently being parsed. */
+static WlzReadObjMap		*wlzReadObjMapList = NULL;
+
+static void			*WlzReadObjMapData(
+				  FILE *fP,
+				  size_t nB,
+				  size_t aB,
+				  void **freeptr);
+static void			WlzReadObjMapUnlink(
+				  void *data);
+static WlzErrorNum		WlzReadRagRValuesMapped(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzObjectType type,
+				  WlzGreyType gType,
+				  int *dstMapped);
+#endif /* WLZ_USE_MMAP */
+
 static WlzIntervalDomain 	*WlzReadIntervalDomain(
 				  FILE *fp,
 				  WlzErrorNum *);
@@ -83,6 +125,11 @@ static WlzErrorNum 		WlzReadTiledValues(
 				  int dim,
 				  WlzObjectType type,
 				  int map);
+static WlzErrorNum		WlzReadTiledValuesCmp(
+				  FILE *fP,
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesCmpType type,
+				  int map);
 static WlzErrorNum		WlzReadVoxelValues(
 				  FILE *fp,
 				  WlzObject *obj);
@@ -146,6 +193,12 @@ static WlzErrorNum 		WlzReadDouble(
 				  FILE *fP,
 				  double *iP,
 				  size_t nI);
+static WlzErrorNum 		WlzReadGreyRun(
+				  FILE *fP,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  WlzGreyType packing,
+				  size_t nG);
 static WlzErrorNum 		WlzReadVertex2D(
 				  FILE *fP,
 				  WlzDVertex2 *vP,
@@ -417,8 +470,10 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
   WlzDomain		domain;
   WlzValues		values;
   Wlz3DWarpTrans	*wtrans3d;
+  WlzPerfScope		perfScope;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
+  WLZ_PERF_BEGIN(perfScope, "WlzReadObj");
   obj = NULL;
   domain.core = NULL;
   values.core = NULL;
@@ -647,9 +702,391 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
   if(dstErr){
     *dstErr = errNum;
   }
+  WLZ_PERF_END(perfScope);
+  return(obj);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads an object from the given file descriptor, mapping
+*		the file into memory rather than copying the bulk data
+*		onto the heap where the file layout allows.
+*
+*		The whole file is mapped privately, so pages are shared
+*		with the page cache and any other mappings of the file
+*		until they are modified, which causes only the modified
+*		pages to be copied. The interval arrays of interval
+*		domains, the values of rectangular value tables and those
+*		of ragged rectangle value tables (when each line has a
+*		single interval) may point into the mapping when their
+*		values are stored unpacked, do not need byte order
+*		conversion and are suitably aligned. Tiled values are
+*		mapped as by WlzReadObj(). All other data (including
+*		floating point values which are stored in VAX order and
+*		conforming mesh nodes which are stored per entity) are
+*		read onto the heap as usual.
+*		Each array in the mapping holds a reference to the
+*		mapping through its owner's free stack and the file is
+*		unmapped when the last of these is freed.
+*		On return the file descriptor's offset is set to the end
+*		of the object so that any following objects may be read.
+*		The file descriptor may be closed once the object has
+*		been read.
+* \param	fd			File descriptor of a regular file
+*					open for reading.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzReadObjMapped(int fd, WlzErrorNum *dstErr)
+{
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+#ifdef WLZ_USE_MMAP
+  int		fd2 = -1;
+  long		off = -1;
+  FILE		*fP = NULL;
+  WlzReadObjMap	*map = NULL;
+  struct stat	st;
+
+  if((fd < 0) ||
+     ((off = (long )lseek(fd, 0, SEEK_CUR)) < 0) ||
+     ((fd2 = dup(fd)) < 0) ||
+     ((fP = fdopen(fd2, "r")) == NULL) ||
+     (fseek(fP, off, SEEK_SET) != 0))
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) &&
+       (st.st_size > off) &&
+       ((map = (WlzReadObjMap *)
+               AlcCalloc(1, sizeof(WlzReadObjMap))) != NULL))
+    {
+      map->len = st.st_size;
+      map->base = (char *)mmap(NULL, map->len, PROT_READ | PROT_WRITE,
+      			       MAP_PRIVATE | MAP_FILE | MAP_NORESERVE,
+			       fd, 0);
+      if(map->base == MAP_FAILED)
+      {
+        AlcFree(map);
+	map = NULL;
+      }
+    }
+    if(map)
+    {
+      /* Keep a reference to the mapping while it is being parsed. */
+      map->linkcount = 1;
+      map->fP = fP;
+#ifdef _OPENMP
+#pragma omp critical (WlzReadObjMap)
+#endif
+      {
+	map->next = wlzReadObjMapList;
+	wlzReadObjMapList = map;
+      }
+    }
+    obj = WlzReadObj(fP, &errNum);
+    if((off = ftell(fP)) >= 0)
+    {
+      (void )lseek(fd, off, SEEK_SET);
+    }
+  }
+  if(map)
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzReadObjMap)
+#endif
+    {
+      WlzReadObjMap **mP;
+
+      mP = &wlzReadObjMapList;
+      while(*mP != map)
+      {
+        mP = &((*mP)->next);
+      }
+      *mP = map->next;
+    }
+    WlzReadObjMapUnlink(map);
+  }
+  if(fP)
+  {
+    (void )fclose(fP);
+  }
+  else if(fd2 >= 0)
+  {
+    (void )close(fd2);
+  }
+#else /* WLZ_USE_MMAP */
+  errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* WLZ_USE_MMAP */
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
   return(obj);
 }
 
+#ifdef WLZ_USE_MMAP
+/*!
+* \return	Pointer into the mapping or NULL if the data can not be
+*		used in place.
+* \ingroup	WlzIO
+* \brief	If the given file stream is being parsed by
+*		WlzReadObjMapped() and the next nB bytes of the file are
+*		within the mapping and are aligned to aB bytes, then a
+*		pointer to them is returned, the file stream is moved past
+*		them and a reference to the mapping is pushed onto the
+*		given free stack. Otherwise NULL is returned and the file
+*		stream is not changed.
+* \param	fP			Given file stream.
+* \param	nB			Number of bytes required.
+* \param	aB			Required alignment in bytes.
+* \param	freeptr			Free stack of the data's owner.
+*/
+static void	*WlzReadObjMapData(FILE *fP, size_t nB, size_t aB,
+				   void **freeptr)
+{
+  long		off;
+  void		*data = NULL,
+  		*fStk = NULL;
+  WlzReadObjMap	*map = NULL;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzReadObjMap)
+#endif
+  {
+    map = wlzReadObjMapList;
+    while(map && (map->fP != fP))
+    {
+      map = map->next;
+    }
+  }
+  if(map && (nB > 0) && ((off = ftell(fP)) >= 0) &&
+     (off + nB <= map->len) &&
+     (((size_t )(map->base + off) % aB) == 0) &&
+     ((fStk = AlcFreeStackPushFn(*freeptr, map, WlzReadObjMapUnlink,
+                                 NULL)) != NULL))
+  {
+    if(fseek(fP, off + nB, SEEK_SET) == 0)
+    {
+#ifdef _OPENMP
+#pragma omp critical (WlzReadObjMap)
+#endif
+      {
+	++(map->linkcount);
+      }
+      *freeptr = fStk;
+      data = map->base + off;
+    }
+    else
+    {
+      (void )AlcFreeStackPop(fStk, NULL, NULL);
+    }
+  }
+  return(data);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Releases a reference to a mapping created by
+*		WlzReadObjMapped(), unmapping the file when there are no
+*		more references. This is called through the free stacks
+*		of objects which use the mapping.
+* \param	data			The mapping.
+*/
+static void	WlzReadObjMapUnlink(void *data)
+{
+  int		cnt;
+  WlzReadObjMap	*map;
+
+  map = (WlzReadObjMap *)data;
+#ifdef _OPENMP
+#pragma omp critical (WlzReadObjMap)
+#endif
+  {
+    cnt = --(map->linkcount);
+  }
+  if(cnt <= 0)
+  {
+    (void )munmap(map->base, map->len);
+    AlcFree(map);
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Attempts to read ragged rectangle grey values which are
+*		used in place within a mapping created by
+*		WlzReadObjMapped(). This is only possible when the values
+*		are not packed, are not floats (which are stored in VAX
+*		order) and each line of the domain has at most one
+*		interval, since the values of consecutive intervals are
+*		contiguous in the file but not within a value line.
+*		If the values can not be used in place the file stream
+*		is left unchanged and the mapped flag is cleared.
+* \param	fP			Given file stream.
+* \param	obj			Object with an interval domain for
+*					which the values are read.
+* \param	type			Ragged rectangle value table type.
+* \param	gType			Grey type of the values.
+* \param	dstMapped		Destination pointer for flag set
+*					non-zero if the values were read.
+*/
+static WlzErrorNum WlzReadRagRValuesMapped(FILE *fP, WlzObject *obj,
+				WlzObjectType type, WlzGreyType gType,
+				int *dstMapped)
+{
+  int		idL,
+		nLn,
+		mapped = 0;
+  long		off;
+  size_t	gSz = 0,
+  		area;
+  WlzGreyType	packing;
+  WlzGreyP	gP;
+  WlzPixelV	bgd;
+  WlzValues	values;
+  WlzIntervalDomain *iDom;
+  WlzIntervalWSpace iWSp;
+  WlzReadObjMap	*map;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#if defined (__x86) || defined (__alpha)
+#ifdef _OPENMP
+#pragma omp critical (WlzReadObjMap)
+#endif
+  {
+    map = wlzReadObjMapList;
+    while(map && (map->fP != fP))
+    {
+      map = map->next;
+    }
+  }
+  if(map)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+	gSz = WlzGreySize(gType);
+	break;
+      default:
+	break;
+    }
+  }
+  if(gSz > 0)
+  {
+    iDom = obj->domain.i;
+    nLn = iDom->lastln - iDom->line1 + 1;
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      if(iDom->intvlines[idL].nintvs > 1)
+      {
+	break;
+      }
+    }
+    if((idL >= nLn) && ((off = ftell(fP)) >= 0))
+    {
+      packing = (WlzGreyType )getc(fP);
+      if(packing == gType)
+      {
+	mapped = 1;
+      }
+      else
+      {
+	(void )fseek(fP, off, SEEK_SET);
+      }
+    }
+  }
+  if(mapped)
+  {
+    bgd.type = gType;
+    switch(gType)
+    {
+      case WLZ_GREY_INT:
+	bgd.v.inv = getword(fP);
+	break;
+      case WLZ_GREY_SHORT:
+	bgd.v.shv = (short )getword(fP);
+	break;
+      case WLZ_GREY_UBYTE:
+	bgd.v.ubv = (WlzUByte )getword(fP);
+	break;
+      case WLZ_GREY_DOUBLE:
+	bgd.v.dbv = getdouble(fP);
+	break;
+      case WLZ_GREY_RGBA:
+	bgd.v.rgbv = getword(fP);
+	break;
+      default:
+	break;
+    }
+    if(feof(fP) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  if(mapped && (errNum == WLZ_ERR_NONE))
+  {
+    values.v = WlzMakeValueTb(type, iDom->line1, iDom->lastln, iDom->kol1,
+			      bgd, obj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      values.v->width = iDom->lastkl - iDom->kol1 + 1;
+      obj->values = WlzAssignValues(values, NULL);
+      area = WlzLineArea(obj, NULL);
+      if((gP.v = WlzReadObjMapData(fP, area * gSz, gSz,
+                                   &(values.v->freeptr))) == NULL)
+      {
+	if((gP.v = AlcMalloc(area * gSz)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  values.v->freeptr = AlcFreeStackPush(values.v->freeptr, gP.v, NULL);
+	  errNum = WlzReadGreyRun(fP, gP, gType, packing, area);
+	  if((errNum == WLZ_ERR_NONE) && (feof(fP) != 0))
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	(void )WlzMakeValueLine(values.v, iWSp.linpos, iWSp.lftpos,
+				iWSp.rgtpos, gP.inp);
+	gP.ubp += iWSp.colrmn * gSz;
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    if((errNum != WLZ_ERR_NONE) && obj->values.core)
+    {
+      (void )WlzFreeValueTb(obj->values.v);
+      obj->values.core = NULL;
+    }
+  }
+#endif /* __x86 || __alpha */
+  *dstMapped = mapped;
+  return(errNum);
+}
+#endif /* WLZ_USE_MMAP */
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -767,8 +1204,22 @@ static WlzErrorNum WlzReadFloat(FILE *fP, float *iP, size_t nI)
   }
   else
   {
-    int		i;
+    size_t	i;
+#if defined (__x86) || defined (__alpha)
+    WlzUInt	*uP;
 
+    /* On little endian hosts WLZ_SWAP_IN_FLOAT swaps the two 16 bit
+     * halves of the word and decrements the most significant byte,
+     * which may be done on whole words. */
+    uP = (WlzUInt *)iP;
+    for(i = 0; i < nI; ++i)
+    {
+      WlzUInt	u;
+
+      u = uP[i];
+      uP[i] = ((u << 16) | (u >> 16)) - 0x01000000;
+    }
+#else /* __x86 || __alpha */
     for(i = 0; i < nI; ++i)
     {
       WlzGreyV	in,
@@ -778,6 +1229,7 @@ static WlzErrorNum WlzReadFloat(FILE *fP, float *iP, size_t nI)
       WLZ_SWAP_IN_FLOAT(out, in);
       iP[i] = out.flv;
     }
+#endif /* __x86 || __alpha */
   }
   return(errNum);
 }
@@ -819,6 +1271,124 @@ static WlzErrorNum WlzReadDouble(FILE *fP, double *iP, size_t nI)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads a run of packed grey values from the given file
+*		stream into a buffer of native grey values (which must have
+*		room for at least nG values of the given grey type).
+*		When the packing is the same as the grey type the values
+*		are read directly into the buffer and converted in place,
+*		otherwise they are read in blocks into a staging buffer
+*		and then widened.
+* \param	fP			Given file.
+* \param	gP			Buffer for the grey values.
+* \param	gType			Grey type of the buffer.
+* \param	packing			Grey type of the packed values in
+*					the file.
+* \param	nG			Number of grey values.
+*/
+static WlzErrorNum WlzReadGreyRun(FILE *fP, WlzGreyP gP, WlzGreyType gType,
+				  WlzGreyType packing, size_t nG)
+{
+  size_t	i,
+  		m,
+		n;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(packing == gType)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:
+        errNum = WlzReadInt(fP, gP.inp, nG);
+	break;
+      case WLZ_GREY_SHORT:
+        errNum = WlzReadShort(fP, gP.shp, nG);
+	break;
+      case WLZ_GREY_UBYTE:
+        errNum = WlzReadUByte(fP, gP.ubp, nG);
+	break;
+      case WLZ_GREY_FLOAT:
+        errNum = WlzReadFloat(fP, gP.flp, nG);
+	break;
+      case WLZ_GREY_DOUBLE:
+        errNum = WlzReadDouble(fP, gP.dbp, nG);
+	break;
+      case WLZ_GREY_RGBA:
+        errNum = WlzReadInt(fP, (int *)(gP.rgbp), nG);
+	break;
+      default:
+        errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  else if(packing == WLZ_GREY_SHORT)
+  {
+    short	buf[WLZ_READ_GREYRUN_BUFSZ];
+
+    if(gType != WLZ_GREY_INT)
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+    for(n = 0; (errNum == WLZ_ERR_NONE) && (n < nG); n += m)
+    {
+      int	*iP;
+
+      m = WLZ_MIN(nG - n, WLZ_READ_GREYRUN_BUFSZ);
+      if((errNum = WlzReadShort(fP, buf, m)) == WLZ_ERR_NONE)
+      {
+        iP = gP.inp + n;
+	for(i = 0; i < m; ++i)
+	{
+	  iP[i] = buf[i];
+	}
+      }
+    }
+  }
+  else if(packing == WLZ_GREY_UBYTE)
+  {
+    WlzUByte	buf[WLZ_READ_GREYRUN_BUFSZ];
+
+    if((gType != WLZ_GREY_INT) && (gType != WLZ_GREY_SHORT))
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+    for(n = 0; (errNum == WLZ_ERR_NONE) && (n < nG); n += m)
+    {
+      m = WLZ_MIN(nG - n, WLZ_READ_GREYRUN_BUFSZ);
+      if((errNum = WlzReadUByte(fP, buf, m)) == WLZ_ERR_NONE)
+      {
+	if(gType == WLZ_GREY_INT)
+	{
+	  int	*iP;
+
+	  iP = gP.inp + n;
+	  for(i = 0; i < m; ++i)
+	  {
+	    iP[i] = buf[i];
+	  }
+	}
+	else /* gType == WLZ_GREY_SHORT */
+	{
+	  short	*sP;
+
+	  sP = gP.shp + n;
+	  for(i = 0; i < m; ++i)
+	  {
+	    sP[i] = buf[i];
+	  }
+	}
+      }
+    }
+  }
+  else
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup      WlzIO
@@ -1187,7 +1757,7 @@ static WlzIntervalDomain *WlzReadIntervalDomain(FILE *fP,
 						WlzErrorNum *dstErr)
 {
   WlzObjectType		type;
-  int			i, l, l1, ll, k1, kl, nints;
+  int			l, l1, ll, k1, kl, nints;
   WlzIntervalDomain	*idmn=NULL;
   WlzIntervalLine 	*ivln;
   WlzInterval 		*itvl0,
@@ -1249,23 +1819,27 @@ type = (WlzObjectType) getc(fP);
 	errNum = WLZ_ERR_EOO;
 	break;
       }
-      else if( (itvl0 = (WlzInterval *)
-	   AlcMalloc(nints * sizeof(WlzInterval))) == NULL){
-	WlzFreeIntervalDomain(idmn);
-	idmn = NULL;
-	errNum = WLZ_ERR_MEM_ALLOC;
-	break;
+      itvl0 = NULL;
+#if defined (WLZ_USE_MMAP) && (defined (__x86) || defined (__alpha))
+      /* The intervals are stored as pairs of native ints on little endian
+       * hosts so they may be used in place if the file is mapped. */
+      itvl0 = (WlzInterval *)WlzReadObjMapData(fP,
+      					       nints * sizeof(WlzInterval),
+					       sizeof(int), &(idmn->freeptr));
+#endif
+      if(itvl0 == NULL){
+	if( (itvl0 = (WlzInterval *)
+	     AlcMalloc(nints * sizeof(WlzInterval))) == NULL){
+	  WlzFreeIntervalDomain(idmn);
+	  idmn = NULL;
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	idmn->freeptr = AlcFreeStackPush(idmn->freeptr, (void *)itvl0, NULL);
+	(void )WlzReadInt(fP, (int *)itvl0, 2 * nints);
       }
       itvl = itvl0;
       ivln = idmn->intvlines;
-      idmn->freeptr = AlcFreeStackPush(idmn->freeptr, (void *)itvl0, NULL);
-
-      for (i=0; i<nints; i++,itvl++) {
-	itvl->ileft = getword(fP);
-	itvl->iright = getword(fP);
-      }
-
-      itvl = itvl0;
 
       if (feof(fP) != 0){
 	WlzFreeIntervalDomain(idmn);
@@ -1475,7 +2049,6 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
   WlzValues		values;
   WlzGreyType		packing;
   int 			l1, ll, k1, kstart = 0;
-  int 			i;
   WlzPixelV 		backgrnd;
   WlzGreyP		v, g;
   size_t		table_size;
@@ -1521,6 +2094,18 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
     return errNum;
   }
 
+#ifdef WLZ_USE_MMAP
+  if(obj->domain.core->type == WLZ_INTERVALDOMAIN_INTVL)
+  {
+    int		mapped = 0;
+
+    errNum = WlzReadRagRValuesMapped(fp, obj, type, gtype, &mapped);
+    if(mapped || (errNum != WLZ_ERR_NONE))
+    {
+      return(errNum);
+    }
+  }
+#endif /* WLZ_USE_MMAP */
   l1 = obj->domain.i->line1;
   ll = obj->domain.i->lastln;
   k1 = obj->domain.i->kol1;
@@ -1558,29 +2143,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	if (iwsp.nwlpos){
 	  kstart = iwsp.lftpos;
 	}
-	switch (packing) {
-	case WLZ_GREY_INT:
-	  g.inp = v.inp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-	    *g.inp++ = getword(fp);
-	  }
-	  break;
-	case WLZ_GREY_SHORT:
-	  g.inp = v.inp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-	    *g.inp++ = getshort(fp);
-	  }
-	  break;
-	case WLZ_GREY_UBYTE:
-	  g.inp = v.inp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-
-		  *g.inp++ = getc(fp);
-
-	  }
-	  break;
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
+	g.inp = v.inp+iwsp.lftpos-kstart;
+	if((errNum = WlzReadGreyRun(fp, g, WLZ_GREY_INT, packing,
+				    iwsp.colrmn)) != WLZ_ERR_NONE){
 	  break;
 	}
 	if (iwsp.intrmn == 0) {
@@ -1589,7 +2154,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  v.inp += (iwsp.rgtpos - kstart + 1);
 	}
       }
-      if (feof(fp) != 0){
+      if((feof(fp) != 0) || (errNum == WLZ_ERR_READ_INCOMPLETE)){
 	WlzFreeValueTb(values.v);
 	obj->values.v = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1631,23 +2196,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	if (iwsp.nwlpos){
 	  kstart = iwsp.lftpos;
 	}
-	switch (packing) {
-	case WLZ_GREY_SHORT:
-	  g.shp = v.shp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-	    *g.shp++ = (short )getshort(fp);
-	  }
-	  break;
-	case WLZ_GREY_UBYTE:
-	  g.shp = v.shp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-
-		  *g.shp++ = (short )getc(fp);
-
-	  }
-	  break;
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
+	g.shp = v.shp+iwsp.lftpos-kstart;
+	if((errNum = WlzReadGreyRun(fp, g, WLZ_GREY_SHORT, packing,
+				    iwsp.colrmn)) != WLZ_ERR_NONE){
 	  break;
 	}
 	if (iwsp.intrmn == 0) {
@@ -1656,7 +2207,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  v.shp += (iwsp.rgtpos - kstart + 1);
 	}
       }
-      if( feof(fp) != 0 ){
+      if((feof(fp) != 0) || (errNum == WLZ_ERR_READ_INCOMPLETE)){
 	WlzFreeValueTb(values.v);
 	obj->values.v = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1699,10 +2250,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  kstart = iwsp.lftpos;
 	}
 	g.ubp = v.ubp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-
-	  *g.ubp++ = (WlzUByte )getc(fp);
-
+	if((errNum = WlzReadUByte(fp, g.ubp,
+				  iwsp.colrmn)) != WLZ_ERR_NONE){
+	  break;
 	}
 	if (iwsp.intrmn == 0) {
 	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
@@ -1710,7 +2260,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  v.ubp += (iwsp.rgtpos - kstart + 1);
 	}
       }
-      if (feof(fp) != 0){
+      if((feof(fp) != 0) || (errNum == WLZ_ERR_READ_INCOMPLETE)){
 	WlzFreeValueTb(values.v);
 	obj->values.v = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1719,7 +2269,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	errNum = WLZ_ERR_NONE;
       }
     }
-    return( WLZ_ERR_NONE );
+    return errNum;
 
   case WLZ_VALUETABLE_RAGR_FLOAT:
 
@@ -1753,8 +2303,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  kstart = iwsp.lftpos;
 	}
 	g.flp = v.flp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-	  *g.flp++ = getfloat(fp);
+	if((errNum = WlzReadFloat(fp, g.flp,
+				  iwsp.colrmn)) != WLZ_ERR_NONE){
+	  break;
 	}
 	if (iwsp.intrmn == 0) {
 	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
@@ -1762,7 +2313,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  v.flp += (iwsp.rgtpos - kstart + 1);
 	}
       }
-      if (feof(fp) != 0){
+      if((feof(fp) != 0) || (errNum == WLZ_ERR_READ_INCOMPLETE)){
 	WlzFreeValueTb(values.v);
 	obj->values.v = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1805,8 +2356,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  kstart = iwsp.lftpos;
 	}
 	g.dbp = v.dbp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-	  *g.dbp++ = getdouble(fp);
+	if((errNum = WlzReadDouble(fp, g.dbp,
+				   iwsp.colrmn)) != WLZ_ERR_NONE){
+	  break;
 	}
 	if (iwsp.intrmn == 0) {
 	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
@@ -1814,7 +2366,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  v.dbp += (iwsp.rgtpos - kstart + 1);
 	}
       }
-      if (feof(fp) != 0){
+      if((feof(fp) != 0) || (errNum == WLZ_ERR_READ_INCOMPLETE)){
 	WlzFreeValueTb(values.v);
 	obj->values.v = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1855,8 +2407,9 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  kstart = iwsp.lftpos;
 	}
 	g.rgbp = v.rgbp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-	  *g.rgbp++ = getword(fp);
+	if((errNum = WlzReadInt(fp, (int *)(g.rgbp),
+				iwsp.colrmn)) != WLZ_ERR_NONE){
+	  break;
 	}
 	if (iwsp.intrmn == 0) {
 	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
@@ -1864,7 +2417,7 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
 	  v.rgbp += (iwsp.rgtpos - kstart + 1);
 	}
       }
-      if (feof(fp) != 0){
+      if((feof(fp) != 0) || (errNum == WLZ_ERR_READ_INCOMPLETE)){
 	WlzFreeValueTb(values.v);
 	obj->values.v = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1905,7 +2458,9 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
 				  WlzObjectType type)
 {
   WlzGreyP		values;
-  int 			i, num;
+  int 			num,
+  			mapped = 0;
+  size_t		gSz;
   WlzGreyType		packing;
   WlzIntervalDomain 	*idmn;
   WlzValues		vtb;
@@ -1928,110 +2483,64 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
   num = vtb.r->width * (vtb.r->lastln - vtb.r->line1 + 1);
 
   /* test on pixel type to read background */
-  switch( WlzGreyTableTypeToGreyType(type, &errNum) ){
+  switch( bgd.type ){
   case WLZ_GREY_INT:
     vtb.r->bckgrnd.v.inv = getword(fp);
-    values.inp = (int *) AlcMalloc(num*sizeof(int));
     break;
   case WLZ_GREY_SHORT:
     vtb.r->bckgrnd.v.shv = (short )getword(fp);
-    values.shp = (short *) AlcMalloc(num*sizeof(short));
     break;
   case WLZ_GREY_UBYTE:
     vtb.r->bckgrnd.v.ubv = (WlzUByte )getword(fp);
-    values.ubp = (WlzUByte *) AlcMalloc(num*sizeof(WlzUByte));
     break;
   case WLZ_GREY_FLOAT:
     vtb.r->bckgrnd.v.flv = getfloat(fp);
-    values.flp = (float *) AlcMalloc(num*sizeof(float));
     break;
   case WLZ_GREY_DOUBLE:
     vtb.r->bckgrnd.v.dbv = getdouble(fp);
-    values.dbp = (double *) AlcMalloc(num*sizeof(double));
     break;
   case WLZ_GREY_RGBA:
     vtb.r->bckgrnd.v.rgbv = getword(fp);
-    values.rgbp = (WlzUInt *) AlcMalloc(num*sizeof(WlzUInt));
     break;
   default:
     return WLZ_ERR_GREY_TYPE;
     break;
   }
+  gSz = WlzGreySize(bgd.type);
 
+  /* Only int and short values may be packed. */
+  if((bgd.type != WLZ_GREY_INT) && (bgd.type != WLZ_GREY_SHORT)){
+    packing = bgd.type;
+  }
+  values.v = NULL;
+#if defined (WLZ_USE_MMAP) && (defined (__x86) || defined (__alpha))
+  /* Unpacked values other than floats (which are stored in VAX order)
+   * may be used in place if the file is mapped. */
+  if((packing == bgd.type) && (bgd.type != WLZ_GREY_FLOAT)){
+    values.v = WlzReadObjMapData(fp, num * gSz, gSz, &(vtb.r->freeptr));
+    mapped = values.v != NULL;
+  }
+#endif
+  if(values.v == NULL){
+    values.v = AlcMalloc(num * gSz);
+  }
   if( values.inp == NULL ){
     WlzFreeValueTb(vtb.v);
     return WLZ_ERR_MEM_ALLOC;
   }
-  vtb.r->freeptr = AlcFreeStackPush(vtb.r->freeptr, (void *)values.inp, NULL);
+  if(!mapped){
+    vtb.r->freeptr = AlcFreeStackPush(vtb.r->freeptr, (void *)values.inp,
+    				      NULL);
+  }
   vtb.r->values = values;
   obj->values = WlzAssignValues(vtb, NULL);
 
-  switch( WlzGreyTableTypeToGreyType(type, &errNum) ) {
-
-  case WLZ_GREY_INT:
-    switch (packing) {
-    case WLZ_GREY_INT:
-      for (i=0 ; i<num ; i++)
-	*values.inp++ = getword(fp);
-      break;
-    case WLZ_GREY_SHORT:
-      for (i=0 ; i<num ; i++){
-        short shv = (short )getshort(fp);
-	*values.inp++ = shv;
-/*fprintf(stderr, "%d\n", shv);*/}
-      break;
-    case WLZ_GREY_UBYTE:
-		for (i=0 ; i<num ; i++){
-
-	*values.inp++ = getc(fp);
-
-		}
-      break;
-    default:
-      break;
-    }
-    break;
-
-  case WLZ_GREY_SHORT:
-    switch (packing) {
-    case WLZ_GREY_SHORT:
-      for (i=0 ; i<num ; i++)
-	*values.shp++ = (short )getshort(fp);
-      break;
-    case WLZ_GREY_UBYTE:
-		for (i=0 ; i<num ; i++){
-
-	*values.shp++ = (short )getc(fp);
-
-		}
-      break;
-    default:
-      break;
-    }
-    break;
-
-  case WLZ_GREY_UBYTE:
-    fread(values.ubp, sizeof(WlzUByte), num, fp);
-    break;
-
-  case WLZ_GREY_FLOAT:
-    for (i=0 ; i<num ; i++)
-      *values.flp++ = getfloat(fp);
-    break;
-
-  case WLZ_GREY_DOUBLE:
-    for (i=0 ; i<num ; i++)
-      *values.dbp++ = getdouble(fp);
-    break;
-
-  case WLZ_GREY_RGBA:
-    for (i=0 ; i<num ; i++)
-      *values.rgbp++ = getword(fp);
-    break;
-
-  default:
-    return  WLZ_ERR_GREY_TYPE;
-    break;
+  if(!mapped &&
+     ((errNum = WlzReadGreyRun(fp, values, bgd.type, packing,
+                               num)) != WLZ_ERR_NONE)){
+    WlzFreeValueTb(vtb.v);
+    obj->values.core = NULL;
+    return errNum;
   }
   if( feof(fp) != 0 ){
     WlzFreeValueTb(vtb.v);
@@ -2171,6 +2680,7 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   WlzPixelV	bgd;
   WlzGreyType	gType;
   size_t	vSz = 1;
+  WlzTiledValuesCmpType cmpType = WLZ_TILEDVALUES_CMP_NONE;
   WlzTiledValues *tVal = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -2183,10 +2693,15 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   {
     int		tDim;
 
-    if((tDim = getc(fP)) != dim)
+    /* The compression type is encoded in the upper bits of the dimension. */
+    if(((tDim = getc(fP)) == EOF) || ((tDim & 0x0f) != dim))
     {
       errNum = WLZ_ERR_READ_INCOMPLETE;
     }
+    else
+    {
+      cmpType = (WlzTiledValuesCmpType )(tDim >> 4);
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -2281,7 +2796,11 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
       tVal->tileOffset = (long )(off[1] << 32) | (long )(off[0]);
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && (cmpType != WLZ_TILEDVALUES_CMP_NONE))
+  {
+    errNum = WlzReadTiledValuesCmp(fP, tVal, cmpType, map);
+  }
+  else if(errNum == WLZ_ERR_NONE)
   {
     size_t	gSz,
       		tSz;
@@ -2434,6 +2953,113 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the compressed tiles of a tiled value table, for
+* 		which all but the tiles have been read. The compressed
+* 		tiles are preceded by their offsets, see
+* 		WlzWriteTiledValuesCmp(). The compressed tiles are only
+* 		decompressed when accessed.
+* \param	fP			Input file.
+* \param	tVal			Tiled value table with it's tile
+* 					offset set.
+* \param	type			Compression type.
+* \param	map			If non zero the compressed tiles are
+* 					memory mapped rather than read.
+*/
+static WlzErrorNum WlzReadTiledValuesCmp(FILE *fP, WlzTiledValues *tVal,
+				         WlzTiledValuesCmpType type, int map)
+{
+  size_t	idx,
+  		nOff,
+		dSz = 0;
+  long		dOff = 0;
+  int		*offBuf = NULL;
+  WlzTiledValuesCmp *cmp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nOff = tVal->numTiles + 1;
+  cmp = WlzMakeTiledValuesCmp(type, tVal->numTiles, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tVal->cmp = cmp;
+    if((offBuf = (int *)AlcMalloc(2 * nOff * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(fseek(fP, tVal->tileOffset, SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      errNum = WlzReadInt(fP, offBuf, 2 * nOff);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < nOff; ++idx)
+    {
+      cmp->offsets[idx] = (WlzLong )(unsigned int )(offBuf[2 * idx]) |
+                          ((WlzLong )(unsigned int )
+			   (offBuf[(2 * idx) + 1]) << 32);
+      if((idx > 0) && (cmp->offsets[idx] < cmp->offsets[idx - 1]))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+	break;
+      }
+    }
+    dSz = cmp->offsets[tVal->numTiles];
+    dOff = tVal->tileOffset + (2 * nOff * sizeof(unsigned int));
+  }
+  AlcFree(offBuf);
+#ifdef WLZ_USE_MMAP
+  if((errNum == WLZ_ERR_NONE) && map && (dSz > 0))
+  {
+    int		fd;
+    struct stat	fSt;
+
+    /* Map the compressed tiles from the page containing their start,
+     * but only if the file holds all of them. */
+    if(((fd = fileno(fP)) >= 0) && (fstat(fd, &fSt) == 0) &&
+       (fSt.st_size >= dOff + (long )dSz))
+    {
+      long	pgSz,
+      		pgOff;
+      void	*addr;
+
+      pgSz = sysconf(_SC_PAGESIZE);
+      pgOff = (pgSz > 0)? dOff % pgSz: 0;
+      addr = mmap(NULL, dSz + pgOff, PROT_READ, MAP_PRIVATE | MAP_FILE,
+		  fd, dOff - pgOff);
+      if(addr != MAP_FAILED)
+      {
+	cmp->map = addr;
+	cmp->mapSz = dSz + pgOff;
+	cmp->data = (WlzUByte *)addr + pgOff;
+	if(fseek(fP, dOff + dSz, SEEK_SET) != 0)
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+  if((errNum == WLZ_ERR_NONE) && (cmp->data == NULL))
+  {
+    if((cmp->data = (WlzUByte *)AlcMalloc(dSz + 1)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(fread(cmp->data, 1, dSz, fP) != dSz)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -1269,6 +1269,9 @@ WlzObject 	*WlzMakeQuadrilateral(double x0, double y0,
 * \ingroup	WlzMorphologyOps
 * \brief	Makes a standard structure element - basicaly a sphere
 *		but with the appropriate connectivity or distance metric.
+*		For the approximate Euclidean distance the structuring
+*		element is the polygon or polyhedron of lines made by
+*		WlzMakeStdStructElmDecomp().
 * \param    	oType		Object type - <tt>WLZ_2D_DOMAINOBJ</tt>
 *				or <tt>WLZ_3D_DOMAINOBJ</tt>.
 * \param	dType		Distance metric.
@@ -1283,6 +1286,7 @@ WlzObject *WlzMakeStdStructElement(
 {
   WlzObject	*structElm=NULL;
   WlzObject	*obj1, *obj2;
+  WlzStructElmDecomp *dec;
   int 		intRadius;
   WlzErrorNum	errNum=WLZ_ERR_NONE;
 
@@ -1357,6 +1361,19 @@ WlzObject *WlzMakeStdStructElement(
 				      0.0, 0.0, 0.0, &errNum);
       break;
 
+    case WLZ_APX_EUCLIDEAN_DISTANCE:
+      /* dilate a single pixel by the decomposed structuring element */
+      if((dec = WlzMakeStdStructElmDecomp(oType, dType, radius,
+      					  &errNum)) != NULL){
+	if((obj1 = WlzMakeSinglePixelObject(oType, 0, 0, 0,
+					    &errNum)) != NULL){
+	  structElm = WlzStructDecompDilation(obj1, dec, &errNum);
+	  WlzFreeObj(obj1);
+	}
+	(void )WlzFreeStructElmDecomp(dec);
+      }
+      break;
+
     default:
       errNum = WLZ_ERR_PARAM_TYPE;
       break;
@@ -73,6 +73,10 @@ static WlzObject 		*WlzStructDilation3d(
 *		structuring element. This is defined as the domain
 *		obtained as the union of the SE placed at every pixel
 *		of the input domain.
+*		If the structuring element can be decomposed into a
+*		sequence of lines and small neighbourhoods, see
+*		WlzStructElmDecompose(), and this is cheaper, the
+*		dilation is done by WlzStructDecompDilation().
 * \param    obj	Input object to be dilated
 * \param    structElm	Structuring element.
 * \param    dstErr	Error return.
@@ -98,6 +102,7 @@ WlzObject *WlzStructDilation(
   WlzInterval 		*aa = NULL;
   WlzInterval 		*bb = NULL;
   WlzInterval 		*cc = NULL;
+  WlzStructElmDecomp	*dec;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   bDom.core = NULL;
@@ -171,6 +176,18 @@ WlzObject *WlzStructDilation(
     }
   }
 
+  /* use a decomposition of the structuring element if it is cheaper */
+  if( errNum == WLZ_ERR_NONE ){
+    if((dec = WlzStructElmDecompose(structElm, &errNum)) != NULL){
+      rtnObj = WlzStructDecompDilation(obj, dec, &errNum);
+      (void )WlzFreeStructElmDecomp(dec);
+      if( dstErr ){
+	*dstErr = errNum;
+      }
+      return rtnObj;
+    }
+  }
+
   if( errNum == WLZ_ERR_NONE ){
     /*
      * use smaller object as the structuring element
@@ -533,6 +550,7 @@ static WlzObject *WlzStructDilation3d(
   WlzDomain	domain, *domains, *domains1, *domains2;
   WlzValues	values;
   int		i, p, plane1, lastpl, nStructPlanes;
+  WlzStructElmDecomp *dec;
   WlzErrorNum	errNum=WLZ_ERR_NONE;
 
   /* the object is definitely 3D but the domain needs checking */
@@ -630,6 +648,14 @@ static WlzObject *WlzStructDilation3d(
      element are 3D and have non-null and non-empty plane domains.
      We assume that the structuring element and object are standardised
      */
+  /* use a decomposition of the structuring element if it is cheaper */
+  if( (errNum == WLZ_ERR_NONE) && !rtnObj ){
+    if((dec = WlzStructElmDecompose(structElm, &errNum)) != NULL){
+      rtnObj = WlzStructDecompDilation(obj, dec, &errNum);
+      (void )WlzFreeStructElmDecomp(dec);
+    }
+  }
+
   if( (errNum == WLZ_ERR_NONE) && !rtnObj ){
     /* make a new planedomain with planes eroded and shifted by the
        planes of the structuring element, leave the lines and kols 
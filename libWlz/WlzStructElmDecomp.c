@@ -0,0 +1,1688 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzStructElmDecomp_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzStructElmDecomp.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Decomposition of structuring elements into sequences of
+* 		line segments and small neighbourhoods, with dilation and
+* 		erosion by decomposed structuring elements.
+* \ingroup	WlzMorphologyOps
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <Wlz.h>
+
+static int			WlzStructDecompIsRect(
+				  WlzIntervalDomain *iDom);
+static int			WlzStructDecompObjEqual(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzIVertex3 off,
+				  WlzErrorNum *dstErr);
+static int			WlzStructDecompDomEqual2D(
+				  WlzDomain dom0,
+				  WlzDomain dom1,
+				  WlzIVertex2 off,
+				  WlzErrorNum *dstErr);
+static double			WlzStructDecompCost(
+				  WlzStructElmDecomp *dec);
+static double			WlzStructDecompDirectCost(
+				  WlzObject *sObj,
+				  WlzErrorNum *dstErr);
+static void			WlzStructDecompApxEuclid(
+				  int dim,
+				  double radius,
+				  int *dstA,
+				  int *dstF,
+				  int *dstB);
+static WlzErrorNum		WlzStructDecompAddStd(
+				  WlzStructElmDecomp *dec,
+				  WlzDistanceType dType,
+				  int radius);
+static WlzErrorNum		WlzStructDecompAddLine(
+				  WlzStructElmDecomp *dec,
+				  int dX,
+				  int dY,
+				  int dZ,
+				  int len);
+static WlzErrorNum		WlzStructDecompAddConnect(
+				  WlzStructElmDecomp *dec,
+				  WlzConnectType con);
+static WlzStructElmStep		*WlzStructDecompNewStep(
+				  WlzStructElmDecomp *dec,
+				  WlzErrorNum *dstErr);
+static WlzStructElmDecomp	*WlzStructDecompMake(
+				  int dim,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructDecompApply(
+				  WlzObject *obj,
+				  WlzStructElmDecomp *dec,
+				  int dil,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructDecompLine(
+				  WlzObject *obj,
+				  WlzStructElmStep *step,
+				  int dil,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructDecompStep(
+				  WlzObject *obj,
+				  WlzStructElmStep *step,
+				  int dil,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructDecompPlanes(
+				  WlzObject *obj,
+				  WlzStructElmDecomp *dec,
+				  int idx0,
+				  int idx1,
+				  int dil,
+				  WlzErrorNum *dstErr);
+static int			WlzStructDecompStepIsPlanar(
+				  WlzStructElmStep *step);
+static WlzObject		*WlzStructDecompLineX2D(
+				  WlzObject *obj,
+				  int len,
+				  int dil,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	New decomposed structuring element or NULL if the
+* 		structuring element can not be decomposed or if
+* 		decomposition would not be cheaper.
+* \ingroup	WlzMorphologyOps
+* \brief	Attempts an exact decomposition of the given structuring
+* 		element into a sequence of line segments and small
+* 		neighbourhoods. Structuring elements with empty domains
+* 		are not decomposed. Rectangles and cuboids are decomposed
+* 		into axis aligned lines, which are applied in a
+* 		logarithmic number of steps. The structuring elements
+* 		made by WlzMakeStdStructElement() for the 4, 6, 18 and
+* 		octagonal distances (centred anywhere) are decomposed into
+* 		the same sequence of neighbourhoods from which they were
+* 		built, with the 8-connected steps of the octagonal
+* 		distance replaced by lines.
+*
+* 		The decomposition is only returned if dilation or
+* 		erosion using it is estimated to be cheaper than by the
+* 		structuring element itself, as done by WlzStructDilation()
+* 		and WlzStructErosion(), which use this function.
+* \param	sObj			Given structuring element, either
+* 					a 2D or 3D domain object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzStructElmDecomp *WlzStructElmDecompose(
+  WlzObject	*sObj,
+  WlzErrorNum	*dstErr)
+{
+  int		dim = 0,
+  		isRect = 0;
+  WlzIBox3	bBox;
+  WlzIVertex3	sz;
+  WlzObject	*sObj2 = NULL,
+  		*tObj = NULL;
+  WlzStructElmDecomp *dec = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(sObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(sObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(sObj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	if(sObj->domain.core->type != WLZ_EMPTY_DOMAIN)
+	{
+	  dim = 2;
+	  sObj2 = sObj;
+	  bBox.xMin = sObj->domain.i->kol1;
+	  bBox.yMin = sObj->domain.i->line1;
+	  bBox.zMin = 0;
+	  bBox.xMax = sObj->domain.i->lastkl;
+	  bBox.yMax = sObj->domain.i->lastln;
+	  bBox.zMax = 0;
+	  isRect = WlzStructDecompIsRect(sObj->domain.i);
+	}
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if(sObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else
+	{
+	  int	p,
+	  	nPl;
+	  WlzPlaneDomain *pDom;
+
+	  pDom = sObj->domain.p;
+	  bBox.xMin = pDom->kol1;
+	  bBox.yMin = pDom->line1;
+	  bBox.zMin = pDom->plane1;
+	  bBox.xMax = pDom->lastkl;
+	  bBox.yMax = pDom->lastln;
+	  bBox.zMax = pDom->lastpl;
+	  nPl = pDom->lastpl - pDom->plane1 + 1;
+	  isRect = 1;
+	  for(p = 0; isRect && (p < nPl); ++p)
+	  {
+	    WlzIntervalDomain *iDom;
+
+	    iDom = pDom->domains[p].i;
+	    isRect = (iDom != NULL) &&
+	             (iDom->type != WLZ_EMPTY_DOMAIN) &&
+	             (iDom->line1 == pDom->line1) &&
+		     (iDom->lastln == pDom->lastln) &&
+	             (iDom->kol1 == pDom->kol1) &&
+		     (iDom->lastkl == pDom->lastkl) &&
+		     WlzStructDecompIsRect(iDom);
+	  }
+	  /* A single plane structuring element is decomposed as 2D. */
+	  if(nPl == 1)
+	  {
+	    dim = 2;
+	    if(pDom->domains[0].core != NULL)
+	    {
+	      WlzValues	nullVal;
+
+	      /* Only this temporary 2D object is assigned and freed here,
+	       * the given object may well have a zero link count. */
+	      nullVal.core = NULL;
+	      tObj = WlzAssignObject(
+	             WlzMakeMain(WLZ_2D_DOMAINOBJ, pDom->domains[0], nullVal,
+		                 NULL, NULL, &errNum), NULL);
+	      sObj2 = tObj;
+	    }
+	  }
+	  else
+	  {
+	    dim = 3;
+	    sObj2 = sObj;
+	  }
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (sObj2 != NULL))
+  {
+    sz.vtX = bBox.xMax - bBox.xMin + 1;
+    sz.vtY = bBox.yMax - bBox.yMin + 1;
+    sz.vtZ = bBox.zMax - bBox.zMin + 1;
+    if(isRect)
+    {
+      /* Rectangle or cuboid: a line along each axis. */
+      if((dec = WlzStructDecompMake(dim, &errNum)) != NULL)
+      {
+	dec->org.vtX = bBox.xMin;
+	dec->org.vtY = bBox.yMin;
+	dec->org.vtZ = bBox.zMin;
+	errNum = WlzStructDecompAddLine(dec, 1, 0, 0, sz.vtX);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzStructDecompAddLine(dec, 0, 1, 0, sz.vtY);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzStructDecompAddLine(dec, 0, 0, 1, sz.vtZ);
+	}
+      }
+    }
+    else if((sz.vtX == sz.vtY) && ((sz.vtX % 2) == 1) &&
+            ((dim == 2) || (sz.vtZ == sz.vtX)))
+    {
+      int	idx,
+      		radius;
+      WlzIVertex3 cen;
+      WlzObjectType oType;
+      const WlzDistanceType dTypes2[2] = {WLZ_4_DISTANCE,
+					  WLZ_OCTAGONAL_DISTANCE},
+			    dTypes3[2] = {WLZ_6_DISTANCE,
+					  WLZ_18_DISTANCE};
+
+      /* Centred square or cube bounding box: compare with the standard
+       * structuring elements of the same radius. */
+      radius = (sz.vtX - 1) / 2;
+      cen.vtX = bBox.xMin + radius;
+      cen.vtY = bBox.yMin + radius;
+      cen.vtZ = (dim == 2)? 0: bBox.zMin + radius;
+      oType = (dim == 2)? WLZ_2D_DOMAINOBJ: WLZ_3D_DOMAINOBJ;
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (dec == NULL) && (idx < 2);
+          ++idx)
+      {
+	WlzDistanceType dType;
+	WlzObject *cObj;
+
+	dType = (dim == 2)? dTypes2[idx]: dTypes3[idx];
+	cObj = WlzAssignObject(
+	       WlzMakeStdStructElement(oType, dType, radius, &errNum), NULL);
+	if((errNum == WLZ_ERR_NONE) &&
+	   WlzStructDecompObjEqual(sObj2, cObj, cen, &errNum))
+	{
+	  if((dec = WlzStructDecompMake(dim, &errNum)) != NULL)
+	  {
+	    dec->org = cen;
+	    if(dim == 2)
+	    {
+	      dec->org.vtZ = bBox.zMin;
+	    }
+	    errNum = WlzStructDecompAddStd(dec, dType, radius);
+	  }
+	}
+	(void )WlzFreeObj(cObj);
+      }
+    }
+  }
+  if(tObj)
+  {
+    (void )WlzFreeObj(tObj);
+  }
+  /* Only use the decomposition if it is likely to be cheaper. */
+  if((errNum == WLZ_ERR_NONE) && (dec != NULL))
+  {
+    double	dCost;
+
+    dCost = WlzStructDecompDirectCost(sObj, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (WlzStructDecompCost(dec) >= dCost))
+    {
+      (void )WlzFreeStructElmDecomp(dec);
+      dec = NULL;
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (dec != NULL))
+  {
+    (void )WlzFreeStructElmDecomp(dec);
+    dec = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dec);
+}
+
+/*!
+* \return	New decomposed structuring element or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a decomposed standard structuring element, as
+* 		made by WlzMakeStdStructElement() and centred on the
+* 		origin. As well as the distances of
+* 		WlzMakeStdStructElement() (apart from the Euclidean
+* 		distance, which has no decomposition) the approximate
+* 		Euclidean distance is supported, for which the
+* 		structuring element is a polygon (2D) or polyhedron
+* 		(3D) built from lines along the axes and diagonals,
+* 		with lengths chosen to best fit a disc or sphere of the
+* 		given radius.
+* \param	oType			Object type, WLZ_2D_DOMAINOBJ or
+* 					WLZ_3D_DOMAINOBJ.
+* \param	dType			Distance type.
+* \param	radius			Radius which is rounded to the
+* 					nearest integer for all but the
+* 					approximate Euclidean distance.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzStructElmDecomp *WlzMakeStdStructElmDecomp(
+  WlzObjectType	oType,
+  WlzDistanceType dType,
+  double	radius,
+  WlzErrorNum	*dstErr)
+{
+  int		dim = 0,
+  		intRadius = 0;
+  WlzStructElmDecomp *dec = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(oType)
+  {
+    case WLZ_2D_DOMAINOBJ:
+      dim = 2;
+      break;
+    case WLZ_3D_DOMAINOBJ:
+      dim = 3;
+      break;
+    default:
+      errNum = WLZ_ERR_OBJECT_TYPE;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(radius < 0.0)
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+    else if(radius >= 0.5)
+    {
+      intRadius = WLZ_NINT(radius);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(dType)
+    {
+      case WLZ_4_DISTANCE:         /* FALLTHROUGH */
+      case WLZ_8_DISTANCE:         /* FALLTHROUGH */
+      case WLZ_6_DISTANCE:         /* FALLTHROUGH */
+      case WLZ_18_DISTANCE:        /* FALLTHROUGH */
+      case WLZ_26_DISTANCE:        /* FALLTHROUGH */
+      case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+      case WLZ_APX_EUCLIDEAN_DISTANCE:
+	dec = WlzStructDecompMake(dim, &errNum);
+        break;
+      default:
+        errNum = WLZ_ERR_PARAM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (intRadius > 0))
+  {
+    if(dType == WLZ_APX_EUCLIDEAN_DISTANCE)
+    {
+      int	idx,
+      		hA,
+      		hF,
+		hB;
+      const int	dir[13][3] = {{1,  0,  0}, {0,  1,  0}, {0,  0,  1},
+			      {1,  1,  0}, {1, -1,  0}, {1,  0,  1},
+			      {1,  0, -1}, {0,  1,  1}, {0,  1, -1},
+			      {1,  1,  1}, {1,  1, -1}, {1, -1,  1},
+			      {1, -1, -1}};
+
+      /* Lines through the origin along the axes, the face diagonals
+       * and (3D only) the body diagonals. In 2D the face diagonals are
+       * just the two in the xy plane. */
+      WlzStructDecompApxEuclid(dim, radius, &hA, &hF, &hB);
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 13); ++idx)
+      {
+	int	h;
+
+	h = (idx < 3)? hA: (idx < 9)? hF: hB;
+	if((dim == 3) || (dir[idx][2] == 0))
+	{
+	  dec->org.vtX -= h * dir[idx][0];
+	  dec->org.vtY -= h * dir[idx][1];
+	  dec->org.vtZ -= h * dir[idx][2];
+	  errNum = WlzStructDecompAddLine(dec, dir[idx][0], dir[idx][1],
+					  dir[idx][2], 2 * h + 1);
+	}
+      }
+    }
+    else
+    {
+      errNum = WlzStructDecompAddStd(dec, dType, intRadius);
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (dec != NULL))
+  {
+    (void )WlzFreeStructElmDecomp(dec);
+    dec = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dec);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Frees a decomposed structuring element.
+* \param	dec			Given decomposed structuring element.
+*/
+WlzErrorNum	WlzFreeStructElmDecomp(
+  WlzStructElmDecomp *dec)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dec == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    AlcFree(dec->step);
+    AlcFree(dec);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Dilated domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates the given object by a decomposed structuring
+* 		element, giving the same domain as WlzStructDilation()
+* 		would with the structuring element itself. Lines along
+* 		the x axis are applied by extending the intervals of each
+* 		line, lines along other directions by a logarithmic
+* 		number of unions with shifted copies of the domain and
+* 		neighbourhoods by WlzDilation().
+* \param	obj			Given 2D or 3D domain object.
+* \param	dec			Decomposed structuring element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzStructDecompDilation(
+  WlzObject	*obj,
+  WlzStructElmDecomp *dec,
+  WlzErrorNum	*dstErr)
+{
+  return(WlzStructDecompApply(obj, dec, 1, dstErr));
+}
+
+/*!
+* \return	Eroded domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Erodes the given object by a decomposed structuring
+* 		element, giving the same domain as WlzStructErosion()
+* 		would with the structuring element itself. See
+* 		WlzStructDecompDilation().
+* \param	obj			Given 2D or 3D domain object.
+* \param	dec			Decomposed structuring element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzStructDecompErosion(
+  WlzObject	*obj,
+  WlzStructElmDecomp *dec,
+  WlzErrorNum	*dstErr)
+{
+  return(WlzStructDecompApply(obj, dec, 0, dstErr));
+}
+
+/*!
+* \return	Non-zero if the domain is a rectangle.
+* \ingroup	WlzMorphologyOps
+* \brief	Tests whether a 2D domain is a filled rectangle.
+* \param	iDom			Given interval domain.
+*/
+static int			WlzStructDecompIsRect(
+				  WlzIntervalDomain *iDom)
+{
+  int		isRect = 0;
+
+  if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+  {
+    isRect = 1;
+  }
+  else if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+  {
+    int		l,
+    		nLn,
+		w;
+
+    isRect = 1;
+    nLn = iDom->lastln - iDom->line1 + 1;
+    w = iDom->lastkl - iDom->kol1;
+    for(l = 0; isRect && (l < nLn); ++l)
+    {
+      WlzIntervalLine *itvLn;
+
+      itvLn = iDom->intvlines + l;
+      isRect = (itvLn->nintvs == 1) &&
+	       (itvLn->intvs[0].ileft == 0) &&
+	       (itvLn->intvs[0].iright == w);
+    }
+  }
+  return(isRect);
+}
+
+/*!
+* \return	Non-zero if the domains are equal.
+* \ingroup	WlzMorphologyOps
+* \brief	Tests whether the domain of the first object is equal to
+* 		that of the second object offset by the given vector.
+* 		Both objects must be of the same type, 2D or 3D domain
+* 		objects.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	off			Offset of the second object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int			WlzStructDecompObjEqual(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzIVertex3 off,
+				  WlzErrorNum *dstErr)
+{
+  int		eq = 0;
+  WlzIVertex2	off2;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  off2.vtX = off.vtX;
+  off2.vtY = off.vtY;
+  if((obj0 == NULL) || (obj1 == NULL) || (obj0->type != obj1->type))
+  {
+    eq = 0;
+  }
+  else if(obj0->type == WLZ_2D_DOMAINOBJ)
+  {
+    eq = WlzStructDecompDomEqual2D(obj0->domain, obj1->domain, off2,
+                                   &errNum);
+  }
+  else if(obj0->type == WLZ_3D_DOMAINOBJ)
+  {
+    WlzPlaneDomain *pDom0,
+    		   *pDom1;
+
+    pDom0 = obj0->domain.p;
+    pDom1 = obj1->domain.p;
+    eq = (pDom0->plane1 == pDom1->plane1 + off.vtZ) &&
+         (pDom0->lastpl == pDom1->lastpl + off.vtZ);
+    if(eq)
+    {
+      int	p,
+      		nPl;
+
+      nPl = pDom0->lastpl - pDom0->plane1 + 1;
+      for(p = 0; eq && (errNum == WLZ_ERR_NONE) && (p < nPl); ++p)
+      {
+	WlzDomain dom0,
+		  dom1;
+
+	dom0 = pDom0->domains[p];
+	dom1 = pDom1->domains[p];
+	if((dom0.core == NULL) || (dom1.core == NULL))
+	{
+	  eq = dom0.core == dom1.core;
+	}
+	else
+	{
+	  eq = WlzStructDecompDomEqual2D(dom0, dom1, off2, &errNum);
+	}
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(eq);
+}
+
+/*!
+* \return	Non-zero if the domains are equal.
+* \ingroup	WlzMorphologyOps
+* \brief	Tests whether the first 2D domain is equal to the second
+* 		offset by the given vector by comparing their intervals.
+* \param	dom0			First domain.
+* \param	dom1			Second domain.
+* \param	off			Offset of the second domain.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int			WlzStructDecompDomEqual2D(
+				  WlzDomain dom0,
+				  WlzDomain dom1,
+				  WlzIVertex2 off,
+				  WlzErrorNum *dstErr)
+{
+  int		eq = 0;
+  WlzObject	*obj0 = NULL,
+  		*obj1 = NULL;
+  WlzValues	nullVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  if((dom0.core->type == WLZ_EMPTY_DOMAIN) ||
+     (dom1.core->type == WLZ_EMPTY_DOMAIN))
+  {
+    eq = dom0.core->type == dom1.core->type;
+  }
+  else if((dom0.i->line1 == dom1.i->line1 + off.vtY) &&
+          (dom0.i->lastln == dom1.i->lastln + off.vtY) &&
+          (dom0.i->kol1 == dom1.i->kol1 + off.vtX) &&
+          (dom0.i->lastkl == dom1.i->lastkl + off.vtX))
+  {
+    obj0 = WlzAssignObject(
+	   WlzMakeMain(WLZ_2D_DOMAINOBJ, dom0, nullVal, NULL, NULL,
+	               &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj1 = WlzAssignObject(
+	     WlzMakeMain(WLZ_2D_DOMAINOBJ, dom1, nullVal, NULL, NULL,
+	                 &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzIntervalWSpace iWSp0,
+      			iWSp1;
+      WlzErrorNum errNum0 = WLZ_ERR_NONE,
+      		  errNum1 = WLZ_ERR_NONE;
+
+      if(((errNum = WlzInitRasterScan(obj0, &iWSp0,
+                                      WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE) &&
+         ((errNum = WlzInitRasterScan(obj1, &iWSp1,
+	                              WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE))
+      {
+	do
+	{
+	  errNum0 = WlzNextInterval(&iWSp0);
+	  errNum1 = WlzNextInterval(&iWSp1);
+	  eq = (errNum0 == errNum1);
+	  if(eq && (errNum0 == WLZ_ERR_NONE))
+	  {
+	    eq = (iWSp0.linpos == iWSp1.linpos + off.vtY) &&
+		 (iWSp0.lftpos == iWSp1.lftpos + off.vtX) &&
+		 (iWSp0.rgtpos == iWSp1.rgtpos + off.vtX);
+	  }
+	} while(eq && (errNum0 == WLZ_ERR_NONE));
+	if((errNum0 != WLZ_ERR_NONE) && (errNum0 != WLZ_ERR_EOO))
+	{
+	  errNum = errNum0;
+	}
+	else if((errNum1 != WLZ_ERR_NONE) && (errNum1 != WLZ_ERR_EOO))
+	{
+	  errNum = errNum1;
+	}
+      }
+    }
+  }
+  (void )WlzFreeObj(obj0);
+  (void )WlzFreeObj(obj1);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    eq = 0;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(eq);
+}
+
+/*!
+* \return	Estimated cost.
+* \ingroup	WlzMorphologyOps
+* \brief	Estimates the cost of dilation or erosion by a decomposed
+* 		structuring element as an approximate number of passes
+* 		through the intervals of the object.
+* \param	dec			Decomposed structuring element.
+*/
+static double			WlzStructDecompCost(
+				  WlzStructElmDecomp *dec)
+{
+  int		idx;
+  double	cost = 1.0;
+
+  for(idx = 0; idx < dec->nStep; ++idx)
+  {
+    int		n;
+    WlzStructElmStep *step;
+
+    step = dec->step + idx;
+    if(step->type == WLZ_STRUCT_ELM_STEP_LINE)
+    {
+      if((step->dir.vtY == 0) && (step->dir.vtZ == 0))
+      {
+	cost += 1.0;
+      }
+      else
+      {
+	for(n = 1; n < step->len; n *= 2)
+	{
+	  cost += (dec->dim == 2)? 1.0: 2.0;
+	}
+      }
+    }
+    else
+    {
+      switch(step->connect)
+      {
+	case WLZ_4_CONNECTED: /* FALLTHROUGH */
+	case WLZ_8_CONNECTED:
+	  cost += 2.0;
+	  break;
+	default:
+	  cost += 4.0;
+	  break;
+      }
+    }
+  }
+  return(cost);
+}
+
+/*!
+* \return	Estimated cost.
+* \ingroup	WlzMorphologyOps
+* \brief	Estimates the cost of dilation or erosion by the
+* 		structuring element itself, in the same units as
+* 		WlzStructDecompCost(). The direct methods take a pass
+* 		through the object's intervals for each interval of the
+* 		structuring element, and in 3D also a pass for each
+* 		plane.
+* \param	sObj			Given structuring element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static double			WlzStructDecompDirectCost(
+				  WlzObject *sObj,
+				  WlzErrorNum *dstErr)
+{
+  double	cost = 0.0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(sObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    cost = WlzIntervalCount(sObj->domain.i, &errNum);
+  }
+  else
+  {
+    int		p,
+    		nPl;
+
+    nPl = sObj->domain.p->lastpl - sObj->domain.p->plane1 + 1;
+    for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPl); ++p)
+    {
+      WlzDomain	dom;
+
+      dom = sObj->domain.p->domains[p];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	cost += WlzIntervalCount(dom.i, &errNum) + 1.0;
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cost);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Chooses the half lengths of the lines along the axes, the
+* 		face diagonals and the body diagonals of an approximate
+* 		Euclidean structuring element. The Minkowski sum of the
+* 		lines has a support function which is the sum of the
+* 		lines' support functions, and the half lengths are chosen
+* 		to minimise the squared difference between this and the
+* 		radius over a set of directions. Diagonal lines are only
+* 		used with axis lines, so that the sum has no holes.
+* \param	dim			Dimension, 2 or 3.
+* \param	radius			Required radius.
+* \param	dstA			Destination pointer for the half
+* 					length of the axis lines.
+* \param	dstF			Destination pointer for the half
+* 					length of the face diagonal lines.
+* \param	dstB			Destination pointer for the half
+* 					length of the body diagonal lines,
+* 					always zero in 2D.
+*/
+static void			WlzStructDecompApxEuclid(
+				  int dim,
+				  double radius,
+				  int *dstA,
+				  int *dstF,
+				  int *dstB)
+{
+  int		a,
+  		f,
+		b,
+		idx,
+		nDir,
+		maxA,
+		maxD,
+		maxB,
+		bestA = 0,
+  		bestF = 0,
+		bestB = 0;
+  double	bestE = -1.0;
+  double	sA[6],
+  		sF[6],
+		sB[6];
+  const int	nDir2 = 5,
+  		nDir3 = 6;
+  const double	dir2[5][2] = {{1.0, 0.0}, {0.9808, 0.1951}, {0.9239, 0.3827},
+			      {0.8315, 0.5556}, {0.7071, 0.7071}},
+		dir3[6][3] = {{1.0, 0.0, 0.0},
+			      {0.7071, 0.7071, 0.0},
+			      {0.5774, 0.5774, 0.5774},
+			      {0.8944, 0.4472, 0.0},
+			      {0.8165, 0.4082, 0.4082},
+			      {0.6667, 0.6667, 0.3333}};
+
+  /* Support functions of unit half length lines of each class. */
+  nDir = (dim == 2)? nDir2: nDir3;
+  for(idx = 0; idx < nDir; ++idx)
+  {
+    double	x,
+    		y,
+		z;
+
+    if(dim == 2)
+    {
+      x = dir2[idx][0];
+      y = dir2[idx][1];
+      sA[idx] = x + y;
+      sF[idx] = fabs(x + y) + fabs(x - y);
+      sB[idx] = 0.0;
+    }
+    else
+    {
+      x = dir3[idx][0];
+      y = dir3[idx][1];
+      z = dir3[idx][2];
+      sA[idx] = x + y + z;
+      sF[idx] = fabs(x + y) + fabs(x - y) + fabs(x + z) + fabs(x - z) +
+		fabs(y + z) + fabs(y - z);
+      sB[idx] = fabs(x + y + z) + fabs(x + y - z) + fabs(x - y + z) +
+		fabs(x - y - z);
+    }
+  }
+  maxA = (int )ceil(radius);
+  maxD = maxA / ((dim == 2)? 2: 4) + 1;
+  maxB = (dim == 2)? 0: maxD;
+  for(a = 0; a <= maxA; ++a)
+  {
+    for(f = 0; f <= maxD; ++f)
+    {
+      for(b = 0; b <= maxB; ++b)
+      {
+	if((a > 0) || ((f == 0) && (b == 0)))
+	{
+	  double e = 0.0;
+
+	  for(idx = 0; idx < nDir; ++idx)
+	  {
+	    double d;
+
+	    d = (a * sA[idx]) + (f * sF[idx]) + (b * sB[idx]) - radius;
+	    e += d * d;
+	  }
+	  if((bestE < 0.0) || (e < bestE))
+	  {
+	    bestE = e;
+	    bestA = a;
+	    bestF = f;
+	    bestB = b;
+	  }
+	}
+      }
+    }
+  }
+  *dstA = bestA;
+  *dstF = bestF;
+  *dstB = bestB;
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Appends the primitives of a standard structuring element,
+* 		with the same sequence of neighbourhoods as used by
+* 		WlzMakeStdStructElement() but with 8 and 26-connected
+* 		neighbourhoods combined into lines.
+* \param	dec			Decomposed structuring element.
+* \param	dType			Distance type.
+* \param	radius			Integer radius.
+*/
+static WlzErrorNum		WlzStructDecompAddStd(
+				  WlzStructElmDecomp *dec,
+				  WlzDistanceType dType,
+				  int radius)
+{
+  int		idx,
+  		nBox = 0,
+		nCon = 0;
+  WlzConnectType con = WLZ_0_CONNECTED;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(dType)
+  {
+    case WLZ_4_DISTANCE:  /* FALLTHROUGH */
+    case WLZ_6_DISTANCE:  /* FALLTHROUGH */
+    case WLZ_18_DISTANCE:
+      nCon = radius;
+      con = (WlzConnectType )dType;
+      break;
+    case WLZ_8_DISTANCE:  /* FALLTHROUGH */
+    case WLZ_26_DISTANCE:
+      nBox = radius;
+      break;
+    case WLZ_OCTAGONAL_DISTANCE:
+      /* Alternately 4 and 8-connected, starting with 8-connected for
+       * an odd radius. */
+      nCon = radius / 2;
+      nBox = radius - nCon;
+      con = WLZ_4_CONNECTED;
+      break;
+    default:
+      errNum = WLZ_ERR_PARAM_TYPE;
+      break;
+  }
+  if((errNum == WLZ_ERR_NONE) && (nBox > 0))
+  {
+    dec->org.vtX -= nBox;
+    dec->org.vtY -= nBox;
+    errNum = WlzStructDecompAddLine(dec, 1, 0, 0, 2 * nBox + 1);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzStructDecompAddLine(dec, 0, 1, 0, 2 * nBox + 1);
+    }
+    if((errNum == WLZ_ERR_NONE) && (dType == WLZ_26_DISTANCE))
+    {
+      dec->org.vtZ -= nBox;
+      errNum = WlzStructDecompAddLine(dec, 0, 0, 1, 2 * nBox + 1);
+    }
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nCon); ++idx)
+  {
+    errNum = WlzStructDecompAddConnect(dec, con);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Appends a line to a decomposed structuring element,
+* 		lines with a single point are ignored.
+* \param	dec			Decomposed structuring element.
+* \param	dX			Column step.
+* \param	dY			Line step.
+* \param	dZ			Plane step.
+* \param	len			Number of points.
+*/
+static WlzErrorNum		WlzStructDecompAddLine(
+				  WlzStructElmDecomp *dec,
+				  int dX,
+				  int dY,
+				  int dZ,
+				  int len)
+{
+  WlzStructElmStep *step;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(len > 1)
+  {
+    if((step = WlzStructDecompNewStep(dec, &errNum)) != NULL)
+    {
+      step->type = WLZ_STRUCT_ELM_STEP_LINE;
+      step->dir.vtX = dX;
+      step->dir.vtY = dY;
+      step->dir.vtZ = dZ;
+      step->len = len;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Appends a connectivity neighbourhood to a decomposed
+* 		structuring element.
+* \param	dec			Decomposed structuring element.
+* \param	con			Connectivity.
+*/
+static WlzErrorNum		WlzStructDecompAddConnect(
+				  WlzStructElmDecomp *dec,
+				  WlzConnectType con)
+{
+  WlzStructElmStep *step;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((step = WlzStructDecompNewStep(dec, &errNum)) != NULL)
+  {
+    step->type = WLZ_STRUCT_ELM_STEP_CONNECT;
+    step->connect = con;
+    step->len = 1;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New, cleared primitive or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Appends a primitive to a decomposed structuring element,
+* 		reallocating the primitives if required.
+* \param	dec			Decomposed structuring element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructElmStep		*WlzStructDecompNewStep(
+				  WlzStructElmDecomp *dec,
+				  WlzErrorNum *dstErr)
+{
+  WlzStructElmStep *step = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dec->nStep >= dec->maxStep)
+  {
+    int		maxStep;
+    WlzStructElmStep *newStep;
+
+    maxStep = (dec->maxStep > 0)? 2 * dec->maxStep: 16;
+    if((newStep = (WlzStructElmStep *)
+                  AlcRealloc(dec->step,
+		             maxStep * sizeof(WlzStructElmStep))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      dec->step = newStep;
+      dec->maxStep = maxStep;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    step = dec->step + dec->nStep++;
+    step->type = WLZ_STRUCT_ELM_STEP_LINE;
+    step->connect = WLZ_0_CONNECTED;
+    step->dir.vtX = step->dir.vtY = step->dir.vtZ = 0;
+    step->len = 0;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(step);
+}
+
+/*!
+* \return	New decomposed structuring element with no primitives
+* 		or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a new decomposed structuring element with a zero
+* 		origin and no primitives, ie a single pixel or voxel.
+* \param	dim			Dimension, 2 or 3.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructElmDecomp	*WlzStructDecompMake(
+				  int dim,
+				  WlzErrorNum *dstErr)
+{
+  WlzStructElmDecomp *dec = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((dec = (WlzStructElmDecomp *)
+            AlcCalloc(1, sizeof(WlzStructElmDecomp))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    dec->dim = dim;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dec);
+}
+
+/*!
+* \return	Dilated or eroded domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes an object by each primitive of a
+* 		decomposed structuring element in turn, then shifts
+* 		the result by the structuring element's origin.
+* \param	obj			Given 2D or 3D domain object.
+* \param	dec			Decomposed structuring element.
+* \param	dil			Dilate if non-zero, else erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructDecompApply(
+				  WlzObject *obj,
+				  WlzStructElmDecomp *dec,
+				  int dil,
+				  WlzErrorNum *dstErr)
+{
+  int		idx;
+  WlzObject	*cObj = NULL;
+  WlzValues	nullVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(dec == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
+      case WLZ_3D_DOMAINOBJ:
+	if((obj->type == WLZ_2D_DOMAINOBJ) && (dec->dim != 2))
+	{
+	  errNum = WLZ_ERR_OBJECT_TYPE;
+	}
+	else if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if(obj->domain.core->type == WLZ_EMPTY_DOMAIN)
+	{
+	  cObj = WlzAssignObject(WlzMakeEmpty(&errNum), NULL);
+	}
+	else if((obj->type == WLZ_3D_DOMAINOBJ) &&
+	        (obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN))
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	break;
+      case WLZ_EMPTY_OBJ:
+	cObj = WlzAssignObject(WlzMakeEmpty(&errNum), NULL);
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (cObj == NULL))
+  {
+    cObj = WlzAssignObject(
+           WlzMakeMain(obj->type, obj->domain, nullVal, NULL, NULL,
+	               &errNum), NULL);
+  }
+  idx = 0;
+  while((errNum == WLZ_ERR_NONE) && (idx < dec->nStep) &&
+        (cObj->type != WLZ_EMPTY_OBJ))
+  {
+    int		idx1;
+    WlzObject	*nObj = NULL;
+
+    /* Consecutive steps which lie within a plane are applied to a 3D
+     * object plane by plane, avoiding 3D shifts and unions. */
+    idx1 = idx;
+    if(cObj->type == WLZ_3D_DOMAINOBJ)
+    {
+      while((idx1 < dec->nStep) &&
+            WlzStructDecompStepIsPlanar(dec->step + idx1))
+      {
+        ++idx1;
+      }
+    }
+    if(idx1 > idx)
+    {
+      nObj = WlzStructDecompPlanes(cObj, dec, idx, idx1, dil, &errNum);
+      idx = idx1;
+    }
+    else
+    {
+      nObj = WlzStructDecompStep(cObj, dec->step + idx, dil, &errNum);
+      ++idx;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzFreeObj(cObj);
+      cObj = WlzAssignObject(nObj, NULL);
+    }
+    else
+    {
+      (void )WlzFreeObj(nObj);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (cObj->type != WLZ_EMPTY_OBJ) &&
+     ((dec->org.vtX != 0) || (dec->org.vtY != 0) ||
+      ((cObj->type == WLZ_3D_DOMAINOBJ) && (dec->org.vtZ != 0))))
+  {
+    int		s;
+    WlzObject	*nObj;
+
+    s = (dil)? 1: -1;
+    nObj = WlzShiftObject(cObj, s * dec->org.vtX, s * dec->org.vtY,
+                          s * dec->org.vtZ, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzFreeObj(cObj);
+      cObj = WlzAssignObject(nObj, NULL);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (cObj->type == WLZ_3D_DOMAINOBJ))
+  {
+    cObj->domain.p->voxel_size[0] = obj->domain.p->voxel_size[0];
+    cObj->domain.p->voxel_size[1] = obj->domain.p->voxel_size[1];
+    cObj->domain.p->voxel_size[2] = obj->domain.p->voxel_size[2];
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(cObj);
+    cObj = NULL;
+  }
+  else
+  {
+    /* Return the object with a zero link count, as the morphological
+     * functions do. */
+    --(cObj->linkcount);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cObj);
+}
+
+/*!
+* \return	Dilated or eroded domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes an object by a line. Lines along the
+* 		x axis are applied directly to the intervals of a 2D
+* 		object. Other lines are applied as a sequence of
+* 		dilations (or erosions) by pairs of points \f$\{0, s \mathbf{d}\}\f$, where s
+* 		doubles until the line is covered, ie as unions (or
+* 		intersections) of the domain with a shifted copy of
+* 		itself.
+* \param	obj			Given domain object.
+* \param	step			Line primitive.
+* \param	dil			Dilate if non-zero, else erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructDecompLine(
+				  WlzObject *obj,
+				  WlzStructElmStep *step,
+				  int dil,
+				  WlzErrorNum *dstErr)
+{
+  int		cov = 1;
+  WlzObject	*cObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj->type == WLZ_2D_DOMAINOBJ) &&
+     (step->dir.vtX == 1) && (step->dir.vtY == 0) && (step->dir.vtZ == 0))
+  {
+    cObj = WlzStructDecompLineX2D(obj, step->len, dil, &errNum);
+  }
+  else
+  {
+    cObj = WlzAssignObject(obj, NULL);
+    while((errNum == WLZ_ERR_NONE) && (cov < step->len) &&
+          (cObj->type != WLZ_EMPTY_OBJ))
+    {
+      int	s;
+      WlzObject	*nObj = NULL;
+      WlzObject	*objs[2];
+
+      s = ALG_MIN(cov, step->len - cov);
+      if(!dil)
+      {
+        s = -s;
+      }
+      objs[0] = cObj;
+      objs[1] = WlzAssignObject(
+	        WlzShiftObject(cObj, s * step->dir.vtX, s * step->dir.vtY,
+		               s * step->dir.vtZ, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        nObj = (dil)? WlzUnionN(2, objs, 0, &errNum):
+		      WlzIntersectN(2, objs, 0, &errNum);
+      }
+      (void )WlzFreeObj(objs[1]);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzFreeObj(cObj);
+	cObj = WlzAssignObject(nObj, NULL);
+      }
+      cov += ALG_MIN(cov, step->len - cov);
+    }
+    if(cObj != NULL)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	--(cObj->linkcount);
+      }
+      else
+      {
+        (void )WlzFreeObj(cObj);
+	cObj = NULL;
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cObj);
+}
+
+/*!
+* \return	Dilated or eroded domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes an object by a single primitive of a
+* 		decomposed structuring element.
+* \param	obj			Given domain object.
+* \param	step			The primitive.
+* \param	dil			Dilate if non-zero, else erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructDecompStep(
+				  WlzObject *obj,
+				  WlzStructElmStep *step,
+				  int dil,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*rObj;
+
+  if(step->type == WLZ_STRUCT_ELM_STEP_LINE)
+  {
+    rObj = WlzStructDecompLine(obj, step, dil, dstErr);
+  }
+  else if(dil)
+  {
+    rObj = WlzDilation(obj, step->connect, dstErr);
+  }
+  else
+  {
+    rObj = WlzErosion(obj, step->connect, dstErr);
+  }
+  return(rObj);
+}
+
+/*!
+* \return	Dilated or eroded 3D domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes each plane of a 3D object by a run
+* 		of primitives which all lie within a plane.
+* \param	obj			Given 3D domain object.
+* \param	dec			Decomposed structuring element.
+* \param	idx0			Index of the first primitive.
+* \param	idx1			One more than the index of the last
+* 					primitive.
+* \param	dil			Dilate if non-zero, else erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructDecompPlanes(
+				  WlzObject *obj,
+				  WlzStructElmDecomp *dec,
+				  int idx0,
+				  int idx1,
+				  int dil,
+				  WlzErrorNum *dstErr)
+{
+  int		p,
+  		nPl,
+		first = 1;
+  WlzDomain	dom;
+  WlzValues	nullVal;
+  WlzPlaneDomain *pDom;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  pDom = obj->domain.p;
+  nPl = pDom->lastpl - pDom->plane1 + 1;
+  dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			     pDom->plane1, pDom->lastpl,
+			     pDom->line1, pDom->lastln,
+			     pDom->kol1, pDom->lastkl, &errNum);
+  for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPl); ++p)
+  {
+    int		idx;
+    WlzDomain	dom2;
+    WlzObject	*cObj = NULL;
+
+    dom2 = pDom->domains[p];
+    if((dom2.core != NULL) && (dom2.core->type != WLZ_EMPTY_DOMAIN))
+    {
+      cObj = WlzAssignObject(
+	     WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, nullVal, NULL, NULL,
+			 &errNum), NULL);
+    }
+    for(idx = idx0; (errNum == WLZ_ERR_NONE) && (cObj != NULL) &&
+                    (cObj->type != WLZ_EMPTY_OBJ) && (idx < idx1); ++idx)
+    {
+      WlzObject	*nObj;
+
+      nObj = WlzStructDecompStep(cObj, dec->step + idx, dil, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzFreeObj(cObj);
+	cObj = WlzAssignObject(nObj, NULL);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (cObj != NULL) &&
+       (cObj->type == WLZ_2D_DOMAINOBJ))
+    {
+      WlzIntervalDomain *iDom;
+
+      iDom = cObj->domain.i;
+      dom.p->domains[p] = WlzAssignDomain(cObj->domain, NULL);
+      if(first)
+      {
+        first = 0;
+	dom.p->line1 = iDom->line1;
+	dom.p->lastln = iDom->lastln;
+	dom.p->kol1 = iDom->kol1;
+	dom.p->lastkl = iDom->lastkl;
+      }
+      else
+      {
+	dom.p->line1 = ALG_MIN(dom.p->line1, iDom->line1);
+	dom.p->lastln = ALG_MAX(dom.p->lastln, iDom->lastln);
+	dom.p->kol1 = ALG_MIN(dom.p->kol1, iDom->kol1);
+	dom.p->lastkl = ALG_MAX(dom.p->lastkl, iDom->lastkl);
+      }
+    }
+    (void )WlzFreeObj(cObj);
+  }
+  if((errNum == WLZ_ERR_NONE) && !first)
+  {
+    errNum = WlzStandardPlaneDomain(dom.p, NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(first)
+    {
+      rObj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, nullVal, NULL, NULL,
+			 &errNum);
+    }
+  }
+  if(((rObj == NULL) || (rObj->type == WLZ_EMPTY_OBJ)) && (dom.p != NULL))
+  {
+    (void )WlzFreePlaneDomain(dom.p);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	Non-zero if the primitive lies within a plane.
+* \ingroup	WlzMorphologyOps
+* \brief	Tests whether a primitive of a decomposed structuring
+* 		element lies within a single plane, in which case it may
+* 		be applied to a 3D object plane by plane.
+* \param	step			The primitive.
+*/
+static int			WlzStructDecompStepIsPlanar(
+				  WlzStructElmStep *step)
+{
+  int		planar;
+
+  if(step->type == WLZ_STRUCT_ELM_STEP_LINE)
+  {
+    planar = (step->dir.vtZ == 0);
+  }
+  else
+  {
+    planar = (step->connect == WLZ_4_CONNECTED) ||
+             (step->connect == WLZ_8_CONNECTED);
+  }
+  return(planar);
+}
+
+/*!
+* \return	Dilated or eroded domain object or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes a 2D object by a line of points
+* 		\f$(k, 0)\f$, \f$k = 0, \ldots, n - 1\f$. Each interval
+* 		\f$[l, r]\f$ becomes \f$[l, r + n - 1]\f$ (merging any
+* 		which then overlap) for dilation or \f$[l, r - n + 1]\f$
+* 		(if not empty) for erosion.
+* \param	obj			Given 2D domain object.
+* \param	len			Number of points in the line.
+* \param	dil			Dilate if non-zero, else erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructDecompLineX2D(
+				  WlzObject *obj,
+				  int len,
+				  int dil,
+				  WlzErrorNum *dstErr)
+{
+  int		ext,
+  		nItv,
+		nOut = 0;
+  WlzInterval	*itv = NULL;
+  WlzDomain	dom;
+  WlzValues	nullVal;
+  WlzIntervalDomain *iDom;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  nullVal.core = NULL;
+  iDom = obj->domain.i;
+  ext = (dil)? len - 1: 1 - len;
+  nItv = WlzIntervalCount(iDom, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((nItv < 1) || (iDom->lastkl + ext < iDom->kol1))
+    {
+      nItv = 0;
+    }
+    else if((itv = (WlzInterval *)
+                   AlcMalloc(nItv * sizeof(WlzInterval))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if((dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+                                         iDom->line1, iDom->lastln,
+					 iDom->kol1, iDom->lastkl + ext,
+					 &errNum)) == NULL)
+    {
+      AlcFree(itv);
+    }
+    else
+    {
+      dom.i->freeptr = AlcFreeStackPush(dom.i->freeptr, (void *)itv, NULL);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    WlzIntervalWSpace iWSp;
+
+    errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	n = 0,
+      		ln;
+      WlzInterval *lnItv;
+
+      ln = iDom->line1;
+      lnItv = itv;
+      while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	l,
+		r;
+
+	if(iWSp.linpos != ln)
+	{
+	  if(n > 0)
+	  {
+	    (void )WlzMakeInterval(ln, dom.i, n, lnItv);
+	    lnItv += n;
+	    nOut += n;
+	    n = 0;
+	  }
+	  ln = iWSp.linpos;
+	}
+	l = iWSp.lftpos - iDom->kol1;
+	r = iWSp.rgtpos - iDom->kol1 + ext;
+	if(r >= l)
+	{
+	  if((n > 0) && (l <= lnItv[n - 1].iright + 1))
+	  {
+	    lnItv[n - 1].iright = ALG_MAX(lnItv[n - 1].iright, r);
+	  }
+	  else
+	  {
+	    lnItv[n].ileft = l;
+	    lnItv[n].iright = r;
+	    ++n;
+	  }
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+      if(n > 0)
+      {
+	(void )WlzMakeInterval(ln, dom.i, n, lnItv);
+	nOut += n;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(nOut == 0)
+    {
+      rObj = WlzMakeEmpty(&errNum);
+    }
+    else if((errNum = WlzStandardIntervalDomain(dom.i)) == WLZ_ERR_NONE)
+    {
+      rObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL,
+                         &errNum);
+    }
+  }
+  if((rObj == NULL) || (rObj->type == WLZ_EMPTY_OBJ))
+  {
+    if(dom.core != NULL)
+    {
+      (void )WlzFreeIntervalDomain(dom.i);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
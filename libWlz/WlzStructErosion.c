@@ -77,6 +77,10 @@ static WlzObject 		*WlzStructErosion3d(
 * \return	New object or NULL on error.
 * \ingroup 	WlzMorphologyOps
 * \brief	Performs erosion using a structuring element.
+*		If the structuring element can be decomposed into a
+*		sequence of lines and small neighbourhoods, see
+*		WlzStructElmDecompose(), and this is cheaper, the
+*		erosion is done by WlzStructDecompErosion().
 * \param	obj			Given object to be eroded.
 * \param	structElm		Structuring element.
 * \param	dstErr			Destination error pointer, may be NULL.
@@ -99,6 +103,7 @@ WlzObject *WlzStructErosion(
   int			i, j, k, m;
   int			maxItvLn;
   int			line1, kol1, lastln, lastkl;
+  WlzStructElmDecomp	*dec;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   bDom.core = NULL;
@@ -172,6 +177,18 @@ WlzObject *WlzStructErosion(
     }
   }
 
+  /* use a decomposition of the structuring element if it is cheaper */
+  if( errNum == WLZ_ERR_NONE ){
+    if((dec = WlzStructElmDecompose(structElm, &errNum)) != NULL){
+      rtnObj = WlzStructDecompErosion(obj, dec, &errNum);
+      (void )WlzFreeStructElmDecomp(dec);
+      if( dstErr ){
+	*dstErr = errNum;
+      }
+      return rtnObj;
+    }
+  }
+
   /* If we get this far we have 2D object and structuring element of
      domain type and with non-null domains */
   if(errNum == WLZ_ERR_NONE)
@@ -489,6 +506,7 @@ static WlzObject *WlzStructErosion3d(
   WlzDomain	domain, *domains = NULL, *domains1 = NULL, *domains2 = NULL;
   WlzValues	values;
   int		i, j, p, plane1, lastpl, nStructPlanes;
+  WlzStructElmDecomp *dec;
   WlzErrorNum	errNum=WLZ_ERR_NONE;
 
   /* the object is definitely 3D but the domain needs checking */
@@ -587,6 +605,14 @@ static WlzObject *WlzStructErosion3d(
      element are 3D and have non-null and non-empty plane domains.
      We assume that the structuring element and object are standardised
      */
+  /* use a decomposition of the structuring element if it is cheaper */
+  if( (errNum == WLZ_ERR_NONE) && !rtnObj ){
+    if((dec = WlzStructElmDecompose(structElm, &errNum)) != NULL){
+      rtnObj = WlzStructDecompErosion(obj, dec, &errNum);
+      (void )WlzFreeStructElmDecomp(dec);
+    }
+  }
+
   if( (errNum == WLZ_ERR_NONE) && !rtnObj ){
     /* make a new planedomain with planes eroded and shifted by the
        planes of the structuring element, leave the lines and kols 
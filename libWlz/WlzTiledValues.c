@@ -40,6 +40,7 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 #include <Wlz.h>
 
@@ -49,10 +50,38 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 #include <fcntl.h>
 #include <sys/mman.h>
 #endif
+#if HAVE_ZLIB != 0
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
 
 /* The use of Hilbert order for tiles may need some testing before real use. */
 /* #define WLZ_TILES_USE_HILBERT */
 
+/* Default maximum total size (bytes) of the decompressed tiles held in the
+ * cache of a compressed tiled value table. */
+#define WLZ_TILEDVALUES_CACHE_MAXSZ	(256 * 1024 * 1024)
+
+/* Size of a decompressed tile's header, padded so that the values which
+ * follow it are suitably aligned for any grey type. */
+#define WLZ_TILEDVALUES_TILE_HDRSZ	\
+	(((sizeof(WlzTiledValuesTile) + 15) / 16) * 16)
+
+static unsigned int		WlzTiledValuesTileKey(
+				  AlcLRUCache *cache,
+				  void *entry);
+static int			WlzTiledValuesTileMatch(
+				  const void *entry0,
+				  const void *entry1);
+static void			WlzTiledValuesTileUnlink(
+				  AlcLRUCache *cache,
+				  void *entry);
+static size_t			WlzTiledValuesTileBytes(
+				  WlzTiledValues *tVal);
+static WlzTiledValuesTile	*WlzTiledValuesTileDecode(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzErrorNum *dstErr);
+
 /*!
 * \return	New tiled values.
 * \ingroup	WlzAllocation
@@ -156,6 +185,7 @@ WlzErrorNum			WlzFreeTiledValues(
 	{
 	  AlcFree(tVal->vDim);
 	}
+	WlzFreeTiledValuesCmp(tVal->cmp);
 	if(tVal->tiles.v)
 	{
 #ifdef WLZ_USE_MMAP
@@ -231,6 +261,7 @@ WlzTiledValues			*WlzNewTiledValues(
       rVal->fd         = gVal->fd;
       rVal->tileOffset = gVal->tileOffset;
       rVal->tiles.v    = gVal->tiles.v;
+      rVal->cmp        = gVal->cmp;
       rVal->indices    = gVal->indices;
       rVal->bckgrnd    = bgdV;
       rVal->vRank      = gVal->vRank;
@@ -410,6 +441,11 @@ int				WlzTiledValuesMode(
   {
     errNum = WLZ_ERR_VALUES_TYPE;
   }
+  else if(tv->cmp != NULL)
+  {
+    /* Compressed tiles are decompressed on demand and are read only. */
+    flags = WLZ_IOFLAGS_READ;
+  }
   else
   {
 #ifdef WLZ_USE_MMAP
@@ -699,6 +735,8 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       		io,
 		itc,
 		rmn;
+      WlzGreyP	tgp;
+      WlzTiledValuesTile *tile = NULL;
 
       ti[0] = kol / tv->tileWidth;
       to[0] = kol % tv->tileWidth;
@@ -711,6 +749,22 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       itc *= tv->vpe;
       io = tvb->lo + to[0];
       ii = *(tv->indices + tvb->li + ti[0]);
+      tgp = tv->tiles;
+      if(ii >= 0)
+      {
+	if(tv->cmp == NULL)
+	{
+	  io += ii * tv->tileSz;
+	}
+	else if((tile = WlzTiledValuesTileGet(tv, ii, NULL)) != NULL)
+	{
+	  tgp = tile->values;
+	}
+	else
+	{
+	  ii = -1;
+	}
+      }
       switch(tvb->gtype)
       {
 	case WLZ_GREY_INT:
@@ -729,7 +783,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      int *tp;
 
-	      tp = tv->tiles.inp + (ii * tv->tileSz) + io;
+	      tp = tgp.inp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -753,7 +807,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      short *tp;
 
-	      tp = tv->tiles.shp + (ii * tv->tileSz) + io;
+	      tp = tgp.shp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -777,7 +831,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      WlzUByte *tp;
 
-	      tp = tv->tiles.ubp + (ii * tv->tileSz) + io;
+	      tp = tgp.ubp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -801,7 +855,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      float *tp;
 
-	      tp = tv->tiles.flp + (ii * tv->tileSz) + io;
+	      tp = tgp.flp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -825,7 +879,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      double *tp;
 
-	      tp = tv->tiles.dbp + (ii * tv->tileSz) + io;
+	      tp = tgp.dbp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -849,7 +903,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      WlzUInt *tp;
 
-	      tp = tv->tiles.rgbp + (ii * tv->tileSz) + io;
+	      tp = tgp.rgbp + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -860,6 +914,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	default:
 	  break;
       }
+      WlzTiledValuesTileRelease(tile);
       kol += itc;
     }
   }
@@ -1410,8 +1465,9 @@ void				WlzTiledValuesCopyLine(
   {
     mx.vtZ = tv->lastpl - tv->plane1;
   }
-  /* Check for intersection. */
-  if((pl  >= 0) && (pl  <=  mx.vtZ) &&
+  /* Check for intersection, compressed tiles can not be written to. */
+  if((tv->cmp == NULL) &&
+     (pl  >= 0) && (pl  <=  mx.vtZ) &&
      (ln  >= 0) && (ln  <=  mx.vtY) &&
      (lkl >= 0) && (kl1 <=  mx.vtX))
   {
@@ -1481,3 +1537,673 @@ int				WlzTiledValuesValPerElm(
   }
   return(vpe);
 }
+
+/*!
+* \return	New compressed tiles or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Allocates the compressed tiles structure of a tiled value
+* 		table, including it's (zeroed) offset index and tile
+* 		cache, but without allocating any compressed data.
+* \param	type			Compression type.
+* \param	numTiles		Number of tiles.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValuesCmp		*WlzMakeTiledValuesCmp(
+				  WlzTiledValuesCmpType type,
+				  size_t numTiles,
+				  WlzErrorNum *dstErr)
+{
+  WlzTiledValuesCmp *cmp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(type != WLZ_TILEDVALUES_CMP_ZLIB)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+#if HAVE_ZLIB == 0
+  else if(type == WLZ_TILEDVALUES_CMP_ZLIB)
+  {
+    errNum = WLZ_ERR_UNIMPLEMENTED;
+  }
+#endif /* HAVE_ZLIB */
+  else if(((cmp = (WlzTiledValuesCmp *)
+                  AlcCalloc(1, sizeof(WlzTiledValuesCmp))) == NULL) ||
+          ((cmp->offsets = (WlzLong *)
+	                   AlcCalloc(numTiles + 1, sizeof(WlzLong))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    unsigned int maxItem;
+
+    cmp->type = type;
+    cmp->numTiles = numTiles;
+    cmp->cacheMaxSz = WLZ_TILEDVALUES_CACHE_MAXSZ;
+    maxItem = (numTiles < 1)? 1: (numTiles > UINT_MAX)? UINT_MAX: numTiles;
+    if((cmp->cache = AlcLRUCacheNew(maxItem, cmp->cacheMaxSz,
+    				    WlzTiledValuesTileKey,
+				    WlzTiledValuesTileMatch,
+				    WlzTiledValuesTileUnlink, NULL)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && cmp)
+  {
+    WlzFreeTiledValuesCmp(cmp);
+    cmp = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cmp);
+}
+
+/*!
+* \ingroup	WlzAllocation
+* \brief	Frees the compressed tiles of a tiled value table along
+* 		with their tile cache. Decompressed tiles which are still
+* 		in use are free'd when they are released.
+* \param	cmp			Given compressed tiles, may be NULL.
+*/
+void				WlzFreeTiledValuesCmp(
+				  WlzTiledValuesCmp *cmp)
+{
+  if(cmp)
+  {
+    if(cmp->cache)
+    {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+      {
+	AlcLRUCacheFree(cmp->cache, 1);
+      }
+    }
+    if(cmp->map)
+    {
+#ifdef WLZ_USE_MMAP
+      (void )munmap(cmp->map, cmp->mapSz);
+#endif /* WLZ_USE_MMAP */
+    }
+    else
+    {
+      AlcFree(cmp->data);
+    }
+    AlcFree(cmp->offsets);
+    AlcFree(cmp);
+  }
+}
+
+/*!
+* \return	New tiled values with compressed tiles or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Creates a new tiled value table in which each of the
+* 		tiles of the given tiled value table is compressed. The
+* 		new table has it's own copy of the tile indices and does
+* 		not share any data with the given table. The values of
+* 		the new table can only be read and are decompressed on
+* 		demand into the new table's tile cache. An object with
+* 		the new table as it's values is written to the native
+* 		file format with it's tiles compressed.
+* \param	tVal			Given tiled value table.
+* \param	type			Required compression type, which
+* 					must currently be
+* 					WLZ_TILEDVALUES_CMP_ZLIB.
+* \param	level			Compression level (0 - 9) or a
+* 					negative value for the default
+* 					level.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValues			*WlzTiledValuesCompress(
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesCmpType type,
+				  int level,
+				  WlzErrorNum *dstErr)
+{
+  size_t	nIdx = 0,
+  		tBytes = 0;
+  WlzUByte	**cBuf = NULL;
+  WlzTiledValues *rVal = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) != WLZ_GREY_TAB_TILED)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((tVal->tiles.v == NULL) && (tVal->cmp == NULL))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else if(type != WLZ_TILEDVALUES_CMP_ZLIB)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+#if HAVE_ZLIB != 0
+    int		idx;
+
+    tBytes = WlzTiledValuesTileBytes(tVal);
+    rVal = WlzMakeTiledValues(tVal->dim, tVal->vRank, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rVal->type       = tVal->type;
+      rVal->kol1       = tVal->kol1;
+      rVal->lastkl     = tVal->lastkl;
+      rVal->line1      = tVal->line1;
+      rVal->lastln     = tVal->lastln;
+      rVal->plane1     = tVal->plane1;
+      rVal->lastpl     = tVal->lastpl;
+      rVal->bckgrnd    = tVal->bckgrnd;
+      rVal->vpe        = tVal->vpe;
+      rVal->tileSz     = tVal->tileSz;
+      rVal->tileWidth  = tVal->tileWidth;
+      rVal->numTiles   = tVal->numTiles;
+      for(idx = 0; idx < tVal->vRank; ++idx)
+      {
+	rVal->vDim[idx] = tVal->vDim[idx];
+      }
+      nIdx = 1;
+      for(idx = 0; idx < tVal->dim; ++idx)
+      {
+	rVal->nIdx[idx] = tVal->nIdx[idx];
+	nIdx *= tVal->nIdx[idx];
+      }
+      if(((rVal->indices = (unsigned int *)
+                           AlcMalloc(nIdx * sizeof(unsigned int))) == NULL) ||
+         ((cBuf = (WlzUByte **)
+	          AlcCalloc(tVal->numTiles + 1, sizeof(WlzUByte *))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	(void )memcpy(rVal->indices, tVal->indices,
+	              nIdx * sizeof(unsigned int));
+        rVal->cmp = WlzMakeTiledValuesCmp(type, tVal->numTiles, &errNum);
+      }
+    }
+    /* Compress each of the tiles into it's own buffer, recording it's
+     * compressed size as the offset of the following tile. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      long	idT;
+      uLong	cBound;
+
+      cBound = compressBound(tBytes);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+      for(idT = 0; idT < (long )(tVal->numTiles); ++idT)
+      {
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  uLongf  cLen;
+	  WlzUByte *src;
+	  WlzTiledValuesTile *tile = NULL;
+	  WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	  if(tVal->cmp)
+	  {
+	    tile = WlzTiledValuesTileGet(tVal, idT, &errNum2);
+	    src = (errNum2 == WLZ_ERR_NONE)? tile->values.ubp: NULL;
+	  }
+	  else
+	  {
+	    src = tVal->tiles.ubp + (idT * tBytes);
+	  }
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    cLen = cBound;
+	    if((cBuf[idT] = (WlzUByte *)AlcMalloc(cBound)) == NULL)
+	    {
+	      errNum2 = WLZ_ERR_MEM_ALLOC;
+	    }
+	    else if(compress2(cBuf[idT], &cLen, src, tBytes,
+	                      (level < 0)? Z_DEFAULT_COMPRESSION: level) != Z_OK)
+	    {
+	      errNum2 = WLZ_ERR_PARAM_DATA;
+	    }
+	    else
+	    {
+	      rVal->cmp->offsets[idT + 1] = cLen;
+	    }
+	  }
+	  WlzTiledValuesTileRelease(tile);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCompress)
+#endif
+	    {
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+		errNum = errNum2;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+    /* Concatenate the compressed tiles. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      size_t	idT;
+      WlzTiledValuesCmp *cmp;
+
+      cmp = rVal->cmp;
+      for(idT = 0; idT < tVal->numTiles; ++idT)
+      {
+        cmp->offsets[idT + 1] += cmp->offsets[idT];
+      }
+      if((cmp->data = (WlzUByte *)
+                      AlcMalloc(cmp->offsets[tVal->numTiles] + 1)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	for(idT = 0; idT < tVal->numTiles; ++idT)
+	{
+	  (void )memcpy(cmp->data + cmp->offsets[idT], cBuf[idT],
+	                cmp->offsets[idT + 1] - cmp->offsets[idT]);
+	}
+      }
+    }
+    if(cBuf)
+    {
+      size_t	idT;
+
+      for(idT = 0; idT < tVal->numTiles; ++idT)
+      {
+	AlcFree(cBuf[idT]);
+      }
+      AlcFree(cBuf);
+    }
+#else /* HAVE_ZLIB */
+    errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* HAVE_ZLIB */
+  }
+  if((errNum != WLZ_ERR_NONE) && rVal)
+  {
+    (void )WlzFreeTiledValues(rVal);
+    rVal = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rVal);
+}
+
+/*!
+* \return	The decompressed tile or NULL on error.
+* \ingroup	WlzValuesUtils
+* \brief	Gets a decompressed tile of a tiled value table which has
+* 		compressed tiles. If the tile is not in the table's tile
+* 		cache then it is decompressed and added to the cache.
+* 		The tile is pinned and must be released using
+* 		WlzTiledValuesTileRelease() once it's values are no longer
+* 		required, it's values must not be modified. This function
+* 		may be called concurrently by any number of threads.
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	idx			Index of the tile, ie an entry of
+* 					the table's tile indices.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValuesTile		*WlzTiledValuesTileGet(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzErrorNum *dstErr)
+{
+  WlzTiledValuesTile *tile = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(tVal->cmp == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else if(idx >= tVal->numTiles)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    WlzTiledValuesTile key;
+    WlzTiledValuesCmp *cmp;
+
+    cmp = tVal->cmp;
+    key.idx = idx;
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      tile = (WlzTiledValuesTile *)
+             AlcLRUCEntryGetWithKey(cmp->cache, (unsigned int )idx, &key);
+      if(tile)
+      {
+        ++(tile->pin);
+	++(cmp->nHit);
+      }
+      else
+      {
+        ++(cmp->nMiss);
+      }
+    }
+    if(tile == NULL)
+    {
+      WlzTiledValuesTile *nTile;
+
+      /* Decompress without holding the cache, then add the tile unless
+       * another thread has added it in the mean time. */
+      nTile = WlzTiledValuesTileDecode(tVal, idx, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+	{
+	  tile = (WlzTiledValuesTile *)
+		 AlcLRUCEntryGetWithKey(cmp->cache, (unsigned int )idx, &key);
+	  if(tile)
+	  {
+	    ++(tile->pin);
+	  }
+	  else
+	  {
+	    tile = nTile;
+	    nTile = NULL;
+	    if(AlcLRUCEntryAddWithKey(cmp->cache,
+	                              WlzTiledValuesTileBytes(tVal), tile,
+				      (unsigned int )idx, NULL) == NULL)
+	    {
+	      /* Tile can't be cached so free it when it's released. */
+	      tile->orphan = 1;
+	    }
+	  }
+	}
+	AlcFree(nTile);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tile);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Releases a tile that was got using WlzTiledValuesTileGet().
+* 		The tile will be free'd if it is no longer in the tile
+* 		cache and is not in use elsewhere.
+* \param	tile			Given tile, may be NULL.
+*/
+void				WlzTiledValuesTileRelease(
+				  WlzTiledValuesTile *tile)
+{
+  if(tile)
+  {
+    int		freeTile = 0;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      freeTile = (--(tile->pin) <= 0) && tile->orphan;
+    }
+    if(freeTile)
+    {
+      AlcFree(tile);
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Sets the maximum total size of the decompressed tiles
+* 		held in the tile cache of a tiled value table with
+* 		compressed tiles. Least recently used tiles are removed
+* 		from the cache as required.
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	maxSz			Maximum total size in bytes, zero
+* 					for no limit.
+*/
+WlzErrorNum			WlzTiledValuesCacheSetMax(
+				  WlzTiledValues *tVal,
+				  size_t maxSz)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(tVal->cmp == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      tVal->cmp->cacheMaxSz = maxSz;
+      AlcLRUCacheMaxSz(tVal->cmp->cache, maxSz);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Gets the tile cache statistics of a tiled value table
+* 		with compressed tiles.
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	dstHit			Destination pointer for the number
+* 					of tile accesses which were found in
+* 					the cache, may be NULL.
+* \param	dstMiss			Destination pointer for the number
+* 					of tile accesses which required the
+* 					tile to be decompressed, may be NULL.
+* \param	dstSz			Destination pointer for the current
+* 					total size of the cached tiles, may
+* 					be NULL.
+*/
+WlzErrorNum			WlzTiledValuesCacheStats(
+				  WlzTiledValues *tVal,
+				  size_t *dstHit,
+				  size_t *dstMiss,
+				  size_t *dstSz)
+{
+  size_t	hit = 0,
+  		miss = 0,
+		sz = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(tVal->cmp == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      hit = tVal->cmp->nHit;
+      miss = tVal->cmp->nMiss;
+      sz = tVal->cmp->cache->curSz;
+    }
+  }
+  if(dstHit)
+  {
+    *dstHit = hit;
+  }
+  if(dstMiss)
+  {
+    *dstMiss = miss;
+  }
+  if(dstSz)
+  {
+    *dstSz = sz;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Cache key.
+* \ingroup	WlzValuesUtils
+* \brief	Computes the tile cache key of a decompressed tile.
+* \param	cache			The cache.
+* \param	entry			The tile.
+*/
+static unsigned int		WlzTiledValuesTileKey(
+				  AlcLRUCache *cache,
+				  void *entry)
+{
+  return((unsigned int )(((WlzTiledValuesTile *)entry)->idx));
+}
+
+/*!
+* \return	Zero iff the tiles match.
+* \ingroup	WlzValuesUtils
+* \brief	Matches two tile cache entries.
+* \param	entry0			First tile.
+* \param	entry1			Second tile.
+*/
+static int			WlzTiledValuesTileMatch(
+				  const void *entry0,
+				  const void *entry1)
+{
+  return(((const WlzTiledValuesTile *)entry0)->idx !=
+         ((const WlzTiledValuesTile *)entry1)->idx);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Called when a tile is removed from the tile cache, frees
+* 		the tile unless it is in use in which case it will be
+* 		free'd when released. Always called with the cache held.
+* \param	cache			The cache.
+* \param	entry			The tile.
+*/
+static void			WlzTiledValuesTileUnlink(
+				  AlcLRUCache *cache,
+				  void *entry)
+{
+  WlzTiledValuesTile *tile;
+
+  tile = (WlzTiledValuesTile *)entry;
+  tile->orphan = 1;
+  if(tile->pin <= 0)
+  {
+    AlcFree(tile);
+  }
+}
+
+/*!
+* \return	Number of bytes in a tile.
+* \ingroup	WlzValuesUtils
+* \brief	Computes the number of bytes in a (decompressed) tile.
+* \param	tVal			Given tiled value table.
+*/
+static size_t			WlzTiledValuesTileBytes(
+				  WlzTiledValues *tVal)
+{
+  size_t	gSz;
+
+  gSz = WlzGreySize(WLZ_GREY_TABLE_TO_GREY_TYPE(tVal->type));
+  return(gSz * tVal->tileSz * tVal->vpe);
+}
+
+/*!
+* \return	New pinned tile which is not in the tile cache or NULL
+* 		on error.
+* \ingroup	WlzValuesUtils
+* \brief	Decompresses a tile of a tiled value table.
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	idx			Index of the tile.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzTiledValuesTile	*WlzTiledValuesTileDecode(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzErrorNum *dstErr)
+{
+  size_t	tBytes;
+  WlzTiledValuesTile *tile = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tBytes = WlzTiledValuesTileBytes(tVal);
+  if((tile = (WlzTiledValuesTile *)
+             AlcMalloc(WLZ_TILEDVALUES_TILE_HDRSZ + tBytes)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    WlzTiledValuesCmp *cmp;
+
+    cmp = tVal->cmp;
+    tile->idx = idx;
+    tile->pin = 1;
+    tile->orphan = 0;
+    tile->values.ubp = (WlzUByte *)tile + WLZ_TILEDVALUES_TILE_HDRSZ;
+    switch(cmp->type)
+    {
+#if HAVE_ZLIB != 0
+      case WLZ_TILEDVALUES_CMP_ZLIB:
+	{
+	  uLongf dLen;
+
+	  dLen = tBytes;
+	  if((uncompress(tile->values.ubp, &dLen,
+	                 cmp->data + cmp->offsets[idx],
+			 cmp->offsets[idx + 1] - cmp->offsets[idx]) != Z_OK) ||
+	     (dLen != tBytes))
+	  {
+	    errNum = WLZ_ERR_VALUES_DATA;
+	  }
+	}
+        break;
+#endif /* HAVE_ZLIB */
+      default:
+        errNum = WLZ_ERR_UNIMPLEMENTED;
+	break;
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && tile)
+  {
+    AlcFree(tile);
+    tile = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tile);
+}
@@ -836,6 +836,21 @@ typedef enum _WlzSpecialStructElmType
   WLZ_SPEC_STRUCT_ELM_V2
 } WlzSpecialStructElmType;
 
+/*!
+* \enum		_WlzStructElmStepType
+* \ingroup	WlzMorphologyOps
+* \brief	Types of the primitive structuring elements from which a
+* 		decomposed structuring element is built.
+*		Typedef: ::WlzStructElmStepType.
+*/
+typedef enum _WlzStructElmStepType
+{
+  WLZ_STRUCT_ELM_STEP_LINE,		/*!< Digital line segment. */
+  WLZ_STRUCT_ELM_STEP_CONNECT		/*!< Neighbourhood of a connectivity
+  					     as used by WlzDilation() and
+					     WlzErosion(). */
+} WlzStructElmStepType;
+
 /*!
 * \enum		_WlzBinaryOperatorType
 * \ingroup	WlzArithmetic
@@ -1451,6 +1466,45 @@ typedef union _WlzBox
   WlzDBox3	d3;
 } WlzBox;
 
+/*!
+* \struct	_WlzStructElmStep
+* \ingroup	WlzMorphologyOps
+* \brief	A primitive structuring element of a decomposed
+* 		structuring element. A line has the points
+* 		\f$k \mathbf{d}\f$, \f$k = 0, \ldots, n - 1\f$.
+*		Typedef: ::WlzStructElmStep.
+*/
+typedef struct _WlzStructElmStep
+{
+  WlzStructElmStepType type;		/*!< Type of primitive. */
+  WlzConnectType connect;		/*!< Connectivity of a neighbourhood
+  					     primitive. */
+  WlzIVertex3	dir;			/*!< Step between the points of a
+  					     line. */
+  int		len;			/*!< Number of points in a line. */
+} WlzStructElmStep;
+
+/*!
+* \struct	_WlzStructElmDecomp
+* \ingroup	WlzMorphologyOps
+* \brief	A structuring element decomposed into a sequence of
+* 		primitive structuring elements. The structuring element
+* 		is the Minkowski sum of the primitives offset by the
+* 		origin, so dilation or erosion by it may be done by
+* 		dilating or eroding by each primitive in turn.
+*		Typedef: ::WlzStructElmDecomp.
+*/
+typedef struct _WlzStructElmDecomp
+{
+  int		dim;			/*!< Dimension, 2 or 3. */
+  WlzIVertex3	org;			/*!< Offset of the structuring
+  					     element. */
+  int		nStep;			/*!< Number of primitives. */
+  int		maxStep;		/*!< Space allocated for
+  					     primitives. */
+  WlzStructElmStep *step;		/*!< Primitives. */
+} WlzStructElmDecomp;
+
 /************************************************************************
 * Grey values.
 ************************************************************************/
@@ -3157,6 +3211,81 @@ typedef struct _WlzIndexedValues
   AlcVector     *values;                /*!< The indexed values. */
 } WlzIndexedValues;
 
+/*!
+* \enum		_WlzTiledValuesCmpType
+* \ingroup	WlzType
+* \brief	Encoding used for the tiles of a tiled value table.
+*		Typedef: ::WlzTiledValuesCmpType.
+*/
+typedef enum _WlzTiledValuesCmpType
+{
+  WLZ_TILEDVALUES_CMP_NONE	= 0,	/*!< Tiles are not compressed. */
+  WLZ_TILEDVALUES_CMP_ZLIB	= 1	/*!< Each tile is compressed using
+  					     zlib (deflate). */
+} WlzTiledValuesCmpType;
+
+/*!
+* \struct	_WlzTiledValuesTile
+* \ingroup	WlzType
+* \brief	A single decompressed tile of a compressed tiled value
+*		table. Tiles are held in the table's tile cache and are
+*		pinned while in use so that they are not free'd when
+*		removed from the cache.
+*		See WlzTiledValuesTileGet() and WlzTiledValuesTileRelease().
+*		Typedef: ::WlzTiledValuesTile.
+*/
+typedef struct _WlzTiledValuesTile
+{
+  size_t	idx;			/*!< Index of the tile. */
+  int		pin;			/*!< Number of users of the tile. */
+  int		orphan;			/*!< Non-zero if the tile is no
+  					     longer in the cache and should
+					     be free'd when it is no longer
+					     pinned. */
+  WlzGreyP	values;			/*!< The tile's decompressed values
+  					     (tileSz x vpe values). */
+} WlzTiledValuesTile;
+
+/*!
+* \struct	_WlzTiledValuesCmp
+* \ingroup	WlzType
+* \brief	The compressed tiles of a tiled value table. Each tile
+*		is compressed independently and is located using an
+*		index of offsets into the compressed data. Tiles are
+*		decompressed when first accessed and are kept in a least
+*		recently used cache, the maximum size of which may be set
+*		using WlzTiledValuesCacheSetMax().
+*		Typedef: ::WlzTiledValuesCmp.
+*/
+typedef struct _WlzTiledValuesCmp
+{
+  WlzTiledValuesCmpType type;		/*!< Compression type. */
+  size_t	numTiles;		/*!< Number of tiles. */
+  WlzLong	*offsets;		/*!< Offsets to the compressed tiles,
+  					     with numTiles + 1 entries so
+					     that the compressed size of tile
+					     i is offsets[i + 1] - offsets[i].
+					     */
+  WlzUByte	*data;			/*!< The compressed tiles. */
+  void		*map;			/*!< If non-NULL the memory mapped
+  					     file region containing the
+					     compressed tiles, else the data
+					     were allocated using AlcMalloc().
+					     */
+  size_t	mapSz;			/*!< Size of the memory mapped region.
+  					     */
+  struct _AlcLRUCache *cache;		/*!< Cache of decompressed tiles. */
+  size_t	cacheMaxSz;		/*!< Maximum total size (bytes) of
+  					     the decompressed tiles held in
+					     the cache. */
+  size_t	nHit;			/*!< Number of tile accesses for which
+  					     the tile was found in the cache.
+					     */
+  size_t	nMiss;			/*!< Number of tile accesses for which
+  					     the tile had to be decompressed.
+					     */
+} WlzTiledValuesCmp;
+
 /*!
 * \struct       _WlzTiledValues
 * \ingroup      WlzType
@@ -3199,6 +3328,13 @@ typedef struct _WlzIndexedValues
 * 		memory in which case the file descriptor will have a
 * 		non-negative value. This can be used to close the file.
 *
+* 		The tiles may instead be compressed (see ::WlzTiledValuesCmp)
+* 		in which case the tiles pointer is NULL and the values can
+* 		only be read, through WlzTiledValuesTileGet(), WlzGreyValueGet()
+* 		or interval scanning. In the native file format the
+* 		compression type is held in the upper four bits of the
+* 		table's dimension byte.
+*
 * 		A memory mapped tiled values object can only have it's
 * 		grey values changed if the file was opened for writing
 * 		attempting to change the grey values of an object only
@@ -3272,6 +3408,8 @@ typedef struct _WlzTiledValues
   					     file to the tiles. This may be
 					     set even if not memory mapped. */
   WlzGreyP 	tiles;			/*!< The tiles. */
+  WlzTiledValuesCmp *cmp;		/*!< The compressed tiles or NULL if
+  					     the tiles are not compressed. */
 } WlzTiledValues;
 
 /*!
@@ -4450,6 +4588,9 @@ typedef enum _WlzFnType
   WLZ_FN_SCALAR_SQRT,		        /*!< Square root (x^-1/2). */
   WLZ_FN_SCALAR_INVSQRT,		/*!< Inverse square root (x^-1/2). */
   WLZ_FN_SCALAR_SQR,			/*!< Square (x * x). */
+  WLZ_FN_BASIS_2DCS,			/*!< Compactly supported (Wendland)
+					     basis function. */
+  WLZ_FN_BASIS_3DCS,
   WLZ_FN_COUNT				/*!< Not a function but the number
   					     of functions. Keep this the
 					     last of the enums! */
@@ -4479,6 +4620,72 @@ typedef void *WlzBasisDistFn;
 typedef double (*WlzBasisDistFn)(void *, int, WlzVertex, void *);
 #endif /* WLZ_EXT_BIND */
 
+/*!
+* \struct	_WlzBasisFnTreeNode
+* \ingroup	WlzFunction
+* \brief	A node of a basis function evaluation tree. Each node
+*		covers a contiguous range of the tree ordered control
+*		points.
+*		Typedef: ::WlzBasisFnTreeNode.
+*/
+typedef struct _WlzBasisFnTreeNode
+{
+  int		first;			/*!< Index of the node's first
+  					     control point. */
+  int		count;			/*!< Number of control points
+  					     covered by the node. */
+  int		child[2];		/*!< Indices of the child nodes or
+  					     -1 for a leaf node. */
+  double	rad;			/*!< Maximum distance from the centre
+  					     to any of the node's control
+					     points. */
+  WlzDVertex3	centre;			/*!< Centre of the node. */
+} WlzBasisFnTreeNode;
+
+/*!
+* \struct	_WlzBasisFnTree
+* \ingroup	WlzFunction
+* \brief	A tree over the control points of a radial basis function
+*		which allows the basis function to be evaluated in
+*		close to O(log n) rather than O(n) time, to within the
+*		given tolerance. Each node holds the moments of the
+*		basis function coefficients about its centre, these
+*		being used with a Taylor expansion of the radial
+*		function to approximate the sum over the node's control
+*		points when the node is far from the evaluation position.
+*		Typedef: ::WlzBasisFnTree.
+*/
+typedef struct _WlzBasisFnTree
+{
+  int		dim;			/*!< Dimension, 2 or 3. */
+  int		order;			/*!< Maximum order of the Taylor
+  					     expansions. */
+  int		nTerm;			/*!< Number of terms in an expansion
+  					     of the maximum order. */
+  int		nVtx;			/*!< Number of control points. */
+  int		nNodes;			/*!< Number of tree nodes. */
+  double	tol;			/*!< Tolerance, the maximum absolute
+  					     error in the sum over the
+					     control points. */
+  double	wSum;			/*!< Sum of the magnitudes of the
+  					     basis function coefficients. */
+  int		*terms;			/*!< For each expansion term, ordered
+  					     by total degree, the degree then
+					     the indices of the terms with
+					     one less power of x, y and z
+					     and then with two less powers
+					     of x, y and z, with -1 for no
+					     such term. */
+  WlzDVertex3	*moments;		/*!< Moments of the coefficients
+  					     about each node's centre, with
+					     nTerm moments for each node. */
+  WlzDVertex3	*vertices;		/*!< Control points in tree order. */
+  WlzDVertex3	*basis;			/*!< Basis function coefficients in
+  					     tree order. */
+  WlzBasisFnTreeNode *nodes;		/*!< Tree nodes with the root node
+  					     first. */
+} WlzBasisFnTree;
+
 /*!
 * \struct	_WlzBasisFn
 * \ingroup	WlzFunction
@@ -4554,6 +4761,13 @@ typedef struct _WlzBasisFn
 					     Athough the number of control
 					     points may vary the number of
 					     mesh nodes must remain constant. */
+  WlzBasisFnTree *tree;			/*!< Optional evaluation tree, set
+  					     by WlzBasisFnSetTree(), may be
+					     NULL in which case the basis
+					     function is evaluated directly.
+					     The tree must be rebuilt if the
+					     control points or coefficients
+					     are changed. */
 } WlzBasisFn;
 
 /*!
@@ -5097,8 +5311,63 @@ typedef struct _WlzGreyValueWSpace
 					     which values are background.
 					     Value is 0 if there are no
 					     background values. */
+  WlzTiledValuesTile *tile;		/*!< Current/last tile used for
+  					     compressed tiled values. */
 } WlzGreyValueWSpace;
 
+/*!
+* \struct	_WlzGreyValueCursor
+* \ingroup	WlzAccess
+* \brief	A cursor for random access to grey values which caches
+*		the last plane, line and interval so that coherent
+*		(neighbouring) queries avoid searching the domain and
+*		value tables. A cursor only reads its grey value work
+*		space, so any number of cursors (typically one per
+*		thread) may share a single work space.
+*		Typedef: ::WlzGreyValueCursor.
+*/
+typedef struct _WlzGreyValueCursor
+{
+  WlzGreyValueWSpace *gVWSp;		/*!< Shared grey value work space,
+  					     which is not modified. */
+  int		lnValid;		/*!< Non-zero if the cached plane
+  					     and line are valid. */
+  int           plane;                  /*!< Current/last plane. */
+  int           line;                   /*!< Current/last line. */
+  WlzIntervalDomain *iDom2D;       	/*!< Current/last plane or 2D object
+  					     domain. */
+  WlzValues     values2D;          	/*!< Current/last plane or 2D object
+  					     values. */
+  WlzObjectType gTabType2D;           	/*!< Current/last plane or 2D grey
+  					     table type. */
+  WlzIntervalLine *itvLn;		/*!< Current/last interval line or
+  					     NULL if the line is not within
+					     the domain. */
+  WlzIntervalLine rectItvLn;		/*!< Interval line used for
+  					     rectangular domains. */
+  WlzInterval	rectItv;		/*!< Interval used for rectangular
+  					     domains. */
+  int		itvIdx;			/*!< Index of the current/last
+  					     interval in the interval line. */
+  int		spanK0;			/*!< First column of the current
+  					     span, within which the values
+					     are contiguous (or background)
+					     and the domain is unchanged. */
+  int		spanK1;			/*!< Last column of the current
+  					     span. */
+  int		vpe;			/*!< Values per element. */
+  WlzGreyP	spanP;			/*!< Pointer to the value at the
+  					     first column of the current
+					     span or NULL if the span is
+					     background. */
+  WlzGreyP      gPtr;        		/*!< Grey pointer. */
+  WlzGreyV      gVal;        		/*!< Grey value. */
+  unsigned	bkdFlag;	  	/*!< Non-zero if the value is
+  					     background. */
+  WlzTiledValuesTile *tile;		/*!< Tile holding the current span
+  					     for compressed tiled values. */
+} WlzGreyValueCursor;
+
 /************************************************************************
 * File I/O flags
 ************************************************************************/
@@ -5498,6 +5767,85 @@ typedef struct _WlzKrigModelFn
                                         /*!< Function pointer. */
 } WlzKrigModelFn;
 
+/*!
+* \enum		_WlzPipelineOpFlags
+* \ingroup	WlzPipeline
+* \brief	Bit flags describing how a pipeline operation treats
+*		the values of the object it is given.
+*		Typedef: ::WlzPipelineOpFlags.
+*/
+typedef enum _WlzPipelineOpFlags
+{
+  WLZ_PIPELINE_OP_NEWVAL	= (1),	/*!< The returned object has new
+  					     values which are not shared
+					     with any other object. */
+  WLZ_PIPELINE_OP_INPLACE	= (1<<1) /*!< The operation modifies the
+  					     values of the given object in
+					     place and returns it. */
+} WlzPipelineOpFlags;
+
+/*!
+* \typedef	WlzPipelineOpFn
+* \ingroup	WlzPipeline
+* \brief	Pipeline operation function which is given an object
+*		and the stage's arguments and returns a new object
+*		(or for ::WLZ_PIPELINE_OP_INPLACE operations the given
+*		object).
+*/
+#ifdef WLZ_EXT_BIND
+typedef void *WlzPipelineOpFn;
+#else /* WLZ_EXT_BIND */
+typedef WlzObject *(*WlzPipelineOpFn)(WlzObject *, int, char **,
+				       WlzErrorNum *);
+#endif /* WLZ_EXT_BIND */
+
+/*!
+* \struct	_WlzPipelineOp
+* \ingroup	WlzPipeline
+* \brief	A named operation which may be used as a pipeline stage.
+*		Typedef: ::WlzPipelineOp.
+*/
+typedef struct _WlzPipelineOp
+{
+  const char	*name;			/*!< Operation name. */
+  int		minArg;			/*!< Minimum number of arguments. */
+  int		maxArg;			/*!< Maximum number of arguments. */
+  unsigned int	flags;			/*!< Bitwise or of
+  					     ::WlzPipelineOpFlags. */
+  const char	*usage;			/*!< Usage string. */
+  WlzPipelineOpFn fn;			/*!< Function pointer. */
+} WlzPipelineOp;
+
+/*!
+* \struct	_WlzPipelineStage
+* \ingroup	WlzPipeline
+* \brief	A stage of a pipeline.
+*		Typedef: ::WlzPipelineStage.
+*/
+typedef struct _WlzPipelineStage
+{
+  const WlzPipelineOp *op;		/*!< The stage's operation. */
+  int		nArg;			/*!< Number of arguments. */
+  char		**arg;			/*!< Arguments. */
+} WlzPipelineStage;
+
+/*!
+* \struct	_WlzPipeline
+* \ingroup	WlzPipeline
+* \brief	A chain of operations parsed from a description by
+*		WlzPipelineParse().
+*		Typedef: ::WlzPipeline.
+*/
+typedef struct _WlzPipeline
+{
+  int		nStage;			/*!< Number of stages. */
+  WlzPipelineStage *stages;		/*!< Array of stages. */
+  char		**args;			/*!< Storage for all the stages'
+  					     argument pointers. */
+  char		*str;			/*!< Copy of the description which
+  					     holds the argument strings. */
+} WlzPipeline;
+
 
 #ifndef WLZ_EXT_BIND
 #ifdef  __cplusplus
@@ -42,6 +42,10 @@ static char _WlzUnion3d_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* function:     WlzUnion3d    */
 /*! 
 * \ingroup      WlzBinaryOps
@@ -63,10 +67,10 @@ WlzObject *WlzUnion3d(int	n,
   /* local variables */
   WlzObject 		**objlist = NULL, *newobj = NULL;
   WlzPlaneDomain 	*pdom = NULL, *newpdom = NULL;
-  WlzVoxelValues 	*voxtab = NULL, *newvoxtab = NULL;
+  WlzVoxelValues 	*newvoxtab = NULL;
   WlzDomain 		*domains = NULL, domain;
   WlzValues	 	*values = NULL, vals;
-  int 			i, p, np, min_plane, max_plane;
+  int 			i, p, min_plane, max_plane, nThr = 1;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
     /* all objects have been checked by WlzUnionN therefore do not need
@@ -122,17 +126,28 @@ WlzObject *WlzUnion3d(int	n,
     }
   }
 
-  /* allocate space for a working object array */
+  /* allocate space for a working object array for each thread */
+#ifdef _OPENMP
+  if( errNum == WLZ_ERR_NONE ){
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nThr = omp_get_num_threads();
+      }
+    }
+  }
+#endif
   objlist = NULL;
   if( errNum == WLZ_ERR_NONE ){
-    if( (objlist = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n))
+    if( (objlist = (WlzObject **) AlcCalloc(nThr * n, sizeof(WlzObject *)))
        == NULL){
       errNum = WLZ_ERR_MEM_ALLOC;
     }
     else {
       domain.core = NULL;
       vals.core = NULL;
-      for(i=0; i < n; i++){
+      for(i=0; (i < nThr * n) && (errNum == WLZ_ERR_NONE); i++){
 	objlist[i] = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, vals,
 				 NULL, NULL, &errNum);
       }
@@ -155,58 +170,87 @@ WlzObject *WlzUnion3d(int	n,
     }
   }
 
-  /* find union at each plane */
+  /* find union at each plane, in parallel. Only non-empty planes are
+     passed to WlzUnionN() and a single non-empty plane is copied. */
   if( errNum == WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic, 1)
+#endif
     for(p=min_plane; p <= max_plane; p++){
+      int		i2, np, thrId = 0;
+      WlzObject		**plObjs, *plObj = NULL;
+      WlzDomain		plDom;
+      WlzValues		plVal;
+      WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      plObjs = objlist + thrId * n;
+      plDom.core = NULL;
+      plVal.core = NULL;
       np = 0;
-      for(i=0; i < n; i++){
-	pdom = objs[i]->domain.p;
-	if( pdom->plane1 > p || pdom->lastpl < p )
+      for(i2=0; i2 < n; i2++){
+	WlzPlaneDomain	*pdom2;
+	WlzVoxelValues	*voxtab2;
+
+	pdom2 = objs[i2]->domain.p;
+	if( pdom2->plane1 > p || pdom2->lastpl < p )
 	{
 	  continue;
 	}
 
-	if( (pdom->domains)[p - pdom->plane1].i == NULL )
+	if( (pdom2->domains)[p - pdom2->plane1].i == NULL )
 	{
 	  continue;
 	}
 
-	objlist[np]->domain.i = (pdom->domains)[p - pdom->plane1].i;
+	plObjs[np]->domain.i = (pdom2->domains)[p - pdom2->plane1].i;
+	plObjs[np]->values.v = NULL;
 	if( uvt ){
-	  voxtab = objs[i]->values.vox;
-	  objlist[np]->values.v = (voxtab->values)[p - voxtab->plane1].v;
+	  voxtab2 = objs[i2]->values.vox;
+	  plObjs[np]->values.v = (voxtab2->values)[p - voxtab2->plane1].v;
+	}
+	if( !WlzIsEmpty(plObjs[np], &errNum2) ){
+	  np++;
 	}
-	np++;
-      }
-
-      newobj = NULL;
-      if( np ){
-	newobj = WlzUnionN(np, objlist, uvt, &errNum);
       }
 
-      /* when np is 1, WlzUnionN does not return a copy. */
-      if( newobj != NULL ){
-	if (1 == np)
-	  domains[p - min_plane] = 
-	    WlzAssignDomain(WlzCopyDomain(newobj->type, newobj->domain,
-					  &errNum), NULL);
-	else
-	  domains[p - min_plane] = WlzAssignDomain(newobj->domain, NULL);
-	if( uvt ){
-	  if (1 == np)
-	    values[p - min_plane] =
-	      WlzAssignValues(WlzCopyValues(newobj->type, newobj->values,
-					    newobj->domain, &errNum), NULL);
-	  else
-	    values[p - min_plane] = WlzAssignValues(newobj->values, NULL);
+      if( errNum2 == WLZ_ERR_NONE ){
+	if( np == 1 ){
+	  plDom = WlzCopyDomain(WLZ_2D_DOMAINOBJ, plObjs[0]->domain,
+	  			&errNum2);
+	  if( uvt && (errNum2 == WLZ_ERR_NONE) &&
+	      (plObjs[0]->values.core != NULL) ){
+	    plVal = WlzCopyValues(WLZ_2D_DOMAINOBJ, plObjs[0]->values,
+	    			  plObjs[0]->domain, &errNum2);
+	  }
 	}
-	WlzFreeObj(newobj);
-      } else {
-	domains[p - min_plane].i = NULL;
-	if( uvt ){
-	  values[p - min_plane].v = NULL;
+	else if( np > 1 ){
+	  plObj = WlzUnionN(np, plObjs, uvt, &errNum2);
+	  if( plObj != NULL ){
+	    plDom = plObj->domain;
+	    plVal = plObj->values;
+	  }
 	}
       }
+      domains[p - min_plane] = WlzAssignDomain(plDom, NULL);
+      if( uvt ){
+	values[p - min_plane] = WlzAssignValues(plVal, NULL);
+      }
+      (void )WlzFreeObj(plObj);
+      if( errNum2 != WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp critical (WlzUnion3d)
+	{
+	  if( errNum == WLZ_ERR_NONE ){
+	    errNum = errNum2;
+	  }
+	}
+#else
+	errNum = errNum2;
+#endif
+      }
     }
   }
 
@@ -223,9 +267,17 @@ WlzObject *WlzUnion3d(int	n,
     vals.vox = newvoxtab;
     newobj = WlzMakeMain(WLZ_3D_DOMAINOBJ, domain, vals,
 			 NULL, NULL, &errNum);
+  }
 
   /* free allocated memory and return */
-    for(i=0; i < n; i++){
+  if( (errNum != WLZ_ERR_NONE) && newpdom ){
+    (void )WlzFreePlaneDomain(newpdom);
+    if( newvoxtab ){
+      (void )WlzFreeVoxelValueTb(newvoxtab);
+    }
+  }
+  if( objlist ){
+    for(i=0; i < nThr * n; i++){
       AlcFree(objlist[i]);
     }
     AlcFree( objlist );
@@ -39,12 +39,25 @@ static char _WlzWriteObj_c[] = "University of Edinburgh $Id$";
 * \ingroup	WlzIO
 */
 
+#if defined(HAVE_FOPENCOOKIE) && defined(HAVE_PWRITE)
+#define WLZ_USE_PWRITE
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#endif
+
 #include <errno.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <string.h>
 #include <Wlz.h>
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
 /* #define WLZ_DEBUG_WRITEOBJ */
 
 #if defined(_WIN32) && !defined(__x86)
@@ -52,6 +65,81 @@ static char _WlzWriteObj_c[] = "University of Edinburgh $Id$";
 #endif
 
 
+/*!
+* \def		WLZ_WRITEBUF_SZ
+* \ingroup	WlzIO
+* \brief	Size of the buffer in which blocks of data are converted
+* 		to the Woolz file byte order before being written.
+*/
+#define WLZ_WRITEBUF_SZ	(1 << 16)
+
+/*!
+* \def		WLZ_WRITEFD_BUFSZ
+* \ingroup	WlzIO
+* \brief	Size of the stream buffer used when writing to a file
+* 		descriptor.
+*/
+#define WLZ_WRITEFD_BUFSZ (1 << 20)
+
+/*!
+* \struct	_WlzWriteBuf
+* \ingroup	WlzIO
+* \brief	Buffer in which data are staged and converted to the Woolz
+* 		file byte order in bulk, so that they can be written using
+* 		few large writes rather than a write for each value.
+*/
+typedef struct _WlzWriteBuf
+{
+  FILE		*fP;		/*!< File to which the buffer is flushed. */
+  size_t	cnt;		/*!< Number of bytes in the buffer. */
+  WlzUByte	*buf;		/*!< Buffer of WLZ_WRITEBUF_SZ bytes. */
+} WlzWriteBuf;
+
+#ifdef WLZ_USE_PWRITE
+/*!
+* \struct	_WlzWriteFdCookie
+* \ingroup	WlzIO
+* \brief	Positional write state of a stream opened on a file
+* 		descriptor.
+*/
+typedef struct _WlzWriteFdCookie
+{
+  int		fd;		/*!< File descriptor. */
+  off_t		off;		/*!< Current file offset of the stream. */
+} WlzWriteFdCookie;
+#endif /* WLZ_USE_PWRITE */
+
+static WlzErrorNum		WlzWriteBufInit(
+				  WlzWriteBuf *wB,
+				  FILE *fP);
+static WlzErrorNum		WlzWriteBufFlush(
+				  WlzWriteBuf *wB);
+static WlzErrorNum		WlzWriteBufEnd(
+				  WlzWriteBuf *wB,
+				  WlzErrorNum errNum);
+static WlzErrorNum		WlzWriteBufGrey(
+				  WlzWriteBuf *wB,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  WlzGreyType packing,
+				  size_t n);
+static WlzErrorNum		WlzWriteGrey(
+				  FILE *fP,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  size_t n);
+#ifdef WLZ_USE_PWRITE
+static ssize_t			WlzWriteFdCookieWrite(
+				  void *cookie,
+				  const char *buf,
+				  size_t n);
+static int			WlzWriteFdCookieSeek(
+				  void *cookie,
+				  off64_t *pos,
+				  int whence);
+static int			WlzWriteFdCookieClose(
+				  void *cookie);
+#endif /* WLZ_USE_PWRITE */
 static WlzErrorNum		WlzWriteIntervalDomain(
 				  FILE *fP,
 				  WlzIntervalDomain *itvl);
@@ -74,6 +162,9 @@ static WlzErrorNum		WlzWriteTiledValueTable(
 				  FILE *fP,
 				  WlzObject *obj,
 				  int writeTiles);
+static WlzErrorNum		WlzWriteTiledValuesCmp(
+				  FILE *fP,
+				  WlzTiledValuesCmp *cmp);
 static WlzErrorNum		WlzWritePolygon(
 				  FILE *fP,
 				  WlzPolygonDomain *poly);
@@ -334,6 +425,209 @@ static int putdouble(double d, FILE *fP)
   return((int )fwrite(out.ubytes, sizeof(char), 8, fP));
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Initialises a write buffer for the given file.
+* \param	wB			Write buffer to initialise.
+* \param	fP			Given file.
+*/
+static WlzErrorNum WlzWriteBufInit(WlzWriteBuf *wB, FILE *fP)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  wB->fP = fP;
+  wB->cnt = 0;
+  if((wB->buf = (WlzUByte *)AlcMalloc(WLZ_WRITEBUF_SZ)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the contents of a write buffer to its file and
+* 		empties it.
+* \param	wB			Given write buffer.
+*/
+static WlzErrorNum WlzWriteBufFlush(WlzWriteBuf *wB)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(wB->cnt > 0)
+  {
+    if(fwrite(wB->buf, sizeof(WlzUByte), wB->cnt, wB->fP) != wB->cnt)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    wB->cnt = 0;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Flushes a write buffer, unless there has already been
+* 		an error, and then frees its storage.
+* \param	wB			Given write buffer.
+* \param	errNum			Error code so far.
+*/
+static WlzErrorNum WlzWriteBufEnd(WlzWriteBuf *wB, WlzErrorNum errNum)
+{
+  if((errNum == WLZ_ERR_NONE) && (wB->buf != NULL))
+  {
+    errNum = WlzWriteBufFlush(wB);
+  }
+  AlcFree(wB->buf);
+  wB->buf = NULL;
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Appends grey values to a write buffer, converting them
+* 		in bulk to the packing type and the Woolz file byte order
+* 		and writing the buffer whenever it is full.
+* 		The supported combinations of grey and packing types are
+* 		those of the value table file format: int values may be
+* 		packed as int, short or unsigned byte; short values as
+* 		short or unsigned byte, RGBA values are written as ints
+* 		and other values are not packed.
+* \param	wB			Given write buffer.
+* \param	gP			Grey values.
+* \param	gType			Grey type of the values.
+* \param	packing			Type written to the file.
+* \param	n			Number of values.
+*/
+static WlzErrorNum WlzWriteBufGrey(WlzWriteBuf *wB, WlzGreyP gP,
+				   WlzGreyType gType, WlzGreyType packing,
+				   size_t n)
+{
+  size_t	i,
+  		m,
+		gSz,
+		pSz;
+  WlzUByte	*bP;
+  WlzGreyV	in,
+  		out;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gSz = WlzGreySize(gType);
+  pSz = WlzGreySize(packing);
+  if((gSz == 0) || (pSz == 0))
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  while((errNum == WLZ_ERR_NONE) && (n > 0))
+  {
+    if((m = (WLZ_WRITEBUF_SZ - wB->cnt) / pSz) == 0)
+    {
+      errNum = WlzWriteBufFlush(wB);
+      continue;
+    }
+    if(m > n)
+    {
+      m = n;
+    }
+    bP = wB->buf + wB->cnt;
+    switch(packing)
+    {
+      case WLZ_GREY_INT:  /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+	for(i = 0; i < m; ++i)
+	{
+	  in.inv = gP.inp[i];
+	  WLZ_SWAP_OUT_WORD(out, in);
+	  (void )memcpy(bP, out.ubytes, 4);
+	  bP += 4;
+	}
+	break;
+      case WLZ_GREY_SHORT:
+	for(i = 0; i < m; ++i)
+	{
+	  in.shv = (gType == WLZ_GREY_INT)? (short )(gP.inp[i]): gP.shp[i];
+	  WLZ_SWAP_OUT_SHORT(out, in);
+	  bP[0] = out.ubytes[0];
+	  bP[1] = out.ubytes[1];
+	  bP += 2;
+	}
+	break;
+      case WLZ_GREY_UBYTE:
+	switch(gType)
+	{
+	  case WLZ_GREY_INT:
+	    for(i = 0; i < m; ++i)
+	    {
+	      bP[i] = (WlzUByte )(gP.inp[i]);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(i = 0; i < m; ++i)
+	    {
+	      bP[i] = (WlzUByte )(gP.shp[i]);
+	    }
+	    break;
+	  default:
+	    (void )memcpy(bP, gP.ubp, m);
+	    break;
+	}
+	break;
+      case WLZ_GREY_FLOAT:
+	for(i = 0; i < m; ++i)
+	{
+	  in.flv = gP.flp[i];
+	  WLZ_SWAP_OUT_FLOAT(out, in);
+	  (void )memcpy(bP, out.ubytes, 4);
+	  bP += 4;
+	}
+	break;
+      case WLZ_GREY_DOUBLE:
+	for(i = 0; i < m; ++i)
+	{
+	  in.dbv = gP.dbp[i];
+	  WLZ_SWAP_OUT_DOUBLE(out, in);
+	  (void )memcpy(bP, out.ubytes, 8);
+	  bP += 8;
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+    wB->cnt += m * pSz;
+    gP.ubp += m * gSz;
+    n -= m;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes an array of grey values to the given file in the
+* 		Woolz file byte order, converting them in blocks.
+* \param	fP			Given file.
+* \param	gP			Grey values.
+* \param	gType			Grey type of the values.
+* \param	n			Number of values.
+*/
+static WlzErrorNum WlzWriteGrey(FILE *fP, WlzGreyP gP, WlzGreyType gType,
+				size_t n)
+{
+  WlzWriteBuf	wB;
+  WlzErrorNum	errNum;
+
+  if((errNum = WlzWriteBufInit(&wB, fP)) == WLZ_ERR_NONE)
+  {
+    errNum = WlzWriteBufGrey(&wB, gP, gType, gType, n);
+  }
+  return(WlzWriteBufEnd(&wB, errNum));
+}
+
 /*!
 * \return       Woolz error number code.
 * \ingroup      WlzIO
@@ -533,6 +827,210 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return       Woolz error number code.
+* \ingroup      WlzIO
+* \brief        Writes an object to an open file descriptor.
+*
+*		If the offset pointer is NULL the object is written at the
+*		file descriptor's current offset, which is then advanced
+*		past the object as by write(2). Otherwise the object is
+*		written starting at the given offset and on return the
+*		offset is set to follow the object. Where positional
+*		writes (pwrite(2)) are available the file descriptor's own
+*		offset is then left unchanged, so several objects may be
+*		written to the same file concurrently by giving each a
+*		disjoint range of offsets.
+*
+*		The object is written through a stream with a large buffer,
+*		so together with the bulk conversion of domains and values
+*		the object is written using a few large writes.
+* \param	fd			Open file descriptor.
+* \param	off			Offset at which to write the object
+* 					or NULL to use the file descriptor's
+* 					current offset. On return the offset
+* 					following the object.
+* \param	obj			Object to be written.
+*/
+WlzErrorNum	WlzWriteObjFd(int fd, WlzLong *off, WlzObject *obj)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+#ifdef HAVE_UNISTD_H
+  int		fd2 = -1;
+  FILE		*fP = NULL;
+#ifdef WLZ_USE_PWRITE
+  WlzWriteFdCookie *cookie = NULL;
+  cookie_io_functions_t cookieFns;
+#endif /* WLZ_USE_PWRITE */
+
+  if(fd < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+#ifdef WLZ_USE_PWRITE
+  else if(off != NULL)
+  {
+    if((cookie = (WlzWriteFdCookie *)
+                 AlcMalloc(sizeof(WlzWriteFdCookie))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      cookie->fd = fd;
+      cookie->off = (off_t )*off;
+      cookieFns.read = NULL;
+      cookieFns.write = WlzWriteFdCookieWrite;
+      cookieFns.seek = WlzWriteFdCookieSeek;
+      cookieFns.close = WlzWriteFdCookieClose;
+      if((fP = fopencookie(cookie, "w", cookieFns)) == NULL)
+      {
+	AlcFree(cookie);
+	errNum = WLZ_ERR_FILE_OPEN;
+      }
+    }
+  }
+#endif /* WLZ_USE_PWRITE */
+  else
+  {
+    if((off != NULL) && (lseek(fd, (off_t )*off, SEEK_SET) == (off_t )-1))
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+    else if(((fd2 = dup(fd)) < 0) || ((fP = fdopen(fd2, "w")) == NULL))
+    {
+      if(fd2 >= 0)
+      {
+        (void )close(fd2);
+      }
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )setvbuf(fP, NULL, _IOFBF, WLZ_WRITEFD_BUFSZ);
+    errNum = WlzWriteObj(fP, obj);
+    if((fflush(fP) != 0) && (errNum == WLZ_ERR_NONE))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    if((errNum == WLZ_ERR_NONE) && (off != NULL))
+    {
+      *off = (WlzLong )ftello(fP);
+    }
+    if((fclose(fP) != 0) && (errNum == WLZ_ERR_NONE))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+#else /* HAVE_UNISTD_H */
+  errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* HAVE_UNISTD_H */
+  return(errNum);
+}
+
+#ifdef WLZ_USE_PWRITE
+/*!
+* \return	Number of bytes written or -1 on error.
+* \ingroup	WlzIO
+* \brief	Stream write function which writes the given bytes at the
+* 		stream's offset using pwrite(2).
+* \param	cookie			Positional write state.
+* \param	buf			Bytes to write.
+* \param	n			Number of bytes.
+*/
+static ssize_t	WlzWriteFdCookieWrite(void *cookie, const char *buf,
+				      size_t n)
+{
+  size_t	done = 0;
+  WlzWriteFdCookie *c;
+
+  c = (WlzWriteFdCookie *)cookie;
+  while(done < n)
+  {
+    ssize_t	w;
+
+    if((w = pwrite(c->fd, buf + done, n - done, c->off)) < 0)
+    {
+      if(errno != EINTR)
+      {
+        break;
+      }
+    }
+    else
+    {
+      done += w;
+      c->off += w;
+    }
+  }
+  return((done > 0)? (ssize_t )done: ((n > 0)? -1: 0));
+}
+
+/*!
+* \return	Zero on success or -1 on error.
+* \ingroup	WlzIO
+* \brief	Stream seek function for positional writes.
+* \param	cookie			Positional write state.
+* \param	pos			Given offset, set to the new offset
+* 					on return.
+* \param	whence			Seek origin as for lseek(2).
+*/
+static int	WlzWriteFdCookieSeek(void *cookie, off64_t *pos, int whence)
+{
+  int		rtn = 0;
+  off_t		o = 0;
+  struct stat	st;
+  WlzWriteFdCookie *c;
+
+  c = (WlzWriteFdCookie *)cookie;
+  switch(whence)
+  {
+    case SEEK_SET:
+      o = *pos;
+      break;
+    case SEEK_CUR:
+      o = c->off + *pos;
+      break;
+    case SEEK_END:
+      if(fstat(c->fd, &st) == 0)
+      {
+        o = st.st_size + *pos;
+      }
+      else
+      {
+        rtn = -1;
+      }
+      break;
+    default:
+      rtn = -1;
+      break;
+  }
+  if((rtn == 0) && (o < 0))
+  {
+    rtn = -1;
+  }
+  if(rtn == 0)
+  {
+    c->off = o;
+    *pos = o;
+  }
+  return(rtn);
+}
+
+/*!
+* \return	Zero.
+* \ingroup	WlzIO
+* \brief	Stream close function for positional writes, which frees
+* 		the write state but leaves the file descriptor open.
+* \param	cookie			Positional write state.
+*/
+static int	WlzWriteFdCookieClose(void *cookie)
+{
+  AlcFree(cookie);
+  return(0);
+}
+#endif /* WLZ_USE_PWRITE */
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -544,17 +1042,10 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
 */
 static WlzErrorNum WlzWriteInt(FILE *fP, int *iP, size_t nI)
 {
-  WlzErrorNum 	errNum = WLZ_ERR_NONE;
+  WlzGreyP	gP;
 
-  while((errNum == WLZ_ERR_NONE) && (nI-- > 0))
-  {
-    if(!putword(*iP, fP))
-    {
-      errNum = WLZ_ERR_WRITE_INCOMPLETE;
-    }
-    ++iP;
-  }
-  return(errNum);
+  gP.inp = iP;
+  return(WlzWriteGrey(fP, gP, WLZ_GREY_INT, nI));
 }
 
 /*!
@@ -568,17 +1059,10 @@ static WlzErrorNum WlzWriteInt(FILE *fP, int *iP, size_t nI)
 */
 static WlzErrorNum WlzWriteShort(FILE *fP, short *iP, size_t nI)
 {
-  WlzErrorNum 	errNum = WLZ_ERR_NONE;
+  WlzGreyP	gP;
 
-  while((errNum == WLZ_ERR_NONE) && (nI-- > 0))
-  {
-    if(!putshort(*iP, fP))
-    {
-      errNum = WLZ_ERR_WRITE_INCOMPLETE;
-    }
-    ++iP;
-  }
-  return(errNum);
+  gP.shp = iP;
+  return(WlzWriteGrey(fP, gP, WLZ_GREY_SHORT, nI));
 }
 
 /*!
@@ -612,21 +1096,10 @@ static WlzErrorNum WlzWriteUByte(FILE *fP, WlzUByte *iP, size_t nI)
 */
 static WlzErrorNum WlzWriteFloat(FILE *fP, float *iP, size_t nI)
 {
-  WlzErrorNum 	errNum = WLZ_ERR_NONE;
+  WlzGreyP	gP;
 
-  while((errNum == WLZ_ERR_NONE) && (nI-- > 0))
-  {
-    if(!putfloat(*iP, fP))
-    {
-      errNum = WLZ_ERR_WRITE_INCOMPLETE;
-    }
-    ++iP;
-  }
-  if(fwrite(iP, sizeof(float), nI, fP) != nI)
-  {
-    errNum = WLZ_ERR_WRITE_INCOMPLETE;
-  }
-  return(errNum);
+  gP.flp = iP;
+  return(WlzWriteGrey(fP, gP, WLZ_GREY_FLOAT, nI));
 }
 
 /*!
@@ -640,17 +1113,10 @@ static WlzErrorNum WlzWriteFloat(FILE *fP, float *iP, size_t nI)
 */
 static WlzErrorNum WlzWriteDouble(FILE *fP, double *iP, size_t nI)
 {
-  WlzErrorNum 	errNum = WLZ_ERR_NONE;
+  WlzGreyP	gP;
 
-  while((errNum == WLZ_ERR_NONE) && (nI-- > 0))
-  {
-    if(!putdouble(*iP, fP))
-    {
-      errNum = WLZ_ERR_WRITE_INCOMPLETE;
-    }
-    ++iP;
-  }
-  return(errNum);
+  gP.dbp = iP;
+  return(WlzWriteGrey(fP, gP, WLZ_GREY_DOUBLE, nI));
 }
 
 /*!
@@ -995,8 +1461,9 @@ static WlzErrorNum	WlzWritePixelV(FILE *fP, WlzPixelV *pV, int nPV)
 static WlzErrorNum WlzWriteIntervalDomain(FILE *fP, WlzIntervalDomain *itvl)
 {
   int 			i,
-  			j,
 			nlines;
+  WlzGreyP		gP;
+  WlzWriteBuf		wB;
   WlzIntervalLine	*ivln;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
@@ -1028,30 +1495,27 @@ static WlzErrorNum WlzWriteIntervalDomain(FILE *fP, WlzIntervalDomain *itvl)
       switch(itvl->type)
       {
 	case WLZ_INTERVALDOMAIN_INTVL:
+	  /* The interval counts of all lines followed by the intervals
+	   * of all lines are staged in a buffer for bulk writing. */
 	  nlines = itvl->lastln - itvl->line1;
+	  errNum = WlzWriteBufInit(&wB, fP);
+	  ivln = itvl->intvlines;
 	  for(i = 0; (i <= nlines) && (errNum == WLZ_ERR_NONE); i++)
 	  {
-	    if(!putword(itvl->intvlines[i].nintvs, fP))
-	    {
-	      errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	    }
+	    gP.inp = &(ivln[i].nintvs);
+	    errNum = WlzWriteBufGrey(&wB, gP, WLZ_GREY_INT, WLZ_GREY_INT, 1);
 	  }
-	  if(errNum == WLZ_ERR_NONE)
+	  for(i = 0; (i <= nlines) && (errNum == WLZ_ERR_NONE); i++)
 	  {
-	    ivln = itvl->intvlines;
-	    for(i = 0; (i <= nlines) && (errNum == WLZ_ERR_NONE); i++)
+	    if(ivln[i].nintvs > 0)
 	    {
-	      for(j = 0; (j < ivln->nintvs) && (errNum == WLZ_ERR_NONE); j++)
-	      {
-		if(!putword(ivln->intvs[j].ileft, fP) ||
-		   !putword(ivln->intvs[j].iright, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	      ivln++;
+	      /* An interval is a pair of ints, left then right. */
+	      gP.inp = &(ivln[i].intvs[0].ileft);
+	      errNum = WlzWriteBufGrey(&wB, gP, WLZ_GREY_INT, WLZ_GREY_INT,
+	                               2 * ivln[i].nintvs);
 	    }
 	  }
+	  errNum = WlzWriteBufEnd(&wB, errNum);
 	  break;
 	case WLZ_INTERVALDOMAIN_RECT:
 	  break;
@@ -1359,12 +1823,11 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
   WlzIntervalWSpace	iwsp;
   WlzGreyWSpace		gwsp;
   WlzGreyType		gType;
-  WlzGreyP		g;
   WlzPixelV		background,
   			min,
 			max;
-  int 			i;
   WlzGreyType		packing;
+  WlzWriteBuf		wB;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* obj == NULL has been checked by WlzWriteObj() */
@@ -1394,12 +1857,14 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
       }
     }
     background = WlzGetBackground(obj, &errNum);
+    /* Write the packing and background, choosing the packing for int
+     * and short values to minimise disc space. */
     if(errNum == WLZ_ERR_NONE)
     {
+      packing = gType;
       switch(gType)
       {
 	case WLZ_GREY_INT:
-	  /* Calculate packing to minimise disc space */
 	  if((errNum = WlzGreyRange(obj, &min, &max)) == WLZ_ERR_NONE)
 	  {
 	    if((min.v.inv >= 0) && (max.v.inv <= 255))
@@ -1410,258 +1875,84 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
 	    {
 	      packing = WLZ_GREY_SHORT;
 	    }
-	    else
-	    {
-	      packing = WLZ_GREY_INT;
-	    }
 	    if((putc((unsigned int )packing, fP) == EOF) ||
 	       !putword(background.v.inv, fP))
             {
 	      errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	    }
-	    if((errNum = WlzInitGreyScan(obj, &iwsp, &gwsp)) == WLZ_ERR_NONE)
-	    {
-	      while((errNum == WLZ_ERR_NONE) &&
-	            ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	      {
-		g = gwsp.u_grintptr;
-		switch(packing)
-		{
-		  case WLZ_GREY_INT:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-			i++, g.inp++)
-		    {
-		      if(!putword(*g.inp, fP))
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  case WLZ_GREY_SHORT:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-			i++, g.inp++)
-		    {
-		      if(!putshort((short) (*g.inp), fP))
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  case WLZ_GREY_UBYTE:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		    	i++, g.inp++)
-		    {
-		      if(putc((unsigned int )*g.inp, fP) == EOF)
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  default:
-		    errNum = WLZ_ERR_GREY_TYPE;
-		    break;
-		}
-	      }
-	      (void )WlzEndGreyScan(&iwsp, &gwsp);
-	      if(errNum == WLZ_ERR_EOO)
-	      {
-	        errNum = WLZ_ERR_NONE;
-	      }
-	    }
 	  }
 	  break;
 	case WLZ_GREY_SHORT:
-	  /* Calculate packing to minimise disc space */
 	  if((errNum = WlzGreyRange(obj, &min, &max)) == WLZ_ERR_NONE)
 	  {
 	    if((min.v.shv >= 0) && (max.v.shv <= 255))
 	    {
 	      packing = WLZ_GREY_UBYTE;
 	    }
-	    else
-	    {
-	      packing = WLZ_GREY_SHORT;
-	    }
 	    if((putc((unsigned int )packing, fP) == EOF) ||
 	       !putword(background.v.shv, fP))
 	    {
 	      errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	    }
-	    if((errNum = WlzInitGreyScan(obj, &iwsp, &gwsp)) == WLZ_ERR_NONE)
-	    {
-	      while((errNum == WLZ_ERR_NONE) &&
-	            ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	      {
-		g = gwsp.u_grintptr;
-		switch(packing)
-		{
-		  case WLZ_GREY_SHORT:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		    	i++, g.shp++)
-		    {
-		      if(!putshort(*g.shp, fP))
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  case WLZ_GREY_UBYTE:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		    	i++, g.shp++)
-		    {
-		      if(putc((unsigned int) *g.shp, fP) == EOF)
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  default:
-		    errNum = WLZ_ERR_GREY_TYPE;
-		    break;
-		}
-	      }
-	      (void )WlzEndGreyScan(&iwsp, &gwsp);
-	      if(errNum == WLZ_ERR_EOO)
-	      {
-	        errNum = WLZ_ERR_NONE;
-	      }
-	    }
 	  }
 	  break;
 	case WLZ_GREY_UBYTE:
-	  packing = WLZ_GREY_UBYTE;
 	  if((putc((unsigned int )packing, fP) == EOF) ||
 	     !putword(background.v.ubv, fP))
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      if((int )fwrite(g.ubp, sizeof(WlzUByte),
-	      		      iwsp.colrmn, fP) < iwsp.colrmn)
-	      {
-		errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	case WLZ_GREY_FLOAT:
-	  packing = WLZ_GREY_FLOAT;
 	  if((putc((unsigned int )packing, fP) == EOF) ||
 	     !putfloat(background.v.flv, fP))
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		  i++, g.flp++)
-	      {
-		if(!putfloat(*g.flp, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	case WLZ_GREY_DOUBLE:
-	  packing = WLZ_GREY_DOUBLE;
 	  if((putc((unsigned int )packing, fP) == EOF) ||
 	     !putdouble(background.v.dbv, fP))
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-	          i++, g.dbp++)
-	      {
-		if(!putdouble(*g.dbp, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	case WLZ_GREY_RGBA:
-	  packing = WLZ_GREY_RGBA;
 	  if((putc((unsigned int )packing, fP) == EOF) ||
 	     !putword(background.v.rgbv, fP))
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-	          i++, g.rgbp++)
-	      {
-		if(!putword(*g.rgbp, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	default:
 	  errNum = WLZ_ERR_GREY_TYPE;
 	  break;
       }
     }
+    /* Write the values of all intervals, staging and converting them
+     * in a buffer which is written in large blocks. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzWriteBufInit(&wB, fP);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((errNum = WlzInitGreyScan(obj, &iwsp, &gwsp)) == WLZ_ERR_NONE)
+      {
+	while((errNum == WLZ_ERR_NONE) &&
+	      ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
+	{
+	  errNum = WlzWriteBufGrey(&wB, gwsp.u_grintptr, gType, packing,
+	                           iwsp.colrmn);
+	}
+	(void )WlzEndGreyScan(&iwsp, &gwsp);
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      errNum = WlzWriteBufEnd(&wB, errNum);
+    }
   }
   return(errNum);
 }
@@ -3167,11 +3458,11 @@ static WlzErrorNum WlzWriteCMesh3D(FILE *fP, int **dstNodTbl,
 static WlzErrorNum WlzWriteIndexedValues(FILE *fP, WlzObject *obj)
 {
   int		idX,
-		idV,
 		vCount,
   		nValues = 0;
   WlzGreyP	gP;
   WlzCMeshP	mesh;
+  WlzWriteBuf	wB;
   WlzIndexedValues *ixv;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -3284,42 +3575,15 @@ static WlzErrorNum WlzWriteIndexedValues(FILE *fP, WlzObject *obj)
 	  vCount *= ixv->dim[idX];
 	}
       }
-      for(idX = 0; idX < nValues; ++idX)
+      if((errNum = WlzWriteBufInit(&wB, fP)) == WLZ_ERR_NONE)
       {
-	gP.v = WlzIndexedValueGet(ixv, idX);
-	for(idV = 0; idV < vCount; ++idV)
+	for(idX = 0; (idX < nValues) && (errNum == WLZ_ERR_NONE); ++idX)
 	{
-	  switch(ixv->vType)
-	  {
-	    case WLZ_GREY_INT:
-	      (void )putword(gP.inp[idV], fP);
-	      break;
-	    case WLZ_GREY_SHORT:
-	      (void )putshort(gP.shp[idV], fP);
-	      break;
-	    case WLZ_GREY_UBYTE:
-	      (void )putc(gP.ubp[idV], fP);
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      (void )putfloat(gP.flp[idV], fP);
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      (void )putdouble(gP.dbp[idV], fP);
-	      break;
-	    case WLZ_GREY_RGBA:
-	      (void )putword(gP.rgbp[idV], fP);
-	      break;
-	    default:
-	      errNum = WLZ_ERR_GREY_TYPE;
-	      break;
-	  }
-	}
-	if(feof(fP))
-	{
-	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	  break;
+	  gP.v = WlzIndexedValueGet(ixv, idX);
+	  errNum = WlzWriteBufGrey(&wB, gP, ixv->vType, ixv->vType, vCount);
 	}
       }
+      errNum = WlzWriteBufEnd(&wB, errNum);
     }
   }
   return(errNum);
@@ -3355,7 +3619,8 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    putc(tVal->dim, fP);
+    /* The compression type is encoded in the upper bits of the dimension. */
+    putc(tVal->dim | ((tVal->cmp)? (tVal->cmp->type << 4): 0), fP);
     putword(tVal->kol1, fP);
     putword(tVal->lastkl, fP);
     putword(tVal->line1, fP);
@@ -3401,8 +3666,11 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
     WlzLong     off[2];
 
     tMrk = ftell(fP) + (2 * sizeof(unsigned int ));
-    blks = (tMrk + tVal->tileSz - 1) / tVal->tileSz;
-    tMrk = blks * tVal->tileSz;
+    if(tVal->cmp == NULL)
+    {
+      blks = (tMrk + tVal->tileSz - 1) / tVal->tileSz;
+      tMrk = blks * tVal->tileSz;
+    }
     off[0] = tMrk & 0xffffffff;
     off[1] = (sizeof(long) > 4)? tMrk >> 32: 0;
     putword((unsigned int )(off[0]), fP);
@@ -3412,7 +3680,11 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
       errNum = WLZ_ERR_WRITE_INCOMPLETE;
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && (tVal->cmp != NULL))
+  {
+    errNum = WlzWriteTiledValuesCmp(fP, tVal->cmp);
+  }
+  else if(errNum == WLZ_ERR_NONE)
   {
     size_t      gSz,
     		tSz;
@@ -3494,6 +3766,53 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the compressed tiles of a tiled value table. These
+* 		are written as the offsets of the compressed tiles (with
+* 		one more offset than there are tiles) followed by the
+* 		compressed tiles. Each offset is written as two words,
+* 		least significant first, and is relative to the start of
+* 		the compressed tiles.
+* \param	fP			Given file pointer.
+* \param	cmp			Given compressed tiles.
+*/
+static WlzErrorNum WlzWriteTiledValuesCmp(FILE *fP, WlzTiledValuesCmp *cmp)
+{
+  size_t	idx,
+  		nOff;
+  int		*offBuf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nOff = cmp->numTiles + 1;
+  if((offBuf = (int *)AlcMalloc(2 * nOff * sizeof(int))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idx = 0; idx < nOff; ++idx)
+    {
+      offBuf[2 * idx] = (int )(cmp->offsets[idx] & 0xffffffff);
+      offBuf[(2 * idx) + 1] = (int )(cmp->offsets[idx] >> 32);
+    }
+    errNum = WlzWriteInt(fP, offBuf, 2 * nOff);
+    AlcFree(offBuf);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	n;
+
+    n = cmp->offsets[cmp->numTiles];
+    if((n > 0) && (fwrite(cmp->data, 1, n, fP) != n))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -66,10 +66,6 @@ static char _WlzExtFFNodeEle_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 #include <WlzExtFF.h>
 
-static char			*WlzEffReadObjNodeEleRec(
-				  FILE *fP,
-				  char *buf,
-				  int bufLen);
 /*!
 * \return       Woolz error number.
 * \ingroup      WlzExtFF
@@ -125,11 +121,8 @@ WlzErrorNum     WlzEffNodeEleFileNames(char **fileBody,
 WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
 				      WlzErrorNum *dstErr)
 {
-  int		cnt,
-		idx,
-  		idE,
+  int		idE,
   		idN,
-		bnd = 0,
 		dim = 0,
 		nAtr = 0,
 		nBnd = 0,
@@ -139,16 +132,19 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
   FILE		*fP = NULL;
   char		*fileName = NULL,
   		*nodeFileName = NULL,
-		*eleFileName = NULL,
-		*str;
-  int 		eBuf[4];
+		*eleFileName = NULL;
+  int		*eP,
+  		*eBuf = NULL;
+  double	*dP,
+  		*dBuf = NULL;
+  WlzEffTok	*tok = NULL;
   WlzVertexP    vBuf;
   WlzCMeshP	mesh;
   WlzObject	*obj = NULL;
   WlzDomain	dom;
   WlzValues	val;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-  char		cBuf[256];
+  int		hBuf[4];
   WlzCMeshNod2D	*nBuf2[4];
   WlzCMeshNod3D	*nBuf3[4];
 
@@ -186,28 +182,23 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
   {
     errNum = WLZ_ERR_PARAM_NULL;
   }
-  else
+  else if((tok = WlzEffTokNew(fP, '#', &errNum)) != NULL)
   {
     /* Optional records may be comments starting with a '#' but apart
      * from these the first line should have four integers specifying
      * the number of nodes, the dimension, the number of attributes
      * and the number of boundary markers. */
-    cnt = 0;
-    do
+    if(WlzEffTokInts(tok, hBuf, 4) != WLZ_ERR_NONE)
     {
-      if((str = WlzEffReadObjNodeEleRec(fP, cBuf, 256)) == NULL)
-      {
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if(*str != '#')
-      {
-	if((cnt = sscanf(str, "%d %d %d %d",
-	                 &nNod, &dim, &nAtr, &nBnd)) != 4)
-	{
-	  errNum = WLZ_ERR_READ_INCOMPLETE;
-	}
-      }
-    } while((errNum == WLZ_ERR_NONE) && (cnt != 4));
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      nNod = hBuf[0];
+      dim = hBuf[1];
+      nAtr = hBuf[2];
+      nBnd = hBuf[3];
+    }
   }
   /* Check for reasonable number of nodes, etc.... */
   if(errNum == WLZ_ERR_NONE)
@@ -218,6 +209,14 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
     }
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    if((dBuf = (double *)
+               AlcMalloc(sizeof(double) * 5 * WLZEFF_TOK_BATCH)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     idN = 0;
     if(dim == 2)
@@ -235,50 +234,38 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
       }
       while((errNum == WLZ_ERR_NONE) && (idN < nNod))
       {
-	if((str = WlzEffReadObjNodeEleRec(fP, cBuf, 256)) == NULL)
+	if((dP = WlzEffTokDblBatch(tok, dBuf, idN, nNod, 4, NULL)) == NULL)
 	{
 	  errNum = WLZ_ERR_READ_INCOMPLETE;
 	  break;
 	}
-	else if(*str != '#')
+	vBuf.d2[idN].vtX = dP[1];
+	vBuf.d2[idN].vtY = dP[2];
+	if(idN == 0)
 	{
-	  if((sscanf(str, "%d %lg %lg %d",
-		     &idx,
-		     &(vBuf.d2[idN].vtX), &(vBuf.d2[idN].vtY),
-		     &bnd) == 4) && (idx = idN + 1))
+	  mesh.m2->bBox.xMin = mesh.m2->bBox.xMax = vBuf.d2[idN].vtX;
+	  mesh.m2->bBox.yMin = mesh.m2->bBox.yMax = vBuf.d2[idN].vtY;
+	}
+	else
+	{
+	  if(vBuf.d2[idN].vtX < mesh.m2->bBox.xMin)
 	  {
-	    if(idN == 0)
-	    {
-	      mesh.m2->bBox.xMin = mesh.m2->bBox.xMax = vBuf.d2[idN].vtX;
-	      mesh.m2->bBox.yMin = mesh.m2->bBox.yMax = vBuf.d2[idN].vtY;
-	    }
-	    else
-	    {
-	      if(vBuf.d2[idN].vtX < mesh.m2->bBox.xMin)
-	      {
-		mesh.m2->bBox.xMin = vBuf.d2[idN].vtX;
-	      }
-	      else if(vBuf.d2[idN].vtX > mesh.m2->bBox.xMax)
-	      {
-		mesh.m2->bBox.xMax = vBuf.d2[idN].vtX;
-	      }
-	      if(vBuf.d2[idN].vtY < mesh.m2->bBox.yMin)
-	      {
-		mesh.m2->bBox.yMin = vBuf.d2[idN].vtY;
-	      }
-	      else if(vBuf.d2[idN].vtY > mesh.m2->bBox.yMax)
-	      {
-		mesh.m2->bBox.yMax = vBuf.d2[idN].vtY;
-	      }
-	    }
-	    ++idN;
+	    mesh.m2->bBox.xMin = vBuf.d2[idN].vtX;
 	  }
-	  else
+	  else if(vBuf.d2[idN].vtX > mesh.m2->bBox.xMax)
 	  {
-	    errNum = WLZ_ERR_READ_INCOMPLETE;
-	    break;
+	    mesh.m2->bBox.xMax = vBuf.d2[idN].vtX;
+	  }
+	  if(vBuf.d2[idN].vtY < mesh.m2->bBox.yMin)
+	  {
+	    mesh.m2->bBox.yMin = vBuf.d2[idN].vtY;
+	  }
+	  else if(vBuf.d2[idN].vtY > mesh.m2->bBox.yMax)
+	  {
+	    mesh.m2->bBox.yMax = vBuf.d2[idN].vtY;
 	  }
 	}
+	++idN;
       }
       /* Create the nodes. */
       if(errNum == WLZ_ERR_NONE)
@@ -317,60 +304,48 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
       }
       while((errNum == WLZ_ERR_NONE) && (idN < nNod))
       {
-	if((str = WlzEffReadObjNodeEleRec(fP, cBuf, 256)) == NULL)
+	if((dP = WlzEffTokDblBatch(tok, dBuf, idN, nNod, 5, NULL)) == NULL)
 	{
 	  errNum = WLZ_ERR_READ_INCOMPLETE;
 	  break;
 	}
-	else if(*str != '#')
+	vBuf.d3[idN].vtX = dP[1];
+	vBuf.d3[idN].vtY = dP[2];
+	vBuf.d3[idN].vtZ = dP[3];
+	if(idN == 0)
 	{
-	  if((sscanf(str, "%d %lg %lg %lg %d",
-		     &idx,
-		     &(vBuf.d3[idN].vtX), &(vBuf.d3[idN].vtY),
-		     &(vBuf.d3[idN].vtZ),
-		     &bnd) == 5) && (idx = idN + 1))
+	  mesh.m3->bBox.xMin = mesh.m3->bBox.xMax = vBuf.d3[idN].vtX;
+	  mesh.m3->bBox.yMin = mesh.m3->bBox.yMax = vBuf.d3[idN].vtY;
+	  mesh.m3->bBox.zMin = mesh.m3->bBox.zMax = vBuf.d3[idN].vtZ;
+	}
+	else
+	{
+	  if(vBuf.d3[idN].vtX < mesh.m3->bBox.xMin)
 	  {
-	    if(idN == 0)
-	    {
-	      mesh.m3->bBox.xMin = mesh.m3->bBox.xMax = vBuf.d3[idN].vtX;
-	      mesh.m3->bBox.yMin = mesh.m3->bBox.yMax = vBuf.d3[idN].vtY;
-	      mesh.m3->bBox.zMin = mesh.m3->bBox.zMax = vBuf.d3[idN].vtZ;
-	    }
-	    else
-	    {
-	      if(vBuf.d3[idN].vtX < mesh.m3->bBox.xMin)
-	      {
-		mesh.m3->bBox.xMin = vBuf.d3[idN].vtX;
-	      }
-	      else if(vBuf.d3[idN].vtX > mesh.m3->bBox.xMax)
-	      {
-		mesh.m3->bBox.xMax = vBuf.d3[idN].vtX;
-	      }
-	      if(vBuf.d3[idN].vtY < mesh.m3->bBox.yMin)
-	      {
-		mesh.m3->bBox.yMin = vBuf.d3[idN].vtY;
-	      }
-	      else if(vBuf.d3[idN].vtY > mesh.m3->bBox.yMax)
-	      {
-		mesh.m3->bBox.yMax = vBuf.d3[idN].vtY;
-	      }
-	      if(vBuf.d3[idN].vtZ < mesh.m3->bBox.zMin)
-	      {
-		mesh.m3->bBox.zMin = vBuf.d3[idN].vtZ;
-	      }
-	      else if(vBuf.d3[idN].vtZ > mesh.m3->bBox.zMax)
-	      {
-		mesh.m3->bBox.zMax = vBuf.d3[idN].vtZ;
-	      }
-	    }
-	    ++idN;
+	    mesh.m3->bBox.xMin = vBuf.d3[idN].vtX;
 	  }
-	  else
+	  else if(vBuf.d3[idN].vtX > mesh.m3->bBox.xMax)
 	  {
-	    errNum = WLZ_ERR_READ_INCOMPLETE;
-	    break;
+	    mesh.m3->bBox.xMax = vBuf.d3[idN].vtX;
+	  }
+	  if(vBuf.d3[idN].vtY < mesh.m3->bBox.yMin)
+	  {
+	    mesh.m3->bBox.yMin = vBuf.d3[idN].vtY;
+	  }
+	  else if(vBuf.d3[idN].vtY > mesh.m3->bBox.yMax)
+	  {
+	    mesh.m3->bBox.yMax = vBuf.d3[idN].vtY;
+	  }
+	  if(vBuf.d3[idN].vtZ < mesh.m3->bBox.zMin)
+	  {
+	    mesh.m3->bBox.zMin = vBuf.d3[idN].vtZ;
+	  }
+	  else if(vBuf.d3[idN].vtZ > mesh.m3->bBox.zMax)
+	  {
+	    mesh.m3->bBox.zMax = vBuf.d3[idN].vtZ;
 	  }
 	}
+	++idN;
       }
       /* Create the nodes. */
       if(errNum == WLZ_ERR_NONE)
@@ -396,7 +371,10 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
     }
   }
   AlcFree(vBuf.v);
+  AlcFree(dBuf);
   /* Close node file. */
+  (void )WlzEffTokFree(tok);
+  tok = NULL;
   if(fP)
   {
     (void )fclose(fP);
@@ -421,27 +399,33 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
 #endif
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    if((eBuf = (int *)
+               AlcMalloc(sizeof(int) * 5 * WLZEFF_TOK_BATCH)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      tok = WlzEffTokNew(fP, '#', &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     /* Optional records may be comments starting with a '#' but apart
-     * from these the first line should have four integers specifying
-     * the number of nodes, the dimension, the number of attributes
-     * and the number of boundary markers. */
-    cnt = 0;
-    do
+     * from these the first line should have three integers specifying
+     * the number of elements, the number of nodes per element and the
+     * number of attributes. */
+    if(WlzEffTokInts(tok, hBuf, 3) != WLZ_ERR_NONE)
     {
-      if((str = WlzEffReadObjNodeEleRec(fP, cBuf, 256)) == NULL)
-      {
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if(*str != '#')
-      {
-	if((cnt = sscanf(str, "%d %d %d",
-	                 &nElm, &nodPerElm, &nAtr)) != 3)
-	{
-	  errNum = WLZ_ERR_READ_INCOMPLETE;
-	}
-      }
-    } while((errNum == WLZ_ERR_NONE) && (cnt != 3));
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      nElm = hBuf[0];
+      nodPerElm = hBuf[1];
+      nAtr = hBuf[2];
+    }
   }
   /* Check for reasonable number of nodes, etc.... */
   if(errNum == WLZ_ERR_NONE)
@@ -462,40 +446,27 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
       }
       while((errNum == WLZ_ERR_NONE) && (idE < nElm))
       {
-	if((str = WlzEffReadObjNodeEleRec(fP, cBuf, 256)) == NULL)
+	if((eP = WlzEffTokIntBatch(tok, eBuf, idE, nElm, 4, NULL)) == NULL)
 	{
 	  errNum = WLZ_ERR_READ_INCOMPLETE;
 	  break;
 	}
-	else if(*str != '#')
+	if((eP[0] != idE + 1) ||
+	   (eP[1] <= 0) || (eP[1] > nNod) ||
+	   (eP[2] <= 0) || (eP[2] > nNod) ||
+	   (eP[3] <= 0) || (eP[3] > nNod))
 	{
-	  if(sscanf(str, "%d %d %d %d",
-		    &idx, eBuf + 0, eBuf + 1, eBuf + 2) == 4)
-	  {
-	    if((idx != idE + 1) ||
-	       (eBuf[0] <= 0) || (eBuf[0] > nNod) ||
-	       (eBuf[1] <= 0) || (eBuf[1] > nNod) ||
-	       (eBuf[2] <= 0) || (eBuf[2] > nNod))
-	    {
-	      errNum = WLZ_ERR_MEM_ALLOC;
-	      break;
-	    }
-	    for(idN = 0; idN < 4; ++idN)
-	    {
-	      nBuf2[idN] = (WlzCMeshNod2D *)
-			   AlcVectorItemGet(mesh.m2->res.nod.vec,
-			                    eBuf[idN] - 1);
-	    }
-	    (void )WlzCMeshNewElm2D(mesh.m2, nBuf2[0], nBuf2[2], nBuf2[1],
-				    1, &errNum);
-	    ++idE;
-	  }
-	  else
-	  {
-	    errNum = WLZ_ERR_READ_INCOMPLETE;
-	    break;
-	  }
-        }
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	for(idN = 0; idN < 3; ++idN)
+	{
+	  nBuf2[idN] = (WlzCMeshNod2D *)
+		       AlcVectorItemGet(mesh.m2->res.nod.vec, eP[idN + 1] - 1);
+	}
+	(void )WlzCMeshNewElm2D(mesh.m2, nBuf2[0], nBuf2[2], nBuf2[1],
+				1, &errNum);
+	++idE;
       }
       if(errNum == WLZ_ERR_NONE)
       {
@@ -512,40 +483,27 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
       }
       while((errNum == WLZ_ERR_NONE) && (idE < nElm))
       {
-	if((str = WlzEffReadObjNodeEleRec(fP, cBuf, 256)) == NULL)
+	if((eP = WlzEffTokIntBatch(tok, eBuf, idE, nElm, 5, NULL)) == NULL)
 	{
 	  errNum = WLZ_ERR_READ_INCOMPLETE;
 	  break;
 	}
-	else if(*str != '#')
+	if((eP[1] <= 0) || (eP[1] > nNod) ||
+	   (eP[2] <= 0) || (eP[2] > nNod) ||
+	   (eP[3] <= 0) || (eP[3] > nNod) ||
+	   (eP[4] <= 0) || (eP[4] > nNod))
 	{
-	  if(sscanf(str, "%d %d %d %d %d",
-		    &idx, eBuf + 0, eBuf + 1, eBuf + 2, eBuf + 3) == 5)
-	  {
-	    if((eBuf[0] <= 0) || (eBuf[0] > nNod) ||
-	       (eBuf[1] <= 0) || (eBuf[1] > nNod) ||
-	       (eBuf[2] <= 0) || (eBuf[2] > nNod) ||
-	       (eBuf[3] <= 0) || (eBuf[3] > nNod))
-	    {
-	      errNum = WLZ_ERR_MEM_ALLOC;
-	      break;
-	    }
-	    for(idN = 0; idN < 4; ++idN)
-	    {
-	      nBuf3[idN] = (WlzCMeshNod3D *)
-			   AlcVectorItemGet(mesh.m3->res.nod.vec,
-			                    eBuf[idN] - 1);
-	    }
-	    (void )WlzCMeshNewElm3D(mesh.m3,
-				    nBuf3[0], nBuf3[1], nBuf3[3], nBuf3[2], 1, &errNum);
-	    ++idE;
-	  }
-	  else
-	  {
-	    errNum = WLZ_ERR_READ_INCOMPLETE;
-	    break;
-	  }
-        }
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	for(idN = 0; idN < 4; ++idN)
+	{
+	  nBuf3[idN] = (WlzCMeshNod3D *)
+		       AlcVectorItemGet(mesh.m3->res.nod.vec, eP[idN + 1] - 1);
+	}
+	(void )WlzCMeshNewElm3D(mesh.m3,
+				nBuf3[0], nBuf3[1], nBuf3[3], nBuf3[2], 1, &errNum);
+	++idE;
       }
       if(errNum == WLZ_ERR_NONE)
       {
@@ -556,6 +514,8 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
     }
   }
   /* Close element file. */
+  (void )WlzEffTokFree(tok);
+  AlcFree(eBuf);
   if(fP)
   {
     (void )fclose(fP);
@@ -578,30 +538,6 @@ WlzObject	*WlzEffReadObjNodeEle(const char *gvnFileName,
   return(obj);
 }
 
-/*!
-* \return	Start of string having skipped past possible white space
-* 		characters.
-* \ingroup	WlzExtFF
-* \brief	Gets the next record from a file.
-* \param	fP			Input file.
-* \param	buf			Buffer for input record.
-* \param	bufLen			Buffer length.
-*/
-static char	*WlzEffReadObjNodeEleRec(FILE *fP, char *buf, int bufLen)
-{
-  char		*str = NULL;
-
-  if((str = fgets(buf, bufLen, fP)) != NULL)
-  {
-    buf[bufLen - 1] = '\0';
-    while((*str != '\0') && isspace(*str))
-    {
-      ++str;
-    }
-  }
-  return(str);
-}
-
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF
@@ -47,10 +47,6 @@ static char _WlzExtFFObj_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 #include <WlzExtFF.h>
 
-static char			*WlzEffReadObjObjRec(
-				  FILE *fP, 
-				  char *buf,
-				  int bufLen);
 static WlzErrorNum		WlzEffWriteObjCM2Obj(
 				  FILE *fP,
 				  WlzObject *obj);
@@ -118,9 +114,6 @@ WlzObject	*WlzEffReadObjObj(FILE *fP, WlzErrorNum *dstErr)
   int		nF = 0,
 		nN = 0,
 		nV = 0;
-  char		*sav,
-  		*str,
-  		*tok;
   int		*iP;
   WlzDVertex3	*dP;
   WlzGMModel	*model = NULL;
@@ -128,6 +121,7 @@ WlzObject	*WlzEffReadObjObj(FILE *fP, WlzErrorNum *dstErr)
   AlcVector	*fVec = NULL,
   		*nVec = NULL,
   		*vVec = NULL;
+  WlzEffTok	*tok = NULL;
   WlzDomain	dom;
   WlzValues	val;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -146,58 +140,61 @@ WlzObject	*WlzEffReadObjObj(FILE *fP, WlzErrorNum *dstErr)
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
+  else
+  {
+    tok = WlzEffTokNew(fP, '#', &errNum);
+  }
+  /* Each record starts with a keyword, the remainder of a record is
+   * skipped once it has been parsed. */
   while((errNum == WLZ_ERR_NONE) &&
-        ((str = WlzEffReadObjObjRec(fP, cBuf, 256)) != NULL))
+        (WlzEffTokWord(tok, cBuf, 256) != NULL))
   {
-    if((tok = ALC_STRTOK_R(str, " \t", &sav)) != NULL)
+    if(strcmp(cBuf, "v") == 0)
     {
-      if(strcmp(tok, "v") == 0)
+      if((dP = (WlzDVertex3 *)AlcVectorExtendAndGet(vVec, nV++)) == NULL)
       {
-	if((dP = (WlzDVertex3 *)AlcVectorExtendAndGet(vVec, nV++)) == NULL)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	else if(((str = ALC_STRTOK_R(NULL, "\n", &sav)) == NULL) ||
-		(sscanf(str, "%lg %lg %lg",
-		        &(dP->vtX), &(dP->vtY), &(dP->vtZ)) != 3))
-	{
-	  errNum = WLZ_ERR_READ_INCOMPLETE;
-	}
+	errNum = WLZ_ERR_MEM_ALLOC;
       }
-      else if(strcmp(tok, "vn") == 0)
+      else if(WlzEffTokDoubles(tok, (double *)dP, 3) != WLZ_ERR_NONE)
       {
-	if((dP = (WlzDVertex3 *)AlcVectorExtendAndGet(nVec, nN++)) == NULL)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	else if(((str = ALC_STRTOK_R(NULL, "\n", &sav)) == NULL) ||
-		(sscanf(str, "%lg %lg %lg",
-		        &(dP->vtX), &(dP->vtY), &(dP->vtZ)) != 3))
-	{
-	  errNum = WLZ_ERR_READ_INCOMPLETE;
-	}
+	errNum = WLZ_ERR_READ_INCOMPLETE;
       }
-      else if(strcmp(tok, "f") == 0)
+    }
+    else if(strcmp(cBuf, "vn") == 0)
+    {
+      if((dP = (WlzDVertex3 *)AlcVectorExtendAndGet(nVec, nN++)) == NULL)
       {
-	if((iP = (int *)AlcVectorExtendAndGet(fVec, nF++)) == NULL)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	else if(((str = ALC_STRTOK_R(NULL, "\n", &sav)) == NULL) ||
-		(sscanf(str, "%d %d %d", iP + 0, iP + 1, iP + 2) != 3))
-	{
-	  errNum = WLZ_ERR_READ_INCOMPLETE;
-	}
-	else
-	{
-	  --iP[0];
-	  --iP[1];
-	  --iP[2];
-	}
+	errNum = WLZ_ERR_MEM_ALLOC;
       }
-      /* All other tokens are ignored. */
+      else if(WlzEffTokDoubles(tok, (double *)dP, 3) != WLZ_ERR_NONE)
+      {
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+    else if(strcmp(cBuf, "f") == 0)
+    {
+      if((iP = (int *)AlcVectorExtendAndGet(fVec, nF++)) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else if(WlzEffTokInts(tok, iP, 3) != WLZ_ERR_NONE)
+      {
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else
+      {
+	--iP[0];
+	--iP[1];
+	--iP[2];
+      }
+    }
+    /* All other tokens are ignored. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzEffTokSkipRec(tok);
     }
   }
+  (void )WlzEffTokFree(tok);
   if(errNum == WLZ_ERR_NONE)
   {
     if((nV < 3) || (nF < 1) || ((nN > 0) && (nN != nV)))
@@ -570,22 +567,3 @@ static WlzErrorNum WlzEffWriteObjCtrObj(FILE *fP, WlzObject *obj)
   WlzGMModelResIdxFree(resIdxTb);
   return(errNum);
 }
-
-/*!
-* \return	String with requested number of space seperated fields.
-* \ingroup	WlzExtFF
-* \brief	Gets the requeted number of fields from the file.
-*               
-* \param	fP			Input file.
-* \param	buf			Buffer for input record.
-* \param	bufLen			Buffer length.
-* \param	nFld			Number of fields required.
-*/
-static char	*WlzEffReadObjObjRec(FILE *fP, char *buf, int bufLen)
-{
-  char		*str;
-
-  str = fgets(buf, bufLen, fP);
-  buf[bufLen - 1] = '\0';
-  return(str);
-}
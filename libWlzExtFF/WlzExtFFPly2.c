@@ -45,11 +45,6 @@ static char _WlzExtFFPly2_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 #include <WlzExtFF.h>
 
-static char			*WlzEffReadObjPly2Rec(
-				  FILE *fP, 
-				  char *buf,
-				  int bufLen,
-				  int nFld);
 static WlzErrorNum		WlzEffWriteObjCM2Ply2(
 				  FILE *fP,
 				  WlzObject *obj);
@@ -79,14 +74,14 @@ WlzObject	*WlzEffReadObjPly2(FILE *fP, WlzErrorNum *dstErr)
 {
   int		nFce = 0,
 		nVtx = 0;
-  char		*str;
+  int		*eBuf = NULL;
   WlzGMModel	*model = NULL;
   WlzObject	*obj = NULL;
   WlzDVertex3	*vBuf = NULL;
+  WlzEffTok	*tok = NULL;
   WlzDomain	dom;
   WlzValues	val;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-  char		cBuf[256];
 
   dom.core = NULL;
   val.core = NULL;
@@ -95,18 +90,10 @@ WlzObject	*WlzEffReadObjPly2(FILE *fP, WlzErrorNum *dstErr)
   {
     errNum = WLZ_ERR_PARAM_NULL;
   }
-  else
-  {
-    if(((str = WlzEffReadObjPly2Rec(fP, cBuf, 256, 1)) == NULL) ||
-       (sscanf(str, "%d", &nVtx) != 1))
-    {
-      errNum = WLZ_ERR_READ_INCOMPLETE;
-    }
-  }
-  if(errNum == WLZ_ERR_NONE)
+  else if((tok = WlzEffTokNew(fP, 0, &errNum)) != NULL)
   {
-    if(((str = WlzEffReadObjPly2Rec(fP, cBuf, 256, 1)) == NULL) ||
-       (sscanf(str, "%d", &nFce) != 1))
+    if((WlzEffTokInts(tok, &nVtx, 1) != WLZ_ERR_NONE) ||
+       (WlzEffTokInts(tok, &nFce, 1) != WLZ_ERR_NONE))
     {
       errNum = WLZ_ERR_READ_INCOMPLETE;
     }
@@ -137,8 +124,10 @@ WlzObject	*WlzEffReadObjPly2(FILE *fP, WlzErrorNum *dstErr)
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Create a vertex buffer. */
-    if((vBuf = AlcMalloc(sizeof(WlzDVertex3) * nVtx)) == NULL)
+    /* Create vertex and face index buffers. */
+    if(((vBuf = AlcMalloc(sizeof(WlzDVertex3) * nVtx)) == NULL) ||
+       ((eBuf = (int *)
+                AlcMalloc(sizeof(int) * 4 * WLZEFF_TOK_BATCH)) == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
@@ -146,43 +135,33 @@ WlzObject	*WlzEffReadObjPly2(FILE *fP, WlzErrorNum *dstErr)
   /* Read the vertex positions into the buffer. */
   if(errNum == WLZ_ERR_NONE)
   {
-    int 	idN;
-    WlzDVertex3 *pos;
-
-    for(idN = 0; idN < nVtx; ++idN)
+    if(WlzEffTokDoubles(tok, (double *)vBuf, 3 * nVtx) != WLZ_ERR_NONE)
     {
-      pos = vBuf + idN;
-      if(((str = WlzEffReadObjPly2Rec(fP, cBuf, 256, 3)) == NULL) ||
-	 (sscanf(str, "%lg %lg %lg", &(pos->vtX), &(pos->vtY), &(pos->vtZ)) != 3))
-      {
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-	break;
-      }
+      errNum = WLZ_ERR_READ_INCOMPLETE;
     }
   }
   /* Read the vertex indicies and build the model. */
   if(errNum == WLZ_ERR_NONE)
   {
     int 	idE;
-    int		idx[3];
     WlzDVertex3	pos[3];
 
     for(idE = 0; idE < nFce; ++idE)
     {
-      int	ck;
+      int	*eP;
 
-      if(((str = WlzEffReadObjPly2Rec(fP, cBuf, 256, 4)) == NULL) ||
-	 (sscanf(str, "%d %d %d %d", &ck, idx + 0, idx + 1, idx + 2) != 4) ||
-	 (ck != 3) || (idx[0] < 0) || (idx[1] < 0) || (idx[2] < 0) ||
-	 (idx[0] >= nVtx) || (idx[1] >= nVtx) || (idx[2] >= nVtx))
+      /* Each face record is the vertex count (3) and the indices. */
+      if(((eP = WlzEffTokIntBatch(tok, eBuf, idE, nFce, 4, NULL)) == NULL) ||
+	 (eP[0] != 3) || (eP[1] < 0) || (eP[2] < 0) || (eP[3] < 0) ||
+	 (eP[1] >= nVtx) || (eP[2] >= nVtx) || (eP[3] >= nVtx))
       {
 	errNum = WLZ_ERR_READ_INCOMPLETE;
       }
       else
       {
-	pos[0] = *(vBuf + idx[0]);
-	pos[1] = *(vBuf + idx[1]);
-	pos[2] = *(vBuf + idx[2]);
+	pos[0] = *(vBuf + eP[1]);
+	pos[1] = *(vBuf + eP[2]);
+	pos[2] = *(vBuf + eP[3]);
 	errNum = WlzGMModelConstructSimplex3D(model, pos);
       }
       if(errNum != WLZ_ERR_NONE)
@@ -192,6 +171,8 @@ WlzObject	*WlzEffReadObjPly2(FILE *fP, WlzErrorNum *dstErr)
     }
   }
   AlcFree(vBuf);
+  AlcFree(eBuf);
+  (void )WlzEffTokFree(tok);
   /* Compute maximum edge length and then create the Woolz object. */
   if(errNum == WLZ_ERR_NONE)
   {
@@ -470,63 +451,3 @@ static WlzErrorNum WlzEffWriteObjCtrPly2(FILE *fP, WlzObject *obj)
   WlzGMModelResIdxFree(resIdxTb);
   return(errNum);
 }
-
-/*!
-* \return	String with requested number of space seperated fields.
-* \ingroup	WlzExtFF
-* \brief	Gets the requeted number of fields from the file.
-*               
-* \param	fP			Input file.
-* \param	buf			Buffer for input record.
-* \param	bufLen			Buffer length.
-* \param	nFld			Number of fields required.
-*/
-static char	*WlzEffReadObjPly2Rec(FILE *fP, char *buf, int bufLen,
-				      int nFld)
-{
-  int		c0,
-  		c1,
-		f;
-  char		*s,
-  		*str = NULL;
-  const char	space = ' ';
-
-  f = 0;
-  s = buf;
-  c0 = space;
-  while(1)
-  {
-    if(s - buf > bufLen - 2)
-    {
-      break;
-    }
-    c1 = fgetc(fP);
-    if(c1 == EOF)
-    {
-      break;
-    }
-    if(isspace(c1))
-    {
-      if(c0 != space)
-      {
-	if(++f >= nFld)
-	{
-	  str = buf;
-	  break;
-	}
-	else
-	{
-	  c1 = space;
-	  *s++ = space;
-	}
-      }
-    }
-    else
-    {
-      *s++ = c1;
-    }
-    c0 = c1;
-  }
-  *s = '\0';
-  return(str);
-}
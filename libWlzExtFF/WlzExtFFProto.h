@@ -280,16 +280,33 @@ extern WlzObject 		*WlzEffReadObjVtk(
 extern WlzErrorNum 		WlzEffWriteObjVtk(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum 		WlzEffWriteObjVtkDataType(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzEffVtkDataType dType);
 extern WlzErrorNum		WlzEffWritePointsVtk(
 				  FILE *fP,
 				  WlzObject *obj,
 				  int onlyDom);
+extern WlzErrorNum		WlzEffWritePointsVtkDataType(
+				  FILE *fP,
+				  WlzObject *obj,
+				  int onlyDom,
+				  WlzEffVtkDataType dType);
 extern WlzErrorNum		WlzEffWritePointsVtkScalarValues(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWritePointsVtkScalarValuesDataType(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzEffVtkDataType dType);
 extern WlzErrorNum		WlzEffWritePointsVtkFieldValues(
 				  FILE *fP, 
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWritePointsVtkFieldValuesDataType(
+				  FILE *fP, 
+				  WlzObject *obj,
+				  WlzEffVtkDataType dType);
 /* From WlzExtFFSlc.c */
 extern WlzObject 		*WlzEffReadObjSlc(
 				  FILE *fP,
@@ -341,6 +358,50 @@ extern WlzErrorNum		WlzEffWriteObjJpeg(
 				  WlzObject *obj,
 				  char	*params);
 
+/* From WlzExtFFTok.c */
+extern WlzEffTok		*WlzEffTokNew(
+				  FILE *fP,
+				  int cmt,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzEffTokFree(
+				  WlzEffTok *tok);
+extern char			*WlzEffTokRec(
+				  WlzEffTok *tok,
+				  char *buf,
+				  int bufLen);
+extern WlzErrorNum		WlzEffTokSkipRec(
+				  WlzEffTok *tok);
+extern char			*WlzEffTokWord(
+				  WlzEffTok *tok,
+				  char *buf,
+				  int bufLen);
+extern WlzErrorNum		WlzEffTokInts(
+				  WlzEffTok *tok,
+				  int *dst,
+				  size_t n);
+extern WlzErrorNum		WlzEffTokDoubles(
+				  WlzEffTok *tok,
+				  double *dst,
+				  size_t n);
+extern int			*WlzEffTokIntBatch(
+				  WlzEffTok *tok,
+				  int *buf,
+				  int idx,
+				  int n,
+				  int nFld,
+				  WlzErrorNum *dstErr);
+extern double			*WlzEffTokDblBatch(
+				  WlzEffTok *tok,
+				  double *buf,
+				  int idx,
+				  int n,
+				  int nFld,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzEffTokBytes(
+				  WlzEffTok *tok,
+				  void *dst,
+				  size_t n);
+
 /* From WlzExtFFTxt.c */
 extern WlzErrorNum		WlzEffWriteObjTxt(
 				  FILE *fP,
@@ -542,6 +542,13 @@ static WlzErrorNum WlzEffReadObjStackData2D(FILE *fP, WlzEffFormat fFmt,
 * \ingroup	WlzExtFF
 * \brief	Reads a 3D Woolz object from the given file(s) using the given
 * 		(2D) file format.
+*		The control file is read first to find the file of each
+*		plane, then the planes are read and decoded concurrently,
+*		each directly into its own plane of the volume. Only one
+*		plane is decoded by each thread at a time, so the number
+*		of threads bounds the memory used in addition to that
+*		of the volume. If any planes can not be read then the
+*		error is that of the first of them.
 * \param	gvnFileName		Given file name.
 * \param	fFmt			Given file format (must be a 2D file
 * 					format).
@@ -554,7 +561,8 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
 {
   int		tI0,
 		planeIdx,
-		planeOff;
+		planeOff,
+		nRec = 0;
   char		*tCP0,
   		*recTok,
   		*fNameStr = NULL,
@@ -562,10 +570,12 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
   		*fBodyStr = NULL,
   		*fExtStr = NULL,
 		*fCtrStr = NULL;
-  FILE		*fP = NULL,
-  		*fP2D = NULL;
+  char		**plnFileStr = NULL;
+  FILE		*fP = NULL;
   WlzIVertex2	imgSz2D;
-  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE,
+  		recErrNum = WLZ_ERR_NONE;
+  WlzErrorNum	*plnErrNum = NULL;
   WlzObject	*obj = NULL;
   unsigned char	***data = NULL;
   char		fRecord[WLZEFF_STACK_CTR_RECORDMAX];
@@ -615,13 +625,25 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    planeOff = 0;
+    if(((plnFileStr = (char **)
+    		      AlcCalloc(header.volSize.vtZ, sizeof(char *))) == NULL) ||
+       ((plnErrNum = (WlzErrorNum *)
+                     AlcCalloc(header.volSize.vtZ,
+		               sizeof(WlzErrorNum))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Find the file of each plane. An error in a record is only reported
+     * if all of the planes before it can be read. */
     planeIdx = header.volOrigin.vtZ;
-    while((planeOff < header.volSize.vtZ) && (errNum == WLZ_ERR_NONE))
+    while((nRec < header.volSize.vtZ) && (recErrNum == WLZ_ERR_NONE))
     {
       if(fgets(fRecord, WLZEFF_STACK_CTR_RECORDMAX, fP) == NULL)
       {
-	errNum = WLZ_ERR_READ_INCOMPLETE;
+	recErrNum = WLZ_ERR_READ_INCOMPLETE;
       }
       else
       {
@@ -635,33 +657,62 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
 	   (tI0 != planeIdx) ||
 	   ((recTok = strtok(NULL, " \t\n")) == NULL))
 	{
-	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	  recErrNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+	else if((*(plnFileStr + nRec) = (char *)
+		  AlcMalloc((strlen(fPathStr) + strlen(recTok) + 1) *
+			    sizeof(char))) == NULL)
+	{
+	  recErrNum = WLZ_ERR_MEM_ALLOC;
 	}
 	else
 	{
-	  sprintf(fNameStr, "%s%s", fPathStr, recTok);
-	  if((fP2D = fopen(fNameStr, "r")) == NULL)
-	  {
-	    errNum = WLZ_ERR_READ_EOF;
-	  }
-	  else
-	  {
-		    #ifdef _WIN32
-  if (fP2D != NULL){
+	  sprintf(*(plnFileStr + nRec), "%s%s", fPathStr, recTok);
+	  ++nRec;
+	  ++planeIdx;
+	}
+      }
+    }
+    /* Read and decode the planes. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(planeOff = 0; planeOff < nRec; ++planeOff)
+    {
+      FILE	*fP2D;
+      WlzIVertex2 plnSz2D;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      plnSz2D = imgSz2D;
+      if((fP2D = fopen(*(plnFileStr + planeOff), "r")) == NULL)
+      {
+	errNum2 = WLZ_ERR_READ_EOF;
+      }
+      else
+      {
+#ifdef _WIN32
 	if(_setmode(_fileno(fP2D), 0x8000) == -1)
 	{
-		errNum = WLZ_ERR_READ_EOF;
+	  errNum2 = WLZ_ERR_READ_EOF;
 	}
-  }
-  #endif
-	    errNum = WlzEffReadObjStackData2D(fP2D, fFmt, &imgSz2D,
-					      (data + planeOff));
-	    fclose(fP2D);
-	  }
+#endif
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  errNum2 = WlzEffReadObjStackData2D(fP2D, fFmt, &plnSz2D,
+					     (data + planeOff));
 	}
+	fclose(fP2D);
       }
-      ++planeOff;
-      ++planeIdx;
+      *(plnErrNum + planeOff) = errNum2;
+    }
+    for(planeOff = 0; (planeOff < nRec) && (errNum == WLZ_ERR_NONE);
+        ++planeOff)
+    {
+      errNum = *(plnErrNum + planeOff);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = recErrNum;
     }
   }
   if(errNum == WLZ_ERR_NONE)
@@ -716,6 +767,19 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
   {
     AlcFree(fCtrStr);
   }
+  if(plnFileStr)
+  {
+    for(planeOff = 0; planeOff < nRec; ++planeOff)
+    {
+      AlcFree(*(plnFileStr + planeOff));
+    }
+    AlcFree(plnFileStr);
+  }
+  AlcFree(plnErrNum);
+  if(fP)
+  {
+    (void )fclose(fP);
+  }
   if(dstErr)
   {
     *dstErr = errNum;
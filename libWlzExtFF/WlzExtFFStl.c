@@ -46,10 +46,6 @@ static char _WlzExtFFStl_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 #include <WlzExtFF.h>
 
-static char			*WlzEffReadObjStlRec(
-				  FILE *fP, 
-				  char *buf,
-				  int bufLen);
 static WlzErrorNum		WlzEffWriteObjCM2D5Stl(
 				  FILE *fP,
 				  WlzObject *obj);
@@ -77,9 +73,7 @@ WlzObject	*WlzEffReadObjStl(FILE *fP, WlzErrorNum *dstErr)
   		inSolid = 0,
   		inFacet = 0,
 		inLoop = 0;
-  char		*sav,
-  		*str,
-  		*tok;
+  WlzEffTok	*tok = NULL;
   WlzDVertex3	vBuf[3];
   WlzGMModel	*model = NULL;
   WlzObject	*obj = NULL;
@@ -169,113 +163,113 @@ WlzObject	*WlzEffReadObjStl(FILE *fP, WlzErrorNum *dstErr)
     else						 /* ASCII not binary */
     {
       /* Discard rest of the first line. */
-      (void )WlzEffReadObjStlRec(fP, buf, 256);
-      /* Read and parse ACSII records. */
+      if((tok = WlzEffTokNew(fP, 0, &errNum)) != NULL)
+      {
+        errNum = WlzEffTokSkipRec(tok);
+      }
+      /* Read and parse ACSII records, each starts with a keyword and
+       * the remainder of a record is skipped once it has been parsed. */
       inSolid = 1;
       while((errNum == WLZ_ERR_NONE) &&
-	    ((str = WlzEffReadObjStlRec(fP, buf, 256)) != NULL))
+	    (WlzEffTokWord(tok, buf, 256) != NULL))
       {
-	if((tok = ALC_STRTOK_R(str, " \t", &sav)) != NULL)
+	if(strncmp(buf, "solid", 5) == 0)
 	{
-	  if(strncmp(tok, "solid", 5) == 0)
+	  if(inSolid == 0)
 	  {
-	    if(inSolid == 0)
-	    {
-	      inSolid = 1;
-	    }
-	    else
-	    {
-	      errNum = WLZ_ERR_READ_INCOMPLETE;
-	    }
+	    inSolid = 1;
 	  }
-	  else if(strncmp(tok, "facet", 5) == 0)
+	  else
 	  {
-	    if((inSolid == 1) && (inFacet == 0))
-	    {
-	      inFacet = 1;
-	      /* Normal vector is ignored. */
-	    }
-	    else
-	    {
-	      errNum = WLZ_ERR_READ_INCOMPLETE;
-	    }
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
 	  }
-	  else if(strncmp(tok, "outer", 5) == 0)
+	}
+	else if(strncmp(buf, "facet", 5) == 0)
+	{
+	  if((inSolid == 1) && (inFacet == 0))
 	  {
-	    if(((tok = ALC_STRTOK_R(NULL, " \t", &sav)) == NULL) ||
-	       (strncmp(tok, "loop", 4) != 0) ||
-	       (inSolid == 0) || (inFacet == 0) || (inLoop != 0))
-	    {
-	      errNum = WLZ_ERR_READ_INCOMPLETE;
-	    }
-	    else
-	    {
-	      vCnt = 0;
-	      inLoop = 1;
-	    }
+	    inFacet = 1;
+	    /* Normal vector is ignored. */
 	  }
-	  else if(strncmp(tok, "vertex", 6) == 0)
+	  else
 	  {
-	    char *pTok[3];
-
-	    if((vCnt < 3) &&
-	       ((pTok[0] = ALC_STRTOK_R(NULL, " \t", &sav)) != NULL) &&
-	       ((pTok[1] = ALC_STRTOK_R(NULL, " \t", &sav)) != NULL) &&
-	       ((pTok[2] = ALC_STRTOK_R(NULL, " \t", &sav)) != NULL) &&
-	       (sscanf(pTok[0], "%lg", &(vBuf[vCnt].vtX)) == 1) &&
-	       (sscanf(pTok[1], "%lg", &(vBuf[vCnt].vtY)) == 1) &&
-	       (sscanf(pTok[2], "%lg", &(vBuf[vCnt].vtZ)) == 1))
-	    {
-	      ++vCnt;
-	    }
-	    else
-	    {
-	      errNum = WLZ_ERR_READ_INCOMPLETE;
-	    }
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
 	  }
-	  else if(strncmp(tok, "endloop", 7) == 0)
+	}
+	else if(strncmp(buf, "outer", 5) == 0)
+	{
+	  if((WlzEffTokWord(tok, buf, 256) == NULL) ||
+	     (strncmp(buf, "loop", 4) != 0) ||
+	     (inSolid == 0) || (inFacet == 0) || (inLoop != 0))
 	  {
-	    if(inLoop == 1)
-	    {
-	      inLoop = 0;
-	      if(vCnt == 3)
-	      {
-		errNum = WlzGMModelConstructSimplex3D(model, vBuf);
-	      }
-	      else
-	      {
-		errNum = WLZ_ERR_READ_INCOMPLETE;
-	      }
-	    }
-	    else
-	    {
-	      errNum = WLZ_ERR_READ_INCOMPLETE;
-	    }
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
 	  }
-	  else if(strncmp(tok, "endfacet", 8) == 0)
+	  else
 	  {
-	    if(inFacet == 1)
-	    {
-	      inFacet = 0;
-	    }
-	    else
-	    {
-	      errNum = WLZ_ERR_READ_INCOMPLETE;
-	    }
+	    vCnt = 0;
+	    inLoop = 1;
 	  }
-	  else if(strncmp(tok, "endsolid", 8) == 0)
+	}
+	else if(strncmp(buf, "vertex", 6) == 0)
+	{
+	  if((vCnt < 3) &&
+	     (WlzEffTokDoubles(tok, (double *)(vBuf + vCnt),
+			       3) == WLZ_ERR_NONE))
 	  {
-	    if(inSolid == 1)
+	    ++vCnt;
+	  }
+	  else
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+	else if(strncmp(buf, "endloop", 7) == 0)
+	{
+	  if(inLoop == 1)
+	  {
+	    inLoop = 0;
+	    if(vCnt == 3)
 	    {
-	      inSolid = 0;
+	      errNum = WlzGMModelConstructSimplex3D(model, vBuf);
 	    }
 	    else
 	    {
 	      errNum = WLZ_ERR_READ_INCOMPLETE;
 	    }
 	  }
+	  else
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+	else if(strncmp(buf, "endfacet", 8) == 0)
+	{
+	  if(inFacet == 1)
+	  {
+	    inFacet = 0;
+	  }
+	  else
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+	else if(strncmp(buf, "endsolid", 8) == 0)
+	{
+	  if(inSolid == 1)
+	  {
+	    inSolid = 0;
+	  }
+	  else
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzEffTokSkipRec(tok);
 	}
       }
+      (void )WlzEffTokFree(tok);
     }
   }
   /* Create the Woolz object. */
@@ -530,22 +524,3 @@ static WlzErrorNum WlzEffWriteObjCtrStl(FILE *fP, WlzObject *obj)
   }
   return(errNum);
 }
-
-/*!
-* \return	String with requested number of space seperated fields.
-* \ingroup	WlzExtFF
-* \brief	Gets the requeted number of fields from the file.
-*               
-* \param	fP			Input file.
-* \param	buf			Buffer for input record.
-* \param	bufLen			Buffer length.
-* \param	nFld			Number of fields required.
-*/
-static char	*WlzEffReadObjStlRec(FILE *fP, char *buf, int bufLen)
-{
-  char		*str;
-
-  str = fgets(buf, bufLen, fP);
-  buf[bufLen - 1] = '\0';
-  return(str);
-}
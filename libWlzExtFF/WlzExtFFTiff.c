@@ -42,6 +42,9 @@ static char _WlzExtFFTiff_c[] = "University of Edinburgh $Id$";
 #include <stdio.h>
 #include <string.h>
 #include <sys/types.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <Wlz.h>
 #include <WlzExtFF.h>
@@ -687,27 +690,86 @@ WlzObject	*WlzEffReadObjTiff(
 	TIFFGetField(tif, TIFFTAG_YRESOLUTION, &(domain.p->voxel_size[1]));
       }
 
-      /* now put in remaining planes */
+      /* now put in remaining planes, these are read concurrently with
+         each thread having its own TIFF handle (a TIFF handle holds the
+	 current directory so can not be shared) and planes are decoded
+	 directly into the plane domain and voxel value table */
       if( errNum == WLZ_ERR_NONE ){
-	for(p=1; p < numPlanes; p++){
-	  if((tmpObj = WlzExtFFReadTiffDirObj(tif, p, split, &errNum)) != NULL){
-	    domains[p] = WlzAssignDomain(tmpObj->domain, NULL);
-	    valuess[p] = WlzAssignValues(tmpObj->values, NULL);
-	    WlzFreeObj(tmpObj);
+	WlzErrorNum *plnErr;
+
+	if((plnErr = (WlzErrorNum *)
+		     AlcCalloc(numPlanes, sizeof(WlzErrorNum))) == NULL){
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else {
+#ifdef _OPENMP
+#pragma omp parallel private(p)
+#endif
+	  {
+	    TIFF	*thrTif;
+
+#ifdef _OPENMP
+	    thrTif = (omp_get_thread_num() == 0)?
+		     tif: TIFFOpen(tiffFileName, "rb");
+#else
+	    thrTif = tif;
+#endif
+	    /* static schedule so each handle steps through the directories
+	       in order */
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+	    for(p=1; p < numPlanes; p++){
+	      WlzObject	*plnObj = NULL;
+
+	      if( thrTif == NULL ){
+		plnErr[p] = WLZ_ERR_READ_EOF;
+	      }
+	      else if((plnObj = WlzExtFFReadTiffDirObj(thrTif, p, split,
+						       &(plnErr[p]))) != NULL){
+		domains[p] = WlzAssignDomain(plnObj->domain, NULL);
+		valuess[p] = WlzAssignValues(plnObj->values, NULL);
+		WlzFreeObj(plnObj);
+	      }
+	      else if( plnErr[p] == WLZ_ERR_NONE ){
+		plnErr[p] = WLZ_ERR_READ_INCOMPLETE;
+	      }
+	    }
+	    if( thrTif && (thrTif != tif) ){
+	      TIFFClose( thrTif );
+	    }
 	  }
-	  else {
-	    /* if it is an image-type error then it is probably some
-	       proprietory information. If there is only one plane
-	       then convert to 2D but still return incomplete read */
-	    if((errNum == WLZ_ERR_IMAGE_TYPE) && (p == 1)){
-	      tmpObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[0],
-				   valuess[0], NULL, NULL, NULL);
-	      WlzFreeObj(obj);
-	      obj = tmpObj;
+	  /* the first plane that failed (in plane order) determines the
+	     result, as when the planes were read in turn, so discard any
+	     planes read after it */
+	  for(p=1; p < numPlanes; p++){
+	    if( plnErr[p] != WLZ_ERR_NONE ){
+	      int	q;
+
+	      for(q=p+1; q < numPlanes; q++){
+		if( domains[q].core ){
+		  (void )WlzFreeDomain(domains[q]);
+		  domains[q].core = NULL;
+		}
+		if( valuess[q].core ){
+		  (void )WlzFreeValues(valuess[q]);
+		  valuess[q].core = NULL;
+		}
+	      }
+	      /* if it is an image-type error then it is probably some
+		 proprietory information. If there is only one plane
+		 then convert to 2D but still return incomplete read */
+	      if((plnErr[p] == WLZ_ERR_IMAGE_TYPE) && (p == 1)){
+		tmpObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[0],
+				     valuess[0], NULL, NULL, NULL);
+		WlzFreeObj(obj);
+		obj = tmpObj;
+	      }
+	      errNum = WLZ_ERR_READ_INCOMPLETE;
+	      break;
 	    }
-	    errNum = WLZ_ERR_READ_INCOMPLETE;
-	    break;
 	  }
+	  AlcFree(plnErr);
 	}
       }
 
@@ -0,0 +1,1111 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzExtFFTok_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlzExtFF/WlzExtFFTok.c
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A buffered tokenizer for the ASCII mesh and points file
+* 		formats. Large blocks are read from the file stream and
+* 		integers and doubles are parsed directly from the
+* 		buffer, avoiding the per field overhead of fscanf().
+* 		Long runs of numeric fields are parsed concurrently when
+* 		OpenMP is enabled. Blocks of binary data embedded in
+* 		otherwise ASCII files may also be read.
+* \ingroup	WlzExtFF
+* \todo         -
+* \bug          None known.
+*/
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <Wlz.h>
+#include <WlzExtFF.h>
+
+/*!
+* \def		WLZEFF_TOK_ISSPACE(C)
+* \ingroup	WlzExtFF
+* \brief	True if the given character is white space.
+*/
+#define WLZEFF_TOK_ISSPACE(C) \
+	(((C) == ' ') || ((C) == '\t') || ((C) == '\n') || \
+	 ((C) == '\r') || ((C) == '\f') || ((C) == '\v'))
+
+/*!
+* \def		WLZEFF_TOK_ISDELIM(C,M)
+* \ingroup	WlzExtFF
+* \brief	True if the given character ends a token, with M the
+* 		comment character.
+*/
+#define WLZEFF_TOK_ISDELIM(C,M) \
+	(WLZEFF_TOK_ISSPACE(C) || ((C) == '\0') || ((C) == (M)))
+
+static WlzErrorNum		WlzEffTokFill(
+				  WlzEffTok *tok);
+static WlzErrorNum		WlzEffTokSkip(
+				  WlzEffTok *tok);
+static WlzErrorNum		WlzEffTokRecCopy(
+				  WlzEffTok *tok,
+				  char *buf,
+				  int bufLen,
+				  int *dstFnd);
+static void			*WlzEffTokBatch(
+				  WlzEffTok *tok,
+				  void *buf,
+				  int idx,
+				  int n,
+				  int nFld,
+				  int dbl,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzEffTokNum(
+				  WlzEffTok *tok,
+				  void *dst,
+				  size_t n,
+				  int dbl);
+static size_t			WlzEffTokNumBlk(
+				  WlzEffTok *tok,
+				  void *dst,
+				  size_t n,
+				  int dbl,
+				  WlzErrorNum *dstErr);
+static const char		*WlzEffTokParseInt(
+				  const char *s,
+				  int cmt,
+				  int *dst);
+static const char		*WlzEffTokParseDbl(
+				  const char *s,
+				  int cmt,
+				  double *dst);
+
+/*!
+* \ingroup	WlzExtFF
+* \brief	Powers of ten which are exactly representable as doubles.
+*/
+static const double WlzEffTokPow10[23] =
+{
+  1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+  1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+  1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/*!
+* \return	New tokenizer or NULL on error.
+* \ingroup	WlzExtFF
+* \brief	Creates a new tokenizer which reads from the current
+* 		position of the given file stream. The tokenizer reads
+* 		ahead of the characters it has consumed, so the stream
+* 		should not be read directly until the tokenizer has
+* 		been freed using WlzEffTokFree().
+* \param	fP			Input file stream.
+* \param	cmt			Comment character, the remainder of
+* 					any record following this character
+* 					is skipped when reading words and
+* 					numbers. Zero if there are no
+* 					comments.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+WlzEffTok	*WlzEffTokNew(FILE *fP, int cmt, WlzErrorNum *dstErr)
+{
+  WlzEffTok	*tok = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((tok = (WlzEffTok *)AlcCalloc(1, sizeof(WlzEffTok))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((tok->buf = (char *)
+                      AlcMalloc(sizeof(char) * (WLZEFF_TOK_BUFSZ + 1))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    tok->fP = fP;
+    tok->cmt = cmt;
+    tok->buf[0] = '\0';
+    errNum = WlzEffTokFill(tok);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(tok)
+    {
+      AlcFree(tok->buf);
+      AlcFree(tok);
+      tok = NULL;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tok);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Frees the given tokenizer. Characters which have been read
+* 		into the tokenizer's buffer but not consumed are returned
+* 		to the file stream if it is seekable.
+* \param	tok			Given tokenizer.
+*/
+WlzErrorNum	WlzEffTokFree(WlzEffTok *tok)
+{
+  if(tok)
+  {
+    if(tok->pos < tok->cnt)
+    {
+      (void )fseek(tok->fP, -(long )(tok->cnt - tok->pos), SEEK_CUR);
+    }
+    AlcFree(tok->buf);
+    AlcFree(tok);
+  }
+  return(WLZ_ERR_NONE);
+}
+
+/*!
+* \return	The given buffer or NULL if at the end of the file or
+* 		on error.
+* \ingroup	WlzExtFF
+* \brief	Reads the remainder of the current record (line) into
+* 		the given buffer, much as fgets() but the record
+* 		separator is not copied and the whole record is always
+* 		consumed even if it is truncated in the buffer.
+* 		Comments are not skipped.
+* \param	tok			Given tokenizer.
+* \param	buf			Buffer for the record.
+* \param	bufLen			Length of the buffer.
+*/
+char		*WlzEffTokRec(WlzEffTok *tok, char *buf, int bufLen)
+{
+  int		fnd = 0;
+  char		*str = NULL;
+
+  if(tok && buf && (bufLen > 0))
+  {
+    if((WlzEffTokRecCopy(tok, buf, bufLen, &fnd) == WLZ_ERR_NONE) && fnd)
+    {
+      str = buf;
+    }
+  }
+  return(str);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Skips the remainder of the current record (line).
+* \param	tok			Given tokenizer.
+*/
+WlzErrorNum	WlzEffTokSkipRec(WlzEffTok *tok)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tok == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    errNum = WlzEffTokRecCopy(tok, NULL, 0, NULL);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	The given buffer or NULL if at the end of the file or
+* 		on error.
+* \ingroup	WlzExtFF
+* \brief	Reads the next white space delimited word, skipping any
+* 		comments. Words longer than the buffer are truncated but
+* 		always consumed.
+* \param	tok			Given tokenizer.
+* \param	buf			Buffer for the word.
+* \param	bufLen			Length of the buffer.
+*/
+char		*WlzEffTokWord(WlzEffTok *tok, char *buf, int bufLen)
+{
+  int		idx = 0,
+  		dlm = 0;
+  char		*str = NULL;
+
+  if(tok && buf && (bufLen > 0) &&
+     (WlzEffTokSkip(tok) == WLZ_ERR_NONE) && (tok->pos < tok->cnt))
+  {
+    str = buf;
+    do
+    {
+      char	*p,
+      		*e;
+
+      p = tok->buf + tok->pos;
+      e = tok->buf + tok->cnt;
+      while((p < e) && !WLZEFF_TOK_ISDELIM(*p, tok->cmt))
+      {
+        if(idx < bufLen - 1)
+	{
+	  buf[idx++] = *p;
+	}
+	++p;
+      }
+      dlm = p < e;
+      tok->pos = p - tok->buf;
+    } while(!dlm && (WlzEffTokFill(tok) == WLZ_ERR_NONE) &&
+            (tok->pos < tok->cnt));
+    buf[idx] = '\0';
+  }
+  return(str);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Reads the given number of white space delimited integers,
+* 		skipping any comments. Record boundaries are not
+* 		significant.
+* \param	tok			Given tokenizer.
+* \param	dst			Destination for the integers.
+* \param	n			Number of integers to read.
+*/
+WlzErrorNum	WlzEffTokInts(WlzEffTok *tok, int *dst, size_t n)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tok == NULL) || (dst == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    errNum = WlzEffTokNum(tok, dst, n, 0);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Reads the given number of white space delimited floating
+* 		point values, skipping any comments. Record boundaries
+* 		are not significant. The values are identical to those
+* 		which would be parsed by strtod().
+* \param	tok			Given tokenizer.
+* \param	dst			Destination for the values.
+* \param	n			Number of values to read.
+*/
+WlzErrorNum	WlzEffTokDoubles(WlzEffTok *tok, double *dst, size_t n)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tok == NULL) || (dst == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    errNum = WlzEffTokNum(tok, dst, n, 1);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Pointer to the integer fields of the given record or NULL
+* 		on error.
+* \ingroup	WlzExtFF
+* \brief	Gives the integer fields of a record from a sequence of
+* 		records which each have the same number of integer fields,
+* 		eg the elements of a mesh. The fields of up to
+* 		WLZEFF_TOK_BATCH records are read together when the given
+* 		record index is the first of a batch, so records must be
+* 		accessed in order.
+* \param	tok			Given tokenizer.
+* \param	buf			Buffer with space for
+* 					WLZEFF_TOK_BATCH * nFld integers.
+* \param	idx			Index of the record in the sequence.
+* \param	n			Number of records in the sequence.
+* \param	nFld			Number of fields per record.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+int		*WlzEffTokIntBatch(WlzEffTok *tok, int *buf, int idx, int n,
+				   int nFld, WlzErrorNum *dstErr)
+{
+  return((int *)WlzEffTokBatch(tok, buf, idx, n, nFld, 0, dstErr));
+}
+
+/*!
+* \return	Pointer to the fields of the given record or NULL on error.
+* \ingroup	WlzExtFF
+* \brief	Gives the fields of a record from a sequence of records
+* 		which each have the same number of floating point fields,
+* 		eg the nodes of a mesh, see WlzEffTokIntBatch().
+* \param	tok			Given tokenizer.
+* \param	buf			Buffer with space for
+* 					WLZEFF_TOK_BATCH * nFld doubles.
+* \param	idx			Index of the record in the sequence.
+* \param	n			Number of records in the sequence.
+* \param	nFld			Number of fields per record.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+double		*WlzEffTokDblBatch(WlzEffTok *tok, double *buf, int idx, int n,
+				   int nFld, WlzErrorNum *dstErr)
+{
+  return((double *)WlzEffTokBatch(tok, buf, idx, n, nFld, 1, dstErr));
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Reads the given number of bytes of unparsed (binary) data
+* 		from the current position, as fread() would. Large reads
+* 		are made directly from the file stream once the buffer
+* 		has been emptied.
+* \param	tok			Given tokenizer.
+* \param	dst			Destination for the bytes.
+* \param	n			Number of bytes to read.
+*/
+WlzErrorNum	WlzEffTokBytes(WlzEffTok *tok, void *dst, size_t n)
+{
+  char		*d;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tok == NULL) || (dst == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  d = (char *)dst;
+  while((errNum == WLZ_ERR_NONE) && (n > 0))
+  {
+    size_t	cpy = 0;
+
+    if(tok->cnt > tok->pos)
+    {
+      cpy = tok->cnt - tok->pos;
+      if(cpy > n)
+      {
+        cpy = n;
+      }
+      (void )memcpy(d, tok->buf + tok->pos, cpy);
+      tok->pos += cpy;
+    }
+    else if(tok->eof)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if(n >= WLZEFF_TOK_BUFSZ)
+    {
+      if((cpy = fread(d, sizeof(char), n, tok->fP)) < n)
+      {
+	tok->eof = 1;
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+    else
+    {
+      errNum = WlzEffTokFill(tok);
+    }
+    d += cpy;
+    n -= cpy;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Moves any unconsumed characters to the start of the
+* 		tokenizer's buffer and then fills the rest of the
+* 		buffer from the file stream.
+* \param	tok			Given tokenizer.
+*/
+static WlzErrorNum WlzEffTokFill(WlzEffTok *tok)
+{
+  size_t	got,
+  		req,
+  		rem;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tok->eof == 0)
+  {
+    rem = tok->cnt - tok->pos;
+    if((rem > 0) && (tok->pos > 0))
+    {
+      (void )memmove(tok->buf, tok->buf + tok->pos, rem);
+    }
+    tok->pos = 0;
+    req = WLZEFF_TOK_BUFSZ - rem;
+    got = fread(tok->buf + rem, sizeof(char), req, tok->fP);
+    tok->cnt = rem + got;
+    tok->buf[tok->cnt] = '\0';
+    if(got < req)
+    {
+      tok->eof = 1;
+      if(ferror(tok->fP))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Skips white space and comments so that the current position
+* 		is at the start of a token or the end of the file. On
+* 		return at least WLZEFF_TOK_MAXLEN characters follow the
+* 		current position unless the end of the file has been
+* 		read.
+* \param	tok			Given tokenizer.
+*/
+static WlzErrorNum WlzEffTokSkip(WlzEffTok *tok)
+{
+  int		fnd = 0,
+  		inCmt = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while(errNum == WLZ_ERR_NONE)
+  {
+    char	*p,
+    		*e;
+
+    p = tok->buf + tok->pos;
+    e = tok->buf + tok->cnt;
+    while(p < e)
+    {
+      if(inCmt)
+      {
+        inCmt = *p != '\n';
+      }
+      else if(tok->cmt && (*p == tok->cmt))
+      {
+        inCmt = 1;
+      }
+      else if(!WLZEFF_TOK_ISSPACE(*p))
+      {
+        fnd = 1;
+	break;
+      }
+      ++p;
+    }
+    tok->pos = p - tok->buf;
+    if(fnd || tok->eof)
+    {
+      break;
+    }
+    errNum = WlzEffTokFill(tok);
+  }
+  if((errNum == WLZ_ERR_NONE) && (tok->eof == 0) &&
+     (tok->cnt - tok->pos < WLZEFF_TOK_MAXLEN))
+  {
+    errNum = WlzEffTokFill(tok);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Consumes the remainder of the current record, copying it
+* 		to the given buffer if the buffer is not NULL.
+* \param	tok			Given tokenizer.
+* \param	buf			Buffer for the record, may be NULL.
+* \param	bufLen			Length of the buffer.
+* \param	dstFnd			Destination pointer set non-zero if
+* 					any characters were consumed, may
+* 					be NULL.
+*/
+static WlzErrorNum WlzEffTokRecCopy(WlzEffTok *tok, char *buf, int bufLen,
+				    int *dstFnd)
+{
+  int		eol = 0,
+  		fnd = 0,
+		idx = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while((errNum == WLZ_ERR_NONE) && (eol == 0))
+  {
+    if(tok->pos >= tok->cnt)
+    {
+      if(tok->eof)
+      {
+        break;
+      }
+      errNum = WlzEffTokFill(tok);
+    }
+    else
+    {
+      size_t	len;
+      char	*p,
+      		*q;
+
+      p = tok->buf + tok->pos;
+      len = tok->cnt - tok->pos;
+      if((q = (char *)memchr(p, '\n', len)) != NULL)
+      {
+        len = q - p;
+	eol = 1;
+      }
+      if(buf)
+      {
+        int	cpy;
+
+	cpy = bufLen - 1 - idx;
+	if((size_t )cpy > len)
+	{
+	  cpy = (int )len;
+	}
+	(void )memcpy(buf + idx, p, cpy);
+	idx += cpy;
+      }
+      tok->pos += len + eol;
+      fnd = 1;
+    }
+  }
+  if(buf)
+  {
+    buf[idx] = '\0';
+  }
+  if(dstFnd)
+  {
+    *dstFnd = fnd;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Pointer to the fields of the given record or NULL on error.
+* \ingroup	WlzExtFF
+* \brief	Gives the integer or double fields of a record from a
+* 		sequence of records, see WlzEffTokIntBatch().
+* \param	tok			Given tokenizer.
+* \param	buf			Buffer with space for
+* 					WLZEFF_TOK_BATCH * nFld values.
+* \param	idx			Index of the record in the sequence.
+* \param	n			Number of records in the sequence.
+* \param	nFld			Number of fields per record.
+* \param	dbl			Values are doubles if non-zero,
+* 					otherwise integers.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+static void	*WlzEffTokBatch(WlzEffTok *tok, void *buf, int idx, int n,
+				int nFld, int dbl, WlzErrorNum *dstErr)
+{
+  int		idB;
+  void		*rec = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tok == NULL) || (buf == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((idx < 0) || (idx >= n) || (nFld < 1))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    idB = idx % WLZEFF_TOK_BATCH;
+    if(idB == 0)
+    {
+      int	nB;
+
+      nB = n - idx;
+      if(nB > WLZEFF_TOK_BATCH)
+      {
+        nB = WLZEFF_TOK_BATCH;
+      }
+      errNum = WlzEffTokNum(tok, buf, (size_t )nB * nFld, dbl);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rec = (dbl)? (void *)((double *)buf + (idB * nFld)):
+                   (void *)((int *)buf + (idB * nFld));
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rec);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Reads the given number of integers or doubles.
+* \param	tok			Given tokenizer.
+* \param	dst			Destination for the values.
+* \param	n			Number of values to read.
+* \param	dbl			Values are doubles if non-zero,
+* 					otherwise integers.
+*/
+static WlzErrorNum WlzEffTokNum(WlzEffTok *tok, void *dst, size_t n, int dbl)
+{
+  size_t	idx = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while((errNum == WLZ_ERR_NONE) && (idx < n))
+  {
+    size_t	got = 0;
+    void	*d;
+
+    d = (dbl)? (void *)((double *)dst + idx): (void *)((int *)dst + idx);
+    if(((errNum = WlzEffTokSkip(tok)) == WLZ_ERR_NONE) &&
+       (tok->pos >= tok->cnt))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      got = WlzEffTokNumBlk(tok, d, n - idx, dbl, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (got == 0))
+    {
+      const char *s,
+      		 *e;
+
+      s = tok->buf + tok->pos;
+      e = (dbl)? WlzEffTokParseDbl(s, tok->cmt, (double *)d):
+                 WlzEffTokParseInt(s, tok->cmt, (int *)d);
+      /* A token which reaches the end of a buffer that is not at the end
+       * of the file is longer than WLZEFF_TOK_MAXLEN. */
+      if((e == NULL) ||
+         ((e == tok->buf + tok->cnt) && (tok->eof == 0)))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else
+      {
+        tok->pos = e - tok->buf;
+	got = 1;
+      }
+    }
+    idx += got;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of values read.
+* \ingroup	WlzExtFF
+* \brief	Reads up to the given number of integers or doubles from
+* 		the complete tokens that are in the buffer and preceed
+* 		any comment. When OpenMP is enabled and there are at
+* 		least WLZEFF_TOK_PARMIN such characters they are split
+* 		into chunks at white space, the tokens in each chunk are
+* 		counted concurrently, giving the offset of each chunk's
+* 		values, and then the chunks are parsed concurrently.
+* 		The current position must be at the start of a token.
+* \param	tok			Given tokenizer.
+* \param	dst			Destination for the values.
+* \param	n			Maximum number of values to read.
+* \param	dbl			Values are doubles if non-zero,
+* 					otherwise integers.
+* \param	dstErr			Destination error pointer.
+*/
+static size_t	WlzEffTokNumBlk(WlzEffTok *tok, void *dst, size_t n, int dbl,
+				WlzErrorNum *dstErr)
+{
+  int		nThr = 1;
+  size_t	got = 0;
+  char		*s,
+  		*e;
+
+  s = tok->buf + tok->pos;
+  e = tok->buf + tok->cnt;
+  /* Avoid scanning much more of the buffer than is needed. */
+  if((size_t )(e - s) / WLZEFF_TOK_PARTOK > n)
+  {
+    e = s + n * WLZEFF_TOK_PARTOK;
+  }
+  if(tok->cmt)
+  {
+    char	*c;
+
+    if((c = (char *)memchr(s, tok->cmt, e - s)) != NULL)
+    {
+      e = c;
+    }
+  }
+  /* Back off to white space unless at a comment or the end of the file
+   * so that no token is split. */
+  if(((e != tok->buf + tok->cnt) || (tok->eof == 0)) &&
+     ((tok->cmt == 0) || (*e != tok->cmt)))
+  {
+    while((e > s) && !WLZEFF_TOK_ISSPACE(*e))
+    {
+      --e;
+    }
+  }
+#ifdef _OPENMP
+  if(e - s >= WLZEFF_TOK_PARMIN)
+  {
+    nThr = omp_get_max_threads();
+  }
+#endif
+  if(nThr < 2)
+  {
+    const char	*p;
+
+    p = s;
+    while(got < n)
+    {
+      while((p < e) && WLZEFF_TOK_ISSPACE(*p))
+      {
+        ++p;
+      }
+      if(p >= e)
+      {
+        break;
+      }
+      p = (dbl)? WlzEffTokParseDbl(p, tok->cmt, (double *)dst + got):
+		 WlzEffTokParseInt(p, tok->cmt, (int *)dst + got);
+      if(p == NULL)
+      {
+	*dstErr = WLZ_ERR_READ_INCOMPLETE;
+	break;
+      }
+      ++got;
+    }
+    if(p)
+    {
+      tok->pos = p - tok->buf;
+    }
+  }
+#ifdef _OPENMP
+  else
+  {
+    int		idC,
+		nChk;
+    int		bad[WLZEFF_TOK_PARCHK];
+    size_t	off[WLZEFF_TOK_PARCHK + 1];
+    const char	*stp[WLZEFF_TOK_PARCHK];
+    char	*bnd[WLZEFF_TOK_PARCHK + 1];
+
+    nChk = nThr * 4;
+    if(nChk > WLZEFF_TOK_PARCHK)
+    {
+      nChk = WLZEFF_TOK_PARCHK;
+    }
+    bnd[0] = s;
+    for(idC = 1; idC < nChk; ++idC)
+    {
+      char	*b;
+
+      b = s + (e - s) * idC / nChk;
+      if(b < bnd[idC - 1])
+      {
+        b = bnd[idC - 1];
+      }
+      while((b < e) && !WLZEFF_TOK_ISSPACE(*b))
+      {
+        ++b;
+      }
+      bnd[idC] = b;
+    }
+    bnd[nChk] = e;
+    /* Count the tokens in each chunk. */
+#pragma omp parallel for num_threads(nThr)
+    for(idC = 0; idC < nChk; ++idC)
+    {
+      size_t	c = 0;
+      char	*p;
+
+      for(p = bnd[idC]; p < bnd[idC + 1]; ++p)
+      {
+        if(!WLZEFF_TOK_ISSPACE(*p) &&
+	   ((p == bnd[idC]) || WLZEFF_TOK_ISSPACE(*(p - 1))))
+	{
+	  ++c;
+	}
+      }
+      off[idC + 1] = c;
+    }
+    off[0] = 0;
+    for(idC = 0; idC < nChk; ++idC)
+    {
+      off[idC + 1] += off[idC];
+    }
+    got = (off[nChk] < n)? off[nChk]: n;
+    /* Parse the tokens that are needed in each chunk. */
+#pragma omp parallel for num_threads(nThr)
+    for(idC = 0; idC < nChk; ++idC)
+    {
+      size_t	idx;
+      const char *p;
+
+      p = bnd[idC];
+      bad[idC] = 0;
+      for(idx = off[idC]; (idx < got) && (idx < off[idC + 1]); ++idx)
+      {
+        while(WLZEFF_TOK_ISSPACE(*p))
+	{
+	  ++p;
+	}
+        p = (dbl)? WlzEffTokParseDbl(p, tok->cmt, (double *)dst + idx):
+	           WlzEffTokParseInt(p, tok->cmt, (int *)dst + idx);
+        if(p == NULL)
+	{
+	  bad[idC] = 1;
+	  break;
+	}
+      }
+      stp[idC] = p;
+    }
+    for(idC = 0; idC < nChk; ++idC)
+    {
+      if(off[idC] < got)
+      {
+        if(bad[idC])
+	{
+	  *dstErr = WLZ_ERR_READ_INCOMPLETE;
+	  break;
+	}
+	tok->pos = stp[idC] - tok->buf;
+      }
+    }
+  }
+#endif
+  return(got);
+}
+
+/*!
+* \return	Pointer to the character following the integer or NULL
+* 		if the token is not a valid integer.
+* \ingroup	WlzExtFF
+* \brief	Parses a decimal integer token, which must be followed
+* 		by white space, a comment character or a nul.
+* \param	s			Start of the token.
+* \param	cmt			Comment character.
+* \param	dst			Destination for the integer.
+*/
+static const char *WlzEffTokParseInt(const char *s, int cmt, int *dst)
+{
+  int		d,
+  		v = 0,
+		neg = 0;
+  const char	*s0;
+
+  if(*s == '-')
+  {
+    neg = 1;
+    ++s;
+  }
+  else if(*s == '+')
+  {
+    ++s;
+  }
+  s0 = s;
+  while((*s >= '0') && (*s <= '9'))
+  {
+    d = *s - '0';
+    if(v > (INT_MAX - d) / 10)
+    {
+      return(NULL);
+    }
+    v = (v * 10) + d;
+    ++s;
+  }
+  if((s == s0) || !WLZEFF_TOK_ISDELIM(*s, cmt))
+  {
+    s = NULL;
+  }
+  else
+  {
+    *dst = (neg)? -v: v;
+  }
+  return(s);
+}
+
+/*!
+* \return	Pointer to the character following the value or NULL
+* 		if the token is not a valid floating point value.
+* \ingroup	WlzExtFF
+* \brief	Parses a floating point token, which must be followed by
+* 		white space, a comment character or a nul. Values with
+* 		no more than 15 significant digits and a decimal
+* 		exponent within +/-22 are computed from the exactly
+* 		represented significand and power of ten using a single
+* 		(so correctly rounded) multiply or divide. All other
+* 		values are parsed by strtod().
+* \param	s			Start of the token.
+* \param	cmt			Comment character.
+* \param	dst			Destination for the value.
+*/
+static const char *WlzEffTokParseDbl(const char *s, int cmt, double *dst)
+{
+  int		exp10 = 0,
+		nDig = 0,
+		nSig = 0,
+		neg = 0,
+		slow = 0;
+  double	v = 0.0;
+  const char	*s0;
+
+  s0 = s;
+  if(*s == '-')
+  {
+    neg = 1;
+    ++s;
+  }
+  else if(*s == '+')
+  {
+    ++s;
+  }
+  while((*s >= '0') && (*s <= '9'))
+  {
+    ++nDig;
+    if((nSig > 0) || (*s != '0'))
+    {
+      if(nSig++ < 15)
+      {
+        v = (v * 10.0) + (*s - '0');
+      }
+      else
+      {
+        slow = 1;
+      }
+    }
+    ++s;
+  }
+  if(*s == '.')
+  {
+    ++s;
+    while((*s >= '0') && (*s <= '9'))
+    {
+      ++nDig;
+      if((nSig > 0) || (*s != '0'))
+      {
+	if(nSig++ < 15)
+	{
+	  v = (v * 10.0) + (*s - '0');
+	}
+	else
+	{
+	  slow = 1;
+	}
+      }
+      --exp10;
+      ++s;
+    }
+  }
+  if(nDig == 0)
+  {
+    slow = 1;
+  }
+  else if((*s == 'e') || (*s == 'E'))
+  {
+    int		eDig = 0,
+    		eNeg = 0,
+    		eVal = 0;
+
+    ++s;
+    if(*s == '-')
+    {
+      eNeg = 1;
+      ++s;
+    }
+    else if(*s == '+')
+    {
+      ++s;
+    }
+    while((*s >= '0') && (*s <= '9'))
+    {
+      if(eVal < 10000)
+      {
+        eVal = (eVal * 10) + (*s - '0');
+      }
+      ++eDig;
+      ++s;
+    }
+    if(eDig == 0)
+    {
+      slow = 1;
+    }
+    exp10 += (eNeg)? -eVal: eVal;
+  }
+  if(!WLZEFF_TOK_ISDELIM(*s, cmt))
+  {
+    slow = 1;
+  }
+  if(slow == 0)
+  {
+    if(v != 0.0)
+    {
+      if((exp10 < -22) || (exp10 > 22))
+      {
+        slow = 1;
+      }
+      else if(exp10 < 0)
+      {
+	v /= WlzEffTokPow10[-exp10];
+      }
+      else
+      {
+	v *= WlzEffTokPow10[exp10];
+      }
+    }
+    if(neg)
+    {
+      v = -v;
+    }
+  }
+  if(slow)
+  {
+    char	*e;
+
+    v = strtod(s0, &e);
+    s = e;
+    if((s == s0) || !WLZEFF_TOK_ISDELIM(*s, cmt))
+    {
+      s = NULL;
+    }
+  }
+  if(s)
+  {
+    *dst = v;
+  }
+  return(s);
+}
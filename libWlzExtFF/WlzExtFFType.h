@@ -400,6 +400,14 @@ typedef struct _WlzEffVffHeader
 #define	WLZEFF_VTK_VERSION_MAJOR	(1)
 #define	WLZEFF_VTK_VERSION_MINOR	(0)
 
+/*!
+* \def		WLZEFF_VTK_BINBLKSZ
+* \ingroup	WlzExtFF
+* \brief	Size (bytes) of the blocks in which binary VTK arrays
+* 		are encoded and written.
+*/
+#define WLZEFF_VTK_BINBLKSZ		(1<<20)
+
 typedef enum _WlzEffVtkDataType
 {
   WLZEFF_VTK_DATATYPE_ASCII,
@@ -951,6 +959,81 @@ typedef struct _WlzEffAnlDsr
   struct _WlzEffAnlDataHistory	hist;	/*!< 200 bytes. */
 } WlzEffAnlDsr;
 
+/* Buffered ASCII tokenizer used by the text mesh and points readers. */
+
+/*!
+* \def		WLZEFF_TOK_BUFSZ
+* \ingroup	WlzExtFF
+* \brief	Size of the block read into a tokenizer's buffer.
+*/
+#define WLZEFF_TOK_BUFSZ		(1<<22)
+
+/*!
+* \def		WLZEFF_TOK_MAXLEN
+* \ingroup	WlzExtFF
+* \brief	Maximum length of a numeric token, the buffer is
+*		refilled so that at least this many characters follow
+*		the current position unless at the end of the file.
+*/
+#define WLZEFF_TOK_MAXLEN		(256)
+
+/*!
+* \def		WLZEFF_TOK_PARMIN
+* \ingroup	WlzExtFF
+* \brief	Minimum number of buffered characters for which numeric
+*		tokens are parsed concurrently.
+*/
+#define WLZEFF_TOK_PARMIN		(1<<16)
+
+/*!
+* \def		WLZEFF_TOK_PARTOK
+* \ingroup	WlzExtFF
+* \brief	Number of characters per numeric token assumed when
+*		limiting the characters that are scanned for a given
+*		number of tokens.
+*/
+#define WLZEFF_TOK_PARTOK		(32)
+
+/*!
+* \def		WLZEFF_TOK_PARCHK
+* \ingroup	WlzExtFF
+* \brief	Maximum number of chunks into which buffered characters
+*		are split for concurrent parsing.
+*/
+#define WLZEFF_TOK_PARCHK		(256)
+
+/*!
+* \def		WLZEFF_TOK_BATCH
+* \ingroup	WlzExtFF
+* \brief	Number of records (eg mesh elements) for which the
+*		numeric fields are read together.
+*/
+#define WLZEFF_TOK_BATCH		(1<<16)
+
+/*!
+* \struct	_WlzEffTok
+* \ingroup	WlzExtFF
+* \brief	Buffered tokenizer for ASCII files. Large blocks are read
+*		from the file stream into the buffer which is always
+*		nul terminated.
+*		Typedef: ::WlzEffTok.
+*/
+typedef struct _WlzEffTok
+{
+  FILE		*fP;			/*!< Input file stream. */
+  int		cmt;			/*!< Comment character, the remainder
+  					     of a record following this is
+					     ignored, zero if no comments. */
+  int		eof;			/*!< Non-zero once the end of file
+  					     has been read into the buffer. */
+  size_t	pos;			/*!< Current position in the
+  					     buffer. */
+  size_t	cnt;			/*!< Number of characters in the
+  					     buffer. */
+  char		*buf;			/*!< Buffer of WLZEFF_TOK_BUFSZ + 1
+  					     characters. */
+} WlzEffTok;
+
 #endif /* WLZ_EXT_BIND */
 
 #ifndef WLZ_EXT_BIND
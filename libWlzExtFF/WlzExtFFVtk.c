@@ -51,19 +51,24 @@ static WlzErrorNum 		WlzEffWriteImgVtk(
 				  WlzObject *obj);
 static WlzErrorNum 		WlzEffWriteCtrVtk(
 				  FILE *fP,
-				  WlzContour *ctr);
+				  WlzContour *ctr,
+				  WlzEffVtkDataType dType);
 static WlzErrorNum 		WlzEffWriteGMModelVtk(
 				  FILE *fP,
-				  WlzGMModel *model);
+				  WlzGMModel *model,
+				  WlzEffVtkDataType dType);
 static WlzErrorNum 		WlzEffWriteCMesh2DVtk(
 				  FILE *fP,
-				  WlzCMesh2D *mesh);
+				  WlzCMesh2D *mesh,
+				  WlzEffVtkDataType dType);
 static WlzErrorNum 		WlzEffWriteCMesh2D5Vtk(
 				  FILE *fP,
-				  WlzCMesh2D5 *mesh);
+				  WlzCMesh2D5 *mesh,
+				  WlzEffVtkDataType dType);
 static WlzErrorNum 		WlzEffWriteCMesh3DVtk(
 				  FILE *fP,
-				  WlzCMesh3D *mesh);
+				  WlzCMesh3D *mesh,
+				  WlzEffVtkDataType dType);
 static WlzErrorNum		WlzEffHeadReadVtk(
 				  WlzEffVtkHeader *header,
 				  FILE *fP);
@@ -79,6 +84,45 @@ static WlzObject		*WlzEffReadImgVtk(
 				  FILE *fP,
 				  WlzEffVtkHeader *header,
 				  WlzErrorNum *dstErr);
+static void			WlzEffVtkBinSwap(
+				  void *buf,
+				  size_t n,
+				  size_t sz);
+static WlzErrorNum		WlzEffVtkBinPut(
+				  FILE *fP,
+				  WlzUByte *blk,
+				  size_t *cnt,
+				  const void *val,
+				  size_t n,
+				  size_t sz);
+static WlzErrorNum		WlzEffVtkBinPutVtx(
+				  FILE *fP,
+				  WlzUByte *blk,
+				  size_t *cnt,
+				  WlzDVertex3 vtx);
+static WlzErrorNum		WlzEffVtkBinEnd(
+				  FILE *fP,
+				  WlzUByte *blk,
+				  size_t *cnt);
+static WlzErrorNum		WlzEffVtkPutPointValues(
+				  FILE *fP,
+				  WlzUByte *blk,
+				  size_t *cnt,
+				  WlzPointValues *pvl,
+				  size_t n);
+static WlzErrorNum		WlzEffVtkReadDoubles(
+				  WlzEffTok *tok,
+				  WlzEffVtkDataType dType,
+				  double *dst,
+				  size_t n,
+				  size_t sz);
+static int			*WlzEffVtkIntBatch(
+				  WlzEffTok *tok,
+				  WlzEffVtkDataType dType,
+				  int *buf,
+				  int idx,
+				  int n,
+				  int nFld);
 
 /*!
 * \return	Object read from file.
@@ -137,11 +181,32 @@ WlzObject	*WlzEffReadObjVtk(FILE *fP, WlzErrorNum *dstErr)
 * \return	Woolz error number.
 * \ingroup	WlzExtFF
 * \brief	Writes the given Woolz object to the given stream using the
-* 		Visualization Toolkit file format.
+* 		Visualization Toolkit file format with ASCII data, see
+* 		WlzEffWriteObjVtkDataType().
 * \param	fP			Output file stream.
 * \param	obj			Given woolz object.
 */
 WlzErrorNum	WlzEffWriteObjVtk(FILE *fP, WlzObject *obj)
+{
+  return(WlzEffWriteObjVtkDataType(fP, obj, WLZEFF_VTK_DATATYPE_ASCII));
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given Woolz object to the given stream using the
+* 		Visualization Toolkit file format with either ASCII or
+* 		binary data. Binary data are written in big-endian byte
+* 		order, as required by the VTK file format, with the arrays
+* 		of meshes, models and points written in blocks of
+* 		WLZEFF_VTK_BINBLKSZ bytes. 3D domain objects with values
+* 		are always written with binary data.
+* \param	fP			Output file stream.
+* \param	obj			Given woolz object.
+* \param	dType			VTK data type, ASCII or binary.
+*/
+WlzErrorNum	WlzEffWriteObjVtkDataType(FILE *fP, WlzObject *obj,
+					  WlzEffVtkDataType dType)
 {
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -165,19 +230,19 @@ WlzErrorNum	WlzEffWriteObjVtk(FILE *fP, WlzObject *obj)
         errNum = WlzEffWriteImgVtk(fP, obj);
 	break;
       case WLZ_CONTOUR:
-        errNum = WlzEffWriteCtrVtk(fP, obj->domain.ctr);
+        errNum = WlzEffWriteCtrVtk(fP, obj->domain.ctr, dType);
 	break;
       case WLZ_CMESH_2D:
-        errNum = WlzEffWriteCMesh2DVtk(fP, obj->domain.cm2);
+        errNum = WlzEffWriteCMesh2DVtk(fP, obj->domain.cm2, dType);
         break;
       case WLZ_CMESH_2D5:
-        errNum = WlzEffWriteCMesh2D5Vtk(fP, obj->domain.cm2d5);
+        errNum = WlzEffWriteCMesh2D5Vtk(fP, obj->domain.cm2d5, dType);
         break;
       case WLZ_CMESH_3D:
-        errNum = WlzEffWriteCMesh3DVtk(fP, obj->domain.cm3);
+        errNum = WlzEffWriteCMesh3DVtk(fP, obj->domain.cm3, dType);
         break;
       case WLZ_POINTS:
-        errNum = WlzEffWritePointsVtk(fP, obj, 0);
+        errNum = WlzEffWritePointsVtkDataType(fP, obj, 0, dType);
 	break;
       default:
         errNum = WLZ_ERR_OBJECT_TYPE;
@@ -277,8 +342,10 @@ static WlzErrorNum WlzEffWriteImgVtk(FILE *fP, WlzObject *obj)
 *		format.
 * \param	fP			Output file stream.
 * \param	ctr			Given woolz contour.
+* \param	dType			VTK data type, ASCII or binary.
 */
-static WlzErrorNum WlzEffWriteCtrVtk(FILE *fP, WlzContour *ctr)
+static WlzErrorNum WlzEffWriteCtrVtk(FILE *fP, WlzContour *ctr,
+				     WlzEffVtkDataType dType)
 {
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -292,7 +359,7 @@ static WlzErrorNum WlzEffWriteCtrVtk(FILE *fP, WlzContour *ctr)
   }
   else
   {
-    errNum = WlzEffWriteGMModelVtk(fP, ctr->model);
+    errNum = WlzEffWriteGMModelVtk(fP, ctr->model, dType);
   }
   return(errNum);
 }
@@ -305,17 +372,21 @@ static WlzErrorNum WlzEffWriteCtrVtk(FILE *fP, WlzContour *ctr)
 *		format.
 * \param	fP			Output file stream.
 * \param	model			Given gemetric model.
+* \param	dType			VTK data type, ASCII or binary.
 */
-static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
+static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model,
+				         WlzEffVtkDataType dType)
 {
 
   int		idI,
   		iCnt;
-  int		bufI[3];
+  int		bufI[4];
+  size_t	bCnt = 0;
   AlcVector	*vec;
   WlzGMEdgeT	*tET;
   WlzGMElemP	eP;
   WlzGMResIdxTb	*resIdxTb = NULL;
+  WlzUByte	*blk = NULL;
   WlzDVertex3	vtx,
   		nrm;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -355,15 +426,23 @@ static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
       errNum = WLZ_ERR_DOMAIN_DATA;
     }
   }
+  if((errNum == WLZ_ERR_NONE) && (dType == WLZEFF_VTK_DATATYPE_BINARY))
+  {
+    if((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     /* Output the file header. */
     (void )fprintf(fP,
     		   "# vtk DataFile Version 1.0\n"
     		   "WlzGeoModel test output\n"
-		   "ASCII\n"
+		   "%s\n"
 		   "DATASET POLYDATA\n"
 		   "POINTS %d float\n",
+		   (blk)? "BINARY": "ASCII",
 		   resIdxTb->vertex.idxCnt);
   }
   if(errNum == WLZ_ERR_NONE)
@@ -378,9 +457,20 @@ static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
       if(eP.vertex->idx >= 0)
       {
 	(void )WlzGMVertexGetG3D(eP.vertex, &vtx);
-	(void )fprintf(fP, "%g %g %g\n", vtx.vtX, vtx.vtY, vtx.vtZ);
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPutVtx(fP, blk, &bCnt, vtx);
+	}
+	else
+	{
+	  (void )fprintf(fP, "%g %g %g\n", vtx.vtX, vtx.vtY, vtx.vtZ);
+	}
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -397,18 +487,26 @@ static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
 	idI = 0;
 	vec = model->res.edge.vec;
 	iCnt = model->res.edge.numIdx;
-	while(iCnt-- > 0)
+	while((errNum == WLZ_ERR_NONE) && (iCnt-- > 0))
 	{
 	  eP.edge = (WlzGMEdge *)AlcVectorItemGet(vec, idI++);
 	  if(eP.edge->idx >= 0)
 	  {
 	    tET = eP.edge->edgeT;
-	    bufI[0] = *(resIdxTb->vertex.idxLut +
-	    		tET->vertexT->diskT->vertex->idx);
+	    bufI[0] = 2;
 	    bufI[1] = *(resIdxTb->vertex.idxLut +
+	    		tET->vertexT->diskT->vertex->idx);
+	    bufI[2] = *(resIdxTb->vertex.idxLut +
 	    		tET->opp->vertexT->diskT->vertex->idx);
-	    (void )fprintf(fP, "2 %d %d\n",
-	    		   bufI[0], bufI[1]);
+	    if(blk)
+	    {
+	      errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 3, sizeof(int));
+	    }
+	    else
+	    {
+	      (void )fprintf(fP, "2 %d %d\n",
+			     bufI[1], bufI[2]);
+	    }
 	  }
 	}
         break;
@@ -421,24 +519,38 @@ static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
 	idI = 0;
 	vec = model->res.face.vec;
 	iCnt = model->res.face.numIdx;
-	while(iCnt-- > 0)
+	while((errNum == WLZ_ERR_NONE) && (iCnt-- > 0))
 	{
 	  eP.face = (WlzGMFace *)AlcVectorItemGet(vec, idI++);
 	  if(eP.face->idx >= 0)
 	  {
 	    /* Face IS a triangle, in 3D nothing else is allowed. */
 	    tET = eP.face->loopT->edgeT;
-	    bufI[0] = *(resIdxTb->vertex.idxLut +
-	    		tET->vertexT->diskT->vertex->idx);
+	    bufI[0] = 3;
 	    bufI[1] = *(resIdxTb->vertex.idxLut +
-	    		tET->next->vertexT->diskT->vertex->idx);
+	    		tET->vertexT->diskT->vertex->idx);
 	    bufI[2] = *(resIdxTb->vertex.idxLut +
+	    		tET->next->vertexT->diskT->vertex->idx);
+	    bufI[3] = *(resIdxTb->vertex.idxLut +
 	    		tET->prev->vertexT->diskT->vertex->idx);
-	    (void )fprintf(fP, "3 %d %d %d\n",
-	    	           bufI[0], bufI[1], bufI[2]);
+	    if(blk)
+	    {
+	      errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 4, sizeof(int));
+	    }
+	    else
+	    {
+	      (void )fprintf(fP, "3 %d %d %d\n",
+			     bufI[1], bufI[2], bufI[3]);
+	    }
 	  }
 	}
         break;
+      default:
+        break;
+    }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
     }
   }
   /* Output the normals if they are in the model, i.e. the model is
@@ -461,10 +573,22 @@ static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
       if(eP.vertex->idx >= 0)
       {
 	(void )WlzGMVertexGetG3N(eP.vertex, &vtx, &nrm);
-	(void )fprintf(fP, "%g %g %g\n", nrm.vtX, nrm.vtY, nrm.vtZ);
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPutVtx(fP, blk, &bCnt, nrm);
+	}
+	else
+	{
+	  (void )fprintf(fP, "%g %g %g\n", nrm.vtX, nrm.vtY, nrm.vtZ);
+	}
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
+  AlcFree(blk);
   if(resIdxTb)
   {
     WlzGMModelResIdxFree(resIdxTb);
@@ -479,9 +603,11 @@ static WlzErrorNum WlzEffWriteGMModelVtk(FILE *fP, WlzGMModel *model)
 *		given stream using the Visualization Toolkit
 *		unstructured grid file format with triangular elements.
 * \param	fP			Output file stream.
-* \param	model			Given gemetric model.
+* \param	mesh			Given mesh.
+* \param	dType			VTK data type, ASCII or binary.
 */
-static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
+static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh,
+				       WlzEffVtkDataType dType)
 {
 
   int		cnt,
@@ -489,9 +615,12 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
 		idN,
   		nElm,
   		nNod;
+  int		bufI[4];
+  size_t	bCnt = 0;
   WlzCMeshElm2D	*elm;
   WlzCMeshNod2D	*nod[3];
   int		*nodTbl = NULL;
+  WlzUByte	*blk = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mesh == NULL)
@@ -509,12 +638,18 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Allocate a node table to avoid deleted nodes. */
+    /* Allocate a node table to avoid deleted nodes and a block for
+     * binary output. */
     if((nodTbl = (int *)AlcMalloc(sizeof(int) *
                                   mesh->res.nod.maxEnt)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    else if((dType == WLZEFF_VTK_DATATYPE_BINARY) &&
+            ((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -522,9 +657,10 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
     if(fprintf(fP,
 	       "# vtk DataFile Version 1.0\n"
 	       "Written by WlzEffWriteCMesh2DVtk().\n"
-	       "ASCII\n"
+	       "%s\n"
 	       "DATASET UNSTRUCTURED_GRID\n"
 	       "POINTS %d float\n",
+	       (blk)? "BINARY": "ASCII",
 	       nNod) <= 0)
     {
       errNum = WLZ_ERR_WRITE_INCOMPLETE;
@@ -539,15 +675,31 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
       nod[0] = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
       if(nod[0]->idx >= 0)
       {
-        if(fprintf(fP, "%g %g 0.0\n",
-	               nod[0]->pos.vtX, nod[0]->pos.vtY) <= 0)
+	if(blk)
+	{
+	  WlzDVertex3 pos;
+
+	  pos.vtX = nod[0]->pos.vtX;
+	  pos.vtY = nod[0]->pos.vtY;
+	  pos.vtZ = 0.0;
+	  errNum = WlzEffVtkBinPutVtx(fP, blk, &bCnt, pos);
+	}
+        else if(fprintf(fP, "%g %g 0.0\n",
+	                nod[0]->pos.vtX, nod[0]->pos.vtY) <= 0)
         {
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
 	  break;
 	}
 	nodTbl[idN] = cnt++;
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -560,6 +712,7 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    bufI[0] = 3;
     for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
     {
       elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
@@ -568,15 +721,28 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
 	nod[0] = WLZ_CMESH_ELM2D_GET_NODE_0(elm);
 	nod[1] = WLZ_CMESH_ELM2D_GET_NODE_1(elm);
 	nod[2] = WLZ_CMESH_ELM2D_GET_NODE_2(elm);
-        if(fprintf(fP, "3 %d %d %d\n",
-	           nodTbl[nod[0]->idx], nodTbl[nod[2]->idx],
-	           nodTbl[nod[1]->idx]) <= 0)
+	bufI[1] = nodTbl[nod[0]->idx];
+	bufI[2] = nodTbl[nod[2]->idx];
+	bufI[3] = nodTbl[nod[1]->idx];
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 4, sizeof(int));
+	}
+        else if(fprintf(fP, "3 %d %d %d\n",
+	                bufI[1], bufI[2], bufI[3]) <= 0)
         {
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
 	  break;
 	}
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   AlcFree(nodTbl);
   if(errNum == WLZ_ERR_NONE)
@@ -590,15 +756,28 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    bufI[0] = 5;
     for(idE = 0; idE < nElm; ++idE)
     {
-      if(fprintf(fP, "5\n") <= 0)
+      if(blk)
+      {
+	errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 1, sizeof(int));
+      }
+      else if(fprintf(fP, "5\n") <= 0)
       {
         errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
 	break;
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
+  AlcFree(blk);
   return(errNum);
 }
 
@@ -607,7 +786,8 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
 * \ingroup	WlzExtFF
 * \brief	Writes the given Woolz points object to the
 *		given stream using the Visualization Toolkit
-*		polydata format, but without polygons.
+*		polydata format, but without polygons, with ASCII
+*		data, see WlzEffWritePointsVtkDataType().
 * \param	fP			Output file stream.
 * \param	obj			Given points object.
 * \param        onlyDom			Only write the points domain if
@@ -615,9 +795,32 @@ static WlzErrorNum WlzEffWriteCMesh2DVtk(FILE *fP, WlzCMesh2D *mesh)
 */
 WlzErrorNum 	WlzEffWritePointsVtk(FILE *fP, WlzObject *obj, int onlyDom)
 {
+  return(WlzEffWritePointsVtkDataType(fP, obj, onlyDom,
+  				      WLZEFF_VTK_DATATYPE_ASCII));
+}
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given Woolz points object to the
+*		given stream using the Visualization Toolkit
+*		polydata format, but without polygons, with either
+*		ASCII or binary data.
+* \param	fP			Output file stream.
+* \param	obj			Given points object.
+* \param        onlyDom			Only write the points domain if
+* 					non-zero.
+* \param	dType			VTK data type, ASCII or binary.
+*/
+WlzErrorNum 	WlzEffWritePointsVtkDataType(FILE *fP, WlzObject *obj,
+					     int onlyDom,
+					     WlzEffVtkDataType dType)
+{
+
+  size_t	 bCnt = 0;
   WlzPoints	 *pdm;
   WlzPointValues *pvl;
+  WlzUByte	 *blk = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((pdm = obj->domain.pts) == NULL)
@@ -638,15 +841,23 @@ WlzErrorNum 	WlzEffWritePointsVtk(FILE *fP, WlzObject *obj, int onlyDom)
 	break;
     }
   }
+  if((errNum == WLZ_ERR_NONE) && (dType == WLZEFF_VTK_DATATYPE_BINARY))
+  {
+    if((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     /* Output the file header. */
     if(fprintf(fP,
 	       "# vtk DataFile Version 1.0\n"
 	       "Written by WlzEffWritePointsVtk().\n"
-	       "ASCII\n"
+	       "%s\n"
 	       "DATASET POLYDATA\n"
 	       "POINTS %d float\n",
+	       (blk)? "BINARY": "ASCII",
 	       pdm->nPoints) <= 0)
     {
       errNum = WLZ_ERR_WRITE_INCOMPLETE;
@@ -656,79 +867,64 @@ WlzErrorNum 	WlzEffWritePointsVtk(FILE *fP, WlzObject *obj, int onlyDom)
   if(errNum == WLZ_ERR_NONE)
   {
     int		i;
+    WlzDVertex3	p;
 
-    switch(pdm->type)
+    p.vtZ = 0.0;
+    for(i = 0; i < pdm->nPoints; ++i)
     {
-      case WLZ_POINTS_2I:
-	for(i = 0; i < pdm->nPoints; ++i)
-        {
-	  WlzIVertex2 *p;
-
-	  p = pdm->points.i2 + i;
-	  if(fprintf(fP, "%g %g 0\n",
-	             (double )(p->vtX), (double )(p->vtY)) <= 0)
-	  {
-	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	    break;
-	  }
-	}
-	break;
-      case WLZ_POINTS_2D:
-	for(i = 0; i < pdm->nPoints; ++i)
-        {
-	  WlzDVertex2 *p;
-
-	  p = pdm->points.d2 + i;
-	  if(fprintf(fP, "%g %g 0\n", p->vtX, p->vtY) <= 0)
-	  {
-	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	    break;
-	  }
-	}
-	break;
-      case WLZ_POINTS_3I:
-	for(i = 0; i < pdm->nPoints; ++i)
-        {
-	  WlzIVertex3 *p;
-
-	  p = pdm->points.i3 + i;
-	  if(fprintf(fP, "%g %g %g\n",
-	             (double )(p->vtX), (double )(p->vtY),
-		     (double )(p->vtZ)) <= 0)
-	  {
-	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	    break;
-	  }
-	}
-	break;
-      case WLZ_POINTS_3D:
-	for(i = 0; i < pdm->nPoints; ++i)
-        {
-	  WlzDVertex3 *p;
-
-	  p = pdm->points.d3 + i;
-	  if(fprintf(fP, "%g %g %g\n", p->vtX, p->vtY, p->vtZ) <= 0)
-	  {
-	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	    break;
-	  }
-	}
+      switch(pdm->type)
+      {
+	case WLZ_POINTS_2I:
+	  p.vtX = pdm->points.i2[i].vtX;
+	  p.vtY = pdm->points.i2[i].vtY;
+	  break;
+	case WLZ_POINTS_2D:
+	  p.vtX = pdm->points.d2[i].vtX;
+	  p.vtY = pdm->points.d2[i].vtY;
+	  break;
+	case WLZ_POINTS_3I:
+	  p.vtX = pdm->points.i3[i].vtX;
+	  p.vtY = pdm->points.i3[i].vtY;
+	  p.vtZ = pdm->points.i3[i].vtZ;
+	  break;
+	case WLZ_POINTS_3D:
+	  p = pdm->points.d3[i];
+	  break;
+	default:
+	  break;
+      }
+      if(blk)
+      {
+        errNum = WlzEffVtkBinPutVtx(fP, blk, &bCnt, p);
+      }
+      else if(fprintf(fP, "%g %g %g\n", p.vtX, p.vtY, p.vtZ) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
         break;
-      default:
-	break;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
     }
   }
+  AlcFree(blk);
   /* Output point values if they exist. */
   if((errNum == WLZ_ERR_NONE) && (onlyDom == 0) &&
      ((pvl = obj->values.pts) != NULL))
   {
     if(pvl->rank == 0)
     {
-      errNum = WlzEffWritePointsVtkScalarValues(fP, obj);
+      errNum = WlzEffWritePointsVtkScalarValuesDataType(fP, obj,
+							     dType);
     }
     else
     {
-      errNum = WlzEffWritePointsVtkFieldValues(fP, obj);
+      errNum = WlzEffWritePointsVtkFieldValuesDataType(fP, obj,
+							    dType);
     }
   }
   return(errNum);
@@ -738,8 +934,9 @@ WlzErrorNum 	WlzEffWritePointsVtk(FILE *fP, WlzObject *obj, int onlyDom)
 * \return	Woolz error number.
 * \ingroup	WlzExtFF
 * \brief	Writes the point scalar values of the given object to the given
-* 		file. It is assumed that the points domain has already been
-* 		written by WlzEffWritePointsVtk().
+* 		file with ASCII data. It is assumed that the points domain has
+* 		already been written by WlzEffWritePointsVtk(), see
+* 		WlzEffWritePointsVtkScalarValuesDataType().
 * \param	fP			Output file stream.
 * \param	obj			Object vith points values for output.
 */
@@ -747,10 +944,36 @@ WlzErrorNum			WlzEffWritePointsVtkScalarValues(
 				  FILE *fP, 
 				  WlzObject *obj)
 {
+  return(WlzEffWritePointsVtkScalarValuesDataType(fP, obj,
+  					WLZEFF_VTK_DATATYPE_ASCII));
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the point scalar values of the given object to the given
+* 		file. It is assumed that the points domain has already been
+* 		written by WlzEffWritePointsVtkDataType() using the same data
+* 		type.
+* 		Unsigned byte values are written as unsigned_char for
+* 		binary data and all other values as float.
+* \param	fP			Output file stream.
+* \param	obj			Object vith points values for output.
+* \param	dType			VTK data type, ASCII or binary, this
+* 					should match the data type used for
+* 					the points domain.
+*/
+WlzErrorNum			WlzEffWritePointsVtkScalarValuesDataType(
+				  FILE *fP, 
+				  WlzObject *obj,
+				  WlzEffVtkDataType dType)
+{
+  size_t	 bCnt = 0;
   WlzPoints	 *pdm;
   WlzPointValues *pvl;
   char		 *dStr = "scalars",
   		 *nStr = NULL;
+  WlzUByte	 *blk = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((pdm = obj->domain.pts) == NULL)
@@ -795,7 +1018,8 @@ WlzErrorNum			WlzEffWritePointsVtkScalarValues(
       {
         case WLZ_GREY_UBYTE:
 	  unsup = 0;
-	  gStr = "char";
+	  gStr = (dType == WLZEFF_VTK_DATATYPE_BINARY)? "unsigned_char":
+	                                                "char";
 	  break;
         case WLZ_GREY_INT:   /* FALLTHROUGH */
 	case WLZ_GREY_SHORT: /* FALLTHROUGH */
@@ -807,7 +1031,14 @@ WlzErrorNum			WlzEffWritePointsVtkScalarValues(
 	default:
 	  break;
       }
-      if(unsup == 0)
+      if((unsup == 0) && (dType == WLZEFF_VTK_DATATYPE_BINARY))
+      {
+	if((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+      }
+      if((errNum == WLZ_ERR_NONE) && (unsup == 0))
       {
 	if(fprintf(fP,
 		   "POINT_DATA %d\n"
@@ -817,6 +1048,15 @@ WlzErrorNum			WlzEffWritePointsVtkScalarValues(
 	{
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	}
+	else if(blk)
+	{
+	  errNum = WlzEffVtkPutPointValues(fP, blk, &bCnt, pvl,
+	                                   pdm->nPoints);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+	  }
+	}
 	else
 	{
           int	i;
@@ -881,16 +1121,36 @@ WlzErrorNum			WlzEffWritePointsVtkScalarValues(
       }
     }
   }
+  AlcFree(blk);
   AlcFree(nStr);
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the point field values of the given object to the given
+* 		file with ASCII data. It is assumed that the points domain has
+* 		already been written by WlzEffWritePointsVtk(), see
+* 		WlzEffWritePointsVtkFieldValuesDataType().
+* \param	fP			Output file stream.
+* \param	obj			Object vith points values for output.
+*/
+WlzErrorNum			WlzEffWritePointsVtkFieldValues(
+				  FILE *fP, 
+				  WlzObject *obj)
+{
+  return(WlzEffWritePointsVtkFieldValuesDataType(fP, obj,
+  					WLZEFF_VTK_DATATYPE_ASCII));
+}
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF
 * \brief	Writes the point field values of the given object to the given
 * 		file. It is assumed that the points domain has already been
-* 		written by WlzEffWritePointsVtk().
+* 		written by WlzEffWritePointsVtkDataType() using the same data
+* 		type.
 *
 * 		The VTK file specification does not include an appropriate
 * 		data type for arbitrary dimensional fields so here one is
@@ -915,17 +1175,26 @@ WlzErrorNum			WlzEffWritePointsVtkScalarValues(
 	1.019 -0.002 0.079  0.003 1.055  0.012 0.002   0.0085 1.019
 	1.012 -0.008 0.015 -0.023 1.013 -0.018 7.9e-05 0.0961 1.005
 		\endverbatim
+*		For binary data the values of all points follow as a
+*		single array, with unsigned byte values written as
+*		unsigned_char and all other values as float.
 * \param	fP			Output file stream.
 * \param	obj			Object vith points values for output.
+* \param	dType			VTK data type, ASCII or binary, this
+* 					should match the data type used for
+* 					the points domain.
 */
-WlzErrorNum			WlzEffWritePointsVtkFieldValues(
+WlzErrorNum			WlzEffWritePointsVtkFieldValuesDataType(
 				  FILE *fP, 
-				  WlzObject *obj)
+				  WlzObject *obj,
+				  WlzEffVtkDataType dType)
 {
+  size_t	 bCnt = 0;
   WlzPoints	 *pdm;
   WlzPointValues *pvl;
   char		 *dStr = "field",
   		 *nStr = NULL;
+  WlzUByte	 *blk = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((pdm = obj->domain.pts) == NULL)
@@ -971,7 +1240,8 @@ WlzErrorNum			WlzEffWritePointsVtkFieldValues(
       {
         case WLZ_GREY_UBYTE:
 	  unsup = 0;
-	  gStr = "char";
+	  gStr = (dType == WLZEFF_VTK_DATATYPE_BINARY)? "unsigned_char":
+	                                                "char";
 	  break;
         case WLZ_GREY_INT:   /* FALLTHROUGH */
 	case WLZ_GREY_SHORT: /* FALLTHROUGH */
@@ -1013,7 +1283,23 @@ WlzErrorNum			WlzEffWritePointsVtkFieldValues(
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
 	}
-	if(errNum == WLZ_ERR_NONE)
+	if((errNum == WLZ_ERR_NONE) && (dType == WLZEFF_VTK_DATATYPE_BINARY))
+	{
+	  if((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    errNum = WlzEffVtkPutPointValues(fP, blk, &bCnt, pvl,
+	                                     (size_t )vpe * pdm->nPoints);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+	  }
+	}
+	else if(errNum == WLZ_ERR_NONE)
 	{
           int		i;
 	  size_t	cnt = 0;
@@ -1080,6 +1366,7 @@ WlzErrorNum			WlzEffWritePointsVtkFieldValues(
       }
     }
   }
+  AlcFree(blk);
   AlcFree(nStr);
   return(errNum);
 }
@@ -1091,9 +1378,11 @@ WlzErrorNum			WlzEffWritePointsVtkFieldValues(
 *		given stream using the Visualization Toolkit
 *		unstructured grid file format with triangular elements.
 * \param	fP			Output file stream.
-* \param	model			Given gemetric model.
+* \param	mesh			Given mesh.
+* \param	dType			VTK data type, ASCII or binary.
 */
-static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
+static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh,
+					WlzEffVtkDataType dType)
 {
 
   int		cnt,
@@ -1101,9 +1390,12 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
 		idN,
   		nElm,
   		nNod;
+  int		bufI[4];
+  size_t	bCnt = 0;
   WlzCMeshElm2D5 *elm;
   WlzCMeshNod2D5 *nod[3];
   int		*nodTbl = NULL;
+  WlzUByte	*blk = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mesh == NULL)
@@ -1121,12 +1413,18 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Allocate a node table to avoid deleted nodes. */
+    /* Allocate a node table to avoid deleted nodes and a block for
+     * binary output. */
     if((nodTbl = (int *)AlcMalloc(sizeof(int) *
                                   mesh->res.nod.maxEnt)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    else if((dType == WLZEFF_VTK_DATATYPE_BINARY) &&
+            ((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1134,9 +1432,10 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
     if(fprintf(fP,
 	       "# vtk DataFile Version 1.0\n"
 	       "Written by WlzEffWriteCMesh2D5Vtk().\n"
-	       "ASCII\n"
+	       "%s\n"
 	       "DATASET UNSTRUCTURED_GRID\n"
 	       "POINTS %d float\n",
+	       (blk)? "BINARY": "ASCII",
 	       nNod) <= 0)
     {
       errNum = WLZ_ERR_WRITE_INCOMPLETE;
@@ -1151,15 +1450,27 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
       nod[0] = (WlzCMeshNod2D5 *)AlcVectorItemGet(mesh->res.nod.vec, idN);
       if(nod[0]->idx >= 0)
       {
-        if(fprintf(fP, "%g %g %g\n",
-	               nod[0]->pos.vtX, nod[0]->pos.vtY, nod[0]->pos.vtZ) <= 0)
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPutVtx(fP, blk, &bCnt, nod[0]->pos);
+	}
+        else if(fprintf(fP, "%g %g %g\n",
+	                nod[0]->pos.vtX, nod[0]->pos.vtY,
+			nod[0]->pos.vtZ) <= 0)
         {
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
 	  break;
 	}
 	nodTbl[idN] = cnt++;
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1172,6 +1483,7 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    bufI[0] = 3;
     for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
     {
       elm = (WlzCMeshElm2D5 *)AlcVectorItemGet(mesh->res.elm.vec, idE);
@@ -1180,15 +1492,28 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
 	nod[0] = WLZ_CMESH_ELM2D5_GET_NODE_0(elm);
 	nod[1] = WLZ_CMESH_ELM2D5_GET_NODE_1(elm);
 	nod[2] = WLZ_CMESH_ELM2D5_GET_NODE_2(elm);
-        if(fprintf(fP, "3 %d %d %d\n",
-	           nodTbl[nod[0]->idx], nodTbl[nod[2]->idx],
-	           nodTbl[nod[1]->idx]) <= 0)
+	bufI[1] = nodTbl[nod[0]->idx];
+	bufI[2] = nodTbl[nod[2]->idx];
+	bufI[3] = nodTbl[nod[1]->idx];
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 4, sizeof(int));
+	}
+        else if(fprintf(fP, "3 %d %d %d\n",
+	                bufI[1], bufI[2], bufI[3]) <= 0)
         {
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
 	  break;
 	}
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   AlcFree(nodTbl);
   if(errNum == WLZ_ERR_NONE)
@@ -1202,15 +1527,28 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    bufI[0] = 5;
     for(idE = 0; idE < nElm; ++idE)
     {
-      if(fprintf(fP, "5\n") <= 0)
+      if(blk)
+      {
+	errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 1, sizeof(int));
+      }
+      else if(fprintf(fP, "5\n") <= 0)
       {
         errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
 	break;
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
+  AlcFree(blk);
   return(errNum);
 }
 
@@ -1221,9 +1559,11 @@ static WlzErrorNum WlzEffWriteCMesh2D5Vtk(FILE *fP, WlzCMesh2D5 *mesh)
 *		given stream using the Visualization Toolkit
 *		unstructured grid file format with tetrahedral elements.
 * \param	fP			Output file stream.
-* \param	model			Given gemetric model.
+* \param	mesh			Given mesh.
+* \param	dType			VTK data type, ASCII or binary.
 */
-static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
+static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh,
+				       WlzEffVtkDataType dType)
 {
 
   int		cnt,
@@ -1231,9 +1571,12 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
 		idN,
   		nElm,
   		nNod;
+  int		bufI[5];
+  size_t	bCnt = 0;
   WlzCMeshElm3D	*elm;
   WlzCMeshNod3D	*nod[4];
   int		*nodTbl = NULL;
+  WlzUByte	*blk = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mesh == NULL)
@@ -1251,12 +1594,18 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Allocate a node table to avoid deleted nodes. */
+    /* Allocate a node table to avoid deleted nodes and a block for
+     * binary output. */
     if((nodTbl = (int *)AlcMalloc(sizeof(int) *
                                   mesh->res.nod.maxEnt)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    else if((dType == WLZEFF_VTK_DATATYPE_BINARY) &&
+            ((blk = (WlzUByte *)AlcMalloc(WLZEFF_VTK_BINBLKSZ)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1264,9 +1613,10 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
     if(fprintf(fP,
 	       "# vtk DataFile Version 1.0\n"
 	       "Written by WlzEffWriteCMesh3DVtk().\n"
-	       "ASCII\n"
+	       "%s\n"
 	       "DATASET UNSTRUCTURED_GRID\n"
 	       "POINTS %d float\n",
+	       (blk)? "BINARY": "ASCII",
 	       nNod) <= 0)
     {
       errNum = WLZ_ERR_WRITE_INCOMPLETE;
@@ -1281,15 +1631,27 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
       nod[0] = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
       if(nod[0]->idx >= 0)
       {
-        if(fprintf(fP, "%g %g %g\n",
-	               nod[0]->pos.vtX, nod[0]->pos.vtY, nod[0]->pos.vtZ) <= 0)
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPutVtx(fP, blk, &bCnt, nod[0]->pos);
+	}
+        else if(fprintf(fP, "%g %g %g\n",
+	                nod[0]->pos.vtX, nod[0]->pos.vtY,
+			nod[0]->pos.vtZ) <= 0)
         {
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
 	  break;
 	}
 	nodTbl[idN] = cnt++;
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1302,6 +1664,7 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    bufI[0] = 4;
     for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
     {
       elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
@@ -1311,15 +1674,29 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
 	nod[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
 	nod[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
 	nod[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
-        if(fprintf(fP, "4 %d %d %d %d\n",
-	           nodTbl[nod[0]->idx], nodTbl[nod[1]->idx],
-	           nodTbl[nod[3]->idx], nodTbl[nod[2]->idx]) <= 0)
+	bufI[1] = nodTbl[nod[0]->idx];
+	bufI[2] = nodTbl[nod[1]->idx];
+	bufI[3] = nodTbl[nod[3]->idx];
+	bufI[4] = nodTbl[nod[2]->idx];
+	if(blk)
+	{
+	  errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 5, sizeof(int));
+	}
+        else if(fprintf(fP, "4 %d %d %d %d\n",
+	                bufI[1], bufI[2], bufI[3], bufI[4]) <= 0)
         {
 	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
 	  break;
 	}
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
   AlcFree(nodTbl);
   if(errNum == WLZ_ERR_NONE)
@@ -1333,15 +1710,28 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
   }
   if(errNum == WLZ_ERR_NONE)
   {
+    bufI[0] = 10;
     for(idE = 0; idE < nElm; ++idE)
     {
-      if(fprintf(fP, "10\n") <= 0)
+      if(blk)
+      {
+	errNum = WlzEffVtkBinPut(fP, blk, &bCnt, bufI, 1, sizeof(int));
+      }
+      else if(fprintf(fP, "10\n") <= 0)
       {
         errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
 	break;
       }
     }
+    if((errNum == WLZ_ERR_NONE) && blk)
+    {
+      errNum = WlzEffVtkBinEnd(fP, blk, &bCnt);
+    }
   }
+  AlcFree(blk);
   return(errNum);
 }
 
@@ -1489,6 +1879,7 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
   		valI,
 		nElm = 0,
 		nNod = 0;
+  size_t	vSz = sizeof(float);
   char 		*valS0,
   		*valS1;
   WlzDBox3	bBox;
@@ -1502,16 +1893,22 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
   WlzDomain	dom;
   WlzValues	val;
   WlzObject	*obj = NULL;
-  int		eBuf[4];
+  WlzEffTok	*tok = NULL;
+  int		*eP,
+  		*eBuf = NULL;
   char		buf[256];
 
   mesh.v = NULL;
   dom.core = NULL;
   val.core = NULL;
-  if(header->dataType != WLZEFF_VTK_DATATYPE_ASCII)
+  if((eBuf = (int *)
+             AlcMalloc(sizeof(int) * 5 * WLZEFF_TOK_BATCH)) == NULL)
   {
-    /* Can only read ascii meshes. */
-    errNum = WLZ_ERR_READ_INCOMPLETE;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    tok = WlzEffTokNew(fP, 0, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1519,7 +1916,7 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
     {
       /* Read line containing token. */
       valS0 = NULL;
-      if(fgets(buf, 256, fP) == NULL)
+      if(WlzEffTokRec(tok, buf, 256) == NULL)
       {
 	if(mesh.v == NULL)
 	{
@@ -1527,7 +1924,6 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 	}
         break;
       }
-      buf[255] = '\0';
       valS0 = strtok(buf, " \t\n\r\f\v");
       if(valS0)
       {
@@ -1561,7 +1957,11 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 		else
 		{
 		  valS0 = strtok(NULL, " \t\n\r\f\v");
-		  if((valS0 == NULL) || strcmp(valS0, "float"))
+		  if(valS0 && (strcmp(valS0, "double") == 0))
+		  {
+		    vSz = sizeof(double);
+		  }
+		  else if((valS0 == NULL) || strcmp(valS0, "float"))
 		  {
 		    errNum = WLZ_ERR_READ_INCOMPLETE;
 		  }
@@ -1578,15 +1978,14 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 		if(errNum == WLZ_ERR_NONE)
 		{
 		  /* Read nNod 3D verticies into the 3D vertex buffer. */
+		  errNum = WlzEffVtkReadDoubles(tok, header->dataType,
+		                                (double *)vBuf,
+						3 * (size_t )nNod, vSz);
+		}
+		if(errNum == WLZ_ERR_NONE)
+		{
 		  for(idN = 0; idN < nNod; ++idN)
 		  {
-		    if((fscanf(fP, "%lg", &(vBuf[idN].vtX)) != 1) ||
-		       (fscanf(fP, "%lg", &(vBuf[idN].vtY)) != 1) ||
-		       (fscanf(fP, "%lg", &(vBuf[idN].vtZ)) != 1))
-		    {
-		      errNum = WLZ_ERR_READ_INCOMPLETE;
-		      break;
-		    }
 		    if(idN == 0)
 		    {
 		      bBox.xMin = bBox.xMax = vBuf[idN].vtX;
@@ -1678,12 +2077,12 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 			}
 			for(idE = 0; idE < nElm; ++idE)
 			{
-			  if((fscanf(fP, "%d", &valI) != 1) || (valI != 3) ||
-			      (fscanf(fP, "%d %d %d",
-				      eBuf + 0, eBuf + 1, eBuf + 2) != 3) ||
-			      (eBuf[0] < 0) || (eBuf[0] >= nNod) ||
-			      (eBuf[1] < 0) || (eBuf[1] >= nNod) ||
-			      (eBuf[2] < 0) || (eBuf[2] >= nNod))
+			  if(((eP = WlzEffVtkIntBatch(tok, header->dataType, eBuf,
+			                              idE, nElm, 4)) == NULL) ||
+			     (eP[0] != 3) ||
+			     (eP[1] < 0) || (eP[1] >= nNod) ||
+			     (eP[2] < 0) || (eP[2] >= nNod) ||
+			     (eP[3] < 0) || (eP[3] >= nNod))
 			  {
 			    errNum = WLZ_ERR_READ_INCOMPLETE;
 			    break;
@@ -1692,7 +2091,7 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 			  {
 			    nBuf2[idN] = (WlzCMeshNod2D *)
 			                 AlcVectorItemGet(mesh.m2->res.nod.vec,
-				                          eBuf[idN]);
+				                          eP[idN + 1]);
 			  }
 			  /* Add triangle to the mesh. It's possible that the
 			   * orienation will be wrong so try both. */
@@ -1730,14 +2129,13 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 			}
 			for(idE = 0; idE < nElm; ++idE)
 			{
-			  if((fscanf(fP, "%d", &valI) != 1) || (valI != 4) ||
-			      (fscanf(fP, "%d %d %d %d",
-				      eBuf + 0, eBuf + 1,
-				      eBuf + 2, eBuf + 3) != 4) ||
-			      (eBuf[0] < 0) || (eBuf[0] >= nNod) ||
-			      (eBuf[1] < 0) || (eBuf[1] >= nNod) ||
-			      (eBuf[2] < 0) || (eBuf[2] >= nNod) ||
-			      (eBuf[3] < 0) || (eBuf[3] >= nNod))
+			  if(((eP = WlzEffVtkIntBatch(tok, header->dataType, eBuf,
+			                              idE, nElm, 5)) == NULL) ||
+			     (eP[0] != 4) ||
+			     (eP[1] < 0) || (eP[1] >= nNod) ||
+			     (eP[2] < 0) || (eP[2] >= nNod) ||
+			     (eP[3] < 0) || (eP[3] >= nNod) ||
+			     (eP[4] < 0) || (eP[4] >= nNod))
 			  {
 			    errNum = WLZ_ERR_READ_INCOMPLETE;
 			    break;
@@ -1746,7 +2144,7 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 			  {
 			    nBuf3[idN] = (WlzCMeshNod3D *)
 			                 AlcVectorItemGet(mesh.m3->res.nod.vec,
-				                          eBuf[idN]);
+				                          eP[idN + 1]);
 			  }
 			  /* Add tetrahedron to the mesh. It's possible that
 			   * the orienation will be wrong so try both. */
@@ -1788,7 +2186,9 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 		     * triangles (type 5).  */
 		    for(idE = 0; idE < cnt; ++idE)
 		    {
-		      if((fscanf(fP, "%d", &valI) != 1) || (valI != 5))
+		      if(((eP = WlzEffVtkIntBatch(tok, header->dataType, eBuf,
+		                                  idE, cnt, 1)) == NULL) ||
+			 (*eP != 5))
 		      {
 			errNum = WLZ_ERR_READ_INCOMPLETE;
 			break;
@@ -1800,7 +2200,9 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
 		     * tetrahedra (type 10).  */
 		    for(idE = 0; idE < cnt; ++idE)
 		    {
-		      if((fscanf(fP, "%d", &valI) != 1) || (valI != 10))
+		      if(((eP = WlzEffVtkIntBatch(tok, header->dataType, eBuf,
+		                                  idE, cnt, 1)) == NULL) ||
+			 (*eP != 10))
 		      {
 			errNum = WLZ_ERR_READ_INCOMPLETE;
 			break;
@@ -1838,6 +2240,8 @@ WlzObject	*WlzEffReadCMeshVtk(FILE *fP, WlzEffVtkHeader *header,
     }
     while(errNum == WLZ_ERR_NONE);
   }
+  (void )WlzEffTokFree(tok);
+  AlcFree(eBuf);
   AlcFree(vBuf);
   if((errNum == WLZ_ERR_NONE) && (mesh.v != NULL))
   {
@@ -1899,6 +2303,8 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 		sumPoints = 0,
 		endOfData = 0,
 		vHTSz;
+  size_t	sSz = sizeof(float),
+  		vSz = sizeof(float);
   char 		*valS = NULL;
   WlzGMModel	*model = NULL;
   WlzDomain	dom;
@@ -1907,14 +2313,21 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzDVertex3	*pointBuf = NULL;
   float		*pointDataBuf = NULL;
+  WlzEffTok	*tok = NULL;
+  int		*eP,
+  		*eBuf = NULL;
   char		buf[256];
 
   dom.core = NULL;
   val.core = NULL;
-  if(header->dataType == WLZEFF_VTK_DATATYPE_BINARY)
+  if((eBuf = (int *)
+             AlcMalloc(sizeof(int) * 4 * WLZEFF_TOK_BATCH)) == NULL)
   {
-    /* Can only read ascii polydata. */
-    errNum = WLZ_ERR_READ_INCOMPLETE;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    tok = WlzEffTokNew(fP, 0, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1923,13 +2336,12 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
       WlzEffVtkPolyDataType prim;
 
       /* Read line containing token. */
-      if(fgets(buf, 256, fP) == NULL)
+      if(WlzEffTokRec(tok, buf, 256) == NULL)
       {
         endOfData = 1;
       }
       else
       {
-	buf[255] = '\0';
 	valS = strtok(buf, " \t\n\r\f\v");
       }
       if(valS)
@@ -1960,7 +2372,11 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 	      else
 	      {
 		  valS = strtok(NULL, " \t\n\r\f\v");
-		if((valS == NULL) || strcmp(valS, "float"))
+		if(valS && (strcmp(valS, "double") == 0))
+		{
+		  vSz = sizeof(double);
+		}
+		else if((valS == NULL) || strcmp(valS, "float"))
 		{
 		  errNum = WLZ_ERR_READ_INCOMPLETE;
 		}
@@ -1976,17 +2392,9 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 	      if(errNum == WLZ_ERR_NONE)
 	      {
 	        /* Read nPoints 3D verticies. */
-		pIdx = 0;
-		while((errNum == WLZ_ERR_NONE) && (pIdx < nPoints))
-		{
-		  if((fscanf(fP, "%lg", &((pointBuf + pIdx)->vtX)) != 1) ||
-		     (fscanf(fP, "%lg", &((pointBuf + pIdx)->vtY)) != 1) ||
-		     (fscanf(fP, "%lg", &((pointBuf + pIdx)->vtZ)) != 1))
-		  {
-		    errNum = WLZ_ERR_READ_INCOMPLETE;
-		  }
-		  ++pIdx;
-		}
+		errNum = WlzEffVtkReadDoubles(tok, header->dataType,
+		                              (double *)pointBuf,
+					      3 * (size_t )nPoints, vSz);
 		sumPoints += nPoints;
 	      }
 	      break;
@@ -2052,12 +2460,15 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 		pIdx = 0;
 		while((errNum == WLZ_ERR_NONE) && (pIdx < nPoly))
 		{
-		  if((fscanf(fP, "%d", &valI) != 1) || (valI != 3) ||
-		     (fscanf(fP, "%d %d %d",
-			     polyBuf + 0, polyBuf + 1, polyBuf + 2) != 3) ||
-		     (*(polyBuf + 0) < 0) || (*(polyBuf + 0) >= sumPoints) ||
-		     (*(polyBuf + 1) < 0) || (*(polyBuf + 1) >= sumPoints) ||
-		     (*(polyBuf + 2) < 0) || (*(polyBuf + 2) >= sumPoints))
+		  if(((eP = WlzEffVtkIntBatch(tok, header->dataType, eBuf,
+		                              pIdx, nPoly, 4)) == NULL) ||
+		     (eP[0] != 3) ||
+		     ((*(polyBuf + 0) = eP[1]) < 0) ||
+		     (*(polyBuf + 0) >= sumPoints) ||
+		     ((*(polyBuf + 1) = eP[2]) < 0) ||
+		     (*(polyBuf + 1) >= sumPoints) ||
+		     ((*(polyBuf + 2) = eP[3]) < 0) ||
+		     (*(polyBuf + 2) >= sumPoints))
 		  {
 		    errNum = WLZ_ERR_READ_INCOMPLETE;
 		  }
@@ -2138,11 +2549,13 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 	        pIdx = 0;
 		while((errNum == WLZ_ERR_NONE) && (pIdx < nLine))
 		{
-		  if((fscanf(fP, "%d", &valI) != 1) || (valI != 2) ||
-		     (fscanf(fP, "%d %d",
-		             polyBuf + 0, polyBuf + 1) != 2) ||
-		     (*(polyBuf + 0) < 0) || (*(polyBuf + 0) >= sumPoints) ||
-		     (*(polyBuf + 1) < 0) || (*(polyBuf + 1) >= sumPoints))
+		  if(((eP = WlzEffVtkIntBatch(tok, header->dataType, eBuf,
+		                              pIdx, nLine, 3)) == NULL) ||
+		     (eP[0] != 2) ||
+		     ((*(polyBuf + 0) = eP[1]) < 0) ||
+		     (*(polyBuf + 0) >= sumPoints) ||
+		     ((*(polyBuf + 1) = eP[2]) < 0) ||
+		     (*(polyBuf + 1) >= sumPoints))
 		  {
 		    errNum = WLZ_ERR_READ_INCOMPLETE;
 		  }
@@ -2189,10 +2602,19 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 	      {
 		if((strtok(NULL, " \t\n\r\f\v") == NULL) ||
 		   ((valS = strtok(NULL, " \t\n\r\f\v")) == NULL) ||
-		   (strcmp(valS, "float") && strcmp(valS, "char")))
+		   (WlzStringMatchValue(&valI, valS,
+		                        "float", 4,
+		                        "double", 8,
+		                        "char", 1,
+		                        "unsigned_char", 1,
+					NULL) == 0))
 		{
 		  errNum = WLZ_ERR_READ_INCOMPLETE;
 		}
+		else
+		{
+		  sSz = valI;
+		}
 	      }
 	      break;
 	    case WLZEFF_VTK_POLYDATATYPE_LOOKUP_TABLE:
@@ -2218,7 +2640,10 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 		  pIdx = 0;
 		  while((errNum == WLZ_ERR_NONE) && (pIdx < nPointData))
 		  {
-		    if(fscanf(fP, "%g", &pVal) != 1)
+		    double dVal;
+
+		    if(WlzEffVtkReadDoubles(tok, header->dataType,
+		                            &dVal, 1, sSz) != WLZ_ERR_NONE)
 		    {
 		      errNum = WLZ_ERR_READ_INCOMPLETE;
 		    }
@@ -2226,6 +2651,7 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
 		    {
 		      int iVal;
 
+		      pVal = (float )dVal;
 		      iVal = WLZ_NINT(pVal);
 		      if(vType != WLZ_GREY_FLOAT)
 		      {
@@ -2301,6 +2727,8 @@ WlzObject	*WlzEffReadPolyVtk(FILE *fP, WlzEffVtkHeader *header,
     }
     while((endOfData == 0) && (errNum == WLZ_ERR_NONE));
   }
+  (void )WlzEffTokFree(tok);
+  AlcFree(eBuf);
   if((errNum == WLZ_ERR_NONE) && (obj == NULL) && (sumPoints > 0))
   {
     WlzVertexP pBuf;
@@ -2353,3 +2781,318 @@ WlzObject	*WlzEffReadImgVtk(FILE *fP, WlzEffVtkHeader *header,
   }
   return(obj);
 }
+
+/*!
+* \return	void
+* \ingroup	WlzExtFF
+* \brief	Converts the byte order of the given values between that
+* 		of the host and big-endian, which is the byte order of
+* 		all binary data in (legacy) VTK files. Nothing is done
+* 		on a big-endian host.
+* \param	buf			Buffer of values.
+* \param	n			Number of values.
+* \param	sz			Size (bytes) of each value.
+*/
+static void	WlzEffVtkBinSwap(void *buf, size_t n, size_t sz)
+{
+  WlzUInt	one = 1;
+
+  if((sz > 1) && (*(WlzUByte *)&one != 0))
+  {
+    size_t	idN;
+    WlzUByte	*b;
+
+    b = (WlzUByte *)buf;
+    for(idN = 0; idN < n; ++idN)
+    {
+      size_t	i,
+      		j;
+
+      for(i = 0, j = sz - 1; i < j; ++i, --j)
+      {
+	WlzUByte t;
+
+	t = b[i];
+	b[i] = b[j];
+	b[j] = t;
+      }
+      b += sz;
+    }
+  }
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Appends the given values to a block of binary VTK output,
+* 		in big-endian byte order. The block is written to the file
+* 		each time that it is filled.
+* \param	fP			Output file stream.
+* \param	blk			Block with space for
+* 					WLZEFF_VTK_BINBLKSZ bytes.
+* \param	cnt			Number of bytes in the block, updated
+* 					on return.
+* \param	val			Values to append.
+* \param	n			Number of values.
+* \param	sz			Size (bytes) of each value.
+*/
+static WlzErrorNum WlzEffVtkBinPut(FILE *fP, WlzUByte *blk, size_t *cnt,
+				   const void *val, size_t n, size_t sz)
+{
+  const WlzUByte *v;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  v = (const WlzUByte *)val;
+  while((errNum == WLZ_ERR_NONE) && (n > 0))
+  {
+    size_t	m;
+
+    if((m = (WLZEFF_VTK_BINBLKSZ - *cnt) / sz) == 0)
+    {
+      if(fwrite(blk, sizeof(WlzUByte), *cnt, fP) != *cnt)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      *cnt = 0;
+    }
+    else
+    {
+      if(m > n)
+      {
+        m = n;
+      }
+      (void )memcpy(blk + *cnt, v, m * sz);
+      WlzEffVtkBinSwap(blk + *cnt, m, sz);
+      *cnt += m * sz;
+      v += m * sz;
+      n -= m;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Appends the given vertex to a block of binary VTK output
+* 		as three floats, see WlzEffVtkBinPut().
+* \param	fP			Output file stream.
+* \param	blk			Block for binary output.
+* \param	cnt			Number of bytes in the block, updated
+* 					on return.
+* \param	vtx			Given vertex.
+*/
+static WlzErrorNum WlzEffVtkBinPutVtx(FILE *fP, WlzUByte *blk, size_t *cnt,
+				      WlzDVertex3 vtx)
+{
+  float		f[3];
+
+  f[0] = (float )(vtx.vtX);
+  f[1] = (float )(vtx.vtY);
+  f[2] = (float )(vtx.vtZ);
+  return(WlzEffVtkBinPut(fP, blk, cnt, f, 3, sizeof(float)));
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes any remaining bytes of a block of binary VTK output
+* 		followed by the new line which ends the binary data.
+* \param	fP			Output file stream.
+* \param	blk			Block for binary output.
+* \param	cnt			Number of bytes in the block, set to
+* 					zero on return.
+*/
+static WlzErrorNum WlzEffVtkBinEnd(FILE *fP, WlzUByte *blk, size_t *cnt)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((*cnt > 0) && (fwrite(blk, sizeof(WlzUByte), *cnt, fP) != *cnt))
+  {
+    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+  }
+  else if(fputc('\n', fP) == EOF)
+  {
+    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+  }
+  *cnt = 0;
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Appends point values to a block of binary VTK output,
+* 		see WlzEffVtkBinPut(). Unsigned byte values are appended
+* 		as they are and all other values are converted to float.
+* \param	fP			Output file stream.
+* \param	blk			Block for binary output.
+* \param	cnt			Number of bytes in the block, updated
+* 					on return.
+* \param	pvl			Given point values.
+* \param	n			Number of values.
+*/
+static WlzErrorNum WlzEffVtkPutPointValues(FILE *fP, WlzUByte *blk,
+					   size_t *cnt, WlzPointValues *pvl,
+					   size_t n)
+{
+  size_t	idN;
+  float		f[256];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(pvl->vType == WLZ_GREY_UBYTE)
+  {
+    errNum = WlzEffVtkBinPut(fP, blk, cnt, pvl->values.ubp, n,
+                             sizeof(WlzUByte));
+  }
+  else
+  {
+    /* Convert the values to floats in small batches. */
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < n); idN += 256)
+    {
+      size_t	i,
+      		m;
+
+      m = ((n - idN) < 256)? n - idN: 256;
+      for(i = 0; i < m; ++i)
+      {
+        size_t	j;
+
+	j = idN + i;
+	switch(pvl->vType)
+	{
+	  case WLZ_GREY_INT:
+	    f[i] = (float )(pvl->values.inp[j]);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    f[i] = (float )(pvl->values.shp[j]);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    f[i] = pvl->values.flp[j];
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    f[i] = (float )(pvl->values.dbp[j]);
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzEffVtkBinPut(fP, blk, cnt, f, m, sizeof(float));
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Reads an array of values from either ASCII or binary
+* 		VTK data into the given buffer of doubles.
+* \param	tok			Tokenizer for the input file.
+* \param	dType			VTK data type, ASCII or binary.
+* \param	dst			Destination for the values.
+* \param	n			Number of values to read.
+* \param	sz			Size (bytes) of each binary value,
+* 					1 for unsigned_char, 4 for float or
+* 					8 for double. Ignored for ASCII data.
+*/
+static WlzErrorNum WlzEffVtkReadDoubles(WlzEffTok *tok,
+					WlzEffVtkDataType dType,
+					double *dst, size_t n, size_t sz)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dType != WLZEFF_VTK_DATATYPE_BINARY)
+  {
+    errNum = WlzEffTokDoubles(tok, dst, n);
+  }
+  else
+  {
+    size_t	idN;
+    WlzUByte	*b;
+
+    /* Read the values into the end of the buffer so that they can be
+     * converted in place, working forwards. */
+    b = (WlzUByte *)dst + ((sizeof(double) - sz) * n);
+    if((errNum = WlzEffTokBytes(tok, b, n * sz)) == WLZ_ERR_NONE)
+    {
+      WlzEffVtkBinSwap(b, n, sz);
+      switch(sz)
+      {
+	case sizeof(WlzUByte):
+	  for(idN = 0; idN < n; ++idN)
+	  {
+	    dst[idN] = b[idN];
+	  }
+	  break;
+	case sizeof(float):
+	  for(idN = 0; idN < n; ++idN)
+	  {
+	    dst[idN] = ((float *)b)[idN];
+	  }
+	  break;
+	case sizeof(double):
+	  break;
+	default:
+	  errNum = WLZ_ERR_PARAM_DATA;
+	  break;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Pointer to the fields of the given record or NULL on error.
+* \ingroup	WlzExtFF
+* \brief	Gives the fields of a record from a sequence of records
+* 		of integers in either ASCII or binary VTK data, as
+* 		WlzEffTokIntBatch() does for ASCII data.
+* \param	tok			Tokenizer for the input file.
+* \param	dType			VTK data type, ASCII or binary.
+* \param	buf			Buffer with space for
+* 					WLZEFF_TOK_BATCH * nFld ints.
+* \param	idx			Index of the record in the sequence.
+* \param	n			Number of records in the sequence.
+* \param	nFld			Number of fields per record.
+*/
+static int	*WlzEffVtkIntBatch(WlzEffTok *tok, WlzEffVtkDataType dType,
+				   int *buf, int idx, int n, int nFld)
+{
+  int		*rec = NULL;
+
+  if(dType != WLZEFF_VTK_DATATYPE_BINARY)
+  {
+    rec = WlzEffTokIntBatch(tok, buf, idx, n, nFld, NULL);
+  }
+  else if((idx >= 0) && (idx < n) && (nFld > 0))
+  {
+    int		idB;
+
+    if((idB = idx % WLZEFF_TOK_BATCH) == 0)
+    {
+      size_t	nB;
+
+      nB = n - idx;
+      if(nB > WLZEFF_TOK_BATCH)
+      {
+        nB = WLZEFF_TOK_BATCH;
+      }
+      nB *= nFld;
+      if(WlzEffTokBytes(tok, buf, nB * sizeof(int)) == WLZ_ERR_NONE)
+      {
+	WlzEffVtkBinSwap(buf, nB, sizeof(int));
+	rec = buf;
+      }
+    }
+    else
+    {
+      rec = buf + (idB * nFld);
+    }
+  }
+  return(rec);
+}